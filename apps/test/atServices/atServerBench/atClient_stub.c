@@ -0,0 +1,152 @@
+/**
+ * AT client stubs required to link the AT server bridge in the AT server benchmark, which does not
+ * open any bridge.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Connect the current client thread to the service providing this API stub.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_atClient_ConnectService
+(
+    void
+)
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start a AT client session on a device stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_atClient_DeviceRef_t le_atClient_Start
+(
+    int32_t fd
+)
+{
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop a AT client session stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_atClient_Stop
+(
+    le_atClient_DeviceRef_t devRef
+)
+{
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set and send an AT command stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_atClient_SetCommandAndSend
+(
+    le_atClient_CmdRef_t*   cmdRefPtr,
+    le_atClient_DeviceRef_t devRef,
+    const char*             commandPtr,
+    const char*             interRespPtr,
+    const char*             finalRespPtr,
+    uint32_t                timeout
+)
+{
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the first intermediate response stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_atClient_GetFirstIntermediateResponse
+(
+    le_atClient_CmdRef_t cmdRef,
+    char*                intermediateRspPtr,
+    size_t               intermediateRspNumElements
+)
+{
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the next intermediate response stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_atClient_GetNextIntermediateResponse
+(
+    le_atClient_CmdRef_t cmdRef,
+    char*                intermediateRspPtr,
+    size_t               intermediateRspNumElements
+)
+{
+    return LE_NOT_FOUND;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the final response stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_atClient_GetFinalResponse
+(
+    le_atClient_CmdRef_t cmdRef,
+    char*                finalRspPtr,
+    size_t               finalRspNumElements
+)
+{
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add an unsolicited response handler stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_atClient_UnsolicitedResponseHandlerRef_t le_atClient_AddUnsolicitedResponseHandler
+(
+    const char*                                  unsolRsp,
+    le_atClient_DeviceRef_t                      devRef,
+    le_atClient_UnsolicitedResponseHandlerFunc_t handlerPtr,
+    void*                                        contextPtr,
+    uint32_t                                     lineCount
+)
+{
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove an unsolicited response handler stub.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_atClient_RemoveUnsolicitedResponseHandler
+(
+    le_atClient_UnsolicitedResponseHandlerRef_t addHandlerRef
+)
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete an AT command reference stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_atClient_Delete
+(
+    le_atClient_CmdRef_t cmdRef
+)
+{
+    return LE_OK;
+}
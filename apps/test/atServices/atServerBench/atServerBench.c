@@ -0,0 +1,375 @@
+/**
+ * Replay benchmark of the AT server: a transcript of AT command lines, as captured on the link of a
+ * host setting up a modem, is replayed through le_atServer and the number of commands and lines
+ * handled per second is printed.
+ *
+ * The AT server runs on the main thread, on one end of a unix socket.  A host thread writes the
+ * transcript to the other end as fast as the socket takes it and counts the final responses.  The
+ * command handlers get all the parameters and reply at once, so the time measured is the time
+ * spent by the AT server to receive, tokenize and dispatch the commands.  The CPU time of the
+ * server thread is printed as well, as it is less dependent on the scheduling of the threads.
+ *
+ * Usage: atServerBench [ROUNDS [TRANSCRIPT_FILE]]
+ *
+ * The transcript file holds one command line per line; the built-in transcript is used by
+ * default.  Every line of the transcript must get an OK final response.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+
+#define DEV_PATH            "\0at-bench"
+#define DEFAULT_ROUNDS      2000
+#define DSIZE               4096    // Size of the buffers of the host
+#define LINE_MAX_LEN        (LE_ATDEFS_COMMAND_MAX_LEN - 1)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Built-in transcript.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* const DefaultTranscript[] =
+{
+    "ATE0V1",
+    "AT+CMEE=1;+CREG=2;+CGREG=2;+CEREG=2",
+    "AT+CPIN?",
+    "AT+CGSN;+CIMI",
+    "ATI",
+    "AT+CFUN=1",
+    "AT+CGDCONT=1,\"IPV4V6\",\"internet.operator.example.com\",\"0.0.0.0\",0,0",
+    "AT+CGDCONT=2,\"IP\",\"ims\",,0,0;+CGDCONT?",
+    "AT+COPS=3,2;+COPS?",
+    "AT+CSQ;+CREG?;+CGREG?;+CEREG?",
+    "AT+CMGF=0;+CNMI=2,1,0,2,0;+CPMS=\"ME\",\"ME\",\"ME\"",
+    "at&f;&c1;&d2",
+    "ATS0=0",
+    "AT+CCLK?",
+    "AT+CGACT=1,1;+CGACT?",
+    "AT+CGPADDR=1",
+    "at+csq",
+    "AT+CGDCONT=3,\"IPV6\",\"a.very.long.access.point.name.of.the.operator.example.com\""
+        ",\"0.0.0.0\",0,0,0,0,0,0,1,0,0,0",
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * AT commands created on the server.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* const Commands[] =
+{
+    "ATE", "ATV", "ATI", "ATS", "AT&F", "AT&C", "AT&D",
+    "AT+CMEE", "AT+CREG", "AT+CGREG", "AT+CEREG", "AT+CPIN", "AT+CGSN", "AT+CIMI", "AT+CFUN",
+    "AT+CGDCONT", "AT+COPS", "AT+CSQ", "AT+CMGF", "AT+CNMI", "AT+CPMS", "AT+CCLK", "AT+CGACT",
+    "AT+CGPADDR",
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Transcript replayed, all the rounds in a row.
+ */
+//--------------------------------------------------------------------------------------------------
+static char* ReplayPtr;
+static size_t ReplaySize;
+static uint32_t ReplayLines;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of commands handled by the server.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t CommandCount;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Thread of the server, and its CPU time when the replay starts.
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_t ServerThread;
+static struct timespec ServerStartTime;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Semaphore posted by the server once it is ready.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_sem_Ref_t ReadySemRef;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * AT command handler: get the parameters and reply.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CmdHandler
+(
+    le_atServer_CmdRef_t commandRef,
+    le_atServer_Type_t   type,
+    uint32_t             parametersNumber,
+    void*                contextPtr
+)
+{
+    char param[LE_ATDEFS_PARAMETER_MAX_BYTES];
+    uint32_t i;
+
+    for (i = 0; i < parametersNumber; i++)
+    {
+        LE_ASSERT_OK(le_atServer_GetParameter(commandRef, i, param, sizeof(param)));
+    }
+    if (LE_ATSERVER_TYPE_READ == type)
+    {
+        LE_ASSERT_OK(le_atServer_SendIntermediateResponse(commandRef, "+READ: 0"));
+    }
+    CommandCount++;
+    LE_ASSERT_OK(le_atServer_SendFinalResultCode(commandRef, LE_ATSERVER_OK, "", 0));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a line to the transcript replayed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddLine
+(
+    char*       bufPtr,     ///< [IN] Buffer to add the line to, NULL to get the size only
+    size_t*     offsetPtr,  ///< [IN/OUT] Offset of the line in the buffer
+    const char* linePtr     ///< [IN] Line, without the end of line
+)
+{
+    size_t len = strcspn(linePtr, "\r\n");
+
+    LE_FATAL_IF(len > LINE_MAX_LEN, "Line too long: %s", linePtr);
+    if (0 == len)
+    {
+        return;
+    }
+    if (bufPtr)
+    {
+        memcpy(bufPtr + *offsetPtr, linePtr, len);
+        bufPtr[*offsetPtr + len] = '\r';
+        ReplayLines++;
+    }
+    *offsetPtr += len + 1;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build the transcript replayed, from the transcript file or the built-in one.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BuildReplay
+(
+    uint32_t    rounds,     ///< [IN] Number of times the transcript is replayed
+    const char* pathPtr     ///< [IN] Transcript file, NULL for the built-in one
+)
+{
+    char line[LE_ATDEFS_COMMAND_MAX_LEN + 2];
+    size_t size = 0;
+    uint32_t round;
+    int pass;
+
+    // First pass to get the size of the replay, second one to fill it
+    for (pass = 0; pass < 2; pass++)
+    {
+        for (round = 0; round < rounds; round++)
+        {
+            if (pathPtr)
+            {
+                FILE* filePtr = fopen(pathPtr, "r");
+
+                LE_FATAL_IF(NULL == filePtr, "Cannot open %s: %m", pathPtr);
+                while (fgets(line, sizeof(line), filePtr))
+                {
+                    AddLine(ReplayPtr, &size, line);
+                }
+                fclose(filePtr);
+            }
+            else
+            {
+                size_t i;
+
+                for (i = 0; i < NUM_ARRAY_MEMBERS(DefaultTranscript); i++)
+                {
+                    AddLine(ReplayPtr, &size, DefaultTranscript[i]);
+                }
+            }
+        }
+        if (0 == pass)
+        {
+            LE_FATAL_IF(0 == size, "Empty transcript");
+            ReplaySize = size;
+            ReplayPtr = malloc(size);
+            LE_ASSERT(ReplayPtr);
+            size = 0;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Count the final responses in the data received by the host.
+ *
+ * @return The number of lines answered by an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t CountFinalResponses
+(
+    const char* dataPtr,    ///< [IN] Data received
+    size_t      size,       ///< [IN] Size of the data
+    uint32_t*   countPtr    ///< [IN/OUT] Final responses received
+)
+{
+    static char line[DSIZE];
+    static size_t lineLen;
+    uint32_t errors = 0;
+    size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        if ('\n' != dataPtr[i])
+        {
+            if (lineLen < sizeof(line) - 1)
+            {
+                line[lineLen++] = dataPtr[i];
+            }
+            continue;
+        }
+        line[lineLen] = '\0';
+        if (0 == strcmp(line, "OK\r"))
+        {
+            (*countPtr)++;
+        }
+        else if (0 == strcmp(line, "ERROR\r"))
+        {
+            (*countPtr)++;
+            errors++;
+        }
+        lineLen = 0;
+    }
+    return errors;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Host thread: replay the transcript and wait for all the final responses.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* Host
+(
+    void* contextPtr
+)
+{
+    struct sockaddr_un addr;
+    char buf[DSIZE];
+    size_t written = 0;
+    uint32_t finalCount = 0;
+    uint32_t errors = 0;
+    int fd;
+
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    LE_ASSERT(-1 != fd);
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, DEV_PATH, sizeof(DEV_PATH));
+    LE_FATAL_IF(-1 == connect(fd, (struct sockaddr*)&addr, sizeof(addr)), "connect failed: %m");
+
+    le_sem_Wait(ReadySemRef);
+
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+
+    while (finalCount < ReplayLines)
+    {
+        struct pollfd pollFd = { .fd = fd, .events = POLLIN };
+        ssize_t size;
+
+        if (written < ReplaySize)
+        {
+            pollFd.events |= POLLOUT;
+        }
+        LE_FATAL_IF((-1 == poll(&pollFd, 1, -1)) && (EINTR != errno), "poll failed: %m");
+        LE_FATAL_IF(pollFd.revents & (POLLERR | POLLHUP), "Connection closed");
+
+        if (pollFd.revents & POLLOUT)
+        {
+            size = write(fd, ReplayPtr + written, ReplaySize - written);
+            LE_FATAL_IF((size < 0) && (EAGAIN != errno) && (EINTR != errno),
+                        "write failed: %m");
+            written += (size > 0 ? size : 0);
+        }
+        if (pollFd.revents & POLLIN)
+        {
+            size = read(fd, buf, sizeof(buf));
+            LE_FATAL_IF((size < 0) && (EAGAIN != errno) && (EINTR != errno),
+                        "read failed: %m");
+            LE_FATAL_IF(0 == size, "Connection closed");
+            if (size > 0)
+            {
+                errors += CountFinalResponses(buf, size, &finalCount);
+            }
+        }
+    }
+
+    le_clk_Time_t time = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+    double seconds = time.sec + (time.usec / 1e6);
+    struct timespec serverTime;
+    clockid_t clockId;
+
+    LE_ASSERT(0 == pthread_getcpuclockid(ServerThread, &clockId));
+    LE_ASSERT(0 == clock_gettime(clockId, &serverTime));
+
+    double serverSeconds = (serverTime.tv_sec - ServerStartTime.tv_sec) +
+                           ((serverTime.tv_nsec - ServerStartTime.tv_nsec) / 1e9);
+
+    printf("%u lines, %u commands in %.3f s: %.0f commands/s, %.0f lines/s\n",
+           ReplayLines, CommandCount, seconds, CommandCount / seconds, ReplayLines / seconds);
+    printf("server CPU time %.3f s: %.3f us/command\n",
+           serverSeconds, serverSeconds * 1e6 / CommandCount);
+    LE_FATAL_IF(errors, "%u lines answered by ERROR", errors);
+    exit(EXIT_SUCCESS);
+    return NULL;
+}
+
+COMPONENT_INIT
+{
+    struct sockaddr_un addr;
+    uint32_t rounds = DEFAULT_ROUNDS;
+    size_t i;
+    int socketFd;
+    int connFd;
+
+    if (le_arg_NumArgs() >= 1)
+    {
+        rounds = atoi(le_arg_GetArg(0));
+    }
+    LE_ASSERT(rounds > 0);
+    BuildReplay(rounds, (le_arg_NumArgs() >= 2) ? le_arg_GetArg(1) : NULL);
+
+    socketFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    LE_ASSERT(-1 != socketFd);
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, DEV_PATH, sizeof(DEV_PATH));
+    LE_FATAL_IF(-1 == bind(socketFd, (struct sockaddr*)&addr, sizeof(addr)), "bind failed: %m");
+    LE_ASSERT(-1 != listen(socketFd, 1));
+
+    ReadySemRef = le_sem_Create("AtBenchSem", 0);
+    le_thread_Start(le_thread_Create("AtBenchHost", Host, NULL));
+
+    connFd = accept(socketFd, NULL, NULL);
+    LE_ASSERT(-1 != connFd);
+    close(socketFd);
+    LE_ASSERT(le_atServer_Open(connFd));
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(Commands); i++)
+    {
+        le_atServer_CmdRef_t cmdRef = le_atServer_Create(Commands[i]);
+
+        LE_ASSERT(cmdRef);
+        LE_ASSERT(le_atServer_AddCommandHandler(cmdRef, CmdHandler, NULL));
+    }
+
+    ServerThread = pthread_self();
+    LE_ASSERT(0 == clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ServerStartTime));
+    le_sem_Post(ReadySemRef);
+}
@@ -0,0 +1,512 @@
+/**
+ * Differential test of the AT server parser: fuzzed AT command lines are replayed through
+ * le_atServer and the responses are written to a file.
+ *
+ * The test is built twice: once with the run-based parser, once with LE_ATSERVER_CHAR_PARSER
+ * defined so that the command lines are parsed one character at a time.  atServerParserTest.sh
+ * runs both builds on the same lines and checks the responses are identical.
+ *
+ * The lines are generated from a fixed seed: basic and extended commands in random case,
+ * concatenated with or without ';', with numeric, quoted, empty or too long parameters, unknown
+ * commands, stray characters and characters erased with the delete character.  Each line is
+ * written in a few chunks and its responses are read up to the final result code before the next
+ * line is sent.  The command handlers send back the name, type and parameters of the commands.
+ *
+ * Usage: atServerParserTest RESPONSE_FILE [LINES [SEED]]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+
+#define DEFAULT_LINES       5000
+#define DEFAULT_SEED        1
+#define RESPONSE_TIMEOUT    5000    // Time to wait for the final response of a line, in ms
+#define DSIZE               4096    // Size of the buffers of the host
+#define LINE_MAX_LEN        (LE_ATDEFS_COMMAND_MAX_LEN - 1)
+#define DELETE              0x7f
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Basic commands created on the server, without the "AT" prefix.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* const BasicCommands[] =
+{
+    "E", "V", "I", "Q", "Z", "S", "&F", "&C", "&D", "&W",
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Extended commands created on the server, without the "AT" prefix.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* const ExtCommands[] =
+{
+    "+CMEE", "+CREG", "+CGREG", "+CPIN", "+CGSN", "+CFUN", "+CGDCONT", "+COPS", "+CSQ", "+CPMS",
+    "+CGACT", "+ABCD", "+A", "+CMGS",
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Characters used for the stray characters, the unknown command names and the quoted strings.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char FuzzChars[] = "ABCDEFabcdefXYZxyz0123456789+-*#&%=?,;\" .:/_";
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * State of the pseudo-random generator (xorshift32), so that the lines only depend on the seed.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t RandState;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Lines replayed, and their seed.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t LineCount = DEFAULT_LINES;
+static uint32_t Seed = DEFAULT_SEED;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * File the responses are written to.
+ */
+//--------------------------------------------------------------------------------------------------
+static FILE* ResponseFilePtr;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Host end of the socket pair.
+ */
+//--------------------------------------------------------------------------------------------------
+static int HostFd;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a pseudo-random number lower than max.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t Rand
+(
+    uint32_t max
+)
+{
+    RandState ^= RandState << 13;
+    RandState ^= RandState >> 17;
+    RandState ^= RandState << 5;
+
+    return RandState % max;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a character to the line being generated, if it fits.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddChar
+(
+    char*   linePtr,    ///< [IN/OUT] Line
+    size_t* lenPtr,     ///< [IN/OUT] Length of the line
+    char    c           ///< [IN] Character to append
+)
+{
+    if (*lenPtr < LINE_MAX_LEN)
+    {
+        linePtr[(*lenPtr)++] = c;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a string to the line being generated, in random case if asked.  Stray characters and
+ * erased characters are inserted now and then.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddString
+(
+    char*       linePtr,    ///< [IN/OUT] Line
+    size_t*     lenPtr,     ///< [IN/OUT] Length of the line
+    const char* strPtr,     ///< [IN] String to append
+    bool        mixCase     ///< [IN] Put the letters in random case
+)
+{
+    for (; *strPtr; strPtr++)
+    {
+        char c = *strPtr;
+
+        if (mixCase && isalpha((unsigned char)c) && Rand(2))
+        {
+            c = islower((unsigned char)c) ? toupper(c) : tolower(c);
+        }
+        switch (Rand(60))
+        {
+            case 0:
+                // Stray character
+                AddChar(linePtr, lenPtr, FuzzChars[Rand(sizeof(FuzzChars) - 1)]);
+            break;
+            case 1:
+            case 2:
+                // Characters erased right away
+                AddChar(linePtr, lenPtr, FuzzChars[Rand(sizeof(FuzzChars) - 1)]);
+                AddChar(linePtr, lenPtr, DELETE);
+                if (Rand(2))
+                {
+                    AddChar(linePtr, lenPtr, FuzzChars[Rand(sizeof(FuzzChars) - 1)]);
+                    AddChar(linePtr, lenPtr, FuzzChars[Rand(sizeof(FuzzChars) - 1)]);
+                    AddChar(linePtr, lenPtr, DELETE);
+                    AddChar(linePtr, lenPtr, DELETE);
+                }
+            break;
+            default:
+            break;
+        }
+        AddChar(linePtr, lenPtr, c);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a parameter of an extended command to the line being generated.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddParam
+(
+    char*   linePtr,    ///< [IN/OUT] Line
+    size_t* lenPtr      ///< [IN/OUT] Length of the line
+)
+{
+    static const char* const Numbers[] = { "0", "1", "12", "255", "-1", "+3", "0x1F", "*#", "ab" };
+    char str[LE_ATDEFS_PARAMETER_MAX_BYTES + 32];
+    uint32_t len;
+    uint32_t i;
+
+    switch (Rand(8))
+    {
+        case 0:
+            // Empty parameter
+        break;
+        case 1:
+        case 2:
+        case 3:
+            AddString(linePtr, lenPtr, Numbers[Rand(NUM_ARRAY_MEMBERS(Numbers))], true);
+        break;
+        default:
+            // Quoted string, sometimes too long or not closed
+            len = (Rand(20) == 0) ? Rand(sizeof(str) - 1) : Rand(16);
+            for (i = 0; i < len; i++)
+            {
+                str[i] = FuzzChars[Rand(sizeof(FuzzChars) - 1)];
+                if ('"' == str[i])
+                {
+                    str[i] = 'q';
+                }
+            }
+            str[len] = '\0';
+            AddChar(linePtr, lenPtr, '"');
+            AddString(linePtr, lenPtr, str, false);
+            if (Rand(30))
+            {
+                AddChar(linePtr, lenPtr, '"');
+            }
+        break;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a command to the line being generated.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddCommand
+(
+    char*   linePtr,    ///< [IN/OUT] Line
+    size_t* lenPtr,     ///< [IN/OUT] Length of the line
+    bool    first       ///< [IN] First command of the line
+)
+{
+    static const char* const Suffixes[] = { "", "?", "=?", "=" };
+    char name[8];
+    uint32_t i;
+
+    switch (Rand(10))
+    {
+        case 0:
+        case 1:
+        case 2:
+            // Basic command, with an optional numeric parameter
+            if ((!first) && Rand(2))
+            {
+                AddChar(linePtr, lenPtr, ';');
+            }
+            AddString(linePtr, lenPtr, BasicCommands[Rand(NUM_ARRAY_MEMBERS(BasicCommands))],
+                      true);
+            switch (Rand(4))
+            {
+                case 0:
+                break;
+                case 1:
+                    AddChar(linePtr, lenPtr, '0' + Rand(10));
+                break;
+                case 2:
+                    AddString(linePtr, lenPtr, Rand(2) ? "0=1" : "7?", false);
+                break;
+                default:
+                    AddString(linePtr, lenPtr, Suffixes[Rand(NUM_ARRAY_MEMBERS(Suffixes))],
+                              false);
+                break;
+            }
+        break;
+        case 3:
+            // Dial command, always the last one of the line
+            AddString(linePtr, lenPtr, Rand(2) ? "D*99***1#" : "d+33123456789;", true);
+        break;
+        default:
+            // Extended command, known or not
+            if (!first)
+            {
+                AddChar(linePtr, lenPtr, ';');
+            }
+            if (Rand(8))
+            {
+                AddString(linePtr, lenPtr, ExtCommands[Rand(NUM_ARRAY_MEMBERS(ExtCommands))],
+                          true);
+            }
+            else
+            {
+                name[0] = '+';
+                for (i = 1; i < sizeof(name) - 1; i++)
+                {
+                    name[i] = FuzzChars[Rand(sizeof(FuzzChars) - 1)];
+                }
+                name[1 + Rand(sizeof(name) - 2)] = '\0';
+                AddString(linePtr, lenPtr, name, true);
+            }
+            i = Rand(NUM_ARRAY_MEMBERS(Suffixes));
+            AddString(linePtr, lenPtr, Suffixes[i], false);
+            if (3 == i)
+            {
+                uint32_t paramCount = 1 + Rand(5);
+
+                for (i = 0; i < paramCount; i++)
+                {
+                    if (i)
+                    {
+                        AddChar(linePtr, lenPtr, ',');
+                    }
+                    AddParam(linePtr, lenPtr);
+                }
+            }
+        break;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Generate the next line, without the end of line.
+ *
+ * @return Length of the line.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t GenerateLine
+(
+    char* linePtr   ///< [OUT] Line, of at least LINE_MAX_LEN bytes
+)
+{
+    static const char* const Prefixes[] = { "AT", "at", "At", "aT" };
+    uint32_t cmdCount = 1 + Rand(4);
+    size_t len = 0;
+    uint32_t i;
+
+    memcpy(linePtr, Prefixes[Rand(NUM_ARRAY_MEMBERS(Prefixes))], 2);
+    len = 2;
+
+    for (i = 0; i < cmdCount; i++)
+    {
+        AddCommand(linePtr, &len, (0 == i));
+    }
+
+    return len;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * AT command handler: send back the name, type and parameters of the command.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CmdHandler
+(
+    le_atServer_CmdRef_t commandRef,
+    le_atServer_Type_t   type,
+    uint32_t             parametersNumber,
+    void*                contextPtr
+)
+{
+    char name[LE_ATDEFS_PARAMETER_MAX_BYTES];    // Large enough for the commands created
+    char param[LE_ATDEFS_PARAMETER_MAX_BYTES];
+    char rsp[LE_ATDEFS_RESPONSE_MAX_BYTES];
+    uint32_t i;
+
+    LE_ASSERT_OK(le_atServer_GetCommandName(commandRef, name, sizeof(name)));
+    snprintf(rsp, sizeof(rsp), "+CMD: %s,%d,%" PRIu32, name, type, parametersNumber);
+    LE_ASSERT_OK(le_atServer_SendIntermediateResponse(commandRef, rsp));
+
+    for (i = 0; i < parametersNumber; i++)
+    {
+        LE_ASSERT_OK(le_atServer_GetParameter(commandRef, i, param, sizeof(param)));
+        snprintf(rsp, sizeof(rsp), "+PARAM: \"%s\"", param);
+        LE_ASSERT_OK(le_atServer_SendIntermediateResponse(commandRef, rsp));
+    }
+
+    LE_ASSERT_OK(le_atServer_SendFinalResultCode(commandRef, LE_ATSERVER_OK, "", 0));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a line to the server, in a few chunks.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteLine
+(
+    const char* linePtr,    ///< [IN] Line, with the end of line
+    size_t      len         ///< [IN] Length of the line
+)
+{
+    while (len)
+    {
+        size_t chunkLen = (Rand(3) == 0) ? 1 + Rand(len) : len;
+        ssize_t size = write(HostFd, linePtr, chunkLen);
+
+        LE_FATAL_IF((size < 0) && (EINTR != errno), "write failed: %m");
+        if (size > 0)
+        {
+            linePtr += size;
+            len -= size;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the responses to a line up to its final result code, and write them to the response file.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReadResponses
+(
+    uint32_t lineNum    ///< [IN] Number of the line, for the error messages
+)
+{
+    char line[DSIZE];
+    size_t lineLen = 0;
+    bool final = false;
+
+    while (!final)
+    {
+        struct pollfd pollFd = { .fd = HostFd, .events = POLLIN };
+        char c;
+        int ret = poll(&pollFd, 1, RESPONSE_TIMEOUT);
+
+        LE_FATAL_IF((-1 == ret) && (EINTR != errno), "poll failed: %m");
+        LE_FATAL_IF(0 == ret, "No final response to line %" PRIu32, lineNum);
+        if (1 != ret)
+        {
+            continue;
+        }
+
+        // One character at a time, not to read the responses to the next line
+        LE_FATAL_IF(1 != read(HostFd, &c, 1), "read failed: %m");
+        fputc(c, ResponseFilePtr);
+        if ('\n' != c)
+        {
+            if (lineLen < sizeof(line) - 1)
+            {
+                line[lineLen++] = c;
+            }
+            continue;
+        }
+        line[lineLen] = '\0';
+        final = ((0 == strcmp(line, "OK\r")) || (0 == strcmp(line, "ERROR\r")));
+        lineLen = 0;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Host thread: replay the lines and write their responses to the response file.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* Host
+(
+    void* contextPtr
+)
+{
+    char line[LINE_MAX_LEN + 1];
+    uint32_t i;
+
+    RandState = Seed;
+    for (i = 0; i < LineCount; i++)
+    {
+        size_t len = GenerateLine(line);
+
+        fprintf(ResponseFilePtr, "%.*s\n", (int)len, line);
+        line[len++] = '\r';
+        WriteLine(line, len);
+        ReadResponses(i);
+    }
+
+    LE_ASSERT(0 == fclose(ResponseFilePtr));
+    LE_INFO("%" PRIu32 " lines replayed", LineCount);
+    exit(EXIT_SUCCESS);
+    return NULL;
+}
+
+COMPONENT_INIT
+{
+    int fds[2];
+    size_t i;
+
+    LE_FATAL_IF(le_arg_NumArgs() < 1, "Usage: atServerParserTest RESPONSE_FILE [LINES [SEED]]");
+    ResponseFilePtr = fopen(le_arg_GetArg(0), "w");
+    LE_FATAL_IF(NULL == ResponseFilePtr, "Cannot open %s: %m", le_arg_GetArg(0));
+    if (le_arg_NumArgs() >= 2)
+    {
+        LineCount = strtoul(le_arg_GetArg(1), NULL, 0);
+    }
+    if (le_arg_NumArgs() >= 3)
+    {
+        Seed = strtoul(le_arg_GetArg(2), NULL, 0);
+    }
+    LE_ASSERT(Seed != 0);
+
+    LE_ASSERT(0 == socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+    HostFd = fds[0];
+    LE_ASSERT(le_atServer_Open(fds[1]));
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(BasicCommands); i++)
+    {
+        char name[LE_ATDEFS_COMMAND_MAX_BYTES];
+        le_atServer_CmdRef_t cmdRef;
+
+        snprintf(name, sizeof(name), "AT%s", BasicCommands[i]);
+        cmdRef = le_atServer_Create(name);
+        LE_ASSERT(cmdRef);
+        LE_ASSERT(le_atServer_AddCommandHandler(cmdRef, CmdHandler, NULL));
+    }
+    for (i = 0; i < NUM_ARRAY_MEMBERS(ExtCommands); i++)
+    {
+        char name[LE_ATDEFS_COMMAND_MAX_BYTES];
+        le_atServer_CmdRef_t cmdRef;
+
+        snprintf(name, sizeof(name), "AT%s", ExtCommands[i]);
+        cmdRef = le_atServer_Create(name);
+        LE_ASSERT(cmdRef);
+        LE_ASSERT(le_atServer_AddCommandHandler(cmdRef, CmdHandler, NULL));
+    }
+    le_atServer_CmdRef_t cmdRef = le_atServer_Create("ATD");
+    LE_ASSERT(cmdRef);
+    LE_ASSERT(le_atServer_AddCommandHandler(cmdRef, CmdHandler, NULL));
+
+    le_thread_Start(le_thread_Create("AtParserTestHost", Host, NULL));
+}
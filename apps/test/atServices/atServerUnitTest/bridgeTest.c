@@ -31,6 +31,7 @@ AtCommandDesc_t;
  */
 //--------------------------------------------------------------------------------------------------
 static const char AtPlusCgdcontPara[] = "AT+CGDCONT=1,\"I,P\",\"orange\"";
+static const char AtPlusCgdcontLongPara[] = "AT+CGDCONT=2,";
 static const char AtPlusCpinRead[] = "AT+CPIN?";
 static const char AtPlusCgdcontRead[] = "AT+CGDCONT?";
 static const char AtPlusCgdcontTest[] = "AT+CGDCONT=?";
@@ -55,6 +56,12 @@ static AtCommandDesc_t AtCommandList[] = {
         .finalRspPtr = OkRsp,
         .readIndex = 0
     },
+    {
+        .commandNamePtr = AtPlusCgdcontLongPara,
+        .intermediateRspPtr = { NULL },
+        .finalRspPtr = OkRsp,
+        .readIndex = 0
+    },
     {
         .commandNamePtr = AtPlusCpinRead,
         .intermediateRspPtr = { "+CPIN: READY", NULL },
@@ -506,6 +513,8 @@ le_result_t Testle_atServer_Bridge
     LE_INFO("======== Test AT server bridge API ========");
     le_result_t ret;
     le_atServer_BridgeRef_t bridgeRef = NULL;
+    char longParam[LE_ATDEFS_PARAMETER_MAX_BYTES];
+    char longCmd[LE_ATDEFS_COMMAND_MAX_BYTES];
 
     BridgeSemaphore = le_sem_Create("BridgeSem", 0);
 
@@ -533,6 +542,32 @@ le_result_t Testle_atServer_Bridge
         return ret;
     }
 
+    // A quoted parameter which fills the parameter buffer, quotes included, is bridged
+    memset(longParam, 'A', LE_ATDEFS_PARAMETER_MAX_LEN - 2);
+    longParam[LE_ATDEFS_PARAMETER_MAX_LEN - 2] = '\0';
+    snprintf(longCmd, sizeof(longCmd), "%s\"%s\"", AtPlusCgdcontLongPara, longParam);
+
+    ret = SendCommandsAndTest(socketFd, epollFd, longCmd,
+                "\r\nOK\r\n");
+
+    if (ret != LE_OK)
+    {
+        return ret;
+    }
+
+    // One more character leaves no room for the closing quote
+    memset(longParam, 'A', LE_ATDEFS_PARAMETER_MAX_LEN - 1);
+    longParam[LE_ATDEFS_PARAMETER_MAX_LEN - 1] = '\0';
+    snprintf(longCmd, sizeof(longCmd), "%s\"%s\"", AtPlusCgdcontLongPara, longParam);
+
+    ret = SendCommandsAndTest(socketFd, epollFd, longCmd,
+                "\r\nERROR\r\n");
+
+    if (ret != LE_OK)
+    {
+        return ret;
+    }
+
     ret = SendCommandsAndTest(socketFd, epollFd, AtPlusBad,
                 "\r\nERROR\r\n");
 
@@ -0,0 +1,417 @@
+/**
+ * Benchmark of the signal processing kernels of the audio service.
+ *
+ * Each kernel processes the same samples as the scalar code it replaces, e.g. the per-sample
+ * sin() calls that used to generate the DTMF in le_media.c, and the throughput of both is
+ * printed in millions of samples per second.  The scalar code is also used as a reference: the
+ * outputs must be identical, or within two quantization steps for the tones, which are computed
+ * with a different rounding.
+ *
+ * Usage: audioDspBench [SECONDS]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "audioDsp.h"
+
+#include <math.h>
+
+#define DEFAULT_SECONDS     1
+#define BLOCK_SAMPLES       8000        // 1 second of a narrowband stream
+#define SAMPLE_RATE         8000
+#define DTMF_AMPLITUDE      13106       // Amplitude of the DTMF of le_media.c (40%)
+#define TONE_TOLERANCE      2
+#define GAIN                2867        // 0.7 in Q12
+
+#if !defined (PI)
+#define PI 3.14159265358979323846264338327
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Kernel under test: processes BLOCK_SAMPLES samples, from InSamples to the output buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*Kernel_t)(int16_t* outPtr);
+
+static double Seconds = DEFAULT_SECONDS;
+
+static int16_t InSamples[2 * BLOCK_SAMPLES];
+static uint8_t InBytes[3 * BLOCK_SAMPLES];
+static int32_t InWords[BLOCK_SAMPLES];
+static int16_t RefSamples[2 * BLOCK_SAMPLES];
+static int16_t DspSamples[2 * BLOCK_SAMPLES];
+
+// Digits of the DTMF, by frequencies.
+static const uint32_t LowFreqs[] = { 697, 770, 852, 941 };
+static const uint32_t HighFreqs[] = { 1209, 1336, 1477, 1633 };
+static size_t Digit;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the monotonic time in nanoseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Saturate a 32-bit value to 16 bits, as le_media.c did.
+ */
+//--------------------------------------------------------------------------------------------------
+static int16_t RefSaturate16(int32_t value)
+{
+    if (value > 32767)
+    {
+        return 32767;
+    }
+    else if (value < -32768)
+    {
+        return -32768;
+    }
+    return value;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * DTMF generation: a sin() call per sample and tone.  le_media.c computed the frequency ratios
+ * in single precision, which put the phase off by up to 3e-4 radians after 1 second: the reference
+ * computes them in double precision.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RefDualTone(int16_t* outPtr)
+{
+    double d1 = (double)LowFreqs[Digit % 4] / SAMPLE_RATE;
+    double d2 = (double)HighFreqs[Digit / 4] / SAMPLE_RATE;
+    uint32_t i;
+
+    for (i = 0; i < BLOCK_SAMPLES; i++)
+    {
+        int16_t s1 = (int16_t)(DTMF_AMPLITUDE * sin(2 * PI * d1 * i));
+        int16_t s2 = (int16_t)(DTMF_AMPLITUDE * sin(2 * PI * d2 * i));
+
+        outPtr[i] = RefSaturate16(s1 + s2);
+    }
+}
+
+static void DspDualTone(int16_t* outPtr)
+{
+    audioDsp_Tone_t tone1;
+    audioDsp_Tone_t tone2;
+
+    audioDsp_InitTone(&tone1, LowFreqs[Digit % 4], SAMPLE_RATE, DTMF_AMPLITUDE);
+    audioDsp_InitTone(&tone2, HighFreqs[Digit / 4], SAMPLE_RATE, DTMF_AMPLITUDE);
+    audioDsp_GenerateDualTone(&tone1, &tone2, outPtr, BLOCK_SAMPLES);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mixing of two streams.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RefMix(int16_t* outPtr)
+{
+    size_t i;
+
+    for (i = 0; i < BLOCK_SAMPLES; i++)
+    {
+        outPtr[i] = RefSaturate16(InSamples[i] + InSamples[BLOCK_SAMPLES + i]);
+    }
+}
+
+static void DspMix(int16_t* outPtr)
+{
+    memcpy(outPtr, InSamples, BLOCK_SAMPLES * sizeof(int16_t));
+    audioDsp_Mix(outPtr, InSamples + BLOCK_SAMPLES, BLOCK_SAMPLES);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gain.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RefGain(int16_t* outPtr)
+{
+    size_t i;
+
+    for (i = 0; i < BLOCK_SAMPLES; i++)
+    {
+        outPtr[i] = RefSaturate16((InSamples[i] * GAIN) >> 12);
+    }
+}
+
+static void DspGain(int16_t* outPtr)
+{
+    memcpy(outPtr, InSamples, BLOCK_SAMPLES * sizeof(int16_t));
+    audioDsp_ApplyGain(outPtr, BLOCK_SAMPLES, GAIN);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Channel conversions.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RefMonoToStereo(int16_t* outPtr)
+{
+    size_t i;
+
+    for (i = 0; i < BLOCK_SAMPLES; i++)
+    {
+        *(outPtr++) = InSamples[i];
+        *(outPtr++) = InSamples[i];
+    }
+}
+
+static void DspMonoToStereo(int16_t* outPtr)
+{
+    audioDsp_MonoToStereo(InSamples, outPtr, BLOCK_SAMPLES);
+}
+
+static void RefStereoToMono(int16_t* outPtr)
+{
+    size_t i;
+
+    for (i = 0; i < BLOCK_SAMPLES / 2; i++)
+    {
+        outPtr[i] = (InSamples[2 * i] + InSamples[2 * i + 1]) >> 1;
+    }
+}
+
+static void DspStereoToMono(int16_t* outPtr)
+{
+    audioDsp_StereoToMono(InSamples, outPtr, BLOCK_SAMPLES / 2);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sample rate conversion from 8 kHz to 16 kHz, then from 16 kHz to 8 kHz.  The reference
+ * interpolates between the two input samples around each output sample, in floating point.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RefResample(int16_t* outPtr, uint32_t inRate, uint32_t outRate, size_t inCount)
+{
+    size_t outCount = inCount * outRate / inRate;
+    size_t i;
+
+    for (i = 0; i < outCount; i++)
+    {
+        double position = (double)i * inRate / outRate;
+        size_t index = (size_t)position;
+        double frac = position - index;
+        int32_t after = (index + 1 < inCount) ? InSamples[index + 1] : InSamples[index];
+
+        outPtr[i] = (int16_t)floor(InSamples[index] + (after - InSamples[index]) * frac);
+    }
+}
+
+static void RefUpsample(int16_t* outPtr)
+{
+    RefResample(outPtr, SAMPLE_RATE, 2 * SAMPLE_RATE, BLOCK_SAMPLES);
+}
+
+static void DspUpsample(int16_t* outPtr)
+{
+    audioDsp_Resampler_t resampler;
+
+    audioDsp_InitResampler(&resampler, SAMPLE_RATE, 2 * SAMPLE_RATE);
+    // The last two output samples need the sample after the block: repeat the last one, as the
+    // reference does.
+    LE_ASSERT(audioDsp_Resample(&resampler, InSamples, BLOCK_SAMPLES, outPtr, 2 * BLOCK_SAMPLES)
+              == 2 * BLOCK_SAMPLES - 2);
+    LE_ASSERT(audioDsp_Resample(&resampler, InSamples + BLOCK_SAMPLES - 1, 1,
+                                outPtr + 2 * BLOCK_SAMPLES - 2, 2) == 2);
+}
+
+static void RefDownsample(int16_t* outPtr)
+{
+    RefResample(outPtr, 2 * SAMPLE_RATE, SAMPLE_RATE, 2 * BLOCK_SAMPLES);
+}
+
+static void DspDownsample(int16_t* outPtr)
+{
+    audioDsp_Resampler_t resampler;
+
+    audioDsp_InitResampler(&resampler, 2 * SAMPLE_RATE, SAMPLE_RATE);
+    LE_ASSERT(audioDsp_Resample(&resampler, InSamples, 2 * BLOCK_SAMPLES, outPtr, BLOCK_SAMPLES)
+              == BLOCK_SAMPLES);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * PCM format conversions.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RefU8ToS16(int16_t* outPtr)
+{
+    size_t i;
+
+    for (i = 0; i < BLOCK_SAMPLES; i++)
+    {
+        outPtr[i] = (InBytes[i] - 128) << 8;
+    }
+}
+
+static void DspU8ToS16(int16_t* outPtr)
+{
+    audioDsp_U8ToS16(InBytes, outPtr, BLOCK_SAMPLES);
+}
+
+static void RefS24ToS16(int16_t* outPtr)
+{
+    size_t i;
+
+    for (i = 0; i < BLOCK_SAMPLES; i++)
+    {
+        int32_t sample = InBytes[3 * i] | (InBytes[3 * i + 1] << 8) | (InBytes[3 * i + 2] << 16);
+
+        // Sign extension of the 24-bit sample.
+        sample = (sample ^ 0x800000) - 0x800000;
+        outPtr[i] = sample >> 8;
+    }
+}
+
+static void DspS24ToS16(int16_t* outPtr)
+{
+    audioDsp_S24ToS16(InBytes, outPtr, BLOCK_SAMPLES);
+}
+
+static void RefS32ToS16(int16_t* outPtr)
+{
+    size_t i;
+
+    for (i = 0; i < BLOCK_SAMPLES; i++)
+    {
+        outPtr[i] = InWords[i] / 65536 - ((InWords[i] < 0) && (InWords[i] % 65536) ? 1 : 0);
+    }
+}
+
+static void DspS32ToS16(int16_t* outPtr)
+{
+    audioDsp_S32ToS16(InWords, outPtr, BLOCK_SAMPLES);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run a kernel repeatedly for the benchmark duration.
+ *
+ * @return
+ *      Millions of samples processed per second.
+ */
+//--------------------------------------------------------------------------------------------------
+static double Measure(Kernel_t kernel, int16_t* outPtr)
+{
+    uint64_t startNs = GetNs();
+    uint64_t endNs = startNs + (uint64_t)(Seconds * 1e9);
+    uint64_t nowNs;
+    uint64_t runCount = 0;
+
+    do
+    {
+        kernel(outPtr);
+        runCount++;
+        nowNs = GetNs();
+    }
+    while (nowNs < endNs);
+
+    return (double)runCount * BLOCK_SAMPLES * 1000 / (nowNs - startNs);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check a kernel against its reference, and compare their throughput.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Bench
+(
+    const char* name,
+    Kernel_t refKernel,
+    Kernel_t dspKernel,
+    size_t outCount,
+    int tolerance
+)
+{
+    double refRate;
+    double dspRate;
+    size_t i;
+
+    memset(RefSamples, 0, sizeof(RefSamples));
+    memset(DspSamples, 0, sizeof(DspSamples));
+    refKernel(RefSamples);
+    dspKernel(DspSamples);
+
+    for (i = 0; i < outCount; i++)
+    {
+        if (abs(RefSamples[i] - DspSamples[i]) > tolerance)
+        {
+            LE_FATAL("%s: sample %zu is %d instead of %d", name, i, DspSamples[i], RefSamples[i]);
+        }
+    }
+
+    refRate = Measure(refKernel, RefSamples);
+    dspRate = Measure(dspKernel, DspSamples);
+
+    printf("  %-16s %8.1f Msamples/s %8.1f Msamples/s   x%.1f\n",
+           name, refRate, dspRate, dspRate / refRate);
+}
+
+
+COMPONENT_INIT
+{
+    size_t i;
+
+    if (le_arg_NumArgs() >= 1)
+    {
+        Seconds = atof(le_arg_GetArg(0));
+        LE_FATAL_IF(Seconds <= 0, "Usage: audioDspBench [SECONDS]");
+    }
+
+    srand(1);
+    for (i = 0; i < NUM_ARRAY_MEMBERS(InSamples); i++)
+    {
+        InSamples[i] = (int16_t)(rand() & 0xFFFF);
+    }
+    for (i = 0; i < NUM_ARRAY_MEMBERS(InBytes); i++)
+    {
+        InBytes[i] = (uint8_t)rand();
+    }
+    for (i = 0; i < NUM_ARRAY_MEMBERS(InWords); i++)
+    {
+        InWords[i] = (int32_t)((uint32_t)rand() << 16 ^ (uint32_t)rand());
+    }
+
+    printf("%-18s %19s %19s\n", "", "scalar", "audioDsp");
+
+    // Every digit is checked against the reference, only the last one is timed.
+    for (Digit = 0; Digit < NUM_ARRAY_MEMBERS(LowFreqs) * NUM_ARRAY_MEMBERS(HighFreqs); Digit++)
+    {
+        RefDualTone(RefSamples);
+        DspDualTone(DspSamples);
+        for (i = 0; i < BLOCK_SAMPLES; i++)
+        {
+            LE_FATAL_IF(abs(RefSamples[i] - DspSamples[i]) > TONE_TOLERANCE,
+                        "DTMF %zu: sample %zu is %d instead of %d",
+                        Digit, i, DspSamples[i], RefSamples[i]);
+        }
+    }
+    Digit--;
+
+    Bench("DTMF", RefDualTone, DspDualTone, BLOCK_SAMPLES, TONE_TOLERANCE);
+    Bench("mix", RefMix, DspMix, BLOCK_SAMPLES, 0);
+    Bench("gain", RefGain, DspGain, BLOCK_SAMPLES, 0);
+    Bench("mono to stereo", RefMonoToStereo, DspMonoToStereo, 2 * BLOCK_SAMPLES, 0);
+    Bench("stereo to mono", RefStereoToMono, DspStereoToMono, BLOCK_SAMPLES / 2, 0);
+    Bench("8 to 16 kHz", RefUpsample, DspUpsample, 2 * BLOCK_SAMPLES, 1);
+    Bench("16 to 8 kHz", RefDownsample, DspDownsample, BLOCK_SAMPLES, 1);
+    Bench("U8 to S16", RefU8ToS16, DspU8ToS16, BLOCK_SAMPLES, 0);
+    Bench("S24 to S16", RefS24ToS16, DspS24ToS16, BLOCK_SAMPLES, 0);
+    Bench("S32 to S16", RefS32ToS16, DspS32ToS16, BLOCK_SAMPLES, 0);
+
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,417 @@
+/**
+ * Benchmark of the transports of PCM samples between a client and the audio service: the pipe of
+ * le_audio_PlaySamples() against the shared memory sample ring of le_audio_PlaySamplesRing().
+ *
+ * A consumer thread stands for the PCM thread of the audio service: it is woken up every period
+ * and reads one period of samples the way le_media.c does.  A producer thread stands for the
+ * client: it writes half of the target latency of samples at a time.  The pipe's buffer is as
+ * small as the kernel allows, a single page, which a poll() for POLLOUT only reports once the
+ * page is drained: the client also waits for the ring to be drained, so that both transports
+ * buffer the same samples.
+ *
+ * Every period of samples carries a sequence number and the time it was written at, which give
+ * the latency from the client to the PCM thread.  The CPU time and the context switches of both
+ * threads are printed per second of audio, for a 8 kHz and a 48 kHz mono 16-bit stream.
+ *
+ * Usage: audioRingBench [SECONDS]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "audioRing.h"
+
+#include <poll.h>
+#include <sys/resource.h>
+
+#define DEFAULT_SECONDS     2
+#define PERIOD_MS           10
+#define BYTES_PER_SAMPLE    2
+#define LATENCY_MS          40          // Target latency
+#define MAX_PERIOD_BYTES    2048
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header of a period of samples.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t seq;                       ///< Sequence number of the period.
+    uint32_t reserved;
+    uint64_t writeNs;                   ///< Time the period was written at.
+}
+Period_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Resources used by a thread.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t cpuUs;                     ///< User and system CPU time, in microseconds.
+    uint64_t switchCount;               ///< Voluntary context switches.
+}
+Usage_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stream under test.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    bool            useRing;            ///< Ring or pipe.
+    uint32_t        sampleRate;         ///< Samples per second.
+    uint32_t        periodBytes;        ///< Bytes per period.
+    uint32_t        periodCount;        ///< Periods to stream.
+    uint32_t        bufferSize;         ///< Bytes buffered by the pipe or ring.
+    uint32_t        batchBytes;         ///< Bytes written by the client at a time.
+    int             pipeFds[2];         ///< Pipe: read end, write end.
+    audioRing_Ref_t serviceRingRef;     ///< Ring: end of the audio service (consumer).
+    audioRing_Ref_t clientRingRef;      ///< Ring: end of the client (producer).
+
+    // Results
+    uint64_t        latencySumNs;
+    uint64_t        latencyMaxNs;
+    uint32_t        underrunCount;
+    Usage_t         producerUsage;
+    Usage_t         consumerUsage;
+}
+Stream_t;
+
+static double Seconds = DEFAULT_SECONDS;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the monotonic time in nanoseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the resources used by the calling thread so far.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetUsage(Usage_t* usagePtr)
+{
+    struct rusage ru;
+
+    LE_FATAL_IF(getrusage(RUSAGE_THREAD, &ru) != 0, "getrusage failed: %m");
+    usagePtr->cpuUs = (uint64_t)(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000000 +
+                      ru.ru_utime.tv_usec + ru.ru_stime.tv_usec;
+    usagePtr->switchCount = ru.ru_nvcsw;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Subtract the resources used when a thread started from the ones used when it ended.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EndUsage(Usage_t* usagePtr)
+{
+    Usage_t end;
+
+    GetUsage(&end);
+    usagePtr->cpuUs = end.cpuUs - usagePtr->cpuUs;
+    usagePtr->switchCount = end.switchCount - usagePtr->switchCount;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the whole buffer to the pipe.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WritePipe(int fd, const uint8_t* bufPtr, size_t len)
+{
+    while (len)
+    {
+        ssize_t count = write(fd, bufPtr, len);
+
+        LE_FATAL_IF((count < 0) && (errno != EINTR), "write failed: %m");
+        if (count > 0)
+        {
+            bufPtr += count;
+            len -= count;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the whole buffer from the pipe.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReadPipe(int fd, uint8_t* bufPtr, size_t len)
+{
+    while (len)
+    {
+        ssize_t count = read(fd, bufPtr, len);
+
+        LE_FATAL_IF((count < 0) && (errno != EINTR), "read failed: %m");
+        LE_FATAL_IF(count == 0, "pipe closed");
+        if (count > 0)
+        {
+            bufPtr += count;
+            len -= count;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Client: writes the periods of samples, a batch at a time.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* ProducerThread(void* contextPtr)
+{
+    Stream_t* streamPtr = contextPtr;
+    uint32_t batchPeriods = streamPtr->batchBytes / streamPtr->periodBytes;
+    static uint64_t batchWords[AUDIORING_MAX_SIZE / sizeof(uint64_t)];
+    uint8_t* batch = (uint8_t*)batchWords;
+    uint32_t seq = 0;
+
+    GetUsage(&streamPtr->producerUsage);
+
+    while (seq < streamPtr->periodCount)
+    {
+        uint32_t count = streamPtr->periodCount - seq;
+        uint32_t len;
+        uint32_t waitLen;
+        uint64_t now;
+        uint32_t i;
+
+        if (count > batchPeriods)
+        {
+            count = batchPeriods;
+        }
+        len = count * streamPtr->periodBytes;
+
+        // Wait for the space before the samples are stamped, as a client producing them on the
+        // fly would do.
+        if (streamPtr->useRing)
+        {
+            waitLen = streamPtr->bufferSize;
+            LE_FATAL_IF(audioRing_Wait(streamPtr->clientRingRef, waitLen, -1) != LE_OK,
+                        "ring wait failed");
+        }
+        else
+        {
+            struct pollfd pfd = { .fd = streamPtr->pipeFds[1], .events = POLLOUT };
+
+            LE_FATAL_IF(poll(&pfd, 1, -1) < 0, "poll failed: %m");
+        }
+
+        now = GetNs();
+        for (i = 0; i < count; i++)
+        {
+            uint8_t* periodPtr = batch + i * streamPtr->periodBytes;
+            Period_t* headerPtr = (Period_t*)periodPtr;
+
+            memset(periodPtr, (seq + i) & 0xFF, streamPtr->periodBytes);
+            headerPtr->seq = seq + i;
+            headerPtr->writeNs = now;
+        }
+
+        if (streamPtr->useRing)
+        {
+            LE_FATAL_IF(audioRing_Write(streamPtr->clientRingRef, batch, len) != len,
+                        "short ring write");
+        }
+        else
+        {
+            WritePipe(streamPtr->pipeFds[1], batch, len);
+        }
+        seq += count;
+    }
+
+    EndUsage(&streamPtr->producerUsage);
+
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Audio service: reads one period of samples every period, as the PCM thread does.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* ConsumerThread(void* contextPtr)
+{
+    Stream_t* streamPtr = contextPtr;
+    uint64_t periodWords[MAX_PERIOD_BYTES / sizeof(uint64_t)];
+    uint8_t* period = (uint8_t*)periodWords;
+    struct timespec wakeup;
+    uint32_t seq;
+
+    clock_gettime(CLOCK_MONOTONIC, &wakeup);
+    GetUsage(&streamPtr->consumerUsage);
+
+    for (seq = 0; seq < streamPtr->periodCount; seq++)
+    {
+        Period_t* headerPtr = (Period_t*)period;
+        uint64_t latencyNs;
+
+        wakeup.tv_nsec += PERIOD_MS * 1000000;
+        if (wakeup.tv_nsec >= 1000000000)
+        {
+            wakeup.tv_nsec -= 1000000000;
+            wakeup.tv_sec++;
+        }
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeup, NULL) == EINTR)
+        {
+        }
+
+        if (streamPtr->useRing)
+        {
+            audioRing_Ref_t ringRef = streamPtr->serviceRingRef;
+
+            if ((audioRing_GetAvailable(ringRef) < streamPtr->periodBytes) &&
+                (audioRing_Wait(ringRef, streamPtr->periodBytes, PERIOD_MS) != LE_OK))
+            {
+                streamPtr->underrunCount++;
+                LE_FATAL_IF(audioRing_Wait(ringRef, streamPtr->periodBytes, -1) != LE_OK,
+                            "ring wait failed");
+            }
+            audioRing_Read(ringRef, period, streamPtr->periodBytes);
+        }
+        else
+        {
+            struct pollfd pfd = { .fd = streamPtr->pipeFds[0], .events = POLLIN };
+            ssize_t count = 0;
+
+            if (poll(&pfd, 1, PERIOD_MS) > 0)
+            {
+                count = read(streamPtr->pipeFds[0], period, streamPtr->periodBytes);
+                LE_FATAL_IF(count < 0, "read failed: %m");
+            }
+            if (count < (ssize_t)streamPtr->periodBytes)
+            {
+                streamPtr->underrunCount++;
+                ReadPipe(streamPtr->pipeFds[0], period + count, streamPtr->periodBytes - count);
+            }
+        }
+
+        latencyNs = GetNs() - headerPtr->writeNs;
+
+        LE_FATAL_IF(headerPtr->seq != seq, "period %u received instead of %u",
+                    headerPtr->seq, seq);
+        LE_FATAL_IF(period[streamPtr->periodBytes - 1] != (seq & 0xFF),
+                    "period %u is corrupted", seq);
+
+        streamPtr->latencySumNs += latencyNs;
+        if (latencyNs > streamPtr->latencyMaxNs)
+        {
+            streamPtr->latencyMaxNs = latencyNs;
+        }
+    }
+
+    EndUsage(&streamPtr->consumerUsage);
+
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stream samples over a pipe or a ring, and print the results.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Run(uint32_t sampleRate, bool useRing)
+{
+    Stream_t stream;
+    le_thread_Ref_t producerRef;
+    le_thread_Ref_t consumerRef;
+    uint32_t bufferSize = AUDIORING_MIN_SIZE;
+    double audioSeconds;
+
+    memset(&stream, 0, sizeof(stream));
+    stream.useRing = useRing;
+    stream.sampleRate = sampleRate;
+    stream.periodBytes = sampleRate / 1000 * PERIOD_MS * BYTES_PER_SAMPLE;
+    stream.periodCount = Seconds * 1000 / PERIOD_MS;
+
+    LE_ASSERT(stream.periodBytes <= MAX_PERIOD_BYTES);
+
+    stream.batchBytes = sampleRate / 1000 * LATENCY_MS / 2 * BYTES_PER_SAMPLE;
+    stream.batchBytes -= stream.batchBytes % stream.periodBytes;
+
+    while (bufferSize < sampleRate / 1000 * LATENCY_MS * BYTES_PER_SAMPLE)
+    {
+        bufferSize *= 2;
+    }
+
+    if (useRing)
+    {
+        // The client maps the ring from the file descriptors, as it would get them over IPC.
+        stream.serviceRingRef = audioRing_Create(bufferSize, AUDIORING_CONSUMER);
+        LE_ASSERT(stream.serviceRingRef);
+        stream.clientRingRef = audioRing_Open(dup(audioRing_GetFd(stream.serviceRingRef)),
+                                              dup(audioRing_GetEventFd(stream.serviceRingRef)));
+        LE_ASSERT(stream.clientRingRef);
+        stream.bufferSize = audioRing_GetSize(stream.serviceRingRef);
+    }
+    else
+    {
+        LE_ASSERT(pipe(stream.pipeFds) == 0);
+        LE_ASSERT(fcntl(stream.pipeFds[0], F_SETPIPE_SZ, 0) >= 0);
+        stream.bufferSize = fcntl(stream.pipeFds[0], F_GETPIPE_SZ);
+    }
+
+    producerRef = le_thread_Create("producer", ProducerThread, &stream);
+    consumerRef = le_thread_Create("consumer", ConsumerThread, &stream);
+    le_thread_SetJoinable(producerRef);
+    le_thread_SetJoinable(consumerRef);
+    le_thread_Start(producerRef);
+    le_thread_Start(consumerRef);
+    le_thread_Join(producerRef, NULL);
+    le_thread_Join(consumerRef, NULL);
+
+    if (useRing)
+    {
+        audioRing_Close(stream.clientRingRef);
+        audioRing_Close(stream.serviceRingRef);
+    }
+    else
+    {
+        close(stream.pipeFds[0]);
+        close(stream.pipeFds[1]);
+    }
+
+    audioSeconds = (double)stream.periodCount * PERIOD_MS / 1000;
+
+    printf("%5u Hz %-5s %7u %8.2f %8.2f %9u %10.1f %10.1f %9.1f %9.1f\n",
+           sampleRate, useRing ? "ring" : "pipe", stream.bufferSize,
+           (double)stream.latencySumNs / stream.periodCount / 1000000,
+           (double)stream.latencyMaxNs / 1000000,
+           stream.underrunCount,
+           stream.producerUsage.cpuUs / audioSeconds,
+           stream.consumerUsage.cpuUs / audioSeconds,
+           stream.producerUsage.switchCount / audioSeconds,
+           stream.consumerUsage.switchCount / audioSeconds);
+}
+
+COMPONENT_INIT
+{
+    if (le_arg_NumArgs() >= 1)
+    {
+        Seconds = atof(le_arg_GetArg(0));
+        LE_FATAL_IF(Seconds * 1000 < PERIOD_MS, "Usage: audioRingBench [SECONDS]");
+    }
+
+    printf("%-14s %7s %8s %8s %9s %10s %10s %9s %9s\n", "", "buffer",
+           "lat(ms)", "max(ms)", "underrun", "prod us/s", "cons us/s", "prod cs/s", "cons cs/s");
+
+    Run(8000, false);
+    Run(8000, true);
+    Run(48000, false);
+    Run(48000, true);
+
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,278 @@
+/**
+ * Benchmark of the log ring of the log daemon.
+ *
+ * A private 16 MB log ring is created.  A number of threads append records to it at the same time,
+ * one at a time as le_log does, then in batches of 16 as the log daemon does for the lines written
+ * by the processes to their standard output.  The throughput is printed in records and megabytes of
+ * messages per second.  The full ring is then queried, without a filter and with a filter on the
+ * component, on the severity level and on the time, and the latency of each query is printed.
+ *
+ * Usage: logRingBench [THREADS [RECORDS]]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "logRing.h"
+
+#define DEFAULT_THREADS     4
+#define DEFAULT_RECORDS     100000      // Per thread and per run
+#define RING_SIZE           (16 * 1024 * 1024)
+#define BATCH_SIZE          16
+#define COMPONENT_COUNT     8
+#define QUERY_ROUNDS        5
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of appending threads, and number of records each one appends.
+ */
+//--------------------------------------------------------------------------------------------------
+static int ThreadCount = DEFAULT_THREADS;
+static int RecordCount = DEFAULT_RECORDS;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The ring, and the number of records appended in each batch of the current run.
+ */
+//--------------------------------------------------------------------------------------------------
+static logRing_Ref_t RingRef;
+static int BatchSize;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Time stamps of the first and last records appended, in nanoseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t FirstTimestampNs;
+static uint64_t LastTimestampNs;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Seconds of the monotonic clock.
+ */
+//--------------------------------------------------------------------------------------------------
+static double Seconds
+(
+    void
+)
+{
+    struct timespec time;
+
+    LE_ASSERT(0 == clock_gettime(CLOCK_MONOTONIC, &time));
+    return time.tv_sec + (time.tv_nsec / 1e9);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Nanoseconds of the real-time clock, as stamped on the records.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t TimestampNs
+(
+    void
+)
+{
+    struct timespec time;
+
+    LE_ASSERT(0 == clock_gettime(CLOCK_REALTIME, &time));
+    return ((uint64_t)time.tv_sec * 1000000000) + time.tv_nsec;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Appending thread: append records to the ring in batches, with messages of various lengths,
+ * components and levels.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* Append
+(
+    void* contextPtr            ///< [IN] Thread number
+)
+{
+    int threadNum = (int)(intptr_t)contextPtr;
+    char compNames[COMPONENT_COUNT][16];
+    char msgs[BATCH_SIZE][LOGRING_MAX_MSG_BYTES];
+    logRing_Entry_t entries[BATCH_SIZE];
+    size_t msgBytes = 0;
+    int i;
+
+    for (i = 0; i < COMPONENT_COUNT; i++)
+    {
+        snprintf(compNames[i], sizeof(compNames[i]), "benchComp%d", i);
+    }
+
+    for (i = 0; i < RecordCount; i += BatchSize)
+    {
+        uint64_t timestampNs = TimestampNs();
+        int batchSize = (RecordCount - i < BatchSize) ? (RecordCount - i) : BatchSize;
+        int j;
+
+        for (j = 0; j < batchSize; j++)
+        {
+            int recordNum = i + j;
+
+            entries[j].timestampNs = timestampNs;
+            entries[j].pid = getpid();
+            entries[j].tid = threadNum;
+            entries[j].level = recordNum % (LE_LOG_EMERG + 1);
+            entries[j].procNamePtr = "logRingBench";
+            entries[j].compNamePtr = compNames[recordNum % COMPONENT_COUNT];
+            entries[j].msgLen = snprintf(msgs[j], sizeof(msgs[j]),
+                                         "Record %d of thread %d, %.*s", recordNum, threadNum,
+                                         (recordNum % 4) * 32,
+                                         "................................................"
+                                         "................................................"
+                                         "..............");
+            entries[j].msgPtr = msgs[j];
+            msgBytes += entries[j].msgLen;
+        }
+
+        logRing_Append(RingRef, entries, batchSize);
+    }
+
+    return (void*)(uintptr_t)msgBytes;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append records from all the threads with a batch size, and print the throughput.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunAppend
+(
+    int batchSize               ///< [IN] Number of records appended at a time
+)
+{
+    le_thread_Ref_t threadRefs[ThreadCount];
+    size_t msgBytes = 0;
+    double startTime;
+    double seconds;
+    int i;
+
+    BatchSize = batchSize;
+    FirstTimestampNs = TimestampNs();
+
+    for (i = 0; i < ThreadCount; i++)
+    {
+        threadRefs[i] = le_thread_Create("Append", Append, (void*)(intptr_t)(i + 1));
+        le_thread_SetJoinable(threadRefs[i]);
+    }
+
+    startTime = Seconds();
+    for (i = 0; i < ThreadCount; i++)
+    {
+        le_thread_Start(threadRefs[i]);
+    }
+    for (i = 0; i < ThreadCount; i++)
+    {
+        void* resultPtr;
+
+        LE_ASSERT_OK(le_thread_Join(threadRefs[i], &resultPtr));
+        msgBytes += (uintptr_t)resultPtr;
+    }
+    seconds = Seconds() - startTime;
+
+    LastTimestampNs = TimestampNs();
+
+    printf("append, batch %2d %12.0f records/s %8.1f MB/s\n", batchSize,
+           (ThreadCount * (double)RecordCount) / seconds, msgBytes / (seconds * 1e6));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler of the queried records: check them.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool CheckRecord
+(
+    const logRing_Record_t* recordPtr,  ///< [IN] The record.
+    void* contextPtr                    ///< [IN] Filter of the query.
+)
+{
+    const logRing_Filter_t* filterPtr = contextPtr;
+
+    LE_ASSERT(0 == strcmp(recordPtr->procName, "logRingBench"));
+    LE_ASSERT(0 == strncmp(recordPtr->msg, "Record ", 7));
+    LE_ASSERT((filterPtr->compNamePtr == NULL)
+              || (0 == strcmp(recordPtr->compName, filterPtr->compNamePtr)));
+    LE_ASSERT(recordPtr->level >= filterPtr->minLevel);
+    LE_ASSERT(recordPtr->timestampNs >= filterPtr->sinceNs);
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Query the ring a number of times with a filter, and print the latency of a query.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunQuery
+(
+    const char* namePtr,                ///< [IN] Name of the query
+    const logRing_Filter_t* filterPtr   ///< [IN] Filter of the query
+)
+{
+    size_t count = 0;
+    double startTime;
+    double seconds;
+    int round;
+
+    startTime = Seconds();
+    for (round = 0; round < QUERY_ROUNDS; round++)
+    {
+        count = logRing_Query(RingRef, filterPtr, CheckRecord, (void*)filterPtr);
+    }
+    seconds = Seconds() - startTime;
+
+    LE_ASSERT(count > 0);
+    printf("query, %-10s %8.2f ms/query %10zu records\n", namePtr,
+           (seconds * 1000) / QUERY_ROUNDS, count);
+}
+
+COMPONENT_INIT
+{
+    logRing_Filter_t filter;
+    int fd;
+
+    if (le_arg_NumArgs() >= 1)
+    {
+        ThreadCount = atoi(le_arg_GetArg(0));
+    }
+    if (le_arg_NumArgs() >= 2)
+    {
+        RecordCount = atoi(le_arg_GetArg(1));
+    }
+    LE_FATAL_IF((ThreadCount <= 0) || (RecordCount < BATCH_SIZE),
+                "Usage: logRingBench [THREADS [RECORDS]]");
+
+    fd = logRing_Create(RING_SIZE);
+    LE_ASSERT(fd >= 0);
+    RingRef = logRing_Map(fd, true);
+    LE_ASSERT(RingRef != NULL);
+    close(fd);
+
+    printf("%d threads, %d records each, %zu bytes ring\n", ThreadCount, RecordCount,
+           logRing_GetSize(RingRef));
+
+    RunAppend(1);
+    RunAppend(BATCH_SIZE);
+
+    memset(&filter, 0, sizeof(filter));
+    RunQuery("all", &filter);
+
+    filter.compNamePtr = "benchComp3";
+    RunQuery("component", &filter);
+
+    memset(&filter, 0, sizeof(filter));
+    filter.minLevel = LE_LOG_ERR;
+    RunQuery("level", &filter);
+
+    // The last tenth of the last run.
+    memset(&filter, 0, sizeof(filter));
+    filter.sinceNs = LastTimestampNs - ((LastTimestampNs - FirstTimestampNs) / 10);
+    RunQuery("time", &filter);
+
+    logRing_Unmap(RingRef);
+
+    exit(EXIT_SUCCESS);
+}
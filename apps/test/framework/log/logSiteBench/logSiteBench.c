@@ -0,0 +1,112 @@
+/**
+ * Benchmark of the log macros.
+ *
+ * The filtering level is set to INFO, and a number of LE_DEBUG (filtered out) and LE_INFO (sent)
+ * messages are logged.  The time per call is printed, compared with the same messages sent without
+ * a call site descriptor, as the log macros used to.  Standard error is redirected to /dev/null so
+ * that, off target, the time of the terminal is not measured.
+ *
+ * Usage: logSiteBench [CALLS]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+
+#define DEFAULT_CALLS       1000000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of calls of each run.
+ */
+//--------------------------------------------------------------------------------------------------
+static int Calls = DEFAULT_CALLS;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log macro without a call site descriptor, for comparison.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LEGACY_LOG_MSG(level, formatString, ...) \
+    do { \
+        if ((LE_LOG_LEVEL_FILTER_PTR == NULL) || (level >= *LE_LOG_LEVEL_FILTER_PTR)) \
+            _le_log_Send(level, NULL, LE_LOG_SESSION, STRINGIZE(LE_FILENAME), __func__, __LINE__, \
+                    formatString, ##__VA_ARGS__); \
+    } while(0)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Seconds of the monotonic clock.
+ */
+//--------------------------------------------------------------------------------------------------
+static double Seconds
+(
+    void
+)
+{
+    struct timespec time;
+
+    LE_ASSERT(0 == clock_gettime(CLOCK_MONOTONIC, &time));
+    return time.tv_sec + (time.tv_nsec / 1e9);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print the time per call of a run.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrintResult
+(
+    const char* namePtr,        ///< [IN] Name of the run
+    int calls,                  ///< [IN] Number of calls
+    double seconds              ///< [IN] Duration of the run
+)
+{
+    printf("%-20s %10.1f ns/call\n", namePtr, (seconds * 1e9) / calls);
+}
+
+COMPONENT_INIT
+{
+    double startTime;
+    int i;
+
+    if (le_arg_NumArgs() >= 1)
+    {
+        Calls = atoi(le_arg_GetArg(0));
+    }
+    LE_FATAL_IF(Calls < 10, "Usage: logSiteBench [CALLS]");
+
+    le_log_SetFilterLevel(LE_LOG_INFO);
+    LE_FATAL_IF(NULL == freopen("/dev/null", "w", stderr), "Can't redirect stderr.  %m.");
+
+    startTime = Seconds();
+    for (i = 0; i < Calls; i++)
+    {
+        LE_DEBUG("Disabled message %d of %s", i, "logSiteBench");
+    }
+    PrintResult("disabled, site", Calls, Seconds() - startTime);
+
+    startTime = Seconds();
+    for (i = 0; i < Calls; i++)
+    {
+        LEGACY_LOG_MSG(LE_LOG_DEBUG, "Disabled message %d of %s", i, "logSiteBench");
+    }
+    PrintResult("disabled, legacy", Calls, Seconds() - startTime);
+
+    // Enabled messages are much slower: log a tenth as many.
+    startTime = Seconds();
+    for (i = 0; i < Calls / 10; i++)
+    {
+        LE_INFO("Enabled message %d of %s", i, "logSiteBench");
+    }
+    PrintResult("enabled, site", Calls / 10, Seconds() - startTime);
+
+    startTime = Seconds();
+    for (i = 0; i < Calls / 10; i++)
+    {
+        LEGACY_LOG_MSG(LE_LOG_INFO, "Enabled message %d of %s", i, "logSiteBench");
+    }
+    PrintResult("enabled, legacy", Calls / 10, Seconds() - startTime);
+
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,182 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark of the write latency of secStore with many items in the client's area.
+ *
+ * Writes NUM_ITEMS items, then overwrites them, and reports the average latency of all the writes
+ * and of the first and last ones.  With the client's usage counted in memory, the latency should
+ * not grow with the number of items.  The limit of the client is then checked against the space reported by
+ * secStoreAdmin, to make sure the usage counted by the daemon is right.
+ *
+ * The limit of the client is given with the -l option, and must fit NUM_ITEMS items.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "interfaces.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of items written by the client.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NUM_ITEMS               1000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of writes averaged at the start and at the end of a pass.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NUM_TIMED_WRITES        100
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Area of the client in secure storage, as set by the stubs of the unit test.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CLIENT_AREA             "/sys/0/apps/secStoreUnitTest"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Data of the items.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t ItemData[LE_SECSTORE_MAX_ITEM_SIZE];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes an item and adds the time the write took to a total.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TimedWrite
+(
+    const char* namePtr,            ///< [IN] Name of the item.
+    size_t size,                    ///< [IN] Size of the item.
+    le_clk_Time_t* totalPtr         ///< [IN/OUT] Total time of the writes.
+)
+{
+    le_clk_Time_t start = le_clk_GetRelativeTime();
+
+    le_result_t result = le_secStore_Write(namePtr, ItemData, size);
+
+    *totalPtr = le_clk_Add(*totalPtr, le_clk_Sub(le_clk_GetRelativeTime(), start));
+
+    LE_FATAL_IF(result != LE_OK, "Could not write '%s'.  %s.", namePtr, LE_RESULT_TXT(result));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes all the items, and logs the average latency of the first and last writes.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteItems
+(
+    const char* passPtr,            ///< [IN] Name of the pass, for the logs.
+    size_t itemSize                 ///< [IN] Size of the items.
+)
+{
+    le_clk_Time_t firstTime = { 0, 0 };
+    le_clk_Time_t lastTime = { 0, 0 };
+    le_clk_Time_t otherTime = { 0, 0 };
+    int i;
+
+    for (i = 0; i < NUM_ITEMS; i++)
+    {
+        char name[LE_SECSTORE_MAX_NAME_BYTES];
+
+        snprintf(name, sizeof(name), "item%d", i);
+
+        if (i < NUM_TIMED_WRITES)
+        {
+            TimedWrite(name, itemSize, &firstTime);
+        }
+        else if (i >= NUM_ITEMS - NUM_TIMED_WRITES)
+        {
+            TimedWrite(name, itemSize, &lastTime);
+        }
+        else
+        {
+            TimedWrite(name, itemSize, &otherTime);
+        }
+    }
+
+    le_clk_Time_t allTime = le_clk_Add(le_clk_Add(firstTime, otherTime), lastTime);
+
+    LE_INFO("%s: %d writes %" PRIu64 " us each, first %d %" PRIu64 " us, last %d %" PRIu64 " us.",
+            passPtr,
+            NUM_ITEMS,
+            (allTime.sec * 1000000ULL + allTime.usec) / NUM_ITEMS,
+            NUM_TIMED_WRITES,
+            (firstTime.sec * 1000000ULL + firstTime.usec) / NUM_TIMED_WRITES,
+            NUM_TIMED_WRITES,
+            (lastTime.sec * 1000000ULL + lastTime.usec) / NUM_TIMED_WRITES);
+}
+
+
+COMPONENT_INIT
+{
+    int limit;
+    size_t usedSpace;
+    le_result_t result;
+    int i;
+
+    LE_INFO("==================== SecStoreBench BEGIN ===========================");
+
+    result = le_arg_GetIntOption(&limit, "l", NULL);
+    LE_FATAL_IF(result != LE_OK, "Could not get storage limit.  %s.", LE_RESULT_TXT(result));
+
+    // Leave half of the limit free for the checks of the limit.
+    size_t itemSize = limit / (2 * NUM_ITEMS);
+
+    LE_FATAL_IF(itemSize == 0, "Limit %d is too small for %d items.", limit, NUM_ITEMS);
+    memset(ItemData, 'x', sizeof(ItemData));
+
+    WriteItems("Create", itemSize);
+    WriteItems("Overwrite", itemSize);
+
+    // The space counted by the daemon must match the space used in the PA: an item filling up the
+    // rest of the limit is accepted, and one more byte is not.
+    result = secStoreAdmin_GetSize(CLIENT_AREA, &usedSpace);
+    LE_FATAL_IF(result != LE_OK, "Could not get used space.  %s.", LE_RESULT_TXT(result));
+
+    size_t fillSize = limit - usedSpace;
+
+    LE_FATAL_IF(fillSize > sizeof(ItemData), "%zu bytes used out of %d.", usedSpace, limit);
+
+    result = le_secStore_Write("fill", ItemData, fillSize);
+    LE_FATAL_IF(result != LE_OK,
+                "Could not fill %zu bytes up to the limit.  %s.", fillSize, LE_RESULT_TXT(result));
+
+    result = le_secStore_Write("extra", ItemData, 1);
+    LE_FATAL_IF(result != LE_NO_MEMORY,
+                "Should have failed due to a memory limit.  %s.", LE_RESULT_TXT(result));
+
+    // Deleting an item frees its space.
+    result = le_secStore_Delete("fill");
+    LE_FATAL_IF(result != LE_OK, "Could not delete 'fill'.  %s.", LE_RESULT_TXT(result));
+
+    result = le_secStore_Write("extra", ItemData, 1);
+    LE_FATAL_IF(result != LE_OK, "Could not write after delete.  %s.", LE_RESULT_TXT(result));
+
+    // Clean up.
+    result = le_secStore_Delete("extra");
+    LE_FATAL_IF(result != LE_OK, "Could not delete 'extra'.  %s.", LE_RESULT_TXT(result));
+
+    for (i = 0; i < NUM_ITEMS; i++)
+    {
+        char name[LE_SECSTORE_MAX_NAME_BYTES];
+
+        snprintf(name, sizeof(name), "item%d", i);
+
+        result = le_secStore_Delete(name);
+        LE_FATAL_IF(result != LE_OK,
+                    "Could not delete item '%s'.  %s.", name, LE_RESULT_TXT(result));
+    }
+
+    LE_INFO("============ SecStoreBench PASSED =============");
+
+    exit(EXIT_SUCCESS);
+}
@@ -35,6 +35,16 @@ le_msg_ServiceRef_t secStoreAdmin_GetServiceRef
     void
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the server service reference for le_secStore
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_ServiceRef_t le_secStore_GetServiceRef
+(
+    void
+);
+
 //--------------------------------------------------------------------------------------------------
 /*
  * FIXME: Declaring secStoreGlobal here since I can't seem to be able to include an api as another
@@ -0,0 +1,291 @@
+/**
+ * Benchmark of the reload of the bindings in the Service Directory after an app install.
+ *
+ * A number of fake unsandboxed apps, each with a few bindings to the next one, are added to the
+ * system configuration tree, as well as a binding of the first one to a service this benchmark
+ * advertises.  The bindings are then reloaded a number of times, with a full "sdir load" and with
+ * "sdir load APP_NAME" for an app in the middle, and the time it takes is printed.  Meanwhile, a
+ * prober thread keeps opening sessions through the binding of the first app, and the time this
+ * binding was missing is printed too: it should be none when only another app is reloaded.
+ *
+ * The fake apps are removed from the configuration tree at the end.  This must be run as root on
+ * the target, with no app installed under the same names.
+ *
+ * Usage: sdirLoadBench [APP_COUNT [ROUNDS]]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+
+#define DEFAULT_APP_COUNT       100
+#define DEFAULT_ROUNDS          10
+#define BINDINGS_PER_APP        5
+
+#define SDIR_TOOL_PATH          "/legato/systems/current/bin/sdir"
+#define APP_NAME_FORMAT         "sdirBenchApp%d"
+#define PROTOCOL_ID             "sdirLoadBench"
+#define SERVICE_NAME            "sdirBenchService"
+#define PROBE_INTERFACE_NAME    "sdirBenchProbe"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of fake apps, and number of times the bindings are reloaded in each mode.
+ */
+//--------------------------------------------------------------------------------------------------
+static int AppCount;
+static int Rounds;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Protocol of the probed service.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_msg_ProtocolRef_t ProtocolRef;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Counters of the prober thread, and flag telling it to stop, protected by the mutex.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mutex_Ref_t Mutex;
+static bool StopProbing;
+static uint32_t ProbeCount;
+static uint32_t FailedProbeCount;
+static double DownSeconds;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Seconds of the monotonic clock.
+ */
+//--------------------------------------------------------------------------------------------------
+static double Seconds
+(
+    void
+)
+{
+    struct timespec time;
+
+    LE_ASSERT(0 == clock_gettime(CLOCK_MONOTONIC, &time));
+    return time.tv_sec + (time.tv_nsec / 1e9);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prober thread: open and close sessions through the probed binding until told to stop, and count
+ * the time the binding was missing.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* Probe
+(
+    void* contextPtr
+)
+{
+    bool isDown = false;
+    double downStart = 0;
+
+    for (;;)
+    {
+        le_msg_SessionRef_t sessionRef = le_msg_CreateSession(ProtocolRef, PROBE_INTERFACE_NAME);
+        le_result_t result = le_msg_TryOpenSessionSync(sessionRef);
+        double now = Seconds();
+
+        le_msg_DeleteSession(sessionRef);
+
+        le_mutex_Lock(Mutex);
+        ProbeCount++;
+        if (LE_OK != result)
+        {
+            FailedProbeCount++;
+            if (!isDown)
+            {
+                isDown = true;
+                downStart = now;
+            }
+        }
+        else if (isDown)
+        {
+            isDown = false;
+            DownSeconds += now - downStart;
+        }
+        if (StopProbing)
+        {
+            if (isDown)
+            {
+                DownSeconds += now - downStart;
+            }
+            le_mutex_Unlock(Mutex);
+            return NULL;
+        }
+        le_mutex_Unlock(Mutex);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run a command and check it succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunCommand
+(
+    const char* commandPtr      ///< [IN] Command line
+)
+{
+    int status = system(commandPtr);
+
+    LE_FATAL_IF(!WIFEXITED(status) || (EXIT_SUCCESS != WEXITSTATUS(status)),
+                "'%s' failed (status %d)", commandPtr, status);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add the fake apps and their bindings to the system configuration tree, or remove them.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetUpApps
+(
+    bool add                    ///< [IN] True to add the apps, false to remove them
+)
+{
+    le_cfg_IteratorRef_t iteratorRef = le_cfg_CreateWriteTxn("system:/apps");
+    char appName[LE_CFG_NAME_LEN_BYTES];
+    char serverAppName[LE_CFG_NAME_LEN_BYTES];
+    char path[LE_CFG_STR_LEN_BYTES];
+    int app;
+    int binding;
+
+    for (app = 0; app < AppCount; app++)
+    {
+        snprintf(appName, sizeof(appName), APP_NAME_FORMAT, app);
+        if (!add)
+        {
+            le_cfg_DeleteNode(iteratorRef, appName);
+            continue;
+        }
+
+        // Unsandboxed apps run as root, so they need no user account to be bound.
+        snprintf(path, sizeof(path), "%s/sandboxed", appName);
+        le_cfg_SetBool(iteratorRef, path, false);
+
+        // Client interface names are made unique, as all the apps have the same user ID.
+        snprintf(serverAppName, sizeof(serverAppName), APP_NAME_FORMAT, (app + 1) % AppCount);
+        for (binding = 0; binding < BINDINGS_PER_APP; binding++)
+        {
+            snprintf(path, sizeof(path), "%s/bindings/%s_%d/app", appName, appName, binding);
+            le_cfg_SetString(iteratorRef, path, serverAppName);
+            snprintf(path, sizeof(path), "%s/bindings/%s_%d/interface", appName, appName,
+                     binding);
+            le_cfg_SetString(iteratorRef, path, "benchService");
+        }
+    }
+
+    if (add)
+    {
+        snprintf(path, sizeof(path),
+                 APP_NAME_FORMAT "/bindings/" PROBE_INTERFACE_NAME "/user", 0);
+        le_cfg_SetString(iteratorRef, path, "root");
+        snprintf(path, sizeof(path),
+                 APP_NAME_FORMAT "/bindings/" PROBE_INTERFACE_NAME "/interface", 0);
+        le_cfg_SetString(iteratorRef, path, SERVICE_NAME);
+    }
+
+    le_cfg_CommitTxn(iteratorRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reload the bindings a number of times with a command, while probing the binding of the first
+ * app, and print the time it took and the time the binding was missing.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunLoad
+(
+    const char* namePtr,        ///< [IN] Name of the run
+    const char* commandPtr      ///< [IN] Command reloading the bindings
+)
+{
+    le_thread_Ref_t proberRef;
+    double startTime;
+    double seconds;
+    int round;
+
+    StopProbing = false;
+    ProbeCount = 0;
+    FailedProbeCount = 0;
+    DownSeconds = 0;
+
+    proberRef = le_thread_Create("Probe", Probe, NULL);
+    le_thread_SetJoinable(proberRef);
+    le_thread_Start(proberRef);
+
+    startTime = Seconds();
+    for (round = 0; round < Rounds; round++)
+    {
+        RunCommand(commandPtr);
+    }
+    seconds = Seconds() - startTime;
+
+    le_mutex_Lock(Mutex);
+    StopProbing = true;
+    le_mutex_Unlock(Mutex);
+    LE_ASSERT_OK(le_thread_Join(proberRef, NULL));
+
+    printf("%-16s %8.1f ms/load, binding down %8.2f ms/load (%u of %u probes failed)\n",
+           namePtr, (seconds * 1000) / Rounds, (DownSeconds * 1000) / Rounds, FailedProbeCount,
+           ProbeCount);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark thread: set up the apps, reload their bindings in each mode and clean up.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* Bench
+(
+    void* contextPtr
+)
+{
+    char command[LE_CFG_STR_LEN_BYTES];
+
+    le_cfg_ConnectService();
+
+    SetUpApps(true);
+    RunCommand(SDIR_TOOL_PATH " load");
+
+    printf("%d apps, %d bindings each, %d rounds\n", AppCount, BINDINGS_PER_APP, Rounds);
+    RunLoad("full load", SDIR_TOOL_PATH " load");
+    snprintf(command, sizeof(command), SDIR_TOOL_PATH " load " APP_NAME_FORMAT, AppCount / 2);
+    RunLoad("single app load", command);
+
+    SetUpApps(false);
+    RunCommand(SDIR_TOOL_PATH " load");
+
+    exit(EXIT_SUCCESS);
+}
+
+COMPONENT_INIT
+{
+    le_msg_ServiceRef_t serviceRef;
+
+    AppCount = DEFAULT_APP_COUNT;
+    Rounds = DEFAULT_ROUNDS;
+    if (le_arg_NumArgs() >= 1)
+    {
+        AppCount = atoi(le_arg_GetArg(0));
+    }
+    if (le_arg_NumArgs() >= 2)
+    {
+        Rounds = atoi(le_arg_GetArg(1));
+    }
+    LE_ASSERT((AppCount > 1) && (Rounds > 0));
+
+    Mutex = le_mutex_CreateNonRecursive("SdirLoadBench");
+
+    // The probed service is served by the main thread's event loop.
+    ProtocolRef = le_msg_GetProtocolRef(PROTOCOL_ID, sizeof(uint32_t));
+    serviceRef = le_msg_CreateService(ProtocolRef, SERVICE_NAME);
+    le_msg_AdvertiseService(serviceRef);
+
+    le_thread_Start(le_thread_Create("Bench", Bench, NULL));
+}
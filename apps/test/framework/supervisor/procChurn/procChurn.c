@@ -0,0 +1,147 @@
+//--------------------------------------------------------------------------------------------------
+/** @file procChurn.c
+ *
+ * This program is a stress test of the handling of process exits by the Supervisor.  It starts a
+ * short-lived process in its own app, kills it as soon as it is running, and waits for the
+ * Supervisor to report its exit, a few hundred times in a row.  The time between each kill and
+ * the report of the exit is the reaction latency of the Supervisor; its average and maximum are
+ * logged at the end.
+ *
+ * This program must be provided with the name of its app in the command-line argument.  The short
+ * lived processes run the same program with the argument "child": they print their PID on their
+ * standard output and wait to be killed.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+#include "legato.h"
+#include "interfaces.h"
+
+#define CHILD_ARG       "child"
+#define NUM_CHILDREN    500
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The short-lived process, and the read end of the pipe it prints its PID to.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_appProc_RefRef_t ChildRef;
+static FILE* ChildPidFilePtr;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of exits reported, time of the last kill, and total and maximum latencies, in seconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static int ExitCount = 0;
+static double KillTime;
+static double TotalLatency = 0;
+static double MaxLatency = 0;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Seconds of the monotonic clock.
+ */
+//--------------------------------------------------------------------------------------------------
+static double Seconds
+(
+    void
+)
+{
+    struct timespec time;
+
+    LE_ASSERT(0 == clock_gettime(CLOCK_MONOTONIC, &time));
+    return time.tv_sec + (time.tv_nsec / 1e9);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts the short-lived process and kills it as soon as it is running.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartAndKillChild
+(
+    void
+)
+{
+    int pid;
+
+    LE_ASSERT(le_appProc_Start(ChildRef) == LE_OK);
+
+    // The child prints its PID once it is running.
+    LE_ASSERT(fscanf(ChildPidFilePtr, "%d", &pid) == 1);
+
+    KillTime = Seconds();
+    LE_ASSERT(kill(pid, SIGKILL) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler called by the Supervisor when the short-lived process has exited.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ChildStopped
+(
+    int32_t exitCode,
+    void* contextPtr
+)
+{
+    double latency = Seconds() - KillTime;
+
+    TotalLatency += latency;
+    if (latency > MaxLatency)
+    {
+        MaxLatency = latency;
+    }
+
+    ExitCount++;
+
+    if (ExitCount < NUM_CHILDREN)
+    {
+        StartAndKillChild();
+        return;
+    }
+
+    LE_INFO("%d exits reported, latency: average %.0f us, maximum %.0f us.", ExitCount,
+            (TotalLatency * 1e6) / ExitCount, MaxLatency * 1e6);
+    LE_INFO("======== ProcChurn Test Passed ========");
+
+    exit(EXIT_SUCCESS);
+}
+
+
+COMPONENT_INIT
+{
+    const char* argPtr = le_arg_GetArg(0);
+    LE_ASSERT(argPtr != NULL);
+
+    if (strcmp(argPtr, CHILD_ARG) == 0)
+    {
+        // Short-lived process: print the PID and wait to be killed.
+        printf("%d\n", getpid());
+        fflush(stdout);
+        return;
+    }
+
+    int pipeFds[2];
+    LE_ASSERT(pipe(pipeFds) == 0);
+
+    ChildPidFilePtr = fdopen(pipeFds[0], "r");
+    LE_ASSERT(ChildPidFilePtr != NULL);
+
+    ChildRef = le_appProc_Create(argPtr, "churnChild", "/bin/procChurn");
+    LE_ASSERT(ChildRef != NULL);
+
+    le_appProc_AddArg(ChildRef, CHILD_ARG);
+    le_appProc_SetStdOut(ChildRef, pipeFds[1]);
+    le_appProc_SetFaultAction(ChildRef, LE_APPPROC_FAULT_ACTION_IGNORE);
+    le_appProc_AddStopHandler(ChildRef, ChildStopped, NULL);
+
+    LE_INFO("======== Start ProcChurn Test ========");
+
+    StartAndKillChild();
+}
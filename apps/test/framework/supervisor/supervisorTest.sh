@@ -105,5 +105,19 @@ CheckLogStr ">" 1 "======== Start 'NonSandboxedFaultApp/sigFault' Test ========"
 CheckLogStr ">" 1 "======== Start 'NonSandboxedRestartApp/noExit' Test ========"
 CheckLogStr "==" 1 "======== Start 'NonSandboxedStopApp/noExit' Test ========"
 
+echo "Testing handling of the exits of short-lived processes."
+InstallApp ProcChurnApp
+ClearLogs
+
+ssh root@$targetAddr  "$BIN_PATH/app start ProcChurnApp"
+CheckRet
+
+# Wait for all the processes to be started and killed.
+sleep 10
+
+ssh root@$targetAddr  "$BIN_PATH/app stop ProcChurnApp"
+
+CheckLogStr "==" 1 "======== ProcChurn Test Passed ========"
+
 echo "Supervisor Test Passed!"
 exit 0
@@ -0,0 +1,273 @@
+/*
+ * Benchmark of the IMA signature verification done when an update is installed.
+ *
+ * Builds an app-sized tree of files, signs each of them with a throw-away key the way evmctl does
+ * (a version 2 digital signature in the security.ima extended attribute, so this must run as
+ * root), and times the verification of the tree: by spawning a process for each file as the
+ * Update Daemon used to (evmctl when it is installed, else an empty shell command, which is the
+ * lower bound of that cost), file by file in-process, and with ima_VerifyDir().  Finally, an unsigned
+ * certificate file is added deep in the tree, then one file is altered, and the verification of
+ * the tree must fail each time.
+ *
+ * Usage: imaVerifyBench [FILE_COUNT]
+ */
+
+#include "legato.h"
+#include "ima.h"
+#include <openssl/evp.h>
+#include <openssl/rsa.h>
+#include <openssl/x509.h>
+#include <sys/xattr.h>
+
+#define WORK_DIR        "/tmp/imaVerifyBench"
+#define TREE_DIR        WORK_DIR "/app"
+#define CERT_PATH       WORK_DIR "/" PUB_CERT_NAME
+#define FILES_PER_DIR   100
+#define MAX_FILE_BYTES  (32 * 1024)
+
+// security.ima header of a version 2 signature: type, version, hash algorithm (SHA-256), key
+// identifier and signature size.
+#define SIG_HDR_BYTES   9
+
+static EVP_PKEY* KeyPtr;
+static size_t FileCount = 5000;
+static le_clk_Time_t StartTime;
+
+
+static void RunShell(const char* commandPtr)
+{
+    int status = system(commandPtr);
+
+    LE_FATAL_IF(!WIFEXITED(status) || (WEXITSTATUS(status) != 0), "'%s' failed.", commandPtr);
+}
+
+
+static bool HasTool(const char* toolPtr)
+{
+    char command[128];
+
+    snprintf(command, sizeof(command), "command -v %s > /dev/null 2>&1", toolPtr);
+
+    return (system(command) == 0);
+}
+
+
+static double ElapsedMs(void)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), StartTime);
+
+    return elapsed.sec * 1000.0 + elapsed.usec / 1000.0;
+}
+
+
+static void FilePath(char* pathPtr, size_t pathSize, size_t index)
+{
+    LE_ASSERT(snprintf(pathPtr, pathSize, TREE_DIR "/dir%zu/file%zu", index / FILES_PER_DIR,
+                       index) < pathSize);
+}
+
+
+// Generate the key and its self-signed certificate, as the DER file evmctl reads.
+static void MakeCertificate(void)
+{
+    EVP_PKEY_CTX* ctxPtr = EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, NULL);
+    LE_ASSERT(ctxPtr);
+    LE_ASSERT(EVP_PKEY_keygen_init(ctxPtr) == 1);
+    LE_ASSERT(EVP_PKEY_CTX_set_rsa_keygen_bits(ctxPtr, 2048) == 1);
+    LE_ASSERT(EVP_PKEY_keygen(ctxPtr, &KeyPtr) == 1);
+    EVP_PKEY_CTX_free(ctxPtr);
+
+    X509* crtPtr = X509_new();
+    LE_ASSERT(crtPtr);
+    ASN1_INTEGER_set(X509_get_serialNumber(crtPtr), 1);
+    X509_gmtime_adj(X509_get_notBefore(crtPtr), 0);
+    X509_gmtime_adj(X509_get_notAfter(crtPtr), 24 * 60 * 60);
+    LE_ASSERT(X509_set_pubkey(crtPtr, KeyPtr) == 1);
+    X509_NAME* namePtr = X509_get_subject_name(crtPtr);
+    X509_NAME_add_entry_by_txt(namePtr, "CN", MBSTRING_ASC, (const unsigned char*)"imaVerifyBench",
+                               -1, -1, 0);
+    LE_ASSERT(X509_set_issuer_name(crtPtr, namePtr) == 1);
+    LE_ASSERT(X509_sign(crtPtr, KeyPtr, EVP_sha256()) > 0);
+
+    FILE* filePtr = fopen(CERT_PATH, "w");
+    LE_ASSERT(filePtr);
+    LE_ASSERT(i2d_X509_fp(filePtr, crtPtr) == 1);
+    fclose(filePtr);
+    X509_free(crtPtr);
+}
+
+
+static void SignFile(const char* pathPtr, const uint8_t* dataPtr, size_t size)
+{
+    uint8_t xattr[SIG_HDR_BYTES + 512];
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int digestLen;
+    size_t sigLen = sizeof(xattr) - SIG_HDR_BYTES;
+
+    LE_ASSERT(EVP_Digest(dataPtr, size, digest, &digestLen, EVP_sha256(), NULL) == 1);
+
+    EVP_PKEY_CTX* ctxPtr = EVP_PKEY_CTX_new(KeyPtr, NULL);
+    LE_ASSERT(ctxPtr);
+    LE_ASSERT(EVP_PKEY_sign_init(ctxPtr) == 1);
+    LE_ASSERT(EVP_PKEY_CTX_set_rsa_padding(ctxPtr, RSA_PKCS1_PADDING) == 1);
+    LE_ASSERT(EVP_PKEY_CTX_set_signature_md(ctxPtr, EVP_sha256()) == 1);
+    LE_ASSERT(EVP_PKEY_sign(ctxPtr, &xattr[SIG_HDR_BYTES], &sigLen, digest, digestLen) == 1);
+    EVP_PKEY_CTX_free(ctxPtr);
+
+    xattr[0] = 0x03;                    // Digital signature
+    xattr[1] = 2;                       // Version 2
+    xattr[2] = 4;                       // SHA-256
+    memset(&xattr[3], 0, 4);            // Key identifier, not checked with an explicit key
+    xattr[7] = sigLen >> 8;
+    xattr[8] = sigLen & 0xFF;
+
+    LE_FATAL_IF(setxattr(pathPtr, "security.ima", xattr, SIG_HDR_BYTES + sigLen, 0) != 0,
+                "Cannot set security.ima of '%s' (%m). Run as root on a file system supporting it.",
+                pathPtr);
+}
+
+
+// Files of random sizes, spread in directories as in an app.
+static void MakeTree(void)
+{
+    static uint8_t buffer[MAX_FILE_BYTES];
+    size_t totalBytes = 0;
+    size_t i;
+
+    RunShell("rm -rf " WORK_DIR);
+    LE_ASSERT(le_dir_MakePath(WORK_DIR, S_IRWXU) == LE_OK);
+    MakeCertificate();
+
+    for (i = 0; i < FileCount; i++)
+    {
+        char path[PATH_MAX];
+        size_t size = 1 + (le_rand_GetNumBetween(0, MAX_FILE_BYTES - 1));
+
+        if (i % FILES_PER_DIR == 0)
+        {
+            LE_ASSERT(snprintf(path, sizeof(path), TREE_DIR "/dir%zu", i / FILES_PER_DIR)
+                      < sizeof(path));
+            LE_ASSERT(le_dir_MakePath(path, S_IRWXU) == LE_OK);
+        }
+        FilePath(path, sizeof(path), i);
+
+        le_rand_GetBuffer(buffer, size);
+
+        int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+        LE_ASSERT(fd >= 0);
+        LE_ASSERT(write(fd, buffer, size) == size);
+        close(fd);
+
+        SignFile(path, buffer, size);
+        totalBytes += size;
+    }
+
+    LE_INFO("Tree: %zu files, %zu bytes.", FileCount, totalBytes);
+}
+
+
+static void RunSpawnPerFile(void)
+{
+    bool hasEvmctl = HasTool("evmctl");
+    char command[PATH_MAX + 128];
+    size_t i;
+
+    StartTime = le_clk_GetRelativeTime();
+    for (i = 0; i < FileCount; i++)
+    {
+        char path[PATH_MAX];
+
+        FilePath(path, sizeof(path), i);
+        if (hasEvmctl)
+        {
+            snprintf(command, sizeof(command), "evmctl ima_verify %s -k %s > /dev/null",
+                     path, CERT_PATH);
+        }
+        else
+        {
+            snprintf(command, sizeof(command), ": %s", path);
+        }
+        RunShell(command);
+    }
+
+    LE_INFO("%-22s %9.1f ms", hasEvmctl ? "evmctl per file" : "shell per file (no evmctl)",
+            ElapsedMs());
+}
+
+
+static void RunInProcessPerFile(void)
+{
+    size_t i;
+
+    StartTime = le_clk_GetRelativeTime();
+    for (i = 0; i < FileCount; i++)
+    {
+        char path[PATH_MAX];
+
+        FilePath(path, sizeof(path), i);
+        LE_ASSERT(ima_VerifyFile(path, CERT_PATH) == LE_OK);
+    }
+
+    LE_INFO("%-22s %9.1f ms", "ima_VerifyFile", ElapsedMs());
+}
+
+
+static void RunVerifyDir(void)
+{
+    StartTime = le_clk_GetRelativeTime();
+    LE_ASSERT(ima_VerifyDir(TREE_DIR, CERT_PATH) == LE_OK);
+
+    LE_INFO("%-22s %9.1f ms  (%ld CPUs)", "ima_VerifyDir", ElapsedMs(),
+            sysconf(_SC_NPROCESSORS_ONLN));
+}
+
+
+// Only the certificate at the top of the tree is left out of the verification: an unsigned file
+// with the same name anywhere else must fail it.
+static void RunNestedCertificate(void)
+{
+    RunShell("cp " CERT_PATH " " TREE_DIR "/" PUB_CERT_NAME);
+    LE_ASSERT(ima_VerifyDir(TREE_DIR, CERT_PATH) == LE_OK);
+
+    RunShell("cp " CERT_PATH " " TREE_DIR "/dir0/" PUB_CERT_NAME);
+    LE_ASSERT(ima_VerifyDir(TREE_DIR, CERT_PATH) == LE_FAULT);
+    LE_INFO("Unsigned nested certificate detected.");
+
+    RunShell("rm " TREE_DIR "/" PUB_CERT_NAME " " TREE_DIR "/dir0/" PUB_CERT_NAME);
+}
+
+
+// The last file keeps its signature but not its content.
+static void RunAlteredFile(void)
+{
+    char path[PATH_MAX];
+
+    FilePath(path, sizeof(path), FileCount - 1);
+    int fd = open(path, O_WRONLY | O_APPEND);
+    LE_ASSERT(fd >= 0);
+    LE_ASSERT(write(fd, "x", 1) == 1);
+    close(fd);
+
+    LE_ASSERT(ima_VerifyDir(TREE_DIR, CERT_PATH) == LE_FAULT);
+    LE_INFO("Altered file detected.");
+}
+
+
+COMPONENT_INIT
+{
+    if (le_arg_NumArgs() >= 1)
+    {
+        FileCount = atoi(le_arg_GetArg(0));
+    }
+    LE_ASSERT(FileCount > 0);
+
+    MakeTree();
+    RunSpawnPerFile();
+    RunInProcessPerFile();
+    RunVerifyDir();
+    RunNestedCertificate();
+    RunAlteredFile();
+
+    RunShell("rm -rf " WORK_DIR);
+    exit(EXIT_SUCCESS);
+}
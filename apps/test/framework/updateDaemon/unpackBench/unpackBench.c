@@ -0,0 +1,317 @@
+/*
+ * Benchmark of the Update Daemon's payload unpacker.
+ *
+ * Builds a system-sized payload (a mix of compressible and incompressible files), compresses it
+ * with each codec whose command-line tool is available on the target, and times how long the
+ * in-process unpacker takes to extract it.  For comparison, the bzip2 payload is also extracted
+ * by the external tar that the Update Daemon used to fork.  Finally, the bzip2 payload is unpacked
+ * twice through the object store, to time the unpack of an app whose files are all unchanged.
+ *
+ * Usage: unpackBench [PAYLOAD_MB]
+ */
+
+#include "legato.h"
+#include "untar.h"
+#include "objStore.h"
+
+#define WORK_DIR        "/tmp/unpackBench"
+#define SRC_DIR         WORK_DIR "/src"
+#define OUT_DIR         WORK_DIR "/out"
+#define OBJ_DIR         WORK_DIR "/objects"
+#define PAYLOAD_TAR     WORK_DIR "/payload.tar"
+#define FILE_BYTES      (256 * 1024)
+
+typedef struct
+{
+    const char* name;           ///< Codec name.
+    const char* tool;           ///< Command-line tool used to compress.
+    const char* compressCmd;    ///< Command that compresses stdin to stdout.
+}
+Codec_t;
+
+static const Codec_t Codecs[] =
+{
+    { "bzip2", "bzip2", "bzip2 -9" },
+    { "xz",    "xz",    "xz -6 -T0" },
+    { "zstd",  "zstd",  "zstd -19 -T0" },
+};
+
+static size_t CodecIndex = 0;
+static size_t FileCount = 0;
+static int WriteFd = -1;
+static char PayloadPath[PATH_MAX];
+static le_clk_Time_t StartTime;
+static int DedupPass = 0;
+
+
+static void RunShell(const char* commandPtr)
+{
+    int status = system(commandPtr);
+
+    LE_FATAL_IF(!WIFEXITED(status) || (WEXITSTATUS(status) != 0), "'%s' failed.", commandPtr);
+}
+
+
+static bool HasTool(const char* toolPtr)
+{
+    char command[128];
+
+    snprintf(command, sizeof(command), "command -v %s > /dev/null 2>&1", toolPtr);
+
+    return (system(command) == 0);
+}
+
+
+static double ElapsedMs(void)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), StartTime);
+
+    return elapsed.sec * 1000.0 + elapsed.usec / 1000.0;
+}
+
+
+static off_t FileSize(const char* pathPtr)
+{
+    struct stat st;
+
+    LE_ASSERT(stat(pathPtr, &st) == 0);
+
+    return st.st_size;
+}
+
+
+// Half of the files are text (compressible), the other half random bytes.
+static void MakePayload(size_t payloadMb)
+{
+    static uint8_t buffer[FILE_BYTES];
+    size_t numFiles = payloadMb * 1024 * 1024 / FILE_BYTES;
+    size_t i;
+
+    RunShell("rm -rf " WORK_DIR);
+    LE_ASSERT(le_dir_MakePath(SRC_DIR, S_IRWXU) == LE_OK);
+
+    for (i = 0; i < numFiles; i++)
+    {
+        char dirPath[PATH_MAX];
+        char path[PATH_MAX];
+        size_t j;
+
+        LE_ASSERT(snprintf(dirPath, sizeof(dirPath), SRC_DIR "/apps/app%zu/bin", i % 16)
+                  < sizeof(dirPath));
+        LE_ASSERT(snprintf(path, sizeof(path), "%s/file%zu", dirPath, i) < sizeof(path));
+        LE_ASSERT(le_dir_MakePath(dirPath, S_IRWXU) == LE_OK);
+
+        if (i % 2)
+        {
+            le_rand_GetBuffer(buffer, sizeof(buffer));
+        }
+        else
+        {
+            for (j = 0; j < sizeof(buffer); j++)
+            {
+                buffer[j] = "LE_INFO(\"unpack benchmark\");\n"[(i + j) % 29];
+            }
+        }
+
+        int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+        LE_ASSERT(fd >= 0);
+        LE_ASSERT(write(fd, buffer, sizeof(buffer)) == sizeof(buffer));
+        close(fd);
+    }
+
+    RunShell("tar cf " PAYLOAD_TAR " -C " SRC_DIR " .");
+    LE_INFO("Payload: %zu files, %zu bytes.", numFiles, (size_t)FileSize(PAYLOAD_TAR));
+}
+
+
+static void* WriterThreadMain(void* contextPtr)
+{
+    int fd = open(PayloadPath, O_RDONLY);
+    static uint8_t buffer[64 * 1024];
+    ssize_t len;
+
+    LE_ASSERT(fd >= 0);
+
+    while ((len = read(fd, buffer, sizeof(buffer))) > 0)
+    {
+        LE_ASSERT(write(WriteFd, buffer, len) == len);
+    }
+
+    close(fd);
+    close(WriteFd);
+
+    return NULL;
+}
+
+
+static le_result_t FileHandler(const char* pathPtr, const uint8_t* digestPtr, void* contextPtr)
+{
+    FileCount++;
+
+    return LE_OK;
+}
+
+
+static le_result_t LinkHandler(const char* pathPtr, const uint8_t* digestPtr, mode_t mode,
+                               void* contextPtr)
+{
+    return objStore_Link("unpackBench", digestPtr, mode, pathPtr);
+}
+
+
+static le_result_t AddHandler(const char* pathPtr, const uint8_t* digestPtr, void* contextPtr)
+{
+    FileCount++;
+    objStore_Add("unpackBench", digestPtr, pathPtr);
+
+    return LE_OK;
+}
+
+
+static void RunNextCodec(void);
+static void RunDedupPass(void);
+
+
+static void DedupDone(untar_Ref_t ref, le_result_t result, void* contextPtr)
+{
+    double ms = ElapsedMs();
+    objStore_Stats_t stats;
+
+    untar_Delete(ref);
+    LE_ASSERT(result == LE_OK);
+
+    objStore_TakeStats(&stats);
+    LE_INFO("dedup%d  %8.1f ms  %zu files written, %zu linked (%" PRIu64 " bytes not written),"
+            " %zu objects added",
+            DedupPass, ms, FileCount, stats.linkedFiles, stats.linkedBytes, stats.addedFiles);
+
+    if (++DedupPass < 2)
+    {
+        RunDedupPass();
+    }
+    else
+    {
+        RunShell("rm -rf " WORK_DIR);
+        exit(EXIT_SUCCESS);
+    }
+}
+
+
+static void RunDedupPass(void)
+{
+    char command[PATH_MAX];
+
+    LE_ASSERT(snprintf(command, sizeof(command), "rm -rf %s%d && mkdir %s%d",
+                       OUT_DIR, DedupPass, OUT_DIR, DedupPass) < sizeof(command));
+    RunShell(command);
+    LE_ASSERT(snprintf(command, sizeof(command), "%s%d", OUT_DIR, DedupPass) < sizeof(command));
+
+    FileCount = 0;
+    StartTime = le_clk_GetRelativeTime();
+
+    untar_Start(command, NULL, DedupDone, LinkHandler, AddHandler, NULL, &WriteFd);
+
+    le_thread_Ref_t writer = le_thread_Create("writer", WriterThreadMain, NULL);
+    le_thread_Start(writer);
+}
+
+
+static void UnpackDone(untar_Ref_t ref, le_result_t result, void* contextPtr)
+{
+    double ms = ElapsedMs();
+    const Codec_t* codecPtr = &Codecs[CodecIndex];
+
+    untar_Delete(ref);
+
+    if (result != LE_OK)
+    {
+        // Codecs other than bzip2 are optional in the Update Daemon.
+        LE_WARN("%-6s  unpack failed (%s), not built in?", codecPtr->name, LE_RESULT_TXT(result));
+    }
+    else
+    {
+        LE_INFO("%-6s  %10zu bytes  %8.1f ms  %7.1f MB/s (tarball)  %zu files hashed",
+                codecPtr->name,
+                (size_t)FileSize(PayloadPath),
+                ms,
+                FileSize(PAYLOAD_TAR) / (ms * 1000.0),
+                FileCount);
+    }
+
+    CodecIndex++;
+    RunNextCodec();
+}
+
+
+static void RunExternalTar(void)
+{
+    char command[PATH_MAX * 2];
+
+    snprintf(PayloadPath, sizeof(PayloadPath), PAYLOAD_TAR ".bzip2");
+    LE_ASSERT(snprintf(command, sizeof(command),
+                       "rm -rf " OUT_DIR " && mkdir " OUT_DIR " && "
+                       "(bsdtar xjmop -f %s -C " OUT_DIR " 2>/dev/null"
+                       " || tar xjop -f %s -C " OUT_DIR ")",
+                       PayloadPath, PayloadPath) < sizeof(command));
+
+    StartTime = le_clk_GetRelativeTime();
+    RunShell(command);
+    double ms = ElapsedMs();
+
+    LE_INFO("%-6s  %10zu bytes  %8.1f ms  %7.1f MB/s (tarball)  external tar",
+            "bzip2",
+            (size_t)FileSize(PayloadPath),
+            ms,
+            FileSize(PAYLOAD_TAR) / (ms * 1000.0));
+}
+
+
+static void RunNextCodec(void)
+{
+    char command[PATH_MAX * 2];
+
+    while ((CodecIndex < NUM_ARRAY_MEMBERS(Codecs)) && !HasTool(Codecs[CodecIndex].tool))
+    {
+        LE_INFO("%-6s  skipped, '%s' not available", Codecs[CodecIndex].name,
+                Codecs[CodecIndex].tool);
+        CodecIndex++;
+    }
+
+    if (CodecIndex >= NUM_ARRAY_MEMBERS(Codecs))
+    {
+        RunExternalTar();
+        objStore_Init(OBJ_DIR);
+        RunDedupPass();
+        return;
+    }
+
+    const Codec_t* codecPtr = &Codecs[CodecIndex];
+
+    snprintf(PayloadPath, sizeof(PayloadPath), PAYLOAD_TAR ".%s", codecPtr->name);
+    LE_ASSERT(snprintf(command, sizeof(command), "%s < " PAYLOAD_TAR " > %s",
+                       codecPtr->compressCmd, PayloadPath) < sizeof(command));
+    RunShell(command);
+    RunShell("rm -rf " OUT_DIR " && mkdir " OUT_DIR);
+
+    FileCount = 0;
+    StartTime = le_clk_GetRelativeTime();
+
+    untar_Start(OUT_DIR, NULL, UnpackDone, NULL, FileHandler, NULL, &WriteFd);
+
+    le_thread_Ref_t writer = le_thread_Create("writer", WriterThreadMain, NULL);
+    le_thread_Start(writer);
+}
+
+
+COMPONENT_INIT
+{
+    size_t payloadMb = 64;
+
+    if (le_arg_NumArgs() >= 1)
+    {
+        payloadMb = atoi(le_arg_GetArg(0));
+    }
+
+    MakePayload(payloadMb);
+    RunNextCodec();
+}
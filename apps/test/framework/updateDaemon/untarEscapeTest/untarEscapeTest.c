@@ -0,0 +1,238 @@
+/*
+ * Test of the Update Daemon's payload unpacker against archives that try to write outside of the
+ * destination directory.
+ *
+ * Each archive is built in memory and extracted into an empty directory.  The unsafe ones must
+ * be refused, and must leave the file next to the destination directory untouched.  The last one
+ * has the kinds of symlinks found in real system updates, and must be extracted.
+ *
+ * Usage: untarEscapeTest
+ */
+
+#include "legato.h"
+#include "untar.h"
+
+#define WORK_DIR        "/tmp/untarEscapeTest"
+#define OUT_DIR         WORK_DIR "/out"
+#define OUTSIDE_DIR     WORK_DIR "/outside"
+#define VICTIM_FILE     OUTSIDE_DIR "/passwd"
+#define VICTIM_TEXT     "original\n"
+
+typedef struct
+{
+    char type;                  ///< Tar type flag ('0' file, '1' hard link, '2' symlink, '5' dir).
+    const char* name;           ///< Name of the entry.
+    const char* link;           ///< Target of a link, or contents of a file.
+}
+Entry_t;
+
+typedef struct
+{
+    const char* name;           ///< Name of the case.
+    const char* linkRootPath;   ///< Where absolute symlinks can point (NULL for nowhere).
+    le_result_t expected;       ///< Expected result of the extraction.
+    Entry_t entries[6];         ///< Entries of the archive, up to one with a NULL name.
+}
+Case_t;
+
+static const Case_t Cases[] =
+{
+    {
+        "absolute symlink, then a file through it", NULL, LE_FORMAT_ERROR,
+        {
+            { '2', "a", OUTSIDE_DIR },
+            { '0', "a/passwd", "overwritten\n" },
+        }
+    },
+    {
+        "allowed absolute symlink, then a file through it", OUTSIDE_DIR, LE_FORMAT_ERROR,
+        {
+            { '2', "a", OUTSIDE_DIR "/." },
+            { '0', "a/passwd", "overwritten\n" },
+        }
+    },
+    {
+        "relative symlink out of the directory", NULL, LE_FORMAT_ERROR,
+        {
+            { '5', "sub/", NULL },
+            { '2', "sub/a", "../../outside" },
+            { '0', "sub/a/passwd", "overwritten\n" },
+        }
+    },
+    {
+        "symlink climbing from another symlink", NULL, LE_FORMAT_ERROR,
+        {
+            { '2', "q", "." },
+            { '2', "a", "q/../outside" },
+            { '0', "a/passwd", "overwritten\n" },
+        }
+    },
+    {
+        "directory over a symlink to a directory", OUTSIDE_DIR, LE_FAULT,
+        {
+            { '2', "a", OUTSIDE_DIR "/." },
+            { '5', "a/", NULL },
+        }
+    },
+    {
+        "hard link through a symlink", OUTSIDE_DIR, LE_FORMAT_ERROR,
+        {
+            { '2', "a", OUTSIDE_DIR "/." },
+            { '1', "h", "a/passwd" },
+        }
+    },
+    {
+        "symlinks of a system update", OUTSIDE_DIR, LE_OK,
+        {
+            { '5', "apps/", NULL },
+            { '2', "apps/x", OUTSIDE_DIR "/x" },
+            { '0', "cmds/y/read-only/bin/cmd", "#!/bin/sh\n" },
+            { '2', "bin/cmd", "../cmds/y/read-only/bin/cmd" },
+            { '2', "bin/self", "./cmd" },
+        }
+    },
+};
+
+static size_t CaseIndex = 0;
+static uint8_t Archive[64 * 1024];
+static size_t ArchiveLen;
+
+
+static void RunShell(const char* commandPtr)
+{
+    int status = system(commandPtr);
+
+    LE_FATAL_IF(!WIFEXITED(status) || (WEXITSTATUS(status) != 0), "'%s' failed.", commandPtr);
+}
+
+
+static void AddBlock(const void* dataPtr, size_t len)
+{
+    LE_ASSERT(ArchiveLen + 512 <= sizeof(Archive));
+
+    memset(Archive + ArchiveLen, 0, 512);
+    memcpy(Archive + ArchiveLen, dataPtr, len);
+    ArchiveLen += 512;
+}
+
+
+static void AddEntry(const Entry_t* entryPtr)
+{
+    uint8_t header[512] = { 0 };
+    size_t size = (entryPtr->type == '0') ? strlen(entryPtr->link) : 0;
+    unsigned int checksum = 0;
+    size_t i;
+
+    strncpy((char*)header, entryPtr->name, 100);
+    snprintf((char*)header + 100, 8, "%07o", (entryPtr->type == '5') ? 0755 : 0644);
+    snprintf((char*)header + 108, 8, "%07o", 0);
+    snprintf((char*)header + 116, 8, "%07o", 0);
+    snprintf((char*)header + 124, 12, "%011o", (unsigned int)size);
+    snprintf((char*)header + 136, 12, "%011o", 0);
+    memset(header + 148, ' ', 8);
+    header[156] = entryPtr->type;
+    if ((entryPtr->type == '1') || (entryPtr->type == '2'))
+    {
+        strncpy((char*)header + 157, entryPtr->link, 100);
+    }
+    memcpy(header + 257, "ustar", 6);
+    memcpy(header + 263, "00", 2);
+
+    for (i = 0; i < sizeof(header); i++)
+    {
+        checksum += header[i];
+    }
+    snprintf((char*)header + 148, 8, "%06o", checksum);
+
+    AddBlock(header, sizeof(header));
+    if (size > 0)
+    {
+        AddBlock(entryPtr->link, size);
+    }
+}
+
+
+static void CheckVictim(void)
+{
+    char buffer[64] = "";
+    int fd = open(VICTIM_FILE, O_RDONLY);
+
+    LE_ASSERT(fd >= 0);
+    LE_ASSERT(read(fd, buffer, sizeof(buffer) - 1) >= 0);
+    close(fd);
+
+    LE_FATAL_IF(strcmp(buffer, VICTIM_TEXT) != 0, "'%s' was modified.", VICTIM_FILE);
+}
+
+
+static void RunNextCase(void);
+
+
+static void ExtractDone(untar_Ref_t ref, le_result_t result, void* contextPtr)
+{
+    const Case_t* casePtr = &Cases[CaseIndex];
+
+    untar_Delete(ref);
+
+    LE_FATAL_IF(result != casePtr->expected, "'%s': got %s instead of %s.", casePtr->name,
+                LE_RESULT_TXT(result), LE_RESULT_TXT(casePtr->expected));
+    CheckVictim();
+
+    if (result == LE_OK)
+    {
+        char target[PATH_MAX];
+        ssize_t len = readlink(OUT_DIR "/apps/x", target, sizeof(target) - 1);
+
+        LE_ASSERT(len > 0);
+        target[len] = '\0';
+        LE_ASSERT(strcmp(target, OUTSIDE_DIR "/x") == 0);
+        LE_ASSERT(access(OUT_DIR "/bin/self", F_OK) == 0);
+    }
+
+    LE_INFO("'%s': %s as expected.", casePtr->name, LE_RESULT_TXT(result));
+
+    CaseIndex++;
+    RunNextCase();
+}
+
+
+static void RunNextCase(void)
+{
+    const Case_t* casePtr;
+    int writeFd;
+    size_t i;
+
+    if (CaseIndex >= NUM_ARRAY_MEMBERS(Cases))
+    {
+        RunShell("rm -rf " WORK_DIR);
+        LE_INFO("======== untar escape test passed ========");
+        exit(EXIT_SUCCESS);
+    }
+    casePtr = &Cases[CaseIndex];
+
+    RunShell("rm -rf " OUT_DIR " && mkdir -p " OUT_DIR);
+
+    ArchiveLen = 0;
+    for (i = 0; (i < NUM_ARRAY_MEMBERS(casePtr->entries)) && (casePtr->entries[i].name != NULL);
+         i++)
+    {
+        AddEntry(&casePtr->entries[i]);
+    }
+    AddBlock("", 0);
+    AddBlock("", 0);
+
+    untar_Start(OUT_DIR, casePtr->linkRootPath, ExtractDone, NULL, NULL, NULL, &writeFd);
+
+    // The archive is small enough to fit in the pipe.
+    LE_ASSERT(write(writeFd, Archive, ArchiveLen) == (ssize_t)ArchiveLen);
+    close(writeFd);
+}
+
+
+COMPONENT_INIT
+{
+    RunShell("rm -rf " WORK_DIR " && mkdir -p " OUTSIDE_DIR " && printf '" VICTIM_TEXT "' > "
+             VICTIM_FILE);
+
+    RunNextCase();
+}
@@ -0,0 +1,176 @@
+/**
+ * Benchmark of the user and group lookups.
+ *
+ * A number of app users are created, and their names, user IDs and app names are looked up in
+ * turn.  The number of lookups per second is printed, compared with looking the user names up
+ * through the C library under a read lock of the passwd file, as user.c used to.  The users are
+ * deleted at the end.  Must be run as root, with /etc writable.
+ *
+ * Usage: userBench [USERS [LOOKUPS]]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "user.h"
+#include <pwd.h>
+
+#define DEFAULT_USERS       200
+#define DEFAULT_LOOKUPS     100000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of app users, and number of lookups of each run.
+ */
+//--------------------------------------------------------------------------------------------------
+static int UserCount = DEFAULT_USERS;
+static int LookupCount = DEFAULT_LOOKUPS;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Seconds of the monotonic clock.
+ */
+//--------------------------------------------------------------------------------------------------
+static double Seconds
+(
+    void
+)
+{
+    struct timespec time;
+
+    LE_ASSERT(0 == clock_gettime(CLOCK_MONOTONIC, &time));
+    return time.tv_sec + (time.tv_nsec / 1e9);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print the throughput of a run.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrintResult
+(
+    const char* namePtr,        ///< [IN] Name of the run
+    double seconds              ///< [IN] Duration of the run
+)
+{
+    printf("%-20s %12.0f lookups/s\n", namePtr, LookupCount / seconds);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Name of an app user of the benchmark.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetUserName
+(
+    int userNum,                ///< [IN] Number of the user
+    char* nameBufPtr,           ///< [OUT] Buffer of the name
+    size_t nameBufSize          ///< [IN] Size of the buffer
+)
+{
+    snprintf(nameBufPtr, nameBufSize, "appUserBench%03d", userNum);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Look a user name up the way user.c used to: through the C library, which reads the passwd file,
+ * under a read lock of the file.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t LegacyGetName
+(
+    uid_t uid,                  ///< [IN] User ID
+    char* nameBufPtr,           ///< [OUT] Buffer of the name
+    size_t nameBufSize          ///< [IN] Size of the buffer
+)
+{
+    char buf[1024];
+    struct passwd pwd;
+    struct passwd* resultPtr;
+    le_result_t result = LE_NOT_FOUND;
+
+    int fd = le_flock_Open("/etc/passwd", LE_FLOCK_READ);
+    LE_ASSERT(fd >= 0);
+
+    if ((getpwuid_r(uid, &pwd, buf, sizeof(buf), &resultPtr) == 0) && (resultPtr != NULL))
+    {
+        result = le_utf8_Copy(nameBufPtr, pwd.pw_name, nameBufSize, NULL);
+    }
+
+    le_flock_Close(fd);
+
+    return result;
+}
+
+COMPONENT_INIT
+{
+    uid_t uids[DEFAULT_USERS * 10];
+    char name[100];
+    double startTime;
+    int i;
+
+    if (le_arg_NumArgs() >= 1)
+    {
+        UserCount = atoi(le_arg_GetArg(0));
+    }
+    if (le_arg_NumArgs() >= 2)
+    {
+        LookupCount = atoi(le_arg_GetArg(1));
+    }
+    LE_FATAL_IF((UserCount <= 0) || (UserCount > NUM_ARRAY_MEMBERS(uids)) || (LookupCount <= 0),
+                "Usage: userBench [USERS [LOOKUPS]]");
+
+    user_Init();
+
+    for (i = 0; i < UserCount; i++)
+    {
+        le_result_t result;
+
+        GetUserName(i, name, sizeof(name));
+        result = user_Create(name, &uids[i], NULL);
+        LE_FATAL_IF((result != LE_OK) && (result != LE_DUPLICATE),
+                    "Could not create user '%s'.", name);
+    }
+
+    printf("%d app users, %d lookups per run\n", UserCount, LookupCount);
+
+    startTime = Seconds();
+    for (i = 0; i < LookupCount; i++)
+    {
+        LE_ASSERT_OK(user_GetName(uids[i % UserCount], name, sizeof(name)));
+    }
+    PrintResult("user_GetName", Seconds() - startTime);
+
+    startTime = Seconds();
+    for (i = 0; i < LookupCount; i++)
+    {
+        uid_t uid;
+
+        GetUserName(i % UserCount, name, sizeof(name));
+        LE_ASSERT_OK(user_GetUid(name, &uid));
+        LE_ASSERT(uid == uids[i % UserCount]);
+    }
+    PrintResult("user_GetUid", Seconds() - startTime);
+
+    startTime = Seconds();
+    for (i = 0; i < LookupCount; i++)
+    {
+        LE_ASSERT_OK(user_GetAppName(uids[i % UserCount], name, sizeof(name)));
+    }
+    PrintResult("user_GetAppName", Seconds() - startTime);
+
+    startTime = Seconds();
+    for (i = 0; i < LookupCount; i++)
+    {
+        LE_ASSERT_OK(LegacyGetName(uids[i % UserCount], name, sizeof(name)));
+    }
+    PrintResult("legacy GetName", Seconds() - startTime);
+
+    for (i = 0; i < UserCount; i++)
+    {
+        GetUserName(i, name, sizeof(name));
+        LE_ASSERT_OK(user_Delete(name));
+    }
+
+    exit(EXIT_SUCCESS);
+}
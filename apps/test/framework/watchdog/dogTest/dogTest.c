@@ -1,6 +1,8 @@
 #include "legato.h"
 #include "interfaces.h"
+#include "wdogHeartbeat.h"
 #include <time.h>
+#include <sys/mman.h>
 
 #define timeval_to_ms(x) ( (x.tv_sec * 1000) + (x.tv_usec / 1000) )
 #define timeval_to_us(x) ( (x.tv_sec * 1000000) + (x.tv_usec) )
@@ -21,10 +23,11 @@ struct timeval timeval_sub(struct timeval x,struct timeval y)
  * This watchdog test begins kicking at start up and waits an increasing amount of time between
  * kicks until it crosses the configured timeout and is killed.
  *
- * The test takes 2 arguments.
+ * The test takes 2 arguments, and an optional third one.
  *
  *      start_duration  How many milliseconds to sleep on the first iteration
  *      increment       How many milliseconds longer to sleep on each successive iterations
+ *      heartbeat       Kick through the shared memory heartbeat rather than with le_wdog_Kick()
  *
  * An arbitrary maximum sleep of 60 seconds has been chosen for this test
  * so that it can end in a reasonable time - however, at a small enough increment it can still take
@@ -56,6 +59,7 @@ COMPONENT_INIT
     le_result_t result;
     int millisecondIncrement;
     int millisecondSleep;
+    wdogHeartbeat_t* heartbeatPtr = NULL;
 
     int numArgs = le_arg_NumArgs();
     LE_INFO("numArgs = %d", numArgs);
@@ -80,13 +84,33 @@ COMPONENT_INIT
                 millisecondsStr,
                 LE_RESULT_TXT(result));
 
+    if ((numArgs >= 3) && (0 == strcmp(le_arg_GetArg(2), "heartbeat")))
+    {
+        int fd;
+
+        LE_ASSERT_OK(le_wdog_GetHeartbeat(&fd));
+        heartbeatPtr = mmap(NULL, sizeof(wdogHeartbeat_t), PROT_READ | PROT_WRITE, MAP_SHARED,
+                            fd, 0);
+        close(fd);
+        LE_ASSERT(heartbeatPtr != MAP_FAILED);
+        LE_ASSERT(heartbeatPtr->magic == WDOG_HEARTBEAT_MAGIC);
+        LE_INFO("Kicking through heartbeat");
+    }
+
     for ( ;
           millisecondSleep < millisecondLimit;
           millisecondSleep += millisecondIncrement)
     {
         gettimeofday(&t1, NULL);
         LE_INFO("le_wdog_Kick then sleep for %d usec", millisecondSleep * 1000);
-        le_wdog_Kick();
+        if (heartbeatPtr != NULL)
+        {
+            wdogHeartbeat_Kick(heartbeatPtr);
+        }
+        else
+        {
+            le_wdog_Kick();
+        }
         gettimeofday(&t2, NULL);
         LE_INFO("kick took %ld usec", timeval_to_us(timeval_sub(t2, t1)));
         usleep(millisecondSleep * 1000);
@@ -224,6 +224,12 @@ set_test_message dogTest "Test if watchdog times out as per new timeout value we
 launch dogTest dogTestWatcher.sh 10
 wait_for_results
 
+# test that kicks through the shared memory heartbeat are seen as le_wdog_Kick() ones
+export DOG_TEST_TIMEOUT=5000
+set_test_message dogTestHeartbeat "Test if watchdog times out as configured when kicked through the heartbeat:"
+launch dogTestHeartbeat dogTestWatcher.sh 30
+wait_for_results
+
 # test that watchdog uses default when there is no watchdogTimeout: configured
 export DOG_TEST_TIMEOUT=30000
 ssh root@${TARGET_ADDR} "${bin_path}config delete apps/dogTest/watchdogTimeout"
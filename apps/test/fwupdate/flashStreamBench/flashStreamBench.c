@@ -0,0 +1,348 @@
+/**
+ * Benchmark of the writing of an image to a flash partition: a loop of le_flash_Write() and
+ * le_flash_Read() calls against le_flash_WriteStream(), on the file-backed flash platform
+ * adaptor.
+ *
+ * A producer thread stands for the download of the image: it writes the image to a pipe by chunks,
+ * each one taking its time at the download rate from the time the previous one was written, as a
+ * link only buffered by the pipe would.  The loop reads a block from the pipe, writes it, reads it
+ * back and compares it, as a client of le_flash does it today, so the download, the erase, the
+ * write and the verification of the blocks are done one after the other.  The stream is given the
+ * read end of the pipe and overlaps them.  Both write the same image to the same partition, which
+ * is checked afterwards, and the throughput is printed in MB/s.
+ *
+ * Usage: flashStreamBench [DOWNLOAD_RATE_KBPS [IMAGE_KB]]
+ *
+ * A download rate of 0 writes the image to the pipe as fast as it is read.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+
+#define PA_FLASH_DIR            "/tmp/pa_flash"
+#define PARTITION_NAME          "bench"
+#define PARTITION_SIZE          (16 * 1024 * 1024)
+#define ERASE_BLOCK_SIZE        (256 * 1024)
+#define DEFAULT_RATE_KBPS       16384
+#define DEFAULT_IMAGE_KB        (12 * 1024 + 100)   // Last block partial
+#define CHUNK_SIZE              (16 * 1024)         // Size of the chunks downloaded
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Image to write, and the rate it is downloaded at.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t* ImagePtr;
+static size_t   ImageSize;
+static uint32_t RateKbps = DEFAULT_RATE_KBPS;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Time the current run started at.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_clk_Time_t StartTime;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Seconds elapsed since StartTime.
+ */
+//--------------------------------------------------------------------------------------------------
+static double Elapsed
+(
+    void
+)
+{
+    le_clk_Time_t time = le_clk_Sub(le_clk_GetRelativeTime(), StartTime);
+
+    return time.sec + (time.usec / 1e6);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Producer thread: write the image to the pipe, paced at the download rate.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* Download
+(
+    void* contextPtr        ///< [IN] Write end of the pipe
+)
+{
+    int fd = (int)(intptr_t)contextPtr;
+    size_t done = 0;
+    double dueTime = 0;
+
+    while (done < ImageSize)
+    {
+        size_t size = ImageSize - done;
+        ssize_t written;
+
+        if (size > CHUNK_SIZE)
+        {
+            size = CHUNK_SIZE;
+        }
+        if (RateKbps)
+        {
+            // A chunk takes its time to be downloaded once the previous one is read, as the link
+            // is only buffered by the pipe.
+            double now = Elapsed();
+
+            dueTime = (dueTime > now ? dueTime : now) + (size / (RateKbps * 1024.0));
+            usleep((useconds_t)((dueTime - now) * 1e6));
+        }
+        written = write(fd, ImagePtr + done, size);
+        if (written < 0)
+        {
+            LE_FATAL_IF(EINTR != errno, "write failed: %m");
+            continue;
+        }
+        done += written;
+    }
+    close(fd);
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a pipe and start the download of the image to it.
+ *
+ * @return The read end of the pipe.
+ */
+//--------------------------------------------------------------------------------------------------
+static int StartDownload
+(
+    void
+)
+{
+    int fds[2];
+
+    LE_FATAL_IF(-1 == pipe(fds), "pipe failed: %m");
+    StartTime = le_clk_GetRelativeTime();
+
+    le_thread_Ref_t threadRef = le_thread_Create("Download", Download, (void*)(intptr_t)fds[1]);
+    le_thread_Start(threadRef);
+    return fds[0];
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open the partition for writing.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_flash_PartitionRef_t OpenPartition
+(
+    uint32_t* blockSizePtr  ///< [OUT] Size of a block
+)
+{
+    le_flash_PartitionRef_t partitionRef;
+    uint32_t badBlocks;
+    uint32_t blocks;
+    uint32_t pageSize;
+
+    LE_ASSERT_OK(le_flash_OpenMtd(PARTITION_NAME, LE_FLASH_READ_WRITE, &partitionRef));
+    LE_ASSERT_OK(le_flash_GetBlockInformation(partitionRef, &badBlocks, &blocks, blockSizePtr,
+                                              &pageSize));
+    return partitionRef;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the image written in the partition and erase the partition for the next run.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckPartition
+(
+    le_flash_PartitionRef_t partitionRef    ///< [IN] Partition
+)
+{
+    static uint8_t data[ERASE_BLOCK_SIZE];
+    uint32_t blockIndex;
+    size_t done;
+
+    for (blockIndex = 0, done = 0; done < ImageSize; blockIndex++, done += sizeof(data))
+    {
+        size_t size = sizeof(data);
+        size_t compareSize = ImageSize - done;
+
+        if (compareSize > size)
+        {
+            compareSize = size;
+        }
+        LE_ASSERT_OK(le_flash_Read(partitionRef, blockIndex, data, &size));
+        LE_FATAL_IF(memcmp(data, ImagePtr + done, compareSize), "Block %u differs", blockIndex);
+        LE_ASSERT_OK(le_flash_EraseBlock(partitionRef, blockIndex));
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print the throughput of a run.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrintRun
+(
+    const char* namePtr,    ///< [IN] Name of the run
+    double      seconds     ///< [IN] Duration of the run
+)
+{
+    printf("%-8s %8.3f s %8.2f MB/s\n", namePtr, seconds, ImageSize / seconds / (1024 * 1024));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the image with a loop of le_flash_Write() and le_flash_Read() calls.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunLoop
+(
+    void
+)
+{
+    static uint8_t block[ERASE_BLOCK_SIZE];
+    static uint8_t verify[ERASE_BLOCK_SIZE];
+    uint32_t blockSize;
+    le_flash_PartitionRef_t partitionRef = OpenPartition(&blockSize);
+    int fd = StartDownload();
+    uint32_t blockIndex = 0;
+    bool isEnd = false;
+
+    while (!isEnd)
+    {
+        size_t size = 0;
+
+        while (size < blockSize)
+        {
+            ssize_t readSize = read(fd, block + size, blockSize - size);
+
+            if (0 == readSize)
+            {
+                isEnd = true;
+                break;
+            }
+            LE_FATAL_IF((readSize < 0) && (EINTR != errno), "read failed: %m");
+            size += (readSize > 0 ? readSize : 0);
+        }
+        if (0 == size)
+        {
+            break;
+        }
+
+        size_t verifySize = size;
+
+        LE_ASSERT_OK(le_flash_Write(partitionRef, blockIndex, block, size));
+        LE_ASSERT_OK(le_flash_Read(partitionRef, blockIndex, verify, &verifySize));
+        LE_FATAL_IF(memcmp(block, verify, size), "Verify of block %u failed", blockIndex);
+        blockIndex++;
+    }
+    close(fd);
+    PrintRun("loop", Elapsed());
+
+    CheckPartition(partitionRef);
+    LE_ASSERT_OK(le_flash_Close(partitionRef));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Called with the progress of the stream: check the image and exit once it is over.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StreamProgress
+(
+    le_flash_PartitionRef_t partitionRef,   ///< [IN] Partition
+    uint32_t                blockCount,     ///< [IN] Blocks written
+    bool                    isComplete,     ///< [IN] True once the stream is over
+    le_result_t             result,         ///< [IN] Result of the stream
+    void*                   contextPtr      ///< [IN] Context
+)
+{
+    if (!isComplete)
+    {
+        return;
+    }
+
+    PrintRun("stream", Elapsed());
+    LE_FATAL_IF(LE_OK != result, "Stream failed: %s", LE_RESULT_TXT(result));
+
+    CheckPartition(partitionRef);
+    LE_ASSERT_OK(le_flash_Close(partitionRef));
+    exit(EXIT_SUCCESS);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the image with le_flash_WriteStream().
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunStream
+(
+    void
+)
+{
+    uint32_t blockSize;
+    le_flash_PartitionRef_t partitionRef = OpenPartition(&blockSize);
+
+    LE_ASSERT(le_flash_AddWriteStreamProgressHandler(StreamProgress, NULL));
+    LE_ASSERT_OK(le_flash_WriteStream(partitionRef, 0, StartDownload()));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create the partition table and the image.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Setup
+(
+    void
+)
+{
+    FILE* filePtr;
+    size_t i;
+
+    LE_FATAL_IF((-1 == mkdir(PA_FLASH_DIR, S_IRWXU)) && (EEXIST != errno),
+                "mkdir failed: %m");
+    unlink(PA_FLASH_DIR "/mtd0.bin");
+    filePtr = fopen(PA_FLASH_DIR "/mtd", "w");
+    LE_FATAL_IF(NULL == filePtr, "fopen failed: %m");
+    fprintf(filePtr, "dev:    size   erasesize  name\n");
+    fprintf(filePtr, "mtd0: %08x %08x \"" PARTITION_NAME "\"\n", PARTITION_SIZE, ERASE_BLOCK_SIZE);
+    fclose(filePtr);
+
+    ImagePtr = malloc(ImageSize);
+    LE_ASSERT(ImagePtr);
+    srand(1);
+    for (i = 0; i < ImageSize; i++)
+    {
+        ImagePtr[i] = rand();
+    }
+}
+
+COMPONENT_INIT
+{
+    if (le_arg_NumArgs() >= 1)
+    {
+        RateKbps = atoi(le_arg_GetArg(0));
+    }
+    ImageSize = DEFAULT_IMAGE_KB * 1024;
+    if (le_arg_NumArgs() >= 2)
+    {
+        ImageSize = atoi(le_arg_GetArg(1)) * 1024;
+    }
+    LE_ASSERT((ImageSize > 0) && (ImageSize <= PARTITION_SIZE));
+
+    Setup();
+
+    printf("image %zu KB, download rate ", ImageSize / 1024);
+    if (RateKbps)
+    {
+        printf("%u KB/s\n", RateKbps);
+    }
+    else
+    {
+        printf("unlimited\n");
+    }
+
+    RunLoop();
+    RunStream();
+}
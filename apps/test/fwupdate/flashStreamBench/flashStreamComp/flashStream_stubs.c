@@ -0,0 +1,161 @@
+/**
+ * @file flashStream_stubs.c
+ *
+ * Stub functions required to run the flash service in the flash stream benchmark.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "pa_fwupdate.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * MTD partition table: empty, all the partitions are "customer partitions" opened by their name.
+ */
+//--------------------------------------------------------------------------------------------------
+static pa_fwupdate_MtdPartition_t MtdPartTab[] =
+{
+    { NULL, { NULL, NULL }, 0, false },
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the client session reference for the current message
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_SessionRef_t le_flash_GetClientSessionRef
+(
+    void
+)
+{
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the server service reference
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_ServiceRef_t le_flash_GetServiceRef
+(
+    void
+)
+{
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the handler callback function to be called when the session is closed from the other
+ * end.  A local termination of the session will not trigger this callback.
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_SessionEventHandlerRef_t le_msg_AddServiceCloseHandler
+(
+    le_msg_ServiceRef_t             serviceRef, ///< [in] Reference to the service.
+    le_msg_SessionEventHandler_t    handlerFunc,///< [in] Handler function.
+    void*                           contextPtr  ///< [in] Opaque pointer value to pass to handler.
+)
+{
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current "system" in use.
+ *
+ * @return
+ *      - LE_OK            On success
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_dualsys_GetCurrentSystem
+(
+    le_dualsys_System_t* systemMaskPtr ///< [OUT] Sub-system bitmask for "modem/lk/linux" partitions
+)
+{
+    *systemMaskPtr = 0;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the MTD partition table
+ *
+ * @return
+ *      - LE_OK            on success
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_fwupdate_GetMtdPartitionTab
+(
+    pa_fwupdate_MtdPartition_t **mtdPartPtr
+)
+{
+    *mtdPartPtr = MtdPartTab;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Request the flash access for a SW update
+ *
+ * @return
+ *      - LE_OK            on success
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_fwupdate_RequestUpdate
+(
+    void
+)
+{
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the flash access after a SW update
+ *
+ * @return
+ *      - LE_OK           on success
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_fwupdate_CompleteUpdate
+(
+    void
+)
+{
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start the bad image indication
+ *
+ * @return
+ *      - LE_OK             on success
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_fwupdate_StartBadImageIndication
+(
+    le_event_Id_t eventId       ///< the event Id to use to report the bad image
+)
+{
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop the bad image indication
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_fwupdate_StopBadImageIndication
+(
+    void
+)
+{
+}
+
+COMPONENT_INIT
+{
+}
@@ -0,0 +1,242 @@
+/**
+ * Benchmark of the SMS PDU encoder and decoder.
+ *
+ * A corpus of GSM 7-bit and UCS-2 texts of random lengths is encoded in SMS SUBMIT PDUs, and a
+ * corpus of SMS DELIVER PDUs carrying the same texts is decoded, a number of rounds each.  The
+ * throughput is printed in messages per second and in MB/s of text.
+ *
+ * Usage: smsPduBench [ROUNDS]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "pa_sms.h"
+#include "smsPdu.h"
+
+#define DEFAULT_ROUNDS      200
+#define CORPUS_SIZE         256
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header of the SMS DELIVER PDUs of the corpus, up to the user data length: SMSC information,
+ * originating address, protocol identifier, data coding scheme (to be set) and time stamp.
+ */
+//--------------------------------------------------------------------------------------------------
+static const uint8_t DeliverHeader[] =
+{
+    0x07, 0x91, 0x33, 0x86, 0x09, 0x40, 0x00, 0xF0, 0x04, 0x0B,
+    0x91, 0x33, 0x46, 0x53, 0x73, 0x19, 0xF9, 0x00, 0x00, 0x41,
+    0x70, 0x13, 0x02, 0x55, 0x71, 0x80,
+};
+
+#define DELIVER_DCS_OFFSET  18
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Message of the corpus: text to encode, and SMS DELIVER PDU carrying it.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint8_t text[LE_SMS_TEXT_MAX_LEN];      ///< Text, or UCS-2 data
+    size_t  textLen;                        ///< Length of the text, in bytes
+    uint8_t pdu[LE_SMS_PDU_MAX_BYTES];      ///< SMS DELIVER PDU
+    size_t  pduLen;                         ///< Length of the PDU, in bytes
+}
+Message_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Corpus of messages, for each encoding.
+ */
+//--------------------------------------------------------------------------------------------------
+static Message_t Gsm7Corpus[CORPUS_SIZE];
+static Message_t Ucs2Corpus[CORPUS_SIZE];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of times each corpus is encoded and decoded.
+ */
+//--------------------------------------------------------------------------------------------------
+static int Rounds;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Seconds of the monotonic clock.
+ */
+//--------------------------------------------------------------------------------------------------
+static double Seconds
+(
+    void
+)
+{
+    struct timespec time;
+
+    LE_ASSERT(0 == clock_gettime(CLOCK_MONOTONIC, &time));
+    return time.tv_sec + (time.tv_nsec / 1e9);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fill a corpus with texts of random lengths, mostly full messages, and build their SMS DELIVER
+ * PDUs with the encoder.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FillCorpus
+(
+    Message_t*        corpusPtr,    ///< [OUT] Corpus
+    smsPdu_Encoding_t encoding      ///< [IN] Encoding of the texts
+)
+{
+    static const char gsm7Chars[] = "abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                    "0123456789 .,:;!?'\"()+-*/=@ \n\r";
+    size_t maxLen = (SMSPDU_7_BITS == encoding) ? LE_SMS_TEXT_MAX_LEN : LE_SMS_UCS2_MAX_BYTES;
+    int i;
+
+    for (i = 0; i < CORPUS_SIZE; i++)
+    {
+        Message_t* msgPtr = &corpusPtr[i];
+        smsPdu_DataToEncode_t data;
+        pa_sms_Pdu_t pdu;
+        size_t userDataLen;
+        size_t j;
+
+        msgPtr->textLen = (rand() % 4) ? maxLen : 2 + (rand() % (maxLen - 1));
+        if (SMSPDU_7_BITS == encoding)
+        {
+            for (j = 0; j < msgPtr->textLen; j++)
+            {
+                msgPtr->text[j] = gsm7Chars[rand() % (sizeof(gsm7Chars) - 1)];
+            }
+            userDataLen = msgPtr->textLen;
+
+            // Some texts start with a character of the extension table, escaped in the PDU
+            if (0 == (i % 8))
+            {
+                msgPtr->text[0] = '[';
+                msgPtr->textLen--;
+            }
+            userDataLen = ((userDataLen * 7) + 7) / 8;
+        }
+        else
+        {
+            msgPtr->textLen &= ~(size_t)1;
+            for (j = 0; j < msgPtr->textLen; j += 2)
+            {
+                msgPtr->text[j] = 0x04;
+                msgPtr->text[j + 1] = 0x10 + (rand() % 0x40);
+            }
+            userDataLen = msgPtr->textLen;
+        }
+
+        memset(&data, 0, sizeof(data));
+        data.protocol = PA_SMS_PROTOCOL_GSM;
+        data.messagePtr = msgPtr->text;
+        data.length = msgPtr->textLen;
+        data.addressPtr = "+33661651866";
+        data.encoding = encoding;
+        data.messageType = PA_SMS_SUBMIT;
+        LE_ASSERT_OK(smsPdu_Encode(&data, &pdu));
+
+        // The user data length and the user data end the SMS SUBMIT PDU
+        memcpy(msgPtr->pdu, DeliverHeader, sizeof(DeliverHeader));
+        msgPtr->pdu[DELIVER_DCS_OFFSET] = (SMSPDU_7_BITS == encoding) ? 0x00 : 0x08;
+        memcpy(&msgPtr->pdu[sizeof(DeliverHeader)], &pdu.data[pdu.dataLen - userDataLen - 1],
+               userDataLen + 1);
+        msgPtr->pduLen = sizeof(DeliverHeader) + userDataLen + 1;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode the texts of a corpus, decode its PDUs, check the decoded texts and print the throughput.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunCorpus
+(
+    const char*       namePtr,      ///< [IN] Name of the corpus
+    const Message_t*  corpusPtr,    ///< [IN] Corpus
+    smsPdu_Encoding_t encoding      ///< [IN] Encoding of the texts
+)
+{
+    static pa_sms_Message_t message;
+    static pa_sms_Pdu_t pdu;
+    smsPdu_DataToEncode_t data;
+    size_t textBytes = 0;
+    double startTime;
+    double seconds;
+    int round;
+    int i;
+
+    for (i = 0; i < CORPUS_SIZE; i++)
+    {
+        textBytes += corpusPtr[i].textLen;
+    }
+
+    memset(&data, 0, sizeof(data));
+    data.protocol = PA_SMS_PROTOCOL_GSM;
+    data.addressPtr = "+33661651866";
+    data.encoding = encoding;
+    data.messageType = PA_SMS_SUBMIT;
+
+    startTime = Seconds();
+    for (round = 0; round < Rounds; round++)
+    {
+        for (i = 0; i < CORPUS_SIZE; i++)
+        {
+            data.messagePtr = corpusPtr[i].text;
+            data.length = corpusPtr[i].textLen;
+            LE_ASSERT_OK(smsPdu_Encode(&data, &pdu));
+        }
+    }
+    seconds = Seconds() - startTime;
+    printf("%-12s encode %10.0f msg/s %8.2f MB/s\n", namePtr, (CORPUS_SIZE * Rounds) / seconds,
+           (textBytes * Rounds) / (seconds * 1024 * 1024));
+
+    startTime = Seconds();
+    for (round = 0; round < Rounds; round++)
+    {
+        for (i = 0; i < CORPUS_SIZE; i++)
+        {
+            LE_ASSERT_OK(smsPdu_Decode(PA_SMS_PROTOCOL_GSM, corpusPtr[i].pdu, corpusPtr[i].pduLen,
+                                       true, &message));
+        }
+    }
+    seconds = Seconds() - startTime;
+    printf("%-12s decode %10.0f msg/s %8.2f MB/s\n", namePtr, (CORPUS_SIZE * Rounds) / seconds,
+           (textBytes * Rounds) / (seconds * 1024 * 1024));
+
+    for (i = 0; i < CORPUS_SIZE; i++)
+    {
+        LE_ASSERT_OK(smsPdu_Decode(PA_SMS_PROTOCOL_GSM, corpusPtr[i].pdu, corpusPtr[i].pduLen,
+                                   true, &message));
+        LE_ASSERT(PA_SMS_DELIVER == message.type);
+        LE_ASSERT(message.smsDeliver.dataLen == corpusPtr[i].textLen);
+        LE_ASSERT(0 == memcmp(message.smsDeliver.data, corpusPtr[i].text,
+                              corpusPtr[i].textLen));
+    }
+}
+
+COMPONENT_INIT
+{
+    Rounds = DEFAULT_ROUNDS;
+    if (le_arg_NumArgs() >= 1)
+    {
+        Rounds = atoi(le_arg_GetArg(0));
+    }
+    LE_ASSERT(Rounds > 0);
+
+    LE_ASSERT_OK(smsPdu_Initialize());
+
+    srand(42);
+    FillCorpus(Gsm7Corpus, SMSPDU_7_BITS);
+    FillCorpus(Ucs2Corpus, SMSPDU_UCS2_16_BITS);
+
+    printf("%d messages, %d rounds\n", CORPUS_SIZE, Rounds);
+    RunCorpus("GSM 7-bit", Gsm7Corpus, SMSPDU_7_BITS);
+    RunCorpus("UCS-2", Ucs2Corpus, SMSPDU_UCS2_16_BITS);
+
+    exit(EXIT_SUCCESS);
+}
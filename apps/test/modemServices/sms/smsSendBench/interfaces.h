@@ -0,0 +1,55 @@
+/**
+ * Interfaces of the SMS send queue benchmark, which links the SMS service with a simulated modem.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "le_mrc_interface.h"
+#include "le_sms_interface.h"
+#include "le_sim_interface.h"
+#include "le_cfg_interface.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the client session reference for the current message
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_SessionRef_t le_sms_GetClientSessionRef
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the server service reference
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_ServiceRef_t le_sms_GetServiceRef
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Registers a function to be called whenever one of this service's sessions is closed by
+ * the client.  (STUBBED FUNCTION)
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_SessionEventHandlerRef_t MyAddServiceCloseHandler
+(
+    le_msg_ServiceRef_t             serviceRef, ///< [in] Reference to the service.
+    le_msg_SessionEventHandler_t    handlerFunc,///< [in] Handler function.
+    void*                           contextPtr  ///< [in] Opaque pointer value to pass to handler.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the time the simulated modem takes to send a message, and the number of messages the SMS
+ * service sends to it at the same time.
+ */
+//--------------------------------------------------------------------------------------------------
+void simuModem_Configure
+(
+    uint32_t sendLatencyMs, ///< [IN] Time to send a message, in milliseconds.
+    int32_t  sendInFlight   ///< [IN] Number of messages sent at the same time.
+);
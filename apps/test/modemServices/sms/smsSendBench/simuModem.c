@@ -0,0 +1,545 @@
+/**
+ * Simulated modem for the SMS send queue benchmark: the platform adaptor functions used by the SMS
+ * service, and the services it requires.
+ *
+ * Sending a message takes a fixed time, as the round trip of a submission to a modem would.  The
+ * other functions do nothing.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "pa_sms.h"
+#include "pa_sim.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Time to send a message, in milliseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t SendLatencyMs;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of sender threads of the SMS service, read from the configuration tree.
+ */
+//--------------------------------------------------------------------------------------------------
+static int32_t SendInFlight = 1;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the time the simulated modem takes to send a message, and the number of sender threads of the
+ * SMS service.
+ */
+//--------------------------------------------------------------------------------------------------
+void simuModem_Configure
+(
+    uint32_t sendLatencyMs, ///< [IN] Time to send a message, in milliseconds.
+    int32_t  sendInFlight   ///< [IN] Number of sender threads.
+)
+{
+    SendLatencyMs = sendLatencyMs;
+    SendInFlight = sendInFlight;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a message in PDU mode: wait for the simulated round trip to the network.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_SendPduMsg
+(
+    pa_sms_Protocol_t        protocol,
+    uint32_t                 length,
+    const uint8_t*           dataPtr,
+    uint8_t*                 msgRef,
+    uint32_t                 timeout,
+    pa_sms_SendingErrCode_t* errorCode
+)
+{
+    static uint8_t reference;
+
+    LE_ASSERT((length > 0) && dataPtr);
+    usleep(SendLatencyMs * 1000);
+    *msgRef = __sync_fetch_and_add(&reference, 1);
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Activate Cell Broadcast message notification stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_ActivateCellBroadcast
+(
+    pa_sms_Protocol_t protocol
+)
+{
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add CDMA Cell Broadcast category services stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_AddCdmaCellBroadcastServices
+(
+    le_sms_CdmaServiceCat_t serviceCat,
+    le_sms_Languages_t      language
+)
+{
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add Cell Broadcast message Identifiers range stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_AddCellBroadcastIds
+(
+    uint16_t fromId,
+    uint16_t toId
+)
+{
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a storage status notification handler stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_event_HandlerRef_t pa_sms_AddStorageStatusHandler
+(
+    pa_sms_StorageMsgHdlrFunc_t statusHandler
+)
+{
+    static int handler;
+
+    return (le_event_HandlerRef_t)&handler;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Change the message status stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_ChangeMessageStatus
+(
+    uint32_t          index,
+    pa_sms_Protocol_t protocol,
+    le_sms_Status_t   status,
+    pa_sms_Storage_t  storage
+)
+{
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Clear CDMA Cell Broadcast category services stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_ClearCdmaCellBroadcastServices
+(
+    void
+)
+{
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Clear Cell Broadcast message Identifiers range stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_ClearCellBroadcastIds
+(
+    void
+)
+{
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Deactivate Cell Broadcast message notification stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_DeactivateCellBroadcast
+(
+    pa_sms_Protocol_t protocol
+)
+{
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete one specific Message from preferred message storage stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_DelMsgFromMem
+(
+    uint32_t          index,
+    pa_sms_Protocol_t protocol,
+    pa_sms_Storage_t  storage
+)
+{
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the preferred SMS storage area stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_GetPreferredStorage
+(
+    le_sms_Storage_t* prefStoragePtr
+)
+{
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the SMS center stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_GetSmsc
+(
+    char*  smscPtr,
+    size_t len
+)
+{
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the indexes of messages stored in the preferred memory stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_ListMsgFromMem
+(
+    le_sms_Status_t   status,
+    pa_sms_Protocol_t protocol,
+    uint32_t*         numPtr,
+    uint32_t*         idxPtr,
+    pa_sms_Storage_t  storage
+)
+{
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the message from the preferred message storage stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_RdPDUMsgFromMem
+(
+    uint32_t          index,
+    pa_sms_Protocol_t protocol,
+    pa_sms_Storage_t  storage,
+    pa_sms_Pdu_t*     msgPtr
+)
+{
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove CDMA Cell Broadcast category services stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_RemoveCdmaCellBroadcastServices
+(
+    le_sms_CdmaServiceCat_t serviceCat,
+    le_sms_Languages_t      language
+)
+{
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove Cell Broadcast message Identifiers range stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_RemoveCellBroadcastIds
+(
+    uint16_t fromId,
+    uint16_t toId
+)
+{
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Register a handler for a new message reception handling stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_SetNewMsgHandler
+(
+    pa_sms_NewMsgHdlrFunc_t msgHandler
+)
+{
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the preferred SMS storage area stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_SetPreferredStorage
+(
+    le_sms_Storage_t prefStorage
+)
+{
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the SMS center stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_SetSmsc
+(
+    const char* smscPtr
+)
+{
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the SIM Status stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sim_GetState
+(
+    le_sim_States_t* statePtr
+)
+{
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the Home Network MCC MNC stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sim_GetHomeNetworkMccMnc
+(
+    char*  mccPtr,
+    size_t mccPtrSize,
+    char*  mncPtr,
+    size_t mncPtrSize
+)
+{
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current Radio Access Technology stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_mrc_GetRadioAccessTechInUse
+(
+    le_mrc_Rat_t* ratPtr
+)
+{
+    *ratPtr = LE_MRC_RAT_GSM;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the client session reference for the current message stub: the benchmark is the only
+ * client.
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_SessionRef_t le_sms_GetClientSessionRef
+(
+    void
+)
+{
+    static int session;
+
+    return (le_msg_SessionRef_t)&session;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the server service reference stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_ServiceRef_t le_sms_GetServiceRef
+(
+    void
+)
+{
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Register a function to be called whenever one of this service's sessions is closed stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_SessionEventHandlerRef_t MyAddServiceCloseHandler
+(
+    le_msg_ServiceRef_t          serviceRef,
+    le_msg_SessionEventHandler_t handlerFunc,
+    void*                        contextPtr
+)
+{
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Begin monitoring the event loop on the current thread stub.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_wdogChain_MonitorEventLoop
+(
+    uint32_t      watchdog,
+    le_clk_Time_t watchdogInterval
+)
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Connect the current client thread to the config tree stub.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_cfg_ConnectService
+(
+    void
+)
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a read transaction stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_cfg_IteratorRef_t le_cfg_CreateReadTxn
+(
+    const char* basePath
+)
+{
+    return (le_cfg_IteratorRef_t)1;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a write transaction stub.
+ */
+//--------------------------------------------------------------------------------------------------
+le_cfg_IteratorRef_t le_cfg_CreateWriteTxn
+(
+    const char* basePath
+)
+{
+    return (le_cfg_IteratorRef_t)1;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Commit a write transaction stub.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_cfg_CommitTxn
+(
+    le_cfg_IteratorRef_t iteratorRef
+)
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cancel a transaction stub.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_cfg_CancelTxn
+(
+    le_cfg_IteratorRef_t iteratorRef
+)
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a signed integer value from the config tree stub: only the number of messages in flight
+ * is set.
+ */
+//--------------------------------------------------------------------------------------------------
+int32_t le_cfg_GetInt
+(
+    le_cfg_IteratorRef_t iteratorRef,
+    const char*          path,
+    int32_t              defaultValue
+)
+{
+    if (0 == strcmp(path, "sendInFlight"))
+    {
+        return SendInFlight;
+    }
+    return defaultValue;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a signed integer value to the config tree stub.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_cfg_SetInt
+(
+    le_cfg_IteratorRef_t iteratorRef,
+    const char*          path,
+    int32_t              value
+)
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a value from the config tree as a boolean stub.
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cfg_GetBool
+(
+    le_cfg_IteratorRef_t iteratorRef,
+    const char*          path,
+    bool                 defaultValue
+)
+{
+    return defaultValue;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a boolean value to the config tree stub.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_cfg_SetBool
+(
+    le_cfg_IteratorRef_t iteratorRef,
+    const char*          path,
+    bool                 value
+)
+{
+}
@@ -0,0 +1,150 @@
+/**
+ * Benchmark of the SMS send queue.
+ *
+ * The SMS service is linked with a simulated modem which takes a fixed time to send each message.
+ * A number of text messages are sent asynchronously, in batches, and the throughput is printed in
+ * messages per minute, with the statistics of the send queue.  It depends on the number of sender
+ * threads of the service, given in the configuration tree.
+ *
+ * Usage: smsSendBench [IN_FLIGHT [COUNT [LATENCY_MS]]]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "le_sms_local.h"
+
+#define DEFAULT_IN_FLIGHT   1
+#define DEFAULT_COUNT       128
+#define DEFAULT_LATENCY_MS  20
+
+#define DEST_NUMBER         "+33606060606"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of messages to send, and number of messages which sending is complete.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t Count;
+static uint32_t SentCount;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of batches which sending is not complete.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t RemainingBatches;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Time the first message was queued.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_clk_Time_t StartTime;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print the throughput and the statistics of the send queue, and exit.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrintResults
+(
+    void
+)
+{
+    le_clk_Time_t time = le_clk_Sub(le_clk_GetRelativeTime(), StartTime);
+    double seconds = time.sec + (time.usec / 1e6);
+    uint32_t queueDepth;
+    uint32_t inFlight;
+    uint32_t maxInFlight;
+    uint32_t sentCount;
+    uint32_t averageLatency;
+    uint32_t maxLatency;
+
+    le_sms_GetSendQueueStats(&queueDepth, &inFlight, &maxInFlight, &sentCount, &averageLatency,
+                             &maxLatency);
+    LE_ASSERT((0 == queueDepth) && (0 == inFlight) && (Count == sentCount));
+
+    printf("%u messages, %u in flight: %8.0f msg/min, latency %u ms average, %u ms max\n",
+           Count, maxInFlight, (Count * 60) / seconds, averageLatency, maxLatency);
+
+    exit(EXIT_SUCCESS);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler for the sending result of a batch.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BatchHandler
+(
+    le_sms_MsgRef_t msgRef,     ///< [IN] Last message of the batch, or first message not sent.
+    le_sms_Status_t status,     ///< [IN] Status of this message.
+    void*           contextPtr  ///< [IN] Number of messages of the batch.
+)
+{
+    LE_ASSERT(LE_SMS_SENT == status);
+    LE_ASSERT(LE_SMS_SENT == le_sms_GetStatus(msgRef));
+
+    SentCount += (uint32_t)(uintptr_t)contextPtr;
+    RemainingBatches--;
+    if (0 == RemainingBatches)
+    {
+        LE_ASSERT(SentCount == Count);
+        PrintResults();
+    }
+}
+
+COMPONENT_INIT
+{
+    le_sms_MsgRef_t msgRefs[LE_SMS_MAX_BATCH_SIZE];
+    char text[LE_SMS_TEXT_MAX_BYTES];
+    int32_t inFlight = DEFAULT_IN_FLIGHT;
+    uint32_t latencyMs = DEFAULT_LATENCY_MS;
+    uint32_t i;
+
+    Count = DEFAULT_COUNT;
+    if (le_arg_NumArgs() >= 1)
+    {
+        inFlight = atoi(le_arg_GetArg(0));
+    }
+    if (le_arg_NumArgs() >= 2)
+    {
+        Count = atoi(le_arg_GetArg(1));
+    }
+    if (le_arg_NumArgs() >= 3)
+    {
+        latencyMs = atoi(le_arg_GetArg(2));
+    }
+    LE_ASSERT(Count > 0);
+
+    simuModem_Configure(latencyMs, inFlight);
+    LE_ASSERT_OK(le_sms_Init());
+
+    memset(text, 'x', LE_SMS_TEXT_MAX_LEN);
+    text[LE_SMS_TEXT_MAX_LEN] = '\0';
+
+    StartTime = le_clk_GetRelativeTime();
+    for (i = 0; i < Count; i += LE_SMS_MAX_BATCH_SIZE)
+    {
+        size_t batchSize = Count - i;
+        size_t j;
+
+        if (batchSize > LE_SMS_MAX_BATCH_SIZE)
+        {
+            batchSize = LE_SMS_MAX_BATCH_SIZE;
+        }
+
+        for (j = 0; j < batchSize; j++)
+        {
+            msgRefs[j] = le_sms_Create();
+            LE_ASSERT_OK(le_sms_SetDestination(msgRefs[j], DEST_NUMBER));
+            LE_ASSERT_OK(le_sms_SetText(msgRefs[j], text));
+        }
+
+        LE_ASSERT_OK(le_sms_SendBatchAsync(msgRefs, batchSize, BatchHandler,
+                                           (void*)(uintptr_t)batchSize));
+        RemainingBatches++;
+    }
+}
@@ -234,6 +234,10 @@ int32_t le_cfg_GetInt
     {
         value = RxCbMessageCount;
     }
+    else if (0 == strncmp(path, CFG_NODE_SEND_IN_FLIGHT, strlen(CFG_NODE_SEND_IN_FLIGHT)))
+    {
+        value = defaultValue;
+    }
     else
     {
         value = defaultValue;
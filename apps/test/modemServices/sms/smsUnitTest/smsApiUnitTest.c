@@ -1024,6 +1024,150 @@ static void Testle_sms_Send
     LE_ASSERT(le_sem_GetValue(SmsSendSemaphore) == 0);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * CallbackSendBatchTestHandler: this function checks the sending result of a batch
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void CallbackSendBatchTestHandler
+(
+    le_sms_MsgRef_t msgRef,
+    le_sms_Status_t status,
+    void* contextPtr
+)
+{
+    LE_INFO("Batch message %p, status %d", msgRef, status);
+
+    // The context is the message expected to be reported
+    LE_ASSERT(contextPtr == msgRef);
+    LE_ASSERT(status == le_sms_GetStatus(msgRef));
+
+    // Semaphore is used to synchronize the execution of SMS send
+    le_sem_Post(SmsSendSemaphore);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create the messages of a batch
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void CreateBatch
+(
+    le_sms_MsgRef_t* msgRefsPtr,
+    size_t msgRefsSize
+)
+{
+    size_t i;
+
+    for (i = 0; i < msgRefsSize; i++)
+    {
+        msgRefsPtr[i] = le_sms_Create();
+        LE_ASSERT(msgRefsPtr[i]);
+        LE_ASSERT_OK(le_sms_SetDestination(msgRefsPtr[i], DEST_TEST_PATTERN));
+        LE_ASSERT_OK(le_sms_SetText(msgRefsPtr[i], TEXT_TEST_PATTERN));
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Testle_sms_SendBatch: this function handles the sending of batches of SMS
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void Testle_sms_SendBatch
+(
+    void
+)
+{
+    le_sms_MsgRef_t msgRefs[3];
+    le_sms_MsgRef_t emptyMsg;
+    uint32_t queueDepth;
+    uint32_t inFlight;
+    uint32_t maxInFlight;
+    uint32_t sentCount;
+    uint32_t previousSentCount;
+    uint32_t averageLatency;
+    uint32_t maxLatency;
+    size_t i;
+
+    pa_sms_SetSmsErrCause(LE_OK);
+    CreateBatch(msgRefs, NUM_ARRAY_MEMBERS(msgRefs));
+
+    // Invalid batches
+    LE_ASSERT(le_sms_SendBatchAsync(msgRefs, 0, CallbackSendBatchTestHandler, NULL) == LE_FAULT);
+    emptyMsg = le_sms_Create();
+    LE_ASSERT(emptyMsg);
+    msgRefs[1] = emptyMsg;
+    LE_ASSERT(le_sms_SendBatchAsync(msgRefs, 2, CallbackSendBatchTestHandler, NULL)
+              == LE_FORMAT_ERROR);
+    msgRefs[1] = msgRefs[0];
+    LE_ASSERT(le_sms_SendBatchAsync(msgRefs, 2, CallbackSendBatchTestHandler, NULL) == LE_FAULT);
+    LE_ASSERT(le_sms_GetStatus(msgRefs[0]) == LE_SMS_UNSENT);
+    le_sms_Delete(emptyMsg);
+    CreateBatch(&msgRefs[1], 1);
+
+    le_sms_GetSendQueueStats(&queueDepth, &inFlight, &maxInFlight, &previousSentCount,
+                             &averageLatency, &maxLatency);
+
+    // The last message is reported once all the messages of the batch are sent
+    LE_ASSERT_OK(le_sms_SendBatchAsync(msgRefs, NUM_ARRAY_MEMBERS(msgRefs),
+                                       CallbackSendBatchTestHandler, msgRefs[2]));
+    // send again
+    LE_ASSERT(le_sms_SendBatchAsync(msgRefs, 1, CallbackSendBatchTestHandler, NULL) == LE_FAULT);
+    WaitForSem(SmsSendSemaphore, LONG_TIMEOUT, LE_OK);
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(msgRefs); i++)
+    {
+        LE_ASSERT(le_sms_GetStatus(msgRefs[i]) == LE_SMS_SENT);
+        le_sms_Delete(msgRefs[i]);
+    }
+
+    le_sms_GetSendQueueStats(&queueDepth, &inFlight, &maxInFlight, &sentCount, &averageLatency,
+                             &maxLatency);
+    LE_ASSERT(0 == queueDepth);
+    LE_ASSERT(0 == inFlight);
+    LE_ASSERT(maxInFlight >= 1);
+    LE_ASSERT(sentCount == previousSentCount + NUM_ARRAY_MEMBERS(msgRefs));
+    LE_ASSERT(maxLatency >= averageLatency);
+
+    // The first message which could not be sent is reported, and the rest of the batch is not
+    // sent (messages are sent one at a time)
+    pa_sms_SetSmsErrCause(LE_TIMEOUT);
+    CreateBatch(msgRefs, NUM_ARRAY_MEMBERS(msgRefs));
+    LE_ASSERT_OK(le_sms_SendBatchAsync(msgRefs, NUM_ARRAY_MEMBERS(msgRefs),
+                                       CallbackSendBatchTestHandler, msgRefs[0]));
+    WaitForSem(SmsSendSemaphore, LONG_TIMEOUT, LE_OK);
+
+    LE_ASSERT(le_sms_GetStatus(msgRefs[0]) == LE_SMS_SENDING_TIMEOUT);
+    for (i = 1; i < NUM_ARRAY_MEMBERS(msgRefs); i++)
+    {
+        LE_ASSERT(le_sms_GetStatus(msgRefs[i]) == LE_SMS_UNSENT);
+    }
+    le_sms_Delete(msgRefs[0]);
+    pa_sms_SetSmsErrCause(LE_OK);
+
+    // The messages not sent can be sent again
+    LE_ASSERT_OK(le_sms_SendBatchAsync(&msgRefs[1], NUM_ARRAY_MEMBERS(msgRefs) - 1,
+                                       CallbackSendBatchTestHandler, msgRefs[2]));
+    WaitForSem(SmsSendSemaphore, LONG_TIMEOUT, LE_OK);
+
+    for (i = 1; i < NUM_ARRAY_MEMBERS(msgRefs); i++)
+    {
+        LE_ASSERT(le_sms_GetStatus(msgRefs[i]) == LE_SMS_SENT);
+        le_sms_Delete(msgRefs[i]);
+    }
+
+    le_sms_GetSendQueueStats(&queueDepth, &inFlight, &maxInFlight, &sentCount, &averageLatency,
+                             &maxLatency);
+    LE_ASSERT(0 == queueDepth);
+    LE_ASSERT(0 == inFlight);
+
+    // Check that no more call of the semaphore
+    LE_ASSERT(le_sem_GetValue(SmsSendSemaphore) == 0);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Test task: this function handles the task and run an eventLoop
@@ -1399,6 +1543,9 @@ void testle_sms_SmsApiUnitTest
     LE_INFO("Test Testle_sms_Send started");
     Testle_sms_Send();
 
+    LE_INFO("Test Testle_sms_SendBatch started");
+    Testle_sms_SendBatch();
+
     LE_INFO("Test Testle_sms_CellBroadcast started");
     Testle_sms_CellBroadcast();
 
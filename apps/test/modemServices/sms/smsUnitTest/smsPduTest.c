@@ -2097,6 +2097,286 @@ static le_result_t TestEncodePdu
     return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of random messages encoded and decoded by the GSM 7 bits differential test.
+ */
+//--------------------------------------------------------------------------------------------------
+#define GSM7_FUZZ_ITERATIONS    1000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header of a SMS-DELIVER PDU in GSM 7 bits, up to the TP-UDL, used to build the PDUs to decode.
+ */
+//--------------------------------------------------------------------------------------------------
+static const uint8_t Gsm7DeliverHeader[] =
+{
+    0x07, 0x91, 0x33, 0x86, 0x09, 0x40, 0x00, 0xF0, 0x04, 0x0B,
+    0x91, 0x33, 0x46, 0x53, 0x73, 0x19, 0xF9, 0x00, 0x00, 0x41,
+    0x70, 0x13, 0x02, 0x55, 0x71, 0x80,
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Conversion tables of smsPdu.c.
+ */
+//--------------------------------------------------------------------------------------------------
+extern const uint8_t Ascii8to7[];
+extern const uint8_t Ascii7to8[];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference GSM 7 bits conversions, one septet at a time, to check the conversions of smsPdu.c
+ * against.
+ */
+//--------------------------------------------------------------------------------------------------
+static unsigned int RefRead7Bits
+(
+    const uint8_t* bufferPtr,
+    uint32_t       pos
+)
+{
+    int a = bufferPtr[pos/8] >> (pos&7);
+    int b = 0;
+
+    if ((pos&7) > 1)
+    {
+        b = bufferPtr[(pos/8)+1] << (8-(pos&7));
+    }
+
+    return (a|b) & 0x7F;
+}
+
+static void RefWrite7Bits
+(
+    uint8_t* bufferPtr,
+    uint8_t  val,
+    uint32_t pos
+)
+{
+    uint32_t idx = pos/8;
+
+    val &= 0x7F;
+    if (!(pos&7))
+    {
+        bufferPtr[idx] = val;
+    }
+    else if ((pos&7) == 1)
+    {
+        bufferPtr[idx] = bufferPtr[idx] | (val<<1);
+    }
+    else
+    {
+        bufferPtr[idx] = bufferPtr[idx] | (val<<(pos&7));
+        bufferPtr[idx+1] = (val>>(8-(pos&7)));
+    }
+}
+
+static int RefConvert8BitsTo7Bits
+(
+    const uint8_t* a8bitPtr,
+    int            length,
+    uint8_t*       a7bitPtr,
+    int*           a7bitsNumberPtr
+)
+{
+    int read;
+    int write = 0;
+
+    for (read = 0; read < length; read++)
+    {
+        uint8_t byte = Ascii8to7[a8bitPtr[read]];
+
+        if (byte >= 128)
+        {
+            RefWrite7Bits(a7bitPtr, 0x1B, write*7);
+            write++;
+            byte -= 128;
+        }
+        RefWrite7Bits(a7bitPtr, byte, write*7);
+        write++;
+    }
+
+    *a7bitsNumberPtr = write;
+    return ((write * 7) + 7) / 8;
+}
+
+static int RefConvert7BitsTo8Bits
+(
+    const uint8_t* a7bitPtr,
+    int            length,
+    uint8_t*       a8bitPtr,
+    size_t         a8bitSize
+)
+{
+    static const struct
+    {
+        uint8_t septet;
+        uint8_t byte;
+    }
+    extension[] =
+    {
+        { 10, 12 }, { 20, '^' }, { 40, '{' }, { 41, '}' }, { 47, '\\' },
+        { 60, '[' }, { 61, '~' }, { 62, ']' }, { 64, '|' },
+    };
+    int r;
+    int w = 0;
+
+    for (r = 0; r < length; r++)
+    {
+        uint8_t byte = Ascii7to8[RefRead7Bits(a7bitPtr, r*7)];
+        int i;
+
+        if (byte == 27)
+        {
+            // An escape at the end is converted with the septet following it.
+            r++;
+            uint8_t septet = RefRead7Bits(a7bitPtr, r*7);
+
+            byte = '?';
+            for (i = 0; i < NUM_ARRAY_MEMBERS(extension); i++)
+            {
+                if (extension[i].septet == septet)
+                {
+                    byte = extension[i].byte;
+                }
+            }
+        }
+        if (w >= a8bitSize)
+        {
+            return LE_OVERFLOW;
+        }
+        a8bitPtr[w++] = byte;
+    }
+
+    return w;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fill a buffer with random bytes, biased towards the characters of the GSM extension table and
+ * the escape septet depending on the round.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FillRandom
+(
+    uint8_t* bufferPtr,
+    size_t   size,
+    int      round
+)
+{
+    static const uint8_t biased[] = { '[', ']', '{', '}', '|', '~', '^', '\\', 0x1B, 0x36 };
+    size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        switch (round % 3)
+        {
+            case 0:
+                bufferPtr[i] = rand();
+                break;
+            case 1:
+                bufferPtr[i] = ' ' + (rand() % 95);
+                break;
+            default:
+                bufferPtr[i] = (rand() % 2) ? biased[rand() % sizeof(biased)] : rand();
+                break;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Differential test of the GSM 7 bits conversions: random texts are encoded and random septets are
+ * decoded, and the results are compared to the reference conversions.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t TestGsm7Conversion
+(
+    void
+)
+{
+    uint8_t text[LE_SMS_TEXT_MAX_LEN];
+    uint8_t ref[2 * LE_SMS_TEXT_MAX_LEN];   // Room for a text of escaped characters
+    pa_sms_Message_t message;
+    smsPdu_DataToEncode_t data;
+    pa_sms_Pdu_t pdu;
+    int i;
+
+    srand(41);
+
+    for (i = 0; i < GSM7_FUZZ_ITERATIONS; i++)
+    {
+        size_t length = 1 + (rand() % sizeof(text));
+        int septets;
+        int size;
+        le_result_t res;
+
+        FillRandom(text, length, i);
+
+        memset(&data, 0, sizeof(data));
+        data.protocol = PA_SMS_PROTOCOL_GSM;
+        data.messagePtr = text;
+        data.length = length;
+        data.addressPtr = "+33661651866";
+        data.encoding = SMSPDU_7_BITS;
+        data.messageType = PA_SMS_SUBMIT;
+
+        memset(ref, 0, sizeof(ref));
+        size = RefConvert8BitsTo7Bits(text, length, ref, &septets);
+        res = smsPdu_Encode(&data, &pdu);
+        if (size > LE_SMS_PDU_MAX_PAYLOAD)
+        {
+            if (LE_OVERFLOW != res)
+            {
+                LE_ERROR("Encode %d: %d, expected overflow", i, res);
+                return LE_FAULT;
+            }
+        }
+        else if ((LE_OK != res) || (pdu.dataLen <= size) ||
+                 (pdu.data[pdu.dataLen - size - 1] != (uint8_t)septets) ||
+                 memcmp(&pdu.data[pdu.dataLen - size], ref, size))
+        {
+            LE_ERROR("Encode %d: %d, %d septets", i, res, septets);
+            DumpPdu("Pdu encoded:", pdu.data, pdu.dataLen);
+            DumpPdu("User data ref:", ref, size);
+            return LE_FAULT;
+        }
+
+        uint8_t pduData[PDU_MAX] = {0};
+        uint8_t* userDataPtr = &pduData[sizeof(Gsm7DeliverHeader) + 1];
+
+        septets = 1 + (rand() % 200);
+        memcpy(pduData, Gsm7DeliverHeader, sizeof(Gsm7DeliverHeader));
+        pduData[sizeof(Gsm7DeliverHeader)] = septets;
+        FillRandom(userDataPtr, ((septets * 7) + 7) / 8, i);
+
+        size = RefConvert7BitsTo8Bits(userDataPtr, septets, ref, sizeof(message.smsDeliver.data));
+        res = smsPdu_Decode(PA_SMS_PROTOCOL_GSM, pduData,
+                            sizeof(Gsm7DeliverHeader) + 1 + (((septets * 7) + 7) / 8), true,
+                            &message);
+        if (LE_OVERFLOW == size)
+        {
+            if (LE_OVERFLOW != res)
+            {
+                LE_ERROR("Decode %d: %d, expected overflow", i, res);
+                return LE_FAULT;
+            }
+        }
+        else if ((LE_OK != res) || (message.smsDeliver.dataLen != size) ||
+                 memcmp(message.smsDeliver.data, ref, size))
+        {
+            LE_ERROR("Decode %d: %d, %u bytes, expected %d", i, res,
+                     message.smsDeliver.dataLen, size);
+            DumpPdu("Data decoded:", message.smsDeliver.data, message.smsDeliver.dataLen);
+            DumpPdu("Data ref:", ref, size);
+            return LE_FAULT;
+        }
+    }
+
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /*
  * SMS PDU encoding and decoding test
@@ -2114,5 +2394,8 @@ void testle_sms_SmsPduTest
     LE_INFO("Test DecodePdu started");
     LE_ASSERT_OK(TestDecodePdu());
 
+    LE_INFO("Test Gsm7Conversion started");
+    LE_ASSERT_OK(TestGsm7Conversion());
+
     LE_INFO("smsPduTest SUCCESS");
 }
@@ -0,0 +1,297 @@
+/**
+ * Benchmark of the data mode relay of the port service, with splice() and with copy.
+ *
+ * The device is the slave side of a pseudo-terminal in raw mode, and the client is a socket pair,
+ * as a PPP daemon connected to the port service would be.  The relay runs in the main thread's
+ * event loop.  For each direction, a producer thread writes a pattern to one end (the master side
+ * of the pseudo-terminal, or the client socket) while the benchmark thread reads it from the other
+ * end and checks it.  The throughput is printed in MB/s, with the CPU time the relay took, in
+ * milliseconds per MB.  As the port service does, the relay is given duplicates of the device and
+ * client file descriptors, which must be blocking again once the relay is stopped.
+ *
+ * Usage: portRelayBench [SIZE_MB]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "relay.h"
+#include <termios.h>
+
+#define DEFAULT_SIZE_MB     64
+#define CHUNK_SIZE          (16 * 1024)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Bytes relayed in each direction, in each run.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t Size;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main thread, running the relay, and its CPU clock.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_thread_Ref_t MainThread;
+static clockid_t MainClock;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Relay of the current run, and the ends of the pseudo-terminal and of the client socket pair left
+ * to the benchmark.
+ */
+//--------------------------------------------------------------------------------------------------
+static relay_Ref_t RelayRef;
+static int MasterFd;
+static int ClientFd;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The ends of the pseudo-terminal and of the client socket pair whose duplicates are relayed.
+ */
+//--------------------------------------------------------------------------------------------------
+static int SlaveFd;
+static int PeerFd;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Posted by the main thread once a relay is started or stopped.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_sem_Ref_t Semaphore;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Byte of the pattern at an offset.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint8_t Pattern
+(
+    size_t offset
+)
+{
+    return (uint8_t)(offset % 251);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Seconds of a clock.
+ */
+//--------------------------------------------------------------------------------------------------
+static double ClockSeconds
+(
+    clockid_t clock
+)
+{
+    struct timespec time;
+
+    LE_ASSERT(0 == clock_gettime(clock, &time));
+    return time.tv_sec + (time.tv_nsec / 1e9);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Producer thread: write the pattern to a file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* Produce
+(
+    void* contextPtr        ///< [IN] File descriptor
+)
+{
+    static uint8_t chunk[CHUNK_SIZE + 251];
+    int fd = (int)(intptr_t)contextPtr;
+    size_t done = 0;
+    size_t i;
+
+    for (i = 0; i < sizeof(chunk); i++)
+    {
+        chunk[i] = Pattern(i);
+    }
+
+    while (done < Size)
+    {
+        size_t size = Size - done;
+        ssize_t written;
+
+        if (size > CHUNK_SIZE)
+        {
+            size = CHUNK_SIZE;
+        }
+        written = write(fd, chunk + (done % 251), size);
+        if (written < 0)
+        {
+            LE_FATAL_IF(EINTR != errno, "write failed: %m");
+            continue;
+        }
+        done += written;
+    }
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Relay the pattern from one file descriptor to another, check it and print the throughput.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunDirection
+(
+    const char* namePtr,    ///< [IN] Name of the run
+    int         inFd,       ///< [IN] File descriptor to write the pattern to
+    int         outFd       ///< [IN] File descriptor to read the pattern from
+)
+{
+    static uint8_t buffer[CHUNK_SIZE];
+    size_t done = 0;
+    double startTime = ClockSeconds(CLOCK_MONOTONIC);
+    double startCpu = ClockSeconds(MainClock);
+
+    le_thread_Ref_t producerRef = le_thread_Create("Produce", Produce, (void*)(intptr_t)inFd);
+    le_thread_SetJoinable(producerRef);
+    le_thread_Start(producerRef);
+
+    while (done < Size)
+    {
+        ssize_t size = read(outFd, buffer, sizeof(buffer));
+        ssize_t i;
+
+        if (size < 0)
+        {
+            LE_FATAL_IF(EINTR != errno, "read failed: %m");
+            continue;
+        }
+        LE_FATAL_IF(0 == size, "Relay closed after %zu bytes", done);
+        for (i = 0; i < size; i++)
+        {
+            LE_FATAL_IF(buffer[i] != Pattern(done + i), "Byte %zu differs", done + i);
+        }
+        done += size;
+    }
+
+    double seconds = ClockSeconds(CLOCK_MONOTONIC) - startTime;
+    double cpu = ClockSeconds(MainClock) - startCpu;
+    double megabytes = Size / (1024.0 * 1024.0);
+
+    LE_ASSERT_OK(le_thread_Join(producerRef, NULL));
+    printf("%-18s %8.2f MB/s %8.2f ms CPU/MB\n", namePtr, megabytes / seconds,
+           cpu * 1000 / megabytes);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open a pseudo-terminal in raw mode and a socket pair, and start to relay them.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartRelay
+(
+    void* param1Ptr,        ///< [IN] True to relay with splice()
+    void* param2Ptr         ///< [IN] Unused
+)
+{
+    struct termios term;
+    int sockets[2];
+
+    MasterFd = posix_openpt(O_RDWR | O_NOCTTY);
+    LE_FATAL_IF(-1 == MasterFd, "posix_openpt failed: %m");
+    LE_FATAL_IF((0 != grantpt(MasterFd)) || (0 != unlockpt(MasterFd)), "pty setup failed: %m");
+    SlaveFd = open(ptsname(MasterFd), O_RDWR | O_NOCTTY);
+    LE_FATAL_IF(-1 == SlaveFd, "open slave failed: %m");
+    LE_ASSERT(0 == tcgetattr(SlaveFd, &term));
+    cfmakeraw(&term);
+    LE_ASSERT(0 == tcsetattr(SlaveFd, TCSANOW, &term));
+
+    LE_FATAL_IF(-1 == socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), "socketpair failed: %m");
+    ClientFd = sockets[0];
+    PeerFd = sockets[1];
+
+    RelayRef = relay_Start(dup(SlaveFd), dup(PeerFd), (bool)(intptr_t)param1Ptr);
+    LE_ASSERT(RelayRef);
+    le_sem_Post(Semaphore);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the counters of the relay and stop it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StopRelay
+(
+    void* param1Ptr,        ///< [IN] Unused
+    void* param2Ptr         ///< [IN] Unused
+)
+{
+    uint64_t fromDevice;
+    uint64_t toDevice;
+    bool isSplice;
+    bool isRunning;
+
+    relay_GetCounters(RelayRef, &fromDevice, &toDevice, &isSplice, &isRunning);
+    LE_ASSERT(isRunning);
+    LE_ASSERT((fromDevice == Size) && (toDevice == Size));
+    if (param1Ptr && !isSplice)
+    {
+        printf("splice() not supported, fell back to copy\n");
+    }
+
+    relay_Stop(RelayRef);
+    LE_ASSERT(0 == (fcntl(SlaveFd, F_GETFL) & O_NONBLOCK));
+    LE_ASSERT(0 == (fcntl(PeerFd, F_GETFL) & O_NONBLOCK));
+    close(SlaveFd);
+    close(PeerFd);
+    close(MasterFd);
+    close(ClientFd);
+    le_sem_Post(Semaphore);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark thread: relay the pattern in both directions, with splice() and with copy.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* Bench
+(
+    void* contextPtr
+)
+{
+    static const char* modeNames[] = { "copy", "splice" };
+    char name[32];
+    int useSplice;
+
+    printf("%zu MB in each direction\n", Size / (1024 * 1024));
+
+    for (useSplice = 1; useSplice >= 0; useSplice--)
+    {
+        le_event_QueueFunctionToThread(MainThread, StartRelay, (void*)(intptr_t)useSplice, NULL);
+        le_sem_Wait(Semaphore);
+
+        snprintf(name, sizeof(name), "%s from device", modeNames[useSplice]);
+        RunDirection(name, MasterFd, ClientFd);
+        snprintf(name, sizeof(name), "%s to device", modeNames[useSplice]);
+        RunDirection(name, ClientFd, MasterFd);
+
+        le_event_QueueFunctionToThread(MainThread, StopRelay, (void*)(intptr_t)useSplice, NULL);
+        le_sem_Wait(Semaphore);
+    }
+
+    exit(EXIT_SUCCESS);
+}
+
+COMPONENT_INIT
+{
+    Size = DEFAULT_SIZE_MB;
+    if (le_arg_NumArgs() >= 1)
+    {
+        Size = atoi(le_arg_GetArg(0));
+    }
+    LE_ASSERT(Size > 0);
+    Size *= 1024 * 1024;
+
+    relay_Init();
+
+    MainThread = le_thread_GetCurrent();
+    LE_ASSERT(0 == pthread_getcpuclockid(pthread_self(), &MainClock));
+    Semaphore = le_sem_Create("RelayBench", 0);
+
+    le_thread_Start(le_thread_Create("Bench", Bench, NULL));
+}
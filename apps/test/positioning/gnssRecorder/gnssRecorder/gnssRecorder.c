@@ -0,0 +1,126 @@
+/**
+ * Record the position fixes of the GNSS service to a fix log.
+ *
+ * The fixes are read from the shared memory fix ring of the positioning service, and written to
+ * the file as they are, after a gnssFixRing_LogHeader_t.  The log can then be replayed by the
+ * replay GNSS platform adaptor (components/positioning/platformAdaptor/replay), to run the
+ * positioning service and its benchmarks without a GNSS device.
+ *
+ * The GNSS device is started if it is not already.
+ *
+ * Usage: app runProc gnssRecorder --exe=gnssRecorder -- FILE [SECONDS]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "gnssFixRing.h"
+
+#define DEFAULT_SECONDS     60
+
+static FILE* LogFilePtr;
+static gnssFixRing_Ref_t RingRef;
+static size_t FixCount;
+static size_t LostCount;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the new fixes of the ring to the log.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RingEventHandler(int fd, short events)
+{
+    gnssFixRing_Record_t record;
+    le_result_t result;
+
+    gnssFixRing_ClearEvent(RingRef);
+
+    while ((result = gnssFixRing_ReadNext(RingRef, &record)) != LE_WOULD_BLOCK)
+    {
+        if (result == LE_OVERFLOW)
+        {
+            LostCount++;
+        }
+
+        // The sequence lock is meaningless out of the ring.
+        record.seq = 0;
+        LE_FATAL_IF(fwrite(&record, sizeof(record), 1, LogFilePtr) != 1,
+                    "Failed to write the fix log (%m).");
+        FixCount++;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the log once the recording time is over.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StopTimerHandler(le_timer_Ref_t timerRef)
+{
+    RingEventHandler(-1, 0);
+
+    LE_FATAL_IF(fclose(LogFilePtr) != 0, "Failed to write the fix log (%m).");
+    gnssFixRing_Close(RingRef);
+
+    printf("%zu fixes recorded", FixCount);
+    if (LostCount > 0)
+    {
+        printf(", fixes lost %zu times", LostCount);
+    }
+    printf("\n");
+
+    exit(EXIT_SUCCESS);
+}
+
+
+COMPONENT_INIT
+{
+    gnssFixRing_LogHeader_t header =
+    {
+        .magic = GNSS_FIXLOG_MAGIC,
+        .version = GNSS_FIXRING_VERSION,
+        .recordSize = sizeof(gnssFixRing_Record_t),
+    };
+    int seconds = DEFAULT_SECONDS;
+    int ringFd;
+    int eventFd;
+
+    LE_FATAL_IF(le_arg_NumArgs() < 1, "Usage: gnssRecorder FILE [SECONDS]");
+    if (le_arg_NumArgs() >= 2)
+    {
+        seconds = atoi(le_arg_GetArg(1));
+        LE_FATAL_IF(seconds < 1, "Duration must be at least 1 second.");
+    }
+
+    LogFilePtr = fopen(le_arg_GetArg(0), "w");
+    LE_FATAL_IF(LogFilePtr == NULL, "Can't create %s (%m).", le_arg_GetArg(0));
+    LE_FATAL_IF(fwrite(&header, sizeof(header), 1, LogFilePtr) != 1,
+                "Failed to write the fix log (%m).");
+
+    LE_ASSERT_OK(le_gnss_GetFixRing(&ringFd));
+    LE_ASSERT_OK(le_gnss_GetFixRingEvent(&eventFd));
+    RingRef = gnssFixRing_Open(ringFd, eventFd);
+    LE_ASSERT(RingRef != NULL);
+    le_fdMonitor_Create("fixRing", eventFd, RingEventHandler, POLLIN);
+
+    switch (le_gnss_GetState())
+    {
+        case LE_GNSS_STATE_DISABLED:
+            LE_ASSERT_OK(le_gnss_Enable());
+            LE_ASSERT_OK(le_gnss_Start());
+            break;
+        case LE_GNSS_STATE_READY:
+            LE_ASSERT_OK(le_gnss_Start());
+            break;
+        default:
+            break;
+    }
+
+    le_timer_Ref_t timerRef = le_timer_Create("stop");
+    le_timer_SetMsInterval(timerRef, seconds * 1000);
+    le_timer_SetHandler(timerRef, StopTimerHandler);
+    LE_ASSERT_OK(le_timer_Start(timerRef));
+}
@@ -0,0 +1,570 @@
+/**
+ * Benchmark of the position sample accessors of the GNSS service.
+ *
+ * Several subscribers, each one with its own IPC session like separate apps would have, are
+ * notified of the position fixes at a 10 Hz acquisition rate. For each fix, every subscriber reads
+ * the whole sample: first through the individual getters (le_gnss_GetLocation(),
+ * le_gnss_GetAltitude(), le_gnss_GetTime(), ...), then through le_gnss_GetSample(). Finally, the
+ * subscribers drop their handlers and read the fixes from the shared memory fix ring instead,
+ * woken up by its event file descriptor. For each method, the time taken to read a fix, the CPU
+ * time it costs, in the subscribers and in the positioning daemon, and the end-to-end delivery
+ * latency are reported. The latency of a fix is measured from the time the positioning daemon got
+ * it from the platform adaptor, as recorded in the fix ring, to the time a subscriber starts
+ * reading it.
+ *
+ * Built with the replay GNSS platform adaptor (components/positioning/platformAdaptor/replay), the
+ * positioning daemon replays a recording instead of using the GNSS device, so the benchmark can be
+ * run without hardware, and at a higher rate than the device's by setting the replay speed.
+ *
+ * Usage: app runProc gnssSampleBench --exe=gnssSampleBench -- [SUBSCRIBERS] [SECONDS_PER_METHOD]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "gnssFixRing.h"
+
+#define ACQUISITION_RATE_MS     100
+#define MAX_SUBSCRIBERS         16
+#define SERVER_PROCESS_NAME     "posDaemon"
+
+typedef enum
+{
+    METHOD_GETTERS,
+    METHOD_SAMPLE,
+    METHOD_RING,
+    METHOD_COUNT
+}
+Method_t;
+
+static const char* MethodNames[METHOD_COUNT] =
+{
+    "individual getters",
+    "le_gnss_GetSample()",
+    "shared memory fix ring",
+};
+
+typedef struct
+{
+    size_t   fixCount;      ///< Number of fixes read.
+    uint64_t totalNs;       ///< Total time taken to read the fixes.
+    uint64_t maxNs;         ///< Longest time taken to read a fix.
+    uint64_t cpuNs;         ///< CPU time taken to read the fixes.
+    size_t   latencyCount;  ///< Number of fixes whose delivery latency was measured.
+    uint64_t latencyNs;     ///< Total delivery latency of the fixes.
+    uint64_t latencyMaxNs;  ///< Longest delivery latency of a fix.
+}
+Stats_t;
+
+typedef struct
+{
+    Stats_t* statsPtr;                          ///< Statistics of the subscriber.
+    le_thread_Ref_t threadRef;                  ///< Subscriber's thread.
+    le_gnss_PositionHandlerRef_t handlerRef;    ///< Position handler, until the fix ring phase.
+    gnssFixRing_Ref_t ringRef;                  ///< Fix ring, to get the time of the fixes, and
+                                                ///< to read them in the fix ring phase.
+}
+Subscriber_t;
+
+static Stats_t Stats[MAX_SUBSCRIBERS];
+static Subscriber_t Subscribers[MAX_SUBSCRIBERS];
+static size_t SubscriberCount = 4;
+static int PhaseSeconds = 30;
+static Method_t Method = METHOD_GETTERS;
+static le_mutex_Ref_t Mutex;
+static pid_t ServerPid = -1;
+static uint64_t ServerStartTicks;
+
+
+static uint64_t NowNs(clockid_t clockId)
+{
+    struct timespec now;
+
+    LE_ASSERT(clock_gettime(clockId, &now) == 0);
+
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the positioning daemon, to measure its CPU time.
+ */
+//--------------------------------------------------------------------------------------------------
+static pid_t FindServer(void)
+{
+    DIR* dirPtr = opendir("/proc");
+    struct dirent* entryPtr;
+    pid_t pid = -1;
+
+    LE_ASSERT(dirPtr != NULL);
+
+    while ((pid < 0) && ((entryPtr = readdir(dirPtr)) != NULL))
+    {
+        char path[PATH_MAX];
+        char name[32] = "";
+        FILE* filePtr;
+
+        snprintf(path, sizeof(path), "/proc/%s/comm", entryPtr->d_name);
+        filePtr = fopen(path, "r");
+        if (filePtr == NULL)
+        {
+            continue;
+        }
+
+        if ((fscanf(filePtr, "%31s", name) == 1) && (strcmp(name, SERVER_PROCESS_NAME) == 0))
+        {
+            pid = atoi(entryPtr->d_name);
+        }
+        fclose(filePtr);
+    }
+
+    closedir(dirPtr);
+
+    return pid;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the CPU time (user + system) of the positioning daemon, in clock ticks.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetServerTicks(void)
+{
+    char path[PATH_MAX];
+    unsigned long long utime = 0;
+    unsigned long long stime = 0;
+    FILE* filePtr;
+
+    if (ServerPid < 0)
+    {
+        return 0;
+    }
+
+    snprintf(path, sizeof(path), "/proc/%d/stat", ServerPid);
+    filePtr = fopen(path, "r");
+    if (filePtr == NULL)
+    {
+        return 0;
+    }
+
+    // Fields 14 and 15, after the command name which is in parentheses.
+    if (fscanf(filePtr, "%*d (%*[^)]) %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu",
+               &utime, &stime) != 2)
+    {
+        utime = 0;
+        stime = 0;
+    }
+    fclose(filePtr);
+
+    return utime + stime;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read every field of a sample through the individual getters.
+ *
+ * @return The epoch time of the sample.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ReadWithGetters(le_gnss_SampleRef_t sampleRef)
+{
+    le_gnss_FixState_t state;
+    int32_t latitude, longitude, hAccuracy, altitude, vAccuracy, altitudeOnWgs84;
+    uint32_t hSpeed, hSpeedAccuracy, direction, directionAccuracy;
+    int32_t vSpeed, vSpeedAccuracy, magneticDeviation;
+    uint16_t year, month, day, hours, minutes, seconds, milliseconds;
+    uint64_t epochTime;
+    uint32_t gpsWeek, gpsTimeOfWeek, timeAccuracy;
+    uint8_t leapSeconds, satsInView, satsTracking, satsUsed;
+    uint16_t dop;
+    le_gnss_DopType_t dopType;
+
+    le_gnss_GetPositionState(sampleRef, &state);
+    le_gnss_GetLocation(sampleRef, &latitude, &longitude, &hAccuracy);
+    le_gnss_GetAltitude(sampleRef, &altitude, &vAccuracy);
+    le_gnss_GetAltitudeOnWgs84(sampleRef, &altitudeOnWgs84);
+    le_gnss_GetHorizontalSpeed(sampleRef, &hSpeed, &hSpeedAccuracy);
+    le_gnss_GetVerticalSpeed(sampleRef, &vSpeed, &vSpeedAccuracy);
+    le_gnss_GetDirection(sampleRef, &direction, &directionAccuracy);
+    le_gnss_GetDate(sampleRef, &year, &month, &day);
+    le_gnss_GetTime(sampleRef, &hours, &minutes, &seconds, &milliseconds);
+    le_gnss_GetEpochTime(sampleRef, &epochTime);
+    le_gnss_GetGpsTime(sampleRef, &gpsWeek, &gpsTimeOfWeek);
+    le_gnss_GetTimeAccuracy(sampleRef, &timeAccuracy);
+    le_gnss_GetGpsLeapSeconds(sampleRef, &leapSeconds);
+    for (dopType = LE_GNSS_PDOP; dopType < LE_GNSS_DOP_LAST; dopType++)
+    {
+        le_gnss_GetDilutionOfPrecision(sampleRef, dopType, &dop);
+    }
+    le_gnss_GetMagneticDeviation(sampleRef, &magneticDeviation);
+    le_gnss_GetSatellitesStatus(sampleRef, &satsInView, &satsTracking, &satsUsed);
+
+    return epochTime;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read every field of a sample at once.
+ *
+ * @return The epoch time of the sample.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ReadWithSample(le_gnss_SampleRef_t sampleRef)
+{
+    le_gnss_FixState_t state;
+    le_gnss_SampleField_t fieldsValid;
+    int32_t latitude, longitude, hAccuracy, altitude, vAccuracy, altitudeOnWgs84;
+    uint32_t hSpeed, hSpeedAccuracy, direction, directionAccuracy;
+    int32_t vSpeed, vSpeedAccuracy, magneticDeviation;
+    uint16_t year, month, day, hours, minutes, seconds, milliseconds;
+    uint64_t epochTime;
+    uint32_t gpsWeek, gpsTimeOfWeek, timeAccuracy;
+    uint8_t leapSeconds, satsInView, satsTracking, satsUsed;
+    uint16_t dop[LE_GNSS_DOP_MAX_LEN];
+    size_t dopSize = LE_GNSS_DOP_MAX_LEN;
+
+    le_gnss_GetSample(sampleRef, &state, &fieldsValid,
+                      &latitude, &longitude, &hAccuracy,
+                      &altitude, &vAccuracy, &altitudeOnWgs84,
+                      &hSpeed, &hSpeedAccuracy, &vSpeed, &vSpeedAccuracy,
+                      &direction, &directionAccuracy,
+                      &year, &month, &day, &hours, &minutes, &seconds, &milliseconds,
+                      &epochTime, &gpsWeek, &gpsTimeOfWeek, &timeAccuracy, &leapSeconds,
+                      dop, &dopSize, &magneticDeviation,
+                      &satsInView, &satsTracking, &satsUsed);
+
+    return epochTime;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the time the positioning daemon got a fix, from its record in the fix ring.
+ *
+ * @return The time in nanoseconds of CLOCK_MONOTONIC, or 0 if the fix isn't in the ring.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetFixTimestamp(gnssFixRing_Ref_t ringRef, uint64_t epochTime)
+{
+    gnssFixRing_Record_t record;
+
+    // The positioning daemon writes a fix to the ring before notifying the handlers, so the
+    // records of the fixes before it are skipped.
+    while (gnssFixRing_ReadNext(ringRef, &record) != LE_WOULD_BLOCK)
+    {
+        if (record.epochTime == epochTime)
+        {
+            return record.timestampNs;
+        }
+    }
+
+    return 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add the delivery latency of a fix to the statistics.  Called with the mutex locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddLatency(Stats_t* statsPtr, uint64_t fixTimestampNs, uint64_t deliveryNs)
+{
+    if ((fixTimestampNs == 0) || (fixTimestampNs > deliveryNs))
+    {
+        return;
+    }
+
+    uint64_t latencyNs = deliveryNs - fixTimestampNs;
+
+    statsPtr->latencyCount++;
+    statsPtr->latencyNs += latencyNs;
+    if (latencyNs > statsPtr->latencyMaxNs)
+    {
+        statsPtr->latencyMaxNs = latencyNs;
+    }
+}
+
+
+static void PositionHandler(le_gnss_SampleRef_t sampleRef, void* contextPtr)
+{
+    Subscriber_t* subscriberPtr = contextPtr;
+    Stats_t* statsPtr = subscriberPtr->statsPtr;
+    uint64_t startNs = NowNs(CLOCK_MONOTONIC);
+    uint64_t startCpuNs = NowNs(CLOCK_THREAD_CPUTIME_ID);
+    Method_t method;
+    uint64_t epochTime;
+
+    le_mutex_Lock(Mutex);
+    method = Method;
+    le_mutex_Unlock(Mutex);
+
+    if (method == METHOD_GETTERS)
+    {
+        epochTime = ReadWithGetters(sampleRef);
+    }
+    else
+    {
+        epochTime = ReadWithSample(sampleRef);
+    }
+    le_gnss_ReleaseSampleRef(sampleRef);
+
+    uint64_t elapsedNs = NowNs(CLOCK_MONOTONIC) - startNs;
+    uint64_t cpuNs = NowNs(CLOCK_THREAD_CPUTIME_ID) - startCpuNs;
+    uint64_t fixTimestampNs = GetFixTimestamp(subscriberPtr->ringRef, epochTime);
+
+    le_mutex_Lock(Mutex);
+    if (method == Method)
+    {
+        statsPtr->fixCount++;
+        statsPtr->totalNs += elapsedNs;
+        statsPtr->cpuNs += cpuNs;
+        if (elapsedNs > statsPtr->maxNs)
+        {
+            statsPtr->maxNs = elapsedNs;
+        }
+        AddLatency(statsPtr, fixTimestampNs, startNs);
+    }
+    le_mutex_Unlock(Mutex);
+}
+
+
+static void RingEventHandler(int fd, short events)
+{
+    Subscriber_t* subscriberPtr = le_fdMonitor_GetContextPtr();
+    Stats_t* statsPtr = subscriberPtr->statsPtr;
+    gnssFixRing_Record_t record;
+    uint64_t startNs = NowNs(CLOCK_MONOTONIC);
+    uint64_t startCpuNs = NowNs(CLOCK_THREAD_CPUTIME_ID);
+    size_t fixCount = 0;
+    uint64_t fixTimestampNs[GNSS_FIXRING_SLOT_COUNT];
+    size_t i;
+
+    gnssFixRing_ClearEvent(subscriberPtr->ringRef);
+    while (gnssFixRing_ReadNext(subscriberPtr->ringRef, &record) != LE_WOULD_BLOCK)
+    {
+        if (fixCount < GNSS_FIXRING_SLOT_COUNT)
+        {
+            fixTimestampNs[fixCount] = record.timestampNs;
+        }
+        fixCount++;
+    }
+
+    uint64_t elapsedNs = NowNs(CLOCK_MONOTONIC) - startNs;
+    uint64_t cpuNs = NowNs(CLOCK_THREAD_CPUTIME_ID) - startCpuNs;
+
+    if (fixCount == 0)
+    {
+        return;
+    }
+
+    le_mutex_Lock(Mutex);
+    if (Method == METHOD_RING)
+    {
+        statsPtr->fixCount += fixCount;
+        statsPtr->totalNs += elapsedNs;
+        statsPtr->cpuNs += cpuNs;
+        if (elapsedNs > statsPtr->maxNs)
+        {
+            statsPtr->maxNs = elapsedNs;
+        }
+        for (i = 0; (i < fixCount) && (i < GNSS_FIXRING_SLOT_COUNT); i++)
+        {
+            AddLatency(statsPtr, fixTimestampNs[i], startNs);
+        }
+    }
+    le_mutex_Unlock(Mutex);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Switch a subscriber from its position handler to the fix ring.  Runs on the subscriber's thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SwitchToRing(void* contextPtr, void* unusedPtr)
+{
+    Subscriber_t* subscriberPtr = contextPtr;
+    int eventFd = gnssFixRing_GetEventFd(subscriberPtr->ringRef);
+    gnssFixRing_Record_t record;
+
+    le_gnss_RemovePositionHandler(subscriberPtr->handlerRef);
+
+    // Skip the fixes delivered to the position handler.
+    gnssFixRing_ClearEvent(subscriberPtr->ringRef);
+    while (gnssFixRing_ReadNext(subscriberPtr->ringRef, &record) != LE_WOULD_BLOCK)
+    {
+    }
+
+    le_fdMonitor_Ref_t monitorRef = le_fdMonitor_Create("fixRing", eventFd, RingEventHandler,
+                                                        POLLIN);
+    le_fdMonitor_SetContextPtr(monitorRef, subscriberPtr);
+}
+
+
+static void* SubscriberThread(void* contextPtr)
+{
+    Subscriber_t* subscriberPtr = contextPtr;
+    int ringFd;
+    int eventFd;
+
+    le_gnss_ConnectService();
+
+    LE_ASSERT_OK(le_gnss_GetFixRing(&ringFd));
+    LE_ASSERT_OK(le_gnss_GetFixRingEvent(&eventFd));
+    subscriberPtr->ringRef = gnssFixRing_Open(ringFd, eventFd);
+    LE_ASSERT(subscriberPtr->ringRef != NULL);
+
+    subscriberPtr->handlerRef = le_gnss_AddPositionHandler(PositionHandler, subscriberPtr);
+    LE_ASSERT(subscriberPtr->handlerRef != NULL);
+
+    le_event_RunLoop();
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report the results of the current method, then switch to the next one.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PhaseTimerHandler(le_timer_Ref_t timerRef)
+{
+    Stats_t total = { 0 };
+    size_t i;
+    uint64_t serverTicks = GetServerTicks() - ServerStartTicks;
+    size_t fixCount;
+
+    le_mutex_Lock(Mutex);
+
+    for (i = 0; i < SubscriberCount; i++)
+    {
+        total.fixCount += Stats[i].fixCount;
+        total.totalNs += Stats[i].totalNs;
+        total.cpuNs += Stats[i].cpuNs;
+        if (Stats[i].maxNs > total.maxNs)
+        {
+            total.maxNs = Stats[i].maxNs;
+        }
+        total.latencyCount += Stats[i].latencyCount;
+        total.latencyNs += Stats[i].latencyNs;
+        if (Stats[i].latencyMaxNs > total.latencyMaxNs)
+        {
+            total.latencyMaxNs = Stats[i].latencyMaxNs;
+        }
+    }
+
+    // Number of fixes delivered (each one is read by every subscriber).
+    fixCount = total.fixCount / SubscriberCount;
+
+    if (fixCount == 0)
+    {
+        printf("%s: no fix received.\n", MethodNames[Method]);
+    }
+    else
+    {
+        printf("%s: %zu fixes, %zu subscribers\n"
+               "  read time per fix and subscriber: avg %.1f us, max %.1f us\n"
+               "  subscriber CPU per fix and subscriber: %.1f us\n",
+               MethodNames[Method], fixCount, SubscriberCount,
+               total.totalNs / 1000.0 / total.fixCount, total.maxNs / 1000.0,
+               total.cpuNs / 1000.0 / total.fixCount);
+
+        if (total.latencyCount > 0)
+        {
+            printf("  delivery latency: avg %.1f us, max %.1f us\n",
+                   total.latencyNs / 1000.0 / total.latencyCount, total.latencyMaxNs / 1000.0);
+        }
+
+        if (ServerPid >= 0)
+        {
+            printf("  " SERVER_PROCESS_NAME " CPU per fix (all subscribers): %.1f us\n",
+                   serverTicks * 1000000.0 / sysconf(_SC_CLK_TCK) / fixCount);
+        }
+    }
+
+    memset(Stats, 0, sizeof(Stats));
+    ServerStartTicks = GetServerTicks();
+    Method++;
+
+    le_mutex_Unlock(Mutex);
+
+    if (Method == METHOD_COUNT)
+    {
+        le_gnss_Stop();
+        exit(EXIT_SUCCESS);
+    }
+
+    if (Method == METHOD_RING)
+    {
+        for (i = 0; i < SubscriberCount; i++)
+        {
+            le_event_QueueFunctionToThread(Subscribers[i].threadRef, SwitchToRing,
+                                           &Subscribers[i], NULL);
+        }
+    }
+}
+
+
+COMPONENT_INIT
+{
+    le_timer_Ref_t timerRef;
+    size_t i;
+
+    if (le_arg_NumArgs() >= 1)
+    {
+        SubscriberCount = atoi(le_arg_GetArg(0));
+        LE_FATAL_IF((SubscriberCount < 1) || (SubscriberCount > MAX_SUBSCRIBERS),
+                    "Number of subscribers must be between 1 and %d.", MAX_SUBSCRIBERS);
+    }
+    if (le_arg_NumArgs() >= 2)
+    {
+        PhaseSeconds = atoi(le_arg_GetArg(1));
+        LE_FATAL_IF(PhaseSeconds < 1, "Duration must be at least 1 second.");
+    }
+
+    Mutex = le_mutex_CreateNonRecursive("gnssSampleBench");
+
+    // Acquire at 10 Hz.
+    switch (le_gnss_GetState())
+    {
+        case LE_GNSS_STATE_ACTIVE:
+            LE_ASSERT_OK(le_gnss_Stop());
+            break;
+        case LE_GNSS_STATE_DISABLED:
+            LE_ASSERT_OK(le_gnss_Enable());
+            break;
+        default:
+            break;
+    }
+    LE_ASSERT_OK(le_gnss_SetAcquisitionRate(ACQUISITION_RATE_MS));
+    LE_ASSERT_OK(le_gnss_Start());
+
+    ServerPid = FindServer();
+    if (ServerPid < 0)
+    {
+        LE_WARN("Can't find " SERVER_PROCESS_NAME ", its CPU time won't be reported.");
+    }
+    ServerStartTicks = GetServerTicks();
+
+    for (i = 0; i < SubscriberCount; i++)
+    {
+        char name[32];
+
+        snprintf(name, sizeof(name), "subscriber%zu", i);
+        Subscribers[i].statsPtr = &Stats[i];
+        Subscribers[i].threadRef = le_thread_Create(name, SubscriberThread, &Subscribers[i]);
+        le_thread_Start(Subscribers[i].threadRef);
+    }
+
+    timerRef = le_timer_Create("phase");
+    le_timer_SetMsInterval(timerRef, PhaseSeconds * 1000);
+    le_timer_SetRepeat(timerRef, METHOD_COUNT);
+    le_timer_SetHandler(timerRef, PhaseTimerHandler);
+    LE_ASSERT_OK(le_timer_Start(timerRef));
+}
@@ -438,6 +438,121 @@ static void Testle_gnss_SetDataResolution
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test: API testing for le_gnss_GetSample(), checking it against the individual getters.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Testle_gnss_GetSample
+(
+    le_gnss_SampleRef_t positionSampleRef
+)
+{
+    le_gnss_FixState_t state, sampleState;
+    le_gnss_SampleField_t fieldsValid;
+    int32_t latitude, longitude, hAccuracy, altitude, vAccuracy, altitudeOnWgs84;
+    int32_t sampleLatitude, sampleLongitude, sampleHAccuracy;
+    int32_t sampleAltitude, sampleVAccuracy, sampleAltitudeOnWgs84;
+    uint32_t hSpeed, hSpeedAccuracy, sampleHSpeed, sampleHSpeedAccuracy;
+    int32_t vSpeed, vSpeedAccuracy, sampleVSpeed, sampleVSpeedAccuracy;
+    uint32_t direction, directionAccuracy, sampleDirection, sampleDirectionAccuracy;
+    uint16_t year, month, day, sampleYear, sampleMonth, sampleDay;
+    uint16_t hours, minutes, seconds, milliseconds;
+    uint16_t sampleHours, sampleMinutes, sampleSeconds, sampleMilliseconds;
+    uint64_t epochTime, sampleEpochTime;
+    uint32_t gpsWeek, gpsTimeOfWeek, sampleGpsWeek, sampleGpsTimeOfWeek;
+    uint32_t timeAccuracy, sampleTimeAccuracy;
+    uint8_t leapSeconds, sampleLeapSeconds;
+    uint16_t dop, sampleDop[LE_GNSS_DOP_MAX_LEN];
+    size_t sampleDopSize = LE_GNSS_DOP_MAX_LEN;
+    int32_t magneticDeviation, sampleMagneticDeviation;
+    uint8_t satsInView, satsTracking, satsUsed;
+    uint8_t sampleSatsInView, sampleSatsTracking, sampleSatsUsed;
+    le_gnss_DopType_t dopType;
+
+    LE_ASSERT_OK(le_gnss_GetSample(positionSampleRef, &sampleState, &fieldsValid,
+                                   &sampleLatitude, &sampleLongitude, &sampleHAccuracy,
+                                   &sampleAltitude, &sampleVAccuracy, &sampleAltitudeOnWgs84,
+                                   &sampleHSpeed, &sampleHSpeedAccuracy,
+                                   &sampleVSpeed, &sampleVSpeedAccuracy,
+                                   &sampleDirection, &sampleDirectionAccuracy,
+                                   &sampleYear, &sampleMonth, &sampleDay,
+                                   &sampleHours, &sampleMinutes, &sampleSeconds,
+                                   &sampleMilliseconds, &sampleEpochTime,
+                                   &sampleGpsWeek, &sampleGpsTimeOfWeek, &sampleTimeAccuracy,
+                                   &sampleLeapSeconds, sampleDop, &sampleDopSize,
+                                   &sampleMagneticDeviation,
+                                   &sampleSatsInView, &sampleSatsTracking, &sampleSatsUsed));
+    LE_ASSERT(LE_GNSS_DOP_MAX_LEN == sampleDopSize);
+
+    LE_ASSERT_OK(le_gnss_GetPositionState(positionSampleRef, &state));
+    LE_ASSERT(state == sampleState);
+
+    le_gnss_GetLocation(positionSampleRef, &latitude, &longitude, &hAccuracy);
+    LE_ASSERT((latitude == sampleLatitude) && (longitude == sampleLongitude)
+              && (hAccuracy == sampleHAccuracy));
+    LE_ASSERT(((fieldsValid & LE_GNSS_SAMPLE_LATITUDE) != 0) == (INT32_MAX != latitude));
+    LE_ASSERT(((fieldsValid & LE_GNSS_SAMPLE_LONGITUDE) != 0) == (INT32_MAX != longitude));
+
+    le_gnss_GetAltitude(positionSampleRef, &altitude, &vAccuracy);
+    LE_ASSERT((altitude == sampleAltitude) && (vAccuracy == sampleVAccuracy));
+    le_gnss_GetAltitudeOnWgs84(positionSampleRef, &altitudeOnWgs84);
+    LE_ASSERT(altitudeOnWgs84 == sampleAltitudeOnWgs84);
+
+    le_gnss_GetHorizontalSpeed(positionSampleRef, &hSpeed, &hSpeedAccuracy);
+    LE_ASSERT((hSpeed == sampleHSpeed) && (hSpeedAccuracy == sampleHSpeedAccuracy));
+    le_gnss_GetVerticalSpeed(positionSampleRef, &vSpeed, &vSpeedAccuracy);
+    LE_ASSERT((vSpeed == sampleVSpeed) && (vSpeedAccuracy == sampleVSpeedAccuracy));
+    le_gnss_GetDirection(positionSampleRef, &direction, &directionAccuracy);
+    LE_ASSERT((direction == sampleDirection) && (directionAccuracy == sampleDirectionAccuracy));
+
+    LE_ASSERT((LE_OK == le_gnss_GetDate(positionSampleRef, &year, &month, &day))
+              == ((fieldsValid & LE_GNSS_SAMPLE_DATE) != 0));
+    LE_ASSERT((year == sampleYear) && (month == sampleMonth) && (day == sampleDay));
+    LE_ASSERT((LE_OK == le_gnss_GetTime(positionSampleRef, &hours, &minutes, &seconds,
+                                        &milliseconds))
+              == ((fieldsValid & LE_GNSS_SAMPLE_TIME) != 0));
+    LE_ASSERT((hours == sampleHours) && (minutes == sampleMinutes)
+              && (seconds == sampleSeconds) && (milliseconds == sampleMilliseconds));
+    le_gnss_GetEpochTime(positionSampleRef, &epochTime);
+    LE_ASSERT(epochTime == sampleEpochTime);
+    if (fieldsValid & LE_GNSS_SAMPLE_GPS_TIME)
+    {
+        le_gnss_GetGpsTime(positionSampleRef, &gpsWeek, &gpsTimeOfWeek);
+        LE_ASSERT((gpsWeek == sampleGpsWeek) && (gpsTimeOfWeek == sampleGpsTimeOfWeek));
+    }
+    le_gnss_GetTimeAccuracy(positionSampleRef, &timeAccuracy);
+    LE_ASSERT(timeAccuracy == sampleTimeAccuracy);
+    le_gnss_GetGpsLeapSeconds(positionSampleRef, &leapSeconds);
+    LE_ASSERT(leapSeconds == sampleLeapSeconds);
+
+    for (dopType = LE_GNSS_PDOP; dopType < LE_GNSS_DOP_LAST; dopType++)
+    {
+        le_gnss_GetDilutionOfPrecision(positionSampleRef, dopType, &dop);
+        LE_ASSERT(dop == sampleDop[dopType]);
+    }
+
+    le_gnss_GetMagneticDeviation(positionSampleRef, &magneticDeviation);
+    LE_ASSERT(magneticDeviation == sampleMagneticDeviation);
+
+    le_gnss_GetSatellitesStatus(positionSampleRef, &satsInView, &satsTracking, &satsUsed);
+    LE_ASSERT((satsInView == sampleSatsInView) && (satsTracking == sampleSatsTracking)
+              && (satsUsed == sampleSatsUsed));
+
+    // All the outputs are optional
+    LE_ASSERT_OK(le_gnss_GetSample(positionSampleRef, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                                   NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                                   NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                                   NULL, NULL, NULL, NULL, NULL));
+
+    // Pass invalid sample reference
+    LE_ASSERT(LE_FAULT == le_gnss_GetSample(GnssPositionSampleRef, &sampleState, &fieldsValid,
+                                            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                                            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                                            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                                            NULL, NULL, NULL, NULL, NULL, NULL));
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Handler function for Position Notifications.
@@ -659,6 +774,9 @@ static void GnssPositionHandlerFunction
                                         &satElevNumElements);
     LE_ASSERT((LE_OK == result) || (LE_OUT_OF_RANGE == result));
 
+    LE_INFO("======== GNSS GetSample ========");
+    Testle_gnss_GetSample(positionSampleRef);
+
     LE_INFO("======== GNSS SetGetDOPResolution ========");
     Testle_gnss_SetGetDOPResolution(positionSampleRef);
 
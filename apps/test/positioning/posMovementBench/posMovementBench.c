@@ -0,0 +1,356 @@
+/**
+ * Benchmark of the movement handlers of the positioning service.
+ *
+ * Many movement handlers, with various horizontal and vertical magnitudes, are registered with the
+ * positioning service, then the simulated GNSS reports the fixes of a vehicle driving at 15 m/s at
+ * a 10 Hz acquisition rate. For each fix, the time taken by the positioning service to notify the
+ * handlers is compared with the time taken by a linear scan of all the handlers, which is how the
+ * service used to find the handlers to notify. The linear scan is also used as a reference: every
+ * handler must be notified as many times as the linear scan finds it should be.
+ *
+ * Usage: posMovementBench [HANDLERS] [FIXES]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+
+#include <math.h>
+
+#define DEFAULT_HANDLER_COUNT   10000
+#define DEFAULT_FIX_COUNT       600
+#define MAX_HANDLERS            100000
+#define FIX_PERIOD_MS           100
+
+// Vehicle trajectory
+#define START_LATITUDE          45500000    // [resolution 1e-6 degrees]
+#define START_LONGITUDE         -73600000   // [resolution 1e-6 degrees]
+#define START_ALTITUDE          120000      // [resolution 1e-3 meters]
+#define SPEED                   15          // [meters/second]
+#define H_ACCURACY              300         // [resolution 1e-2 meters]
+#define V_ACCURACY              50          // [resolution 1e-1 meters]
+
+typedef struct
+{
+    uint32_t horizontalMagnitude;   ///< Horizontal magnitude of the handler.
+    uint32_t verticalMagnitude;     ///< Vertical magnitude of the handler.
+    int32_t  lastLat;               ///< Reference model: latitude of the last notification.
+    int32_t  lastLong;              ///< Reference model: longitude of the last notification.
+    int32_t  lastAlt;               ///< Reference model: altitude of the last notification.
+    uint32_t expectedCount;         ///< Notifications expected by the reference model.
+    uint32_t notifiedCount;         ///< Notifications received from the positioning service.
+}
+Handler_t;
+
+static Handler_t Handlers[MAX_HANDLERS];
+static size_t HandlerCount = DEFAULT_HANDLER_COUNT;
+static size_t FixCount = DEFAULT_FIX_COUNT;
+static size_t FixIndex;
+
+static int32_t Latitude = START_LATITUDE;
+static int32_t Longitude = START_LONGITUDE;
+static int32_t Altitude = START_ALTITUDE;
+
+static uint64_t StartNs;
+static uint64_t ServiceTotalNs;
+static uint64_t ServiceMaxNs;
+static uint64_t ScanTotalNs;
+static uint64_t ScanMaxNs;
+static uint64_t NotificationCount;
+
+static void ReportFix(void* param1Ptr, void* param2Ptr);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Registers a function to be called whenever one of this service's sessions is closed by
+ * the client.  (STUBBED FUNCTION)
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_SessionEventHandlerRef_t MyAddServiceCloseHandler
+(
+    le_msg_ServiceRef_t             serviceRef, ///< [in] Reference to the service.
+    le_msg_SessionEventHandler_t    handlerFunc,///< [in] Handler function.
+    void*                           contextPtr  ///< [in] Opaque pointer value to pass to handler.
+)
+{
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the monotonic time in nanoseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetNs
+(
+    void
+)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Distance in meters between two fix points, computed as the positioning service does.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t ComputeDistance
+(
+    int32_t latitude1,
+    int32_t longitude1,
+    int32_t latitude2,
+    int32_t longitude2
+)
+{
+    #define PI 3.14159265
+
+    double R = 6371; // km
+    double dLat = ((double)latitude2-(double)latitude1)/1000000.0*PI/180;
+    double dLon = ((double)longitude2-(double)longitude1)/1000000.0*PI/180;
+    double lat1 = ((double)latitude1)/1000000.0*PI/180;
+    double lat2 = ((double)latitude2)/1000000.0*PI/180;
+    double a, c;
+
+    a = sin(dLat/2) * sin(dLat/2) + sin(dLon/2) * sin(dLon/2) * cos(lat1) * cos(lat2);
+    c = 2 * atan2(sqrt(a), sqrt(1-a));
+
+    return (uint32_t)(R * c * 1000);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a move is beyond a magnitude, as the positioning service does.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsBeyondMagnitude
+(
+    uint32_t magnitude,
+    uint32_t move,
+    uint32_t accuracy
+)
+{
+    return (move > magnitude) && (accuracy <= move) && ((move - accuracy) >= magnitude);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference model: check every handler against the fix, and count the ones to notify.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ScanHandlers
+(
+    void
+)
+{
+    size_t i;
+
+    for (i = 0; i < HandlerCount; i++)
+    {
+        Handler_t* handlerPtr = &Handlers[i];
+
+        if (0 == handlerPtr->lastLat)
+        {
+            handlerPtr->lastLat = Latitude;
+        }
+        if (0 == handlerPtr->lastLong)
+        {
+            handlerPtr->lastLong = Longitude;
+        }
+        if (0 == handlerPtr->lastAlt)
+        {
+            handlerPtr->lastAlt = Altitude;
+        }
+
+        uint32_t horizontalMove = ComputeDistance(handlerPtr->lastLat, handlerPtr->lastLong,
+                                                  Latitude, Longitude);
+        uint32_t verticalMove = abs(Altitude - handlerPtr->lastAlt);
+
+        bool hflag = IsBeyondMagnitude(handlerPtr->horizontalMagnitude, horizontalMove,
+                                       H_ACCURACY / 100);
+        bool vflag = IsBeyondMagnitude(handlerPtr->verticalMagnitude, verticalMove,
+                                       V_ACCURACY / 10);
+
+        if (((0 != handlerPtr->verticalMagnitude) && (vflag)) ||
+            ((0 != handlerPtr->horizontalMagnitude) && (hflag)) ||
+            ((0 == handlerPtr->verticalMagnitude) && (0 == handlerPtr->horizontalMagnitude)))
+        {
+            handlerPtr->expectedCount++;
+            handlerPtr->lastLat = Latitude;
+            handlerPtr->lastLong = Longitude;
+            handlerPtr->lastAlt = Altitude;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Movement handler.
+ */
+//--------------------------------------------------------------------------------------------------
+static void MovementHandler
+(
+    le_pos_SampleRef_t positionSampleRef,
+    void* contextPtr
+)
+{
+    Handler_t* handlerPtr = contextPtr;
+
+    handlerPtr->notifiedCount++;
+    NotificationCount++;
+    le_pos_sample_Release(positionSampleRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print the results, and check the notifications against the reference model.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Report
+(
+    void
+)
+{
+    size_t i;
+
+    printf("%zu handlers, %zu fixes, %" PRIu64 " notifications\n",
+           HandlerCount, FixCount, NotificationCount);
+    printf("  positioning service: %.1f us per fix (max %.1f us), %.2f%% of the fix period\n",
+           ServiceTotalNs / 1000.0 / FixCount, ServiceMaxNs / 1000.0,
+           ServiceTotalNs / 1e4 / FixCount / FIX_PERIOD_MS);
+    printf("  linear scan:         %.1f us per fix (max %.1f us), %.2f%% of the fix period\n",
+           ScanTotalNs / 1000.0 / FixCount, ScanMaxNs / 1000.0,
+           ScanTotalNs / 1e4 / FixCount / FIX_PERIOD_MS);
+
+    for (i = 0; i < HandlerCount; i++)
+    {
+        if (Handlers[i].notifiedCount != Handlers[i].expectedCount)
+        {
+            LE_FATAL("Handler %zu (%u m, %u) notified %u times instead of %u", i,
+                     Handlers[i].horizontalMagnitude, Handlers[i].verticalMagnitude,
+                     Handlers[i].notifiedCount, Handlers[i].expectedCount);
+        }
+    }
+
+    LE_INFO("Notifications match the linear scan.");
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Called once the positioning service processed a fix.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FixProcessed
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    uint64_t elapsedNs = GetNs() - StartNs;
+
+    ServiceTotalNs += elapsedNs;
+    if (elapsedNs > ServiceMaxNs)
+    {
+        ServiceMaxNs = elapsedNs;
+    }
+
+    StartNs = GetNs();
+    ScanHandlers();
+    elapsedNs = GetNs() - StartNs;
+
+    ScanTotalNs += elapsedNs;
+    if (elapsedNs > ScanMaxNs)
+    {
+        ScanMaxNs = elapsedNs;
+    }
+
+    if (++FixIndex < FixCount)
+    {
+        le_event_QueueFunction(ReportFix, NULL, NULL);
+    }
+    else
+    {
+        Report();
+        exit(EXIT_SUCCESS);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move the vehicle, and report the new fix.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportFix
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    // Drive along a slowly turning path, going up and down hills.
+    double heading = FixIndex * 0.002;
+    double meters = SPEED * FIX_PERIOD_MS / 1000.0;
+    double metersPerMicroDegree = 6371000.0 * PI / 180 / 1000000.0;
+
+    Latitude += (int32_t)lround(meters * cos(heading) / metersPerMicroDegree);
+    Longitude += (int32_t)lround(meters * sin(heading) /
+                                 (metersPerMicroDegree * cos(Latitude / 1000000.0 * PI / 180)));
+    Altitude = START_ALTITUDE + (int32_t)lround(20000 * sin(FixIndex * 0.01));
+
+    gnssSimuLocation_t location = { Latitude, Longitude, H_ACCURACY, LE_OK };
+    gnssSimuAltitude_t altitude = { Altitude, V_ACCURACY, LE_OK };
+
+    le_gnssSimu_SetLocation(location);
+    le_gnssSimu_SetAltitude(altitude);
+
+    // The fix is processed before the function queued after it.
+    StartNs = GetNs();
+    le_gnssSimu_ReportEvent();
+    le_event_QueueFunction(FixProcessed, NULL, NULL);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * main of the benchmark
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    size_t i;
+
+    if (le_arg_NumArgs() >= 1)
+    {
+        HandlerCount = atoi(le_arg_GetArg(0));
+    }
+    if (le_arg_NumArgs() >= 2)
+    {
+        FixCount = atoi(le_arg_GetArg(1));
+    }
+    LE_ASSERT((HandlerCount > 0) && (HandlerCount <= MAX_HANDLERS) && (FixCount > 0));
+
+    // Mostly horizontal fences from 5 m to 2 km, some of them with a vertical magnitude as well,
+    // a few vertical only ones, and a few handlers notified on every fix.
+    srand(1);
+    for (i = 0; i < HandlerCount; i++)
+    {
+        if (999 == (i % 1000))
+        {
+            Handlers[i].horizontalMagnitude = 0;
+            Handlers[i].verticalMagnitude = 0;
+        }
+        else
+        {
+            Handlers[i].horizontalMagnitude = (4 == (i % 8)) ? 0 : 5 + (rand() % 1996);
+            Handlers[i].verticalMagnitude = (0 == (i % 4)) ? 100 + (rand() % 20000) : 0;
+        }
+
+        LE_ASSERT(NULL != le_pos_AddMovementHandler(Handlers[i].horizontalMagnitude,
+                                                    Handlers[i].verticalMagnitude,
+                                                    MovementHandler,
+                                                    &Handlers[i]));
+    }
+
+    le_event_QueueFunction(ReportFix, NULL, NULL);
+}
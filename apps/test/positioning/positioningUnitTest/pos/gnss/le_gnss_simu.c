@@ -1490,6 +1490,150 @@ le_result_t le_gnss_GetMagneticDeviation
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set an output parameter of le_gnss_GetSample() and flag it in the valid fields' bit mask if it
+ * is not set to its invalid value.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SET_SAMPLE_FIELD(_outPtr_, _value_, _invalidValue_, _fieldBit_, _fieldsValid_) \
+    do                                                                                \
+    {                                                                                 \
+        if ((_value_) != (_invalidValue_))                                            \
+        {                                                                             \
+            (_fieldsValid_) |= (_fieldBit_);                                          \
+        }                                                                             \
+        if (NULL != (_outPtr_))                                                       \
+        {                                                                             \
+            *(_outPtr_) = (_value_);                                                  \
+        }                                                                             \
+    } while (0)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get all the information of a position sample at once.
+ *
+ * @return
+ *  - LE_FAULT         Function failed to find the positionSample.
+ *  - LE_OK            Function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_gnss_GetSample
+(
+    le_gnss_SampleRef_t positionSampleRef,  ///< [IN] Position sample's reference.
+    le_gnss_FixState_t* statePtr,           ///< [OUT] Position fix state.
+    le_gnss_SampleField_t* fieldsValidPtr,  ///< [OUT] Bit mask of the valid fields.
+    int32_t* latitudePtr,                   ///< [OUT] WGS84 Latitude [resolution 1e-6].
+    int32_t* longitudePtr,                  ///< [OUT] WGS84 Longitude [resolution 1e-6].
+    int32_t* hAccuracyPtr,                  ///< [OUT] Horizontal position's accuracy.
+    int32_t* altitudePtr,                   ///< [OUT] Altitude [resolution 1e-3].
+    int32_t* vAccuracyPtr,                  ///< [OUT] Vertical position's accuracy.
+    int32_t* altitudeOnWgs84Ptr,            ///< [OUT] Altitude on WGS-84 [resolution 1e-3].
+    uint32_t* hSpeedPtr,                    ///< [OUT] Horizontal speed [resolution 1e-2].
+    uint32_t* hSpeedAccuracyPtr,            ///< [OUT] Horizontal speed's accuracy.
+    int32_t* vSpeedPtr,                     ///< [OUT] Vertical speed [resolution 1e-2].
+    int32_t* vSpeedAccuracyPtr,             ///< [OUT] Vertical speed's accuracy.
+    uint32_t* directionPtr,                 ///< [OUT] Direction [resolution 1e-1].
+    uint32_t* directionAccuracyPtr,         ///< [OUT] Direction's accuracy [resolution 1e-1].
+    uint16_t* yearPtr,                      ///< [OUT] UTC Year A.D.
+    uint16_t* monthPtr,                     ///< [OUT] UTC Month into the year.
+    uint16_t* dayPtr,                       ///< [OUT] UTC Days into the month.
+    uint16_t* hoursPtr,                     ///< [OUT] UTC Hours into the day.
+    uint16_t* minutesPtr,                   ///< [OUT] UTC Minutes into the hour.
+    uint16_t* secondsPtr,                   ///< [OUT] UTC Seconds into the minute.
+    uint16_t* millisecondsPtr,              ///< [OUT] UTC Milliseconds into the second.
+    uint64_t* epochTimePtr,                 ///< [OUT] Milliseconds since Jan. 1, 1970.
+    uint32_t* gpsWeekPtr,                   ///< [OUT] GPS week number.
+    uint32_t* gpsTimeOfWeekPtr,             ///< [OUT] Milliseconds into the GPS week.
+    uint32_t* timeAccuracyPtr,              ///< [OUT] Time accuracy in nanoseconds.
+    uint8_t* leapSecondsPtr,                ///< [OUT] UTC leap seconds in advance.
+    uint16_t* dopPtr,                       ///< [OUT] Dilutions of Precision.
+    size_t* dopSizePtr,                     ///< [INOUT] Number of Dilutions of Precision.
+    int32_t* magneticDeviationPtr,          ///< [OUT] Magnetic deviation [resolution 1e-1].
+    uint8_t* satsInViewCountPtr,            ///< [OUT] Number of satellites in view.
+    uint8_t* satsTrackingCountPtr,          ///< [OUT] Number of satellites tracking.
+    uint8_t* satsUsedCountPtr               ///< [OUT] Number of satellites used.
+)
+{
+    le_gnss_SampleField_t fieldsValid = 0;
+    bool dateValid = (LE_OK == GnssDate.result);
+    bool timeValid = (LE_OK == GnssTime.result);
+
+    if (statePtr)
+    {
+        *statePtr = (LE_OK == GnssSimuPositionSate.result) ? GnssSimuPositionSate.state
+                                                           : LE_GNSS_STATE_FIX_NO_POS;
+    }
+
+    SET_SAMPLE_FIELD(latitudePtr, GnssLocation.latitude,
+                     INT32_MAX, LE_GNSS_SAMPLE_LATITUDE, fieldsValid);
+    SET_SAMPLE_FIELD(longitudePtr, GnssLocation.longitude,
+                     INT32_MAX, LE_GNSS_SAMPLE_LONGITUDE, fieldsValid);
+    SET_SAMPLE_FIELD(hAccuracyPtr, GnssLocation.accuracy,
+                     INT32_MAX, LE_GNSS_SAMPLE_H_ACCURACY, fieldsValid);
+    SET_SAMPLE_FIELD(altitudePtr, GnssAltitude.altitude,
+                     INT32_MAX, LE_GNSS_SAMPLE_ALTITUDE, fieldsValid);
+    SET_SAMPLE_FIELD(vAccuracyPtr, GnssAltitude.accuracy,
+                     INT32_MAX, LE_GNSS_SAMPLE_V_ACCURACY, fieldsValid);
+    SET_SAMPLE_FIELD(altitudeOnWgs84Ptr, INT32_MAX,
+                     INT32_MAX, LE_GNSS_SAMPLE_ALTITUDE_ON_WGS84, fieldsValid);
+    SET_SAMPLE_FIELD(hSpeedPtr, GnssHSpeed.speed,
+                     UINT32_MAX, LE_GNSS_SAMPLE_H_SPEED, fieldsValid);
+    SET_SAMPLE_FIELD(hSpeedAccuracyPtr, GnssHSpeed.accuracy,
+                     UINT32_MAX, LE_GNSS_SAMPLE_H_SPEED_ACCURACY, fieldsValid);
+    SET_SAMPLE_FIELD(vSpeedPtr, GnssVSpeed.speed,
+                     INT32_MAX, LE_GNSS_SAMPLE_V_SPEED, fieldsValid);
+    SET_SAMPLE_FIELD(vSpeedAccuracyPtr, GnssVSpeed.accuracy,
+                     INT32_MAX, LE_GNSS_SAMPLE_V_SPEED_ACCURACY, fieldsValid);
+    SET_SAMPLE_FIELD(directionPtr, GnssDirection.direction,
+                     UINT32_MAX, LE_GNSS_SAMPLE_DIRECTION, fieldsValid);
+    SET_SAMPLE_FIELD(directionAccuracyPtr, GnssDirection.accuracy,
+                     UINT32_MAX, LE_GNSS_SAMPLE_DIRECTION_ACCURACY, fieldsValid);
+
+    SET_SAMPLE_FIELD(yearPtr, dateValid ? GnssDate.year : 0, 0, LE_GNSS_SAMPLE_DATE, fieldsValid);
+    SET_SAMPLE_FIELD(monthPtr, dateValid ? GnssDate.month : 0, 0, LE_GNSS_SAMPLE_DATE, fieldsValid);
+    SET_SAMPLE_FIELD(dayPtr, dateValid ? GnssDate.day : 0, 0, LE_GNSS_SAMPLE_DATE, fieldsValid);
+    if (timeValid)
+    {
+        fieldsValid |= LE_GNSS_SAMPLE_TIME;
+    }
+    SET_SAMPLE_FIELD(hoursPtr, timeValid ? GnssTime.hrs : 0, 0, 0, fieldsValid);
+    SET_SAMPLE_FIELD(minutesPtr, timeValid ? GnssTime.min : 0, 0, 0, fieldsValid);
+    SET_SAMPLE_FIELD(secondsPtr, timeValid ? GnssTime.sec : 0, 0, 0, fieldsValid);
+    SET_SAMPLE_FIELD(millisecondsPtr, timeValid ? GnssTime.msec : 0, 0, 0, fieldsValid);
+    SET_SAMPLE_FIELD(epochTimePtr, 0, 0, 0, fieldsValid);
+    SET_SAMPLE_FIELD(gpsWeekPtr, 0, 0, 0, fieldsValid);
+    SET_SAMPLE_FIELD(gpsTimeOfWeekPtr, 0, 0, 0, fieldsValid);
+    SET_SAMPLE_FIELD(timeAccuracyPtr, UINT16_MAX, UINT16_MAX, 0, fieldsValid);
+    SET_SAMPLE_FIELD(leapSecondsPtr, UINT8_MAX, UINT8_MAX, 0, fieldsValid);
+
+    if ((dopPtr) && (dopSizePtr))
+    {
+        size_t i;
+
+        if (*dopSizePtr > LE_GNSS_DOP_MAX_LEN)
+        {
+            *dopSizePtr = LE_GNSS_DOP_MAX_LEN;
+        }
+        for (i = 0; i < *dopSizePtr; i++)
+        {
+            dopPtr[i] = UINT16_MAX;
+        }
+    }
+
+    SET_SAMPLE_FIELD(magneticDeviationPtr, INT32_MAX, INT32_MAX, 0, fieldsValid);
+    SET_SAMPLE_FIELD(satsInViewCountPtr, UINT8_MAX, UINT8_MAX, 0, fieldsValid);
+    SET_SAMPLE_FIELD(satsTrackingCountPtr, UINT8_MAX, UINT8_MAX, 0, fieldsValid);
+    SET_SAMPLE_FIELD(satsUsedCountPtr, UINT8_MAX, UINT8_MAX, 0, fieldsValid);
+
+    if (fieldsValidPtr)
+    {
+        *fieldsValidPtr = fieldsValid;
+    }
+
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function gets the last updated position sample object reference.
@@ -591,6 +591,43 @@ le_result_t le_gnss_GetMagneticDeviation
         ///< [OUT] MagneticDeviation in degrees [resolution 1e-1].
 );
 
+le_result_t le_gnss_GetSample
+(
+    le_gnss_SampleRef_t positionSampleRef,  ///< [IN] Position sample's reference.
+    le_gnss_FixState_t* statePtr,           ///< [OUT] Position fix state.
+    le_gnss_SampleField_t* fieldsValidPtr,  ///< [OUT] Bit mask of the valid fields.
+    int32_t* latitudePtr,                   ///< [OUT] WGS84 Latitude [resolution 1e-6].
+    int32_t* longitudePtr,                  ///< [OUT] WGS84 Longitude [resolution 1e-6].
+    int32_t* hAccuracyPtr,                  ///< [OUT] Horizontal position's accuracy.
+    int32_t* altitudePtr,                   ///< [OUT] Altitude [resolution 1e-3].
+    int32_t* vAccuracyPtr,                  ///< [OUT] Vertical position's accuracy.
+    int32_t* altitudeOnWgs84Ptr,            ///< [OUT] Altitude on WGS-84 [resolution 1e-3].
+    uint32_t* hSpeedPtr,                    ///< [OUT] Horizontal speed [resolution 1e-2].
+    uint32_t* hSpeedAccuracyPtr,            ///< [OUT] Horizontal speed's accuracy.
+    int32_t* vSpeedPtr,                     ///< [OUT] Vertical speed [resolution 1e-2].
+    int32_t* vSpeedAccuracyPtr,             ///< [OUT] Vertical speed's accuracy.
+    uint32_t* directionPtr,                 ///< [OUT] Direction [resolution 1e-1].
+    uint32_t* directionAccuracyPtr,         ///< [OUT] Direction's accuracy [resolution 1e-1].
+    uint16_t* yearPtr,                      ///< [OUT] UTC Year A.D.
+    uint16_t* monthPtr,                     ///< [OUT] UTC Month into the year.
+    uint16_t* dayPtr,                       ///< [OUT] UTC Days into the month.
+    uint16_t* hoursPtr,                     ///< [OUT] UTC Hours into the day.
+    uint16_t* minutesPtr,                   ///< [OUT] UTC Minutes into the hour.
+    uint16_t* secondsPtr,                   ///< [OUT] UTC Seconds into the minute.
+    uint16_t* millisecondsPtr,              ///< [OUT] UTC Milliseconds into the second.
+    uint64_t* epochTimePtr,                 ///< [OUT] Milliseconds since Jan. 1, 1970.
+    uint32_t* gpsWeekPtr,                   ///< [OUT] GPS week number.
+    uint32_t* gpsTimeOfWeekPtr,             ///< [OUT] Milliseconds into the GPS week.
+    uint32_t* timeAccuracyPtr,              ///< [OUT] Time accuracy in nanoseconds.
+    uint8_t* leapSecondsPtr,                ///< [OUT] UTC leap seconds in advance.
+    uint16_t* dopPtr,                       ///< [OUT] Dilutions of Precision.
+    size_t* dopSizePtr,                     ///< [INOUT] Number of Dilutions of Precision.
+    int32_t* magneticDeviationPtr,          ///< [OUT] Magnetic deviation [resolution 1e-1].
+    uint8_t* satsInViewCountPtr,            ///< [OUT] Number of satellites in view.
+    uint8_t* satsTrackingCountPtr,          ///< [OUT] Number of satellites tracking.
+    uint8_t* satsUsedCountPtr               ///< [OUT] Number of satellites used.
+);
+
 le_gnss_SampleRef_t le_gnss_GetLastSampleRef
 (
     void
@@ -2,6 +2,10 @@
  *
  * Implementation of AT commands server API.
  *
+ * The command lines are tokenized by runs of characters: see CopyCmdChars(), ScanCmdName() and
+ * ParseParam().  When LE_ATSERVER_CHAR_PARSER is defined, they are tokenized one character at a
+ * time instead.  atServerParserTest checks both ways give the same responses.
+ *
  * Copyright (C) Sierra Wireless Inc.
  */
 
@@ -146,6 +150,28 @@
                                     IS_HEXA(X) || \
                                     IS_BETWEEN_A_AND_F(X) )
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Character classes of the AT parser, as bits of the CharClass table entries.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CHAR_CLASS_BASIC        0x01    ///< Character starting a basic syntax command
+#define CHAR_CLASS_PARAM        0x02    ///< Character expected as a parameter
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Is character of the given class ?
+ */
+//--------------------------------------------------------------------------------------------------
+#define IS_CHAR_CLASS(X, CLASS) (CharClass[(uint8_t)(X)] & (CLASS))
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Characters ending the name of a command: '=', '?', ',' and ';'.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CMD_NAME_END_CHARS      "=?,;"
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Text prompt definition.
@@ -188,6 +214,13 @@
 //--------------------------------------------------------------------------------------------------
 #define BACKSPACE           0x08
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * ASCII delete code, used as backspace in command lines.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DELETE              0x7f
+
 //--------------------------------------------------------------------------------------------------
 /**
  * The timer interval to kick the watchdog chain.
@@ -279,6 +312,13 @@ static le_hashmap_Ref_t   CmdHashMap;
 //--------------------------------------------------------------------------------------------------
 static ErrorCodesMode_t ErrorCodesMode = MODE_DISABLED;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Classes of the characters for the AT parser (CHAR_CLASS_xxx bits), indexed by character
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t CharClass[UINT8_MAX + 1];
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Pre-formatted strings corresponding to AT commands +CME error codes
@@ -1762,18 +1802,54 @@ static le_result_t ParseParam
             // If "bridge command", keep the quote
             if ((cmdParserPtr->currentCmdPtr)->bridgeCmd)
             {
+                if (index >= (sizeof(paramPtr->param) - 1))
+                {
+                    LE_ERROR("Parameter too long");
+                    le_mem_Release(paramPtr);
+                    return LE_FAULT;
+                }
                 paramPtr->param[index++] = *cmdParserPtr->currentCharPtr;
             }
+
+#ifndef LE_ATSERVER_CHAR_PARSER
+            if (tokenQuote)
+            {
+                // Copy the quoted string up to the closing quote at once
+                char* startPtr = cmdParserPtr->currentCharPtr + 1;
+                char* endPtr = memchr(startPtr, '"', cmdParserPtr->lastCharPtr + 1 - startPtr);
+                size_t len = (endPtr ? endPtr : cmdParserPtr->lastCharPtr + 1) - startPtr;
+
+                if ((index + len) >= sizeof(paramPtr->param))
+                {
+                    LE_ERROR("Parameter too long");
+                    le_mem_Release(paramPtr);
+                    return LE_FAULT;
+                }
+                memcpy(paramPtr->param + index, startPtr, len);
+                index += len;
+                cmdParserPtr->currentCharPtr += len;
+            }
+#endif
         }
-        else
+#ifdef LE_ATSERVER_CHAR_PARSER
+        else if (tokenQuote)
         {
-            if (!tokenQuote)
+            if (index >= (sizeof(paramPtr->param) - 1))
             {
-                // Put character in upper case
-                *cmdParserPtr->currentCharPtr = toupper(*cmdParserPtr->currentCharPtr);
+                LE_ERROR("Parameter too long");
+                le_mem_Release(paramPtr);
+                return LE_FAULT;
             }
+            paramPtr->param[index++] = *cmdParserPtr->currentCharPtr;
+        }
+#endif
+        else
+        {
+            // Put character in upper case
+            *cmdParserPtr->currentCharPtr = toupper(*cmdParserPtr->currentCharPtr);
 
-            if ((tokenQuote) || ( IS_PARAM_CHAR(*cmdParserPtr->currentCharPtr) ))
+            if (( index < (sizeof(paramPtr->param) - 1) ) &&
+                ( IS_CHAR_CLASS(*cmdParserPtr->currentCharPtr, CHAR_CLASS_PARAM) ))
             {
                 paramPtr->param[index++] = *cmdParserPtr->currentCharPtr;
             }
@@ -1874,6 +1950,51 @@ static le_result_t ParseSemicolon
     return LE_OK;
 }
 
+#ifndef LE_ATSERVER_CHAR_PARSER
+//--------------------------------------------------------------------------------------------------
+/**
+ * Skip the characters of a command name up to the next '=', '?', ',' or ';', putting them in upper
+ * case.  This replays the ParseContinue() transitions the parser automaton would do one character
+ * at a time, so the characters which may change its state (3rd character of a basic command, last
+ * character of the line) are left to it.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void ScanCmdName
+(
+    CmdParser_t* cmdParserPtr
+)
+{
+    char* charPtr = cmdParserPtr->currentCharPtr;
+    char* basicPtr = cmdParserPtr->currentAtCmdPtr + 2;
+    char* endPtr = charPtr + strcspn(charPtr, CMD_NAME_END_CHARS);
+
+    LE_ASSERT(CmdParserTab[cmdParserPtr->lastCmdParserState][PARSE_CMDNAME] == ParseContinue);
+
+    if (endPtr > cmdParserPtr->lastCharPtr)
+    {
+        endPtr = cmdParserPtr->lastCharPtr;
+    }
+    if ((charPtr <= basicPtr) && (basicPtr < endPtr) &&
+        (IS_CHAR_CLASS(*basicPtr, CHAR_CLASS_BASIC)))
+    {
+        endPtr = basicPtr;
+    }
+    if (charPtr >= endPtr)
+    {
+        return;
+    }
+
+    for (; charPtr < endPtr; charPtr++)
+    {
+        *charPtr = toupper(*charPtr);
+    }
+
+    cmdParserPtr->currentCharPtr = endPtr;
+    cmdParserPtr->lastCmdParserState = PARSE_CMDNAME;
+}
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  * AT parser main function
@@ -1909,6 +2030,20 @@ static void ParseAtCmd
     while (( cmdParserPtr->cmdParser != PARSE_SEMICOLON ) &&
            ( cmdParserPtr->cmdParser != PARSE_LAST ))
     {
+#ifndef LE_ATSERVER_CHAR_PARSER
+        // Command name not resolved yet: skip it up to the next token at once, from the states
+        // which CmdParserTab goes on with ParseContinue() for a command name character
+        if (( cmdParserPtr->cmdParser == PARSE_CMDNAME ) &&
+            ( cmdParserPtr->currentCmdPtr == NULL ) &&
+            (( cmdParserPtr->lastCmdParserState == PARSE_CMDNAME ) ||
+             ( cmdParserPtr->lastCmdParserState == PARSE_SEMICOLON ) ||
+             ( cmdParserPtr->lastCmdParserState == PARSE_BASIC ) ||
+             ( cmdParserPtr->lastCmdParserState == PARSE_LAST )))
+        {
+            ScanCmdName(cmdParserPtr);
+        }
+#endif
+
         switch (*cmdParserPtr->currentCharPtr)
         {
             case AT_TOKEN_EQUAL:
@@ -1953,7 +2088,7 @@ static void ParseAtCmd
                 }
 
                 if ((cmdParserPtr->currentCharPtr - cmdParserPtr->currentAtCmdPtr == 2) &&
-                    (IS_BASIC(*cmdParserPtr->currentCharPtr)))
+                    (IS_CHAR_CLASS(*cmdParserPtr->currentCharPtr, CHAR_CLASS_BASIC)))
                 {
                     // 3rd char of the command is into [A-Z] => basic command
                     cmdParserPtr->cmdParser = PARSE_BASIC;
@@ -2066,6 +2201,45 @@ sendErrorRsp:
     SendFinalRsp(devPtr);
 }
 
+#ifndef LE_ATSERVER_CHAR_PARSER
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy the received characters of a command line up to the next CR or delete character at once.
+ *
+ * @return Index of the first character not copied.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t CopyCmdChars
+(
+    DeviceContext_t* devPtr,
+    uint32_t index              ///< [IN] Index of the first character to copy
+)
+{
+    char* startPtr = devPtr->currentCmd + index;
+    uint32_t len = devPtr->indexRead - index;
+    char* endPtr = memchr(startPtr, AT_TOKEN_CR, len);
+
+    if (endPtr)
+    {
+        len = endPtr - startPtr;
+    }
+
+    endPtr = memchr(startPtr, DELETE, len);
+    if (endPtr)
+    {
+        len = endPtr - startPtr;
+    }
+
+    if (len && (devPtr->parseIndex != index))
+    {
+        memmove(devPtr->currentCmd + devPtr->parseIndex, startPtr, len);
+    }
+    devPtr->parseIndex += len;
+
+    return index + len;
+}
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Parser incoming characters
@@ -2081,6 +2255,17 @@ static void ParseBuffer
 
     for (i = devPtr->parseIndex; i < devPtr->indexRead; i++)
     {
+#ifndef LE_ATSERVER_CHAR_PARSER
+        if (devPtr->cmdParser.rxState == PARSER_SEARCH_CR)
+        {
+            i = CopyCmdChars(devPtr, i);
+            if (i >= devPtr->indexRead)
+            {
+                break;
+            }
+        }
+#endif
+
         char input = devPtr->currentCmd[i];
 
         switch (devPtr->cmdParser.rxState)
@@ -2149,7 +2334,7 @@ static void ParseBuffer
                     devPtr->parseIndex=0;
                 }
                 // backspace character
-                else if ( input == 0x7F )
+                else if ( input == DELETE )
                 {
                     devPtr->parseIndex--;
                 }
@@ -3834,6 +4019,34 @@ le_result_t le_atServer_GetTextAsync
     return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the character classes table of the AT parser
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void InitCharClass
+(
+    void
+)
+{
+    int c;
+
+    for (c = 0; c <= UINT8_MAX; c++)
+    {
+        CharClass[c] = 0;
+
+        if (IS_BASIC(c))
+        {
+            CharClass[c] |= CHAR_CLASS_BASIC;
+        }
+        if (IS_PARAM_CHAR(c))
+        {
+            CharClass[c] |= CHAR_CLASS_PARAM;
+        }
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * The COMPONENT_INIT intialize the AT Server Component when Legato start
@@ -3842,6 +4055,8 @@ le_result_t le_atServer_GetTextAsync
 //--------------------------------------------------------------------------------------------------
 COMPONENT_INIT
 {
+    InitCharClass();
+
     // Device pool allocation
     DevicesPool = le_mem_CreatePool("ATServerDevicesPool",sizeof(DeviceContext_t));
     le_mem_ExpandPool(DevicesPool,DEVICE_POOL_SIZE);
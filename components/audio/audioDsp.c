@@ -0,0 +1,422 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file audioDsp.c
+ *
+ * Signal processing kernels used by the media threads of the audio service.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "audioDsp.h"
+#include <math.h>
+
+//--------------------------------------------------------------------------------------------------
+// Symbol and Enum definitions.
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of samples generated between two settings of the tone oscillators from the exact phase.
+ * Must be a multiple of AUDIODSP_TONE_LANES.
+ */
+//--------------------------------------------------------------------------------------------------
+#define TONE_BLOCK_SAMPLES      256
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Limits of a signed 16-bit sample.
+ */
+//--------------------------------------------------------------------------------------------------
+#define S16_MAX                 32767
+#define S16_MIN                 (-32768)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Saturate a 32-bit value to 16 bits.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline int16_t Saturate16
+(
+    int32_t value
+)
+{
+    value = (value > S16_MAX) ? S16_MAX : value;
+    value = (value < S16_MIN) ? S16_MIN : value;
+
+    return (int16_t)value;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Generate a block of a tone, and move the generator after it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GenerateToneBlock
+(
+    audioDsp_Tone_t* tonePtr,                   ///< [IN/OUT] Tone generator.
+    float* outPtr,                              ///< [OUT] Samples, TONE_BLOCK_SAMPLES long.
+    size_t count                                ///< [IN] Number of samples, at most
+                                                ///< TONE_BLOCK_SAMPLES.
+)
+{
+    float current[AUDIODSP_TONE_LANES];
+    float previous[AUDIODSP_TONE_LANES];
+    size_t lane;
+    size_t i;
+
+    // Lane k computes the samples index + k + n * AUDIODSP_TONE_LANES.
+    for (lane = 0; lane < AUDIODSP_TONE_LANES; lane++)
+    {
+        double phase = tonePtr->step * ((double)tonePtr->index + lane);
+
+        current[lane] = tonePtr->amplitude * (float)sin(phase);
+        previous[lane] = tonePtr->amplitude *
+                         (float)sin(phase - tonePtr->step * AUDIODSP_TONE_LANES);
+    }
+
+    // The block is rounded up to a whole number of samples per lane; the buffer is large enough.
+    for (i = 0; i < count; i += AUDIODSP_TONE_LANES)
+    {
+        for (lane = 0; lane < AUDIODSP_TONE_LANES; lane++)
+        {
+            float next = tonePtr->coef * current[lane] - previous[lane];
+
+            outPtr[i + lane] = current[lane];
+            previous[lane] = current[lane];
+            current[lane] = next;
+        }
+    }
+
+    tonePtr->index += count;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a tone generator.  The first generated sample is the sample of phase 0.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_InitTone
+(
+    audioDsp_Tone_t* tonePtr,   ///< [OUT] Tone generator.
+    uint32_t frequency,         ///< [IN] Frequency of the tone, in Hertz.
+    uint32_t sampleRate,        ///< [IN] Sample rate, in Hertz.
+    int16_t amplitude           ///< [IN] Peak amplitude.
+)
+{
+    LE_ASSERT(tonePtr != NULL);
+    LE_ASSERT(sampleRate > 0);
+
+    tonePtr->step = 2 * M_PI * frequency / sampleRate;
+    tonePtr->amplitude = amplitude;
+    tonePtr->coef = (float)(2 * cos(tonePtr->step * AUDIODSP_TONE_LANES));
+    tonePtr->index = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move a tone generator to a sample, so that it is the next one generated.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_SeekTone
+(
+    audioDsp_Tone_t* tonePtr,   ///< [IN/OUT] Tone generator.
+    uint32_t index              ///< [IN] Index of the sample, counting from phase 0.
+)
+{
+    LE_ASSERT(tonePtr != NULL);
+
+    tonePtr->index = index;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Generate the sum of two tones, saturated to 16 bits, e.g. a DTMF.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_GenerateDualTone
+(
+    audioDsp_Tone_t* tone1Ptr,  ///< [IN/OUT] First tone generator.
+    audioDsp_Tone_t* tone2Ptr,  ///< [IN/OUT] Second tone generator.
+    int16_t* outPtr,            ///< [OUT] Samples.
+    size_t count                ///< [IN] Number of samples.
+)
+{
+    float tone1[TONE_BLOCK_SAMPLES];
+    float tone2[TONE_BLOCK_SAMPLES];
+
+    LE_ASSERT((tone1Ptr != NULL) && (tone2Ptr != NULL) && (outPtr != NULL));
+
+    while (count > 0)
+    {
+        size_t blockCount = (count < TONE_BLOCK_SAMPLES) ? count : TONE_BLOCK_SAMPLES;
+        size_t i;
+
+        GenerateToneBlock(tone1Ptr, tone1, blockCount);
+        GenerateToneBlock(tone2Ptr, tone2, blockCount);
+
+        for (i = 0; i < blockCount; i++)
+        {
+            float sample = tone1[i] + tone2[i];
+
+            sample = (sample > S16_MAX) ? S16_MAX : sample;
+            sample = (sample < S16_MIN) ? S16_MIN : sample;
+            outPtr[i] = (int16_t)sample;
+        }
+
+        outPtr += blockCount;
+        count -= blockCount;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mix samples into a buffer, with saturation.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_Mix
+(
+    int16_t* dstPtr,            ///< [IN/OUT] Samples to mix into.
+    const int16_t* srcPtr,      ///< [IN] Samples to mix.
+    size_t count                ///< [IN] Number of samples.
+)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        dstPtr[i] = Saturate16((int32_t)dstPtr[i] + srcPtr[i]);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Apply a gain to samples in place, with saturation.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_ApplyGain
+(
+    int16_t* bufPtr,            ///< [IN/OUT] Samples.
+    size_t count,               ///< [IN] Number of samples.
+    uint16_t gain               ///< [IN] Gain in Q12 (AUDIODSP_GAIN_UNITY is a gain of 1).
+)
+{
+    size_t i;
+
+    // |sample * gain| < 2^15 * 2^16, so the product fits in 32 bits.
+    for (i = 0; i < count; i++)
+    {
+        bufPtr[i] = Saturate16(((int32_t)bufPtr[i] * gain) >> 12);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert mono samples to interleaved stereo samples.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_MonoToStereo
+(
+    const int16_t* inPtr,       ///< [IN] Mono samples.
+    int16_t* outPtr,            ///< [OUT] Stereo samples, 2 * frameCount long.
+    size_t frameCount           ///< [IN] Number of frames.
+)
+{
+    size_t i;
+
+    for (i = 0; i < frameCount; i++)
+    {
+        outPtr[2 * i] = inPtr[i];
+        outPtr[2 * i + 1] = inPtr[i];
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert interleaved stereo samples to mono samples, by averaging the channels.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_StereoToMono
+(
+    const int16_t* inPtr,       ///< [IN] Stereo samples, 2 * frameCount long.
+    int16_t* outPtr,            ///< [OUT] Mono samples.
+    size_t frameCount           ///< [IN] Number of frames.
+)
+{
+    size_t i;
+
+    for (i = 0; i < frameCount; i++)
+    {
+        outPtr[i] = (int16_t)(((int32_t)inPtr[2 * i] + inPtr[2 * i + 1]) >> 1);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a sample rate converter.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_InitResampler
+(
+    audioDsp_Resampler_t* resamplerPtr,     ///< [OUT] Sample rate converter.
+    uint32_t inRate,                        ///< [IN] Input sample rate, in Hertz.
+    uint32_t outRate                        ///< [IN] Output sample rate, in Hertz.
+)
+{
+    LE_ASSERT(resamplerPtr != NULL);
+    LE_ASSERT((inRate > 0) && (outRate > 0));
+
+    resamplerPtr->step = (uint32_t)(((uint64_t)inRate << 16) / outRate);
+    // The first output sample is the first input sample.
+    resamplerPtr->position = 1 << 16;
+    resamplerPtr->last = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert a block of a mono stream to another sample rate.  The blocks of a stream must be
+ * converted in order, with the same converter.
+ *
+ * @return
+ *      Number of output samples, at most outMax.  The input samples that don't fit in the output
+ *      buffer are dropped.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t audioDsp_Resample
+(
+    audioDsp_Resampler_t* resamplerPtr,     ///< [IN/OUT] Sample rate converter.
+    const int16_t* inPtr,                   ///< [IN] Input samples.
+    size_t inCount,                         ///< [IN] Number of input samples.
+    int16_t* outPtr,                        ///< [OUT] Output samples.
+    size_t outMax                           ///< [IN] Size of the output buffer, in samples.
+)
+{
+    uint64_t position = resamplerPtr->position;
+    uint64_t end = (uint64_t)inCount << 16;
+    size_t outCount = 0;
+
+    if (0 == inCount)
+    {
+        return 0;
+    }
+
+    // The integer part of the position is the index of the sample after the output sample, in
+    // the block preceded by the last sample of the previous block.
+    while ((position < end) && (outCount < outMax))
+    {
+        size_t index = position >> 16;
+        int32_t frac = position & 0xFFFF;
+        int32_t before = (index > 0) ? inPtr[index - 1] : resamplerPtr->last;
+        int32_t after = inPtr[index];
+
+        outPtr[outCount++] = (int16_t)(before + (((after - before) * frac) >> 16));
+        position += resamplerPtr->step;
+    }
+
+    resamplerPtr->position = (position > end) ? (uint32_t)(position - end) : 0;
+    resamplerPtr->last = inPtr[inCount - 1];
+
+    return outCount;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert unsigned 8-bit samples to signed 16-bit samples.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_U8ToS16
+(
+    const uint8_t* inPtr,       ///< [IN] Unsigned 8-bit samples.
+    int16_t* outPtr,            ///< [OUT] Signed 16-bit samples.
+    size_t count                ///< [IN] Number of samples.
+)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        outPtr[i] = (int16_t)(((int32_t)inPtr[i] - 128) * 256);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert signed 16-bit samples to unsigned 8-bit samples.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_S16ToU8
+(
+    const int16_t* inPtr,       ///< [IN] Signed 16-bit samples.
+    uint8_t* outPtr,            ///< [OUT] Unsigned 8-bit samples.
+    size_t count                ///< [IN] Number of samples.
+)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        outPtr[i] = (uint8_t)((inPtr[i] >> 8) + 128);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert packed little-endian signed 24-bit samples to signed 16-bit samples.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_S24ToS16
+(
+    const uint8_t* inPtr,       ///< [IN] Signed 24-bit samples, 3 bytes each.
+    int16_t* outPtr,            ///< [OUT] Signed 16-bit samples.
+    size_t count                ///< [IN] Number of samples.
+)
+{
+    size_t i;
+
+    // Keep the 16 most significant bits.
+    for (i = 0; i < count; i++)
+    {
+        outPtr[i] = (int16_t)(inPtr[3 * i + 1] | (inPtr[3 * i + 2] << 8));
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert signed 32-bit samples to signed 16-bit samples.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_S32ToS16
+(
+    const int32_t* inPtr,       ///< [IN] Signed 32-bit samples.
+    int16_t* outPtr,            ///< [OUT] Signed 16-bit samples.
+    size_t count                ///< [IN] Number of samples.
+)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        outPtr[i] = (int16_t)(inPtr[i] >> 16);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert signed 16-bit samples to signed 32-bit samples.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_S16ToS32
+(
+    const int16_t* inPtr,       ///< [IN] Signed 16-bit samples.
+    int32_t* outPtr,            ///< [OUT] Signed 32-bit samples.
+    size_t count                ///< [IN] Number of samples.
+)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        outPtr[i] = (int32_t)inPtr[i] * 65536;
+    }
+}
@@ -0,0 +1,244 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file audioDsp.h
+ *
+ * Signal processing kernels used by the media threads of the audio service: tone generation,
+ * mixing, gain, channel and sample rate conversion, and PCM format conversion.
+ *
+ * The kernels work on blocks of samples with simple loops without branches in their bodies, so
+ * that the compiler can vectorize them.  Unless stated otherwise, the samples are signed 16-bit
+ * integers in the native byte order, and the input and output buffers must not overlap.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_AUDIO_DSP_INCLUDE_GUARD
+#define LEGATO_AUDIO_DSP_INCLUDE_GUARD
+
+#include "legato.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of interleaved oscillators used to generate a tone.  Each one computes every
+ * AUDIODSP_TONE_LANES-th sample, so that consecutive samples are computed independently.
+ */
+//--------------------------------------------------------------------------------------------------
+#define AUDIODSP_TONE_LANES     8
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gain of 1 in the Q12 fixed point format used by audioDsp_ApplyGain().
+ */
+//--------------------------------------------------------------------------------------------------
+#define AUDIODSP_GAIN_UNITY     4096
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sine tone generator.
+ *
+ * The tone is computed by recursive oscillators, y[n] = 2cos(w) * y[n-1] - y[n-2], instead of a
+ * call to sin() per sample.  The oscillators are set again from the exact phase every block of
+ * samples, so that the rounding errors don't build up.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    double   step;                              ///< Phase increment per sample, in radians.
+    float    amplitude;                         ///< Peak amplitude.
+    float    coef;                              ///< 2cos(step * AUDIODSP_TONE_LANES).
+    uint32_t index;                             ///< Index of the next sample.
+}
+audioDsp_Tone_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Linear interpolating sample rate converter, for a mono stream.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t step;                              ///< Input samples per output sample, in Q16.
+    uint32_t position;                          ///< Position of the next output sample, in Q16,
+                                                ///< from the last sample of the previous block.
+    int16_t  last;                              ///< Last sample of the previous block.
+}
+audioDsp_Resampler_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a tone generator.  The first generated sample is the sample of phase 0.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_InitTone
+(
+    audioDsp_Tone_t* tonePtr,   ///< [OUT] Tone generator.
+    uint32_t frequency,         ///< [IN] Frequency of the tone, in Hertz.
+    uint32_t sampleRate,        ///< [IN] Sample rate, in Hertz.
+    int16_t amplitude           ///< [IN] Peak amplitude.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move a tone generator to a sample, so that it is the next one generated.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_SeekTone
+(
+    audioDsp_Tone_t* tonePtr,   ///< [IN/OUT] Tone generator.
+    uint32_t index              ///< [IN] Index of the sample, counting from phase 0.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Generate the sum of two tones, saturated to 16 bits, e.g. a DTMF.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_GenerateDualTone
+(
+    audioDsp_Tone_t* tone1Ptr,  ///< [IN/OUT] First tone generator.
+    audioDsp_Tone_t* tone2Ptr,  ///< [IN/OUT] Second tone generator.
+    int16_t* outPtr,            ///< [OUT] Samples.
+    size_t count                ///< [IN] Number of samples.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mix samples into a buffer, with saturation.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_Mix
+(
+    int16_t* dstPtr,            ///< [IN/OUT] Samples to mix into.
+    const int16_t* srcPtr,      ///< [IN] Samples to mix.
+    size_t count                ///< [IN] Number of samples.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Apply a gain to samples in place, with saturation.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_ApplyGain
+(
+    int16_t* bufPtr,            ///< [IN/OUT] Samples.
+    size_t count,               ///< [IN] Number of samples.
+    uint16_t gain               ///< [IN] Gain in Q12 (AUDIODSP_GAIN_UNITY is a gain of 1).
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert mono samples to interleaved stereo samples.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_MonoToStereo
+(
+    const int16_t* inPtr,       ///< [IN] Mono samples.
+    int16_t* outPtr,            ///< [OUT] Stereo samples, 2 * frameCount long.
+    size_t frameCount           ///< [IN] Number of frames.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert interleaved stereo samples to mono samples, by averaging the channels.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_StereoToMono
+(
+    const int16_t* inPtr,       ///< [IN] Stereo samples, 2 * frameCount long.
+    int16_t* outPtr,            ///< [OUT] Mono samples.
+    size_t frameCount           ///< [IN] Number of frames.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a sample rate converter.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_InitResampler
+(
+    audioDsp_Resampler_t* resamplerPtr,     ///< [OUT] Sample rate converter.
+    uint32_t inRate,                        ///< [IN] Input sample rate, in Hertz.
+    uint32_t outRate                        ///< [IN] Output sample rate, in Hertz.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert a block of a mono stream to another sample rate.  The blocks of a stream must be
+ * converted in order, with the same converter.
+ *
+ * @return
+ *      Number of output samples, at most outMax.  The input samples that don't fit in the output
+ *      buffer are dropped.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t audioDsp_Resample
+(
+    audioDsp_Resampler_t* resamplerPtr,     ///< [IN/OUT] Sample rate converter.
+    const int16_t* inPtr,                   ///< [IN] Input samples.
+    size_t inCount,                         ///< [IN] Number of input samples.
+    int16_t* outPtr,                        ///< [OUT] Output samples.
+    size_t outMax                           ///< [IN] Size of the output buffer, in samples.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert unsigned 8-bit samples to signed 16-bit samples.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_U8ToS16
+(
+    const uint8_t* inPtr,       ///< [IN] Unsigned 8-bit samples.
+    int16_t* outPtr,            ///< [OUT] Signed 16-bit samples.
+    size_t count                ///< [IN] Number of samples.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert signed 16-bit samples to unsigned 8-bit samples.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_S16ToU8
+(
+    const int16_t* inPtr,       ///< [IN] Signed 16-bit samples.
+    uint8_t* outPtr,            ///< [OUT] Unsigned 8-bit samples.
+    size_t count                ///< [IN] Number of samples.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert packed little-endian signed 24-bit samples to signed 16-bit samples.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_S24ToS16
+(
+    const uint8_t* inPtr,       ///< [IN] Signed 24-bit samples, 3 bytes each.
+    int16_t* outPtr,            ///< [OUT] Signed 16-bit samples.
+    size_t count                ///< [IN] Number of samples.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert signed 32-bit samples to signed 16-bit samples.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_S32ToS16
+(
+    const int32_t* inPtr,       ///< [IN] Signed 32-bit samples.
+    int16_t* outPtr,            ///< [OUT] Signed 16-bit samples.
+    size_t count                ///< [IN] Number of samples.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert signed 16-bit samples to signed 32-bit samples.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioDsp_S16ToS32
+(
+    const int16_t* inPtr,       ///< [IN] Signed 16-bit samples.
+    int32_t* outPtr,            ///< [OUT] Signed 32-bit samples.
+    size_t count                ///< [IN] Number of samples.
+);
+
+#endif // LEGATO_AUDIO_DSP_INCLUDE_GUARD
@@ -0,0 +1,807 @@
+//--------------------------------------------------------------------------------------------------
+/** @file audioRing.c
+ *
+ * Shared memory sample ring, used by the audio service and its clients.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "audioRing.h"
+#include <sys/mman.h>
+#include <sys/eventfd.h>
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Name of the memfd, for debugging purposes (/proc/PID/fd).
+ */
+//--------------------------------------------------------------------------------------------------
+#define RING_MEMFD_NAME     "le_audio.ring"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mapped ring, as seen from one of its ends.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct audioRing_End
+{
+    audioRing_Header_t* headerPtr;      ///< Mapped ring.
+    uint8_t* dataPtr;                   ///< Buffer of the ring, right after the header.
+    uint32_t size;                      ///< Size of the buffer, read once from the header.
+    audioRing_Role_t role;              ///< End of the ring.
+    int ringFd;                         ///< memfd of the ring, only kept by the creator, or -1.
+    int eventFd;                        ///< Event file descriptor, or -1.
+}
+End_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of ring ends.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t EndPool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocate a ring end.
+ */
+//--------------------------------------------------------------------------------------------------
+static End_t* NewEnd
+(
+    audioRing_Header_t* headerPtr,      ///< [IN] Mapped ring.
+    uint32_t size,                      ///< [IN] Size of the buffer.
+    audioRing_Role_t role,              ///< [IN] End of the ring.
+    int ringFd,                         ///< [IN] memfd of the ring, or -1.
+    int eventFd                         ///< [IN] Event file descriptor, or -1.
+)
+{
+    if (NULL == EndPool)
+    {
+        EndPool = le_mem_CreatePool("audioRingEnd", sizeof(End_t));
+    }
+
+    End_t* endPtr = le_mem_ForceAlloc(EndPool);
+
+    endPtr->headerPtr = headerPtr;
+    endPtr->dataPtr = (uint8_t*)(headerPtr + 1);
+    endPtr->size = size;
+    endPtr->role = role;
+    endPtr->ringFd = ringFd;
+    endPtr->eventFd = eventFd;
+
+    return endPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes that an end can read or write, and its position in the ring.
+ *
+ * The other end's count is not trusted: it could be corrupted by a faulty client, so the number
+ * of bytes is always kept within the buffer size.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t GetAvailable
+(
+    End_t* endPtr,                      ///< [IN] Ring end.
+    uint64_t* positionPtr               ///< [OUT] Count of the bytes read or written by the end.
+)
+{
+    audioRing_Header_t* headerPtr = endPtr->headerPtr;
+    uint64_t used;
+
+    if (AUDIORING_PRODUCER == endPtr->role)
+    {
+        *positionPtr = __atomic_load_n(&headerPtr->writeCount, __ATOMIC_RELAXED);
+        used = *positionPtr - __atomic_load_n(&headerPtr->readCount, __ATOMIC_ACQUIRE);
+
+        return (used >= endPtr->size) ? 0 : (uint32_t)(endPtr->size - used);
+    }
+
+    *positionPtr = __atomic_load_n(&headerPtr->readCount, __ATOMIC_RELAXED);
+    used = __atomic_load_n(&headerPtr->writeCount, __ATOMIC_ACQUIRE) - *positionPtr;
+
+    return (used >= endPtr->size) ? endPtr->size : (uint32_t)used;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes the other end waits for.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t* OtherWaitLen
+(
+    End_t* endPtr                       ///< [IN] Ring end.
+)
+{
+    return (AUDIORING_PRODUCER == endPtr->role) ? &endPtr->headerPtr->consumerWaitLen
+                                                : &endPtr->headerPtr->producerWaitLen;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes an end waits for.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t* OwnWaitLen
+(
+    End_t* endPtr                       ///< [IN] Ring end.
+)
+{
+    return (AUDIORING_PRODUCER == endPtr->role) ? &endPtr->headerPtr->producerWaitLen
+                                                : &endPtr->headerPtr->consumerWaitLen;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Request the other end to signal the event file descriptor once a number of bytes is available.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ArmEvent
+(
+    End_t* endPtr,                      ///< [IN] Ring end.
+    uint32_t len                        ///< [IN] Number of bytes, at least 1.
+)
+{
+    __atomic_store_n(OwnWaitLen(endPtr), len, __ATOMIC_RELAXED);
+
+    // Pairs with the fence in Advance().
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Signal the event file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SignalEvent
+(
+    End_t* endPtr                       ///< [IN] Ring end.
+)
+{
+    uint64_t one = 1;
+
+    // The event file descriptor is non-blocking, and its counter can't realistically overflow.
+    if ((endPtr->eventFd >= 0) &&
+        (write(endPtr->eventFd, &one, sizeof(one)) < 0) && (EAGAIN != errno))
+    {
+        LE_WARN("Failed to signal audio ring event %d (%m)", endPtr->eventFd);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move an end's count after bytes it read or wrote, and wake up the other end if it waits for no
+ * more than it can now read or write.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Advance
+(
+    End_t* endPtr,                      ///< [IN] Ring end.
+    uint64_t position,                  ///< [IN] Count of the bytes read or written by the end.
+    uint32_t len                        ///< [IN] Number of bytes read or written.
+)
+{
+    if (0 == len)
+    {
+        return;
+    }
+
+    audioRing_Header_t* headerPtr = endPtr->headerPtr;
+    uint32_t waitLen;
+    uint64_t used;
+
+    __atomic_store_n((AUDIORING_PRODUCER == endPtr->role) ? &headerPtr->writeCount
+                                                          : &headerPtr->readCount,
+                     position + len, __ATOMIC_RELEASE);
+
+    // Pairs with the fence in ArmEvent(): either the other end sees the new count when it checks
+    // the ring after setting its wait length, or this end sees the wait length.
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    waitLen = __atomic_load_n(OtherWaitLen(endPtr), __ATOMIC_RELAXED);
+    if (0 == waitLen)
+    {
+        return;
+    }
+
+    // Bytes in the ring, as the other end will see them.
+    if (AUDIORING_PRODUCER == endPtr->role)
+    {
+        used = position + len - __atomic_load_n(&headerPtr->readCount, __ATOMIC_RELAXED);
+        if (used >= waitLen)
+        {
+            SignalEvent(endPtr);
+        }
+    }
+    else
+    {
+        used = __atomic_load_n(&headerPtr->writeCount, __ATOMIC_RELAXED) - (position + len);
+        if ((used > endPtr->size) || (endPtr->size - used >= waitLen))
+        {
+            SignalEvent(endPtr);
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a ring in a new memfd, with its event file descriptor.  This is done by the audio
+ * service.
+ *
+ * @return
+ *      Reference to the ring, or NULL on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+audioRing_Ref_t audioRing_Create
+(
+    uint32_t size,                      ///< [IN] Size of the buffer, in bytes.  Rounded up to a
+                                        ///<      power of 2, at least AUDIORING_MIN_SIZE.
+    audioRing_Role_t role               ///< [IN] End of the ring of the caller.
+)
+{
+    uint32_t ringSize = AUDIORING_MIN_SIZE;
+    size_t mapSize;
+    audioRing_Header_t* headerPtr = MAP_FAILED;
+    int eventFd;
+
+    if (size > AUDIORING_MAX_SIZE)
+    {
+        LE_ERROR("Audio ring size %" PRIu32 " is too large", size);
+        return NULL;
+    }
+
+    while (ringSize < size)
+    {
+        ringSize <<= 1;
+    }
+    mapSize = sizeof(audioRing_Header_t) + ringSize;
+
+    int fd = memfd_create(RING_MEMFD_NAME, MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0)
+    {
+        LE_ERROR("Failed to create audio ring (%m)");
+        return NULL;
+    }
+
+    // The size is sealed, so that a client can't truncate the ring and crash the service with a
+    // SIGBUS.
+    if ((0 == ftruncate(fd, mapSize)) &&
+        (0 == fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL)))
+    {
+        headerPtr = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+
+    if (MAP_FAILED == headerPtr)
+    {
+        LE_ERROR("Failed to map audio ring (%m)");
+        close(fd);
+        return NULL;
+    }
+
+    eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (eventFd < 0)
+    {
+        LE_ERROR("Failed to create audio ring event (%m)");
+        munmap(headerPtr, mapSize);
+        close(fd);
+        return NULL;
+    }
+
+    // The memfd is zero-filled: the counts, flags and padding are already cleared.
+    headerPtr->version = AUDIORING_VERSION;
+    headerPtr->size = ringSize;
+    headerPtr->creatorRole = role;
+    __atomic_store_n(&headerPtr->magic, AUDIORING_MAGIC, __ATOMIC_RELEASE);
+
+    return NewEnd(headerPtr, ringSize, role, fd, eventFd);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Map a ring created by the audio service.  The caller is the end of the ring that the audio
+ * service is not.
+ *
+ * Both file descriptors are owned by the ring from then on, even if this fails.
+ *
+ * @return
+ *      Reference to the ring, or NULL if the file descriptor is not a valid ring.
+ */
+//--------------------------------------------------------------------------------------------------
+audioRing_Ref_t audioRing_Open
+(
+    int ringFd,                         ///< [IN] File descriptor of the ring.
+    int eventFd                         ///< [IN] File descriptor from
+                                        ///<      le_audio_GetSampleRingEvent(), or -1.
+)
+{
+    audioRing_Header_t* headerPtr = MAP_FAILED;
+    struct stat st;
+
+    if ((ringFd >= 0) && (0 == fstat(ringFd, &st)) &&
+        ((size_t)st.st_size > sizeof(audioRing_Header_t)))
+    {
+        headerPtr = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, ringFd, 0);
+    }
+
+    // The mapping stays valid once the file descriptor is closed.
+    if (ringFd >= 0)
+    {
+        close(ringFd);
+    }
+
+    if (MAP_FAILED == headerPtr)
+    {
+        LE_ERROR("Could not map the audio ring (%m).");
+    }
+    else
+    {
+        uint32_t size = headerPtr->size;
+
+        if (   (__atomic_load_n(&headerPtr->magic, __ATOMIC_ACQUIRE) == AUDIORING_MAGIC)
+            && (headerPtr->version == AUDIORING_VERSION)
+            && (size >= AUDIORING_MIN_SIZE) && (0 == (size & (size - 1)))
+            && ((size_t)st.st_size == sizeof(audioRing_Header_t) + size)
+            && (headerPtr->creatorRole <= AUDIORING_CONSUMER))
+        {
+            audioRing_Role_t role = (AUDIORING_PRODUCER == headerPtr->creatorRole)
+                                        ? AUDIORING_CONSUMER : AUDIORING_PRODUCER;
+
+            return NewEnd(headerPtr, size, role, -1, eventFd);
+        }
+
+        LE_ERROR("Audio ring layout not supported (magic 0x%08" PRIx32 ", version %" PRIu32 ").",
+                 headerPtr->magic, headerPtr->version);
+        munmap(headerPtr, st.st_size);
+    }
+
+    if (eventFd >= 0)
+    {
+        close(eventFd);
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the file descriptor of the ring's memfd.  Only the ring's creator has it.
+ *
+ * @return
+ *      The file descriptor, or -1.
+ */
+//--------------------------------------------------------------------------------------------------
+int audioRing_GetFd
+(
+    audioRing_Ref_t ringRef             ///< [IN] Ring.
+)
+{
+    LE_ASSERT(ringRef != NULL);
+
+    return ringRef->ringFd;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the event file descriptor of the ring.  It is non-blocking.
+ *
+ * @return
+ *      The file descriptor, or -1 if the ring was opened without one.
+ */
+//--------------------------------------------------------------------------------------------------
+int audioRing_GetEventFd
+(
+    audioRing_Ref_t ringRef             ///< [IN] Ring.
+)
+{
+    LE_ASSERT(ringRef != NULL);
+
+    return ringRef->eventFd;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the size of the ring's buffer.
+ *
+ * @return
+ *      Size in bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t audioRing_GetSize
+(
+    audioRing_Ref_t ringRef             ///< [IN] Ring.
+)
+{
+    LE_ASSERT(ringRef != NULL);
+
+    return ringRef->size;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes that the caller can read from the ring (consumer), or write to it
+ * (producer).
+ *
+ * @return
+ *      Number of bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t audioRing_GetAvailable
+(
+    audioRing_Ref_t ringRef             ///< [IN] Ring.
+)
+{
+    LE_ASSERT(ringRef != NULL);
+
+    uint64_t position;
+
+    return GetAvailable(ringRef, &position);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the part of the ring's buffer that the caller can read from (consumer) or write to
+ * (producer) in place, without a copy.  This is the contiguous part of audioRing_GetAvailable()
+ * bytes, up to the end of the buffer.  audioRing_Commit() must be called once done.
+ *
+ * @return
+ *      Pointer to the first byte.
+ */
+//--------------------------------------------------------------------------------------------------
+uint8_t* audioRing_GetBuffer
+(
+    audioRing_Ref_t ringRef,            ///< [IN] Ring.
+    uint32_t* lenPtr                    ///< [OUT] Number of bytes.
+)
+{
+    LE_ASSERT((ringRef != NULL) && (lenPtr != NULL));
+
+    uint64_t position;
+    uint32_t available = GetAvailable(ringRef, &position);
+    uint32_t offset = position & (ringRef->size - 1);
+
+    *lenPtr = ((ringRef->size - offset) < available) ? (ringRef->size - offset) : available;
+
+    return ringRef->dataPtr + offset;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hand over bytes read from (consumer) or written to (producer) the buffer returned by
+ * audioRing_GetBuffer() to the other end.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioRing_Commit
+(
+    audioRing_Ref_t ringRef,            ///< [IN] Ring.
+    uint32_t len                        ///< [IN] Number of bytes, at most the length returned by
+                                        ///<      audioRing_GetBuffer().
+)
+{
+    LE_ASSERT(ringRef != NULL);
+
+    uint64_t position;
+    uint32_t available = GetAvailable(ringRef, &position);
+
+    LE_ASSERT(len <= available);
+
+    Advance(ringRef, position, len);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy bytes to the ring.  Only for the producer.
+ *
+ * @return
+ *      Number of bytes written, which is less than len if the ring is full.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t audioRing_Write
+(
+    audioRing_Ref_t ringRef,            ///< [IN] Ring.
+    const void* bufPtr,                 ///< [IN] Bytes to write.
+    uint32_t len                        ///< [IN] Number of bytes.
+)
+{
+    LE_ASSERT((ringRef != NULL) && (AUDIORING_PRODUCER == ringRef->role));
+
+    uint64_t position;
+    uint32_t available = GetAvailable(ringRef, &position);
+    uint32_t offset = position & (ringRef->size - 1);
+    uint32_t count = (len < available) ? len : available;
+    uint32_t firstPart = ((ringRef->size - offset) < count) ? (ringRef->size - offset) : count;
+
+    // The buffer wraps around: copy up to its end, then from its start.
+    memcpy(ringRef->dataPtr + offset, bufPtr, firstPart);
+    memcpy(ringRef->dataPtr, (const uint8_t*)bufPtr + firstPart, count - firstPart);
+
+    Advance(ringRef, position, count);
+
+    return count;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy bytes from the ring.  Only for the consumer.
+ *
+ * @return
+ *      Number of bytes read, which is less than len if the ring doesn't hold as many.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t audioRing_Read
+(
+    audioRing_Ref_t ringRef,            ///< [IN] Ring.
+    void* bufPtr,                       ///< [OUT] Bytes read, or NULL to drop them.
+    uint32_t len                        ///< [IN] Number of bytes.
+)
+{
+    LE_ASSERT((ringRef != NULL) && (AUDIORING_CONSUMER == ringRef->role));
+
+    uint64_t position;
+    uint32_t available = GetAvailable(ringRef, &position);
+    uint32_t offset = position & (ringRef->size - 1);
+    uint32_t count = (len < available) ? len : available;
+    uint32_t firstPart = ((ringRef->size - offset) < count) ? (ringRef->size - offset) : count;
+
+    if (NULL != bufPtr)
+    {
+        memcpy(bufPtr, ringRef->dataPtr + offset, firstPart);
+        memcpy((uint8_t*)bufPtr + firstPart, ringRef->dataPtr, count - firstPart);
+    }
+
+    Advance(ringRef, position, count);
+
+    return count;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait until the caller can read (consumer) or write (producer) a number of bytes.
+ *
+ * @return
+ *      - LE_OK if the bytes are available.
+ *      - LE_TIMEOUT if they are not available after the timeout.
+ *      - LE_CLOSED if the ring was shut down, and they will never be.
+ *      - LE_FAULT if the ring has no event file descriptor, or the wait failed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t audioRing_Wait
+(
+    audioRing_Ref_t ringRef,            ///< [IN] Ring.
+    uint32_t len,                       ///< [IN] Number of bytes, at most the size of the ring.
+    int32_t timeoutMs                   ///< [IN] Timeout in milliseconds, or -1 to wait forever.
+)
+{
+    LE_ASSERT(ringRef != NULL);
+
+    le_clk_Time_t timeout = { .sec = timeoutMs / 1000, .usec = (timeoutMs % 1000) * 1000 };
+    le_clk_Time_t deadline = le_clk_Add(le_clk_GetRelativeTime(), timeout);
+    struct pollfd pfd = { .fd = ringRef->eventFd, .events = POLLIN };
+
+    if ((ringRef->eventFd < 0) || (len > ringRef->size))
+    {
+        return LE_FAULT;
+    }
+
+    for (;;)
+    {
+        int pollTimeoutMs = -1;
+
+        if (audioRing_GetAvailable(ringRef) >= len)
+        {
+            return LE_OK;
+        }
+        if (audioRing_IsShutdown(ringRef))
+        {
+            return LE_CLOSED;
+        }
+
+        // Check again once the other end is sure to see the wait length, or it might never signal.
+        ArmEvent(ringRef, (len > 0) ? len : 1);
+        if ((audioRing_GetAvailable(ringRef) >= len) || audioRing_IsShutdown(ringRef))
+        {
+            audioRing_ClearEvent(ringRef);
+            continue;
+        }
+
+        if (timeoutMs >= 0)
+        {
+            le_clk_Time_t remaining = le_clk_Sub(deadline, le_clk_GetRelativeTime());
+
+            pollTimeoutMs = (remaining.sec < 0) ? 0
+                                                : (remaining.sec * 1000 + remaining.usec / 1000);
+        }
+
+        int result = poll(&pfd, 1, pollTimeoutMs);
+
+        audioRing_ClearEvent(ringRef);
+
+        if (0 == result)
+        {
+            return (audioRing_GetAvailable(ringRef) >= len) ? LE_OK : LE_TIMEOUT;
+        }
+        if ((result < 0) && (EINTR != errno))
+        {
+            LE_ERROR("Failed to wait for the audio ring (%m)");
+            return LE_FAULT;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Request the other end to signal the event file descriptor at its next commit, to wait for the
+ * ring with poll() or le_fdMonitor.  audioRing_GetAvailable() must be checked after this call,
+ * as the other end may have committed before it, and audioRing_ClearEvent() must be called once
+ * the event is reported.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioRing_ArmEvent
+(
+    audioRing_Ref_t ringRef             ///< [IN] Ring.
+)
+{
+    LE_ASSERT(ringRef != NULL);
+
+    ArmEvent(ringRef, 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Clear the ring's event and the request made by audioRing_ArmEvent().
+ */
+//--------------------------------------------------------------------------------------------------
+void audioRing_ClearEvent
+(
+    audioRing_Ref_t ringRef             ///< [IN] Ring.
+)
+{
+    LE_ASSERT(ringRef != NULL);
+
+    uint64_t count;
+
+    __atomic_store_n(OwnWaitLen(ringRef), 0, __ATOMIC_RELAXED);
+
+    // The event file descriptor is non-blocking, so this fails with EAGAIN if it wasn't signalled.
+    if (ringRef->eventFd >= 0)
+    {
+        while ((read(ringRef->eventFd, &count, sizeof(count)) < 0) && (EINTR == errno))
+        {
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Tell the other end that the caller won't read or write the ring anymore.  The consumer can
+ * still read the bytes already written.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioRing_Shutdown
+(
+    audioRing_Ref_t ringRef             ///< [IN] Ring.
+)
+{
+    LE_ASSERT(ringRef != NULL);
+
+    __atomic_store_n(&ringRef->headerPtr->shutdown, 1, __ATOMIC_RELEASE);
+
+    // Whatever the other end waits for, it won't come.
+    SignalEvent(ringRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether the ring was shut down by either end.
+ *
+ * @return
+ *      true if the ring was shut down.
+ */
+//--------------------------------------------------------------------------------------------------
+bool audioRing_IsShutdown
+(
+    audioRing_Ref_t ringRef             ///< [IN] Ring.
+)
+{
+    LE_ASSERT(ringRef != NULL);
+
+    return (0 != __atomic_load_n(&ringRef->headerPtr->shutdown, __ATOMIC_ACQUIRE));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Count a missed transfer: an underrun for the consumer, which had no samples to read, or an
+ * overrun for the producer, which had no space to write.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioRing_CountXrun
+(
+    audioRing_Ref_t ringRef             ///< [IN] Ring.
+)
+{
+    LE_ASSERT(ringRef != NULL);
+
+    __atomic_fetch_add((AUDIORING_PRODUCER == ringRef->role) ? &ringRef->headerPtr->overrunCount
+                                                             : &ringRef->headerPtr->underrunCount,
+                       1, __ATOMIC_RELAXED);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the underrun and overrun counts of the ring.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioRing_GetXrunCounts
+(
+    audioRing_Ref_t ringRef,            ///< [IN] Ring.
+    uint32_t* underrunCountPtr,         ///< [OUT] Underruns counted by the consumer.
+    uint32_t* overrunCountPtr           ///< [OUT] Overruns counted by the producer.
+)
+{
+    LE_ASSERT(ringRef != NULL);
+
+    if (NULL != underrunCountPtr)
+    {
+        *underrunCountPtr = __atomic_load_n(&ringRef->headerPtr->underrunCount, __ATOMIC_RELAXED);
+    }
+    if (NULL != overrunCountPtr)
+    {
+        *overrunCountPtr = __atomic_load_n(&ringRef->headerPtr->overrunCount, __ATOMIC_RELAXED);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unmap a ring and close its file descriptors.  The ring is shut down first.
+ */
+//--------------------------------------------------------------------------------------------------
+void audioRing_Close
+(
+    audioRing_Ref_t ringRef             ///< [IN] Ring.
+)
+{
+    LE_ASSERT(ringRef != NULL);
+
+    audioRing_Shutdown(ringRef);
+
+    munmap(ringRef->headerPtr, sizeof(audioRing_Header_t) + ringRef->size);
+
+    if (ringRef->ringFd >= 0)
+    {
+        close(ringRef->ringFd);
+    }
+    if (ringRef->eventFd >= 0)
+    {
+        close(ringRef->eventFd);
+    }
+
+    le_mem_Release(ringRef);
+}
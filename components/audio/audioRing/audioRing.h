@@ -0,0 +1,356 @@
+//--------------------------------------------------------------------------------------------------
+/** @file audioRing.h
+ *
+ * Shared memory sample ring, used to stream PCM samples between the audio service and a client
+ * without a pipe.
+ *
+ * The ring is a header followed by a buffer, whose size is a power of 2, in a memfd created by the
+ * audio service.  One end of the ring (the producer) writes the samples, the other end (the
+ * consumer) reads them: the audio service is the consumer of a playback ring
+ * (le_audio_PlaySamplesRing()) and the producer of a recording ring (le_audio_GetSamplesRing()).
+ *
+ * Each end only writes its own count of bytes, so the ring needs no lock: the producer's
+ * writeCount minus the consumer's readCount is the number of bytes in the ring.  Both ends copy
+ * the samples directly from or to the ring, and no system call is made while the samples flow:
+ * the ring's event file descriptor is only signalled when the other end waits for the ring, in
+ * audioRing_Wait() or after audioRing_ArmEvent(), and only once the number of bytes it waits for
+ * is available.
+ *
+ * A client gets the ring from le_audio_PlaySamplesRing() or le_audio_GetSamplesRing(), and the
+ * event file descriptor from le_audio_GetSampleRingEvent(), then hands them over to
+ * audioRing_Open():
+ *
+ * @code
+ *     int ringFd;
+ *     int eventFd;
+ *
+ *     if (   (LE_OK == le_audio_PlaySamplesRing(streamRef, 16384, &ringFd))
+ *         && (LE_OK == le_audio_GetSampleRingEvent(streamRef, &eventFd)))
+ *     {
+ *         audioRing_Ref_t ringRef = audioRing_Open(ringFd, eventFd);
+ *         ...
+ *     }
+ * @endcode
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_AUDIO_RING_INCLUDE_GUARD
+#define LEGATO_AUDIO_RING_INCLUDE_GUARD
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Magic number at the start of the ring ("AUDR").
+ */
+//--------------------------------------------------------------------------------------------------
+#define AUDIORING_MAGIC             0x52445541
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Version of the ring layout.  Changed whenever the layout changes.
+ */
+//--------------------------------------------------------------------------------------------------
+#define AUDIORING_VERSION           1
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Limits of the buffer size, in bytes.  The size is rounded up to a power of 2.
+ */
+//--------------------------------------------------------------------------------------------------
+#define AUDIORING_MIN_SIZE          4096
+#define AUDIORING_MAX_SIZE          (1024 * 1024)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * End of the ring.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    AUDIORING_PRODUCER = 0,                 ///< Writes the samples.
+    AUDIORING_CONSUMER = 1                  ///< Reads the samples.
+}
+audioRing_Role_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Ring header.  The fields written by each end are on their own cache line.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    // Set by the audio service.
+    uint32_t magic;                         ///< AUDIORING_MAGIC.
+    uint32_t version;                       ///< AUDIORING_VERSION.
+    uint32_t size;                          ///< Size of the buffer, in bytes.
+    uint32_t creatorRole;                   ///< audioRing_Role_t of the audio service's end.
+    uint32_t shutdown;                      ///< Set when an end stops reading or writing.
+    uint8_t  reserved0[44];                 ///< Padding to a cache line, set to 0.
+
+    // Written by the producer.
+    uint64_t writeCount;                    ///< Number of bytes written to the ring.
+    uint32_t overrunCount;                  ///< Number of times the samples did not fit.
+    uint32_t producerWaitLen;               ///< Free bytes the producer waits for, or 0.
+    uint8_t  reserved1[48];                 ///< Padding to a cache line, set to 0.
+
+    // Written by the consumer.
+    uint64_t readCount;                     ///< Number of bytes read from the ring.
+    uint32_t underrunCount;                 ///< Number of times samples were missing.
+    uint32_t consumerWaitLen;               ///< Bytes the consumer waits for, or 0.
+    uint8_t  reserved2[48];                 ///< Padding to a cache line, set to 0.
+}
+audioRing_Header_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a mapped ring.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct audioRing_End* audioRing_Ref_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a ring in a new memfd, with its event file descriptor.  This is done by the audio
+ * service.
+ *
+ * @return
+ *      Reference to the ring, or NULL on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED audioRing_Ref_t audioRing_Create
+(
+    uint32_t size,                      ///< [IN] Size of the buffer, in bytes.  Rounded up to a
+                                        ///<      power of 2, at least AUDIORING_MIN_SIZE.
+    audioRing_Role_t role               ///< [IN] End of the ring of the caller.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Map a ring created by the audio service.  The caller is the end of the ring that the audio
+ * service is not.
+ *
+ * Both file descriptors are owned by the ring from then on, even if this fails.
+ *
+ * @return
+ *      Reference to the ring, or NULL if the file descriptor is not a valid ring.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED audioRing_Ref_t audioRing_Open
+(
+    int ringFd,                         ///< [IN] File descriptor of the ring.
+    int eventFd                         ///< [IN] File descriptor from
+                                        ///<      le_audio_GetSampleRingEvent(), or -1.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the file descriptor of the ring's memfd.  Only the ring's creator has it.
+ *
+ * @return
+ *      The file descriptor, or -1.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED int audioRing_GetFd
+(
+    audioRing_Ref_t ringRef             ///< [IN] Ring.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the event file descriptor of the ring.  It is non-blocking.
+ *
+ * @return
+ *      The file descriptor, or -1 if the ring was opened without one.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED int audioRing_GetEventFd
+(
+    audioRing_Ref_t ringRef             ///< [IN] Ring.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the size of the ring's buffer.
+ *
+ * @return
+ *      Size in bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED uint32_t audioRing_GetSize
+(
+    audioRing_Ref_t ringRef             ///< [IN] Ring.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes that the caller can read from the ring (consumer), or write to it
+ * (producer).
+ *
+ * @return
+ *      Number of bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED uint32_t audioRing_GetAvailable
+(
+    audioRing_Ref_t ringRef             ///< [IN] Ring.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the part of the ring's buffer that the caller can read from (consumer) or write to
+ * (producer) in place, without a copy.  This is the contiguous part of audioRing_GetAvailable()
+ * bytes, up to the end of the buffer.  audioRing_Commit() must be called once done.
+ *
+ * @return
+ *      Pointer to the first byte.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED uint8_t* audioRing_GetBuffer
+(
+    audioRing_Ref_t ringRef,            ///< [IN] Ring.
+    uint32_t* lenPtr                    ///< [OUT] Number of bytes.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hand over bytes read from (consumer) or written to (producer) the buffer returned by
+ * audioRing_GetBuffer() to the other end.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void audioRing_Commit
+(
+    audioRing_Ref_t ringRef,            ///< [IN] Ring.
+    uint32_t len                        ///< [IN] Number of bytes, at most the length returned by
+                                        ///<      audioRing_GetBuffer().
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy bytes to the ring.  Only for the producer.
+ *
+ * @return
+ *      Number of bytes written, which is less than len if the ring is full.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED uint32_t audioRing_Write
+(
+    audioRing_Ref_t ringRef,            ///< [IN] Ring.
+    const void* bufPtr,                 ///< [IN] Bytes to write.
+    uint32_t len                        ///< [IN] Number of bytes.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy bytes from the ring.  Only for the consumer.
+ *
+ * @return
+ *      Number of bytes read, which is less than len if the ring doesn't hold as many.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED uint32_t audioRing_Read
+(
+    audioRing_Ref_t ringRef,            ///< [IN] Ring.
+    void* bufPtr,                       ///< [OUT] Bytes read, or NULL to drop them.
+    uint32_t len                        ///< [IN] Number of bytes.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait until the caller can read (consumer) or write (producer) a number of bytes.
+ *
+ * @return
+ *      - LE_OK if the bytes are available.
+ *      - LE_TIMEOUT if they are not available after the timeout.
+ *      - LE_CLOSED if the ring was shut down, and they will never be.
+ *      - LE_FAULT if the ring has no event file descriptor, or the wait failed.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t audioRing_Wait
+(
+    audioRing_Ref_t ringRef,            ///< [IN] Ring.
+    uint32_t len,                       ///< [IN] Number of bytes, at most the size of the ring.
+    int32_t timeoutMs                   ///< [IN] Timeout in milliseconds, or -1 to wait forever.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Request the other end to signal the event file descriptor at its next commit, to wait for the
+ * ring with poll() or le_fdMonitor.  audioRing_GetAvailable() must be checked after this call,
+ * as the other end may have committed before it, and audioRing_ClearEvent() must be called once
+ * the event is reported.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void audioRing_ArmEvent
+(
+    audioRing_Ref_t ringRef             ///< [IN] Ring.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Clear the ring's event and the request made by audioRing_ArmEvent().
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void audioRing_ClearEvent
+(
+    audioRing_Ref_t ringRef             ///< [IN] Ring.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Tell the other end that the caller won't read or write the ring anymore.  The consumer can
+ * still read the bytes already written.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void audioRing_Shutdown
+(
+    audioRing_Ref_t ringRef             ///< [IN] Ring.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether the ring was shut down by either end.
+ *
+ * @return
+ *      true if the ring was shut down.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED bool audioRing_IsShutdown
+(
+    audioRing_Ref_t ringRef             ///< [IN] Ring.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Count a missed transfer: an underrun for the consumer, which had no samples to read, or an
+ * overrun for the producer, which had no space to write.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void audioRing_CountXrun
+(
+    audioRing_Ref_t ringRef             ///< [IN] Ring.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the underrun and overrun counts of the ring.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void audioRing_GetXrunCounts
+(
+    audioRing_Ref_t ringRef,            ///< [IN] Ring.
+    uint32_t* underrunCountPtr,         ///< [OUT] Underruns counted by the consumer.
+    uint32_t* overrunCountPtr           ///< [OUT] Overruns counted by the producer.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unmap a ring and close its file descriptors.  The ring is shut down first.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void audioRing_Close
+(
+    audioRing_Ref_t ringRef             ///< [IN] Ring.
+);
+
+#endif // LEGATO_AUDIO_RING_INCLUDE_GUARD
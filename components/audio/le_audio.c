@@ -2945,6 +2945,45 @@ le_result_t le_audio_PlaySamples
                                 &streamPtr->samplePcmConfig);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initiate a playback sending samples over a shared memory sample ring.
+ *
+ * @return LE_FAULT         Function failed.
+ * @return LE_BUSY          The player interface is already active.
+ * @return LE_OK            Function succeeded.
+ *
+ * @note Playback initiated with this function must be stopped by calling le_audio_Stop().
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_audio_PlaySamplesRing
+(
+    le_audio_StreamRef_t streamRef , ///< Audio stream reference.
+    uint32_t             ringSize,   ///< Size of the ring, in bytes.
+    int*                 ringFdPtr   ///< File descriptor of the ring.
+)
+{
+    le_audio_Stream_t* streamPtr = le_ref_Lookup(AudioStreamRefMap, streamRef);
+
+    if (streamPtr == NULL)
+    {
+        LE_KILL_CLIENT("Invalid reference (%p) provided!", streamRef);
+        return LE_FAULT;
+    }
+
+    if ( le_media_IsStreamBusy(streamPtr) )
+    {
+        return LE_BUSY;
+    }
+
+    streamPtr->playFile = false;
+
+    return le_media_PlaySamplesRing(streamPtr,
+                                    &streamPtr->samplePcmConfig,
+                                    ringSize,
+                                    ringFdPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Record a file on a recorder stream.
@@ -3066,6 +3105,68 @@ le_result_t le_audio_GetSamples
                                 &streamPtr->samplePcmConfig);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get samples from a recorder stream over a shared memory sample ring.
+ *
+ * @return LE_FAULT         Function failed.
+ * @return LE_BUSY          The recorder interface is already active.
+ * @return LE_OK            Function succeeded.
+ *
+ * @note When using this function recording must be stopped by calling le_audio_Stop().
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_audio_GetSamplesRing
+(
+    le_audio_StreamRef_t streamRef , ///< Audio stream reference.
+    uint32_t             ringSize,   ///< Size of the ring, in bytes.
+    int*                 ringFdPtr   ///< File descriptor of the ring.
+)
+{
+    le_audio_Stream_t* streamPtr = le_ref_Lookup(AudioStreamRefMap, streamRef);
+
+    if (streamPtr == NULL)
+    {
+        LE_KILL_CLIENT("Invalid reference (%p) provided!", streamRef);
+        return LE_FAULT;
+    }
+
+    if ( le_media_IsStreamBusy(streamPtr) )
+    {
+        return LE_BUSY;
+    }
+
+    return le_media_CaptureRing(streamPtr,
+                                &streamPtr->samplePcmConfig,
+                                ringSize,
+                                ringFdPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the event file descriptor of the sample ring of a stream.
+ *
+ * @return LE_FAULT         The stream doesn't use a sample ring.
+ * @return LE_OK            Function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_audio_GetSampleRingEvent
+(
+    le_audio_StreamRef_t streamRef , ///< Audio stream reference.
+    int*                 eventFdPtr  ///< File descriptor of the ring's event.
+)
+{
+    le_audio_Stream_t* streamPtr = le_ref_Lookup(AudioStreamRefMap, streamRef);
+
+    if (streamPtr == NULL)
+    {
+        LE_KILL_CLIENT("Invalid reference (%p) provided!", streamRef);
+        return LE_FAULT;
+    }
+
+    return le_media_GetSampleRingEvent(streamPtr, eventFdPtr);
+}
+
 
 //--------------------------------------------------------------------------------------------------
 /**
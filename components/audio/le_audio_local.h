@@ -88,6 +88,8 @@ typedef struct {
     bool                        pause;              ///< pause in capture
     le_audio_MediaEvent_t       mediaEvent;         ///< media event to be sent
     int                         framesFuncTimeout;  ///< Timeout for getFramesFunc callback
+    struct audioRing_End*       ringRef;            ///< Sample ring (audioRing_Ref_t) used instead
+                                                    ///< of fd, or NULL
 }
 le_audio_PcmContext_t;
 
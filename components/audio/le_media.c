@@ -15,7 +15,8 @@
 #include "pa_audio.h"
 #include "pa_amr.h"
 #include "pa_pcm.h"
-#include <math.h>
+#include "audioDsp.h"
+#include "audioRing.h"
 
 //--------------------------------------------------------------------------------------------------
 // Symbol and Enum definitions.
@@ -35,9 +36,6 @@
 //--------------------------------------------------------------------------------------------------
 #define SAMPLE_SCALE    (32767)
 #define DTMF_AMPLITUDE  (40)
-#if !defined (PI)
-#define PI 3.14159265358979323846264338327
-#endif
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -50,6 +48,13 @@
 #define ID_DATA    0x61746164
 #define FORMAT_PCM 1
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of 8-bit WAV samples read at once to be converted to 16 bits.
+ */
+//--------------------------------------------------------------------------------------------------
+#define WAV_8BIT_CHUNK_SAMPLES  256
+
 //--------------------------------------------------------------------------------------------------
 /**
  * For PlaySamples wait indefinitely until more samples are available or playback is stopped
@@ -381,34 +386,6 @@ static inline uint32_t Digit2HighFreq
     }
 }
 
-//--------------------------------------------------------------------------------------------------
-/**
- *  Add two 16-bit values.
- *
- */
-//--------------------------------------------------------------------------------------------------
-static inline int16_t SaturateAdd16
-(
-    int32_t a,
-    int32_t b
-)
-{
-    int32_t tot=a+b;
-
-    if (tot > 32767)
-    {
-        return 32767;
-    }
-    else if (tot < -32768)
-    {
-        return -32768;
-    }
-    else
-    {
-        return (tot & 0xFFFF);
-    }
-}
-
 //--------------------------------------------------------------------------------------------------
 /**
  *  Play Tone function. This function split into samples of 1s. To play a DTMF or a PAUSE for a
@@ -423,7 +400,6 @@ static le_result_t PlayTone
     uint32_t*                      bufferLenPtr  ///< [OUT] Length of the buffer
 )
 {
-    double   d1, d2;
     uint32_t i;
 
     DtmfParams_t*  dtmfParamsPtr = (DtmfParams_t*) mediaCtxPtr->codecParams;
@@ -433,8 +409,8 @@ static le_result_t PlayTone
     uint32_t sampleOneSecond = dtmfParamsPtr->sampleRate + dtmfParamsPtr->currentSampleCount;
     uint32_t freq1;
     uint32_t freq2;
-    int32_t  amp1;
-    int32_t  amp2;
+    audioDsp_Tone_t tone1;
+    audioDsp_Tone_t tone2;
     int16_t* dataPtr = (int16_t*) bufferOutPtr;
     // Length of the current sample: max 1 second, i.e, sampleRate
     uint32_t sampleLength;
@@ -490,23 +466,16 @@ static le_result_t PlayTone
 
         freq1 = Digit2LowFreq(dtmfParamsPtr->dtmf[dtmfParamsPtr->currentDtmf]);
         freq2 = Digit2HighFreq(dtmfParamsPtr->dtmf[dtmfParamsPtr->currentDtmf]);
-        amp1 = DTMF_AMPLITUDE;
-        amp2 = DTMF_AMPLITUDE;
-
-        d1 = 1.0f * freq1 / dtmfParamsPtr->sampleRate;
-        d2 = 1.0f * freq2 / dtmfParamsPtr->sampleRate;
-
-        for (i = dtmfParamsPtr->currentSampleCount;
-             // Play max sampleRate (1s) of DTMF and continue at next call
-             (i < sampleOneSecond) && (i < samplesCount);
-             i++)
-        {
-            int16_t s1, s2;
+        audioDsp_InitTone(&tone1, freq1, dtmfParamsPtr->sampleRate,
+                          SAMPLE_SCALE * DTMF_AMPLITUDE / 100);
+        audioDsp_InitTone(&tone2, freq2, dtmfParamsPtr->sampleRate,
+                          SAMPLE_SCALE * DTMF_AMPLITUDE / 100);
+        audioDsp_SeekTone(&tone1, dtmfParamsPtr->currentSampleCount);
+        audioDsp_SeekTone(&tone2, dtmfParamsPtr->currentSampleCount);
 
-            s1 = (int16_t)(SAMPLE_SCALE * amp1 / 100.0f * sin(2 * PI * d1 * i));
-            s2 = (int16_t)(SAMPLE_SCALE * amp2 / 100.0f * sin(2 * PI * d2 * i));
-            *(dataPtr++) = SaturateAdd16(s1, s2);
-        }
+        // Play max sampleRate (1s) of DTMF and continue at next call
+        i = dtmfParamsPtr->currentSampleCount + sampleLength;
+        audioDsp_GenerateDualTone(&tone1, &tone2, dataPtr, sampleLength);
 
         // Save the current sample count. If the whole DTMF is played, reset to 0
         dtmfParamsPtr->currentSampleCount = (i == samplesCount ? 0 : i);
@@ -599,6 +568,52 @@ static le_result_t MediaReadFd
     return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read 8-bit samples from a file descriptor, and convert them to 16-bit samples.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t Wav8BitReadFd
+(
+    le_audio_MediaThreadContext_t* mediaCtxPtr,  ///< [IN] Media thread context
+    uint8_t*                       bufferOutPtr, ///< [OUT] Converted samples buffer output
+    uint32_t*                      readLenPtr    ///< [OUT] Length of the converted data
+)
+{
+    uint8_t  chunk[WAV_8BIT_CHUNK_SAMPLES];
+    int16_t* dataPtr = (int16_t*) bufferOutPtr;
+    uint32_t maxSamples = mediaCtxPtr->bufferSize / sizeof(int16_t);
+    uint32_t sampleCount = 0;
+
+    while (sampleCount < maxSamples)
+    {
+        size_t  chunkSize = ((maxSamples - sampleCount) < sizeof(chunk))
+                                ? (maxSamples - sampleCount)
+                                : sizeof(chunk);
+        ssize_t size = ReadFd(mediaCtxPtr->fd_in, chunk, chunkSize);
+
+        if (size < 0)
+        {
+            LE_ERROR("Read error fd=%d", mediaCtxPtr->fd_in);
+            return LE_FAULT;
+        }
+
+        audioDsp_U8ToS16(chunk, dataPtr + sampleCount, size);
+        sampleCount += size;
+
+        if ((size_t)size < chunkSize)
+        {
+            // End of file
+            break;
+        }
+    }
+
+    (*readLenPtr) = sampleCount * sizeof(int16_t);
+
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Write on a file descriptor.
@@ -1030,6 +1045,15 @@ static le_result_t PlayWavFile
 
     mediaContextPtr->initFunc = InitPlayWavFile;
     mediaContextPtr->readFunc = MediaReadFd;
+
+    // 8-bit WAV samples are unsigned, unlike the samples of the wider formats: play them as
+    // 16-bit samples.
+    if (8 == hdr.bitsPerSample)
+    {
+        samplePcmConfigPtr->bitsPerSample = 16;
+        mediaContextPtr->readFunc = Wav8BitReadFd;
+    }
+
     mediaContextPtr->writeFunc = MediaWriteFd;
     mediaContextPtr->closeFunc = ReleaseCodecParams;
 
@@ -1288,7 +1312,17 @@ static le_result_t PlayCaptControl
 
         case FLUSH:
             // flush the audio stream
-            if (pcmContextPtr)
+            if (pcmContextPtr && pcmContextPtr->ringRef)
+            {
+                pcmContextPtr->pause = true;
+                audioRing_Read(pcmContextPtr->ringRef, NULL,
+                               audioRing_GetAvailable(pcmContextPtr->ringRef));
+                pcmContextPtr->pause = false;
+
+                res = LE_OK;
+                LE_INFO("Flush audio!");
+            }
+            else if (pcmContextPtr)
             {
                 pcmContextPtr->pause = true;
 
@@ -1409,6 +1443,88 @@ static void PlayTreatEvent
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the timeout of the getFramesFunc callback to the duration of a period, once the playback
+ * has started.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetFramesFuncTimeout
+(
+    le_audio_PcmContext_t* pcmContextPtr
+)
+{
+    long msec = (pa_pcm_GetPeriodSize(pcmContextPtr->pcmHandle) *
+                 (1000000 / (pcmContextPtr->pcmConfig.byteRate))) / 1000;
+    pcmContextPtr->framesFuncTimeout = msec;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get Playback frames from a sample ring
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetRingPlaybackFrames
+(
+    le_audio_PcmContext_t* pcmContextPtr,
+    uint8_t* bufferPtr,
+    uint32_t* bufsizePtr
+)
+{
+    audioRing_Ref_t ringRef = pcmContextPtr->ringRef;
+    uint32_t size = *bufsizePtr;
+    uint32_t amount;
+
+    // playback is paused: return without reading samples
+    if (pcmContextPtr->pause)
+    {
+        memset(bufferPtr, 0, size);
+        return LE_OK;
+    }
+
+    // As with a pipe, wait up to a period for the samples. No system call is made as long as the
+    // client keeps the ring filled.
+    if ((audioRing_GetAvailable(ringRef) < size) &&
+        (audioRing_Wait(ringRef, (size < audioRing_GetSize(ringRef))
+                                     ? size : audioRing_GetSize(ringRef),
+                        pcmContextPtr->framesFuncTimeout) == LE_FAULT))
+    {
+        return LE_FAULT;
+    }
+
+    amount = audioRing_Read(ringRef, bufferPtr, size);
+
+    if (amount < size)
+    {
+        if ((0 == amount) && audioRing_IsShutdown(ringRef))
+        {
+            LE_DEBUG("Sample ring was shut down by the client");
+            return LE_CLOSED;
+        }
+
+        audioRing_CountXrun(ringRef);
+
+        if (0 == amount)
+        {
+            // no more samples available at this point:
+            // send silence frames to avoid xrun
+            LE_DEBUG("No data read");
+            memset(bufferPtr, 0, size);
+        }
+    }
+
+    if (amount)
+    {
+        SetFramesFuncTimeout(pcmContextPtr);
+    }
+
+    *bufsizePtr = amount;
+
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get Playback frames
@@ -1431,6 +1547,11 @@ static le_result_t GetPlaybackFrames
     nfds_t nfds = 1;
     struct pollfd pfd;
 
+    if (pcmContextPtr->ringRef)
+    {
+        return GetRingPlaybackFrames(pcmContextPtr, bufferPtr, bufsizePtr);
+    }
+
     pfd.fd = pcmContextPtr->fd;
     pfd.events = POLLIN;
 
@@ -1489,9 +1610,7 @@ static le_result_t GetPlaybackFrames
                         amount += len;
                         *bufsizePtr = amount;
                         // update timeout value for remaining data to be read
-                        long msec = (pa_pcm_GetPeriodSize(pcmContextPtr->pcmHandle) *
-                                     (1000000 / (pcmContextPtr->pcmConfig.byteRate))) / 1000;
-                        pcmContextPtr->framesFuncTimeout = msec;
+                        SetFramesFuncTimeout(pcmContextPtr);
                         continue;
                     }
                     else if (len < 0)
@@ -1533,7 +1652,22 @@ static le_result_t SetCaptureFrames
     le_audio_Stream_t*     streamPtr = contextPtr;
     le_audio_PcmContext_t* pcmContextPtr = streamPtr->pcmContextPtr;
 
-    if ( !pcmContextPtr->pause )
+    if ( pcmContextPtr->ringRef )
+    {
+        if (audioRing_IsShutdown(pcmContextPtr->ringRef))
+        {
+            LE_ERROR("Sample ring was shut down by the client");
+            return LE_FAULT;
+        }
+
+        // The capture must not be held up by the client: the samples that don't fit are lost.
+        if ( !pcmContextPtr->pause &&
+             (audioRing_Write(pcmContextPtr->ringRef, bufferPtr, *bufsizePtr) < *bufsizePtr) )
+        {
+            audioRing_CountXrun(pcmContextPtr->ringRef);
+        }
+    }
+    else if ( !pcmContextPtr->pause )
     {
         if (WriteFd(pcmContextPtr->fd, bufferPtr, *bufsizePtr) < 0)
         {
@@ -1850,7 +1984,10 @@ le_result_t le_media_Open
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function is used to play audio samples.
+ * Start the playback of audio samples, read from the stream's file descriptor or from a sample
+ * ring.
+ *
+ * The sample ring is owned by the playback from then on, even if this fails.
  *
  * @return LE_OK            The thread is started
  * @return LE_BAD_PARAMETER The interface is not valid
@@ -1858,26 +1995,35 @@ le_result_t le_media_Open
  * @return LE_FAULT         The function is failed
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t le_media_PlaySamples
+static le_result_t StartPlayback
 (
     le_audio_Stream_t*          streamPtr,          ///< [IN] Stream object
-    le_audio_SamplePcmConfig_t* samplePcmConfigPtr  ///< [IN] Sample configuration
+    le_audio_SamplePcmConfig_t* samplePcmConfigPtr, ///< [IN] Sample configuration
+    audioRing_Ref_t             ringRef             ///< [IN] Sample ring, or NULL
 )
 {
     le_audio_PcmContext_t*  pcmContextPtr;
 
-    LE_DEBUG("Create Playback thread for interface %d fd %d", streamPtr->audioInterface,
-                                                              streamPtr->fd);
-
     if ((streamPtr == NULL) || (streamPtr->pcmContextPtr))
     {
         LE_ERROR("Playback thread is already started");
+        if (ringRef)
+        {
+            audioRing_Close(ringRef);
+        }
         return LE_BUSY;
     }
 
+    LE_DEBUG("Create Playback thread for interface %d fd %d", streamPtr->audioInterface,
+                                                              streamPtr->fd);
+
     if (streamPtr->audioInterface != LE_AUDIO_IF_DSP_FRONTEND_FILE_PLAY)
     {
         LE_ERROR("Invalid interface");
+        if (ringRef)
+        {
+            audioRing_Close(ringRef);
+        }
         return LE_BAD_PARAMETER;
     }
 
@@ -1885,6 +2031,7 @@ le_result_t le_media_PlaySamples
     memset(pcmContextPtr, 0, sizeof(le_audio_PcmContext_t));
 
     pcmContextPtr->fd = streamPtr->fd;
+    pcmContextPtr->ringRef = ringRef;
 
     samplePcmConfigPtr->byteRate = (  samplePcmConfigPtr->sampleRate *
                                       samplePcmConfigPtr->channelsCount *
@@ -1941,6 +2088,102 @@ le_result_t le_media_PlaySamples
     return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function is used to play audio samples.
+ *
+ * @return LE_OK            The thread is started
+ * @return LE_BAD_PARAMETER The interface is not valid
+ * @return LE_BUSY          The thread is already started
+ * @return LE_FAULT         The function is failed
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_media_PlaySamples
+(
+    le_audio_Stream_t*          streamPtr,          ///< [IN] Stream object
+    le_audio_SamplePcmConfig_t* samplePcmConfigPtr  ///< [IN] Sample configuration
+)
+{
+    return StartPlayback(streamPtr, samplePcmConfigPtr, NULL);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function is used to play audio samples written by the client to a shared memory sample
+ * ring, instead of a pipe.
+ *
+ * @return LE_OK            The thread is started
+ * @return LE_BAD_PARAMETER The interface is not valid
+ * @return LE_BUSY          The thread is already started
+ * @return LE_FAULT         The function is failed
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_media_PlaySamplesRing
+(
+    le_audio_Stream_t*          streamPtr,          ///< [IN] Stream object
+    le_audio_SamplePcmConfig_t* samplePcmConfigPtr, ///< [IN] Sample configuration
+    uint32_t                    ringSize,           ///< [IN] Size of the ring, in bytes
+    int*                        ringFdPtr           ///< [OUT] File descriptor of the ring
+)
+{
+    audioRing_Ref_t ringRef = audioRing_Create(ringSize, AUDIORING_CONSUMER);
+    le_result_t     res;
+
+    if (NULL == ringRef)
+    {
+        return LE_FAULT;
+    }
+
+    res = StartPlayback(streamPtr, samplePcmConfigPtr, ringRef);
+
+    if (LE_OK == res)
+    {
+        // The IPC closes the file descriptor once sent.
+        *ringFdPtr = dup(audioRing_GetFd(ringRef));
+
+        if (*ringFdPtr < 0)
+        {
+            LE_ERROR("Cannot duplicate the ring file descriptor: %m");
+            le_media_Stop(streamPtr);
+            res = LE_FAULT;
+        }
+    }
+
+    return res;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the event file descriptor of the sample ring of a stream.
+ *
+ * @return LE_OK            The function is succeeded
+ * @return LE_FAULT         The stream doesn't use a sample ring
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_media_GetSampleRingEvent
+(
+    le_audio_Stream_t*          streamPtr,          ///< [IN] Stream object
+    int*                        eventFdPtr          ///< [OUT] Event file descriptor of the ring
+)
+{
+    if ((NULL == streamPtr->pcmContextPtr) || (NULL == streamPtr->pcmContextPtr->ringRef))
+    {
+        LE_ERROR("Stream %p has no sample ring", streamPtr);
+        return LE_FAULT;
+    }
+
+    // The IPC closes the file descriptor once sent.
+    *eventFdPtr = dup(audioRing_GetEventFd(streamPtr->pcmContextPtr->ringRef));
+
+    if (*eventFdPtr < 0)
+    {
+        LE_ERROR("Cannot duplicate the ring event file descriptor: %m");
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to pause the playback/capture thread.
@@ -2116,6 +2359,17 @@ le_result_t le_media_Stop
             {
                 LE_DEBUG("Close pa_pcm");
                 pa_pcm_Close(streamPtr->pcmContextPtr->pcmHandle);
+                if (streamPtr->pcmContextPtr->ringRef)
+                {
+                    uint32_t underrunCount;
+                    uint32_t overrunCount;
+
+                    audioRing_GetXrunCounts(streamPtr->pcmContextPtr->ringRef,
+                                            &underrunCount, &overrunCount);
+                    LE_DEBUG("Close sample ring: %u underruns, %u overruns",
+                             underrunCount, overrunCount);
+                    audioRing_Close(streamPtr->pcmContextPtr->ringRef);
+                }
                 le_mem_Release(streamPtr->pcmContextPtr);
                 streamPtr->pcmContextPtr = NULL;
             }
@@ -2145,7 +2399,10 @@ le_result_t le_media_Stop
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function is used to capture an audio stream.
+ * Start the capture of an audio stream, written to the stream's file descriptor or to a sample
+ * ring.
+ *
+ * The sample ring is owned by the capture from then on, even if this fails.
  *
  * @return LE_OK            The thread is started
  * @return LE_BAD_PARAMETER The interface is not valid
@@ -2153,10 +2410,11 @@ le_result_t le_media_Stop
  * @return LE_FAULT         The function is failed
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t le_media_Capture
+static le_result_t StartCapture
 (
     le_audio_Stream_t*          streamPtr,          ///< [IN] Stream object
-    le_audio_SamplePcmConfig_t* samplePcmConfigPtr  ///< [IN] Sample configuration
+    le_audio_SamplePcmConfig_t* samplePcmConfigPtr, ///< [IN] Sample configuration
+    audioRing_Ref_t             ringRef             ///< [IN] Sample ring, or NULL
 )
 {
     LE_DEBUG("Create capture thread for interface %d", streamPtr->audioInterface);
@@ -2164,12 +2422,20 @@ le_result_t le_media_Capture
     if (streamPtr->pcmContextPtr)
     {
         LE_ERROR("capture thread is already started");
+        if (ringRef)
+        {
+            audioRing_Close(ringRef);
+        }
         return LE_BUSY;
     }
 
     if (streamPtr->audioInterface != LE_AUDIO_IF_DSP_FRONTEND_FILE_CAPTURE)
     {
         LE_ERROR("Invalid interface");
+        if (ringRef)
+        {
+            audioRing_Close(ringRef);
+        }
         return LE_BAD_PARAMETER;
     }
 
@@ -2179,6 +2445,7 @@ le_result_t le_media_Capture
     memset(pcmContextPtr, 0, sizeof(le_audio_PcmContext_t));
 
     pcmContextPtr->fd = streamPtr->fd;
+    pcmContextPtr->ringRef = ringRef;
 
     samplePcmConfigPtr->byteRate = (samplePcmConfigPtr->sampleRate *
                                     samplePcmConfigPtr->channelsCount *
@@ -2222,6 +2489,70 @@ le_result_t le_media_Capture
     return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function is used to capture an audio stream.
+ *
+ * @return LE_OK            The thread is started
+ * @return LE_BAD_PARAMETER The interface is not valid
+ * @return LE_BUSY          The thread is already started
+ * @return LE_FAULT         The function is failed
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_media_Capture
+(
+    le_audio_Stream_t*          streamPtr,          ///< [IN] Stream object
+    le_audio_SamplePcmConfig_t* samplePcmConfigPtr  ///< [IN] Sample configuration
+)
+{
+    return StartCapture(streamPtr, samplePcmConfigPtr, NULL);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function is used to capture an audio stream to a shared memory sample ring read by the
+ * client, instead of a pipe.
+ *
+ * @return LE_OK            The thread is started
+ * @return LE_BAD_PARAMETER The interface is not valid
+ * @return LE_BUSY          The thread is already started
+ * @return LE_FAULT         The function is failed
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_media_CaptureRing
+(
+    le_audio_Stream_t*          streamPtr,          ///< [IN] Stream object
+    le_audio_SamplePcmConfig_t* samplePcmConfigPtr, ///< [IN] Sample configuration
+    uint32_t                    ringSize,           ///< [IN] Size of the ring, in bytes
+    int*                        ringFdPtr           ///< [OUT] File descriptor of the ring
+)
+{
+    audioRing_Ref_t ringRef = audioRing_Create(ringSize, AUDIORING_PRODUCER);
+    le_result_t     res;
+
+    if (NULL == ringRef)
+    {
+        return LE_FAULT;
+    }
+
+    res = StartCapture(streamPtr, samplePcmConfigPtr, ringRef);
+
+    if (LE_OK == res)
+    {
+        // The IPC closes the file descriptor once sent.
+        *ringFdPtr = dup(audioRing_GetFd(ringRef));
+
+        if (*ringFdPtr < 0)
+        {
+            LE_ERROR("Cannot duplicate the ring file descriptor: %m");
+            le_media_Stop(streamPtr);
+            res = LE_FAULT;
+        }
+    }
+
+    return res;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function check if a stream is busy.
@@ -67,6 +67,25 @@ le_result_t le_media_Capture
     le_audio_SamplePcmConfig_t* samplePcmConfigPtr  ///< [IN] Sample configuration
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function is used to capture an audio stream to a shared memory sample ring read by the
+ * client, instead of a pipe.
+ *
+ * @return LE_OK            The thread is started
+ * @return LE_BAD_PARAMETER The interface is not valid
+ * @return LE_BUSY          The thread is already started
+ * @return LE_FAULT         The function is failed
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_media_CaptureRing
+(
+    le_audio_Stream_t*          streamPtr,          ///< [IN] Stream object
+    le_audio_SamplePcmConfig_t* samplePcmConfigPtr, ///< [IN] Sample configuration
+    uint32_t                    ringSize,           ///< [IN] Size of the ring, in bytes
+    int*                        ringFdPtr           ///< [OUT] File descriptor of the ring
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to stop an interface.
@@ -136,6 +155,39 @@ le_result_t le_media_PlaySamples
     le_audio_SamplePcmConfig_t* samplePcmConfigPtr  ///< [IN] Sample configuration
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function is used to play audio samples written by the client to a shared memory sample
+ * ring, instead of a pipe.
+ *
+ * @return LE_OK            The thread is started
+ * @return LE_BAD_PARAMETER The interface is not valid
+ * @return LE_BUSY          The thread is already started
+ * @return LE_FAULT         The function is failed
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_media_PlaySamplesRing
+(
+    le_audio_Stream_t*          streamPtr,          ///< [IN] Stream object
+    le_audio_SamplePcmConfig_t* samplePcmConfigPtr, ///< [IN] Sample configuration
+    uint32_t                    ringSize,           ///< [IN] Size of the ring, in bytes
+    int*                        ringFdPtr           ///< [OUT] File descriptor of the ring
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the event file descriptor of the sample ring of a stream.
+ *
+ * @return LE_OK            The function is succeeded
+ * @return LE_FAULT         The stream doesn't use a sample ring
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_media_GetSampleRingEvent
+(
+    le_audio_Stream_t*          streamPtr,          ///< [IN] Stream object
+    int*                        eventFdPtr          ///< [OUT] Event file descriptor of the ring
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function check if a stream is busy.
@@ -41,6 +41,7 @@
 #define CFG_NODE_TX_COUNT                   "txCount"
 #define CFG_NODE_RX_CB_COUNT                "rxCbCount"
 #define CFG_NODE_STATUS_REPORT              "statusReportEnabled"
+#define CFG_NODE_SEND_IN_FLIGHT             "sendInFlight"
 
 //--------------------------------------------------------------------------------------------------
 /**
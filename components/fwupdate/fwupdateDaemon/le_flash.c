@@ -18,6 +18,23 @@
 //--------------------------------------------------------------------------------------------------
 #define MAX_PARTITION_REF             18
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of block buffers of a stream: one being filled from the file descriptor, one being
+ * written by the flash thread and one ready to be written.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STREAM_BLOCK_BUFFERS          3
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Table of the MTD partitions.
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LE_FLASH_MTD_TABLE_PATH
+#define LE_FLASH_MTD_TABLE_PATH       "/proc/mtd"
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Event ID on bad image notification.
@@ -64,9 +81,69 @@ typedef struct
     le_dualsys_System_t     systemMask;    ///< System owning the partion, (modem, lk or linux)
     pa_flash_Info_t*        mtdInfo;       ///< Global MTD information
     pa_flash_EccStats_t     statsAtOpen;   ///< ECC stats and bad block at open time
+    struct Stream*          streamPtr;     ///< Stream being written to the partition, or NULL
+    bool                    isClosePending;///< True if to be closed once the stream is over
 }
 Partition_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * A block of data of a stream.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_sls_Link_t           link;          ///< Link in the list of free blocks of the stream
+    uint32_t                blockIndex;    ///< Logical block index to write the data at
+    size_t                  size;          ///< Size of the data
+    le_result_t             result;        ///< Result of the erase and write, set by flash thread
+    uint8_t                 data[LE_FLASH_MAX_WRITE_SIZE];
+                                           ///< Data to write
+}
+StreamBlock_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A stream of data written to a partition.
+ *
+ * The data are read from the file descriptor by the main thread and written block by block by the
+ * flash thread. When the first data of a block are read, the flash thread is asked to erase the
+ * block, which it does once the previous block is written. So the transfer of the data overlaps
+ * with the erase and the write of the blocks, and no IPC is needed between the blocks.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct Stream
+{
+    Partition_t*            partPtr;       ///< Partition written
+    int                     fd;            ///< File descriptor the data are read from
+    le_fdMonitor_Ref_t      fdMonitorRef;  ///< Monitor of the file descriptor, NULL once read
+    size_t                  blockSize;     ///< Size of the data of a block
+    uint32_t                nextBlockIndex;///< Logical block index of the next block to fill
+    StreamBlock_t*          fillBlockPtr;  ///< Block being filled, or NULL
+    le_sls_List_t           freeBlockList; ///< Blocks free to be filled
+    StreamBlock_t*          verifyBlockPtr;///< Buffer to read back the blocks, used by flash thread
+    uint32_t                pendingCount;  ///< Number of operations queued to the flash thread
+    uint32_t                blockCount;    ///< Number of blocks written and verified
+    le_result_t             result;        ///< Result of the stream
+    bool                    isCancelled;   ///< Set by the main thread when the stream fails or
+                                           ///< is closed: the flash thread skips its operations
+}
+Stream_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Progress of a stream, reported by the WriteStreamProgress event.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_flash_PartitionRef_t partitionRef;  ///< Partition written
+    uint32_t                blockCount;    ///< Number of blocks written and verified
+    bool                    isComplete;    ///< True if the stream is over
+    le_result_t             result;        ///< Result of the stream
+}
+StreamProgress_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Memory pool for allocating partitions ref.
@@ -109,6 +186,38 @@ static uint32_t FlashRequestedCount = 0;
 //--------------------------------------------------------------------------------------------------
 static le_dualsys_System_t ActiveSystemMask = 0;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory pools for allocating streams and their blocks.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t StreamPool = NULL;
+static le_mem_PoolRef_t StreamBlockPool = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Event ID on stream progress notification.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_event_Id_t StreamProgressEventId = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main thread, which reads the data of the streams, and flash thread, which writes them.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_thread_Ref_t MainThreadRef = NULL;
+static le_thread_Ref_t FlashThreadRef = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of streams not finished yet. While the flash thread may still use a partition, the end
+ * of the flash access (pa_fwupdate_CompleteUpdate) is deferred until the last stream is finished.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t StreamCount = 0;
+static bool IsCompleteUpdatePending = false;
+
 //--------------------------------------------------------------------------------------------------
 // Private functions
 //--------------------------------------------------------------------------------------------------
@@ -253,9 +362,9 @@ static le_result_t ParsePartitionNameAndGetMtd
 
     LE_DEBUG("Fetching partiton \"%s\"", namePtr);
     // Open the /proc/mtd partition
-    if (NULL == (mtdFdPtr = fopen( "/proc/mtd", "r" )))
+    if (NULL == (mtdFdPtr = fopen( LE_FLASH_MTD_TABLE_PATH, "r" )))
     {
-        LE_ERROR( "fopen on /proc/mtd failed: %m" );
+        LE_ERROR( "fopen on " LE_FLASH_MTD_TABLE_PATH " failed: %m" );
         return LE_FAULT;
     }
 
@@ -479,12 +588,20 @@ static le_result_t CloseUbiVolume
     return res;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop a stream, defined below.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StopStream(Stream_t* streamPtr, le_result_t result);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Close the partiton. If an UBI volume is currently open, it will close it also and adjust UBI
  * volume size if needed (write mode).
  * Release the whole Partition_t structure and any dynamic data. Once done, the reference will be
- * invalid.
+ * invalid. If a stream is being written to the partition, it is stopped, and the partition is
+ * closed once the flash thread is done with it.
  *
  * @return
  *      - LE_OK            On success
@@ -499,6 +616,13 @@ static le_result_t Close
 {
     le_result_t res;
 
+    if (NULL != partPtr->streamPtr)
+    {
+        partPtr->isClosePending = true;
+        StopStream(partPtr->streamPtr, LE_CLOSED);
+        return LE_OK;
+    }
+
     if ((partPtr->isUbi) && (-1 != partPtr->ubiVolume))
     {
         // The UBI volume is open. Force it to be closed.
@@ -587,6 +711,30 @@ static void CloseClientPartitions
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the flash access once no client requests it. If a stream is still written, the flash
+ * access is released once the flash thread is done with the last stream.
+ *
+ * @return
+ *      - LE_OK            On success, or if the release is deferred
+ *      - LE_FAULT         On failure
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CompleteUpdate
+(
+    void
+)
+{
+    if (StreamCount > 0)
+    {
+        LE_INFO("Flash access released once %u stream(s) are finished", StreamCount);
+        IsCompleteUpdatePending = true;
+        return LE_OK;
+    }
+    return pa_fwupdate_CompleteUpdate();
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * A handler for client disconnects which release its access counts and release the flash access
@@ -611,7 +759,7 @@ static void ReleaseClientAccess
             FlashRequestedCount--;
             if (0 == FlashRequestedCount)
             {
-                pa_fwupdate_CompleteUpdate();
+                (void)CompleteUpdate();
             }
         }
         le_hashmap_Remove(RequestHashMap, clientSession);
@@ -677,6 +825,467 @@ static void RequestInit
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a stream is being written to the partition, in which case the partition can't be
+ * accessed.
+ *
+ * @return
+ *      - true             If a stream is being written
+ *      - false            Otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsStreaming
+(
+    Partition_t* partPtr    ///< [IN] Partition descriptor
+)
+{
+    if (NULL != partPtr->streamPtr)
+    {
+        LE_ERROR("Partition \"%s\" MTD%d: A stream is being written",
+                 partPtr->partitionName, partPtr->mtdNum);
+        return true;
+    }
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * First layer stream progress handler
+ */
+//--------------------------------------------------------------------------------------------------
+static void StreamProgressHandler
+(
+    void *reportPtr,       ///< [IN] Pointer to the event report payload.
+    void *secondLayerFunc  ///< [IN] Address of the second layer handler function.
+)
+{
+    le_flash_WriteStreamProgressHandlerFunc_t clientHandlerFunc = secondLayerFunc;
+    StreamProgress_t* progressPtr = reportPtr;
+
+    clientHandlerFunc(progressPtr->partitionRef, progressPtr->blockCount,
+                      progressPtr->isComplete, progressPtr->result, le_event_GetContextPtr());
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report the progress of a stream
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportStreamProgress
+(
+    Stream_t* streamPtr,    ///< [IN] Stream
+    bool      isComplete    ///< [IN] True if the stream is over
+)
+{
+    StreamProgress_t progress;
+
+    progress.partitionRef = streamPtr->partPtr->ref;
+    progress.blockCount = streamPtr->blockCount;
+    progress.isComplete = isComplete;
+    progress.result = streamPtr->result;
+
+    le_event_Report(StreamProgressEventId, &progress, sizeof(progress));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release a stream once the data are all read and the flash thread is done with it. If the
+ * partition was closed meanwhile, it is closed now.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FinishStream
+(
+    Stream_t* streamPtr     ///< [IN] Stream
+)
+{
+    Partition_t* partPtr = streamPtr->partPtr;
+    le_sls_Link_t* linkPtr;
+
+    LE_INFO("Partition \"%s\" MTD%d: Stream over, %u blocks written: %d",
+            partPtr->partitionName, partPtr->mtdNum, streamPtr->blockCount, streamPtr->result);
+
+    ReportStreamProgress(streamPtr, true);
+
+    while (NULL != (linkPtr = le_sls_Pop(&streamPtr->freeBlockList)))
+    {
+        le_mem_Release(CONTAINER_OF(linkPtr, StreamBlock_t, link));
+    }
+    le_mem_Release(streamPtr->verifyBlockPtr);
+    le_mem_Release(streamPtr);
+
+    partPtr->streamPtr = NULL;
+    if (partPtr->isClosePending)
+    {
+        (void)Close(partPtr);
+    }
+
+    StreamCount--;
+    if ((0 == StreamCount) && (IsCompleteUpdatePending))
+    {
+        IsCompleteUpdatePending = false;
+        (void)pa_fwupdate_CompleteUpdate();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop reading the data of a stream, at the end of the file or on error. On error, the blocks
+ * still queued to the flash thread are skipped. The stream is released once the flash thread is
+ * done with it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StopStream
+(
+    Stream_t*   streamPtr,  ///< [IN] Stream
+    le_result_t result      ///< [IN] Result of the stream, if not already failed
+)
+{
+    if (LE_OK == streamPtr->result)
+    {
+        streamPtr->result = result;
+    }
+
+    if (LE_OK != streamPtr->result)
+    {
+        __atomic_store_n(&streamPtr->isCancelled, true, __ATOMIC_RELAXED);
+    }
+
+    if (NULL != streamPtr->fdMonitorRef)
+    {
+        le_fdMonitor_Delete(streamPtr->fdMonitorRef);
+        streamPtr->fdMonitorRef = NULL;
+        close(streamPtr->fd);
+        streamPtr->fd = -1;
+    }
+
+    if (NULL != streamPtr->fillBlockPtr)
+    {
+        le_sls_Queue(&streamPtr->freeBlockList, &streamPtr->fillBlockPtr->link);
+        streamPtr->fillBlockPtr = NULL;
+    }
+
+    if (0 == streamPtr->pendingCount)
+    {
+        FinishStream(streamPtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Called in the main thread once the flash thread is done with an operation of a stream.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StreamOperationDone
+(
+    void* param1Ptr,        ///< [IN] Stream
+    void* param2Ptr         ///< [IN] Block written, or NULL for an erase
+)
+{
+    Stream_t* streamPtr = param1Ptr;
+    StreamBlock_t* blockPtr = param2Ptr;
+
+    streamPtr->pendingCount--;
+
+    if (NULL != blockPtr)
+    {
+        le_sls_Queue(&streamPtr->freeBlockList, &blockPtr->link);
+
+        if (LE_OK != blockPtr->result)
+        {
+            LE_ERROR("Partition \"%s\" MTD%d: Stream failed at blockIndex %u: %d",
+                     streamPtr->partPtr->partitionName, streamPtr->partPtr->mtdNum,
+                     blockPtr->blockIndex, blockPtr->result);
+            StopStream(streamPtr, LE_FAULT);
+            return;
+        }
+
+        streamPtr->blockCount++;
+        ReportStreamProgress(streamPtr, false);
+
+        if (NULL != streamPtr->fdMonitorRef)
+        {
+            // A block is free again.
+            le_fdMonitor_Enable(streamPtr->fdMonitorRef, POLLIN);
+        }
+    }
+
+    if ((NULL == streamPtr->fdMonitorRef) && (0 == streamPtr->pendingCount))
+    {
+        FinishStream(streamPtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Erase a block of a stream, in the flash thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StreamEraseBlock
+(
+    void* param1Ptr,        ///< [IN] Stream
+    void* param2Ptr         ///< [IN] Block to erase
+)
+{
+    Stream_t* streamPtr = param1Ptr;
+    StreamBlock_t* blockPtr = param2Ptr;
+
+    if (__atomic_load_n(&streamPtr->isCancelled, __ATOMIC_RELAXED))
+    {
+        blockPtr->result = LE_CLOSED;
+    }
+    else
+    {
+        blockPtr->result = pa_flash_EraseBlock(streamPtr->partPtr->desc, blockPtr->blockIndex);
+    }
+
+    le_event_QueueFunctionToThread(MainThreadRef, StreamOperationDone, streamPtr, NULL);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a block of a stream and read it back to verify it, in the flash thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StreamWriteBlock
+(
+    void* param1Ptr,        ///< [IN] Stream
+    void* param2Ptr         ///< [IN] Block to write
+)
+{
+    Stream_t* streamPtr = param1Ptr;
+    StreamBlock_t* blockPtr = param2Ptr;
+    Partition_t* partPtr = streamPtr->partPtr;
+    uint8_t* verifyPtr = streamPtr->verifyBlockPtr->data;
+    size_t readSize = blockPtr->size;
+
+    // The result is the one of the erase for a MTD partition.
+    le_result_t res = blockPtr->result;
+
+    if (__atomic_load_n(&streamPtr->isCancelled, __ATOMIC_RELAXED))
+    {
+        res = LE_CLOSED;
+    }
+
+    if ((LE_OK == res) && (partPtr->isUbi))
+    {
+        res = pa_flash_WriteUbiAtBlock(partPtr->desc, blockPtr->blockIndex,
+                                       blockPtr->data, blockPtr->size, true);
+        if (LE_OK == res)
+        {
+            res = pa_flash_ReadUbiAtBlock(partPtr->desc, blockPtr->blockIndex,
+                                          verifyPtr, &readSize);
+        }
+    }
+    else if (LE_OK == res)
+    {
+        res = pa_flash_WriteAtBlock(partPtr->desc, blockPtr->blockIndex,
+                                    blockPtr->data, blockPtr->size);
+        if (LE_OK == res)
+        {
+            res = pa_flash_ReadAtBlock(partPtr->desc, blockPtr->blockIndex,
+                                       verifyPtr, readSize);
+        }
+    }
+
+    if ((LE_OK == res) &&
+        ((readSize != blockPtr->size) || (0 != memcmp(verifyPtr, blockPtr->data, readSize))))
+    {
+        LE_ERROR("Partition \"%s\" MTD%d: Verify failed at blockIndex %u",
+                 partPtr->partitionName, partPtr->mtdNum, blockPtr->blockIndex);
+        res = LE_FAULT;
+    }
+
+    blockPtr->result = res;
+
+    le_event_QueueFunctionToThread(MainThreadRef, StreamOperationDone, streamPtr, blockPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue the block being filled to the flash thread to be written.
+ */
+//--------------------------------------------------------------------------------------------------
+static void QueueStreamBlock
+(
+    Stream_t* streamPtr     ///< [IN] Stream
+)
+{
+    StreamBlock_t* blockPtr = streamPtr->fillBlockPtr;
+    uint32_t writeSize = streamPtr->partPtr->mtdInfo->writeSize;
+
+    if ((!streamPtr->partPtr->isUbi) && (writeSize) && (blockPtr->size % writeSize))
+    {
+        // Only whole pages can be written: pad the last block with erased bytes.
+        size_t padSize = writeSize - (blockPtr->size % writeSize);
+
+        memset(blockPtr->data + blockPtr->size, PA_FLASH_ERASED_VALUE, padSize);
+        blockPtr->size += padSize;
+    }
+
+    streamPtr->fillBlockPtr = NULL;
+    streamPtr->nextBlockIndex++;
+    streamPtr->pendingCount++;
+    le_event_QueueFunctionToThread(FlashThreadRef, StreamWriteBlock, streamPtr, blockPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the data of a stream from its file descriptor into free blocks, and queue the blocks to the
+ * flash thread as they are filled.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StreamReadHandler
+(
+    int   fd,               ///< [IN] File descriptor
+    short events            ///< [IN] Events
+)
+{
+    Stream_t* streamPtr = le_fdMonitor_GetContextPtr();
+    Partition_t* partPtr = streamPtr->partPtr;
+
+    while (NULL != streamPtr->fdMonitorRef)
+    {
+        StreamBlock_t* blockPtr = streamPtr->fillBlockPtr;
+
+        if (NULL == blockPtr)
+        {
+            le_sls_Link_t* linkPtr = le_sls_Pop(&streamPtr->freeBlockList);
+
+            if (NULL == linkPtr)
+            {
+                // Wait for the flash thread to write a block.
+                le_fdMonitor_Disable(streamPtr->fdMonitorRef, POLLIN);
+                return;
+            }
+            blockPtr = CONTAINER_OF(linkPtr, StreamBlock_t, link);
+            blockPtr->blockIndex = streamPtr->nextBlockIndex;
+            blockPtr->size = 0;
+            blockPtr->result = LE_OK;
+            streamPtr->fillBlockPtr = blockPtr;
+        }
+
+        ssize_t readSize = read(fd, blockPtr->data + blockPtr->size,
+                                streamPtr->blockSize - blockPtr->size);
+        if (readSize < 0)
+        {
+            if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+            {
+                return;
+            }
+            if (EINTR != errno)
+            {
+                LE_ERROR("Partition \"%s\" MTD%d: Stream read failed: %m",
+                         partPtr->partitionName, partPtr->mtdNum);
+                StopStream(streamPtr, LE_FAULT);
+            }
+            continue;
+        }
+
+        if (0 == readSize)
+        {
+            // End of file: write the last block.
+            if (blockPtr->size)
+            {
+                QueueStreamBlock(streamPtr);
+            }
+            StopStream(streamPtr, LE_OK);
+            return;
+        }
+
+        if (0 == blockPtr->size)
+        {
+            // First data of the block: have it erased while the rest of its data are read.
+            if ((!partPtr->isUbi) && (blockPtr->blockIndex >= partPtr->mtdInfo->nbLeb))
+            {
+                LE_ERROR("Partition \"%s\" MTD%d: Stream over the end of the partition",
+                         partPtr->partitionName, partPtr->mtdNum);
+                StopStream(streamPtr, LE_OUT_OF_RANGE);
+                return;
+            }
+            if (!partPtr->isUbi)
+            {
+                streamPtr->pendingCount++;
+                le_event_QueueFunctionToThread(FlashThreadRef, StreamEraseBlock,
+                                               streamPtr, blockPtr);
+            }
+        }
+
+        blockPtr->size += readSize;
+        if (blockPtr->size == streamPtr->blockSize)
+        {
+            QueueStreamBlock(streamPtr);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main function of the flash thread, which erases and writes the blocks of the streams.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* FlashThread
+(
+    void* contextPtr        ///< [IN] Semaphore to post once the thread is running
+)
+{
+    le_sem_Post((le_sem_Ref_t)contextPtr);
+    le_event_RunLoop();
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialization for Stream
+ */
+//--------------------------------------------------------------------------------------------------
+static void StreamInit
+(
+    void
+)
+{
+    if (NULL == StreamPool)
+    {
+        StreamPool = le_mem_CreatePool("Flash Stream Pool", sizeof(Stream_t));
+        StreamBlockPool = le_mem_CreatePool("Flash Stream Block Pool", sizeof(StreamBlock_t));
+        StreamProgressEventId = le_event_CreateId("StreamProgressEvent", sizeof(StreamProgress_t));
+        MainThreadRef = le_thread_GetCurrent();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start the flash thread if not running yet.
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_FAULT         If the thread could not be started
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t StartFlashThread
+(
+    void
+)
+{
+    if (NULL == FlashThreadRef)
+    {
+        le_sem_Ref_t semRef = le_sem_Create("FlashThreadSem", 0);
+        le_clk_Time_t timeToWait = { 5, 0 };
+        le_thread_Ref_t threadRef = le_thread_Create("FlashThread", FlashThread, semRef);
+
+        le_thread_Start(threadRef);
+        if (LE_OK != le_sem_WaitWithTimeOut(semRef, timeToWait))
+        {
+            LE_ERROR("Flash thread did not start");
+            le_sem_Delete(semRef);
+            return LE_FAULT;
+        }
+        le_sem_Delete(semRef);
+        FlashThreadRef = threadRef;
+    }
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 // APIs
 //--------------------------------------------------------------------------------------------------
@@ -736,6 +1345,52 @@ void le_flash_RemoveBadImageDetectionHandler
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function adds a handler for the progress of the streams
+ */
+//--------------------------------------------------------------------------------------------------
+le_flash_WriteStreamProgressHandlerRef_t le_flash_AddWriteStreamProgressHandler
+(
+    le_flash_WriteStreamProgressHandlerFunc_t handlerPtr, ///< [IN] Handler pointer
+    void* contextPtr                                      ///< [IN] Associated context pointer
+)
+{
+    if (handlerPtr == NULL)
+    {
+        LE_ERROR("Bad parameters");
+        return NULL;
+    }
+
+    StreamInit();
+
+    le_event_HandlerRef_t handlerRef = le_event_AddLayeredHandler(
+        "WriteStreamProgressHandler",
+        StreamProgressEventId,
+        StreamProgressHandler,
+        (void*)handlerPtr);
+
+    le_event_SetContextPtr(handlerRef, contextPtr);
+
+    return (le_flash_WriteStreamProgressHandlerRef_t)(handlerRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function removes a handler for the progress of the streams
+ */
+//--------------------------------------------------------------------------------------------------
+void le_flash_RemoveWriteStreamProgressHandler
+(
+    le_flash_WriteStreamProgressHandlerRef_t handlerRef ///< [IN] Handler reference
+)
+{
+    if (StreamProgressEventId && handlerRef)
+    {
+        le_event_RemoveHandler((le_event_HandlerRef_t)handlerRef);
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Request the flash access authorization. This is required to avoid race operations.
@@ -775,7 +1430,12 @@ le_result_t le_flash_RequestAccess
             LE_ERROR("Client %p already performed a request access", requestPtr->client);
             return LE_DUPLICATE;
         }
-        if (0 == FlashRequestedCount)
+        if ((0 == FlashRequestedCount) && (IsCompleteUpdatePending))
+        {
+            // The previous access is not released yet: keep it.
+            IsCompleteUpdatePending = false;
+        }
+        else if (0 == FlashRequestedCount)
         {
             // Request the access to the flash
             res = pa_fwupdate_RequestUpdate();
@@ -798,7 +1458,8 @@ le_result_t le_flash_RequestAccess
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Release the flash access requested by le_flash_RequestAccess API.
+ * Release the flash access requested by le_flash_RequestAccess API. If a stream is still being
+ * written, the flash access is released once the stream is over.
  *
  * @return
  *      - LE_OK            On success
@@ -832,7 +1493,7 @@ le_result_t le_flash_ReleaseAccess
             }
             if (0 == FlashRequestedCount)
             {
-                res = pa_fwupdate_CompleteUpdate();
+                res = CompleteUpdate();
             }
         }
     }
@@ -991,6 +1652,7 @@ le_result_t le_flash_OpenUbiVolume
  * @return
  *      - LE_OK            On success
  *      - LE_BAD_PARAMETER If a parameter is invalid
+ *      - LE_BUSY          If a stream is being written to the partition
  *      - LE_FAULT         On failure
  *
  */
@@ -1007,6 +1669,11 @@ le_result_t le_flash_CloseUbiVolume
         return LE_BAD_PARAMETER;
     }
 
+    if (IsStreaming(partPtr))
+    {
+        return LE_BUSY;
+    }
+
     LE_INFO("Closing UBI volume %d partition \"%s\" MTD%d",
             partPtr->ubiVolume, partPtr->partitionName, partPtr->mtdNum);
 
@@ -1015,7 +1682,8 @@ le_result_t le_flash_CloseUbiVolume
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Close a flash partition
+ * Close a flash partition. If a stream is being written to the partition, it is cancelled: the
+ * blocks not written yet are skipped, and the partition is closed once the stream is over.
  *
  * @return
  *      - LE_OK            On success
@@ -1047,6 +1715,7 @@ le_result_t le_flash_Close
  * @return
  *      - LE_OK            On success
  *      - LE_BAD_PARAMETER If a parameter is invalid
+ *      - LE_BUSY          If a stream is being written to the partition
  *      - LE_FAULT         On other error
  */
 //--------------------------------------------------------------------------------------------------
@@ -1064,6 +1733,11 @@ le_result_t le_flash_EraseBlock
         return LE_BAD_PARAMETER;
     }
 
+    if (IsStreaming(partPtr))
+    {
+        return LE_BUSY;
+    }
+
     LE_INFO("Erasing block %u in partition \"%s\" MTD%d",
             blockIndex, partPtr->partitionName, partPtr->mtdNum);
 
@@ -1088,6 +1762,7 @@ le_result_t le_flash_EraseBlock
  * @return
  *      - LE_OK            On success
  *      - LE_BAD_PARAMETER If a parameter is invalid
+ *      - LE_BUSY          If a stream is being written to the partition
  *      - LE_NOT_PERMITTED If the partition is an UBI and no UBI volume has been open
  *      - LE_FAULT         On other error
  */
@@ -1109,6 +1784,11 @@ le_result_t le_flash_Read
         return LE_BAD_PARAMETER;
     }
 
+    if (IsStreaming(partPtr))
+    {
+        return LE_BUSY;
+    }
+
     if (partPtr->isUbi)
     {
         if (-1 == partPtr->ubiVolume)
@@ -1165,6 +1845,7 @@ le_result_t le_flash_Read
  * @return
  *      - LE_OK            On success
  *      - LE_BAD_PARAMETER If a parameter is invalid
+ *      - LE_BUSY          If a stream is being written to the partition
  *      - LE_FAULT         On other error
  */
 //--------------------------------------------------------------------------------------------------
@@ -1184,6 +1865,11 @@ le_result_t le_flash_Write
         return LE_BAD_PARAMETER;
     }
 
+    if (IsStreaming(partPtr))
+    {
+        return LE_BUSY;
+    }
+
     if (partPtr->isUbi)
     {
         if (-1 == partPtr->ubiVolume)
@@ -1222,6 +1908,109 @@ le_result_t le_flash_Write
     return res;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the data read from a file descriptor to a flash partition, up to the end of the file. The
+ * data are written block by block from the logical block index given by blockIndex, as by
+ * le_flash_Write(). The file descriptor is closed once read.
+ *
+ * This function returns once the stream is started. The progress of the stream is notified by the
+ * WriteStreamProgress event.
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If a parameter is invalid
+ *      - LE_BUSY          If a stream is already being written to the partition
+ *      - LE_FAULT         On other error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_flash_WriteStream
+(
+    le_flash_PartitionRef_t partitionRef, ///< [IN] Partition reference to be used.
+    uint32_t                blockIndex,   ///< [IN] Logical block index to start at.
+    int                     fd            ///< [IN] File descriptor to read the data from.
+)
+{
+    Partition_t *partPtr = GetPartitionFromRef(partitionRef);
+    Stream_t* streamPtr;
+    size_t blockSize;
+    int flags;
+    int iBlock;
+
+    if (fd < 0)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    if ((NULL == partPtr) || !(partPtr->isWrite) ||
+        ((partPtr->isUbi) && (-1 == partPtr->ubiVolume)))
+    {
+        close(fd);
+        return LE_BAD_PARAMETER;
+    }
+
+    if (IsStreaming(partPtr))
+    {
+        close(fd);
+        return LE_BUSY;
+    }
+
+    blockSize = partPtr->mtdInfo->eraseSize;
+    if (partPtr->isUbi)
+    {
+        blockSize -= (2 * partPtr->mtdInfo->writeSize);
+    }
+    if (blockSize > LE_FLASH_MAX_WRITE_SIZE)
+    {
+        LE_ERROR("Partition \"%s\" MTD%d: Block size %zu too large for a stream",
+                 partPtr->partitionName, partPtr->mtdNum, blockSize);
+        close(fd);
+        return LE_FAULT;
+    }
+
+    flags = fcntl(fd, F_GETFL);
+    if ((-1 == flags) || (-1 == fcntl(fd, F_SETFL, flags | O_NONBLOCK)))
+    {
+        LE_ERROR("fcntl failed on fd %d: %m", fd);
+        close(fd);
+        return LE_FAULT;
+    }
+
+    StreamInit();
+    if (LE_OK != StartFlashThread())
+    {
+        close(fd);
+        return LE_FAULT;
+    }
+
+    LE_INFO("Streaming to partition \"%s\" MTD%d from blockIndex %u",
+            partPtr->partitionName, partPtr->mtdNum, blockIndex);
+
+    streamPtr = le_mem_ForceAlloc(StreamPool);
+    memset(streamPtr, 0, sizeof(Stream_t));
+    streamPtr->partPtr = partPtr;
+    streamPtr->fd = fd;
+    streamPtr->blockSize = blockSize;
+    streamPtr->nextBlockIndex = blockIndex;
+    streamPtr->freeBlockList = LE_SLS_LIST_INIT;
+    streamPtr->result = LE_OK;
+    for (iBlock = 0; iBlock < STREAM_BLOCK_BUFFERS; iBlock++)
+    {
+        StreamBlock_t* blockPtr = le_mem_ForceAlloc(StreamBlockPool);
+
+        blockPtr->link = LE_SLS_LINK_INIT;
+        le_sls_Queue(&streamPtr->freeBlockList, &blockPtr->link);
+    }
+    streamPtr->verifyBlockPtr = le_mem_ForceAlloc(StreamBlockPool);
+    partPtr->streamPtr = streamPtr;
+    StreamCount++;
+
+    streamPtr->fdMonitorRef = le_fdMonitor_Create("FlashStream", fd, StreamReadHandler, POLLIN);
+    le_fdMonitor_SetContextPtr(streamPtr->fdMonitorRef, streamPtr);
+
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Retrieve information about the partition opened: the number of bad blocks found inside the
@@ -1230,6 +2019,7 @@ le_result_t le_flash_Write
  * @return
  *      - LE_OK            On success
  *      - LE_BAD_PARAMETER If a parameter is invalid
+ *      - LE_BUSY          If a stream is being written to the partition
  *      - LE_FAULT         On other error
  */
 //--------------------------------------------------------------------------------------------------
@@ -1252,6 +2042,11 @@ le_result_t le_flash_GetBlockInformation
         return LE_BAD_PARAMETER;
     }
 
+    if (IsStreaming(partPtr))
+    {
+        return LE_BUSY;
+    }
+
     res = pa_flash_GetEccStats(partPtr->desc, &eccStat);
     *badBlocksNumberPtr = eccStat.badBlocks;
     *eraseBlocksNumberPtr = partPtr->mtdInfo->nbLeb;
@@ -1268,6 +2063,7 @@ le_result_t le_flash_GetBlockInformation
  * @return
  *      - LE_OK            On success
  *      - LE_BAD_PARAMETER If a parameter is invalid
+ *      - LE_BUSY          If a stream is being written to the partition
  *      - LE_FAULT         On other error
  */
 //--------------------------------------------------------------------------------------------------
@@ -1289,6 +2085,11 @@ le_result_t le_flash_GetUbiVolumeInformation
         return LE_BAD_PARAMETER;
     }
 
+    if (IsStreaming(partPtr))
+    {
+        return LE_BUSY;
+    }
+
     return pa_flash_GetUbiInfo(partPtr->desc,
                                freeBlockNumberPtr, allocatedBlockNumberPtr, sizeInBytesPtr);
 }
@@ -0,0 +1,1029 @@
+/**
+ * @file pa_flash_file.c
+ *
+ * File-backed implementation of the flash platform adaptor.
+ *
+ * Instead of driving MTD devices, this platform adaptor simulates a NAND flash with files, so that
+ * the flash service can be exercised and benchmarked on a desktop. The partitions are described by
+ * a table in the /proc/mtd format, PA_FLASH_FILE_DIR/mtd:
+ *
+ *     dev:    size   erasesize  name
+ *     mtd0: 00800000 00040000 "system"
+ *
+ * and the content of the partition N is stored in PA_FLASH_FILE_DIR/mtdN.bin, created erased on
+ * first open. The page size is the erase block size / PA_FLASH_FILE_PAGES_PER_BLOCK.
+ *
+ * As on a NAND, a write can only clear bits, so a block must be erased before being written. The
+ * erase, program and read times are simulated by sleeping, PA_FLASH_FILE_ERASE_US per block and
+ * PA_FLASH_FILE_PROGRAM_US and PA_FLASH_FILE_READ_US per page. All of them can be overridden at
+ * build time. There are no bad blocks: the LEB are the PEB. UBI is not supported.
+ *
+ * To build the flash service with this platform adaptor, set
+ * LEGATO_FWUPDATE_PA_FLASH=$LEGATO_ROOT/components/fwupdate/platformAdaptor/file/le_pa_flash_file
+ * and have le_flash read the same table, with
+ * -DLE_FLASH_MTD_TABLE_PATH=\"<PA_FLASH_FILE_DIR>/mtd\".
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "pa_flash.h"
+
+//--------------------------------------------------------------------------------------------------
+// Symbol and Enum definitions.
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Directory of the partition table and of the partition files.
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef PA_FLASH_FILE_DIR
+#define PA_FLASH_FILE_DIR           "/tmp/pa_flash"
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of pages in an erase block.
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef PA_FLASH_FILE_PAGES_PER_BLOCK
+#define PA_FLASH_FILE_PAGES_PER_BLOCK   64
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Simulated time to erase a block, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef PA_FLASH_FILE_ERASE_US
+#define PA_FLASH_FILE_ERASE_US      2000
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Simulated time to program a page, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef PA_FLASH_FILE_PROGRAM_US
+#define PA_FLASH_FILE_PROGRAM_US    200
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Simulated time to read a page, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef PA_FLASH_FILE_READ_US
+#define PA_FLASH_FILE_READ_US       25
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of partitions open at the same time.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_OPEN_PARTITIONS         4
+
+//--------------------------------------------------------------------------------------------------
+// Data structures.
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Descriptor of an open partition.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    int                 fd;             ///< File descriptor of the partition file
+    pa_flash_OpenMode_t mode;           ///< Open mode
+    pa_flash_Info_t     info;           ///< Information of the partition
+    off_t               offset;         ///< Current offset for pa_flash_Read/pa_flash_Write
+    pa_flash_LebToPeb_t lebToPeb;       ///< LEB to PEB table, the identity
+}
+Desc_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of descriptors.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t DescPool;
+
+//--------------------------------------------------------------------------------------------------
+// Local functions.
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Simulate the time taken by a flash operation.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Delay
+(
+    uint32_t us         ///< [IN] Time in microseconds
+)
+{
+    struct timespec ts = { us / 1000000, (us % 1000000) * 1000 };
+
+    while ((-1 == nanosleep(&ts, &ts)) && (EINTR == errno))
+    {
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of pages touched by a data size.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t PageCount
+(
+    Desc_t* descPtr,    ///< [IN] Descriptor
+    size_t  dataSize    ///< [IN] Data size
+)
+{
+    return (dataSize + descPtr->info.writeSize - 1) / descPtr->info.writeSize;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the size and erase block size of a partition from the partition table.
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_NOT_FOUND     If the partition is not in the table
+ *      - LE_FAULT         If the table can't be read
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadPartitionTable
+(
+    int              partNum,   ///< [IN] Partition number
+    pa_flash_Info_t* infoPtr    ///< [OUT] Information filled with the partition geometry
+)
+{
+    FILE* filePtr = fopen(PA_FLASH_FILE_DIR "/mtd", "r");
+    char line[PA_FLASH_MAX_INFO_NAME + 64];
+    le_result_t res = LE_NOT_FOUND;
+
+    if (NULL == filePtr)
+    {
+        LE_ERROR("fopen on " PA_FLASH_FILE_DIR "/mtd failed: %m");
+        return LE_FAULT;
+    }
+
+    while (fgets(line, sizeof(line), filePtr))
+    {
+        int num;
+        uint32_t size;
+        uint32_t eraseSize;
+        char name[PA_FLASH_MAX_INFO_NAME];
+
+        if ((4 == sscanf(line, "mtd%d: %x %x \"%127[^\"]\"", &num, &size, &eraseSize, name)) &&
+            (num == partNum))
+        {
+            if ((0 == eraseSize) || (eraseSize % PA_FLASH_FILE_PAGES_PER_BLOCK) ||
+                (size % eraseSize) || ((size / eraseSize) > PA_FLASH_MAX_LEB))
+            {
+                LE_ERROR("Invalid geometry for mtd%d: size %x erasesize %x",
+                         partNum, size, eraseSize);
+                res = LE_FAULT;
+                break;
+            }
+            memset(infoPtr, 0, sizeof(pa_flash_Info_t));
+            infoPtr->size = size;
+            infoPtr->eraseSize = eraseSize;
+            infoPtr->writeSize = eraseSize / PA_FLASH_FILE_PAGES_PER_BLOCK;
+            infoPtr->nbBlk = size / eraseSize;
+            infoPtr->nbLeb = infoPtr->nbBlk;
+            snprintf(infoPtr->name, sizeof(infoPtr->name), "%s", name);
+            res = LE_OK;
+            break;
+        }
+    }
+
+    fclose(filePtr);
+    return res;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the descriptor and the block index and compute the offset of the block in the file.
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If the descriptor is NULL
+ *      - LE_OUT_OF_RANGE  If the block is outside the partition
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetBlockOffset
+(
+    Desc_t*  descPtr,       ///< [IN] Descriptor
+    uint32_t blockIndex,    ///< [IN] PEB or LEB
+    size_t   dataSize,      ///< [IN] Size of the data to access in the block
+    off_t*   offsetPtr      ///< [OUT] Offset of the block in the file
+)
+{
+    if (NULL == descPtr)
+    {
+        return LE_BAD_PARAMETER;
+    }
+    if ((blockIndex >= descPtr->info.nbLeb) || (dataSize > descPtr->info.eraseSize))
+    {
+        return LE_OUT_OF_RANGE;
+    }
+    *offsetPtr = descPtr->info.startOffset + ((off_t)blockIndex * descPtr->info.eraseSize);
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read data at an offset of the partition file.
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_FAULT         On failure
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadData
+(
+    Desc_t*  descPtr,       ///< [IN] Descriptor
+    off_t    offset,        ///< [IN] Offset in the file
+    uint8_t* dataPtr,       ///< [OUT] Data read
+    size_t   dataSize       ///< [IN] Size of the data
+)
+{
+    if ((ssize_t)dataSize != pread(descPtr->fd, dataPtr, dataSize, offset))
+    {
+        LE_ERROR("pread failed at offset %jd: %m", (intmax_t)offset);
+        return LE_FAULT;
+    }
+    Delay(PageCount(descPtr, dataSize) * PA_FLASH_FILE_READ_US);
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Program data at an offset of the partition file. As on a NAND, bits can only be cleared.
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_FAULT         On failure
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteData
+(
+    Desc_t*        descPtr, ///< [IN] Descriptor
+    off_t          offset,  ///< [IN] Offset in the file
+    const uint8_t* dataPtr, ///< [IN] Data to write
+    size_t         dataSize ///< [IN] Size of the data
+)
+{
+    uint8_t page[descPtr->info.writeSize];
+    size_t done;
+
+    for (done = 0; done < dataSize; done += sizeof(page))
+    {
+        size_t size = dataSize - done;
+        size_t i;
+
+        if (size > sizeof(page))
+        {
+            size = sizeof(page);
+        }
+        if ((ssize_t)size != pread(descPtr->fd, page, size, offset + done))
+        {
+            LE_ERROR("pread failed at offset %jd: %m", (intmax_t)(offset + done));
+            return LE_FAULT;
+        }
+        for (i = 0; i < size; i++)
+        {
+            page[i] &= dataPtr[done + i];
+        }
+        if ((ssize_t)size != pwrite(descPtr->fd, page, size, offset + done))
+        {
+            LE_ERROR("pwrite failed at offset %jd: %m", (intmax_t)(offset + done));
+            return LE_FAULT;
+        }
+    }
+    Delay(PageCount(descPtr, dataSize) * PA_FLASH_FILE_PROGRAM_US);
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Public functions.
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get flash information without opening a flash device
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If infoPtr is NULL
+ *      - LE_FAULT         On failure
+ *      - LE_UNSUPPORTED   If the flash device informations cannot be read
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_flash_GetInfo
+(
+    int partNum,              ///< [IN] Partition number
+    pa_flash_Info_t *infoPtr, ///< [IN] Pointer to copy the flash information
+    bool isLogical,           ///< [IN] Logical partition
+    bool isDual               ///< [IN] Dual of a logical partition
+)
+{
+    le_result_t res;
+
+    if (NULL == infoPtr)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    res = ReadPartitionTable(partNum, infoPtr);
+    if (LE_OK != res)
+    {
+        return (LE_NOT_FOUND == res ? LE_UNSUPPORTED : res);
+    }
+
+    if (isLogical)
+    {
+        infoPtr->logical = true;
+        infoPtr->nbBlk /= 2;
+        infoPtr->nbLeb = infoPtr->nbBlk;
+        infoPtr->size = infoPtr->nbBlk * infoPtr->eraseSize;
+        infoPtr->startOffset = (isDual ? infoPtr->size : 0);
+    }
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Retrieve flash information of opening a flash device
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If desc is NULL or not a valid flash descriptor or infoPtr is NULL
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_flash_RetrieveInfo
+(
+    pa_flash_Desc_t desc,     ///< [IN] Private flash descriptor
+    pa_flash_Info_t **infoPtr ///< [IN] Pointer to copy the flash information
+)
+{
+    if ((NULL == desc) || (NULL == infoPtr))
+    {
+        return LE_BAD_PARAMETER;
+    }
+    *infoPtr = &((Desc_t*)desc)->info;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the ECC and bad blocks statistics
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If desc is NULL or isBadBlockPtr is NULL
+ *      - LE_FAULT         On failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_flash_GetEccStats
+(
+    pa_flash_Desc_t      desc,       ///< [IN] Private flash descriptor
+    pa_flash_EccStats_t *eccStatsPtr ///< [IN] Pointer to copy the ECC and bad blocks statistics
+)
+{
+    if ((NULL == desc) || (NULL == eccStatsPtr))
+    {
+        return LE_BAD_PARAMETER;
+    }
+    memset(eccStatsPtr, 0, sizeof(pa_flash_EccStats_t));
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open a flash device for the given operation and return a descriptor
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If desc is NULL or if mode is not correct
+ *      - LE_FAULT         On failure
+ *      - LE_UNSUPPORTED   If the flash device cannot be opened
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_flash_Open
+(
+    int partNum,              ///< [IN] Partition number
+    pa_flash_OpenMode_t mode, ///< [IN] Open mode for this flash partition
+    pa_flash_Desc_t *descPtr, ///< [OUT] Private flash descriptor
+    pa_flash_Info_t **infoPtr ///< [OUT] Pointer to the flash information (may be NULL)
+)
+{
+    char path[PATH_MAX];
+    struct stat st;
+    Desc_t* fdescPtr;
+    bool isLogical = (PA_FLASH_OPENMODE_LOGICAL & mode) ? true : false;
+    bool isDual = (PA_FLASH_OPENMODE_LOGICAL_DUAL == (PA_FLASH_OPENMODE_LOGICAL_DUAL & mode));
+    uint32_t size;
+    uint32_t iBlk;
+    le_result_t res;
+
+    if ((NULL == descPtr) ||
+        (0 == (mode & (PA_FLASH_OPENMODE_READONLY | PA_FLASH_OPENMODE_WRITEONLY |
+                       PA_FLASH_OPENMODE_READWRITE))))
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    if (PA_FLASH_OPENMODE_UBI & mode)
+    {
+        return LE_UNSUPPORTED;
+    }
+
+    fdescPtr = le_mem_ForceAlloc(DescPool);
+    memset(fdescPtr, 0, sizeof(Desc_t));
+    fdescPtr->mode = mode;
+
+    res = pa_flash_GetInfo(partNum, &fdescPtr->info, isLogical, isDual);
+    if (LE_OK != res)
+    {
+        le_mem_Release(fdescPtr);
+        return res;
+    }
+
+    // The file holds the whole physical partition.
+    size = fdescPtr->info.size * (isLogical ? 2 : 1);
+    snprintf(path, sizeof(path), PA_FLASH_FILE_DIR "/mtd%d.bin", partNum);
+    fdescPtr->fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if ((-1 == fdescPtr->fd) || (-1 == fstat(fdescPtr->fd, &st)))
+    {
+        LE_ERROR("Unable to open %s: %m", path);
+        goto error;
+    }
+
+    // Create the missing blocks erased.
+    if (st.st_size < size)
+    {
+        uint8_t erased[fdescPtr->info.writeSize];
+        off_t offset;
+
+        memset(erased, PA_FLASH_ERASED_VALUE, sizeof(erased));
+        for (offset = st.st_size; offset < size; offset += sizeof(erased))
+        {
+            if ((ssize_t)sizeof(erased) != pwrite(fdescPtr->fd, erased, sizeof(erased), offset))
+            {
+                LE_ERROR("Unable to create %s: %m", path);
+                goto error;
+            }
+        }
+    }
+
+    for (iBlk = 0; iBlk < fdescPtr->info.nbBlk; iBlk++)
+    {
+        fdescPtr->lebToPeb.lebToPeb[iBlk] = iBlk;
+    }
+
+    *descPtr = fdescPtr;
+    if (infoPtr)
+    {
+        *infoPtr = &fdescPtr->info;
+    }
+    LE_DEBUG("mtd%d open: %s", partNum, path);
+    return LE_OK;
+
+error:
+    if (-1 != fdescPtr->fd)
+    {
+        close(fdescPtr->fd);
+    }
+    le_mem_Release(fdescPtr);
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close a flash descriptor
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If desc is NULL or not a valid flash descriptor
+ *      - LE_FAULT         On failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_flash_Close
+(
+    pa_flash_Desc_t desc      ///< [IN] Private flash descriptor
+)
+{
+    Desc_t* descPtr = desc;
+
+    if (NULL == descPtr)
+    {
+        return LE_BAD_PARAMETER;
+    }
+    close(descPtr->fd);
+    le_mem_Release(descPtr);
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Scan a flash and produce a list of LEB and PEB. As there are no bad blocks, the LEB are the PEB.
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If desc is NULL or not a valid flash descriptor
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_flash_Scan
+(
+    pa_flash_Desc_t desc,     ///< [IN] Private flash descriptor
+    pa_flash_LebToPeb_t **lebToPebPtr
+                              ///< [OUT] Pointer to a LEB to PEB table (may be NULL)
+)
+{
+    Desc_t* descPtr = desc;
+
+    if (NULL == descPtr)
+    {
+        return LE_BAD_PARAMETER;
+    }
+    if (lebToPebPtr)
+    {
+        *lebToPebPtr = &descPtr->lebToPeb;
+    }
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Clear the scanned list of LEB and set all to PEB
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If desc is NULL or not a valid flash descriptor
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_flash_Unscan
+(
+    pa_flash_Desc_t desc      ///< [IN] Private flash descriptor
+)
+{
+    return (desc ? LE_OK : LE_BAD_PARAMETER);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a block is bad. There are no bad blocks.
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If desc is NULL or not a valid flash descriptor
+ *      - LE_OUT_OF_RANGE  If the block is outside the partition
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_flash_CheckBadBlock
+(
+    pa_flash_Desc_t desc,     ///< [IN] Private flash descriptor
+    uint32_t blockIndex,      ///< [IN] PEB or LEB to be checked
+    bool *isBadBlockPtr       ///< [OUT] true if bad block, false else
+)
+{
+    off_t offset;
+    le_result_t res = GetBlockOffset(desc, blockIndex, 0, &offset);
+
+    if ((LE_OK == res) && (NULL == isBadBlockPtr))
+    {
+        res = LE_BAD_PARAMETER;
+    }
+    if (LE_OK == res)
+    {
+        *isBadBlockPtr = false;
+    }
+    return res;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mark a block as bad. Bad blocks are not simulated.
+ *
+ * @return
+ *      - LE_UNSUPPORTED   Always
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_flash_MarkBadBlock
+(
+    pa_flash_Desc_t desc,     ///< [IN] Private flash descriptor
+    uint32_t blockIndex       ///< [IN] PEB or LEB to be marked bad
+)
+{
+    return LE_UNSUPPORTED;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Erase a block
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If desc is NULL or not a valid flash descriptor
+ *      - LE_OUT_OF_RANGE  If the block is outside the partition
+ *      - LE_FAULT         On failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_flash_EraseBlock
+(
+    pa_flash_Desc_t desc,     ///< [IN] Private flash descriptor
+    uint32_t blockIndex       ///< [IN] PEB or LEB to erase
+)
+{
+    Desc_t* descPtr = desc;
+    off_t offset;
+    le_result_t res = GetBlockOffset(descPtr, blockIndex, 0, &offset);
+
+    if (LE_OK != res)
+    {
+        return res;
+    }
+
+    uint8_t erased[descPtr->info.writeSize];
+    uint32_t done;
+
+    memset(erased, PA_FLASH_ERASED_VALUE, sizeof(erased));
+    for (done = 0; done < descPtr->info.eraseSize; done += sizeof(erased))
+    {
+        if ((ssize_t)sizeof(erased) != pwrite(descPtr->fd, erased, sizeof(erased), offset + done))
+        {
+            LE_ERROR("pwrite failed at offset %jd: %m", (intmax_t)(offset + done));
+            return LE_FAULT;
+        }
+    }
+    Delay(PA_FLASH_FILE_ERASE_US);
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Seek at an offset
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If desc is NULL or not a valid flash descriptor
+ *      - LE_OUT_OF_RANGE  If the offset is outside the partition
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_flash_SeekAtOffset
+(
+    pa_flash_Desc_t desc,     ///< [IN] Private flash descriptor
+    off_t offset              ///< [IN] Physical or Logical offset to seek
+)
+{
+    Desc_t* descPtr = desc;
+
+    if (NULL == descPtr)
+    {
+        return LE_BAD_PARAMETER;
+    }
+    if ((offset < 0) || (offset > descPtr->info.size))
+    {
+        return LE_OUT_OF_RANGE;
+    }
+    descPtr->offset = offset;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Seek at a block
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If desc is NULL or not a valid flash descriptor
+ *      - LE_OUT_OF_RANGE  If the block is outside the partition
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_flash_SeekAtBlock
+(
+    pa_flash_Desc_t desc,     ///< [IN] Private flash descriptor
+    uint32_t blockIndex       ///< [IN] PEB or LEB to seek
+)
+{
+    Desc_t* descPtr = desc;
+
+    if (NULL == descPtr)
+    {
+        return LE_BAD_PARAMETER;
+    }
+    if (blockIndex >= descPtr->info.nbLeb)
+    {
+        return LE_OUT_OF_RANGE;
+    }
+    descPtr->offset = (off_t)blockIndex * descPtr->info.eraseSize;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read data at the current offset, and move the offset after the data read
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If desc is NULL or not a valid flash descriptor
+ *      - LE_OUT_OF_RANGE  If the data are outside the partition
+ *      - LE_FAULT         On failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_flash_Read
+(
+    pa_flash_Desc_t desc,     ///< [IN] Private flash descriptor
+    uint8_t *dataPtr,         ///< [IN] Pointer to data to be read
+    size_t dataSize           ///< [IN] Size of data to read
+)
+{
+    Desc_t* descPtr = desc;
+    le_result_t res;
+
+    if ((NULL == descPtr) || (NULL == dataPtr))
+    {
+        return LE_BAD_PARAMETER;
+    }
+    if ((descPtr->offset + dataSize) > descPtr->info.size)
+    {
+        return LE_OUT_OF_RANGE;
+    }
+    res = ReadData(descPtr, descPtr->info.startOffset + descPtr->offset, dataPtr, dataSize);
+    if (LE_OK == res)
+    {
+        descPtr->offset += dataSize;
+    }
+    return res;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write data at the current offset, and move the offset after the data written
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If desc is NULL or not a valid flash descriptor
+ *      - LE_OUT_OF_RANGE  If the data are outside the partition
+ *      - LE_FAULT         On failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_flash_Write
+(
+    pa_flash_Desc_t desc,     ///< [IN] Private flash descriptor
+    uint8_t *dataPtr,         ///< [IN] Pointer to data to be written
+    size_t dataSize           ///< [IN] Size of data to write
+)
+{
+    Desc_t* descPtr = desc;
+    le_result_t res;
+
+    if ((NULL == descPtr) || (NULL == dataPtr))
+    {
+        return LE_BAD_PARAMETER;
+    }
+    if ((descPtr->offset + dataSize) > descPtr->info.size)
+    {
+        return LE_OUT_OF_RANGE;
+    }
+    res = WriteData(descPtr, descPtr->info.startOffset + descPtr->offset, dataPtr, dataSize);
+    if (LE_OK == res)
+    {
+        descPtr->offset += dataSize;
+    }
+    return res;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read data at the start of a block
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If desc is NULL or not a valid flash descriptor
+ *      - LE_OUT_OF_RANGE  If the block is outside the partition or the size over the block
+ *      - LE_FAULT         On failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_flash_ReadAtBlock
+(
+    pa_flash_Desc_t desc,     ///< [IN] Private flash descriptor
+    uint32_t blockIndex,      ///< [IN] PEB or LEB to read
+    uint8_t *dataPtr,         ///< [IN] Pointer to data to be read
+    size_t dataSize           ///< [IN] Size of data to read
+)
+{
+    off_t offset;
+    le_result_t res = GetBlockOffset(desc, blockIndex, dataSize, &offset);
+
+    if ((LE_OK == res) && (NULL == dataPtr))
+    {
+        res = LE_BAD_PARAMETER;
+    }
+    if (LE_OK == res)
+    {
+        res = ReadData(desc, offset, dataPtr, dataSize);
+    }
+    return res;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write data at the start of a block
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If desc is NULL or not a valid flash descriptor
+ *      - LE_OUT_OF_RANGE  If the block is outside the partition or the size over the block
+ *      - LE_FAULT         On failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_flash_WriteAtBlock
+(
+    pa_flash_Desc_t desc,     ///< [IN] Private flash descriptor
+    uint32_t blockIndex,      ///< [IN] PEB or LEB to write
+    uint8_t *dataPtr,         ///< [IN] Pointer to data to be written
+    size_t dataSize           ///< [IN] Size of data to write
+)
+{
+    off_t offset;
+    le_result_t res = GetBlockOffset(desc, blockIndex, dataSize, &offset);
+
+    if ((LE_OK == res) && (NULL == dataPtr))
+    {
+        res = LE_BAD_PARAMETER;
+    }
+    if (LE_OK == res)
+    {
+        res = WriteData(desc, offset, dataPtr, dataSize);
+    }
+    return res;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if the partition is an UBI container. It never is.
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If desc is NULL or isUbiPtr is NULL
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_flash_CheckUbi
+(
+    pa_flash_Desc_t desc,    ///< [IN]  Private flash descriptor
+    bool *isUbiPtr           ///< [OUT] true if the partition is an UBI container, false otherwise
+)
+{
+    if ((NULL == desc) || (NULL == isUbiPtr))
+    {
+        return LE_BAD_PARAMETER;
+    }
+    *isUbiPtr = false;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The UBI functions are not supported by this platform adaptor.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_flash_ScanUbiForVolumes
+(
+    pa_flash_Desc_t desc,            ///< [IN] Private flash descriptor
+    uint32_t*       ubiVolNumberPtr, ///< [OUT] UBI volume number found
+    char            ubiVolName[PA_FLASH_UBI_MAX_VOLUMES][PA_FLASH_UBI_MAX_VOLUMES]
+                                     ///< [OUT] UBI volume name array
+)
+{
+    return LE_UNSUPPORTED;
+}
+
+le_result_t pa_flash_ScanUbi
+(
+    pa_flash_Desc_t desc,     ///< [IN] Private flash descriptor
+    uint32_t ubiVolId         ///< [IN] UBI volume ID
+)
+{
+    return LE_UNSUPPORTED;
+}
+
+le_result_t pa_flash_UnscanUbi
+(
+    pa_flash_Desc_t desc      ///< [IN] Private flash descriptor
+)
+{
+    return LE_UNSUPPORTED;
+}
+
+le_result_t pa_flash_ReadUbiAtBlock
+(
+    pa_flash_Desc_t desc,     ///< [IN] Private flash descriptor
+    uint32_t leb,             ///< [IN] LEB to read
+    uint8_t *dataPtr,         ///< [IN] Pointer to data to be read
+    size_t *dataSizePtr       ///< [IN][OUT] Pointer to size to read
+)
+{
+    return LE_UNSUPPORTED;
+}
+
+le_result_t pa_flash_WriteUbiAtBlock
+(
+    pa_flash_Desc_t desc,     ///< [IN] Private flash descriptor
+    uint32_t leb,             ///< [IN] LEB to write
+    uint8_t *dataPtr,         ///< [IN] Pointer to data to be written
+    size_t dataSize,          ///< [IN] Size to be written
+    bool isExtendUbiVolume    ///< [IN] True if the volume may be extended by one block if write
+                              ///<      is the leb is outside the current volume
+)
+{
+    return LE_UNSUPPORTED;
+}
+
+le_result_t pa_flash_AdjustUbiSize
+(
+    pa_flash_Desc_t desc,     ///< [IN] Private flash descriptor
+    size_t newSize            ///< [IN] Final size of the UBI volume
+)
+{
+    return LE_UNSUPPORTED;
+}
+
+le_result_t pa_flash_GetUbiInfo
+(
+    pa_flash_Desc_t desc,         ///< [IN] Private flash descriptor
+    uint32_t*       freeBlockPtr, ///< [OUT] Free blocks number in the UBI partition
+    uint32_t*       volBlockPtr,  ///< [OUT] Allocated blocks number belonging to the volume
+    uint32_t*       volSizePtr    ///< [OUT] Real volume size
+)
+{
+    return LE_UNSUPPORTED;
+}
+
+le_result_t pa_flash_CheckUbiMagic
+(
+    void*    data,       ///< [IN] buffer to check
+    uint32_t pattern     ///< [IN] the pattern to check
+)
+{
+    return LE_UNSUPPORTED;
+}
+
+le_result_t pa_flash_CalculateDataLength
+(
+    int         pageSize,       ///< [IN] min I/O of the device
+    const void* data,           ///< [IN] a buffer with the contents of the physical eraseblock
+    uint32_t*   dataSize        ///< [INOUT] input : the buffer length
+                                ///<         output: real data length align with pages size
+)
+{
+    return LE_UNSUPPORTED;
+}
+
+le_result_t pa_flash_CreateUbi
+(
+    pa_flash_Desc_t desc,           ///< [IN] Private flash descriptor
+    bool            isForcedCreate  ///< [IN] If set to true the UBI partition is overwriten and the
+                                    ///<      previous content is lost
+)
+{
+    return LE_UNSUPPORTED;
+}
+
+le_result_t pa_flash_CreateUbiVolume
+(
+    pa_flash_Desc_t desc,      ///< [IN] Private flash descriptor
+    uint32_t ubiVolId,         ///< [IN] UBI volume ID
+    const char* ubiVolNamePtr, ///< [IN] UBI volume name
+    uint32_t ubiVolType,       ///< [IN] UBI volume type: dynamic or static
+    uint32_t ubiVolSize        ///< [IN] UBI volume size (for dynamic volumes only)
+)
+{
+    return LE_UNSUPPORTED;
+}
+
+le_result_t pa_flash_DeleteUbiVolume
+(
+    pa_flash_Desc_t desc,     ///< [IN] Private flash descriptor
+    uint32_t ubiVolId         ///< [IN] UBI volume ID
+)
+{
+    return LE_UNSUPPORTED;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Init this component
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    DescPool = le_mem_CreatePool("PaFlashFileDescPool", sizeof(Desc_t));
+    le_mem_ExpandPool(DescPool, MAX_OPEN_PARTITIONS);
+}
@@ -32,7 +32,6 @@
 //--------------------------------------------------------------------------------------------------
 #define WDOG_THREAD_NAME_MDC_COMMAND_EVENT "CommandEventThread"
 #define WDOG_THREAD_NAME_MRC_COMMAND_PROCESS "ProcessMrcCommandHandler"
-#define WDOG_THREAD_NAME_SMS_COMMAND_SENDING "ProcessSmsSendingCommandHandler"
 
 //--------------------------------------------------------------------------------------------------
 /**
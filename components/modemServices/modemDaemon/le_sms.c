@@ -71,15 +71,13 @@
 
 //--------------------------------------------------------------------------------------------------
 /**
- * SMS command Type.
- *
+ * Default and maximum number of sender threads for the messages sent asynchronously. The modem is
+ * still given one message at a time: further threads report the result of a message while the
+ * next one is sent.
  */
 //--------------------------------------------------------------------------------------------------
-typedef enum
-{
-    LE_SMS_CMD_TYPE_SEND    = 0 ///< Pool and send SMS message.
-}
-CmdType_t;
+#define SMS_SEND_IN_FLIGHT_DEFAULT  1
+#define SMS_SEND_IN_FLIGHT_MAX      4
 
 //--------------------------------------------------------------------------------------------------
 // Data structures.
@@ -166,15 +164,70 @@ typedef struct le_sms_MsgList
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Sms message sending command structure.
+ * Batch of messages sent with le_sms_SendBatchAsync().
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_sms_CallbackResultFunc_t callBackPtr;    ///< Callback response.
+    void*                       ctxPtr;         ///< Context.
+    uint32_t                    remaining;      ///< Messages which sending is not complete.
+    uint32_t                    failedIndex;    ///< Index of the first message not sent.
+    le_sms_MsgRef_t             resultRef;      ///< Message given to the callback.
+    le_sms_Status_t             resultStatus;   ///< Status given to the callback.
+}
+SendBatch_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sms message sending request structure, queued in SendQueue until a sender thread is idle.
  *
+ * The request holds a reference on the message object, so that the object stays valid while the
+ * message is sent even if the client deletes it.
  */
 //--------------------------------------------------------------------------------------------------
 typedef struct
 {
-    CmdType_t           command;        ///< The command.
     le_sms_MsgRef_t     msgRef;         ///< The message reference.
-} CmdRequest_t;
+    le_sms_Msg_t*       msgPtr;         ///< The message object.
+    SendBatch_t*        batchPtr;       ///< Batch of the message, or NULL.
+    uint32_t            batchIndex;     ///< Index of the message in its batch.
+    le_clk_Time_t       queuedTime;     ///< Relative time of the queueing.
+    le_dls_Link_t       link;           ///< Link for SendQueue.
+}
+SendRequest_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sender thread structure.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_thread_Ref_t     threadRef;      ///< Sender thread.
+    uint32_t            index;          ///< Index of the sender thread.
+    SendRequest_t*      requestPtr;     ///< Request being sent, or NULL if the thread is idle.
+}
+SmsSender_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Data structure for the statistics of the messages sent asynchronously.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t queueDepth;        ///< Number of messages waiting to be sent.
+    uint32_t inFlight;          ///< Number of messages being sent.
+    uint32_t sentCount;         ///< Number of messages which sending is complete.
+    uint64_t totalLatencyMs;    ///< Total sending time of these messages, in milliseconds.
+    uint32_t maxLatencyMs;      ///< Maximum sending time of these messages, in milliseconds.
+}
+SendStats_t;
 
 
 //--------------------------------------------------------------------------------------------------
@@ -261,6 +314,16 @@ static le_mem_PoolRef_t   MsgPool;
 //--------------------------------------------------------------------------------------------------
 static le_ref_MapRef_t MsgRefMap;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mutex protecting MsgRefMap against the sender threads, which look message references up while
+ * the main thread creates and deletes them. Only the main thread changes the map, so it looks
+ * references up without locking.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mutex_Ref_t MsgRefMapMutex;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Memory Pool for Listed SMS messages.
@@ -327,14 +390,45 @@ static le_event_Id_t StorageStatusEventId;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Event ID for message sending commands.
+ * Memory Pools for message sending requests and batches.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t   SendRequestPool;
+static le_mem_PoolRef_t   SendBatchPool;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue of the messages waiting for an idle sender thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_dls_List_t SendQueue;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sender threads, and their number.
+ */
+//--------------------------------------------------------------------------------------------------
+static SmsSender_t SmsSenders[SMS_SEND_IN_FLIGHT_MAX];
+static uint32_t SmsSendersCount;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mutex protecting the send queue, the requests of the sender threads, the batches, the
+ * statistics of the messages sent asynchronously and the count of the messages sent.
  */
 //--------------------------------------------------------------------------------------------------
-static le_event_Id_t SmsCommandEventId;
+static le_mutex_Ref_t SendQueueMutex;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Semaphore to synchronize threads.
+ * Statistics of the messages sent asynchronously.
+ */
+//--------------------------------------------------------------------------------------------------
+static SendStats_t SendStats;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Semaphore to synchronize threads. Binary: it serializes the calls to the platform adaptor.
  */
 //--------------------------------------------------------------------------------------------------
 static le_sem_Ref_t SmsSem;
@@ -384,6 +478,35 @@ static bool GetCountingState
     return countingState;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the number of messages sent asynchronously at the same time
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t GetSendInFlight
+(
+    void
+)
+{
+    int32_t inFlight;
+    le_cfg_IteratorRef_t iteratorRef;
+
+    iteratorRef = le_cfg_CreateReadTxn(CFG_MODEMSERVICE_SMS_PATH);
+    inFlight = le_cfg_GetInt(iteratorRef, CFG_NODE_SEND_IN_FLIGHT, SMS_SEND_IN_FLIGHT_DEFAULT);
+    le_cfg_CancelTxn(iteratorRef);
+
+    if ((inFlight < 1) || (inFlight > SMS_SEND_IN_FLIGHT_MAX))
+    {
+        LE_WARN("Invalid number of messages in flight %" PRId32 ", using %d", inFlight,
+                SMS_SEND_IN_FLIGHT_DEFAULT);
+        inFlight = SMS_SEND_IN_FLIGHT_DEFAULT;
+    }
+
+    LE_DEBUG("Retrieved number of messages in flight: %" PRId32, inFlight);
+
+    return inFlight;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Write the message counting state
@@ -492,6 +615,27 @@ static le_result_t SetMessageCount
     return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Count a message successfully sent, if message counting is activated.
+ *
+ * @note The sender threads count their messages at the same time, so the count is read and
+ *       written with SendQueueMutex locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CountSentMessage
+(
+    void
+)
+{
+    le_mutex_Lock(SendQueueMutex);
+    if (MessageStats.counting)
+    {
+        SetMessageCount(LE_SMS_TYPE_TX, MessageStats.txCount + 1);
+    }
+    le_mutex_Unlock(SendQueueMutex);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Initialize message statistics structure
@@ -560,6 +704,61 @@ static void SetStatusReportState
     StatusReportActivation = statusReportState;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a Safe Reference for a message object.
+ *
+ * @note Called in the main thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_sms_MsgRef_t CreateMsgRef
+(
+    le_sms_Msg_t* msgPtr    ///< [IN] Message object.
+)
+{
+    le_mutex_Lock(MsgRefMapMutex);
+    le_sms_MsgRef_t msgRef = le_ref_CreateRef(MsgRefMap, msgPtr);
+    le_mutex_Unlock(MsgRefMapMutex);
+
+    return msgRef;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Invalidate the Safe Reference of a message object.
+ *
+ * @note Called in the main thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeleteMsgRef
+(
+    le_sms_MsgRef_t msgRef  ///< [IN] Message reference.
+)
+{
+    le_mutex_Lock(MsgRefMapMutex);
+    le_ref_DeleteRef(MsgRefMap, msgRef);
+    le_mutex_Unlock(MsgRefMapMutex);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Look a message reference up from a sender thread.
+ *
+ * @return The message object, or NULL if the reference was deleted.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_sms_Msg_t* LookupMsgRefFromSender
+(
+    le_sms_MsgRef_t msgRef  ///< [IN] Message reference.
+)
+{
+    le_mutex_Lock(MsgRefMapMutex);
+    le_sms_Msg_t* msgPtr = le_ref_Lookup(MsgRefMap, msgRef);
+    le_mutex_Unlock(MsgRefMapMutex);
+
+    return msgPtr;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Re-initialize a List.
@@ -600,7 +799,7 @@ static void ReInitializeList
             msgPtr->smsUserCount --;
 
             // Invalidate the Safe Reference.
-            le_ref_DeleteRef(MsgRefMap, nodePtr->msgRef);
+            DeleteMsgRef(nodePtr->msgRef);
 
             // release the message object.
             le_mem_Release(msgPtr);
@@ -1045,7 +1244,7 @@ static int32_t GetMessagesFromMem
                                 (le_sms_MsgReference_t*)le_mem_ForceAlloc(ReferencePool);
 
                 // Create a Safe Reference for this Message object.
-                newReferencePtr->msgRef = le_ref_CreateRef(MsgRefMap, newSmsMsgObjPtr);
+                newReferencePtr->msgRef = CreateMsgRef(newSmsMsgObjPtr);
                 (newSmsMsgObjPtr->smsUserCount)++;
 
                 LE_DEBUG("create reference node[%p], obj[%p], ref[%p], cpt (%d)",
@@ -1081,7 +1280,7 @@ static int32_t GetMessagesFromMem
             le_sms_MsgReference_t* newReferencePtr =
                             (le_sms_MsgReference_t*)le_mem_ForceAlloc(ReferencePool);
             // Create a Safe Reference for this Message object.
-            newReferencePtr->msgRef = le_ref_CreateRef(MsgRefMap, newSmsMsgObjPtr);
+            newReferencePtr->msgRef = CreateMsgRef(newSmsMsgObjPtr);
             (newSmsMsgObjPtr->smsUserCount)++;
 
             LE_DEBUG("create reference node[%p], obj[%p], ref[%p], cpt (%d)",
@@ -1518,7 +1717,7 @@ static le_sms_MsgRef_t SetMsgRefForSessionCtx
 
     MsgRefNode_t* msgNodePtr = le_mem_ForceAlloc(MsgRefPool);
 
-    msgNodePtr->msgRef = le_ref_CreateRef(MsgRefMap, msgPtr);
+    msgNodePtr->msgRef = CreateMsgRef(msgPtr);
     msgNodePtr->link = LE_DLS_LINK_INIT;
     le_dls_Queue(&(sessionCtxPtr->msgRefList), &(msgNodePtr->link));
 
@@ -1551,7 +1750,7 @@ static void RemoveMsgRefFromSessionCtx
         {
             // Remove this node.
             LE_DEBUG("Remove msgRef %p from sessionCtxPtr %p", msgRef, sessionCtxPtr);
-            le_ref_DeleteRef(MsgRefMap, msgRefPtr->msgRef);
+            DeleteMsgRef(msgRefPtr->msgRef);
             le_dls_Remove(&(sessionCtxPtr->msgRefList), &(msgRefPtr->link));
             le_mem_Release(msgRefPtr);
             return;
@@ -1969,7 +2168,7 @@ static le_result_t CheckAndEncodeMessage
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Send connection state event.
+ * Send connection state event. Called in a sender thread.
  */
 //--------------------------------------------------------------------------------------------------
 static void SendSmsSendingStateEvent
@@ -1977,7 +2176,7 @@ static void SendSmsSendingStateEvent
     le_sms_MsgRef_t messageRef
 )
 {
-    le_sms_Msg_t* msgPtr = le_ref_Lookup(MsgRefMap, messageRef);
+    le_sms_Msg_t* msgPtr = LookupMsgRefFromSender(messageRef);
     if (NULL == msgPtr)
     {
         LE_ERROR("Message Null");
@@ -1993,9 +2192,9 @@ static void SendSmsSendingStateEvent
                  Myfunction, messageRef, msgPtr->pdu.status);
 
         // Update sent message count if necessary
-        if ((MessageStats.counting) && (LE_SMS_SENT == msgPtr->pdu.status))
+        if (LE_SMS_SENT == msgPtr->pdu.status)
         {
-            SetMessageCount(LE_SMS_TYPE_TX, MessageStats.txCount + 1);
+            CountSentMessage();
         }
 
         Myfunction(messageRef, msgPtr->pdu.status, msgPtr->ctxPtr);
@@ -2007,6 +2206,260 @@ static void SendSmsSendingStateEvent
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Account for the end of the sending of a message in its batch.
+ *
+ * @note Called with SendQueueMutex locked.
+ *
+ * @return True if the sending of all the messages of the batch is complete.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool UpdateBatch
+(
+    SendBatch_t*    batchPtr,   ///< [IN] Batch of the message.
+    le_sms_MsgRef_t messageRef, ///< [IN] Message reference.
+    uint32_t        index,      ///< [IN] Index of the message in the batch.
+    le_sms_Status_t status      ///< [IN] Sending status of the message.
+)
+{
+    // Report the first message of the batch which could not be sent
+    if ((LE_SMS_SENT != status) && (index < batchPtr->failedIndex))
+    {
+        batchPtr->failedIndex = index;
+        batchPtr->resultRef = messageRef;
+        batchPtr->resultStatus = status;
+    }
+
+    batchPtr->remaining--;
+    return (0 == batchPtr->remaining);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop a batch after one of its messages could not be sent: its messages still in the send queue
+ * are removed from it and go back to the LE_SMS_UNSENT state. The removed requests are moved to a
+ * list, to be released once SendQueueMutex is unlocked.
+ *
+ * @note Called with SendQueueMutex locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CancelBatch
+(
+    SendBatch_t*    batchPtr,           ///< [IN] Batch to stop.
+    le_dls_List_t*  cancelledListPtr    ///< [OUT] List of the removed requests.
+)
+{
+    le_dls_Link_t* linkPtr = le_dls_Peek(&SendQueue);
+
+    while (NULL != linkPtr)
+    {
+        SendRequest_t* requestPtr = CONTAINER_OF(linkPtr, SendRequest_t, link);
+
+        linkPtr = le_dls_PeekNext(&SendQueue, linkPtr);
+
+        if (batchPtr == requestPtr->batchPtr)
+        {
+            le_dls_Remove(&SendQueue, &requestPtr->link);
+            le_dls_Queue(cancelledListPtr, &requestPtr->link);
+            requestPtr->msgPtr->pdu.status = LE_SMS_UNSENT;
+            SendStats.queueDepth--;
+            batchPtr->remaining--;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Declaration of the sending of a message, queued to the sender threads.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendPduMsg(void* param1Ptr, void* param2Ptr);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Give the queued messages to the idle sender threads.
+ *
+ * @note Called with SendQueueMutex locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DispatchSendQueue
+(
+    void
+)
+{
+    uint32_t i;
+
+    for (i = 0; (i < SmsSendersCount) && (!le_dls_IsEmpty(&SendQueue)); i++)
+    {
+        SmsSender_t* senderPtr = &SmsSenders[i];
+
+        if (NULL == senderPtr->requestPtr)
+        {
+            senderPtr->requestPtr = CONTAINER_OF(le_dls_Pop(&SendQueue), SendRequest_t, link);
+            SendStats.queueDepth--;
+            SendStats.inFlight++;
+            le_event_QueueFunctionToThread(senderPtr->threadRef, SendPduMsg, senderPtr, NULL);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a message on the modem, give the next queued message to the sender thread, and report the
+ * sending result. Called in a sender thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendPduMsg
+(
+    void* param1Ptr,    ///< [IN] Sender thread.
+    void* param2Ptr     ///< [IN] Unused.
+)
+{
+    SmsSender_t* senderPtr = param1Ptr;
+    SendRequest_t* requestPtr = senderPtr->requestPtr;
+    le_sms_Msg_t* msgPtr = requestPtr->msgPtr;
+    le_sms_MsgRef_t messageRef = requestPtr->msgRef;
+    SendBatch_t* batchPtr = requestPtr->batchPtr;
+    bool isValid = (msgPtr == LookupMsgRefFromSender(messageRef));
+    bool isBatchComplete = false;
+    le_dls_List_t cancelledList = LE_DLS_LIST_INIT;
+    le_sms_Status_t status;
+    le_result_t res;
+
+    if (isValid)
+    {
+        le_sem_Wait(SmsSem);
+        LE_INFO("Send message (%p) on sender %u", messageRef, senderPtr->index);
+
+        res = pa_sms_SendPduMsg(msgPtr->protocol, msgPtr->pdu.dataLen, msgPtr->pdu.data,
+                                &msgPtr->messageReference, PA_SMS_SENDING_TIMEOUT,
+                                &msgPtr->pdu.errorCode);
+        le_sem_Post(SmsSem);
+    }
+    else
+    {
+        // The message was deleted by its client while it was queued
+        LE_DEBUG("No more message reference (%p) valid", messageRef);
+        res = LE_FAULT;
+    }
+
+    if (LE_OK == res)
+    {
+        status = LE_SMS_SENT;
+    }
+    else if (LE_TIMEOUT == res)
+    {
+        status = LE_SMS_SENDING_TIMEOUT;
+    }
+    else
+    {
+        status = LE_SMS_SENDING_FAILED;
+    }
+
+    le_clk_Time_t latency = le_clk_Sub(le_clk_GetRelativeTime(), requestPtr->queuedTime);
+    uint32_t latencyMs = (latency.sec * 1000) + (latency.usec / 1000);
+
+    le_mutex_Lock(SendQueueMutex);
+
+    senderPtr->requestPtr = NULL;
+    SendStats.inFlight--;
+    SendStats.sentCount++;
+    SendStats.totalLatencyMs += latencyMs;
+    if (latencyMs > SendStats.maxLatencyMs)
+    {
+        SendStats.maxLatencyMs = latencyMs;
+    }
+
+    if (batchPtr)
+    {
+        if (LE_SMS_SENT != status)
+        {
+            // Don't send the rest of the batch
+            CancelBatch(batchPtr, &cancelledList);
+        }
+        isBatchComplete = UpdateBatch(batchPtr, messageRef, requestPtr->batchIndex, status);
+    }
+
+    // Keep the modem busy before calling the client back
+    DispatchSendQueue();
+
+    le_mutex_Unlock(SendQueueMutex);
+
+    while (!le_dls_IsEmpty(&cancelledList))
+    {
+        SendRequest_t* cancelledPtr = CONTAINER_OF(le_dls_Pop(&cancelledList), SendRequest_t,
+                                                   link);
+
+        LE_INFO("Message (%p) not sent, its batch failed", cancelledPtr->msgRef);
+        le_mem_Release(cancelledPtr->msgPtr);
+        le_mem_Release(cancelledPtr);
+    }
+
+    if (isValid)
+    {
+        msgPtr->pdu.status = status;
+
+        if (NULL == batchPtr)
+        {
+            SendSmsSendingStateEvent(messageRef);
+        }
+        else if (LE_SMS_SENT == status)
+        {
+            // Update sent message count if necessary
+            CountSentMessage();
+        }
+    }
+
+    if (isBatchComplete)
+    {
+        LE_DEBUG("Sending CallBack (%p) Batch (%p), Message (%p), Status %d",
+                 batchPtr->callBackPtr, batchPtr, batchPtr->resultRef, batchPtr->resultStatus);
+        if (batchPtr->callBackPtr)
+        {
+            batchPtr->callBackPtr(batchPtr->resultRef, batchPtr->resultStatus, batchPtr->ctxPtr);
+        }
+        le_mem_Release(batchPtr);
+    }
+
+    le_mem_Release(msgPtr);
+    le_mem_Release(requestPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue a checked and encoded message, to be sent by the next idle sender thread.
+ *
+ * @note Called with SendQueueMutex locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void QueueMessage
+(
+    le_sms_MsgRef_t msgRef,     ///< [IN] Message reference.
+    le_sms_Msg_t*   msgPtr,     ///< [IN] Message object.
+    SendBatch_t*    batchPtr,   ///< [IN] Batch of the message, or NULL.
+    uint32_t        batchIndex  ///< [IN] Index of the message in the batch.
+)
+{
+    SendRequest_t* requestPtr = le_mem_ForceAlloc(SendRequestPool);
+
+    // Save the client session "msgSession" associated with the request reference "reqRef".
+    msgPtr->sessionRef = le_sms_GetClientSessionRef();
+    msgPtr->pdu.status = LE_SMS_SENDING;
+
+    le_mem_AddRef(msgPtr);
+    requestPtr->msgRef = msgRef;
+    requestPtr->msgPtr = msgPtr;
+    requestPtr->batchPtr = batchPtr;
+    requestPtr->batchIndex = batchIndex;
+    requestPtr->queuedTime = le_clk_GetRelativeTime();
+    requestPtr->link = LE_DLS_LINK_INIT;
+
+    LE_INFO("Queue message (%p)", msgRef);
+    le_dls_Queue(&SendQueue, &requestPtr->link);
+    SendStats.queueDepth++;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function send a message in asynchrone mode.
@@ -2042,20 +2495,13 @@ static le_result_t SendAsyncSMS
     /* Send */
     if (result == LE_OK)
     {
-        CmdRequest_t msgCommand;
-        // Save the client session "msgSession" associated with the request reference "reqRef".
-        msgPtr->sessionRef = le_sms_GetClientSessionRef();
-
-        msgPtr->pdu.status = LE_SMS_SENDING;
-
-        // Sending Message.
-        msgCommand.command = LE_SMS_CMD_TYPE_SEND;
-        msgCommand.msgRef = msgRef;
         msgPtr->callBackPtr = callBack;
         msgPtr->ctxPtr = context;
 
-        LE_INFO("Send Send command for message (%p)", msgRef);
-        le_event_Report(SmsCommandEventId, &msgCommand, sizeof(msgCommand));
+        le_mutex_Lock(SendQueueMutex);
+        QueueMessage(msgRef, msgPtr, NULL, 0);
+        DispatchSendQueue();
+        le_mutex_Unlock(SendQueueMutex);
     }
     else
     {
@@ -2067,68 +2513,9 @@ static le_result_t SendAsyncSMS
 }
 
 
-
 //--------------------------------------------------------------------------------------------------
 /**
- * Handler to process a command.
- */
-//--------------------------------------------------------------------------------------------------
-static void ProcessSmsSendingCommandHandler
-(
-    void* msgCommand
-)
-{
-    le_result_t res;
-    uint32_t command = ((CmdRequest_t*)msgCommand)->command;
-    le_sms_MsgRef_t messageRef = ((CmdRequest_t*)msgCommand)->msgRef;
-
-    le_sms_Msg_t* msgPtr = le_ref_Lookup(MsgRefMap, messageRef);
-
-    if (NULL == msgPtr)
-    {
-        LE_DEBUG("No more message reference (%p) valid", messageRef);
-        return;
-    }
-
-    switch (command)
-    {
-        case LE_SMS_CMD_TYPE_SEND:
-        {
-            le_sem_Wait(SmsSem);
-            LE_INFO("LE_SMS_CMD_TYPE_SEND message (%p) ", messageRef);
-
-            res = pa_sms_SendPduMsg(msgPtr->protocol, msgPtr->pdu.dataLen, msgPtr->pdu.data,
-                                    &msgPtr->messageReference, PA_SMS_SENDING_TIMEOUT,
-                                    &msgPtr->pdu.errorCode);
-            if (LE_OK == res)
-            {
-                msgPtr->pdu.status = LE_SMS_SENT;
-            }
-            else if (LE_TIMEOUT == res)
-            {
-                msgPtr->pdu.status = LE_SMS_SENDING_TIMEOUT;
-            }
-            else
-            {
-                msgPtr->pdu.status = LE_SMS_SENDING_FAILED;
-            }
-            le_sem_Post(SmsSem);
-            SendSmsSendingStateEvent(messageRef);
-        }
-        break;
-
-        default:
-        {
-            LE_ERROR("Command %i is not valid", command);
-        }
-        break;
-    }
-}
-
-
-//--------------------------------------------------------------------------------------------------
-/**
- * This thread does the actual work of Pool and send a SMS.
+ * This thread sends the queued messages, one at a time.
  */
 //--------------------------------------------------------------------------------------------------
 static void* SmsSenderThread
@@ -2136,21 +2523,22 @@ static void* SmsSenderThread
     void* contextPtr
 )
 {
-    LE_INFO("Sms command Thread started");
+    SmsSender_t* senderPtr = contextPtr;
+
+    LE_INFO("Sms sender thread %u started", senderPtr->index);
 
     // Connect to services used by this thread
     le_cfg_ConnectService();
 
-    // Register for SMS command events.
-    le_event_AddHandler(WDOG_THREAD_NAME_SMS_COMMAND_SENDING, SmsCommandEventId,
-        ProcessSmsSendingCommandHandler);
-
     le_sem_Post(SmsSem);
 
-    // Watchdog SMS event loop
+    // Watchdog SMS event loop, of the first sender thread only.
     // Try to kick a couple of times before each timeout.
-    le_clk_Time_t watchdogInterval = { .sec = MS_WDOG_INTERVAL };
-    le_wdogChain_MonitorEventLoop(MS_WDOG_SMS_LOOP, watchdogInterval);
+    if (0 == senderPtr->index)
+    {
+        le_clk_Time_t watchdogInterval = { .sec = MS_WDOG_INTERVAL };
+        le_wdogChain_MonitorEventLoop(MS_WDOG_SMS_LOOP, watchdogInterval);
+    }
 
     // Run the event loop
     le_event_RunLoop();
@@ -2236,6 +2624,8 @@ le_result_t le_sms_Init
     void
 )
 {
+    uint32_t i;
+
     // Initialize the smsPdu module.
     smsPdu_Initialize();
 
@@ -2251,6 +2641,7 @@ le_result_t le_sms_Init
 
     // Create the Safe Reference Map to use for Message object Safe References.
     MsgRefMap = le_ref_CreateMap("SmsMsgMap", MAX_NUM_OF_SMS_MSG);
+    MsgRefMapMutex = le_mutex_CreateNonRecursive("SmsMsgMapMutex");
 
     // Create a pool for List objects.
     ListPool = le_mem_CreatePool("ListSmsPool", sizeof(le_sms_List_t));
@@ -2291,13 +2682,32 @@ le_result_t le_sms_Init
         LE_WARN("failed to register a handler function for SMS storage");
     }
 
+    // Create pools for message sending requests and batches.
+    SendRequestPool = le_mem_CreatePool("SmsSendRequestPool", sizeof(SendRequest_t));
+    le_mem_ExpandPool(SendRequestPool, MAX_NUM_OF_SMS_MSG);
+    SendBatchPool = le_mem_CreatePool("SmsSendBatchPool", sizeof(SendBatch_t));
+
+    SendQueue = LE_DLS_LIST_INIT;
+    SendQueueMutex = le_mutex_CreateNonRecursive("SmsSendQueueMutex");
+
     SmsSem = le_sem_Create("SmsSem", 1);
 
-    // Init the SMS command Event Id.
-    SmsCommandEventId = le_event_CreateId("SmsSendCmd", sizeof(CmdRequest_t));
-    le_thread_Start(le_thread_Create("SmsSenderThread", SmsSenderThread, NULL));
+    // Start the sender threads, and wait for them to be ready.
+    SmsSendersCount = GetSendInFlight();
+    for (i = 0; i < SmsSendersCount; i++)
+    {
+        char threadName[32];
 
-    le_sem_Wait(SmsSem);
+        snprintf(threadName, sizeof(threadName), "SmsSenderThread%" PRIu32, i);
+        SmsSenders[i].index = i;
+        SmsSenders[i].requestPtr = NULL;
+        SmsSenders[i].threadRef = le_thread_Create(threadName, SmsSenderThread, &SmsSenders[i]);
+        le_thread_Start(SmsSenders[i].threadRef);
+    }
+    for (i = 0; i < SmsSendersCount; i++)
+    {
+        le_sem_Wait(SmsSem);
+    }
 
     // Register a handler function for new message indication.
     if (pa_sms_SetNewMsgHandler(NewSmsHandler) != LE_OK)
@@ -3751,10 +4161,7 @@ le_result_t le_sms_Send
             result = LE_OK;
 
             // Update sent message count if necessary
-            if (MessageStats.counting)
-            {
-                SetMessageCount(LE_SMS_TYPE_TX, MessageStats.txCount + 1);
-            }
+            CountSentMessage();
         }
     }
     else
@@ -3824,6 +4231,110 @@ le_result_t le_sms_SendAsync
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a batch of asynchronous SMS messages.
+ *
+ * All the messages are verified and encoded before any of them is queued. The handler is called
+ * once, when the sending of all the messages is complete, with the first message which could not
+ * be sent, or with the last message if all of them were sent.
+ *
+ * @return LE_FORMAT_ERROR  The content of a message is invalid.
+ * @return LE_FAULT         A message is read-only or was already sent, or the batch is empty.
+ * @return LE_OK            Function succeeded.
+ *
+ * @note If the caller is passing a bad pointer into this function, it is a fatal error, the
+ *       function will not return.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_sms_SendBatchAsync
+(
+    const le_sms_MsgRef_t* msgRefsPtr,
+        ///< [IN]
+        ///< References to the message objects.
+
+    size_t msgRefsSize,
+        ///< [IN]
+
+    le_sms_CallbackResultFunc_t handlerPtr,
+        ///< [IN]
+
+    void* contextPtr
+        ///< [IN]
+)
+{
+    le_sms_Msg_t* msgPtrs[LE_SMS_MAX_BATCH_SIZE];
+    SendBatch_t* batchPtr;
+    size_t i;
+    size_t j;
+
+    if ((0 == msgRefsSize) || (msgRefsSize > LE_SMS_MAX_BATCH_SIZE))
+    {
+        LE_ERROR("Invalid batch size %zu", msgRefsSize);
+        return LE_FAULT;
+    }
+
+    // Check and encode all the messages before queueing any of them
+    for (i = 0; i < msgRefsSize; i++)
+    {
+        msgPtrs[i] = le_ref_Lookup(MsgRefMap, msgRefsPtr[i]);
+
+        if (NULL == msgPtrs[i])
+        {
+            LE_KILL_CLIENT("Invalid reference (%p) provided!", msgRefsPtr[i]);
+            return LE_NOT_FOUND;
+        }
+
+        if (msgPtrs[i]->readonly)
+        {
+            LE_ERROR("Message %p is Read-only", msgRefsPtr[i]);
+            return LE_FAULT;
+        }
+
+        if (LE_SMS_UNSENT != msgPtrs[i]->pdu.status)
+        {
+            LE_ERROR("Message %p is not in UNSENT state", msgRefsPtr[i]);
+            return LE_FAULT;
+        }
+
+        for (j = 0; j < i; j++)
+        {
+            if (msgPtrs[j] == msgPtrs[i])
+            {
+                LE_ERROR("Message %p is twice in the batch", msgRefsPtr[i]);
+                return LE_FAULT;
+            }
+        }
+
+        if (LE_OK != CheckAndEncodeMessage(msgPtrs[i]))
+        {
+            LE_ERROR("Cannot encode Message Object %p", msgPtrs[i]);
+            return LE_FORMAT_ERROR;
+        }
+    }
+
+    batchPtr = le_mem_ForceAlloc(SendBatchPool);
+    batchPtr->callBackPtr = handlerPtr;
+    batchPtr->ctxPtr = contextPtr;
+    batchPtr->remaining = msgRefsSize;
+    batchPtr->failedIndex = UINT32_MAX;
+    batchPtr->resultRef = msgRefsPtr[msgRefsSize - 1];
+    batchPtr->resultStatus = LE_SMS_SENT;
+
+    le_mutex_Lock(SendQueueMutex);
+    for (i = 0; i < msgRefsSize; i++)
+    {
+        msgPtrs[i]->callBackPtr = NULL;
+        msgPtrs[i]->ctxPtr = NULL;
+        QueueMessage(msgRefsPtr[i], msgPtrs[i], batchPtr, i);
+    }
+    DispatchSendQueue();
+    le_mutex_Unlock(SendQueueMutex);
+
+    return LE_OK;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get the error code when a 3GPP2 message sending has Failed.
@@ -4738,10 +5249,46 @@ void le_sms_ResetCount
 
     // Reset the message count for all types.
     SetMessageCount(LE_SMS_TYPE_RX, 0);
+    le_mutex_Lock(SendQueueMutex);
     SetMessageCount(LE_SMS_TYPE_TX, 0);
+    le_mutex_Unlock(SendQueueMutex);
     SetMessageCount(LE_SMS_TYPE_BROADCAST_RX, 0);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the state of the queue of messages sent asynchronously, and the time taken by the messages
+ * from their queueing to the end of their sending, since the start of the service.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_sms_GetSendQueueStats
+(
+    uint32_t* queueDepthPtr,        ///< [OUT] Number of messages waiting to be sent.
+    uint32_t* inFlightPtr,          ///< [OUT] Number of messages being sent.
+    uint32_t* maxInFlightPtr,       ///< [OUT] Maximum number of messages sent at the same time.
+    uint32_t* sentCountPtr,         ///< [OUT] Number of messages which sending is complete.
+    uint32_t* averageLatencyPtr,    ///< [OUT] Average sending time of these messages, in ms.
+    uint32_t* maxLatencyPtr         ///< [OUT] Maximum sending time of these messages, in ms.
+)
+{
+    if ((NULL == queueDepthPtr) || (NULL == inFlightPtr) || (NULL == maxInFlightPtr) ||
+        (NULL == sentCountPtr) || (NULL == averageLatencyPtr) || (NULL == maxLatencyPtr))
+    {
+        LE_KILL_CLIENT("Invalid pointer provided!");
+        return;
+    }
+
+    le_mutex_Lock(SendQueueMutex);
+    *queueDepthPtr = SendStats.queueDepth;
+    *inFlightPtr = SendStats.inFlight;
+    *maxInFlightPtr = SmsSendersCount;
+    *sentCountPtr = SendStats.sentCount;
+    *averageLatencyPtr = SendStats.sentCount ?
+                         (uint32_t)(SendStats.totalLatencyMs / SendStats.sentCount) : 0;
+    *maxLatencyPtr = SendStats.maxLatencyMs;
+    le_mutex_Unlock(SendQueueMutex);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Enable SMS Status Report for outgoing messages.
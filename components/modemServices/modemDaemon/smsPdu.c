@@ -513,8 +513,7 @@ const uint8_t Ascii7to8[] = {
     252,        /*  126    ü  LATIN SMALL LETTER U WITH DIAERESIS     */
     224         /*  127    à  LATIN SMALL LETTER A WITH GRAVE         */
 
-    /*  The double bytes below must be handled separately after the
-     *   table lookup.
+    /*  The double bytes below are converted by the Ascii7ExtTo8 table.
      *
      *   12             27 10      FORM FEED
      *   94             27 20   ^  CIRCUMFLEX ACCENT
@@ -528,6 +527,32 @@ const uint8_t Ascii7to8[] = {
 
 };
 
+/****************************************************************************
+ *  This lookup table converts a character of the extension table of the
+ *   7 bit "default alphabet", which follows an escape (27), to ISO-8859-1.
+ *
+ *   The characters which are not defined, or don't exist in the ISO
+ *   character set, are replaced by the NPC8-character.
+ ****************************************************************************/
+static const uint8_t Ascii7ExtTo8[] = {
+    NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8,         /*   0 -   7 */
+    NPC8, NPC8, 12, NPC8, NPC8, NPC8, NPC8, NPC8,           /*   8 -  15 */
+    NPC8, NPC8, NPC8, NPC8, '^', NPC8, NPC8, NPC8,          /*  16 -  23 */
+    NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8,         /*  24 -  31 */
+    NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8,         /*  32 -  39 */
+    '{', '}', NPC8, NPC8, NPC8, NPC8, NPC8, '\\',           /*  40 -  47 */
+    NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8,         /*  48 -  55 */
+    NPC8, NPC8, NPC8, NPC8, '[', '~', ']', NPC8,            /*  56 -  63 */
+    '|', NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8,          /*  64 -  71 */
+    NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8,         /*  72 -  79 */
+    NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8,         /*  80 -  87 */
+    NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8,         /*  88 -  95 */
+    NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8,         /*  96 - 103 */
+    NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8,         /* 104 - 111 */
+    NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8,         /* 112 - 119 */
+    NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8, NPC8          /* 120 - 127 */
+};
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Dump the PDU
@@ -560,6 +585,21 @@ static void DumpPdu
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of septets packed in a group of GSM_7BITS_GROUP_BYTES bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+#define GSM_7BITS_GROUP_SEPTETS 8
+#define GSM_7BITS_GROUP_BYTES   7
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Escape to the extension table of the 7 bit default alphabet.
+ */
+//--------------------------------------------------------------------------------------------------
+#define GSM_7BITS_ESCAPE        0x1B
+
 static inline unsigned int Read7Bits
 (
     const uint8_t* bufferPtr,
@@ -575,27 +615,117 @@ static inline unsigned int Read7Bits
     return (a|b) & 0x7F;
 }
 
-static inline void Write7Bits
+//--------------------------------------------------------------------------------------------------
+/**
+ * Word with each byte set to the same value.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BYTES_OF(val)           (0x0101010101010101ULL * (val))
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unpack the 8 septets of a group of 7 bytes at once.
+ *
+ * The group is read as a 56-bit little-endian word, septet i being its bits 7*i to 7*i+6, and the
+ * septets are spread to the bytes of the returned word, septet i in byte i.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint64_t Unpack7BitsGroup
 (
-    uint8_t* bufferPtr,
-    uint8_t  val,
-    uint32_t pos
+    const uint8_t* bufferPtr    ///< [IN] Group of GSM_7BITS_GROUP_BYTES bytes
 )
 {
-    val &= 0x7F;
-    uint8_t idx = pos/8;
+    // Written out rather than looped, for the compiler to keep it branchless.
+    uint64_t word = (uint64_t)bufferPtr[0]         | ((uint64_t)bufferPtr[1] << 8)  |
+                    ((uint64_t)bufferPtr[2] << 16) | ((uint64_t)bufferPtr[3] << 24) |
+                    ((uint64_t)bufferPtr[4] << 32) | ((uint64_t)bufferPtr[5] << 40) |
+                    ((uint64_t)bufferPtr[6] << 48);
+
+    return (word & 0x7FULL)                      | ((word << 1) & (0x7FULL << 8))  |
+           ((word << 2) & (0x7FULL << 16))       | ((word << 3) & (0x7FULL << 24)) |
+           ((word << 4) & (0x7FULL << 32))       | ((word << 5) & (0x7FULL << 40)) |
+           ((word << 6) & (0x7FULL << 48))       | ((word << 7) & (0x7FULL << 56));
+}
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pack 8 septets, septet i in byte i of a word, into a group of 7 bytes at once.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void Pack7BitsGroup
+(
+    uint64_t septets,           ///< [IN] GSM_7BITS_GROUP_SEPTETS septets
+    uint8_t* bufferPtr          ///< [OUT] Group of GSM_7BITS_GROUP_BYTES bytes
+)
+{
+    uint64_t word = (septets & 0x7FULL)                | ((septets >> 1) & (0x7FULL << 7))  |
+                    ((septets >> 2) & (0x7FULL << 14)) | ((septets >> 3) & (0x7FULL << 21)) |
+                    ((septets >> 4) & (0x7FULL << 28)) | ((septets >> 5) & (0x7FULL << 35)) |
+                    ((septets >> 6) & (0x7FULL << 42)) | ((septets >> 7) & (0x7FULL << 49));
+
+    bufferPtr[0] = word;
+    bufferPtr[1] = word >> 8;
+    bufferPtr[2] = word >> 16;
+    bufferPtr[3] = word >> 24;
+    bufferPtr[4] = word >> 32;
+    bufferPtr[5] = word >> 40;
+    bufferPtr[6] = word >> 48;
+}
 
-    if (!(pos&7)) {
-        bufferPtr[idx] = val;
-    }
-    else if ((pos&7) == 1) {
-        bufferPtr[idx] = bufferPtr[idx] | (val<<1);
-    }
-    else {
-        bufferPtr[idx] = bufferPtr[idx] | (val<<(pos&7));
-        bufferPtr[idx+1] = (val>>(8-(pos&7)));
-    }
+//--------------------------------------------------------------------------------------------------
+/**
+ * Look up 8 bytes in a conversion table at once: byte i of the returned word is the entry of byte
+ * i of the array.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint64_t LookUpGroup
+(
+    const uint8_t* tablePtr,    ///< [IN] Conversion table
+    const uint8_t* bytesPtr     ///< [IN] GSM_7BITS_GROUP_SEPTETS bytes
+)
+{
+    return (uint64_t)tablePtr[bytesPtr[0]]         | ((uint64_t)tablePtr[bytesPtr[1]] << 8)  |
+           ((uint64_t)tablePtr[bytesPtr[2]] << 16) | ((uint64_t)tablePtr[bytesPtr[3]] << 24) |
+           ((uint64_t)tablePtr[bytesPtr[4]] << 32) | ((uint64_t)tablePtr[bytesPtr[5]] << 40) |
+           ((uint64_t)tablePtr[bytesPtr[6]] << 48) | ((uint64_t)tablePtr[bytesPtr[7]] << 56);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert 8 septets, septet i in byte i of a word, with the default alphabet at once.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void Convert7BitsGroup
+(
+    uint64_t septets,           ///< [IN] GSM_7BITS_GROUP_SEPTETS septets, without escape
+    uint8_t* a8bitPtr           ///< [OUT] GSM_7BITS_GROUP_SEPTETS characters
+)
+{
+    a8bitPtr[0] = Ascii7to8[septets & 0x7F];
+    a8bitPtr[1] = Ascii7to8[(septets >> 8) & 0x7F];
+    a8bitPtr[2] = Ascii7to8[(septets >> 16) & 0x7F];
+    a8bitPtr[3] = Ascii7to8[(septets >> 24) & 0x7F];
+    a8bitPtr[4] = Ascii7to8[(septets >> 32) & 0x7F];
+    a8bitPtr[5] = Ascii7to8[(septets >> 40) & 0x7F];
+    a8bitPtr[6] = Ascii7to8[(septets >> 48) & 0x7F];
+    a8bitPtr[7] = Ascii7to8[(septets >> 56) & 0x7F];
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether one of the septets of a word, septet i in byte i, is an escape.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool HasEscape
+(
+    uint64_t septets            ///< [IN] GSM_7BITS_GROUP_SEPTETS septets
+)
+{
+    // A byte of the xor is null where the septet is an escape. The septets being lower than 0x80,
+    // subtracting 1 from a null byte is the only way to set its upper bit.
+    uint64_t xor = septets ^ BYTES_OF(GSM_7BITS_ESCAPE);
+
+    return ((xor - BYTES_OF(0x01)) & ~xor & BYTES_OF(0x80)) != 0;
 }
 
 static inline unsigned int ReadCdma7Bits
@@ -635,6 +765,9 @@ static inline void WriteCdma7Bits
  * Convert an ascii array into a 7bits array
  * length is the number of bytes in the ascii buffer
  *
+ * Runs of 8 characters without escape are packed as a whole group of 7 bytes once the output is
+ * aligned on a group; the other characters are packed through a bit accumulator.
+ *
  * @return the size of the a7bit string (in 7bit chars!), or LE_OVERFLOW if a7bitPtr is too small.
  */
 static int32_t Convert8BitsTo7Bits
@@ -647,43 +780,68 @@ static int32_t Convert8BitsTo7Bits
     uint8_t       *a7bitsNumber ///< [OUT] number of char in &7bitsPtr
 )
 {
-    int read;
+    uint32_t bits = 0;      // Bits of the accumulator not written yet
+    int bitCount = 0;       // Number of bits in the accumulator
+    int read = pos;
     int write = 0;
-    int size = 0;
+    size_t size = 0;
 
-    for (read = pos; read < length+pos; ++read)
+    while (read < length+pos)
     {
-        uint8_t byte = Ascii8to7[a8bitPtr[read]];
-
-        /* Escape */
-        if (byte >= 128)
+        // Whole group of characters without escape, when the output is aligned on a group.
+        if ((0 == bitCount) && ((length+pos-read) >= GSM_7BITS_GROUP_SEPTETS))
         {
-            if (size>a7bitSize)
+            uint64_t septets = LookUpGroup(Ascii8to7, &a8bitPtr[read]);
+
+            // Characters needing an escape are marked by their upper bit.
+            if (!(septets & BYTES_OF(0x80)))
             {
-                return LE_OVERFLOW;
+                if ((size + GSM_7BITS_GROUP_BYTES) > a7bitSize)
+                {
+                    return LE_OVERFLOW;
+                }
+                Pack7BitsGroup(septets, &a7bitPtr[size]);
+                size += GSM_7BITS_GROUP_BYTES;
+                read += GSM_7BITS_GROUP_SEPTETS;
+                write += GSM_7BITS_GROUP_SEPTETS;
+                continue;
             }
-
-            Write7Bits(a7bitPtr, 0x1B, write*7);
-            write++;
-            byte -= 128;
         }
 
-        if (size>a7bitSize)
+        uint8_t byte = Ascii8to7[a8bitPtr[read++]];
+
+        /* Escape */
+        if (byte >= 128)
         {
-            return LE_OVERFLOW;
+            bits |= GSM_7BITS_ESCAPE << bitCount;
+            bitCount += 7;
+            write++;
+            byte -= 128;
         }
 
-        Write7Bits(a7bitPtr, byte, write*7);
+        bits |= byte << bitCount;
+        bitCount += 7;
         write++;
 
-        /* Number of 8 bit chars */
-        size = (write * 7);
-        size = (size % 8 != 0) ? (size/8 + 1) : (size/8);
+        while (bitCount >= 8)
+        {
+            if (size >= a7bitSize)
+            {
+                return LE_OVERFLOW;
+            }
+            a7bitPtr[size++] = bits & 0xFF;
+            bits >>= 8;
+            bitCount -= 8;
+        }
     }
 
-    if (size>a7bitSize)
+    if (bitCount)
     {
-        return LE_OVERFLOW;
+        if (size >= a7bitSize)
+        {
+            return LE_OVERFLOW;
+        }
+        a7bitPtr[size++] = bits;
     }
 
     /* Number of written chars */
@@ -696,6 +854,9 @@ static int32_t Convert8BitsTo7Bits
  * Convert a 7bit array into a ascii array
  * length is the number of 7bit char in the a7bit buffer
  *
+ * The septets are unpacked a whole group of 8 at a time when the position is aligned on a group,
+ * and converted with the default alphabet and extension tables.
+ *
  * @return the size of the ascii array, of LE_OVERFLOW if a8bitPtr is too small.
  */
 static int32_t Convert7BitsTo8Bits
@@ -707,77 +868,76 @@ static int32_t Convert7BitsTo8Bits
     size_t         a8bitSize     ///< [IN] 8bits array size.
 )
 {
-    int r;
-    int w;
+    bool isEscaped = false;
+    int r = pos;
+    int w = 0;
 
-    w = 0;
-    for (r = pos; r < length+pos; r++)
+    while (r < length+pos)
     {
-        uint8_t byte = Read7Bits(a7bitPtr, r*7);
-        byte = Ascii7to8[byte];
+        uint64_t septets;
+        int count = 1;
+        int i;
 
-        if (byte != 27)
+        if (!(r % GSM_7BITS_GROUP_SEPTETS) && ((length+pos-r) >= GSM_7BITS_GROUP_SEPTETS))
         {
-            if (w < a8bitSize)
-            {
-                a8bitPtr[w] = byte;
-                w++;
-            }
-            else
+            septets = Unpack7BitsGroup(
+                &a7bitPtr[(r / GSM_7BITS_GROUP_SEPTETS) * GSM_7BITS_GROUP_BYTES]);
+            count = GSM_7BITS_GROUP_SEPTETS;
+
+            // Whole group of the default alphabet.
+            if (!isEscaped && !HasEscape(septets) && ((w + GSM_7BITS_GROUP_SEPTETS) <= a8bitSize))
             {
-                return LE_OVERFLOW;
+                Convert7BitsGroup(septets, &a8bitPtr[w]);
+                w += GSM_7BITS_GROUP_SEPTETS;
+                r += GSM_7BITS_GROUP_SEPTETS;
+                continue;
             }
         }
         else
         {
-            /* If we're escaped then the next byte have a special meaning. */
-            r++;
+            septets = Read7Bits(a7bitPtr, r*7);
+        }
+        r += count;
 
-            byte = Read7Bits(a7bitPtr, r*7);
-            if (w < a8bitSize)
+        for (i = 0; i < count; i++, septets >>= 8)
+        {
+            uint8_t septet = septets & 0x7F;
+
+            if (isEscaped)
             {
-                switch (byte)
+                /* The escaped byte has a special meaning. */
+                isEscaped = false;
+                if (w >= a8bitSize)
                 {
-                    case 10:
-                        a8bitPtr[w] = 12;
-                        break;
-                    case 20:
-                        a8bitPtr[w] = '^';
-                        break;
-                    case 40:
-                        a8bitPtr[w] = '{';
-                        break;
-                    case 41:
-                        a8bitPtr[w] = '}';
-                        break;
-                    case 47:
-                        a8bitPtr[w] = '\\';
-                        break;
-                    case 60:
-                        a8bitPtr[w] = '[';
-                        break;
-                    case 61:
-                        a8bitPtr[w] = '~';
-                        break;
-                    case 62:
-                        a8bitPtr[w] = ']';
-                        break;
-                    case 64:
-                        a8bitPtr[w] = '|';
-                        break;
-                    default:
-                        a8bitPtr[w] = NPC8;
-                        break;
+                    return LE_OVERFLOW;
                 }
-                w++;
+                a8bitPtr[w++] = Ascii7ExtTo8[septet];
+            }
+            else if (septet == GSM_7BITS_ESCAPE)
+            {
+                isEscaped = true;
             }
             else
             {
-                return LE_OVERFLOW;
+                if (w >= a8bitSize)
+                {
+                    return LE_OVERFLOW;
+                }
+                a8bitPtr[w++] = Ascii7to8[septet];
             }
         }
     }
 
+    if (isEscaped)
+    {
+        /* An escape ending the array is converted with the septet following it, as before. */
+        if (w >= a8bitSize)
+        {
+            return LE_OVERFLOW;
+        }
+        a8bitPtr[w++] = Ascii7ExtTo8[Read7Bits(a7bitPtr, r*7)];
+    }
+
     return w;
 }
 
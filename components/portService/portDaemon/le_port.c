@@ -16,6 +16,7 @@
 #include <sys/un.h>
 #include <sys/socket.h>
 #include "watchdogChain.h"
+#include "relay.h"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -143,6 +144,7 @@ typedef struct
     char openingType[OPEN_TYPE_MAX_BYTES];                          ///< Device opening type.
     char possibleMode[MAX_POSSIBLE_MODES][POSSIBLE_MODE_MAX_BYTES]; ///< Possible mode name.
     bool suspended;
+    relay_Ref_t relayRef;                                           ///< Data relay, if started.
 }
 LinkInformation_t;
 
@@ -760,6 +762,7 @@ static void DeviceEventHandler
                 instanceConfigPtr->linkInfo[instanceConfigPtr->linkCounter]->dataModeSockFd = -1;
                 instanceConfigPtr->linkInfo[instanceConfigPtr->linkCounter]->atServerDevRef = NULL;
                 instanceConfigPtr->linkInfo[instanceConfigPtr->linkCounter]->suspended = false;
+                instanceConfigPtr->linkInfo[instanceConfigPtr->linkCounter]->relayRef = NULL;
 
                 // Initialize the counter before parsing of new link.
                 PossibleModeNumber = 0;
@@ -1471,6 +1474,207 @@ le_result_t le_port_SetDataMode
     return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function gets the link of an instance which supports the data mode.
+ *
+ * @return
+ *      - Link information.
+ *      - NULL if no link supports the data mode.
+ */
+//--------------------------------------------------------------------------------------------------
+static LinkInformation_t* GetDataLink
+(
+    InstanceConfiguration_t* instanceConfigPtr
+)
+{
+    int i, j;
+
+    for (i = 0; i < (instanceConfigPtr->linkCounter); i++)
+    {
+        for (j = 0; j < MAX_POSSIBLE_MODES; j++)
+        {
+            if (0 == strcmp(instanceConfigPtr->linkInfo[i]->possibleMode[j], "DATA"))
+            {
+                return instanceConfigPtr->linkInfo[i];
+            }
+        }
+    }
+
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function stops the data relays of an instance.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StopDataRelays
+(
+    InstanceConfiguration_t* instanceConfigPtr
+)
+{
+    int i;
+
+    for (i = 0; i < (instanceConfigPtr->linkCounter); i++)
+    {
+        if (NULL != instanceConfigPtr->linkInfo[i]->relayRef)
+        {
+            relay_Stop(instanceConfigPtr->linkInfo[i]->relayRef);
+            instanceConfigPtr->linkInfo[i]->relayRef = NULL;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function switches the device into data mode and relays the data between the device and the
+ * given file descriptor until one of them is closed, or the device is switched into AT command
+ * mode or released.
+ *
+ * @return
+ *      - LE_OK            Function succeeded.
+ *      - LE_FAULT         Function failed.
+ *      - LE_BAD_PARAMETER Invalid parameter.
+ *      - LE_UNAVAILABLE   JSON parsing is not completed.
+ *      - LE_DUPLICATE     Device already opened in data mode, or already relayed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_port_StartDataRelay
+(
+    le_port_DeviceRef_t devRef,   ///< [IN] Device reference.
+    int fd                        ///< [IN] File descriptor to relay the data of the device to.
+)
+{
+    le_result_t result;
+    int32_t dataModeFd;
+
+    if (0 > fd)
+    {
+        LE_ERROR("fd is invalid!");
+        return LE_BAD_PARAMETER;
+    }
+
+    if (false == JsonParseComplete)
+    {
+        LE_ERROR("JSON parsing is not completed!");
+        CloseWarn(fd);
+        return LE_UNAVAILABLE;
+    }
+
+    OpenedInstanceCtx_t* openedInstanceCtxPtr = le_ref_Lookup(DeviceRefMap, devRef);
+    if ((NULL == openedInstanceCtxPtr) || (NULL == openedInstanceCtxPtr->instanceConfigPtr))
+    {
+        LE_ERROR("devRef is invalid!");
+        CloseWarn(fd);
+        return LE_BAD_PARAMETER;
+    }
+
+    LinkInformation_t* linkInfoPtr = GetDataLink(openedInstanceCtxPtr->instanceConfigPtr);
+    if (NULL == linkInfoPtr)
+    {
+        LE_ERROR("Instance does not support data mode!");
+        CloseWarn(fd);
+        return LE_FAULT;
+    }
+
+    if (NULL != linkInfoPtr->relayRef)
+    {
+        uint64_t fromDevice, toDevice;
+        bool isSplice, isRunning;
+
+        relay_GetCounters(linkInfoPtr->relayRef, &fromDevice, &toDevice, &isSplice, &isRunning);
+        if (isRunning)
+        {
+            LE_ERROR("Device data is already relayed!");
+            CloseWarn(fd);
+            return LE_DUPLICATE;
+        }
+        relay_Stop(linkInfoPtr->relayRef);
+        linkInfoPtr->relayRef = NULL;
+    }
+
+    result = le_port_SetDataMode(devRef, &dataModeFd);
+    if (LE_OK != result)
+    {
+        CloseWarn(fd);
+        return result;
+    }
+
+    // The socket of a unixSocket link is not duplicated for the client: the relay needs its own.
+    if (dataModeFd == linkInfoPtr->dataModeFd)
+    {
+        dataModeFd = dup(dataModeFd);
+        if (-1 == dataModeFd)
+        {
+            LE_ERROR("Unable to duplicate the data mode fd %m");
+            CloseWarn(fd);
+            return LE_FAULT;
+        }
+    }
+
+    linkInfoPtr->relayRef = relay_Start(dataModeFd, fd, true);
+    if (NULL == linkInfoPtr->relayRef)
+    {
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function gets the number of bytes relayed between the device and the file descriptor given
+ * to le_port_StartDataRelay().
+ *
+ * @return
+ *      - LE_OK            Function succeeded.
+ *      - LE_BAD_PARAMETER Invalid parameter.
+ *      - LE_UNAVAILABLE   JSON parsing is not completed.
+ *      - LE_NOT_FOUND     The device data is not relayed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_port_GetDataRelayCounters
+(
+    le_port_DeviceRef_t devRef,   ///< [IN] Device reference.
+    uint64_t* fromDevicePtr,      ///< [OUT] Bytes read from the device and written to the fd.
+    uint64_t* toDevicePtr,        ///< [OUT] Bytes read from the fd and written to the device.
+    bool* isSplicePtr,            ///< [OUT] True if the data is moved with splice().
+    bool* isRunningPtr            ///< [OUT] False once the device or the fd is closed.
+)
+{
+    if (false == JsonParseComplete)
+    {
+        LE_ERROR("JSON parsing is not completed!");
+        return LE_UNAVAILABLE;
+    }
+
+    if ((NULL == fromDevicePtr) || (NULL == toDevicePtr) || (NULL == isSplicePtr) ||
+        (NULL == isRunningPtr))
+    {
+        LE_ERROR("Output pointer is NULL!");
+        return LE_BAD_PARAMETER;
+    }
+
+    OpenedInstanceCtx_t* openedInstanceCtxPtr = le_ref_Lookup(DeviceRefMap, devRef);
+    if ((NULL == openedInstanceCtxPtr) || (NULL == openedInstanceCtxPtr->instanceConfigPtr))
+    {
+        LE_ERROR("devRef is invalid!");
+        return LE_BAD_PARAMETER;
+    }
+
+    LinkInformation_t* linkInfoPtr = GetDataLink(openedInstanceCtxPtr->instanceConfigPtr);
+    if ((NULL == linkInfoPtr) || (NULL == linkInfoPtr->relayRef))
+    {
+        return LE_NOT_FOUND;
+    }
+
+    relay_GetCounters(linkInfoPtr->relayRef, fromDevicePtr, toDevicePtr, isSplicePtr,
+                      isRunningPtr);
+
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function switches the device into AT command mode and returns At server device reference.
@@ -1518,6 +1722,9 @@ le_result_t le_port_SetCommandMode
         return LE_FAULT;
     }
 
+    // The client takes the device back.
+    StopDataRelays(instanceConfigPtr);
+
     // Check all the links. Open the link which contains "AT" as possibleMode if not opened in AT
     // command mode.
     for (i = 0; i < (instanceConfigPtr->linkCounter); i++)
@@ -1595,6 +1802,8 @@ static void CloseAllFd
 {
     int i;
 
+    StopDataRelays(instanceConfigPtr);
+
     for (i = 0; i < (instanceConfigPtr->linkCounter); i++)
     {
         if (-1 != instanceConfigPtr->linkInfo[i]->fd)
@@ -1850,6 +2059,9 @@ COMPONENT_INIT
     // Add a handler to the close session service.
     le_msg_AddServiceCloseHandler(le_port_GetServiceRef(), CloseSessionEventHandler, NULL);
 
+    // Initialize the data relays.
+    relay_Init();
+
     // Link list for device.
     DeviceList = LE_DLS_LIST_INIT;
 
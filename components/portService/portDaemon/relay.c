@@ -0,0 +1,557 @@
+/** @file relay.c
+ *
+ * Relay of the data between a device in data mode and a client file descriptor.
+ *
+ * Each direction reads what is available on its input and writes it to its output before reading
+ * again.  When both sides support it, the data is moved with splice() through a pipe owned by the
+ * direction, so that it is never copied to user space: the kernel moves the pages from the device
+ * to the pipe and from the pipe to the peer.  When one of the sides does not support splice()
+ * (EINVAL), the relay falls back to read() and write() through a large buffer.
+ *
+ * The file descriptors are non-blocking: when an output is full, the input of the direction is no
+ * longer monitored until the output becomes writable again, so that a slow side throttles the
+ * other one instead of the data being buffered.  Their file descriptions are shared with the link
+ * and with the client, so their original flags are restored when the relay stops.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "relay.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of bytes moved at once, which is also the size of the copy buffers. It matches
+ * the default capacity of a pipe.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RELAY_CHUNK_BYTES       (64 * 1024)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default number of relays, one per link in data mode.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RELAY_DEFAULT_POOL_SIZE 2
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum length of a monitor name.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MONITOR_NAME_MAX_BYTES  32
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sides of a relay. The direction from the device to the peer has the index of the device.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SIDE_DEVICE             0
+#define SIDE_PEER               1
+#define SIDE_COUNT              2
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Events reporting that a side is closed.
+ */
+//--------------------------------------------------------------------------------------------------
+#define HANGUP_EVENTS           (POLLHUP | POLLERR | POLLRDHUP)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A direction of a relay, moving the data read from one side to the other side.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    int      pipeFd[2];     ///< Pipe the data is spliced through, -1 when copying.
+    uint8_t* bufferPtr;     ///< Buffer the data is copied through, NULL when splicing.
+    size_t   offset;        ///< Offset of the pending data in the buffer.
+    size_t   pending;       ///< Bytes read and not written yet, in the pipe or in the buffer.
+    uint64_t count;         ///< Bytes written to the output so far.
+    bool     isBlocked;     ///< True while waiting for the output to be writable.
+}
+Direction_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Relay object structure.
+ */
+//--------------------------------------------------------------------------------------------------
+struct relay_Relay
+{
+    int                fd[SIDE_COUNT];          ///< File descriptors of the sides.
+    int                savedFlags[SIDE_COUNT];  ///< Original file status flags of the sides, or
+                                                ///  -1 if they were not changed.
+    le_fdMonitor_Ref_t monitorRef[SIDE_COUNT];  ///< Monitors of the sides.
+    Direction_t        direction[SIDE_COUNT];   ///< Directions, indexed by their input side.
+    bool               isSplice;                ///< True while the data is spliced.
+    bool               isRunning;               ///< False once a side is closed.
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool for the relays.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t RelayPool;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool for the copy buffers.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t BufferPool;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the pipes and release the buffers of the directions.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseDirections
+(
+    relay_Ref_t relayRef
+)
+{
+    int i, j;
+
+    for (i = 0; i < SIDE_COUNT; i++)
+    {
+        Direction_t* dirPtr = &relayRef->direction[i];
+
+        for (j = 0; j < 2; j++)
+        {
+            if (-1 != dirPtr->pipeFd[j])
+            {
+                close(dirPtr->pipeFd[j]);
+                dirPtr->pipeFd[j] = -1;
+            }
+        }
+        if (NULL != dirPtr->bufferPtr)
+        {
+            le_mem_Release(dirPtr->bufferPtr);
+            dirPtr->bufferPtr = NULL;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop relaying: stop monitoring and close the file descriptors. The counters are kept.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Halt
+(
+    relay_Ref_t relayRef
+)
+{
+    int i;
+
+    if (!relayRef->isRunning)
+    {
+        return;
+    }
+
+    for (i = 0; i < SIDE_COUNT; i++)
+    {
+        if (NULL != relayRef->monitorRef[i])
+        {
+            le_fdMonitor_Delete(relayRef->monitorRef[i]);
+            relayRef->monitorRef[i] = NULL;
+        }
+        if (-1 != relayRef->savedFlags[i])
+        {
+            if (-1 == fcntl(relayRef->fd[i], F_SETFL, relayRef->savedFlags[i]))
+            {
+                LE_WARN("Unable to restore the flags of fd %d: %m", relayRef->fd[i]);
+            }
+            relayRef->savedFlags[i] = -1;
+        }
+        close(relayRef->fd[i]);
+        relayRef->fd[i] = -1;
+    }
+    ReleaseDirections(relayRef);
+    relayRef->isRunning = false;
+
+    LE_INFO("Relay stopped, %" PRIu64 " bytes from device, %" PRIu64 " bytes to device",
+            relayRef->direction[SIDE_DEVICE].count, relayRef->direction[SIDE_PEER].count);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Switch the relay from splice() to copy. The data left in the pipes is moved to the buffers.
+ *
+ * @return
+ *      - LE_OK            The function succeeded.
+ *      - LE_FAULT         The data left in a pipe could not be read.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SwitchToCopy
+(
+    relay_Ref_t relayRef
+)
+{
+    int i;
+
+    LE_INFO("splice() not supported, relay by copy");
+
+    for (i = 0; i < SIDE_COUNT; i++)
+    {
+        Direction_t* dirPtr = &relayRef->direction[i];
+
+        dirPtr->bufferPtr = le_mem_ForceAlloc(BufferPool);
+        dirPtr->offset = 0;
+        if (dirPtr->pending)
+        {
+            // The pipe only holds what one splice() of at most RELAY_CHUNK_BYTES put in it.
+            ssize_t size = read(dirPtr->pipeFd[0], dirPtr->bufferPtr, dirPtr->pending);
+
+            if (size != (ssize_t)dirPtr->pending)
+            {
+                LE_ERROR("Unable to read the pipe: %m");
+                return LE_FAULT;
+            }
+        }
+        close(dirPtr->pipeFd[0]);
+        close(dirPtr->pipeFd[1]);
+        dirPtr->pipeFd[0] = -1;
+        dirPtr->pipeFd[1] = -1;
+    }
+    relayRef->isSplice = false;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the pending data of a direction to its output.
+ *
+ * When the output is full, the input of the direction stops being monitored and the output is
+ * monitored for writing instead, until all the pending data is written.
+ *
+ * @return
+ *      - LE_OK            All the pending data is written.
+ *      - LE_WOULD_BLOCK   The output is full.
+ *      - LE_CLOSED        The output is closed, or failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t Flush
+(
+    relay_Ref_t relayRef,
+    int         side        ///< [IN] Input side of the direction.
+)
+{
+    Direction_t* dirPtr = &relayRef->direction[side];
+    int outFd = relayRef->fd[!side];
+
+    while (dirPtr->pending)
+    {
+        ssize_t size;
+
+        if (relayRef->isSplice)
+        {
+            size = splice(dirPtr->pipeFd[0], NULL, outFd, NULL, dirPtr->pending,
+                          SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+        }
+        else
+        {
+            size = write(outFd, dirPtr->bufferPtr + dirPtr->offset, dirPtr->pending);
+        }
+
+        if (size < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+            {
+                if (!dirPtr->isBlocked)
+                {
+                    le_fdMonitor_Disable(relayRef->monitorRef[side], POLLIN);
+                    le_fdMonitor_Enable(relayRef->monitorRef[!side], POLLOUT);
+                    dirPtr->isBlocked = true;
+                }
+                return LE_WOULD_BLOCK;
+            }
+            if ((EINVAL == errno) && relayRef->isSplice)
+            {
+                if (LE_OK != SwitchToCopy(relayRef))
+                {
+                    return LE_CLOSED;
+                }
+                continue;
+            }
+            LE_ERROR("Unable to write to fd %d: %m", outFd);
+            return LE_CLOSED;
+        }
+
+        dirPtr->pending -= size;
+        dirPtr->offset += size;
+        dirPtr->count += size;
+    }
+
+    if (dirPtr->isBlocked)
+    {
+        le_fdMonitor_Disable(relayRef->monitorRef[!side], POLLOUT);
+        le_fdMonitor_Enable(relayRef->monitorRef[side], POLLIN);
+        dirPtr->isBlocked = false;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read what is available on the input of a direction, and write it to its output.
+ *
+ * @return
+ *      - LE_OK            The data read, if any, is written or pending.
+ *      - LE_CLOSED        A side is closed, or failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t Pump
+(
+    relay_Ref_t relayRef,
+    int         side        ///< [IN] Input side of the direction.
+)
+{
+    Direction_t* dirPtr = &relayRef->direction[side];
+    int inFd = relayRef->fd[side];
+    ssize_t size;
+
+    if (dirPtr->pending)
+    {
+        // Still waiting for the output.
+        return LE_OK;
+    }
+
+    for (;;)
+    {
+        if (relayRef->isSplice)
+        {
+            size = splice(inFd, NULL, dirPtr->pipeFd[1], NULL, RELAY_CHUNK_BYTES,
+                          SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+        }
+        else
+        {
+            size = read(inFd, dirPtr->bufferPtr, RELAY_CHUNK_BYTES);
+        }
+
+        if (size > 0)
+        {
+            break;
+        }
+        if (0 == size)
+        {
+            LE_DEBUG("fd %d closed", inFd);
+            return LE_CLOSED;
+        }
+        if (EINTR == errno)
+        {
+            continue;
+        }
+        if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+        {
+            return LE_OK;
+        }
+        if ((EINVAL == errno) && relayRef->isSplice)
+        {
+            if (LE_OK != SwitchToCopy(relayRef))
+            {
+                return LE_CLOSED;
+            }
+            continue;
+        }
+        LE_ERROR("Unable to read fd %d: %m", inFd);
+        return LE_CLOSED;
+    }
+
+    dirPtr->pending = size;
+    dirPtr->offset = 0;
+
+    return (LE_CLOSED == Flush(relayRef, side)) ? LE_CLOSED : LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler of the events of a side of a relay.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SideEventHandler
+(
+    int   fd,       ///< [IN] File descriptor of the side.
+    short events    ///< [IN] Events.
+)
+{
+    relay_Ref_t relayRef = le_fdMonitor_GetContextPtr();
+    int side = (fd == relayRef->fd[SIDE_DEVICE]) ? SIDE_DEVICE : SIDE_PEER;
+
+    // The side can be written to again: complete the direction writing to it.
+    if ((events & POLLOUT) && (LE_CLOSED == Flush(relayRef, !side)))
+    {
+        Halt(relayRef);
+        return;
+    }
+
+    if (events & POLLIN)
+    {
+        if (LE_CLOSED == Pump(relayRef, side))
+        {
+            Halt(relayRef);
+        }
+    }
+    else if (events & HANGUP_EVENTS)
+    {
+        // Nothing left to read, or the direction is blocked and can't drain the side anymore.
+        Halt(relayRef);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the file descriptor of a side non-blocking, saving its original flags so that Halt() can
+ * restore them.
+ *
+ * @return
+ *      - LE_OK            The function succeeded.
+ *      - LE_FAULT         The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SetNonBlocking
+(
+    relay_Ref_t relayRef,
+    int side
+)
+{
+    int fd = relayRef->fd[side];
+    int flags = fcntl(fd, F_GETFL);
+
+    if ((-1 == flags) || (-1 == fcntl(fd, F_SETFL, flags | O_NONBLOCK)))
+    {
+        LE_ERROR("Unable to set fd %d non-blocking: %m", fd);
+        return LE_FAULT;
+    }
+    relayRef->savedFlags[side] = flags;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Relay initialization.
+ */
+//--------------------------------------------------------------------------------------------------
+void relay_Init
+(
+    void
+)
+{
+    RelayPool = le_mem_CreatePool("RelayPool", sizeof(struct relay_Relay));
+    le_mem_ExpandPool(RelayPool, RELAY_DEFAULT_POOL_SIZE);
+
+    BufferPool = le_mem_CreatePool("RelayBufferPool", RELAY_CHUNK_BYTES);
+
+    // A peer closing its side must make the write fail with EPIPE, not kill the process.
+    le_sig_Block(SIGPIPE);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start to relay the data between a device and a peer file descriptor, in the calling thread's
+ * event loop, until one of them is closed or relay_Stop() is called.
+ *
+ * @return
+ *      - Reference to the relay.
+ *      - NULL if the relay could not be started. The file descriptors are closed.
+ */
+//--------------------------------------------------------------------------------------------------
+relay_Ref_t relay_Start
+(
+    int  devFd,         ///< [IN] File descriptor of the device.
+    int  peerFd,        ///< [IN] File descriptor of the peer.
+    bool useSplice      ///< [IN] Try to relay with splice(), else only copy.
+)
+{
+    relay_Ref_t relayRef = le_mem_ForceAlloc(RelayPool);
+    char monitorName[MONITOR_NAME_MAX_BYTES];
+    int i;
+
+    memset(relayRef, 0, sizeof(*relayRef));
+    relayRef->fd[SIDE_DEVICE] = devFd;
+    relayRef->fd[SIDE_PEER] = peerFd;
+    relayRef->savedFlags[SIDE_DEVICE] = -1;
+    relayRef->savedFlags[SIDE_PEER] = -1;
+    relayRef->isSplice = useSplice;
+    relayRef->isRunning = true;
+
+    for (i = 0; i < SIDE_COUNT; i++)
+    {
+        Direction_t* dirPtr = &relayRef->direction[i];
+
+        dirPtr->pipeFd[0] = -1;
+        dirPtr->pipeFd[1] = -1;
+        if (!useSplice)
+        {
+            dirPtr->bufferPtr = le_mem_ForceAlloc(BufferPool);
+        }
+        else if (-1 == pipe2(dirPtr->pipeFd, O_CLOEXEC | O_NONBLOCK))
+        {
+            LE_ERROR("Unable to create pipe: %m");
+            relay_Stop(relayRef);
+            return NULL;
+        }
+    }
+
+    for (i = 0; i < SIDE_COUNT; i++)
+    {
+        if (LE_OK != SetNonBlocking(relayRef, i))
+        {
+            relay_Stop(relayRef);
+            return NULL;
+        }
+
+        snprintf(monitorName, sizeof(monitorName), "Relay-%d", relayRef->fd[i]);
+        relayRef->monitorRef[i] = le_fdMonitor_Create(monitorName, relayRef->fd[i],
+                                                      SideEventHandler, POLLIN | POLLRDHUP);
+        le_fdMonitor_SetContextPtr(relayRef->monitorRef[i], relayRef);
+    }
+
+    LE_INFO("Relay started between device fd %d and fd %d", devFd, peerFd);
+
+    return relayRef;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop a relay, close its file descriptors and release it.
+ */
+//--------------------------------------------------------------------------------------------------
+void relay_Stop
+(
+    relay_Ref_t relayRef    ///< [IN] Relay reference.
+)
+{
+    Halt(relayRef);
+    le_mem_Release(relayRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes relayed in each direction so far.
+ */
+//--------------------------------------------------------------------------------------------------
+void relay_GetCounters
+(
+    relay_Ref_t relayRef,       ///< [IN] Relay reference.
+    uint64_t*   fromDevicePtr,  ///< [OUT] Bytes read from the device and written to the peer.
+    uint64_t*   toDevicePtr,    ///< [OUT] Bytes read from the peer and written to the device.
+    bool*       isSplicePtr,    ///< [OUT] True if the data is moved with splice().
+    bool*       isRunningPtr    ///< [OUT] False once one of the file descriptors is closed.
+)
+{
+    *fromDevicePtr = relayRef->direction[SIDE_DEVICE].count;
+    *toDevicePtr = relayRef->direction[SIDE_PEER].count;
+    *isSplicePtr = relayRef->isSplice;
+    *isRunningPtr = relayRef->isRunning;
+}
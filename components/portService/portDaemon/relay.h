@@ -0,0 +1,76 @@
+/** @file relay.h
+ *
+ * Relay of the data between a device in data mode and a client file descriptor, done by the port
+ * service itself.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LEGATO_PORT_RELAY_INCLUDE_GUARD
+#define LEGATO_PORT_RELAY_INCLUDE_GUARD
+
+#include "legato.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a relay.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct relay_Relay* relay_Ref_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Relay initialization.
+ */
+//--------------------------------------------------------------------------------------------------
+void relay_Init
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start to relay the data between a device and a peer file descriptor, in the calling thread's
+ * event loop, until one of them is closed or relay_Stop() is called.
+ *
+ * The data is moved by the kernel through pipes with splice() when both file descriptors support
+ * it, and copied through a large buffer otherwise.  The relay takes the ownership of the file
+ * descriptors, and sets them non-blocking.
+ *
+ * @return
+ *      - Reference to the relay.
+ *      - NULL if the relay could not be started. The file descriptors are closed.
+ */
+//--------------------------------------------------------------------------------------------------
+relay_Ref_t relay_Start
+(
+    int  devFd,         ///< [IN] File descriptor of the device.
+    int  peerFd,        ///< [IN] File descriptor of the peer.
+    bool useSplice      ///< [IN] Try to relay with splice(), else only copy.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop a relay, close its file descriptors and release it.
+ */
+//--------------------------------------------------------------------------------------------------
+void relay_Stop
+(
+    relay_Ref_t relayRef    ///< [IN] Relay reference.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes relayed in each direction so far.
+ */
+//--------------------------------------------------------------------------------------------------
+void relay_GetCounters
+(
+    relay_Ref_t relayRef,       ///< [IN] Relay reference.
+    uint64_t*   fromDevicePtr,  ///< [OUT] Bytes read from the device and written to the peer.
+    uint64_t*   toDevicePtr,    ///< [OUT] Bytes read from the peer and written to the device.
+    bool*       isSplicePtr,    ///< [OUT] True if the data is moved with splice().
+    bool*       isRunningPtr    ///< [OUT] False once one of the file descriptors is closed.
+);
+
+#endif // LEGATO_PORT_RELAY_INCLUDE_GUARD
@@ -0,0 +1,314 @@
+//--------------------------------------------------------------------------------------------------
+/** @file gnssFixRing.c
+ *
+ * Reader side of the shared memory fix ring written by the positioning service.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "gnssFixRing.h"
+#include <sys/mman.h>
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of attempts at copying a record that is being written before giving up.  The service
+ * writes a record in well under a microsecond, so this is only reached if it died while writing.
+ */
+//--------------------------------------------------------------------------------------------------
+#define READ_RETRY_MAX  1000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mapped fix ring.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct gnssFixRing_Reader
+{
+    const gnssFixRing_t* ringPtr;   ///< Mapped ring.
+    int eventFd;                    ///< Event file descriptor, or -1.
+    uint64_t nextIndex;             ///< Index of the next fix to read.
+}
+Reader_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of readers.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t ReaderPool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy the record of a fix out of the ring.
+ *
+ * @return
+ *      - LE_OK if the record was copied.
+ *      - LE_OVERFLOW if the slot holds a later fix than the one requested.
+ *      - LE_FAULT if the record could not be copied consistently.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CopyRecord
+(
+    const gnssFixRing_t* ringPtr,       ///< [IN] Ring.
+    uint64_t fixIndex,                  ///< [IN] Index of the fix.
+    gnssFixRing_Record_t* recordPtr     ///< [OUT] Copy of the record.
+)
+{
+    const gnssFixRing_Record_t* slotPtr =
+        &ringPtr->records[fixIndex & (GNSS_FIXRING_SLOT_COUNT - 1)];
+    int retry;
+
+    for (retry = 0; retry < READ_RETRY_MAX; retry++)
+    {
+        uint32_t seq = __atomic_load_n(&slotPtr->seq, __ATOMIC_ACQUIRE);
+
+        if (seq & 1)
+        {
+            continue;
+        }
+
+        memcpy(recordPtr, slotPtr, sizeof(*recordPtr));
+
+        // The copy must be complete before seq is read again.
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (__atomic_load_n(&slotPtr->seq, __ATOMIC_RELAXED) == seq)
+        {
+            return (recordPtr->fixIndex == fixIndex) ? LE_OK : LE_OVERFLOW;
+        }
+    }
+
+    LE_ERROR("Fix %" PRIu64 " could not be read from the ring.", fixIndex);
+    return LE_FAULT;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Map a fix ring for reading.  The reader starts after the last fix written to the ring.
+ *
+ * Both file descriptors are owned by the reader from then on, even if this fails.
+ *
+ * @return
+ *      Reference to the ring, or NULL if the file descriptor is not a valid fix ring.
+ */
+//--------------------------------------------------------------------------------------------------
+gnssFixRing_Ref_t gnssFixRing_Open
+(
+    int ringFd,             ///< [IN] File descriptor from le_gnss_GetFixRing().
+    int eventFd             ///< [IN] File descriptor from le_gnss_GetFixRingEvent(), or -1.
+)
+{
+    const gnssFixRing_t* ringPtr = mmap(NULL, sizeof(gnssFixRing_t), PROT_READ, MAP_SHARED,
+                                        ringFd, 0);
+
+    // The mapping stays valid once the file descriptor is closed.
+    if (ringFd >= 0)
+    {
+        close(ringFd);
+    }
+
+    if (MAP_FAILED == ringPtr)
+    {
+        LE_ERROR("Could not map the fix ring (%m).");
+    }
+    else if (   (__atomic_load_n(&ringPtr->header.magic, __ATOMIC_ACQUIRE) != GNSS_FIXRING_MAGIC)
+             || (ringPtr->header.version != GNSS_FIXRING_VERSION)
+             || (ringPtr->header.recordSize != sizeof(gnssFixRing_Record_t))
+             || (ringPtr->header.slotCount != GNSS_FIXRING_SLOT_COUNT))
+    {
+        LE_ERROR("Fix ring layout not supported (magic 0x%08" PRIx32 ", version %" PRIu32 ").",
+                 ringPtr->header.magic, ringPtr->header.version);
+        munmap((void*)ringPtr, sizeof(gnssFixRing_t));
+    }
+    else
+    {
+        if (NULL == ReaderPool)
+        {
+            ReaderPool = le_mem_CreatePool("gnssFixRingReader", sizeof(Reader_t));
+        }
+
+        Reader_t* readerPtr = le_mem_ForceAlloc(ReaderPool);
+
+        readerPtr->ringPtr = ringPtr;
+        readerPtr->eventFd = eventFd;
+        readerPtr->nextIndex = __atomic_load_n(&ringPtr->header.writeCount, __ATOMIC_ACQUIRE);
+
+        return readerPtr;
+    }
+
+    if (eventFd >= 0)
+    {
+        close(eventFd);
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the last fix written to the ring, and move the reader after it.
+ *
+ * @return
+ *      - LE_OK if the record was read.
+ *      - LE_UNAVAILABLE if no fix was written to the ring yet.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gnssFixRing_ReadLatest
+(
+    gnssFixRing_Ref_t ringRef,          ///< [IN] Ring.
+    gnssFixRing_Record_t* recordPtr     ///< [OUT] Copy of the record.
+)
+{
+    LE_ASSERT(ringRef != NULL);
+
+    le_result_t result;
+
+    do
+    {
+        uint64_t writeCount = __atomic_load_n(&ringRef->ringPtr->header.writeCount,
+                                              __ATOMIC_ACQUIRE);
+        if (0 == writeCount)
+        {
+            return LE_UNAVAILABLE;
+        }
+
+        result = CopyRecord(ringRef->ringPtr, writeCount - 1, recordPtr);
+        ringRef->nextIndex = writeCount;
+    }
+    while (LE_OVERFLOW == result);
+
+    return (LE_OK == result) ? LE_OK : LE_UNAVAILABLE;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the next fix from the ring.
+ *
+ * @return
+ *      - LE_OK if the record was read.
+ *      - LE_OVERFLOW if the record was read, but the fixes before it were overwritten before they
+ *        could be read.
+ *      - LE_WOULD_BLOCK if there is no new fix.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gnssFixRing_ReadNext
+(
+    gnssFixRing_Ref_t ringRef,          ///< [IN] Ring.
+    gnssFixRing_Record_t* recordPtr     ///< [OUT] Copy of the record.
+)
+{
+    LE_ASSERT(ringRef != NULL);
+
+    bool overflow = false;
+
+    for (;;)
+    {
+        uint64_t writeCount = __atomic_load_n(&ringRef->ringPtr->header.writeCount,
+                                              __ATOMIC_ACQUIRE);
+
+        if (ringRef->nextIndex >= writeCount)
+        {
+            return LE_WOULD_BLOCK;
+        }
+
+        // The slot of the oldest fix in the ring is the next one to be overwritten, so skip to
+        // the one after it.
+        if ((writeCount - ringRef->nextIndex) >= GNSS_FIXRING_SLOT_COUNT)
+        {
+            ringRef->nextIndex = writeCount - GNSS_FIXRING_SLOT_COUNT + 1;
+            overflow = true;
+        }
+
+        le_result_t result = CopyRecord(ringRef->ringPtr, ringRef->nextIndex, recordPtr);
+
+        if (LE_OK == result)
+        {
+            ringRef->nextIndex++;
+            return overflow ? LE_OVERFLOW : LE_OK;
+        }
+        if (LE_OVERFLOW != result)
+        {
+            return LE_WOULD_BLOCK;
+        }
+
+        // Overwritten while it was being copied: the writer is far ahead, catch up with it.
+        overflow = true;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the event file descriptor of the ring, to wait for new fixes with poll() or le_fdMonitor.
+ * Once it is reported readable, gnssFixRing_ClearEvent() must be called before reading the fixes.
+ *
+ * @return
+ *      The file descriptor, or -1 if the ring was opened without one.
+ */
+//--------------------------------------------------------------------------------------------------
+int gnssFixRing_GetEventFd
+(
+    gnssFixRing_Ref_t ringRef           ///< [IN] Ring.
+)
+{
+    LE_ASSERT(ringRef != NULL);
+
+    return ringRef->eventFd;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Clear the ring's event, so that the event file descriptor is reported readable again only when
+ * a new fix is written.
+ */
+//--------------------------------------------------------------------------------------------------
+void gnssFixRing_ClearEvent
+(
+    gnssFixRing_Ref_t ringRef           ///< [IN] Ring.
+)
+{
+    LE_ASSERT(ringRef != NULL);
+
+    uint64_t count;
+
+    // The event file descriptor is non-blocking, so this fails with EAGAIN if it wasn't signalled.
+    if (ringRef->eventFd >= 0)
+    {
+        while ((read(ringRef->eventFd, &count, sizeof(count)) < 0) && (EINTR == errno))
+        {
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unmap a fix ring and close its file descriptors.
+ */
+//--------------------------------------------------------------------------------------------------
+void gnssFixRing_Close
+(
+    gnssFixRing_Ref_t ringRef           ///< [IN] Ring.
+)
+{
+    LE_ASSERT(ringRef != NULL);
+
+    munmap((void*)ringRef->ringPtr, sizeof(gnssFixRing_t));
+
+    if (ringRef->eventFd >= 0)
+    {
+        close(ringRef->eventFd);
+    }
+
+    le_mem_Release(ringRef);
+}
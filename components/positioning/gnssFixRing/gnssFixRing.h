@@ -0,0 +1,260 @@
+//--------------------------------------------------------------------------------------------------
+/** @file gnssFixRing.h
+ *
+ * Layout of the shared memory fix ring written by the positioning service, and functions to read
+ * it.
+ *
+ * The ring is a header followed by GNSS_FIXRING_SLOT_COUNT records.  The N-th fix written by the
+ * service (counting from 0) goes to the slot N % GNSS_FIXRING_SLOT_COUNT, and the header's
+ * writeCount is then set to N + 1.  Each record is protected by a sequence lock: its seq field is
+ * odd while the service writes the record and is incremented again once the record is complete, so
+ * a reader that sees the same even seq before and after copying a record got a consistent copy.
+ *
+ * A client gets the ring from le_gnss_GetFixRing() and the event file descriptor signalled after
+ * each fix from le_gnss_GetFixRingEvent(), then hands them over to gnssFixRing_Open():
+ *
+ * @code
+ *     int ringFd;
+ *     int eventFd;
+ *
+ *     if (   (LE_OK == le_gnss_GetFixRing(&ringFd))
+ *         && (LE_OK == le_gnss_GetFixRingEvent(&eventFd)))
+ *     {
+ *         gnssFixRing_Ref_t ringRef = gnssFixRing_Open(ringFd, eventFd);
+ *         ...
+ *     }
+ * @endcode
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_GNSS_FIXRING_INCLUDE_GUARD
+#define LEGATO_GNSS_FIXRING_INCLUDE_GUARD
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Magic number at the start of the ring ("GFXR").
+ */
+//--------------------------------------------------------------------------------------------------
+#define GNSS_FIXRING_MAGIC          0x52584647
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Version of the ring layout.  Changed whenever the layout changes.
+ */
+//--------------------------------------------------------------------------------------------------
+#define GNSS_FIXRING_VERSION        1
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of records in the ring.  Must be a power of 2.
+ */
+//--------------------------------------------------------------------------------------------------
+#define GNSS_FIXRING_SLOT_COUNT     32
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of Dilutions of Precision in a record, indexed by le_gnss_DopType_t.
+ */
+//--------------------------------------------------------------------------------------------------
+#define GNSS_FIXRING_DOP_COUNT      5
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Position fix record.
+ *
+ * The fields have the same meaning, unit and invalid value as the output parameters of
+ * le_gnss_GetSample(), except for the vertical position accuracy, the speed accuracies and the
+ * DOP which always have a resolution of 3 decimal places.  fieldsValid is a le_gnss_SampleField_t
+ * bit mask of the valid fields.
+ *
+ * Only fixed-size types are used, so that the layout doesn't depend on the compiler.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t seq;                           ///< Sequence lock, odd while the record is written.
+    uint32_t fieldsValid;                   ///< Bit mask of the valid fields.
+    uint64_t fixIndex;                      ///< Index of the fix, counting from 0.
+    uint64_t timestampNs;                   ///< Time the service got the fix, in nanoseconds of
+                                            ///< CLOCK_MONOTONIC.
+    uint64_t epochTime;                     ///< Milliseconds since Jan. 1, 1970.
+    uint32_t fixState;                      ///< Position fix state (le_gnss_FixState_t).
+    int32_t  latitude;                      ///< WGS84 Latitude [resolution 1e-6].
+    int32_t  longitude;                     ///< WGS84 Longitude [resolution 1e-6].
+    int32_t  hAccuracy;                     ///< Horizontal position's accuracy [resolution 1e-2].
+    int32_t  altitude;                      ///< Altitude above Mean Sea Level [resolution 1e-3].
+    int32_t  vAccuracy;                     ///< Vertical position's accuracy [resolution 1e-3].
+    int32_t  altitudeOnWgs84;               ///< Altitude above the WGS-84 ellipsoid
+                                            ///< [resolution 1e-3].
+    uint32_t hSpeed;                        ///< Horizontal speed [resolution 1e-2].
+    uint32_t hSpeedAccuracy;                ///< Horizontal speed's accuracy [resolution 1e-3].
+    int32_t  vSpeed;                        ///< Vertical speed [resolution 1e-2].
+    int32_t  vSpeedAccuracy;                ///< Vertical speed's accuracy [resolution 1e-3].
+    uint32_t direction;                     ///< Direction [resolution 1e-1].
+    uint32_t directionAccuracy;             ///< Direction's accuracy [resolution 1e-1].
+    uint32_t gpsWeek;                       ///< GPS week number.
+    uint32_t gpsTimeOfWeek;                 ///< Milliseconds into the GPS week.
+    uint32_t timeAccuracy;                  ///< Time accuracy in nanoseconds.
+    int32_t  magneticDeviation;             ///< Magnetic deviation [resolution 1e-1].
+    uint32_t dop[GNSS_FIXRING_DOP_COUNT];   ///< Dilutions of Precision [resolution 1e-3].
+    uint16_t year;                          ///< UTC Year A.D.
+    uint16_t month;                         ///< UTC Month into the year.
+    uint16_t day;                           ///< UTC Days into the month.
+    uint16_t hours;                         ///< UTC Hours into the day.
+    uint16_t minutes;                       ///< UTC Minutes into the hour.
+    uint16_t seconds;                       ///< UTC Seconds into the minute.
+    uint16_t milliseconds;                  ///< UTC Milliseconds into the second.
+    uint8_t  leapSeconds;                   ///< UTC leap seconds in advance.
+    uint8_t  satsInViewCount;               ///< Number of satellites expected to be in view.
+    uint8_t  satsTrackingCount;             ///< Number of satellites in view, when tracking.
+    uint8_t  satsUsedCount;                 ///< Number of satellites in view used for Navigation.
+    uint8_t  reserved[6];                   ///< Padding, set to 0.
+}
+gnssFixRing_Record_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Ring header.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t magic;                         ///< GNSS_FIXRING_MAGIC.
+    uint32_t version;                       ///< GNSS_FIXRING_VERSION.
+    uint32_t recordSize;                    ///< sizeof(gnssFixRing_Record_t).
+    uint32_t slotCount;                     ///< GNSS_FIXRING_SLOT_COUNT.
+    uint64_t writeCount;                    ///< Number of fixes written to the ring.
+    uint8_t  reserved[40];                  ///< Padding to a cache line, set to 0.
+}
+gnssFixRing_Header_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Shared memory fix ring.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    gnssFixRing_Header_t header;
+    gnssFixRing_Record_t records[GNSS_FIXRING_SLOT_COUNT];
+}
+gnssFixRing_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Magic number at the start of a fix log file ("GFXL").
+ *
+ * A fix log is a gnssFixRing_LogHeader_t followed by the records read from the ring, in the order
+ * they were written.  It is written by the gnssRecorder test app and replayed by the replay GNSS
+ * platform adaptor.
+ */
+//--------------------------------------------------------------------------------------------------
+#define GNSS_FIXLOG_MAGIC           0x4c584647
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fix log header.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t magic;                         ///< GNSS_FIXLOG_MAGIC.
+    uint32_t version;                       ///< GNSS_FIXRING_VERSION.
+    uint32_t recordSize;                    ///< sizeof(gnssFixRing_Record_t).
+    uint32_t reserved;                      ///< Padding, set to 0.
+}
+gnssFixRing_LogHeader_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a mapped fix ring.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct gnssFixRing_Reader* gnssFixRing_Ref_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Map a fix ring for reading.  The reader starts after the last fix written to the ring.
+ *
+ * Both file descriptors are owned by the reader from then on, even if this fails.
+ *
+ * @return
+ *      Reference to the ring, or NULL if the file descriptor is not a valid fix ring.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED gnssFixRing_Ref_t gnssFixRing_Open
+(
+    int ringFd,             ///< [IN] File descriptor from le_gnss_GetFixRing().
+    int eventFd             ///< [IN] File descriptor from le_gnss_GetFixRingEvent(), or -1.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the last fix written to the ring, and move the reader after it.
+ *
+ * @return
+ *      - LE_OK if the record was read.
+ *      - LE_UNAVAILABLE if no fix was written to the ring yet.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t gnssFixRing_ReadLatest
+(
+    gnssFixRing_Ref_t ringRef,          ///< [IN] Ring.
+    gnssFixRing_Record_t* recordPtr     ///< [OUT] Copy of the record.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the next fix from the ring.
+ *
+ * @return
+ *      - LE_OK if the record was read.
+ *      - LE_OVERFLOW if the record was read, but the fixes before it were overwritten before they
+ *        could be read.
+ *      - LE_WOULD_BLOCK if there is no new fix.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t gnssFixRing_ReadNext
+(
+    gnssFixRing_Ref_t ringRef,          ///< [IN] Ring.
+    gnssFixRing_Record_t* recordPtr     ///< [OUT] Copy of the record.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the event file descriptor of the ring, to wait for new fixes with poll() or le_fdMonitor.
+ * Once it is reported readable, gnssFixRing_ClearEvent() must be called before reading the fixes.
+ *
+ * @return
+ *      The file descriptor, or -1 if the ring was opened without one.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED int gnssFixRing_GetEventFd
+(
+    gnssFixRing_Ref_t ringRef           ///< [IN] Ring.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Clear the ring's event, so that the event file descriptor is reported readable again only when
+ * a new fix is written.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void gnssFixRing_ClearEvent
+(
+    gnssFixRing_Ref_t ringRef           ///< [IN] Ring.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unmap a fix ring and close its file descriptors.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void gnssFixRing_Close
+(
+    gnssFixRing_Ref_t ringRef           ///< [IN] Ring.
+);
+
+#endif // LEGATO_GNSS_FIXRING_INCLUDE_GUARD
@@ -0,0 +1,1748 @@
+/**
+ * @file pa_gnss_replay.c
+ *
+ * Replay implementation of @ref c_pa_gnss.
+ *
+ * Instead of driving a GNSS device, this platform adaptor replays a recording of the fixes of one,
+ * so that the positioning service can be exercised and benchmarked without hardware, at any rate
+ * and deterministically.  The recording is either:
+ *  - an NMEA log, as read from /dev/nmea: every sentence is reported to the NMEA handlers, and the
+ *    GGA, RMC and GSA sentences of an epoch are parsed into the position reported at its end;
+ *  - a fix log, as written by the gnssRecorder test app from the positioning service's fix ring:
+ *    each record is reported as a position (see gnssFixRing.h).
+ *
+ * The replay is configured under positioningService:/replay:
+ *  - file: path of the recording (mandatory);
+ *  - speed: replay speed in percent of the acquisition rate, 100 by default.  1000 replays the
+ *    fixes ten times faster than they were acquired, and 0 replays them back to back, as fast as
+ *    the positioning service handles them.  A negative speed is rejected;
+ *  - loop: whether the recording is replayed again from the start once it ends, true by default.
+ *
+ * One fix is replayed per (acquisition rate * 100 / speed) ms.  The configuration is read when the
+ * acquisition starts.
+ *
+ * To build the positioning service with this platform adaptor, set
+ * LEGATO_GNSS_PA=$LEGATO_ROOT/components/positioning/platformAdaptor/replay/le_pa_gnss_replay.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "pa_gnss.h"
+#include "gnssFixRing.h"
+
+//--------------------------------------------------------------------------------------------------
+// Symbol and Enum definitions.
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Configuration of the replay.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CFG_REPLAY_PATH             "positioningService:/replay"
+#define CFG_NODE_FILE               "file"
+#define CFG_NODE_SPEED              "speed"
+#define CFG_NODE_LOOP               "loop"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default replay speed, in percent of the acquisition rate.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_SPEED               100
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default acquisition rate, in milliseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_ACQUISITION_RATE    1000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum length of an NMEA sentence, including the end of line and the null terminator.  Longer
+ * lines are skipped.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NMEA_SENTENCE_MAX_BYTES     256
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of fields parsed in an NMEA sentence.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NMEA_FIELD_MAX              24
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of lines read from an NMEA log for one fix.  Bounds the work done on a log
+ * without any GGA or RMC sentence.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NMEA_LINES_PER_FIX_MAX      64
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of position and NMEA reports to preallocate.
+ */
+//--------------------------------------------------------------------------------------------------
+#define POSITION_REPORT_COUNT       4
+#define NMEA_REPORT_COUNT           16
+
+//--------------------------------------------------------------------------------------------------
+// Data structures.
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replayed recording.
+ */
+//--------------------------------------------------------------------------------------------------
+static FILE* ReplayFilePtr;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Whether the recording is a fix log, rather than an NMEA log.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsFixLog;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replay speed, in percent of the acquisition rate, and whether the recording is replayed again
+ * once it ends.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t Speed = DEFAULT_SPEED;
+static bool Loop = true;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Settings of the simulated device.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t AcqRate = DEFAULT_ACQUISITION_RATE;
+static le_gnss_ConstellationBitMask_t ConstellationMask = LE_GNSS_CONSTELLATION_GPS;
+static le_gnss_NmeaBitMask_t NmeaMask = LE_GNSS_NMEA_SENTENCES_MAX;
+static uint8_t MinElevation;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Whether the acquisition is started.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsStarted;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Generation of the acquisition, incremented when it stops.  At speed 0, each replayed fix queues
+ * the next one with the generation it belongs to, so that a chain queued before a stop ends there
+ * rather than running along with the one of the next start.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t Generation;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Time the acquisition started, and Time To First Fix (0 until the first fix is replayed).
+ */
+//--------------------------------------------------------------------------------------------------
+static le_clk_Time_t StartTime;
+static uint32_t Ttff;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer pacing the replay.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_timer_Ref_t ReplayTimer;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Position being assembled from the sentences of the current NMEA epoch, and whether any sentence
+ * of the epoch was parsed into it.
+ */
+//--------------------------------------------------------------------------------------------------
+static pa_Gnss_Position_t NmeaPosition;
+static bool NmeaPositionPending;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * NMEA sentence read ahead: the first sentence of the next epoch.
+ */
+//--------------------------------------------------------------------------------------------------
+static char NextSentence[NMEA_SENTENCE_MAX_BYTES];
+static bool HasNextSentence;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Events and pools of the position and NMEA reports.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_event_Id_t PositionEvent;
+static le_event_Id_t NmeaEvent;
+static le_mem_PoolRef_t PositionPool;
+static le_mem_PoolRef_t NmeaPool;
+
+static void ReplayNextFix(void* param1Ptr, void* param2Ptr);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The first-layer position handler.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FirstLayerPositionHandler
+(
+    void* reportPtr,
+    void* secondLayerHandlerFunc
+)
+{
+    pa_gnss_PositionDataHandlerFunc_t handlerFunc = secondLayerHandlerFunc;
+
+    // The handler releases the report.
+    handlerFunc((pa_Gnss_Position_t*)reportPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The first-layer NMEA handler.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FirstLayerNmeaHandler
+(
+    void* reportPtr,
+    void* secondLayerHandlerFunc
+)
+{
+    pa_gnss_NmeaHandlerFunc_t handlerFunc = secondLayerHandlerFunc;
+
+    // The handler releases the report.
+    handlerFunc((char*)reportPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report a position to the position handlers.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportPosition
+(
+    const pa_Gnss_Position_t* positionPtr   ///< [IN] Position.
+)
+{
+    pa_Gnss_Position_t* reportPtr = le_mem_ForceAlloc(PositionPool);
+
+    memcpy(reportPtr, positionPtr, sizeof(*reportPtr));
+
+    if (0 == Ttff)
+    {
+        le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), StartTime);
+
+        Ttff = elapsed.sec * 1000 + elapsed.usec / 1000;
+        if (0 == Ttff)
+        {
+            Ttff = 1;
+        }
+    }
+
+    le_event_ReportWithRefCounting(PositionEvent, reportPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report an NMEA sentence to the NMEA handlers.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportNmea
+(
+    const char* sentencePtr                 ///< [IN] NMEA sentence.
+)
+{
+    char* reportPtr = le_mem_ForceAlloc(NmeaPool);
+
+    le_utf8_Copy(reportPtr, sentencePtr, NMEA_SENTENCE_MAX_BYTES, NULL);
+    le_event_ReportWithRefCounting(NmeaEvent, reportPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert a fix log record to a position.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RecordToPosition
+(
+    const gnssFixRing_Record_t* recordPtr,  ///< [IN] Record.
+    pa_Gnss_Position_t* positionPtr         ///< [OUT] Position.
+)
+{
+    uint32_t valid = recordPtr->fieldsValid;
+
+    memset(positionPtr, 0, sizeof(*positionPtr));
+
+    positionPtr->fixState = recordPtr->fixState;
+
+    positionPtr->latitudeValid = valid & LE_GNSS_SAMPLE_LATITUDE;
+    positionPtr->latitude = recordPtr->latitude;
+    positionPtr->longitudeValid = valid & LE_GNSS_SAMPLE_LONGITUDE;
+    positionPtr->longitude = recordPtr->longitude;
+    positionPtr->hUncertaintyValid = valid & LE_GNSS_SAMPLE_H_ACCURACY;
+    positionPtr->hUncertainty = recordPtr->hAccuracy;
+    positionPtr->altitudeValid = valid & LE_GNSS_SAMPLE_ALTITUDE;
+    positionPtr->altitude = recordPtr->altitude;
+    positionPtr->vUncertaintyValid = valid & LE_GNSS_SAMPLE_V_ACCURACY;
+    positionPtr->vUncertainty = recordPtr->vAccuracy;
+    positionPtr->altitudeOnWgs84Valid = valid & LE_GNSS_SAMPLE_ALTITUDE_ON_WGS84;
+    positionPtr->altitudeOnWgs84 = recordPtr->altitudeOnWgs84;
+    positionPtr->hSpeedValid = valid & LE_GNSS_SAMPLE_H_SPEED;
+    positionPtr->hSpeed = recordPtr->hSpeed;
+    positionPtr->hSpeedUncertaintyValid = valid & LE_GNSS_SAMPLE_H_SPEED_ACCURACY;
+    positionPtr->hSpeedUncertainty = recordPtr->hSpeedAccuracy;
+    positionPtr->vSpeedValid = valid & LE_GNSS_SAMPLE_V_SPEED;
+    positionPtr->vSpeed = (uint32_t)recordPtr->vSpeed;
+    positionPtr->vSpeedUncertaintyValid = valid & LE_GNSS_SAMPLE_V_SPEED_ACCURACY;
+    positionPtr->vSpeedUncertainty = recordPtr->vSpeedAccuracy;
+    positionPtr->directionValid = valid & LE_GNSS_SAMPLE_DIRECTION;
+    positionPtr->direction = recordPtr->direction;
+    positionPtr->directionUncertaintyValid = valid & LE_GNSS_SAMPLE_DIRECTION_ACCURACY;
+    positionPtr->directionUncertainty = recordPtr->directionAccuracy;
+    positionPtr->magneticDeviationValid = valid & LE_GNSS_SAMPLE_MAGNETIC_DEVIATION;
+    positionPtr->magneticDeviation = recordPtr->magneticDeviation;
+
+    positionPtr->dateValid = valid & LE_GNSS_SAMPLE_DATE;
+    positionPtr->date.year = recordPtr->year;
+    positionPtr->date.month = recordPtr->month;
+    positionPtr->date.day = recordPtr->day;
+    positionPtr->timeValid = valid & LE_GNSS_SAMPLE_TIME;
+    positionPtr->time.hours = recordPtr->hours;
+    positionPtr->time.minutes = recordPtr->minutes;
+    positionPtr->time.seconds = recordPtr->seconds;
+    positionPtr->time.milliseconds = recordPtr->milliseconds;
+    positionPtr->epochTime = recordPtr->epochTime;
+    positionPtr->gpsTimeValid = valid & LE_GNSS_SAMPLE_GPS_TIME;
+    positionPtr->gpsWeek = recordPtr->gpsWeek;
+    positionPtr->gpsTimeOfWeek = recordPtr->gpsTimeOfWeek;
+    positionPtr->timeAccuracyValid = valid & LE_GNSS_SAMPLE_TIME_ACCURACY;
+    positionPtr->timeAccuracy = recordPtr->timeAccuracy;
+    positionPtr->leapSecondsValid = valid & LE_GNSS_SAMPLE_LEAP_SECONDS;
+    positionPtr->leapSeconds = recordPtr->leapSeconds;
+
+    positionPtr->pdopValid = valid & LE_GNSS_SAMPLE_PDOP;
+    positionPtr->pdop = recordPtr->dop[LE_GNSS_PDOP];
+    positionPtr->hdopValid = valid & LE_GNSS_SAMPLE_HDOP;
+    positionPtr->hdop = recordPtr->dop[LE_GNSS_HDOP];
+    positionPtr->vdopValid = valid & LE_GNSS_SAMPLE_VDOP;
+    positionPtr->vdop = recordPtr->dop[LE_GNSS_VDOP];
+    positionPtr->gdopValid = valid & LE_GNSS_SAMPLE_GDOP;
+    positionPtr->gdop = recordPtr->dop[LE_GNSS_GDOP];
+    positionPtr->tdopValid = valid & LE_GNSS_SAMPLE_TDOP;
+    positionPtr->tdop = recordPtr->dop[LE_GNSS_TDOP];
+
+    positionPtr->satsInViewCountValid = valid & LE_GNSS_SAMPLE_SATS_IN_VIEW;
+    positionPtr->satsInViewCount = recordPtr->satsInViewCount;
+    positionPtr->satsTrackingCountValid = valid & LE_GNSS_SAMPLE_SATS_TRACKING;
+    positionPtr->satsTrackingCount = recordPtr->satsTrackingCount;
+    positionPtr->satsUsedCountValid = valid & LE_GNSS_SAMPLE_SATS_USED;
+    positionPtr->satsUsedCount = recordPtr->satsUsedCount;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Round a value to the nearest integer.
+ */
+//--------------------------------------------------------------------------------------------------
+static int64_t Round
+(
+    double value
+)
+{
+    return (int64_t)((value < 0) ? (value - 0.5) : (value + 0.5));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the checksum of an NMEA sentence, if it has one, and strip it and the end of line.
+ *
+ * @return
+ *      - true if the sentence is valid.
+ *      - false otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool CheckNmeaSentence
+(
+    char* sentencePtr                       ///< [IN/OUT] NMEA sentence.
+)
+{
+    char* endPtr = sentencePtr + strcspn(sentencePtr, "\r\n");
+    char* starPtr;
+    uint8_t checksum = 0;
+    const char* charPtr;
+
+    *endPtr = '\0';
+
+    if ('$' != sentencePtr[0])
+    {
+        return false;
+    }
+
+    starPtr = strchr(sentencePtr, '*');
+    if (NULL == starPtr)
+    {
+        return true;
+    }
+
+    for (charPtr = sentencePtr + 1; charPtr < starPtr; charPtr++)
+    {
+        checksum ^= (uint8_t)*charPtr;
+    }
+    *starPtr = '\0';
+
+    return (strtoul(starPtr + 1, NULL, 16) == checksum);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse an NMEA latitude or longitude ([d]ddmm.mmmm and hemisphere) in degrees with 6 decimal
+ * places.
+ *
+ * @return
+ *      - true if the field is set.
+ *      - false otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ParseNmeaCoordinate
+(
+    const char* valuePtr,                   ///< [IN] Coordinate field.
+    const char* hemispherePtr,              ///< [IN] Hemisphere field.
+    int32_t* coordinatePtr                  ///< [OUT] Coordinate.
+)
+{
+    if (('\0' == valuePtr[0]) || ('\0' == hemispherePtr[0]))
+    {
+        return false;
+    }
+
+    double value = strtod(valuePtr, NULL);
+    double degrees = (double)((int32_t)(value / 100));
+    double coordinate = (degrees + (value - degrees * 100) / 60) * 1000000;
+
+    if (('S' == hemispherePtr[0]) || ('W' == hemispherePtr[0]))
+    {
+        coordinate = -coordinate;
+    }
+    *coordinatePtr = (int32_t)Round(coordinate);
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse an NMEA UTC time (hhmmss.sss).
+ *
+ * @return
+ *      - true if the field is set.
+ *      - false otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ParseNmeaTime
+(
+    const char* valuePtr,                   ///< [IN] Time field.
+    pa_Gnss_Time_t* timePtr                 ///< [OUT] Time.
+)
+{
+    if (strlen(valuePtr) < 6)
+    {
+        return false;
+    }
+
+    uint32_t ms = (uint32_t)Round(strtod(valuePtr, NULL) * 1000);
+
+    timePtr->milliseconds = ms % 1000;
+    timePtr->seconds = (ms / 1000) % 100;
+    timePtr->minutes = (ms / 100000) % 100;
+    timePtr->hours = ms / 10000000;
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a DOP field in the resolution of the platform adaptor (3 decimal places).
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ParseNmeaDop
+(
+    const char* valuePtr,                   ///< [IN] DOP field.
+    uint32_t* dopPtr                        ///< [OUT] DOP.
+)
+{
+    if ('\0' == valuePtr[0])
+    {
+        return false;
+    }
+
+    *dopPtr = (uint32_t)Round(strtod(valuePtr, NULL) * 1000);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Split an NMEA sentence, without its checksum, into its fields.  The first field is the address,
+ * e.g. "$GPGGA".
+ *
+ * @return
+ *      Number of fields.
+ */
+//--------------------------------------------------------------------------------------------------
+static int SplitNmeaSentence
+(
+    char* sentencePtr,                      ///< [IN/OUT] NMEA sentence, split in place.
+    char* fields[NMEA_FIELD_MAX]            ///< [OUT] Fields.
+)
+{
+    int count = 0;
+    char* fieldPtr = sentencePtr;
+
+    while (count < NMEA_FIELD_MAX)
+    {
+        char* commaPtr = strchr(fieldPtr, ',');
+
+        fields[count++] = fieldPtr;
+        if (NULL == commaPtr)
+        {
+            break;
+        }
+        *commaPtr = '\0';
+        fieldPtr = commaPtr + 1;
+    }
+
+    // Missing fields are empty.
+    while (count < NMEA_FIELD_MAX)
+    {
+        fields[count++] = "";
+    }
+
+    return count;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the UTC time of an NMEA sentence that starts an epoch (GGA or RMC).
+ *
+ * @return
+ *      - true if the sentence is a GGA or RMC sentence with a time.
+ *      - false otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool GetNmeaEpochTime
+(
+    const char* sentencePtr,                ///< [IN] Valid NMEA sentence.
+    pa_Gnss_Time_t* timePtr                 ///< [OUT] Time.
+)
+{
+    if ((strlen(sentencePtr) < 8) ||
+        ((0 != strncmp(sentencePtr + 3, "GGA,", 4)) && (0 != strncmp(sentencePtr + 3, "RMC,", 4))))
+    {
+        return false;
+    }
+
+    char timeField[16];
+
+    le_utf8_Copy(timeField, sentencePtr + 7, sizeof(timeField), NULL);
+    timeField[strcspn(timeField, ",")] = '\0';
+
+    return ParseNmeaTime(timeField, timePtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse the GGA, RMC and GSA sentences into the position of the current epoch.  Other sentences
+ * are only reported to the NMEA handlers.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ParseNmeaSentence
+(
+    const char* sentencePtr                 ///< [IN] Valid NMEA sentence.
+)
+{
+    char sentence[NMEA_SENTENCE_MAX_BYTES];
+    char* fields[NMEA_FIELD_MAX];
+    pa_Gnss_Position_t* posPtr = &NmeaPosition;
+
+    le_utf8_Copy(sentence, sentencePtr, sizeof(sentence), NULL);
+    SplitNmeaSentence(sentence, fields);
+
+    if (strlen(fields[0]) != 6)
+    {
+        return;
+    }
+
+    const char* typePtr = fields[0] + 3;
+
+    if (0 == strcmp(typePtr, "GGA"))
+    {
+        // time, lat, N/S, lon, E/W, quality, sats used, HDOP, altitude, M, geoid separation, M
+        posPtr->timeValid = ParseNmeaTime(fields[1], &posPtr->time) || posPtr->timeValid;
+        posPtr->latitudeValid = ParseNmeaCoordinate(fields[2], fields[3], &posPtr->latitude);
+        posPtr->longitudeValid = ParseNmeaCoordinate(fields[4], fields[5], &posPtr->longitude);
+        if ('\0' != fields[7][0])
+        {
+            posPtr->satsUsedCountValid = true;
+            posPtr->satsUsedCount = (uint8_t)atoi(fields[7]);
+        }
+        posPtr->hdopValid = ParseNmeaDop(fields[8], &posPtr->hdop);
+        if ('\0' != fields[9][0])
+        {
+            double altitude = strtod(fields[9], NULL);
+
+            posPtr->altitudeValid = true;
+            posPtr->altitude = (int32_t)Round(altitude * 1000);
+            if ('\0' != fields[11][0])
+            {
+                posPtr->altitudeOnWgs84Valid = true;
+                posPtr->altitudeOnWgs84 = (int32_t)Round((altitude + strtod(fields[11], NULL))
+                                                         * 1000);
+            }
+        }
+        if ((LE_GNSS_STATE_FIX_NO_POS == posPtr->fixState) && (atoi(fields[6]) > 0))
+        {
+            posPtr->fixState = posPtr->altitudeValid ? LE_GNSS_STATE_FIX_3D
+                                                     : LE_GNSS_STATE_FIX_2D;
+        }
+    }
+    else if (0 == strcmp(typePtr, "RMC"))
+    {
+        // time, status, lat, N/S, lon, E/W, speed (knots), course, date (ddmmyy), variation, E/W
+        posPtr->timeValid = ParseNmeaTime(fields[1], &posPtr->time) || posPtr->timeValid;
+        if ('A' == fields[2][0])
+        {
+            posPtr->latitudeValid = ParseNmeaCoordinate(fields[3], fields[4], &posPtr->latitude);
+            posPtr->longitudeValid = ParseNmeaCoordinate(fields[5], fields[6],
+                                                         &posPtr->longitude);
+            if ('\0' != fields[7][0])
+            {
+                posPtr->hSpeedValid = true;
+                posPtr->hSpeed = (uint32_t)Round(strtod(fields[7], NULL) * 51.4444);
+            }
+            if ('\0' != fields[8][0])
+            {
+                posPtr->directionValid = true;
+                posPtr->direction = (uint32_t)Round(strtod(fields[8], NULL) * 10);
+            }
+            if (LE_GNSS_STATE_FIX_NO_POS == posPtr->fixState)
+            {
+                posPtr->fixState = LE_GNSS_STATE_FIX_2D;
+            }
+        }
+        if (6 == strlen(fields[9]))
+        {
+            uint32_t date = strtoul(fields[9], NULL, 10);
+
+            posPtr->dateValid = true;
+            posPtr->date.day = date / 10000;
+            posPtr->date.month = (date / 100) % 100;
+            // Two-digit years from 80 are in the 20th century, as GPS started in 1980.
+            posPtr->date.year = ((date % 100) >= 80 ? 1900 : 2000) + date % 100;
+        }
+        if (('\0' != fields[10][0]) && ('\0' != fields[11][0]))
+        {
+            posPtr->magneticDeviationValid = true;
+            posPtr->magneticDeviation = (int32_t)Round(strtod(fields[10], NULL) * 10);
+            if ('W' == fields[11][0])
+            {
+                posPtr->magneticDeviation = -posPtr->magneticDeviation;
+            }
+        }
+    }
+    else if (0 == strcmp(typePtr, "GSA"))
+    {
+        // mode, fix type, 12 satellites, PDOP, HDOP, VDOP
+        int fixType = atoi(fields[2]);
+
+        if (3 == fixType)
+        {
+            posPtr->fixState = LE_GNSS_STATE_FIX_3D;
+        }
+        else if ((2 == fixType) && (LE_GNSS_STATE_FIX_3D != posPtr->fixState))
+        {
+            posPtr->fixState = LE_GNSS_STATE_FIX_2D;
+        }
+        posPtr->pdopValid = ParseNmeaDop(fields[15], &posPtr->pdop) || posPtr->pdopValid;
+        posPtr->hdopValid = ParseNmeaDop(fields[16], &posPtr->hdop) || posPtr->hdopValid;
+        posPtr->vdopValid = ParseNmeaDop(fields[17], &posPtr->vdop) || posPtr->vdopValid;
+    }
+    else
+    {
+        return;
+    }
+
+    NmeaPositionPending = true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report the position of the current NMEA epoch, and start a new one.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FlushNmeaPosition
+(
+    void
+)
+{
+    pa_Gnss_Position_t* posPtr = &NmeaPosition;
+
+    if (posPtr->timeValid && posPtr->dateValid)
+    {
+        struct tm utc =
+        {
+            .tm_year = posPtr->date.year - 1900,
+            .tm_mon = posPtr->date.month - 1,
+            .tm_mday = posPtr->date.day,
+            .tm_hour = posPtr->time.hours,
+            .tm_min = posPtr->time.minutes,
+            .tm_sec = posPtr->time.seconds,
+        };
+
+        posPtr->epochTime = (uint64_t)timegm(&utc) * 1000 + posPtr->time.milliseconds;
+    }
+
+    ReportPosition(posPtr);
+
+    memset(posPtr, 0, sizeof(*posPtr));
+    posPtr->fixState = LE_GNSS_STATE_FIX_NO_POS;
+    NmeaPositionPending = false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the next line of an NMEA log.  A line too long for the buffer is read as an empty line.
+ *
+ * @return
+ *      - LE_OK if a line was read.
+ *      - LE_OUT_OF_RANGE if the recording ended.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadNmeaLine
+(
+    char* linePtr                           ///< [OUT] Line, NMEA_SENTENCE_MAX_BYTES long.
+)
+{
+    int c;
+
+    if (NULL == fgets(linePtr, NMEA_SENTENCE_MAX_BYTES, ReplayFilePtr))
+    {
+        return LE_OUT_OF_RANGE;
+    }
+
+    if ((NULL == strchr(linePtr, '\n')) && !feof(ReplayFilePtr))
+    {
+        do
+        {
+            c = fgetc(ReplayFilePtr);
+        }
+        while ((EOF != c) && ('\n' != c));
+
+        linePtr[0] = '\0';
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replay the sentences of the next NMEA epoch, and report its position.
+ *
+ * @return
+ *      - LE_OK if a fix was replayed.
+ *      - LE_OUT_OF_RANGE if the recording ended.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReplayNmeaFix
+(
+    void
+)
+{
+    char sentence[NMEA_SENTENCE_MAX_BYTES];
+    pa_Gnss_Time_t epochTime;
+    int lineCount;
+
+    for (lineCount = 0; lineCount < NMEA_LINES_PER_FIX_MAX; lineCount++)
+    {
+        if (HasNextSentence)
+        {
+            le_utf8_Copy(sentence, NextSentence, sizeof(sentence), NULL);
+            HasNextSentence = false;
+        }
+        else if (LE_OK != ReadNmeaLine(sentence))
+        {
+            if (NmeaPositionPending)
+            {
+                FlushNmeaPosition();
+                return LE_OK;
+            }
+            return LE_OUT_OF_RANGE;
+        }
+        else if (!CheckNmeaSentence(sentence))
+        {
+            continue;
+        }
+
+        // A GGA or RMC sentence with another time than the epoch's starts the next epoch.
+        if (NmeaPositionPending && NmeaPosition.timeValid &&
+            GetNmeaEpochTime(sentence, &epochTime) &&
+            (0 != memcmp(&epochTime, &NmeaPosition.time, sizeof(epochTime))))
+        {
+            le_utf8_Copy(NextSentence, sentence, sizeof(NextSentence), NULL);
+            HasNextSentence = true;
+            FlushNmeaPosition();
+            return LE_OK;
+        }
+
+        ReportNmea(sentence);
+        ParseNmeaSentence(sentence);
+    }
+
+    LE_WARN("No epoch found in %d NMEA sentences", NMEA_LINES_PER_FIX_MAX);
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replay the next record of a fix log.
+ *
+ * @return
+ *      - LE_OK if a fix was replayed.
+ *      - LE_OUT_OF_RANGE if the recording ended.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReplayRecordFix
+(
+    void
+)
+{
+    gnssFixRing_Record_t record;
+    pa_Gnss_Position_t position;
+
+    if (1 != fread(&record, sizeof(record), 1, ReplayFilePtr))
+    {
+        return LE_OUT_OF_RANGE;
+    }
+
+    RecordToPosition(&record, &position);
+    ReportPosition(&position);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Go back to the start of the recording.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RewindRecording
+(
+    void
+)
+{
+    fseek(ReplayFilePtr, IsFixLog ? sizeof(gnssFixRing_LogHeader_t) : 0, SEEK_SET);
+
+    memset(&NmeaPosition, 0, sizeof(NmeaPosition));
+    NmeaPosition.fixState = LE_GNSS_STATE_FIX_NO_POS;
+    NmeaPositionPending = false;
+    HasNextSentence = false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replay the next fix of the recording.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReplayNextFix
+(
+    void* param1Ptr,        ///< [IN] Generation of the acquisition the fix belongs to.
+    void* param2Ptr
+)
+{
+    le_result_t result;
+
+    if ((!IsStarted) || (NULL == ReplayFilePtr) || ((uintptr_t)param1Ptr != Generation))
+    {
+        return;
+    }
+
+    result = IsFixLog ? ReplayRecordFix() : ReplayNmeaFix();
+    if ((LE_OUT_OF_RANGE == result) && Loop)
+    {
+        RewindRecording();
+        result = IsFixLog ? ReplayRecordFix() : ReplayNmeaFix();
+    }
+
+    if (LE_OK != result)
+    {
+        LE_INFO("End of the recording");
+        le_timer_Stop(ReplayTimer);
+        return;
+    }
+
+    // At speed 0, the next fix is replayed as soon as the event loop is done with this one.
+    if (0 == Speed)
+    {
+        le_event_QueueFunction(ReplayNextFix, (void*)(uintptr_t)Generation, NULL);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replay timer handler.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReplayTimerHandler
+(
+    le_timer_Ref_t timerRef
+)
+{
+    ReplayNextFix((void*)(uintptr_t)Generation, NULL);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open the recording set in the configuration, and read the replay settings.
+ *
+ * @return
+ *      - LE_OK on success.
+ *      - LE_FAULT if the recording can't be opened.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t OpenRecording
+(
+    void
+)
+{
+    char path[PATH_MAX] = "";
+    gnssFixRing_LogHeader_t header;
+    int32_t speed;
+
+    le_cfg_IteratorRef_t cfg = le_cfg_CreateReadTxn(CFG_REPLAY_PATH);
+    le_cfg_GetString(cfg, CFG_NODE_FILE, path, sizeof(path), "");
+    speed = le_cfg_GetInt(cfg, CFG_NODE_SPEED, DEFAULT_SPEED);
+    Loop = le_cfg_GetBool(cfg, CFG_NODE_LOOP, true);
+    le_cfg_CancelTxn(cfg);
+
+    if (speed < 0)
+    {
+        LE_ERROR("Invalid replay speed %" PRId32 " in %s/%s", speed, CFG_REPLAY_PATH,
+                 CFG_NODE_SPEED);
+        return LE_FAULT;
+    }
+    Speed = speed;
+
+    if (NULL != ReplayFilePtr)
+    {
+        fclose(ReplayFilePtr);
+        ReplayFilePtr = NULL;
+    }
+
+    if ('\0' == path[0])
+    {
+        LE_ERROR("No recording set in %s/%s", CFG_REPLAY_PATH, CFG_NODE_FILE);
+        return LE_FAULT;
+    }
+
+    ReplayFilePtr = fopen(path, "r");
+    if (NULL == ReplayFilePtr)
+    {
+        LE_ERROR("Failed to open %s (%m)", path);
+        return LE_FAULT;
+    }
+
+    IsFixLog = (1 == fread(&header, sizeof(header), 1, ReplayFilePtr)) &&
+               (GNSS_FIXLOG_MAGIC == header.magic);
+    if (IsFixLog &&
+        ((GNSS_FIXRING_VERSION != header.version) ||
+         (sizeof(gnssFixRing_Record_t) != header.recordSize)))
+    {
+        LE_ERROR("Fix log %s not supported (version %" PRIu32 ", record size %" PRIu32 ")",
+                 path, header.version, header.recordSize);
+        fclose(ReplayFilePtr);
+        ReplayFilePtr = NULL;
+        return LE_FAULT;
+    }
+
+    RewindRecording();
+
+    LE_INFO("Replaying %s log %s at %" PRIu32 "%% speed", IsFixLog ? "fix" : "NMEA", path, Speed);
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the interval of the replay timer from the acquisition rate and the replay speed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetReplayInterval
+(
+    void
+)
+{
+    uint64_t intervalUs = (Speed > 0) ? ((uint64_t)AcqRate * 1000 * 100 / Speed) : 0;
+    le_clk_Time_t interval;
+
+    if (0 == intervalUs)
+    {
+        intervalUs = 1;
+    }
+    interval.sec = intervalUs / 1000000;
+    interval.usec = intervalUs % 1000000;
+
+    le_timer_SetInterval(ReplayTimer, interval);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Init this component
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    PositionEvent = le_event_CreateIdWithRefCounting("ReplayPositionEvent");
+    NmeaEvent = le_event_CreateIdWithRefCounting("ReplayNmeaEvent");
+
+    PositionPool = le_mem_CreatePool("ReplayPositionPool", sizeof(pa_Gnss_Position_t));
+    le_mem_ExpandPool(PositionPool, POSITION_REPORT_COUNT);
+    NmeaPool = le_mem_CreatePool("ReplayNmeaPool", NMEA_SENTENCE_MAX_BYTES);
+    le_mem_ExpandPool(NmeaPool, NMEA_REPORT_COUNT);
+
+    ReplayTimer = le_timer_Create("GnssReplayTimer");
+    le_timer_SetHandler(ReplayTimer, ReplayTimerHandler);
+    le_timer_SetRepeat(ReplayTimer, 0);
+
+    NmeaPosition.fixState = LE_GNSS_STATE_FIX_NO_POS;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to initialize the PA GNSS Module.
+ *
+ * @return LE_FAULT  The function failed.
+ * @return LE_OK     The function succeed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_Init
+(
+    void
+)
+{
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to release the PA GNSS Module.
+ *
+ * @return LE_FAULT  The function failed.
+ * @return LE_OK     The function succeed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_Release
+(
+    void
+)
+{
+    pa_gnss_Stop();
+
+    if (NULL != ReplayFilePtr)
+    {
+        fclose(ReplayFilePtr);
+        ReplayFilePtr = NULL;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the GNSS constellation bit mask
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ *  - LE_UNSUPPORTED request not supported
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_SetConstellation
+(
+    le_gnss_ConstellationBitMask_t constellationMask  ///< [IN] GNSS constellation used in solution.
+)
+{
+    ConstellationMask = constellationMask;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the GNSS constellation bit mask
+ *
+* @return
+*  - LE_OK on success
+*  - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_GetConstellation
+(
+    le_gnss_ConstellationBitMask_t *constellationMaskPtr ///< [OUT] GNSS constellation used
+                                                         ///< in solution
+)
+{
+    LE_ASSERT(NULL != constellationMaskPtr);
+
+    *constellationMaskPtr = ConstellationMask;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to start the GNSS acquisition.
+ *
+ * @return LE_FAULT  The function failed.
+ * @return LE_OK     The function succeed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_Start
+(
+    void
+)
+{
+    if (IsStarted)
+    {
+        return LE_OK;
+    }
+
+    if (LE_OK != OpenRecording())
+    {
+        return LE_FAULT;
+    }
+
+    IsStarted = true;
+    StartTime = le_clk_GetRelativeTime();
+    Ttff = 0;
+
+    if (0 == Speed)
+    {
+        le_event_QueueFunction(ReplayNextFix, (void*)(uintptr_t)Generation, NULL);
+    }
+    else
+    {
+        SetReplayInterval();
+        le_timer_Start(ReplayTimer);
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to stop the GNSS acquisition.
+ *
+ * @return LE_FAULT  The function failed.
+ * @return LE_OK     The function succeed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_Stop
+(
+    void
+)
+{
+    if (IsStarted)
+    {
+        IsStarted = false;
+        Generation++;
+    }
+    le_timer_Stop(ReplayTimer);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function sets the GNSS device acquisition rate.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ *  - LE_UNSUPPORTED request not supported
+ *  - LE_TIMEOUT a time-out occurred
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_SetAcquisitionRate
+(
+    uint32_t rate     ///< [IN] rate in milliseconds
+)
+{
+    if (0 == rate)
+    {
+        return LE_UNSUPPORTED;
+    }
+
+    AcqRate = rate;
+    if (IsStarted && (Speed > 0))
+    {
+        SetReplayInterval();
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to get the rate of GNSS fix reception
+ *
+ *
+ * @return LE_FAULT         The function failed.
+ * @return LE_OK            The function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_GetAcquisitionRate
+(
+    uint32_t* ratePtr     ///< [IN] rate in milliseconds
+)
+{
+    LE_ASSERT(NULL != ratePtr);
+
+    *ratePtr = AcqRate;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to register an handler for GNSS position data notifications.
+ *
+ * @return A handler reference, which is only needed for later removal of the handler.
+ *
+ * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_event_HandlerRef_t pa_gnss_AddPositionDataHandler
+(
+    pa_gnss_PositionDataHandlerFunc_t handler ///< [IN] The handler function.
+)
+{
+    LE_FATAL_IF(NULL == handler, "Position handler is NULL");
+
+    return le_event_AddLayeredHandler("ReplayPositionHandler",
+                                      PositionEvent,
+                                      FirstLayerPositionHandler,
+                                      (le_event_HandlerFunc_t)handler);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to remove a handler for GNSS position data notifications.
+ *
+ * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_gnss_RemovePositionDataHandler
+(
+    le_event_HandlerRef_t    handlerRef ///< [IN] The handler reference.
+)
+{
+    le_event_RemoveHandler(handlerRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to register an handler for NMEA frames notifications.
+ *
+ * @return A handler reference, which is only needed for later removal of the handler.
+ *
+ * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_event_HandlerRef_t pa_gnss_AddNmeaHandler
+(
+    pa_gnss_NmeaHandlerFunc_t handler ///< [IN] The handler function.
+)
+{
+    LE_FATAL_IF(NULL == handler, "NMEA handler is NULL");
+
+    return le_event_AddLayeredHandler("ReplayNmeaHandler",
+                                      NmeaEvent,
+                                      FirstLayerNmeaHandler,
+                                      (le_event_HandlerFunc_t)handler);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to remove a handler for NMEA frames notifications.
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_gnss_RemoveNmeaHandler
+(
+    le_event_HandlerRef_t    handlerRef ///< [IN] The handler reference.
+)
+{
+    le_event_RemoveHandler(handlerRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to load an 'Extended Ephemeris' file into the GNSS device.
+ *
+ * @return LE_FAULT         The function failed to inject the 'Extended Ephemeris' file.
+ * @return LE_TIMEOUT       A time-out occurred.
+ * @return LE_FORMAT_ERROR  'Extended Ephemeris' file format error.
+ * @return LE_OK            The function succeeded.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_LoadExtendedEphemerisFile
+(
+    int32_t       fd      ///< [IN] extended ephemeris file descriptor
+)
+{
+    LE_ERROR("Unsupported function called");
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to get the validity of the last injected Extended Ephemeris.
+ *
+ * @return LE_FAULT         The function failed to get the validity
+ * @return LE_OK            The function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_GetExtendedEphemerisValidity
+(
+    uint64_t *startTimePtr,    ///< [OUT] Start time in seconds (since Jan. 1, 1970)
+    uint64_t *stopTimePtr      ///< [OUT] Stop time in seconds (since Jan. 1, 1970)
+)
+{
+    LE_ERROR("Unsupported function called");
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function enables the use of the 'Extended Ephemeris' file into the GNSS device.
+ *
+ * @return LE_FAULT         The function failed to enable the 'Extended Ephemeris' file.
+ * @return LE_OK            The function succeeded.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_EnableExtendedEphemerisFile
+(
+    void
+)
+{
+    LE_ERROR("Unsupported function called");
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function disables the use of the 'Extended Ephemeris' file into the GNSS device.
+ *
+ * @return LE_FAULT         The function failed to disable the 'Extended Ephemeris' file.
+ * @return LE_OK            The function succeeded.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_DisableExtendedEphemerisFile
+(
+    void
+)
+{
+    LE_ERROR("Unsupported function called");
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to inject UTC time into the GNSS device.
+ *
+ * @return
+ *  - LE_OK            The function succeeded.
+ *  - LE_FAULT         The function failed to inject the UTC time.
+ *  - LE_TIMEOUT       A time-out occurred.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_InjectUtcTime
+(
+    uint64_t timeUtc,      ///< [IN] UTC time since Jan. 1, 1970 in milliseconds
+    uint32_t timeUnc       ///< [IN] Time uncertainty in milliseconds
+)
+{
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to restart the GNSS device.
+ *
+ * @return LE_FAULT         The function failed.
+ * @return LE_OK            The function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_ForceRestart
+(
+    pa_gnss_Restart_t  restartType ///< [IN] type of restart
+)
+{
+    // A restart replays the recording from its start.
+    if (NULL != ReplayFilePtr)
+    {
+        RewindRecording();
+    }
+    StartTime = le_clk_GetRelativeTime();
+    Ttff = 0;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the TTFF in milliseconds.
+ *
+ * @return LE_BUSY          The position is not fixed and TTFF can't be measured.
+ * @return LE_OK            The function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_GetTtff
+(
+    uint32_t* ttffPtr     ///< [OUT] TTFF in milliseconds
+)
+{
+    LE_ASSERT(NULL != ttffPtr);
+
+    if (0 == Ttff)
+    {
+        return LE_BUSY;
+    }
+
+    *ttffPtr = Ttff;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function enables the GNSS device.
+ *
+ * @return LE_FAULT         The function failed.
+ * @return LE_OK            The function succeeded.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_Enable
+(
+    void
+)
+{
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function disables the GNSS device.
+ *
+ * @return LE_FAULT         The function failed.
+ * @return LE_OK            The function succeeded.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_Disable
+(
+    void
+)
+{
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function sets the SUPL Assisted-GNSS mode.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ *  - LE_UNSUPPORTED request not supported
+ *  - LE_TIMEOUT a time-out occurred
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_SetSuplAssistedMode
+(
+    le_gnss_AssistedMode_t  assistedMode      ///< [IN] Assisted-GNSS mode.
+)
+{
+    LE_ERROR("Unsupported function called");
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function gets the SUPL Assisted-GNSS mode.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_GetSuplAssistedMode
+(
+    le_gnss_AssistedMode_t *assistedModePtr      ///< [OUT] Assisted-GNSS mode.
+)
+{
+    LE_ERROR("Unsupported function called");
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function sets the SUPL server URL.
+ * That server URL is a NULL-terminated string with a maximum string length (including NULL
+ * terminator) equal to 256. Optionally the port number is specified after a colon.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ *  - LE_BUSY service is busy
+ *  - LE_TIMEOUT a time-out occurred
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_SetSuplServerUrl
+(
+    const char*  suplServerUrlPtr      ///< [IN] SUPL server URL.
+)
+{
+    LE_ERROR("Unsupported function called");
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function injects the SUPL certificate to be used in A-GNSS sessions.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ *  - LE_BUSY service is busy
+ *  - LE_TIMEOUT a time-out occurred
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_InjectSuplCertificate
+(
+    uint8_t  suplCertificateId,      ///< [IN] ID of the SUPL certificate.
+                                     ///< Certificate ID range is 0 to 9
+    uint16_t suplCertificateLen,     ///< [IN] SUPL certificate size in Bytes.
+    const char*  suplCertificatePtr  ///< [IN] SUPL certificate contents.
+)
+{
+    LE_ERROR("Unsupported function called");
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function deletes the SUPL certificate.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ *  - LE_BUSY service is busy
+ *  - LE_TIMEOUT a time-out occurred
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_DeleteSuplCertificate
+(
+    uint8_t  suplCertificateId  ///< [IN]  ID of the SUPL certificate.
+                                ///< Certificate ID range is 0 to 9
+)
+{
+    LE_ERROR("Unsupported function called");
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the enabled NMEA sentences bit mask
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ *  - LE_BUSY service is busy
+ *  - LE_TIMEOUT a time-out occurred
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_SetNmeaSentences
+(
+    le_gnss_NmeaBitMask_t nmeaMask ///< [IN] Bit mask for enabled NMEA sentences.
+)
+{
+    NmeaMask = nmeaMask;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the enabled NMEA sentences bit mask
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ *  - LE_BUSY service is busy
+ *  - LE_TIMEOUT a time-out occurred
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_GetNmeaSentences
+(
+    le_gnss_NmeaBitMask_t* nmeaMaskPtr ///< [OUT] Bit mask for enabled NMEA sentences.
+)
+{
+    LE_ASSERT(NULL != nmeaMaskPtr);
+
+    *nmeaMaskPtr = NmeaMask;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function sets the GNSS minimum elevation.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ *  - LE_UNSUPPORTED request not supported
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_SetMinElevation
+(
+    uint8_t  minElevation      ///< [IN] Minimum elevation in degrees [range 0..90].
+)
+{
+    if (minElevation > 90)
+    {
+        return LE_OUT_OF_RANGE;
+    }
+
+    MinElevation = minElevation;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function gets leap seconds information
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ *  - LE_TIMEOUT on indication timeout
+ *  - LE_UNSUPPORTED Not supported on this platform
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_GetLeapSeconds
+(
+    uint64_t* gpsTimePtr,              ///< [OUT] The number of milliseconds of GPS time since
+                                       ///<       Jan. 6, 1980
+    int32_t* currentLeapSecondsPtr,    ///< [OUT] Current UTC leap seconds value in milliseconds
+    uint64_t* changeEventTimePtr,      ///< [OUT] The number of milliseconds since Jan. 6, 1980
+                                       ///<       to the next leap seconds change event
+    int32_t* nextLeapSecondsPtr        ///< [OUT] UTC leap seconds value to be applied at the
+                                       ///<       change event time in milliseconds
+)
+{
+    LE_ERROR("Unsupported function called");
+    return LE_UNSUPPORTED;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function gets the GNSS minimum elevation.
+ *
+ * @return
+*  - LE_OK on success
+*  - LE_BAD_PARAMETER if minElevationPtr is NULL
+*  - LE_FAULT on failure
+*  - LE_UNSUPPORTED request not supported
+*/
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_GetMinElevation
+(
+   uint8_t*  minElevationPtr     ///< [OUT] Minimum elevation in degrees [range 0..90].
+)
+{
+    if (NULL == minElevationPtr)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    *minElevationPtr = MinElevation;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the area for the GNSS constellation
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ *  - LE_UNSUPPORTED request not supported
+ *  - LE_BAD_PARAMETER on invalid constellation area
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_SetConstellationArea
+(
+    le_gnss_Constellation_t satConstellation,        ///< [IN] GNSS constellation used in solution.
+    le_gnss_ConstellationArea_t constellationArea    ///< [IN] GNSS constellation area.
+)
+{
+    LE_ERROR("Unsupported function called");
+    return LE_UNSUPPORTED;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the area for the GNSS constellation
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ *  - LE_UNSUPPORTED request not supported
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_GetConstellationArea
+(
+    le_gnss_Constellation_t satConstellation,         ///< [IN] GNSS constellation used in solution.
+    le_gnss_ConstellationArea_t* constellationAreaPtr ///< [OUT] GNSS constellation area.
+)
+{
+    LE_ERROR("Unsupported function called");
+    return LE_UNSUPPORTED;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert a location data parameter from/to multi-coordinate system
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ *  - LE_BAD_PARAMETER if locationDataDstPtr is NULL
+ *  - LE_UNSUPPORTED request not supported
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_gnss_ConvertDataCoordinateSystem
+(
+    le_gnss_CoordinateSystem_t coordinateSrc,     ///< [IN] Coordinate system to convert from.
+    le_gnss_CoordinateSystem_t coordinateDst,     ///< [IN] Coordinate system to convert to.
+    le_gnss_LocationDataType_t locationDataType,  ///< [IN] Type of location data to convert.
+    int64_t locationDataSrc,                      ///< [IN] Data to convert.
+    int64_t* locationDataDstPtr                   ///< [OUT] Converted Data.
+)
+{
+    LE_ERROR("Unsupported function called");
+    return LE_UNSUPPORTED;
+}
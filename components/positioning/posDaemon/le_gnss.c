@@ -12,6 +12,9 @@
 #include "legato.h"
 #include "interfaces.h"
 #include "pa_gnss.h"
+#include "gnssFixRing.h"
+#include <sys/mman.h>
+#include <sys/eventfd.h>
 
 
 //--------------------------------------------------------------------------------------------------
@@ -33,6 +36,14 @@
 #define LE_GNSS_NMEA_NODE_PATH                  "/dev/nmea"
 #endif
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Format of the name of the fix ring's shared memory object.  The object is only named for as long
+ * as it takes to open it twice (read-write and read-only).
+ */
+//--------------------------------------------------------------------------------------------------
+#define FIXRING_SHM_NAME_FORMAT     "/le_gnss.fixRing.%d"
+
 //--------------------------------------------------------------------------------------------------
 /**
  * SV ID definitions corresponding to SBAS constellation categories
@@ -228,6 +239,8 @@ typedef struct
     le_gnss_Resolution_t        vSpeedAccuracyResolution;   ///< Vertical speed accuracy resolution.
     le_gnss_Resolution_t        hSpeedAccuracyResolution;   ///< Horizontal speed accuracy
                                                             ///< resolution.
+    int                         fixEventFd;                 ///< Fix ring event file descriptor,
+                                                            ///< -1 if not requested.
     le_dls_Link_t               link;                       ///< Object node link.
 }
 le_gnss_Client_t;
@@ -347,6 +360,27 @@ static le_ref_MapRef_t ClientRequestRefMap;
 //--------------------------------------------------------------------------------------------------
 static int NmeaPipeFd = -1;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Shared memory fix ring, NULL until a client requests it.
+ */
+//--------------------------------------------------------------------------------------------------
+static gnssFixRing_t* FixRingPtr = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read-only file descriptor of the fix ring, duplicated for each client that requests it.
+ */
+//--------------------------------------------------------------------------------------------------
+static int FixRingFd = -1;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of clients with a fix ring event file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+static int NumOfFixRingEvents = 0;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Position Handler destructor.
@@ -425,6 +459,27 @@ static void PositionSampleDestructor
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Client session destructor.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void ClientDestructor
+(
+    void* obj
+)
+{
+    le_gnss_Client_t* clientPtr = (le_gnss_Client_t*)obj;
+
+    if (clientPtr->fixEventFd >= 0)
+    {
+        close(clientPtr->fixEventFd);
+        clientPtr->fixEventFd = -1;
+        NumOfFixRingEvents--;
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Create NMEA named pipe (FIFO)
@@ -734,6 +789,7 @@ static void InitClientRequest
     clientRequestPtr->vAccuracyResolution = LE_GNSS_RES_ONE_DECIMAL;
     clientRequestPtr->vSpeedAccuracyResolution = LE_GNSS_RES_ONE_DECIMAL;
     clientRequestPtr->hSpeedAccuracyResolution = LE_GNSS_RES_ONE_DECIMAL;
+    clientRequestPtr->fixEventFd = -1;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -943,6 +999,170 @@ static le_result_t ConvertPositionData
 // APIs.
 //--------------------------------------------------------------------------------------------------
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set an output parameter of le_gnss_GetSample() or a field of a fix ring record to a position
+ * sample's field, or to the field's invalid value, and flag the valid fields in the bit mask.
+ */
+//--------------------------------------------------------------------------------------------------
+#define GET_SAMPLE_FIELD(_outPtr_, _valid_, _value_, _invalidValue_, _fieldBit_, _fieldsValid_) \
+    do                                                                                           \
+    {                                                                                            \
+        if (_valid_)                                                                             \
+        {                                                                                        \
+            (_fieldsValid_) |= (_fieldBit_);                                                     \
+        }                                                                                        \
+        if (NULL != (_outPtr_))                                                                  \
+        {                                                                                        \
+            *(_outPtr_) = (_valid_) ? (_value_) : (_invalidValue_);                              \
+        }                                                                                        \
+    } while (0)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fill a fix ring record from a position sample.  The fields are in the sample's resolution.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FillFixRecord
+(
+    const le_gnss_PositionSample_t* samplePtr,  ///< [IN] Position sample.
+    gnssFixRing_Record_t* recordPtr             ///< [OUT] Record.
+)
+{
+    le_gnss_SampleField_t fieldsValid = 0;
+
+    recordPtr->fixState = samplePtr->fixState;
+
+    GET_SAMPLE_FIELD(&recordPtr->latitude, samplePtr->latitudeValid, samplePtr->latitude,
+                     INT32_MAX, LE_GNSS_SAMPLE_LATITUDE, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->longitude, samplePtr->longitudeValid, samplePtr->longitude,
+                     INT32_MAX, LE_GNSS_SAMPLE_LONGITUDE, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->hAccuracy, samplePtr->hAccuracyValid, samplePtr->hAccuracy,
+                     INT32_MAX, LE_GNSS_SAMPLE_H_ACCURACY, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->altitude, samplePtr->altitudeValid, samplePtr->altitude,
+                     INT32_MAX, LE_GNSS_SAMPLE_ALTITUDE, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->vAccuracy, samplePtr->vAccuracyValid, samplePtr->vAccuracy,
+                     INT32_MAX, LE_GNSS_SAMPLE_V_ACCURACY, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->altitudeOnWgs84, samplePtr->altitudeOnWgs84Valid,
+                     samplePtr->altitudeOnWgs84,
+                     INT32_MAX, LE_GNSS_SAMPLE_ALTITUDE_ON_WGS84, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->hSpeed, samplePtr->hSpeedValid, samplePtr->hSpeed,
+                     UINT32_MAX, LE_GNSS_SAMPLE_H_SPEED, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->hSpeedAccuracy, samplePtr->hSpeedAccuracyValid,
+                     (uint32_t)samplePtr->hSpeedAccuracy,
+                     UINT32_MAX, LE_GNSS_SAMPLE_H_SPEED_ACCURACY, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->vSpeed, samplePtr->vSpeedValid, samplePtr->vSpeed,
+                     INT32_MAX, LE_GNSS_SAMPLE_V_SPEED, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->vSpeedAccuracy, samplePtr->vSpeedAccuracyValid,
+                     samplePtr->vSpeedAccuracy,
+                     INT32_MAX, LE_GNSS_SAMPLE_V_SPEED_ACCURACY, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->direction, samplePtr->directionValid, samplePtr->direction,
+                     UINT32_MAX, LE_GNSS_SAMPLE_DIRECTION, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->directionAccuracy, samplePtr->directionAccuracyValid,
+                     samplePtr->directionAccuracy,
+                     UINT32_MAX, LE_GNSS_SAMPLE_DIRECTION_ACCURACY, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->year, samplePtr->dateValid, samplePtr->year,
+                     0, LE_GNSS_SAMPLE_DATE, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->month, samplePtr->dateValid, samplePtr->month,
+                     0, LE_GNSS_SAMPLE_DATE, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->day, samplePtr->dateValid, samplePtr->day,
+                     0, LE_GNSS_SAMPLE_DATE, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->hours, samplePtr->timeValid, samplePtr->hours,
+                     0, LE_GNSS_SAMPLE_TIME, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->minutes, samplePtr->timeValid, samplePtr->minutes,
+                     0, LE_GNSS_SAMPLE_TIME, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->seconds, samplePtr->timeValid, samplePtr->seconds,
+                     0, LE_GNSS_SAMPLE_TIME, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->milliseconds, samplePtr->timeValid, samplePtr->milliseconds,
+                     0, LE_GNSS_SAMPLE_TIME, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->epochTime, samplePtr->timeValid, samplePtr->epochTime,
+                     0, LE_GNSS_SAMPLE_TIME, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->gpsWeek, samplePtr->gpsTimeValid, samplePtr->gpsWeek,
+                     0, LE_GNSS_SAMPLE_GPS_TIME, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->gpsTimeOfWeek, samplePtr->gpsTimeValid, samplePtr->gpsTimeOfWeek,
+                     0, LE_GNSS_SAMPLE_GPS_TIME, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->timeAccuracy, samplePtr->timeAccuracyValid,
+                     samplePtr->timeAccuracy,
+                     UINT16_MAX, LE_GNSS_SAMPLE_TIME_ACCURACY, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->leapSeconds, samplePtr->leapSecondsValid, samplePtr->leapSeconds,
+                     UINT8_MAX, LE_GNSS_SAMPLE_LEAP_SECONDS, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->dop[LE_GNSS_PDOP], samplePtr->pdopValid, samplePtr->pdop,
+                     UINT16_MAX, LE_GNSS_SAMPLE_PDOP, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->dop[LE_GNSS_HDOP], samplePtr->hdopValid, samplePtr->hdop,
+                     UINT16_MAX, LE_GNSS_SAMPLE_HDOP, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->dop[LE_GNSS_VDOP], samplePtr->vdopValid, samplePtr->vdop,
+                     UINT16_MAX, LE_GNSS_SAMPLE_VDOP, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->dop[LE_GNSS_GDOP], samplePtr->gdopValid, samplePtr->gdop,
+                     UINT16_MAX, LE_GNSS_SAMPLE_GDOP, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->dop[LE_GNSS_TDOP], samplePtr->tdopValid, samplePtr->tdop,
+                     UINT16_MAX, LE_GNSS_SAMPLE_TDOP, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->magneticDeviation, samplePtr->magneticDeviationValid,
+                     samplePtr->magneticDeviation,
+                     INT32_MAX, LE_GNSS_SAMPLE_MAGNETIC_DEVIATION, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->satsInViewCount, samplePtr->satsInViewCountValid,
+                     samplePtr->satsInViewCount,
+                     UINT8_MAX, LE_GNSS_SAMPLE_SATS_IN_VIEW, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->satsTrackingCount, samplePtr->satsTrackingCountValid,
+                     samplePtr->satsTrackingCount,
+                     UINT8_MAX, LE_GNSS_SAMPLE_SATS_TRACKING, fieldsValid);
+    GET_SAMPLE_FIELD(&recordPtr->satsUsedCount, samplePtr->satsUsedCountValid,
+                     samplePtr->satsUsedCount,
+                     UINT8_MAX, LE_GNSS_SAMPLE_SATS_USED, fieldsValid);
+
+    recordPtr->fieldsValid = fieldsValid;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a position sample to the fix ring, and signal the clients' fix ring events.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteFixRing
+(
+    const le_gnss_PositionSample_t* samplePtr   ///< [IN] Position sample.
+)
+{
+    uint64_t fixIndex = FixRingPtr->header.writeCount;
+    gnssFixRing_Record_t* slotPtr = &FixRingPtr->records[fixIndex & (GNSS_FIXRING_SLOT_COUNT - 1)];
+    gnssFixRing_Record_t record;
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+
+    memset(&record, 0, sizeof(record));
+    FillFixRecord(samplePtr, &record);
+    record.fixIndex = fixIndex;
+    record.timestampNs = (uint64_t)now.sec * 1000000000 + (uint64_t)now.usec * 1000;
+
+    // Readers retry while seq is odd, or if it changed while they were copying the record.
+    uint32_t seq = slotPtr->seq;
+    __atomic_store_n(&slotPtr->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    record.seq = seq + 1;
+    memcpy(slotPtr, &record, sizeof(record));
+
+    __atomic_store_n(&slotPtr->seq, seq + 2, __ATOMIC_RELEASE);
+    __atomic_store_n(&FixRingPtr->header.writeCount, fixIndex + 1, __ATOMIC_RELEASE);
+
+    if (NumOfFixRingEvents > 0)
+    {
+        uint64_t one = 1;
+        le_ref_IterRef_t iterRef = le_ref_GetIterator(ClientRequestRefMap);
+
+        while (LE_OK == le_ref_NextNode(iterRef))
+        {
+            le_gnss_Client_t* clientPtr = (le_gnss_Client_t*)le_ref_GetValue(iterRef);
+
+            // The event file descriptors are non-blocking, and a client that doesn't clear its
+            // event just misses the signal.
+            if ((clientPtr->fixEventFd >= 0) &&
+                (write(clientPtr->fixEventFd, &one, sizeof(one)) < 0) && (EAGAIN != errno))
+            {
+                LE_WARN("Failed to signal fix ring event %d (%m)", clientPtr->fixEventFd);
+            }
+        }
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * The PA position Handler.
@@ -971,6 +1191,11 @@ static void PaPositionHandler
     // Get the position sample data from the PA position data report
     GetPosSampleData(&LastPositionSample, positionPtr);
 
+    if (NULL != FixRingPtr)
+    {
+        WriteFixRing(&LastPositionSample);
+    }
+
     if(!NumOfPositionHandlers)
     {
         LE_DEBUG("No positioning handlers, exit Handler Function");
@@ -1242,6 +1467,7 @@ le_result_t gnss_Init
     // Create a pool for client session object structure.
     ClientPoolRef = le_mem_CreatePool("ClientPoolRef", sizeof(le_gnss_Client_t));
     le_mem_ExpandPool(ClientPoolRef, GNSS_POSITION_ACTIVATION_MAX);
+    le_mem_SetDestructor(ClientPoolRef, ClientDestructor);
 
     // Initialize the event client close function handler.
     le_msg_ServiceRef_t msgService = le_gnss_GetServiceRef();
@@ -2983,6 +3209,254 @@ le_result_t le_gnss_GetMagneticDeviation
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a Dilution of Precision of a position sample in the client's resolution.
+ *
+ * @return true if the DOP is valid, false otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool GetSampleDop
+(
+    bool dopValid,          ///< [IN] Whether the sample's DOP is valid.
+    uint32_t dop,           ///< [IN] Sample's DOP.
+    uint16_t* dopPtr        ///< [OUT] DOP in the client's resolution.
+)
+{
+    uint32_t convertedDop = UINT16_MAX;
+
+    if (dopValid)
+    {
+        convertedDop = ConvertDop(dop);
+
+        // Test if the dop value exceeds a uint16_t after the conversion
+        dopValid = !(convertedDop >> 16);
+    }
+
+    *dopPtr = dopValid ? (uint16_t)convertedDop : UINT16_MAX;
+
+    return dopValid;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get all the information of a position sample at once. This is equivalent to calling the
+ * individual getters (le_gnss_GetLocation(), le_gnss_GetAltitude(), le_gnss_GetTime(), ...) on the
+ * same sample, but costs a single IPC round trip.
+ *
+ * @return
+ *  - LE_FAULT         Function failed to find the positionSample.
+ *  - LE_OK            Function succeeded.
+ *
+ * @note Each field is in the same unit and resolution as returned by its individual getter; the
+ *       accuracies and the DOP follow le_gnss_SetDataResolution() and le_gnss_SetDopResolution().
+ *
+ * @note The fields that are not valid are set to the same value as their individual getter would
+ *       return, and their bit is cleared in fieldsValid.
+ *
+ * @note All the output pointers can be set to NULL if not needed.
+ *
+ * @note If the caller is passing an invalid Position sample reference into this function,
+ *       it is a fatal error, the function will not return.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_gnss_GetSample
+(
+    le_gnss_SampleRef_t positionSampleRef,  ///< [IN] Position sample's reference.
+    le_gnss_FixState_t* statePtr,           ///< [OUT] Position fix state.
+    le_gnss_SampleField_t* fieldsValidPtr,  ///< [OUT] Bit mask of the valid fields.
+    int32_t* latitudePtr,                   ///< [OUT] WGS84 Latitude in degrees, positive North
+                                            ///<       [resolution 1e-6].
+    int32_t* longitudePtr,                  ///< [OUT] WGS84 Longitude in degrees, positive East
+                                            ///<       [resolution 1e-6].
+    int32_t* hAccuracyPtr,                  ///< [OUT] Horizontal position's accuracy in meters
+                                            ///<       [resolution 1e-2].
+    int32_t* altitudePtr,                   ///< [OUT] Altitude in meters, above Mean Sea Level
+                                            ///<       [resolution 1e-3].
+    int32_t* vAccuracyPtr,                  ///< [OUT] Vertical position's accuracy in meters.
+    int32_t* altitudeOnWgs84Ptr,            ///< [OUT] Altitude in meters, between WGS-84 earth
+                                            ///<       ellipsoid and mean sea level
+                                            ///<       [resolution 1e-3].
+    uint32_t* hSpeedPtr,                    ///< [OUT] Horizontal speed in meters/second
+                                            ///<       [resolution 1e-2].
+    uint32_t* hSpeedAccuracyPtr,            ///< [OUT] Horizontal speed's accuracy estimate in
+                                            ///<       meters/second.
+    int32_t* vSpeedPtr,                     ///< [OUT] Vertical speed in meters/second
+                                            ///<       [resolution 1e-2].
+    int32_t* vSpeedAccuracyPtr,             ///< [OUT] Vertical speed's accuracy estimate in
+                                            ///<       meters/second.
+    uint32_t* directionPtr,                 ///< [OUT] Direction in degrees [resolution 1e-1].
+                                            ///<       Range: 0 to 359.9, where 0 is True North.
+    uint32_t* directionAccuracyPtr,         ///< [OUT] Direction's accuracy estimate in degrees
+                                            ///<       [resolution 1e-1].
+    uint16_t* yearPtr,                      ///< [OUT] UTC Year A.D. [e.g. 2014].
+    uint16_t* monthPtr,                     ///< [OUT] UTC Month into the year [range 1...12].
+    uint16_t* dayPtr,                       ///< [OUT] UTC Days into the month [range 1...31].
+    uint16_t* hoursPtr,                     ///< [OUT] UTC Hours into the day [range 0..23].
+    uint16_t* minutesPtr,                   ///< [OUT] UTC Minutes into the hour [range 0..59].
+    uint16_t* secondsPtr,                   ///< [OUT] UTC Seconds into the minute [range 0..59].
+    uint16_t* millisecondsPtr,              ///< [OUT] UTC Milliseconds into the second
+                                            ///<       [range 0..999].
+    uint64_t* epochTimePtr,                 ///< [OUT] Milliseconds since Jan. 1, 1970.
+    uint32_t* gpsWeekPtr,                   ///< [OUT] GPS week number from midnight, Jan. 6, 1980.
+    uint32_t* gpsTimeOfWeekPtr,             ///< [OUT] Amount of time in milliseconds into the GPS
+                                            ///<       week.
+    uint32_t* timeAccuracyPtr,              ///< [OUT] Estimated time accuracy in nanoseconds.
+    uint8_t* leapSecondsPtr,                ///< [OUT] UTC leap seconds in advance in seconds.
+    uint16_t* dopPtr,                       ///< [OUT] Dilutions of Precision, indexed by
+                                            ///<       le_gnss_DopType_t.
+    size_t* dopSizePtr,                     ///< [INOUT] Number of Dilutions of Precision.
+    int32_t* magneticDeviationPtr,          ///< [OUT] Magnetic deviation in degrees
+                                            ///<       [resolution 1e-1].
+    uint8_t* satsInViewCountPtr,            ///< [OUT] Number of satellites expected to be in view.
+    uint8_t* satsTrackingCountPtr,          ///< [OUT] Number of satellites in view, when tracking.
+    uint8_t* satsUsedCountPtr               ///< [OUT] Number of satellites in view used for
+                                            ///<       Navigation.
+)
+{
+    le_gnss_SampleField_t fieldsValid = 0;
+    le_gnss_PositionSample_t* samplePtr;
+    le_gnss_PositionSampleRequest_t* positionSampleRequestNodePtr
+                                            = le_ref_Lookup(PositionSampleMap,positionSampleRef);
+    bool valid;
+    int32_t accuracy = INT32_MAX;
+    uint16_t dop[LE_GNSS_DOP_MAX_LEN];
+
+    // Check position sample's reference
+    le_result_t result = ValidatePositionSamplePtr(positionSampleRequestNodePtr);
+    if (LE_OK != result)
+    {
+        return result;
+    }
+
+    samplePtr = positionSampleRequestNodePtr->positionSampleNodePtr;
+
+    if (statePtr)
+    {
+        *statePtr = samplePtr->fixState;
+    }
+
+    // Location
+    GET_SAMPLE_FIELD(latitudePtr, samplePtr->latitudeValid, samplePtr->latitude,
+                     INT32_MAX, LE_GNSS_SAMPLE_LATITUDE, fieldsValid);
+    GET_SAMPLE_FIELD(longitudePtr, samplePtr->longitudeValid, samplePtr->longitude,
+                     INT32_MAX, LE_GNSS_SAMPLE_LONGITUDE, fieldsValid);
+    GET_SAMPLE_FIELD(hAccuracyPtr, samplePtr->hAccuracyValid, samplePtr->hAccuracy,
+                     INT32_MAX, LE_GNSS_SAMPLE_H_ACCURACY, fieldsValid);
+
+    // Altitude
+    GET_SAMPLE_FIELD(altitudePtr, samplePtr->altitudeValid, samplePtr->altitude,
+                     INT32_MAX, LE_GNSS_SAMPLE_ALTITUDE, fieldsValid);
+    valid = samplePtr->vAccuracyValid &&
+            (LE_OK == ConvertPositionData(samplePtr->vAccuracy, LE_GNSS_DATA_VACCURACY, &accuracy));
+    GET_SAMPLE_FIELD(vAccuracyPtr, valid, accuracy,
+                     INT32_MAX, LE_GNSS_SAMPLE_V_ACCURACY, fieldsValid);
+    GET_SAMPLE_FIELD(altitudeOnWgs84Ptr, samplePtr->altitudeOnWgs84Valid,
+                     samplePtr->altitudeOnWgs84,
+                     INT32_MAX, LE_GNSS_SAMPLE_ALTITUDE_ON_WGS84, fieldsValid);
+
+    // Horizontal and vertical speeds
+    GET_SAMPLE_FIELD(hSpeedPtr, samplePtr->hSpeedValid, samplePtr->hSpeed,
+                     UINT32_MAX, LE_GNSS_SAMPLE_H_SPEED, fieldsValid);
+    valid = samplePtr->hSpeedAccuracyValid &&
+            (LE_OK == ConvertPositionData(samplePtr->hSpeedAccuracy, LE_GNSS_DATA_HSPEEDACCURACY,
+                                          &accuracy));
+    GET_SAMPLE_FIELD(hSpeedAccuracyPtr, valid, (uint32_t)accuracy,
+                     UINT32_MAX, LE_GNSS_SAMPLE_H_SPEED_ACCURACY, fieldsValid);
+    GET_SAMPLE_FIELD(vSpeedPtr, samplePtr->vSpeedValid, samplePtr->vSpeed,
+                     INT32_MAX, LE_GNSS_SAMPLE_V_SPEED, fieldsValid);
+    valid = samplePtr->vSpeedAccuracyValid &&
+            (LE_OK == ConvertPositionData(samplePtr->vSpeedAccuracy, LE_GNSS_DATA_VSPEEDACCURACY,
+                                          &accuracy));
+    GET_SAMPLE_FIELD(vSpeedAccuracyPtr, valid, accuracy,
+                     INT32_MAX, LE_GNSS_SAMPLE_V_SPEED_ACCURACY, fieldsValid);
+
+    // Direction
+    GET_SAMPLE_FIELD(directionPtr, samplePtr->directionValid, samplePtr->direction,
+                     UINT32_MAX, LE_GNSS_SAMPLE_DIRECTION, fieldsValid);
+    GET_SAMPLE_FIELD(directionAccuracyPtr, samplePtr->directionAccuracyValid,
+                     samplePtr->directionAccuracy,
+                     UINT32_MAX, LE_GNSS_SAMPLE_DIRECTION_ACCURACY, fieldsValid);
+
+    // Date and time
+    GET_SAMPLE_FIELD(yearPtr, samplePtr->dateValid, samplePtr->year,
+                     0, LE_GNSS_SAMPLE_DATE, fieldsValid);
+    GET_SAMPLE_FIELD(monthPtr, samplePtr->dateValid, samplePtr->month,
+                     0, LE_GNSS_SAMPLE_DATE, fieldsValid);
+    GET_SAMPLE_FIELD(dayPtr, samplePtr->dateValid, samplePtr->day,
+                     0, LE_GNSS_SAMPLE_DATE, fieldsValid);
+    GET_SAMPLE_FIELD(hoursPtr, samplePtr->timeValid, samplePtr->hours,
+                     0, LE_GNSS_SAMPLE_TIME, fieldsValid);
+    GET_SAMPLE_FIELD(minutesPtr, samplePtr->timeValid, samplePtr->minutes,
+                     0, LE_GNSS_SAMPLE_TIME, fieldsValid);
+    GET_SAMPLE_FIELD(secondsPtr, samplePtr->timeValid, samplePtr->seconds,
+                     0, LE_GNSS_SAMPLE_TIME, fieldsValid);
+    GET_SAMPLE_FIELD(millisecondsPtr, samplePtr->timeValid, samplePtr->milliseconds,
+                     0, LE_GNSS_SAMPLE_TIME, fieldsValid);
+    GET_SAMPLE_FIELD(epochTimePtr, samplePtr->timeValid, samplePtr->epochTime,
+                     0, LE_GNSS_SAMPLE_TIME, fieldsValid);
+    GET_SAMPLE_FIELD(gpsWeekPtr, samplePtr->gpsTimeValid, samplePtr->gpsWeek,
+                     0, LE_GNSS_SAMPLE_GPS_TIME, fieldsValid);
+    GET_SAMPLE_FIELD(gpsTimeOfWeekPtr, samplePtr->gpsTimeValid, samplePtr->gpsTimeOfWeek,
+                     0, LE_GNSS_SAMPLE_GPS_TIME, fieldsValid);
+    GET_SAMPLE_FIELD(timeAccuracyPtr, samplePtr->timeAccuracyValid, samplePtr->timeAccuracy,
+                     UINT16_MAX, LE_GNSS_SAMPLE_TIME_ACCURACY, fieldsValid);
+    GET_SAMPLE_FIELD(leapSecondsPtr, samplePtr->leapSecondsValid, samplePtr->leapSeconds,
+                     UINT8_MAX, LE_GNSS_SAMPLE_LEAP_SECONDS, fieldsValid);
+
+    // Dilutions of precision
+    if (GetSampleDop(samplePtr->pdopValid, samplePtr->pdop, &dop[LE_GNSS_PDOP]))
+    {
+        fieldsValid |= LE_GNSS_SAMPLE_PDOP;
+    }
+    if (GetSampleDop(samplePtr->hdopValid, samplePtr->hdop, &dop[LE_GNSS_HDOP]))
+    {
+        fieldsValid |= LE_GNSS_SAMPLE_HDOP;
+    }
+    if (GetSampleDop(samplePtr->vdopValid, samplePtr->vdop, &dop[LE_GNSS_VDOP]))
+    {
+        fieldsValid |= LE_GNSS_SAMPLE_VDOP;
+    }
+    if (GetSampleDop(samplePtr->gdopValid, samplePtr->gdop, &dop[LE_GNSS_GDOP]))
+    {
+        fieldsValid |= LE_GNSS_SAMPLE_GDOP;
+    }
+    if (GetSampleDop(samplePtr->tdopValid, samplePtr->tdop, &dop[LE_GNSS_TDOP]))
+    {
+        fieldsValid |= LE_GNSS_SAMPLE_TDOP;
+    }
+    if ((dopPtr) && (dopSizePtr))
+    {
+        if (*dopSizePtr > LE_GNSS_DOP_MAX_LEN)
+        {
+            *dopSizePtr = LE_GNSS_DOP_MAX_LEN;
+        }
+        memcpy(dopPtr, dop, *dopSizePtr * sizeof(dop[0]));
+    }
+
+    GET_SAMPLE_FIELD(magneticDeviationPtr, samplePtr->magneticDeviationValid,
+                     samplePtr->magneticDeviation,
+                     INT32_MAX, LE_GNSS_SAMPLE_MAGNETIC_DEVIATION, fieldsValid);
+
+    // Satellites status
+    GET_SAMPLE_FIELD(satsInViewCountPtr, samplePtr->satsInViewCountValid,
+                     samplePtr->satsInViewCount,
+                     UINT8_MAX, LE_GNSS_SAMPLE_SATS_IN_VIEW, fieldsValid);
+    GET_SAMPLE_FIELD(satsTrackingCountPtr, samplePtr->satsTrackingCountValid,
+                     samplePtr->satsTrackingCount,
+                     UINT8_MAX, LE_GNSS_SAMPLE_SATS_TRACKING, fieldsValid);
+    GET_SAMPLE_FIELD(satsUsedCountPtr, samplePtr->satsUsedCountValid,
+                     samplePtr->satsUsedCount,
+                     UINT8_MAX, LE_GNSS_SAMPLE_SATS_USED, fieldsValid);
+
+    if (fieldsValidPtr)
+    {
+        *fieldsValidPtr = fieldsValid;
+    }
+
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function gets the last updated position sample object reference.
@@ -3053,6 +3527,159 @@ void le_gnss_ReleaseSampleRef
     le_mem_Release(positionSampleRequestNodePtr);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create the shared memory fix ring.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CreateFixRing
+(
+    void
+)
+{
+    char shmName[32];
+    gnssFixRing_t* ringPtr = MAP_FAILED;
+
+    snprintf(shmName, sizeof(shmName), FIXRING_SHM_NAME_FORMAT, (int)getpid());
+
+    int fd = shm_open(shmName, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+        LE_ERROR("Failed to create fix ring '%s' (%m)", shmName);
+        return LE_FAULT;
+    }
+
+    // Clients get a read-only file descriptor, so they can't map the ring for writing.
+    int readOnlyFd = shm_open(shmName, O_RDONLY | O_CLOEXEC, 0);
+
+    shm_unlink(shmName);
+
+    if ((readOnlyFd >= 0) && (0 == ftruncate(fd, sizeof(gnssFixRing_t))))
+    {
+        ringPtr = mmap(NULL, sizeof(gnssFixRing_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+
+    close(fd);
+
+    if (MAP_FAILED == ringPtr)
+    {
+        LE_ERROR("Failed to map fix ring (%m)");
+        if (readOnlyFd >= 0)
+        {
+            close(readOnlyFd);
+        }
+        return LE_FAULT;
+    }
+
+    ringPtr->header.version = GNSS_FIXRING_VERSION;
+    ringPtr->header.recordSize = sizeof(gnssFixRing_Record_t);
+    ringPtr->header.slotCount = GNSS_FIXRING_SLOT_COUNT;
+    ringPtr->header.writeCount = 0;
+
+    // Readers check the magic number first, so write it last.
+    __atomic_store_n(&ringPtr->header.magic, GNSS_FIXRING_MAGIC, __ATOMIC_RELEASE);
+
+    FixRingPtr = ringPtr;
+    FixRingFd = readOnlyFd;
+
+    LE_INFO("Fix ring created (%zu bytes)", sizeof(gnssFixRing_t));
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function gets a read-only file descriptor to the shared memory fix ring. The positioning
+ * service creates the ring on the first call, and from then on writes each position fix to it.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_gnss_GetFixRing
+(
+    int* ringFdPtr      ///< [OUT] Read-only file descriptor of the fix ring.
+)
+{
+    if (NULL == ringFdPtr)
+    {
+        LE_KILL_CLIENT("ringFdPtr is NULL !");
+        return LE_FAULT;
+    }
+
+    *ringFdPtr = -1;
+
+    if ((NULL == FixRingPtr) && (LE_OK != CreateFixRing()))
+    {
+        return LE_FAULT;
+    }
+
+    // The IPC closes the file descriptor once it is sent.
+    *ringFdPtr = dup(FixRingFd);
+    if (*ringFdPtr < 0)
+    {
+        LE_ERROR("Failed to duplicate fix ring file descriptor (%m)");
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function gets an event file descriptor (see eventfd(2)) that the positioning service
+ * signals each time it writes a position fix to the shared memory fix ring. There is one event
+ * file descriptor per client session, which is closed by the service when the session closes.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ *
+ * @note The event file descriptor is non-blocking.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_gnss_GetFixRingEvent
+(
+    int* eventFdPtr     ///< [OUT] Event file descriptor.
+)
+{
+    if (NULL == eventFdPtr)
+    {
+        LE_KILL_CLIENT("eventFdPtr is NULL !");
+        return LE_FAULT;
+    }
+
+    *eventFdPtr = -1;
+
+    le_gnss_Client_t* clientPtr = GetClientSessionReference();
+
+    if (clientPtr->fixEventFd < 0)
+    {
+        clientPtr->fixEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (clientPtr->fixEventFd < 0)
+        {
+            LE_ERROR("Failed to create fix ring event (%m)");
+            return LE_FAULT;
+        }
+        NumOfFixRingEvents++;
+    }
+
+    // The IPC closes the file descriptor once it is sent.
+    *eventFdPtr = dup(clientPtr->fixEventFd);
+    if (*eventFdPtr < 0)
+    {
+        LE_ERROR("Failed to duplicate fix ring event (%m)");
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the GNSS constellation bit mask
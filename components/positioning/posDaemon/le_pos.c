@@ -39,8 +39,6 @@
 #define POSITIONING_ACTIVATION_MAX      13      // Ideally should be a prime number.
 
 
-#define CHECK_VALIDITY(_par_,_max_) (((_par_) == (_max_))? false : true)
-
 //--------------------------------------------------------------------------------------------------
 /**
  * The timer interval to kick the watchdog chain.
@@ -48,6 +46,33 @@
 //--------------------------------------------------------------------------------------------------
 #define MS_WDOG_INTERVAL 8
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Movement index parameters.
+ *
+ * The movement handlers are sorted in buckets by the distance the device can still move away from
+ * a reference point without reaching any of their magnitudes.  Only the buckets holding handlers
+ * whose distance is below the distance between the reference point and a new fix have to be
+ * checked.  The reference point is moved to the fix, and all the handlers are sorted again, when
+ * the fix is further than the rebase distance from it.
+ *
+ * The horizontal distances are in meters, and the vertical ones in the unit of the altitude.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MOVEMENT_INDEX_BUCKET_COUNT         32
+#define MOVEMENT_INDEX_H_BUCKET_WIDTH       4
+#define MOVEMENT_INDEX_H_REBASE_DISTANCE    100
+#define MOVEMENT_INDEX_V_BUCKET_WIDTH       32
+#define MOVEMENT_INDEX_V_REBASE_DISTANCE    1000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Horizontal distance, in meters, subtracted from the distance a handler can still move to make
+ * up for the rounding of the computed distances.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MOVEMENT_INDEX_H_MARGIN             2
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Enumeration for time conversion
@@ -134,6 +159,36 @@ typedef struct le_pos_Sample
 }
 le_pos_Sample_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Movement index structure.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_List_t   buckets[MOVEMENT_INDEX_BUCKET_COUNT];   ///< Handlers sorted by their slack.
+    uint32_t        bucketWidth;                            ///< Slack range of a bucket.
+}
+MovementIndex_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Entry of a Position Sample's Handler in a movement index.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    struct le_pos_SampleHandler* handlerPtr;    ///< The handler.
+    int64_t                      slack;         ///< Distance the device can move away from the
+                                                ///  reference point without reaching the
+                                                ///  handler's magnitude, negative if unknown.
+    le_dls_List_t*               listPtr;       ///< List the entry is in, NULL if none.
+    le_dls_Link_t                link;          ///< Object node link.
+}
+MovementIndexEntry_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Position Sample's Handler structure.
@@ -156,6 +211,13 @@ typedef struct le_pos_SampleHandler
     int32_t                      lastAlt;             ///< The altitude associated with the last
                                                       ///  handler's notification.
     le_msg_SessionRef_t          sessionRef;          ///< Store message session reference.
+    MovementIndexEntry_t         hEntry;              ///< Entry in the horizontal movement index,
+                                                      ///  or in the list of handlers to check on
+                                                      ///  every fix.
+    MovementIndexEntry_t         vEntry;              ///< Entry in the vertical movement index.
+    bool                         isCandidate;         ///< True if in the list of handlers to check
+                                                      ///  for the current fix.
+    le_dls_Link_t                candidateLink;       ///< Candidate list node link.
     le_dls_Link_t                link;                ///< Object node link
 }
 le_pos_SampleHandler_t;
@@ -236,6 +298,43 @@ static le_dls_List_t PosSampleList = LE_DLS_LIST_INIT;
 //--------------------------------------------------------------------------------------------------
 static le_dls_List_t PosSampleHandlerList = LE_DLS_LIST_INIT;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Movement indexes of the position sample's handlers with an horizontal and a vertical magnitude.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static MovementIndex_t HorizontalIndex;
+static MovementIndex_t VerticalIndex;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * List of the position sample's handlers without magnitude, reported on every fix.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_dls_List_t EveryFixHandlerList = LE_DLS_LIST_INIT;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * List of the position sample's handlers to check for the current fix.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_dls_List_t CandidateHandlerList = LE_DLS_LIST_INIT;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference point of the movement indexes.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static bool    IndexLocationValid = false;
+static int32_t IndexLatitude;
+static int32_t IndexLongitude;
+static bool    IndexAltitudeValid = false;
+static int32_t IndexAltitude;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Memory Pool for position samples.
@@ -360,6 +459,107 @@ static void PosSampleDestructor
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove a handler's entry from the movement index or list it is in.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemoveFromMovementIndex
+(
+    MovementIndexEntry_t* entryPtr    ///< [IN] The handler's entry.
+)
+{
+    if (NULL != entryPtr->listPtr)
+    {
+        le_dls_Remove(entryPtr->listPtr, &entryPtr->link);
+        entryPtr->listPtr = NULL;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a handler's entry to the bucket of a movement index matching its slack.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddToMovementIndex
+(
+    MovementIndex_t*      indexPtr,   ///< [IN] The movement index.
+    MovementIndexEntry_t* entryPtr,   ///< [IN] The handler's entry.
+    int64_t               slack       ///< [IN] The handler's slack.
+)
+{
+    int64_t bucket = (slack > 0) ? (slack / indexPtr->bucketWidth) : 0;
+
+    if (bucket >= MOVEMENT_INDEX_BUCKET_COUNT)
+    {
+        bucket = MOVEMENT_INDEX_BUCKET_COUNT - 1;
+    }
+
+    RemoveFromMovementIndex(entryPtr);
+    entryPtr->slack = slack;
+    entryPtr->listPtr = &indexPtr->buckets[bucket];
+    le_dls_Queue(entryPtr->listPtr, &entryPtr->link);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a handler to the list of handlers to check for the current fix, if it isn't already in.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddCandidateHandler
+(
+    le_pos_SampleHandler_t* posSampleHandlerNodePtr   ///< [IN] The handler.
+)
+{
+    if (!posSampleHandlerNodePtr->isCandidate)
+    {
+        posSampleHandlerNodePtr->isCandidate = true;
+        le_dls_Queue(&CandidateHandlerList, &posSampleHandlerNodePtr->candidateLink);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add the handlers of a movement index whose magnitude may have been reached to the list of
+ * handlers to check for the current fix.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddCandidateHandlersFromIndex
+(
+    MovementIndex_t* indexPtr,        ///< [IN] The movement index.
+    uint32_t         distance         ///< [IN] Distance between the reference point and the fix.
+)
+{
+    uint32_t lastBucket = distance / indexPtr->bucketWidth;
+    uint32_t bucket;
+
+    if (lastBucket >= MOVEMENT_INDEX_BUCKET_COUNT)
+    {
+        lastBucket = MOVEMENT_INDEX_BUCKET_COUNT - 1;
+    }
+
+    for (bucket = 0; bucket <= lastBucket; bucket++)
+    {
+        le_dls_Link_t* linkPtr = le_dls_Peek(&indexPtr->buckets[bucket]);
+
+        while (NULL != linkPtr)
+        {
+            MovementIndexEntry_t* entryPtr = CONTAINER_OF(linkPtr, MovementIndexEntry_t, link);
+
+            if ((int64_t)distance > entryPtr->slack)
+            {
+                AddCandidateHandler(entryPtr->handlerPtr);
+            }
+
+            linkPtr = le_dls_PeekNext(&indexPtr->buckets[bucket], linkPtr);
+        }
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Pos Sample's Handler destructor.
@@ -387,6 +587,13 @@ static void PosSampleHandlerDestructor
             if (posSampleHandlerNodePtr == (le_pos_SampleHandler_t*)obj)
             {
                 // Remove the node.
+                RemoveFromMovementIndex(&posSampleHandlerNodePtr->hEntry);
+                RemoveFromMovementIndex(&posSampleHandlerNodePtr->vEntry);
+                if (posSampleHandlerNodePtr->isCandidate)
+                {
+                    le_dls_Remove(&CandidateHandlerList, &posSampleHandlerNodePtr->candidateLink);
+                    posSampleHandlerNodePtr->isCandidate = false;
+                }
                 le_dls_Remove(&PosSampleHandlerList, linkPtr);
                 linkPtr=NULL;
             }
@@ -447,10 +654,10 @@ static uint32_t CalculateAcquisitionRate
 //--------------------------------------------------------------------------------------------------
 static uint32_t ComputeDistance
 (
-    uint32_t latitude1,
-    uint32_t longitude1,
-    uint32_t latitude2,
-    uint32_t longitude2
+    int32_t latitude1,
+    int32_t longitude1,
+    int32_t latitude2,
+    int32_t longitude2
 )
 {
     // Haversine formula:
@@ -507,6 +714,185 @@ static bool IsBeyondMagnitude
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sort a handler in the horizontal movement index, according to the position associated with its
+ * last notification.
+ *
+ * A handler can only be notified once the device moved beyond its magnitude from that position.
+ * The distance between the position and the reference point of the index is subtracted from the
+ * magnitude to get the handler's slack: as long as the device is no further than the slack from
+ * the reference point, it is within the magnitude.  The slack is negative if the position is
+ * unknown, so that the handler is checked on every fix.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void UpdateHorizontalIndex
+(
+    le_pos_SampleHandler_t* posSampleHandlerNodePtr   ///< [IN] The handler.
+)
+{
+    int64_t slack = -1;
+
+    if ((IndexLocationValid) &&
+        (0 != posSampleHandlerNodePtr->lastLat) && (0 != posSampleHandlerNodePtr->lastLong))
+    {
+        slack = (int64_t)posSampleHandlerNodePtr->horizontalMagnitude
+                - ComputeDistance(posSampleHandlerNodePtr->lastLat,
+                                  posSampleHandlerNodePtr->lastLong,
+                                  IndexLatitude,
+                                  IndexLongitude)
+                - MOVEMENT_INDEX_H_MARGIN;
+    }
+    AddToMovementIndex(&HorizontalIndex, &posSampleHandlerNodePtr->hEntry, slack);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sort a handler in the vertical movement index, according to the altitude associated with its
+ * last notification.  See UpdateHorizontalIndex().
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void UpdateVerticalIndex
+(
+    le_pos_SampleHandler_t* posSampleHandlerNodePtr   ///< [IN] The handler.
+)
+{
+    int64_t slack = -1;
+
+    if ((IndexAltitudeValid) && (0 != posSampleHandlerNodePtr->lastAlt))
+    {
+        slack = (int64_t)posSampleHandlerNodePtr->verticalMagnitude
+                - llabs((int64_t)posSampleHandlerNodePtr->lastAlt - IndexAltitude);
+    }
+    AddToMovementIndex(&VerticalIndex, &posSampleHandlerNodePtr->vEntry, slack);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sort a handler in the movement indexes of its magnitudes, or in the list of handlers reported
+ * on every fix if it has none.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void UpdateMovementIndex
+(
+    le_pos_SampleHandler_t* posSampleHandlerNodePtr   ///< [IN] The handler.
+)
+{
+    if ((0 == posSampleHandlerNodePtr->horizontalMagnitude) &&
+        (0 == posSampleHandlerNodePtr->verticalMagnitude))
+    {
+        if (NULL == posSampleHandlerNodePtr->hEntry.listPtr)
+        {
+            posSampleHandlerNodePtr->hEntry.listPtr = &EveryFixHandlerList;
+            le_dls_Queue(&EveryFixHandlerList, &posSampleHandlerNodePtr->hEntry.link);
+        }
+        return;
+    }
+
+    if (0 != posSampleHandlerNodePtr->horizontalMagnitude)
+    {
+        UpdateHorizontalIndex(posSampleHandlerNodePtr);
+    }
+    if (0 != posSampleHandlerNodePtr->verticalMagnitude)
+    {
+        UpdateVerticalIndex(posSampleHandlerNodePtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move the reference point of the movement indexes if the fix is too far from it, and get the
+ * handlers whose magnitude may have been reached by the fix.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetCandidateHandlers
+(
+    const PositionParam_t* posParamPtr    ///< [IN] The position of the fix.
+)
+{
+    uint32_t horizontalDistance = 0;
+    uint32_t verticalDistance = 0;
+    bool     horizontalRebase = false;
+    bool     verticalRebase = false;
+    le_dls_Link_t* linkPtr;
+
+    if (posParamPtr->locationValid)
+    {
+        if (IndexLocationValid)
+        {
+            horizontalDistance = ComputeDistance(IndexLatitude, IndexLongitude,
+                                                 posParamPtr->latitude, posParamPtr->longitude);
+        }
+        if ((!IndexLocationValid) || (horizontalDistance > MOVEMENT_INDEX_H_REBASE_DISTANCE))
+        {
+            IndexLocationValid = true;
+            IndexLatitude = posParamPtr->latitude;
+            IndexLongitude = posParamPtr->longitude;
+            horizontalDistance = 0;
+            horizontalRebase = true;
+        }
+    }
+
+    if (posParamPtr->altitudeValid)
+    {
+        if (IndexAltitudeValid)
+        {
+            verticalDistance = llabs((int64_t)posParamPtr->altitude - IndexAltitude);
+        }
+        if ((!IndexAltitudeValid) || (verticalDistance > MOVEMENT_INDEX_V_REBASE_DISTANCE))
+        {
+            IndexAltitudeValid = true;
+            IndexAltitude = posParamPtr->altitude;
+            verticalDistance = 0;
+            verticalRebase = true;
+        }
+    }
+
+    if ((horizontalRebase) || (verticalRebase))
+    {
+        LE_DEBUG("Movement index reference point moved to lat.%d, long.%d, alt.%d",
+                 IndexLatitude, IndexLongitude, IndexAltitude);
+
+        linkPtr = le_dls_Peek(&PosSampleHandlerList);
+        while (NULL != linkPtr)
+        {
+            le_pos_SampleHandler_t* posSampleHandlerNodePtr =
+                                        CONTAINER_OF(linkPtr, le_pos_SampleHandler_t, link);
+
+            if ((horizontalRebase) && (0 != posSampleHandlerNodePtr->horizontalMagnitude))
+            {
+                UpdateHorizontalIndex(posSampleHandlerNodePtr);
+            }
+            if ((verticalRebase) && (0 != posSampleHandlerNodePtr->verticalMagnitude))
+            {
+                UpdateVerticalIndex(posSampleHandlerNodePtr);
+            }
+            linkPtr = le_dls_PeekNext(&PosSampleHandlerList, linkPtr);
+        }
+    }
+
+    linkPtr = le_dls_Peek(&EveryFixHandlerList);
+    while (NULL != linkPtr)
+    {
+        AddCandidateHandler(CONTAINER_OF(linkPtr, MovementIndexEntry_t, link)->handlerPtr);
+        linkPtr = le_dls_PeekNext(&EveryFixHandlerList, linkPtr);
+    }
+
+    // A handler can't be notified without the location or the altitude its magnitude applies to.
+    if (posParamPtr->locationValid)
+    {
+        AddCandidateHandlersFromIndex(&HorizontalIndex, horizontalDistance);
+    }
+    if (posParamPtr->altitudeValid)
+    {
+        AddCandidateHandlersFromIndex(&VerticalIndex, verticalDistance);
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Calculate the smallest acquisition rate to use for all the registered handlers.
@@ -741,7 +1127,8 @@ static void PosSampleHandlerfunc
     void* contextPtr
 )
 {
-    le_result_t result;
+    // Valid fields of the GNSS sample
+    le_gnss_SampleField_t fieldsValid;
     // Location parameters
     bool        locationValid = false;
     int32_t     latitude;
@@ -795,10 +1182,25 @@ static void PosSampleHandlerfunc
 
     LE_DEBUG("Handler Function called with sample %p", positionSampleRef);
 
+    // Get the whole GNSS sample once, whatever the number of handlers to report it to
+    if (LE_OK != le_gnss_GetSample(positionSampleRef, &gnssState, &fieldsValid,
+                                   &latitude, &longitude, &hAccuracy,
+                                   &altitude, &vAccuracy, NULL,
+                                   &hSpeed, &hSpeedAccuracy, &vSpeed, &vSpeedAccuracy,
+                                   &direction, &directionAccuracy,
+                                   &year, &month, &day,
+                                   &hours, &minutes, &seconds, &milliseconds, NULL,
+                                   NULL, NULL, NULL, &leapSeconds,
+                                   NULL, NULL, NULL,
+                                   NULL, NULL, NULL))
+    {
+        LE_ERROR("Failed to get the GNSS sample");
+        le_gnss_ReleaseSampleRef(positionSampleRef);
+        return;
+    }
+
     // Get Location
-    result = le_gnss_GetLocation(positionSampleRef, &latitude, &longitude, &hAccuracy);
-    if ((LE_OK == result) ||
-        ((LE_OUT_OF_RANGE == result) && (INT32_MAX != latitude) && (INT32_MAX != longitude)))
+    if ((fieldsValid & LE_GNSS_SAMPLE_LATITUDE) && (fieldsValid & LE_GNSS_SAMPLE_LONGITUDE))
     {
         locationValid = true;
         LE_DEBUG("Position lat.%d, long.%d, hAccuracy.%d",
@@ -811,10 +1213,7 @@ static void PosSampleHandlerfunc
     }
 
     // Get altitude
-    result = le_gnss_GetAltitude(positionSampleRef, &altitude, &vAccuracy);
-
-    if ((LE_OK == result) ||
-        ((LE_OUT_OF_RANGE != result) && (INT32_MAX != altitude)))
+    if ((fieldsValid & LE_GNSS_SAMPLE_ALTITUDE) && (fieldsValid & LE_GNSS_SAMPLE_V_ACCURACY))
     {
         altitudeValid = true;
         LE_DEBUG("Altitude.%d, vAccuracy.%d", ConvertDistance(altitude, ALTITUDE),
@@ -826,16 +1225,6 @@ static void PosSampleHandlerfunc
         LE_DEBUG("Altitude unknown [%d,%d]", altitude, vAccuracy);
     }
 
-    // Positioning sample
-    linkPtr = le_dls_Peek(&PosSampleHandlerList);
-
-    if (NULL == linkPtr)
-    {
-        // Release provided Position sample reference
-        le_gnss_ReleaseSampleRef(positionSampleRef);
-        return;
-    }
-
     posParam.latitude = latitude;
     posParam.longitude = longitude;
     posParam.altitude = altitude;
@@ -844,19 +1233,35 @@ static void PosSampleHandlerfunc
     posParam.locationValid = locationValid;
     posParam.altitudeValid = altitudeValid;
 
-    do
+    // Only check the handlers whose magnitude may have been reached
+    GetCandidateHandlers(&posParam);
+
+    while (NULL != (linkPtr = le_dls_Pop(&CandidateHandlerList)))
     {
         bool hflag, vflag;
         // Get the node from the list
         posSampleHandlerNodePtr = (le_pos_SampleHandler_t*)CONTAINER_OF(linkPtr,
                                                                         le_pos_SampleHandler_t,
-                                                                        link);
+                                                                        candidateLink);
+        posSampleHandlerNodePtr->isCandidate = false;
+
+        // Skip the handlers needing a location or an altitude the fix doesn't have
+        if (((0 != posSampleHandlerNodePtr->horizontalMagnitude) && (!locationValid)) ||
+            ((0 != posSampleHandlerNodePtr->verticalMagnitude) && (!altitudeValid)))
+        {
+            continue;
+        }
+
+        // ComputeMove() sets the position associated with the handler on its first check
+        bool isPositionSet = ((0 == posSampleHandlerNodePtr->horizontalMagnitude) ||
+                              ((0 != posSampleHandlerNodePtr->lastLat) &&
+                               (0 != posSampleHandlerNodePtr->lastLong))) &&
+                             ((0 == posSampleHandlerNodePtr->verticalMagnitude) ||
+                              (0 != posSampleHandlerNodePtr->lastAlt));
 
         if (LE_FAULT == ComputeMove(posSampleHandlerNodePtr, &posParam, &hflag, &vflag))
         {
-            // Release provided Position sample reference
-            le_gnss_ReleaseSampleRef(positionSampleRef);
-            return;
+            continue;
         }
 
         // Movement is detected in the following cases:
@@ -874,41 +1279,39 @@ static void PosSampleHandlerfunc
             posSampleRequestPtr->posSampleNodePtr
                                 = (le_pos_Sample_t*)le_mem_ForceAlloc(PosSamplePoolRef);
             posSampleRequestPtr->posSampleNodePtr->latitudeValid
-                                = CHECK_VALIDITY(latitude,INT32_MAX);
+                                = (0 != (fieldsValid & LE_GNSS_SAMPLE_LATITUDE));
             posSampleRequestPtr->posSampleNodePtr->latitude = latitude;
 
             posSampleRequestPtr->posSampleNodePtr->longitudeValid
-                                = CHECK_VALIDITY(longitude,INT32_MAX);
+                                = (0 != (fieldsValid & LE_GNSS_SAMPLE_LONGITUDE));
             posSampleRequestPtr->posSampleNodePtr->longitude = longitude;
 
             posSampleRequestPtr->posSampleNodePtr->hAccuracyValid
-                                = CHECK_VALIDITY(hAccuracy,INT32_MAX);
+                                = (0 != (fieldsValid & LE_GNSS_SAMPLE_H_ACCURACY));
             posSampleRequestPtr->posSampleNodePtr->hAccuracy = hAccuracy;
 
             posSampleRequestPtr->posSampleNodePtr->altitudeValid
-                                = CHECK_VALIDITY(altitude,INT32_MAX);
+                                = (0 != (fieldsValid & LE_GNSS_SAMPLE_ALTITUDE));
             posSampleRequestPtr->posSampleNodePtr->altitude = altitude;
 
             posSampleRequestPtr->posSampleNodePtr->vAccuracyValid
-                                = CHECK_VALIDITY(vAccuracy,INT32_MAX);
+                                = (0 != (fieldsValid & LE_GNSS_SAMPLE_V_ACCURACY));
             posSampleRequestPtr->posSampleNodePtr->vAccuracy = vAccuracy;
 
-            // Get horizontal speed
-            le_gnss_GetHorizontalSpeed(positionSampleRef, &hSpeed, &hSpeedAccuracy);
+            // Horizontal speed
             posSampleRequestPtr->posSampleNodePtr->hSpeedValid
-                                    = CHECK_VALIDITY(hSpeed,UINT32_MAX);
+                                = (0 != (fieldsValid & LE_GNSS_SAMPLE_H_SPEED));
             posSampleRequestPtr->posSampleNodePtr->hSpeed = hSpeed;
-            posSampleRequestPtr->posSampleNodePtr->hSpeedAccuracyValid =
-                                                CHECK_VALIDITY(hSpeedAccuracy,UINT32_MAX);
+            posSampleRequestPtr->posSampleNodePtr->hSpeedAccuracyValid
+                                = (0 != (fieldsValid & LE_GNSS_SAMPLE_H_SPEED_ACCURACY));
             posSampleRequestPtr->posSampleNodePtr->hSpeedAccuracy = hSpeedAccuracy;
 
-            // Get vertical speed
-            le_gnss_GetVerticalSpeed(positionSampleRef, &vSpeed, &vSpeedAccuracy);
+            // Vertical speed
             posSampleRequestPtr->posSampleNodePtr->vSpeedValid
-                                = CHECK_VALIDITY(vSpeed,INT32_MAX);
+                                = (0 != (fieldsValid & LE_GNSS_SAMPLE_V_SPEED));
             posSampleRequestPtr->posSampleNodePtr->vSpeed = vSpeed;
-            posSampleRequestPtr->posSampleNodePtr->vSpeedAccuracyValid =
-                                                CHECK_VALIDITY(vSpeedAccuracy,INT32_MAX);
+            posSampleRequestPtr->posSampleNodePtr->vSpeedAccuracyValid
+                                = (0 != (fieldsValid & LE_GNSS_SAMPLE_V_SPEED_ACCURACY));
             posSampleRequestPtr->posSampleNodePtr->vSpeedAccuracy = vSpeedAccuracy;
 
             // Heading not supported by GNSS engine
@@ -917,64 +1320,35 @@ static void PosSampleHandlerfunc
             posSampleRequestPtr->posSampleNodePtr->headingAccuracyValid = false;
             posSampleRequestPtr->posSampleNodePtr->headingAccuracy = UINT32_MAX;
 
-            // Get direction
-            le_gnss_GetDirection(positionSampleRef, &direction, &directionAccuracy);
-
+            // Direction
             posSampleRequestPtr->posSampleNodePtr->directionValid
-                                = CHECK_VALIDITY(direction,UINT32_MAX);
+                                = (0 != (fieldsValid & LE_GNSS_SAMPLE_DIRECTION));
             posSampleRequestPtr->posSampleNodePtr->direction = direction;
-            posSampleRequestPtr->posSampleNodePtr->directionAccuracyValid =
-                                            CHECK_VALIDITY(directionAccuracy,UINT32_MAX);
+            posSampleRequestPtr->posSampleNodePtr->directionAccuracyValid
+                                = (0 != (fieldsValid & LE_GNSS_SAMPLE_DIRECTION_ACCURACY));
             posSampleRequestPtr->posSampleNodePtr->directionAccuracy = directionAccuracy;
 
-            // Get UTC time
-            if (LE_OK == le_gnss_GetDate(positionSampleRef, &year, &month, &day))
-            {
-                posSampleRequestPtr->posSampleNodePtr->dateValid = true;
-            }
-            else
-            {
-                posSampleRequestPtr->posSampleNodePtr->dateValid = false;
-            }
+            // UTC time
+            posSampleRequestPtr->posSampleNodePtr->dateValid
+                                = (0 != (fieldsValid & LE_GNSS_SAMPLE_DATE));
             posSampleRequestPtr->posSampleNodePtr->year = year;
             posSampleRequestPtr->posSampleNodePtr->month = month;
             posSampleRequestPtr->posSampleNodePtr->day = day;
 
-            if (LE_OK == le_gnss_GetTime(positionSampleRef, &hours, &minutes, &seconds,
-                                         &milliseconds))
-            {
-                posSampleRequestPtr->posSampleNodePtr->timeValid = true;
-            }
-            else
-            {
-                posSampleRequestPtr->posSampleNodePtr->timeValid = false;
-            }
+            posSampleRequestPtr->posSampleNodePtr->timeValid
+                                = (0 != (fieldsValid & LE_GNSS_SAMPLE_TIME));
             posSampleRequestPtr->posSampleNodePtr->hours = hours;
             posSampleRequestPtr->posSampleNodePtr->minutes = minutes;
             posSampleRequestPtr->posSampleNodePtr->seconds = seconds;
             posSampleRequestPtr->posSampleNodePtr->milliseconds = milliseconds;
 
-            // Get UTC leap seconds in advance
-            if (LE_OK == le_gnss_GetGpsLeapSeconds(positionSampleRef, &leapSeconds))
-            {
-               posSampleRequestPtr->posSampleNodePtr->leapSecondsValid = true;
-            }
-            else
-            {
-                posSampleRequestPtr->posSampleNodePtr->leapSecondsValid = false;
-            }
+            // UTC leap seconds in advance
+            posSampleRequestPtr->posSampleNodePtr->leapSecondsValid
+                                = (0 != (fieldsValid & LE_GNSS_SAMPLE_LEAP_SECONDS));
             posSampleRequestPtr->posSampleNodePtr->leapSeconds = leapSeconds;
 
-            // Get position fix state
-            if (LE_OK != le_gnss_GetPositionState(positionSampleRef, &gnssState))
-            {
-                posSampleRequestPtr->posSampleNodePtr->fixState = LE_POS_STATE_UNKNOWN;
-                LE_ERROR("Failed to get a position fix");
-            }
-            else
-            {
-                posSampleRequestPtr->posSampleNodePtr->fixState = (le_pos_FixState_t)gnssState;
-            }
+            // Position fix state
+            posSampleRequestPtr->posSampleNodePtr->fixState = (le_pos_FixState_t)gnssState;
 
             posSampleRequestPtr->posSampleNodePtr->link = LE_DLS_LINK_INIT;
 
@@ -985,6 +1359,7 @@ static void PosSampleHandlerfunc
             posSampleHandlerNodePtr->lastLat = latitude;
             posSampleHandlerNodePtr->lastLong = longitude;
             posSampleHandlerNodePtr->lastAlt = altitude;
+            UpdateMovementIndex(posSampleHandlerNodePtr);
 
             LE_DEBUG("Report sample %p to the corresponding handler (handler %p)",
                      posSampleRequestPtr->posSampleNodePtr,
@@ -1002,10 +1377,11 @@ static void PosSampleHandlerfunc
             posSampleHandlerNodePtr->handlerFuncPtr(reqRef,
                                             posSampleHandlerNodePtr->handlerContextPtr);
         }
-
-        // Move to the next node.
-        linkPtr = le_dls_PeekNext(&PosSampleHandlerList, linkPtr);
-    } while (NULL != linkPtr);
+        else if (!isPositionSet)
+        {
+            UpdateMovementIndex(posSampleHandlerNodePtr);
+        }
+    }
 
     // Release provided Position sample reference
     le_gnss_ReleaseSampleRef(positionSampleRef);
@@ -1181,6 +1557,18 @@ COMPONENT_INIT
                                                 sizeof(le_pos_SampleHandler_t));
     le_mem_SetDestructor(PosSampleHandlerPoolRef, PosSampleHandlerDestructor);
 
+    // Initialize the movement indexes
+    {
+        int i;
+        for (i = 0; i < MOVEMENT_INDEX_BUCKET_COUNT; i++)
+        {
+            HorizontalIndex.buckets[i] = LE_DLS_LIST_INIT;
+            VerticalIndex.buckets[i] = LE_DLS_LIST_INIT;
+        }
+        HorizontalIndex.bucketWidth = MOVEMENT_INDEX_H_BUCKET_WIDTH;
+        VerticalIndex.bucketWidth = MOVEMENT_INDEX_V_BUCKET_WIDTH;
+    }
+
     // Create the reference HashMap for positioning sample
     PosSampleMap = le_ref_CreateMap("PosSampleMap", POSITIONING_SAMPLE_MAX);
 
@@ -1364,6 +1752,15 @@ le_pos_MovementHandlerRef_t le_pos_AddMovementHandler
     posSampleHandlerNodePtr->lastLong = 0;
     posSampleHandlerNodePtr->lastAlt = 0;
 
+    posSampleHandlerNodePtr->hEntry.handlerPtr = posSampleHandlerNodePtr;
+    posSampleHandlerNodePtr->hEntry.listPtr = NULL;
+    posSampleHandlerNodePtr->hEntry.link = LE_DLS_LINK_INIT;
+    posSampleHandlerNodePtr->vEntry.handlerPtr = posSampleHandlerNodePtr;
+    posSampleHandlerNodePtr->vEntry.listPtr = NULL;
+    posSampleHandlerNodePtr->vEntry.link = LE_DLS_LINK_INIT;
+    posSampleHandlerNodePtr->isCandidate = false;
+    posSampleHandlerNodePtr->candidateLink = LE_DLS_LINK_INIT;
+
     // Start acquisition
     if (0 == NumOfHandlers)
     {
@@ -1376,6 +1773,7 @@ le_pos_MovementHandlerRef_t le_pos_AddMovementHandler
     }
 
     le_dls_Queue(&PosSampleHandlerList, &(posSampleHandlerNodePtr->link));
+    UpdateMovementIndex(posSampleHandlerNodePtr);
     NumOfHandlers++;
 
     return (le_pos_MovementHandlerRef_t)posSampleHandlerNodePtr;
@@ -13,6 +13,13 @@
  * writes item "bar" the item will be stored as "/app/foo/bar".  Also, if a non-app user "foo"
  * writes item "bar" the item will be stored as "/foo/bar".
  *
+ * To check the limit of a client without walking through its whole area on every write, the
+ * daemon indexes the items of the area, with their sizes, the first time the client writes to it.
+ * The index and the space used by the area are then updated as the client writes and deletes its
+ * items.  Changes made to an area by other means (secStoreAdmin, or the copy of a system) drop the
+ * index, which is rebuilt at the next write.  The name of a client is also resolved only once per
+ * IPC session.
+ *
  * <hr>
  *
  * Copyright (C) Sierra Wireless Inc.
@@ -63,6 +70,20 @@
 //--------------------------------------------------------------------------------------------------
 #define MS_WDOG_INTERVAL 8
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Estimated number of clients connected at the same time, and of client areas.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CLIENT_MAP_SIZE             31
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Estimated number of items indexed in all client areas.
+ */
+//--------------------------------------------------------------------------------------------------
+#define ITEM_INDEX_SIZE             1031
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Current system path.
@@ -169,6 +190,462 @@ Entry_t;
 static le_mem_PoolRef_t EntryPool = NULL;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * A client connected to the le_secStore service.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_msg_SessionRef_t sessionRef;             ///< Client's session.
+    char name[LIMIT_MAX_USER_NAME_BYTES];       ///< App name, or user name if not an app.
+    bool isApp;                                 ///< true if the client is an app.
+    bool isLimitValid;                          ///< true once secStoreLimit is read.
+    size_t secStoreLimit;                       ///< Client's secure storage limit, in bytes.
+}
+Client_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of clients.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t ClientPool = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Clients, by session reference.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t ClientMap = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A client's area in secure storage.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char path[SECSTOREADMIN_MAX_PATH_BYTES];    ///< Path of the area.
+    bool isIndexed;                             ///< true if usedSpace and itemList are valid.
+    size_t usedSpace;                           ///< Space used by the items of the area.
+    le_dls_List_t itemList;                     ///< Items of the area, in ItemIndex.
+}
+ClientArea_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of client areas.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t ClientAreaPool = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Client areas, by path.  Areas are kept for the life of the daemon.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t ClientAreaMap = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * An item of a client area, with its size.  An item is also its own key in ItemIndex.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    ClientArea_t* areaPtr;                      ///< Area of the item.
+    char name[LE_SECSTORE_MAX_NAME_BYTES];      ///< Path of the item in the area.
+    size_t size;                                ///< Size of the item, in bytes.
+    le_dls_Link_t link;                         ///< Link in the area's list of items.
+}
+IndexedItem_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of indexed items.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t IndexedItemPool = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Items of all client areas, by area and name.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t ItemIndex = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash function of the item index: the key is an item, of which only the area and name are used.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t HashItem
+(
+    const void* keyPtr              ///< [IN] Item.
+)
+{
+    const IndexedItem_t* itemPtr = keyPtr;
+
+    return le_hashmap_HashString(itemPtr->name) * 31 +
+           le_hashmap_HashVoidPointer(itemPtr->areaPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Equality function of the item index.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool EqualsItem
+(
+    const void* firstKeyPtr,        ///< [IN] Item.
+    const void* secondKeyPtr        ///< [IN] Item.
+)
+{
+    const IndexedItem_t* firstPtr = firstKeyPtr;
+    const IndexedItem_t* secondPtr = secondKeyPtr;
+
+    return (firstPtr->areaPtr == secondPtr->areaPtr) &&
+           (strcmp(firstPtr->name, secondPtr->name) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the client area at a path, creating it if needed.  The area is not indexed when created.
+ */
+//--------------------------------------------------------------------------------------------------
+static ClientArea_t* GetClientArea
+(
+    const char* pathPtr             ///< [IN] Path of the area.
+)
+{
+    ClientArea_t* areaPtr = le_hashmap_Get(ClientAreaMap, pathPtr);
+
+    if (areaPtr == NULL)
+    {
+        areaPtr = le_mem_ForceAlloc(ClientAreaPool);
+
+        LE_ASSERT(le_utf8_Copy(areaPtr->path, pathPtr, sizeof(areaPtr->path), NULL) == LE_OK);
+        areaPtr->isIndexed = false;
+        areaPtr->usedSpace = 0;
+        areaPtr->itemList = LE_DLS_LIST_INIT;
+
+        le_hashmap_Put(ClientAreaMap, areaPtr->path, areaPtr);
+    }
+
+    return areaPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the path of an item in a client area, from the path of the item in secure storage.  Items
+ * are indexed by this path, as the PA gets it, rather than by the name given by the client.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* GetItemName
+(
+    const ClientArea_t* areaPtr,    ///< [IN] Area.
+    const char* pathPtr             ///< [IN] Path of the item, under the area.
+)
+{
+    const char* namePtr = pathPtr + strlen(areaPtr->path);
+
+    return (*namePtr == '/') ? namePtr + 1 : namePtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds an item of an area in the index.
+ *
+ * @return
+ *      The item, or NULL if it is not in the index.
+ */
+//--------------------------------------------------------------------------------------------------
+static IndexedItem_t* FindIndexedItem
+(
+    ClientArea_t* areaPtr,          ///< [IN] Area.
+    const char* namePtr             ///< [IN] Path of the item in the area.
+)
+{
+    IndexedItem_t key;
+
+    key.areaPtr = areaPtr;
+    if (le_utf8_Copy(key.name, namePtr, sizeof(key.name), NULL) != LE_OK)
+    {
+        return NULL;
+    }
+
+    return le_hashmap_Get(ItemIndex, &key);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records the size of an item of an indexed area, and the space now used by the area.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_OVERFLOW if the name is too long to be indexed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SetIndexedItem
+(
+    ClientArea_t* areaPtr,          ///< [IN] Area.
+    const char* namePtr,            ///< [IN] Path of the item in the area.
+    size_t size                     ///< [IN] Size of the item, in bytes.
+)
+{
+    IndexedItem_t* itemPtr = FindIndexedItem(areaPtr, namePtr);
+
+    if (itemPtr == NULL)
+    {
+        itemPtr = le_mem_ForceAlloc(IndexedItemPool);
+
+        if (le_utf8_Copy(itemPtr->name, namePtr, sizeof(itemPtr->name), NULL) != LE_OK)
+        {
+            le_mem_Release(itemPtr);
+            return LE_OVERFLOW;
+        }
+        itemPtr->areaPtr = areaPtr;
+        itemPtr->size = 0;
+        itemPtr->link = LE_DLS_LINK_INIT;
+
+        le_dls_Queue(&areaPtr->itemList, &itemPtr->link);
+        le_hashmap_Put(ItemIndex, itemPtr, itemPtr);
+    }
+
+    areaPtr->usedSpace = areaPtr->usedSpace - itemPtr->size + size;
+    itemPtr->size = size;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes an item from the index of an area, and its size from the space used by the area.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemoveIndexedItem
+(
+    IndexedItem_t* itemPtr          ///< [IN] Item.
+)
+{
+    ClientArea_t* areaPtr = itemPtr->areaPtr;
+
+    areaPtr->usedSpace -= itemPtr->size;
+
+    le_hashmap_Remove(ItemIndex, itemPtr);
+    le_dls_Remove(&areaPtr->itemList, &itemPtr->link);
+    le_mem_Release(itemPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Drops the index of a client area, when the content of the area is not known anymore.  The area
+ * will be indexed again when needed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DropAreaIndex
+(
+    ClientArea_t* areaPtr           ///< [IN] Area.
+)
+{
+    le_dls_Link_t* linkPtr;
+
+    while ((linkPtr = le_dls_Peek(&areaPtr->itemList)) != NULL)
+    {
+        RemoveIndexedItem(CONTAINER_OF(linkPtr, IndexedItem_t, link));
+    }
+
+    areaPtr->isIndexed = false;
+    areaPtr->usedSpace = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Drops the index of the client areas that contain or are under a path of secure storage.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DropAreaIndexes
+(
+    const char* pathPtr             ///< [IN] Path that changed, or NULL for all the areas.
+)
+{
+    le_hashmap_It_Ref_t iter = le_hashmap_GetIterator(ClientAreaMap);
+
+    while (le_hashmap_NextNode(iter) == LE_OK)
+    {
+        ClientArea_t* areaPtr = le_hashmap_GetValue(iter);
+
+        if ((pathPtr == NULL) ||
+            le_path_IsEquivalent(pathPtr, areaPtr->path, "/") ||
+            le_path_IsSubpath(pathPtr, areaPtr->path, "/") ||
+            le_path_IsSubpath(areaPtr->path, pathPtr, "/"))
+        {
+            DropAreaIndex(areaPtr);
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds an entry of a directory to a list of entries.  Used as the callback of
+ * pa_secStore_GetEntries() to list a directory before its entries are processed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ListEntry
+(
+    const char* entryNamePtr,       ///< [IN] Entry name.
+    bool isDir,                     ///< [IN] true if the entry is a directory, otherwise entry is a
+                                    ///       file.
+    void* contextPtr                ///< [IN] List of entries.
+)
+{
+    le_sls_List_t* listPtr = contextPtr;
+    Entry_t* entryPtr = le_mem_ForceAlloc(EntryPool);
+
+    entryPtr->link = LE_SLS_LINK_INIT;
+    entryPtr->isDir = isDir;
+
+    if (le_utf8_Copy(entryPtr->path, entryNamePtr, sizeof(entryPtr->path), NULL) != LE_OK)
+    {
+        LE_ERROR("Secure storage entry '%s...' is too long.", entryPtr->path);
+        le_mem_Release(entryPtr);
+        return;
+    }
+
+    le_sls_Queue(listPtr, &entryPtr->link);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Indexes the items of a directory of a client area, and of its sub-directories.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t IndexDirectory
+(
+    ClientArea_t* areaPtr,          ///< [IN] Area.
+    const char* dirNamePtr          ///< [IN] Path of the directory in the area, "" for the area.
+)
+{
+    char path[SECSTOREADMIN_MAX_PATH_BYTES] = "";
+    le_sls_List_t entryList = LE_SLS_LIST_INIT;
+    le_sls_Link_t* linkPtr;
+
+    if (le_path_Concat("/", path, sizeof(path), areaPtr->path, dirNamePtr, NULL) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    // List the directory first: the PA is not called back while it iterates over the entries.
+    le_result_t result = pa_secStore_GetEntries(path, ListEntry, &entryList);
+
+    while ((linkPtr = le_sls_Pop(&entryList)) != NULL)
+    {
+        Entry_t* entryPtr = CONTAINER_OF(linkPtr, Entry_t, link);
+        char name[SECSTOREADMIN_MAX_PATH_BYTES] = "";
+        size_t size = 0;
+
+        if (result == LE_OK)
+        {
+            path[0] = '\0';
+            le_path_Concat("/", name, sizeof(name), dirNamePtr, entryPtr->path, NULL);
+            le_path_Concat("/", path, sizeof(path), areaPtr->path, name, NULL);
+
+            if (entryPtr->isDir)
+            {
+                result = IndexDirectory(areaPtr, name);
+            }
+            else if ((result = pa_secStore_GetSize(path, &size)) == LE_OK)
+            {
+                // Items with longer names can't be written by the client, only their size counts.
+                if (SetIndexedItem(areaPtr, name, size) != LE_OK)
+                {
+                    areaPtr->usedSpace += size;
+                }
+            }
+        }
+
+        le_mem_Release(entryPtr);
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Indexes the items of a client area, if not done yet.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t IndexClientArea
+(
+    ClientArea_t* areaPtr           ///< [IN] Area.
+)
+{
+    if (areaPtr->isIndexed)
+    {
+        return LE_OK;
+    }
+
+    size_t usedSpace = 0;
+    le_result_t result = pa_secStore_GetSize(areaPtr->path, &usedSpace);
+
+    if (result == LE_OK)
+    {
+        result = IndexDirectory(areaPtr, "");
+    }
+    else if (result == LE_NOT_FOUND)
+    {
+        // The client has not stored anything yet.
+        result = LE_OK;
+    }
+
+    if (result != LE_OK)
+    {
+        DropAreaIndex(areaPtr);
+        return result;
+    }
+
+    // The space used by the area is the one counted by the PA, which may differ from the sum of
+    // the item sizes.
+    LE_DEBUG("Indexed %zu items in '%s', %zu bytes (%zu in items).",
+             le_dls_NumLinks(&areaPtr->itemList), areaPtr->path, usedSpace, areaPtr->usedSpace);
+    areaPtr->usedSpace = usedSpace;
+    areaPtr->isIndexed = true;
+
+    return LE_OK;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Checks if the specified system index is in the list.
@@ -522,9 +999,11 @@ static le_result_t InitSystems
         return result;
     }
 
-    // Set the current system.
+    // Set the current system.  The client areas may be copied or moved.
     result = SetCurrSystem(currIndex);
 
+    DropAreaIndexes(NULL);
+
     if (result != LE_OK)
     {
         return result;
@@ -637,6 +1116,95 @@ static le_result_t GetClientName
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the currently connected client.  Its name is only looked up on the first request of its
+ * session.
+ *
+ * This function must be called within an IPC message handler from the client.
+ *
+ * @return
+ *      The client, or NULL if its name could not be found.
+ */
+//--------------------------------------------------------------------------------------------------
+static Client_t* GetClient
+(
+    void
+)
+{
+    le_msg_SessionRef_t sessionRef = le_secStore_GetClientSessionRef();
+    Client_t* clientPtr = le_hashmap_Get(ClientMap, &sessionRef);
+
+    if (clientPtr != NULL)
+    {
+        return clientPtr;
+    }
+
+    clientPtr = le_mem_ForceAlloc(ClientPool);
+    memset(clientPtr, 0, sizeof(Client_t));
+    clientPtr->sessionRef = sessionRef;
+
+    if (GetClientName(clientPtr->name, sizeof(clientPtr->name), &clientPtr->isApp) != LE_OK)
+    {
+        le_mem_Release(clientPtr);
+        return NULL;
+    }
+
+    le_hashmap_Put(ClientMap, &clientPtr->sessionRef, clientPtr);
+
+    return clientPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Forgets a client when its session closes.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemoveClient
+(
+    le_msg_SessionRef_t sessionRef,
+    void*               contextPtr
+)
+{
+    Client_t* clientPtr = le_hashmap_Remove(ClientMap, &sessionRef);
+
+    if (clientPtr != NULL)
+    {
+        le_mem_Release(clientPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash function of the clients map: the key is a pointer to the session reference.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t HashSession
+(
+    const void* keyPtr              ///< [IN] Session reference.
+)
+{
+    return le_hashmap_HashVoidPointer(*(void* const*)keyPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Equality function of the clients map.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool EqualsSession
+(
+    const void* firstKeyPtr,        ///< [IN] Session reference.
+    const void* secondKeyPtr        ///< [IN] Session reference.
+)
+{
+    return *(void* const*)firstKeyPtr == *(void* const*)secondKeyPtr;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets the path to the client's area in secure storage.  If the client is an application the path
@@ -683,47 +1251,40 @@ static void GetClientPath
 //--------------------------------------------------------------------------------------------------
 static le_result_t CheckClientLimit
 (
-    const char* clientNamePtr,              ///< [IN] Name of the client.
-    const char* clientPathPtr,              ///< [IN] Path to the client's area in secure storage.
-    const char* itemNamePtr,                ///< [IN] Name of the item.
+    Client_t* clientPtr,                    ///< [IN] Client.
+    ClientArea_t* areaPtr,                  ///< [IN] Client's area in secure storage.
+    const char* itemNamePtr,                ///< [IN] Path of the item in the area.
     size_t itemSize                         ///< [IN] Size, in bytes, of the item.
 )
 {
     // Get the secure storage limit for the client.
-    appCfg_Iter_t iter = appCfg_FindApp(clientNamePtr);
-    if (!iter)
+    if (!clientPtr->isLimitValid)
     {
-       LE_ERROR("iter is NULL");
-       return LE_FAULT;
+        appCfg_Iter_t iter = appCfg_FindApp(clientPtr->name);
+        if (!iter)
+        {
+           LE_ERROR("iter is NULL");
+           return LE_FAULT;
+        }
+        clientPtr->secStoreLimit = appCfg_GetSecStoreLimit(iter);
+        clientPtr->isLimitValid = true;
+        appCfg_DeleteIter(iter);
     }
-    size_t secStoreLimit = appCfg_GetSecStoreLimit(iter);
-    appCfg_DeleteIter(iter);
 
     // Get the current amount of space used by the client.
-    size_t usedSpace = 0;
-    le_result_t result = pa_secStore_GetSize(clientPathPtr, &usedSpace);
+    le_result_t result = IndexClientArea(areaPtr);
 
-    if ( (result != LE_OK) && (result != LE_NOT_FOUND) )
+    if (result != LE_OK)
     {
         return result;
     }
 
     // Get the size of the item in the secure storage if it already exists.
-    char itemPath[SECSTOREADMIN_MAX_PATH_BYTES] = "";
-
-    LE_FATAL_IF(le_path_Concat("/", itemPath, sizeof(itemPath), clientPathPtr, itemNamePtr, NULL) != LE_OK,
-                "Client %s's path for item %s is too long.", clientNamePtr, itemNamePtr);
-
-    size_t origItemSize = 0;
-    result = pa_secStore_GetSize(itemPath, &origItemSize);
-
-    if ( (result != LE_OK) && (result != LE_NOT_FOUND) )
-    {
-        return result;
-    }
+    IndexedItem_t* itemPtr = FindIndexedItem(areaPtr, itemNamePtr);
+    size_t origItemSize = (itemPtr != NULL) ? itemPtr->size : 0;
 
     // Calculate if replacing the item would fit within the limit.
-    if (((ssize_t)(secStoreLimit - usedSpace + origItemSize - itemSize)) >= 0)
+    if (((ssize_t)(clientPtr->secStoreLimit - areaPtr->usedSpace + origItemSize - itemSize)) >= 0)
     {
         return LE_OK;
     }
@@ -821,6 +1382,8 @@ static le_result_t Write
     }
 
     char path[SECSTOREADMIN_MAX_PATH_BYTES] = {0};
+    ClientArea_t* areaPtr = NULL;
+    const char* itemNamePtr = NULL;
     le_result_t result;
 
     if(isGlobal)
@@ -832,34 +1395,45 @@ static le_result_t Write
     else
     {
         // Get the client's name and see if it is an app.
-        bool isApp;
-        char clientName[LIMIT_MAX_USER_NAME_BYTES];
+        Client_t* clientPtr = GetClient();
 
-        if (GetClientName(clientName, sizeof(clientName), &isApp) != LE_OK)
+        if (clientPtr == NULL)
         {
             LE_KILL_CLIENT("Could not get the client's name.");
             return LE_FAULT;
         }
 
         // Get the path to the client's secure storage area.
-        GetClientPath(clientName, isApp, path, sizeof(path));
+        GetClientPath(clientPtr->name, clientPtr->isApp, path, sizeof(path));
+        areaPtr = GetClientArea(path);
+
+        // Append item name to client path.
+        LE_FATAL_IF(le_path_Concat("/", path, sizeof(path), name, NULL) != LE_OK,
+                    "Client %s's path for item %s is too long.", clientPtr->name, name);
+
+        itemNamePtr = GetItemName(areaPtr, path);
 
         // Check the available limit for the client.
-        result = CheckClientLimit(clientName, path, name, bufNumElements);
+        result = CheckClientLimit(clientPtr, areaPtr, itemNamePtr, bufNumElements);
 
         if (result != LE_OK)
         {
             return result;
         }
-
-        // Append item name to client path.
-        LE_FATAL_IF(le_path_Concat("/", path, sizeof(path), name, NULL) != LE_OK,
-                    "Client %s's path for item %s is too long.", clientName, name);
     }
 
     // Write the item to the secure storage.
     result = pa_secStore_Write(path, bufPtr, bufNumElements);
 
+    if (areaPtr != NULL)
+    {
+        // If the write failed, the item may be partly written.
+        if ((result != LE_OK) || (SetIndexedItem(areaPtr, itemNamePtr, bufNumElements) != LE_OK))
+        {
+            DropAreaIndex(areaPtr);
+        }
+    }
+
     if (result == LE_BAD_PARAMETER)
     {
         return LE_FAULT;
@@ -971,21 +1545,20 @@ static le_result_t Read
     else
     {
         // Get the client's name and see if it is an app.
-        bool isApp;
-        char clientName[LIMIT_MAX_USER_NAME_BYTES];
+        Client_t* clientPtr = GetClient();
 
-        if (GetClientName(clientName, sizeof(clientName), &isApp) != LE_OK)
+        if (clientPtr == NULL)
         {
             LE_KILL_CLIENT("Could not get the client's name.");
             return LE_FAULT;
         }
 
         // Get the path to the client's secure storage area.
-        GetClientPath(clientName, isApp, path, sizeof(path));
+        GetClientPath(clientPtr->name, clientPtr->isApp, path, sizeof(path));
 
         // Append item name to client path.
         LE_FATAL_IF(le_path_Concat("/", path, sizeof(path), name, NULL) != LE_OK,
-                    "Client %s's path for item %s is too long.", clientName, name);
+                    "Client %s's path for item %s is too long.", clientPtr->name, name);
     }
 
     // Read the item from the secure storage.
@@ -1083,6 +1656,7 @@ le_result_t Delete
     }
 
     char path[SECSTOREADMIN_MAX_PATH_BYTES] = {0};
+    ClientArea_t* areaPtr = NULL;
 
     if(isGlobal)
     {
@@ -1093,25 +1667,42 @@ le_result_t Delete
     else
     {
         // Get the client's name and see if it is an app.
-        bool isApp;
-        char clientName[LIMIT_MAX_USER_NAME_BYTES];
+        Client_t* clientPtr = GetClient();
 
-        if (GetClientName(clientName, sizeof(clientName), &isApp) != LE_OK)
+        if (clientPtr == NULL)
         {
             LE_KILL_CLIENT("Could not get the client's name.");
             return LE_FAULT;
         }
 
         // Get the path to the client's secure storage area.
-        GetClientPath(clientName, isApp, path, sizeof(path));
+        GetClientPath(clientPtr->name, clientPtr->isApp, path, sizeof(path));
+        areaPtr = GetClientArea(path);
 
         // Append item name to client path.
         LE_FATAL_IF(le_path_Concat("/", path, sizeof(path), name, NULL) != LE_OK,
-                    "Client %s's path for item %s is too long.", clientName, name);
+                    "Client %s's path for item %s is too long.", clientPtr->name, name);
     }
 
     // Delete the item from the secure storage.
-    return pa_secStore_Delete(path);
+    le_result_t result = pa_secStore_Delete(path);
+
+    if ((areaPtr != NULL) && areaPtr->isIndexed && (result != LE_NOT_FOUND))
+    {
+        IndexedItem_t* itemPtr = FindIndexedItem(areaPtr, GetItemName(areaPtr, path));
+
+        // A directory was deleted, with the items under it, or the delete failed part way.
+        if ((result == LE_OK) && (itemPtr != NULL))
+        {
+            RemoveIndexedItem(itemPtr);
+        }
+        else
+        {
+            DropAreaIndex(areaPtr);
+        }
+    }
+
+    return result;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1578,6 +2169,9 @@ le_result_t secStoreAdmin_Write
         return LE_FAULT;
     }
 
+    // The item may be in a client area.
+    DropAreaIndexes(path);
+
     // Write the item to the secure storage.
     return pa_secStore_Write(path, bufPtr, bufNumElements);
 
@@ -1658,6 +2252,8 @@ le_result_t secStoreAdmin_CopyMetaTo
 )
 {
 #if (SECSTOREADMIN == 1)
+    DropAreaIndexes(path);
+
     return pa_secStore_CopyMetaTo(path);
 #else
     return LE_UNSUPPORTED;
@@ -1695,6 +2291,9 @@ le_result_t secStoreAdmin_Delete
         return LE_FAULT;
     }
 
+    // The path may be or contain client areas.
+    DropAreaIndexes(path);
+
     // Delete the item from the secure storage.
     return pa_secStore_Delete(path);
 #else
@@ -1808,10 +2407,25 @@ COMPONENT_INIT
 
     SystemIndexPool = le_mem_CreatePool("SystemIndexPool", sizeof(SystemsIndex_t));
 
+    ClientPool = le_mem_CreatePool("ClientPool", sizeof(Client_t));
+    ClientMap = le_hashmap_Create("ClientMap", CLIENT_MAP_SIZE, HashSession, EqualsSession);
+
+    ClientAreaPool = le_mem_CreatePool("ClientAreaPool", sizeof(ClientArea_t));
+    ClientAreaMap = le_hashmap_Create("ClientAreaMap",
+                                      CLIENT_MAP_SIZE,
+                                      le_hashmap_HashString,
+                                      le_hashmap_EqualsString);
+
+    IndexedItemPool = le_mem_CreatePool("IndexedItemPool", sizeof(IndexedItem_t));
+    ItemIndex = le_hashmap_Create("ItemIndex", ITEM_INDEX_SIZE, HashItem, EqualsItem);
+
     // Register a handler that will clean up client specific data when clients disconnect.
     le_msg_AddServiceCloseHandler(secStoreAdmin_GetServiceRef(),
                                   CleanupClientIterators,
                                   NULL);
+    le_msg_AddServiceCloseHandler(le_secStore_GetServiceRef(),
+                                  RemoveClient,
+                                  NULL);
 
     // Try to kick a couple of times before each timeout.
     le_clk_Time_t watchdogInterval = { .sec = MS_WDOG_INTERVAL };
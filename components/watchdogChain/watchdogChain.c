@@ -12,6 +12,8 @@
 #include "legato.h"
 #include "interfaces.h"
 #include "watchdogChain.h"
+#include "wdogHeartbeat.h"
+#include <sys/mman.h>
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -96,6 +98,15 @@ WatchdogObj_t;
 //--------------------------------------------------------------------------------------------------
 static WatchdogObj_t* WatchdogList[MAX_WATCHDOGS];
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Shared memory heartbeat the process watchdog is kicked through, or NULL to kick it with IPC
+ * messages.  Once mapped, the heartbeat stays mapped for the life of the process, as it can be
+ * kicked from any thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static wdogHeartbeat_t* HeartbeatPtr = NULL;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Timer to queue function to kick watchdog chain. If our queued function is called, it implies
@@ -150,7 +161,15 @@ void CheckChain
             TRACE("Watchdog chain is all kicked, kick watchdog.");
         }
 
-        le_wdog_Kick();
+        wdogHeartbeat_t* heartbeatPtr = __atomic_load_n(&HeartbeatPtr, __ATOMIC_ACQUIRE);
+        if (heartbeatPtr != NULL)
+        {
+            wdogHeartbeat_Kick(heartbeatPtr);
+        }
+        else
+        {
+            le_wdog_Kick();
+        }
         __sync_and_and_fetch(&WatchdogChain, ((uint64_t)-(INT64_C(1) << MAX_WATCHDOGS)));
     }
 }
@@ -335,6 +354,61 @@ void le_wdogChain_Stop
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Kick the process watchdog through a shared memory heartbeat rather than with an IPC message each
+ * time the chain is all kicked.
+ *
+ * @return
+ *      - LE_OK            The heartbeat is used
+ *      - LE_FAULT         The heartbeat can't be used; the watchdog is still kicked with IPC
+ *                         messages
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_wdogChain_UseHeartbeat
+(
+    void
+)
+{
+    wdogHeartbeat_t* heartbeatPtr;
+    int fd;
+
+    // The heartbeat lives as long as the session it is obtained on, so this connection is never
+    // disconnected: the session stays open even when the watchdogs are stopped.
+    if (LE_OK != le_wdog_TryConnectService())
+    {
+        LE_WARN("Failed to connect to watchdog service; heartbeat not used");
+        return LE_FAULT;
+    }
+
+    if (LE_OK != le_wdog_GetHeartbeat(&fd))
+    {
+        LE_WARN("Watchdog heartbeat not available");
+        return LE_FAULT;
+    }
+
+    heartbeatPtr = mmap(NULL, sizeof(wdogHeartbeat_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == heartbeatPtr)
+    {
+        LE_ERROR("Failed to map watchdog heartbeat (%m)");
+        return LE_FAULT;
+    }
+
+    if ((heartbeatPtr->magic != WDOG_HEARTBEAT_MAGIC) ||
+        (heartbeatPtr->version != WDOG_HEARTBEAT_VERSION))
+    {
+        LE_ERROR("Bad watchdog heartbeat (magic 0x%08" PRIx32 ", version %" PRIu32 ")",
+                 heartbeatPtr->magic, heartbeatPtr->version);
+        munmap(heartbeatPtr, sizeof(wdogHeartbeat_t));
+        return LE_FAULT;
+    }
+
+    LE_INFO("Kicking watchdog through heartbeat");
+    __atomic_store_n(&HeartbeatPtr, heartbeatPtr, __ATOMIC_RELEASE);
+    return LE_OK;
+}
+
 COMPONENT_INIT
 {
     // Get a reference to the trace keyword that is used to control tracing in this module.
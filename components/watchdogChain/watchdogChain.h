@@ -57,4 +57,21 @@ LE_SHARED void le_wdogChain_Stop
     uint32_t watchdog
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Kick the process watchdog through a shared memory heartbeat rather than with an IPC message each
+ * time the chain is all kicked.  Call it once, after le_wdogChain_Init().  The connection to the
+ * watchdog service it opens on the current thread is kept for the life of the process.
+ *
+ * @return
+ *      - LE_OK            The heartbeat is used
+ *      - LE_FAULT         The heartbeat can't be used; the watchdog is still kicked with IPC
+ *                         messages
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t le_wdogChain_UseHeartbeat
+(
+    void
+);
+
 #endif /* LEGATO_WATCHDOG_CHAIN_INCLUDE_GUARD */
@@ -0,0 +1,101 @@
+//--------------------------------------------------------------------------------------------------
+/** @file wdogHeartbeat.h
+ *
+ * Layout of the shared memory heartbeat a process can kick its watchdog through, and function to
+ * kick it.
+ *
+ * The watchdog daemon creates one heartbeat per process, on the first call to
+ * le_wdog_GetHeartbeat().  The process kicks its watchdog by writing the time to the heartbeat
+ * and incrementing its kick count, with no IPC message.  The watchdog daemon checks all the
+ * heartbeats in one periodic sweep, and again before a watchdog expires, and handles each new kick
+ * as le_wdog_Kick() does: the watchdog expires after its configured timeout from the time of the
+ * kick.  le_wdog_Timeout() is still done through IPC.
+ *
+ * The heartbeat stays valid as long as the IPC session it was obtained on is open.
+ *
+ * @code
+ *     int fd;
+ *
+ *     if (LE_OK == le_wdog_GetHeartbeat(&fd))
+ *     {
+ *         wdogHeartbeat_t* heartbeatPtr = mmap(NULL, sizeof(wdogHeartbeat_t),
+ *                                              PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+ *         close(fd);
+ *         ...
+ *         wdogHeartbeat_Kick(heartbeatPtr);
+ *     }
+ * @endcode
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_WDOG_HEARTBEAT_INCLUDE_GUARD
+#define LEGATO_WDOG_HEARTBEAT_INCLUDE_GUARD
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Magic number at the start of the heartbeat ("WDHB").
+ */
+//--------------------------------------------------------------------------------------------------
+#define WDOG_HEARTBEAT_MAGIC        0x42484457
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Version of the heartbeat layout.  Changed whenever the layout changes.
+ */
+//--------------------------------------------------------------------------------------------------
+#define WDOG_HEARTBEAT_VERSION      1
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Shared memory heartbeat.  Written by the daemon (magic and version) and by the process (kick
+ * time and count).
+ *
+ * Only 32-bit fields are used, so that they can be accessed atomically on all platforms.  The kick
+ * time wraps around every 49 days, so only differences between times are meaningful.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t magic;                         ///< WDOG_HEARTBEAT_MAGIC.
+    uint32_t version;                       ///< WDOG_HEARTBEAT_VERSION.
+    uint32_t kickCount;                     ///< Incremented after each kick.
+    uint32_t kickTimeMs;                    ///< Time of the last kick, in milliseconds of the
+                                            ///  monotonic clock.
+}
+wdogHeartbeat_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the time of the heartbeats: milliseconds of the monotonic clock, wrapping around.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint32_t wdogHeartbeat_GetTimeMs
+(
+    void
+)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint32_t)((time.tv_sec * 1000) + (time.tv_nsec / 1000000));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Kick the watchdog through its heartbeat.  May be called from any thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void wdogHeartbeat_Kick
+(
+    wdogHeartbeat_t* heartbeatPtr       ///< [IN] Mapped heartbeat.
+)
+{
+    __atomic_store_n(&heartbeatPtr->kickTimeMs, wdogHeartbeat_GetTimeMs(), __ATOMIC_RELAXED);
+
+    // The daemon reads the count first, so a kick is seen with its time or a later one.
+    __atomic_add_fetch(&heartbeatPtr->kickCount, 1, __ATOMIC_RELEASE);
+}
+
+#endif // LEGATO_WDOG_HEARTBEAT_INCLUDE_GUARD
@@ -15,8 +15,10 @@
 #include "fileDescriptor.h"
 #include "sysPaths.h"
 #include "ima.h"
-#include "file.h"
+#include <openssl/evp.h>
+#include <openssl/rsa.h>
 #include <openssl/x509.h>
+#include <sys/xattr.h>
 
 
 //--------------------------------------------------------------------------------------------------
@@ -46,14 +48,66 @@
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Verify a file IMA signature against provided public certificate path
+ * Extended attribute holding the IMA signature of a file, and its maximum size.
+ */
+//--------------------------------------------------------------------------------------------------
+#define IMA_XATTR_NAME        "security.ima"
+#define IMA_XATTR_MAX_BYTES   1024
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Type of IMA extended attribute holding a digital signature, and version of the signatures
+ * verified in-process. A signature of version 2 starts with a 9 bytes header.
+ */
+//--------------------------------------------------------------------------------------------------
+#define IMA_XATTR_DIGSIG        0x03
+#define IMA_DIGSIG_VERSION_2    2
+#define IMA_SIG_V2_HDR_BYTES    9
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash algorithms of the IMA signatures, as defined by the kernel.
+ */
+//--------------------------------------------------------------------------------------------------
+#define IMA_HASH_ALGO_MD5           1
+#define IMA_HASH_ALGO_SHA1          2
+#define IMA_HASH_ALGO_RIPE_MD_160   3
+#define IMA_HASH_ALGO_SHA256        4
+#define IMA_HASH_ALGO_SHA384        5
+#define IMA_HASH_ALGO_SHA512        6
+#define IMA_HASH_ALGO_SHA224        7
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the buffer used to read the files to hash.
+ */
+//--------------------------------------------------------------------------------------------------
+#define READ_BUFFER_BYTES     (32 * 1024)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of threads verifying the files of a directory, and number of files which can be
+ * waiting for them.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_VERIFY_THREADS    8
+#define VERIFY_QUEUE_SIZE     64
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Verify a file IMA signature against provided public certificate path, with evmctl.
  *
  * @return
  *      - LE_OK on success
  *      - LE_FAULT otherwise
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t VerifyFile
+static le_result_t EvmctlVerifyFile
 (
     const char * filePath,
     const char * certPath
@@ -81,11 +135,359 @@ static le_result_t VerifyFile
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the public key of an IMA public certificate (DER encoded X509 certificate).
+ *
+ * @return
+ *      - Public key, to be freed with EVP_PKEY_free()
+ *      - NULL on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static EVP_PKEY* LoadPublicKey
+(
+    const char * certPath
+)
+{
+    FILE* fp = fopen(certPath, "r");
+    if (NULL == fp)
+    {
+        LE_ERROR("Failed to open certificate '%s': %m", certPath);
+        return NULL;
+    }
+
+    X509* crt = d2i_X509_fp(fp, NULL);
+    fclose(fp);
+    if (NULL == crt)
+    {
+        LE_ERROR("Failed to parse certificate '%s'", certPath);
+        return NULL;
+    }
+
+    EVP_PKEY* keyPtr = X509_get_pubkey(crt);
+    X509_free(crt);
+    if (NULL == keyPtr)
+    {
+        LE_ERROR("Failed to get the public key of certificate '%s'", certPath);
+    }
+
+    return keyPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the digest algorithm of a kernel hash algorithm identifier, as found in IMA signatures.
+ *
+ * @return
+ *      - Digest algorithm
+ *      - NULL if the algorithm is not supported
+ */
+//--------------------------------------------------------------------------------------------------
+static const EVP_MD* GetDigest
+(
+    uint8_t hashAlgo
+)
+{
+    switch (hashAlgo)
+    {
+        case IMA_HASH_ALGO_MD5:
+            return EVP_md5();
+        case IMA_HASH_ALGO_SHA1:
+            return EVP_sha1();
+        case IMA_HASH_ALGO_RIPE_MD_160:
+            return EVP_ripemd160();
+        case IMA_HASH_ALGO_SHA256:
+            return EVP_sha256();
+        case IMA_HASH_ALGO_SHA384:
+            return EVP_sha384();
+        case IMA_HASH_ALGO_SHA512:
+            return EVP_sha512();
+        case IMA_HASH_ALGO_SHA224:
+            return EVP_sha224();
+        default:
+            return NULL;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the digest of the content of a file.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t HashFile
+(
+    const char * filePath,
+    const EVP_MD * mdPtr,
+    unsigned char * digestPtr,
+    unsigned int * digestLenPtr
+)
+{
+    uint8_t buffer[READ_BUFFER_BYTES];
+    le_result_t result = LE_OK;
+    ssize_t readBytes;
+
+    int fd = open(filePath, O_RDONLY | O_CLOEXEC);
+    if (-1 == fd)
+    {
+        LE_ERROR("Failed to open file '%s': %m", filePath);
+        return LE_FAULT;
+    }
+
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    EVP_MD_CTX* ctxPtr = EVP_MD_CTX_create();
+    if ((NULL == ctxPtr) || (1 != EVP_DigestInit_ex(ctxPtr, mdPtr, NULL)))
+    {
+        LE_ERROR("Failed to initialize digest of file '%s'", filePath);
+        result = LE_FAULT;
+        goto cleanup;
+    }
+
+    while (0 != (readBytes = read(fd, buffer, sizeof(buffer))))
+    {
+        if (-1 == readBytes)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            LE_ERROR("Failed to read file '%s': %m", filePath);
+            result = LE_FAULT;
+            goto cleanup;
+        }
+
+        if (1 != EVP_DigestUpdate(ctxPtr, buffer, readBytes))
+        {
+            result = LE_FAULT;
+            goto cleanup;
+        }
+    }
+
+    if (1 != EVP_DigestFinal_ex(ctxPtr, digestPtr, digestLenPtr))
+    {
+        result = LE_FAULT;
+    }
+
+cleanup:
+    if (ctxPtr)
+    {
+        EVP_MD_CTX_destroy(ctxPtr);
+    }
+    fd_Close(fd);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Verify a file IMA signature against a public key, without spawning any process.
+ *
+ * The security.ima extended attribute of the file must hold a digital signature of version 2,
+ * which is what evmctl produces by default: the digest of the file content is computed and the
+ * RSA signature checked against it.  Any other kind of IMA signature is verified with evmctl.
+ *
+ * As with "evmctl ima_verify -k", the key identifier of the signature is not checked: the
+ * signature must only be valid for the given key.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t VerifyFile
+(
+    const char * filePath,
+    EVP_PKEY * keyPtr,
+    const char * certPath
+)
+{
+    uint8_t xattr[IMA_XATTR_MAX_BYTES];
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int digestLen;
+
+    ssize_t xattrLen = getxattr(filePath, IMA_XATTR_NAME, xattr, sizeof(xattr));
+    if (-1 == xattrLen)
+    {
+        LE_ERROR("Failed to read IMA signature of file '%s': %m", filePath);
+        return LE_FAULT;
+    }
+
+    if ((xattrLen <= IMA_SIG_V2_HDR_BYTES) ||
+        (IMA_XATTR_DIGSIG != xattr[0]) ||
+        (IMA_DIGSIG_VERSION_2 != xattr[1]))
+    {
+        LE_DEBUG("IMA signature of file '%s' is not of version 2", filePath);
+        return EvmctlVerifyFile(filePath, certPath);
+    }
+
+    // Header: type, version, hash algorithm, key identifier (4 bytes) and signature size (2 bytes
+    // big endian), followed by the signature.
+    const EVP_MD* mdPtr = GetDigest(xattr[2]);
+    size_t sigLen = (xattr[7] << 8) | xattr[8];
+
+    if ((NULL == mdPtr) || (sigLen != (size_t)(xattrLen - IMA_SIG_V2_HDR_BYTES)))
+    {
+        LE_ERROR("Bad IMA signature of file '%s' (algorithm %u, size %zu)",
+                 filePath, xattr[2], sigLen);
+        return LE_FAULT;
+    }
+
+    if (LE_OK != HashFile(filePath, mdPtr, digest, &digestLen))
+    {
+        return LE_FAULT;
+    }
+
+    le_result_t result = LE_FAULT;
+    EVP_PKEY_CTX* ctxPtr = EVP_PKEY_CTX_new(keyPtr, NULL);
+
+    if ((NULL != ctxPtr) &&
+        (1 == EVP_PKEY_verify_init(ctxPtr)) &&
+        (1 == EVP_PKEY_CTX_set_rsa_padding(ctxPtr, RSA_PKCS1_PADDING)) &&
+        (1 == EVP_PKEY_CTX_set_signature_md(ctxPtr, mdPtr)) &&
+        (1 == EVP_PKEY_verify(ctxPtr, &xattr[IMA_SIG_V2_HDR_BYTES], sigLen, digest, digestLen)))
+    {
+        LE_DEBUG("Verified file: '%s' successfully", filePath);
+        result = LE_OK;
+    }
+    else
+    {
+        LE_ERROR("Failed to verify file '%s' with certificate '%s'", filePath, certPath);
+    }
+
+    EVP_PKEY_CTX_free(ctxPtr);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Verification of the files of a directory, shared by the traversal and the worker threads.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    EVP_PKEY*       keyPtr;     ///< Public key of the certificate.
+    const char*     certPath;   ///< Path of the certificate.
+    le_mutex_Ref_t  mutex;      ///< Protects the job queue and the result.
+    le_sem_Ref_t    jobSem;     ///< Counts the queued jobs, and the end of the traversal.
+    le_sem_Ref_t    slotSem;    ///< Counts the jobs which can still be queued.
+    le_sls_List_t   jobQueue;   ///< Files to verify.
+    le_result_t     result;     ///< LE_FAULT once a file failed to be verified.
+}
+DirVerifier_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * File to verify, queued to the worker threads.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char            path[LIMIT_MAX_PATH_BYTES];     ///< Path of the file.
+    le_sls_Link_t   link;                           ///< Link in the job queue.
+}
+VerifyJob_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of the files to verify.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t VerifyJobPool = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Worker thread verifying the queued files until the end of the traversal.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* VerifyWorker
+(
+    void* contextPtr
+)
+{
+    DirVerifier_t* verifierPtr = contextPtr;
+
+    for (;;)
+    {
+        le_sem_Wait(verifierPtr->jobSem);
+
+        le_mutex_Lock(verifierPtr->mutex);
+        le_sls_Link_t* linkPtr = le_sls_Pop(&verifierPtr->jobQueue);
+        bool failed = (LE_OK != verifierPtr->result);
+        le_mutex_Unlock(verifierPtr->mutex);
+
+        if (NULL == linkPtr)
+        {
+            // All the files were queued and verified.
+            return NULL;
+        }
+
+        VerifyJob_t* jobPtr = CONTAINER_OF(linkPtr, VerifyJob_t, link);
+
+        if ((!failed) &&
+            (LE_OK != VerifyFile(jobPtr->path, verifierPtr->keyPtr, verifierPtr->certPath)))
+        {
+            LE_CRIT("Failed to verify file '%s' with public certificate '%s'",
+                    jobPtr->path,
+                    verifierPtr->certPath);
+
+            le_mutex_Lock(verifierPtr->mutex);
+            verifierPtr->result = LE_FAULT;
+            le_mutex_Unlock(verifierPtr->mutex);
+        }
+
+        le_mem_Release(jobPtr);
+        le_sem_Post(verifierPtr->slotSem);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of worker threads verifying the files of a directory.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t GetWorkerCount
+(
+    void
+)
+{
+    long numCpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (numCpus < 1)
+    {
+        return 1;
+    }
+
+    // The files are read as well as hashed, so use a couple of threads per CPU.
+    if ((size_t)numCpus > (MAX_VERIFY_THREADS / 2))
+    {
+        return MAX_VERIFY_THREADS;
+    }
+
+    return 2 * (size_t)numCpus;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Recursively traverse the directory and verify each file IMA signature against provided public
  * certificate path
  *
+ * The certificate is read once, and the files are verified by a pool of worker threads while the
+ * directory is traversed.
+ *
  * @return
  *      - LE_OK on success
  *      - LE_FAULT otherwise
@@ -97,12 +499,17 @@ static le_result_t VerifyDir
     const char * certPath
 )
 {
+    le_thread_Ref_t workers[MAX_VERIFY_THREADS];
+    size_t workerCount = GetWorkerCount();
+    size_t i;
+
     char* pathArrayPtr[] = {(char *)dirPath,
                                     NULL};
 
-    // Open the directory tree to traverse.
+    // Open the directory tree to traverse. The worker threads share the current directory, so
+    // the traversal must not change it.
     FTS* ftsPtr = fts_open(pathArrayPtr,
-                           FTS_PHYSICAL,
+                           FTS_PHYSICAL | FTS_NOCHDIR,
                            NULL);
 
     if (NULL == ftsPtr)
@@ -111,7 +518,38 @@ static le_result_t VerifyDir
         return LE_FAULT;
     }
 
-    // Traverse through the directory tree.
+    EVP_PKEY* keyPtr = LoadPublicKey(certPath);
+    if (NULL == keyPtr)
+    {
+        fts_close(ftsPtr);
+        return LE_FAULT;
+    }
+
+    if (NULL == VerifyJobPool)
+    {
+        VerifyJobPool = le_mem_CreatePool("ImaVerifyJob", sizeof(VerifyJob_t));
+        le_mem_ExpandPool(VerifyJobPool, VERIFY_QUEUE_SIZE);
+    }
+
+    DirVerifier_t verifier =
+    {
+        .keyPtr = keyPtr,
+        .certPath = certPath,
+        .mutex = le_mutex_CreateNonRecursive("ImaVerify"),
+        .jobSem = le_sem_Create("ImaVerifyJobs", 0),
+        .slotSem = le_sem_Create("ImaVerifySlots", VERIFY_QUEUE_SIZE),
+        .jobQueue = LE_SLS_LIST_INIT,
+        .result = LE_OK,
+    };
+
+    for (i = 0; i < workerCount; i++)
+    {
+        workers[i] = le_thread_Create("ImaVerify", VerifyWorker, &verifier);
+        le_thread_SetJoinable(workers[i]);
+        le_thread_Start(workers[i]);
+    }
+
+    // Traverse through the directory tree, queueing the files to the worker threads.
     FTSENT* entPtr;
     while (NULL != (entPtr = fts_read(ftsPtr)))
     {
@@ -120,32 +558,66 @@ static le_result_t VerifyDir
                                 entPtr->fts_path,
                                 entPtr->fts_info);
 
-        switch (entPtr->fts_info)
+        // Only the certificate at the top of the tree is not verified here: a file of the same
+        // name further down is just another file of the tree.
+        if (   (FTS_F != entPtr->fts_info)
+            || ((FTS_ROOTLEVEL + 1 == entPtr->fts_level)
+                && (0 == strcmp(entPtr->fts_name, PUB_CERT_NAME))))
         {
-            case FTS_SL:
-            case FTS_SLNONE:
-                break;
-
-            case FTS_F:
-                if (0 != strcmp(entPtr->fts_name, PUB_CERT_NAME ))
-                {
-                    if (LE_OK != VerifyFile(entPtr->fts_accpath, certPath))
-                    {
-                        LE_CRIT("Failed to verify file '%s' with public certificate '%s'",
-                                entPtr->fts_accpath,
-                                certPath);
-                        fts_close(ftsPtr);
-                        return LE_FAULT;
-                    }
-                }
-                break;
+            continue;
+        }
+
+        le_sem_Wait(verifier.slotSem);
+
+        le_mutex_Lock(verifier.mutex);
+        bool failed = (LE_OK != verifier.result);
+        le_mutex_Unlock(verifier.mutex);
+
+        if (failed)
+        {
+            // Do not verify the other files.
+            le_sem_Post(verifier.slotSem);
+            break;
         }
 
+        VerifyJob_t* jobPtr = le_mem_ForceAlloc(VerifyJobPool);
+        if (LE_OK != le_utf8_Copy(jobPtr->path, entPtr->fts_accpath, sizeof(jobPtr->path), NULL))
+        {
+            LE_CRIT("File path '%s' is too long", entPtr->fts_accpath);
+            le_mem_Release(jobPtr);
+            le_sem_Post(verifier.slotSem);
+
+            le_mutex_Lock(verifier.mutex);
+            verifier.result = LE_FAULT;
+            le_mutex_Unlock(verifier.mutex);
+            break;
+        }
+        jobPtr->link = LE_SLS_LINK_INIT;
+
+        le_mutex_Lock(verifier.mutex);
+        le_sls_Queue(&verifier.jobQueue, &jobPtr->link);
+        le_mutex_Unlock(verifier.mutex);
+        le_sem_Post(verifier.jobSem);
     }
 
     fts_close(ftsPtr);
 
-    return LE_OK;
+    // Each worker thread exits once the job queue is empty.
+    for (i = 0; i < workerCount; i++)
+    {
+        le_sem_Post(verifier.jobSem);
+    }
+    for (i = 0; i < workerCount; i++)
+    {
+        le_thread_Join(workers[i], NULL);
+    }
+
+    le_sem_Delete(verifier.slotSem);
+    le_sem_Delete(verifier.jobSem);
+    le_mutex_Delete(verifier.mutex);
+    EVP_PKEY_free(keyPtr);
+
+    return verifier.result;
 }
 
 
@@ -213,7 +685,16 @@ le_result_t ima_VerifyFile
     const char * certPath
 )
 {
-    return VerifyFile(filePath, certPath);
+    EVP_PKEY* keyPtr = LoadPublicKey(certPath);
+    if (NULL == keyPtr)
+    {
+        return LE_FAULT;
+    }
+
+    le_result_t result = VerifyFile(filePath, keyPtr, certPath);
+    EVP_PKEY_free(keyPtr);
+
+    return result;
 }
 
 
@@ -59,6 +59,14 @@
  * running process that belongs to an IPC session reference when the IPC system reports that
  * a session closed.  This is how the Log Control Daemon finds out that a client process died.
  *
+ * The Log Control Daemon also owns the log ring (see logRing.h), a memory-mapped circular store of
+ * structured log records.  The file descriptor of the ring is passed to the clients running as
+ * root in the response to their registration, so that they can append their log messages to the
+ * ring directly, and to the log control tool on request, so that it can query them.  Any process
+ * mapping the ring can read and write all of its records, so it is not given to the other clients,
+ * i.e. to sandboxed apps: their messages only go to syslog.  The size of the ring can be set with
+ * the LE_LOG_RING_SIZE environment variable, in bytes.
+ *
  * Copyright (C) Sierra Wireless Inc.
  */
 
@@ -67,6 +75,7 @@
 #include "logDaemon.h"
 #include "limit.h"
 #include "fileDescriptor.h"
+#include "logRing.h"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -335,6 +344,22 @@ static le_mem_PoolRef_t FdLogPoolRef;
 #define MAX_MSG_SIZE            256
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default size of the log ring, in bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_LOG_RING_SIZE   (1024 * 1024)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * File descriptor of the log ring, or -1 if it could not be created.
+ */
+//--------------------------------------------------------------------------------------------------
+static int LogRingFd = -1;
+
+
 
 // ========================================
 //  FUNCTIONS
@@ -951,8 +976,8 @@ static bool ParseCmdPacket
     }
     packetPtr++;
 
-    // The "list" command has no parameters.
-    if (commandCode == LOG_CMD_LIST_COMPONENTS)
+    // The "list" and "get ring" commands have no parameters.
+    if ((commandCode == LOG_CMD_LIST_COMPONENTS) || (commandCode == LOG_CMD_GET_RING))
     {
         return true;
     }
@@ -2458,6 +2483,88 @@ static void ForgetProcess
 
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Responds to a request with the file descriptor of the log ring, if there is one and the client
+ * runs as root.  Other clients, such as sandboxed apps, only get the response.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void SendLogRing
+(
+    le_msg_MessageRef_t msgRef      ///< [IN] Request to respond to.
+)
+{
+    uid_t clientUid;
+
+    if (le_msg_GetClientUserId(le_msg_GetSession(msgRef), &clientUid) != LE_OK)
+    {
+        clientUid = (uid_t)-1;
+    }
+
+    if ((LogRingFd >= 0) && (clientUid == 0))
+    {
+        // The messaging system closes the fd once sent, so send a copy.
+        int fd = dup(LogRingFd);
+
+        if (fd >= 0)
+        {
+            le_msg_SetFd(msgRef, fd);
+        }
+        else
+        {
+            LE_ERROR("Failed to duplicate the log ring fd.  %m.");
+        }
+    }
+
+    le_msg_Respond(msgRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates the log ring, and starts appending the messages of this daemon to it.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void CreateLogRing
+(
+    void
+)
+{
+    size_t size = DEFAULT_LOG_RING_SIZE;
+    const char* envStrPtr = getenv("LE_LOG_RING_SIZE");
+
+    if (envStrPtr != NULL)
+    {
+        char* endPtr;
+        unsigned long value = strtoul(envStrPtr, &endPtr, 0);
+
+        if ((endPtr != envStrPtr) && (*endPtr == '\0'))
+        {
+            size = value;
+        }
+        else
+        {
+            LE_ERROR("LE_LOG_RING_SIZE environment variable has invalid value '%s'.", envStrPtr);
+        }
+    }
+
+    LogRingFd = logRing_Create(size);
+
+    if (LogRingFd < 0)
+    {
+        LE_ERROR("Failed to create the log ring.  Log messages will only go to syslog.");
+        return;
+    }
+
+    int fd = dup(LogRingFd);
+
+    if (fd >= 0)
+    {
+        log_UseRing(fd);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Process a message received from a connected log session client.
@@ -2487,7 +2594,7 @@ static void ClientMsgReceiveHandler
             case LOG_CMD_REG_COMPONENT:
 
                 RegComponent(processName, componentName, commandDataPtr, ipcSessionRef);
-                le_msg_Respond(msgRef);
+                SendLogRing(msgRef);
 
                 return;
 
@@ -2496,6 +2603,7 @@ static void ClientMsgReceiveHandler
             case LOG_CMD_DISABLE_TRACE:
             case LOG_CMD_LIST_COMPONENTS:
             case LOG_CMD_FORGET_PROCESS:
+            case LOG_CMD_GET_RING:
 
                 LE_ERROR("Client attempted to issue a log control command (%c)!", command);
 
@@ -2583,6 +2691,14 @@ static void ControlToolMsgReceiveHandler
 
                 break;
 
+            case LOG_CMD_GET_RING:
+
+                // The response takes over the message.
+                SendLogRing(msgRef);
+                le_msg_CloseSession(ipcSessionRef);
+
+                return;
+
             default:
 
                 LE_ERROR("Unknown command byte '%c' received from log control tool.", command);
@@ -2641,7 +2757,8 @@ static void LogFdMessages
 
         do
         {
-            c = read(fd, msg, sizeof(msg));
+            // Leave room for the null terminator.
+            c = read(fd, msg, sizeof(msg) - 1);
         }
         while ( (c == -1) && (errno == EINTR) );
 
@@ -2826,6 +2943,9 @@ COMPONENT_INIT
                                           ProcessIdHash,
                                           ProcessIdEquals);
 
+    // Create the log ring before any client can register.
+    CreateLogRing();
+
     // Get a reference to the Log Control Protocol identification.
     le_msg_ProtocolRef_t protocolRef = le_msg_GetProtocolRef(LOG_CONTROL_PROTOCOL_ID,
                                                              LOG_MAX_CMD_PACKET_BYTES);
@@ -103,6 +103,8 @@
 //--------------------------------------------------------------------------------------------------
 #define LOG_CMD_LIST_COMPONENTS         'c' // No ProcessName, ComponentName, or CommandData
 #define LOG_CMD_FORGET_PROCESS          'x' // No ComponentName or CommandData
+#define LOG_CMD_GET_RING                'g' // No ProcessName, ComponentName, or CommandData.
+                                            // The response carries the fd of the log ring.
 
 
 // =======================================================
@@ -45,6 +45,18 @@ typedef enum
     LE_SDTP_MSGID_BIND,             ///< Create one binding.  The payload is the binding details.
                                     ///  If the Service Directory runs into an error, it will
                                     ///  drop the connection to the sdir tool without responding.
+
+    LE_SDTP_MSGID_UNBIND,           ///< Delete the binding of a client interface, if any.  The
+                                    ///  payload is the client's user ID and interface name.
+
+    LE_SDTP_MSGID_APP_BIND_START,   ///< Start to update the bindings of one app.  The payload is
+                                    ///  the app name.  The bindings created from this app's
+                                    ///  configuration and not bound again before
+                                    ///  LE_SDTP_MSGID_APP_BIND_END are deleted then; the others
+                                    ///  are left untouched.
+
+    LE_SDTP_MSGID_APP_BIND_END,     ///< End the update of the bindings of one app.  The payload is
+                                    ///  the app name.
 }
 le_sdtp_MsgType_t;
 
@@ -61,6 +73,8 @@ typedef struct
     uid_t server;               ///< Unix user ID of the server.
     char clientInterfaceName[LIMIT_MAX_IPC_INTERFACE_NAME_BYTES]; ///< Client's interface name.
     char serverInterfaceName[LIMIT_MAX_IPC_INTERFACE_NAME_BYTES]; ///< Server's interface name.
+    char appName[LIMIT_MAX_APP_NAME_BYTES]; ///< App whose configuration the binding comes from
+                                            ///  (empty if none).
 }
 le_sdtp_Msg_t;
 
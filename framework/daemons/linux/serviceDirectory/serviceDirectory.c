@@ -290,6 +290,9 @@ typedef struct
     char                serverInterfaceName[LIMIT_MAX_IPC_INTERFACE_NAME_BYTES];///< Service name
     ServerConnection_t* serverConnectionPtr;///< Ptr to Server Connection (NULL if service unavail.)
     le_dls_List_t       waitingClientsList; ///< List of Client Connections waiting for the service.
+    char                appName[LIMIT_MAX_APP_NAME_BYTES]; ///< App whose config created it, or "".
+    bool                isStale;            ///< true = not bound again since its app's update
+                                            ///  started (see LE_SDTP_MSGID_APP_BIND_START).
 }
 Binding_t;
 
@@ -408,13 +411,12 @@ static User_t* CreateUser
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Searches the User List for a particular Unix user ID.  If found, increments the reference count
- * on that object.  If not found, creates a new User object.
+ * Searches the User List for a particular Unix user ID.
  *
- * @return Pointer to the User object.
+ * @return Pointer to the User object or NULL if not found.
  **/
 //--------------------------------------------------------------------------------------------------
-static User_t* GetUser
+static User_t* FindUser
 (
     uid_t uid   ///< [in] The user ID.
 )
@@ -428,13 +430,38 @@ static User_t* GetUser
 
         if (userPtr->uid == uid)
         {
-            le_mem_AddRef(userPtr);
             return userPtr;
         }
 
         linkPtr = le_dls_PeekNext(&UserList, linkPtr);
     }
 
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Searches the User List for a particular Unix user ID.  If found, increments the reference count
+ * on that object.  If not found, creates a new User object.
+ *
+ * @return Pointer to the User object.
+ **/
+//--------------------------------------------------------------------------------------------------
+static User_t* GetUser
+(
+    uid_t uid   ///< [in] The user ID.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    User_t* userPtr = FindUser(uid);
+
+    if (userPtr != NULL)
+    {
+        le_mem_AddRef(userPtr);
+        return userPtr;
+    }
+
     return CreateUser(uid);
 }
 
@@ -836,9 +863,11 @@ static void FollowBinding
 /**
  * Creates a Binding object for a given binding between a client user's interface name and a
  * Service.
+ *
+ * @return Pointer to the Binding object (the existing one if it was already bound the same way).
  **/
 //--------------------------------------------------------------------------------------------------
-static void CreateBinding
+static Binding_t* CreateBinding
 (
     uid_t   clientUserId,               ///< [in] Client's user ID.
     const char* clientInterfaceName,    ///< [in] Client's interface name.
@@ -867,7 +896,7 @@ static void CreateBinding
                     serverInterfaceName);
             le_mem_Release(clientUserPtr);
             le_mem_Release(serverUserPtr);
-            return;
+            return oldBindingPtr;
         }
 
         // Warn if it's not the same.
@@ -916,6 +945,8 @@ static void CreateBinding
 
     bindingPtr->serverConnectionPtr = NULL;
     bindingPtr->waitingClientsList = LE_DLS_LIST_INIT;
+    bindingPtr->appName[0] = '\0';
+    bindingPtr->isStale = false;
 
     // Add the Binding to the client User's Binding List.
     le_dls_Queue(&bindingPtr->clientUserPtr->bindingList, &bindingPtr->link);
@@ -944,6 +975,8 @@ static void CreateBinding
             FollowBinding(bindingPtr, clientConnectionPtr, true /* shouldWait */ );
         }
     }
+
+    return bindingPtr;
 }
 
 
@@ -2472,13 +2505,195 @@ static void SdirToolBind
         {
             LE_KILL_CLIENT("Server interface name not null terminated!");
         }
+        else if (strnlen(msgPtr->appName, LIMIT_MAX_APP_NAME_BYTES) == LIMIT_MAX_APP_NAME_BYTES)
+        {
+            LE_KILL_CLIENT("App name not null terminated!");
+        }
         else
         {
-            CreateBinding(msgPtr->client,
-                          msgPtr->clientInterfaceName,
-                          msgPtr->server,
-                          msgPtr->serverInterfaceName);
+            Binding_t* bindingPtr = CreateBinding(msgPtr->client,
+                                                  msgPtr->clientInterfaceName,
+                                                  msgPtr->server,
+                                                  msgPtr->serverInterfaceName);
+
+            // Remember which app's configuration the binding comes from, so that it can be
+            // updated with that app only.
+            LE_ASSERT(le_utf8_Copy(bindingPtr->appName,
+                                   msgPtr->appName,
+                                   sizeof(bindingPtr->appName),
+                                   NULL) == LE_OK);
+            bindingPtr->isStale = false;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handles an "Unbind" request from the 'sdir' tool.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SdirToolUnbind
+(
+    const le_sdtp_Msg_t* msgPtr   ///< [in] Pointer to the request message payload.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t len = strnlen(msgPtr->clientInterfaceName, LIMIT_MAX_IPC_INTERFACE_NAME_BYTES);
+    if (len == 0)
+    {
+        LE_KILL_CLIENT("Client interface name empty.");
+    }
+    else if (len == LIMIT_MAX_IPC_INTERFACE_NAME_BYTES)
+    {
+        LE_KILL_CLIENT("Client interface name not null terminated!");
+    }
+    else
+    {
+        // Don't create a User object if there is none, as it would have no binding anyway.
+        User_t* userPtr = FindUser(msgPtr->client);
+
+        if (userPtr != NULL)
+        {
+            Binding_t* bindingPtr = FindBinding(userPtr, msgPtr->clientInterfaceName);
+
+            if (bindingPtr != NULL)
+            {
+                // The destructor will remove it from the User's Binding List, etc.
+                le_mem_Release(bindingPtr);
+            }
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks the app name of an "App Bind Start" or "App Bind End" request from the 'sdir' tool.
+ *
+ * @return true if the app name is valid, false if the client was killed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool CheckAppName
+(
+    const le_sdtp_Msg_t* msgPtr   ///< [in] Pointer to the request message payload.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t len = strnlen(msgPtr->appName, LIMIT_MAX_APP_NAME_BYTES);
+    if (len == 0)
+    {
+        LE_KILL_CLIENT("App name empty.");
+        return false;
+    }
+    else if (len == LIMIT_MAX_APP_NAME_BYTES)
+    {
+        LE_KILL_CLIENT("App name not null terminated!");
+        return false;
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handles an "App Bind Start" request from the 'sdir' tool.
+ *
+ * Marks stale all the bindings created from the app's configuration.  The ones that are bound
+ * again before the "App Bind End" request are kept, so that the clients using them are not
+ * disturbed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SdirToolAppBindStart
+(
+    const le_sdtp_Msg_t* msgPtr   ///< [in] Pointer to the request message payload.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (!CheckAppName(msgPtr))
+    {
+        return;
+    }
+
+    le_dls_Link_t* userLinkPtr = le_dls_Peek(&UserList);
+
+    while (userLinkPtr != NULL)
+    {
+        User_t* userPtr = CONTAINER_OF(userLinkPtr, User_t, link);
+
+        le_dls_Link_t* bindingLinkPtr = le_dls_Peek(&userPtr->bindingList);
+
+        while (bindingLinkPtr != NULL)
+        {
+            Binding_t* bindingPtr = CONTAINER_OF(bindingLinkPtr, Binding_t, link);
+
+            if (strcmp(bindingPtr->appName, msgPtr->appName) == 0)
+            {
+                bindingPtr->isStale = true;
+            }
+
+            bindingLinkPtr = le_dls_PeekNext(&userPtr->bindingList, bindingLinkPtr);
         }
+
+        userLinkPtr = le_dls_PeekNext(&UserList, userLinkPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handles an "App Bind End" request from the 'sdir' tool.
+ *
+ * Deletes the bindings created from the app's configuration that were not bound again since the
+ * "App Bind Start" request.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SdirToolAppBindEnd
+(
+    const le_sdtp_Msg_t* msgPtr   ///< [in] Pointer to the request message payload.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (!CheckAppName(msgPtr))
+    {
+        return;
+    }
+
+    le_dls_Link_t* userLinkPtr = le_dls_Peek(&UserList);
+
+    while (userLinkPtr != NULL)
+    {
+        User_t* userPtr = CONTAINER_OF(userLinkPtr, User_t, link);
+
+        // Increment the reference count on the User object to ensure that it doesn't go away
+        // when we delete its bindings.
+        le_mem_AddRef(userPtr);
+
+        le_dls_Link_t* bindingLinkPtr = le_dls_Peek(&userPtr->bindingList);
+
+        while (bindingLinkPtr != NULL)
+        {
+            Binding_t* bindingPtr = CONTAINER_OF(bindingLinkPtr, Binding_t, link);
+
+            bindingLinkPtr = le_dls_PeekNext(&userPtr->bindingList, bindingLinkPtr);
+
+            if (bindingPtr->isStale && (strcmp(bindingPtr->appName, msgPtr->appName) == 0))
+            {
+                LE_DEBUG("Deleting binding of '%s.%s' from app '%s'.",
+                         userPtr->name,
+                         bindingPtr->clientInterfaceName,
+                         bindingPtr->appName);
+
+                // The destructor will remove it from the User's Binding List, etc.
+                le_mem_Release(bindingPtr);
+            }
+        }
+
+        userLinkPtr = le_dls_PeekNext(&UserList, userLinkPtr);
+
+        // It's okay for the User object to go away now.
+        le_mem_Release(userPtr);
     }
 }
 
@@ -2519,6 +2734,21 @@ static void SdirToolRecv
             SdirToolBind(msgPtr);
             break;
 
+        case LE_SDTP_MSGID_UNBIND:
+
+            SdirToolUnbind(msgPtr);
+            break;
+
+        case LE_SDTP_MSGID_APP_BIND_START:
+
+            SdirToolAppBindStart(msgPtr);
+            break;
+
+        case LE_SDTP_MSGID_APP_BIND_END:
+
+            SdirToolAppBindEnd(msgPtr);
+            break;
+
         default:
             LE_KILL_CLIENT("Invalid message ID %d.", msgPtr->msgType);
             break;
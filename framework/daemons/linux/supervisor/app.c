@@ -354,6 +354,7 @@ typedef struct app_Ref
     le_sls_List_t   additionalLinks;    // List of additional links that are temporarily added to
                                         // the app.
     le_sls_List_t   reqModuleName;      // List of required kernel module names
+    void*           contextPtr;         // Context pointer of the owner of the application.
 }
 App_t;
 
@@ -406,6 +407,7 @@ typedef le_result_t (*ProcStopHandler_t)
 typedef struct app_ProcRef
 {
     proc_Ref_t      procRef;        // The process reference.
+    app_Ref_t       appRef;         // The application the process belongs to.
     ProcStopHandler_t stopHandler;  // Handler function that gets called when this process stops.
     le_dls_Link_t   link;           // The link in the application's list of processes.
     app_Proc_StopHandlerFunc_t externStopHandler;   // External stop handler.
@@ -1493,61 +1495,35 @@ static void HardKillApp
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Finds a process container with this pid in the specified list.
+ * Finds a process container for the app by pid.
  *
  * @return
  *      The pointer to a process container if successful.
  *      NULL if the process could not be found.
  */
 //--------------------------------------------------------------------------------------------------
-static ProcContainer_t* FindProcContainerInList
+static ProcContainer_t* FindProcContainer
 (
-    le_dls_List_t list,             ///< [IN] List of process containers.
+    app_Ref_t appRef,               ///< [IN] The application to search in.
     pid_t pid                       ///< [IN] The pid to search for.
 )
 {
-    le_dls_Link_t* procLinkPtr = le_dls_Peek(&list);
+    // Running processes are indexed by pid, and each one knows its container.
+    proc_Ref_t procRef = proc_FindByPid(pid);
 
-    while (procLinkPtr != NULL)
+    if (procRef == NULL)
     {
-        ProcContainer_t* procContainerPtr = CONTAINER_OF(procLinkPtr, ProcContainer_t, link);
-
-        if (proc_GetPID(procContainerPtr->procRef) == pid)
-        {
-            return procContainerPtr;
-        }
-
-        procLinkPtr = le_dls_PeekNext(&list, procLinkPtr);
+        return NULL;
     }
 
-    return NULL;
-}
-
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Finds a process container for the app by pid.
- *
- * @return
- *      The pointer to a process container if successful.
- *      NULL if the process could not be found.
- */
-//--------------------------------------------------------------------------------------------------
-static ProcContainer_t* FindProcContainer
-(
-    app_Ref_t appRef,               ///< [IN] The application to search in.
-    pid_t pid                       ///< [IN] The pid to search for.
-)
-{
-    // Find the process in the app's list.
-    ProcContainer_t* procContainerPtr = FindProcContainerInList(appRef->procs, pid);
+    ProcContainer_t* procContainerPtr = proc_GetContextPtr(procRef);
 
-    if (procContainerPtr != NULL)
+    if ( (procContainerPtr == NULL) || (procContainerPtr->appRef != appRef) )
     {
-        return procContainerPtr;
+        return NULL;
     }
 
-    return FindProcContainerInList(appRef->auxProcs, pid);
+    return procContainerPtr;
 }
 
 
@@ -3112,11 +3088,15 @@ static ProcContainer_t* CreateProcContainer
     ProcContainer_t* procContainerPtr = le_mem_ForceAlloc(ProcContainerPool);
 
     procContainerPtr->procRef = procRef;
+    procContainerPtr->appRef = appRef;
     procContainerPtr->stopHandler = NULL;
     procContainerPtr->link = LE_DLS_LINK_INIT;
     procContainerPtr->externStopHandler = NULL;
     procContainerPtr->externContextPtr = NULL;
 
+    // Lets the container be found from the process, when the process has terminated.
+    proc_SetContextPtr(procRef, procContainerPtr);
+
     return procContainerPtr;
 }
 
@@ -3160,6 +3140,7 @@ app_Ref_t app_Create
     appPtr->additionalLinks = LE_SLS_LIST_INIT;
     appPtr->state = APP_STATE_STOPPED;
     appPtr->killTimer = NULL;
+    appPtr->contextPtr = NULL;
 
     LE_INFO("Creating app '%s'", appPtr->name);
 
@@ -3634,6 +3615,65 @@ bool app_HasTopLevelProc
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds the app running a top-level process with given PID.
+ *
+ * @return
+ *      The application reference if found.
+ *      NULL if the process is not a top-level process of any app.
+ */
+//--------------------------------------------------------------------------------------------------
+app_Ref_t app_FindByTopLevelProc
+(
+    pid_t pid                           ///< [IN] PID of the process.
+)
+{
+    proc_Ref_t procRef = proc_FindByPid(pid);
+
+    if (procRef == NULL)
+    {
+        return NULL;
+    }
+
+    ProcContainer_t* procContainerPtr = proc_GetContextPtr(procRef);
+
+    return (procContainerPtr == NULL) ? NULL : procContainerPtr->appRef;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the context pointer of an application, for its owner.
+ */
+//--------------------------------------------------------------------------------------------------
+void app_SetContextPtr
+(
+    app_Ref_t appRef,                   ///< [IN] The application reference.
+    void* contextPtr                    ///< [IN] Context pointer.
+)
+{
+    appRef->contextPtr = contextPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the context pointer of an application.
+ *
+ * @return
+ *      The context pointer set with app_SetContextPtr(), or NULL if none was set.
+ */
+//--------------------------------------------------------------------------------------------------
+void* app_GetContextPtr
+(
+    app_Ref_t appRef                    ///< [IN] The application reference.
+)
+{
+    return appRef->contextPtr;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets an application's name.
@@ -232,6 +232,47 @@ bool app_HasTopLevelProc
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds the app running a top-level process with given PID.
+ *
+ * @return
+ *      The application reference if found.
+ *      NULL if the process is not a top-level process of any app.
+ */
+//--------------------------------------------------------------------------------------------------
+app_Ref_t app_FindByTopLevelProc
+(
+    pid_t pid                           ///< [IN] PID of the process.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the context pointer of an application, for its owner.
+ */
+//--------------------------------------------------------------------------------------------------
+void app_SetContextPtr
+(
+    app_Ref_t appRef,                   ///< [IN] The application reference.
+    void* contextPtr                    ///< [IN] Context pointer.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the context pointer of an application.
+ *
+ * @return
+ *      The context pointer set with app_SetContextPtr(), or NULL if none was set.
+ */
+//--------------------------------------------------------------------------------------------------
+void* app_GetContextPtr
+(
+    app_Ref_t appRef                    ///< [IN] The application reference.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets an application's name.
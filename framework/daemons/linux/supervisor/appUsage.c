@@ -0,0 +1,410 @@
+//--------------------------------------------------------------------------------------------------
+/** @file supervisor/appUsage.c
+ *
+ * Periodic sampling of the resource usage of the running applications.
+ *
+ * The usage counters of the cgroups of each application are opened once when the application is
+ * started and kept open, so that a sample is a single read of each counter, with no path to build
+ * and no file to open.  All the applications are sampled in the same round, from one timer.  The
+ * CPU time taken by each round is measured, so that the cost of the sampling itself can be checked
+ * with le_appInfo_GetUsageSamplerStats().
+ *
+ * I/O is not sampled, since the Supervisor does not set up a blkio cgroup for the applications.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "limit.h"
+#include "cgroups.h"
+#include "fileDescriptor.h"
+#include "appUsage.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sampling period, in milliseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SAMPLE_PERIOD_MS            10000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Estimated maximum number of running applications, used to size the hashmap.
+ */
+//--------------------------------------------------------------------------------------------------
+#define APPS_HASHMAP_SIZE           31
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A resource usage sample.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t timeMs;                ///< Time of the sample, in milliseconds of the relative clock.
+    uint64_t cpuTimeUs;             ///< CPU time used by the application, in microseconds.
+    uint64_t memBytes;              ///< Memory used by the application, in bytes.
+}
+Sample_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Resource usage history of a running application.  The samples are kept in a ring, oldest ones
+ * overwritten first.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char name[LIMIT_MAX_APP_NAME_BYTES];            ///< Name of the application.
+    int cpuFd;                                      ///< CPU usage counter of its cgroup.
+    int memFd;                                      ///< Memory usage counter of its cgroup.
+    Sample_t samples[LE_APPINFO_MAX_USAGE_SAMPLES]; ///< Ring of samples.
+    size_t head;                                    ///< Index of the next sample to write.
+    size_t count;                                   ///< Number of samples in the ring.
+}
+AppUsage_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of application usage histories.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t AppUsagePool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Usage histories of the running applications, by application name.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t AppUsageMap;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sampling timer.  Only runs while there are applications to sample.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_timer_Ref_t SampleTimer;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of sampling rounds done, and total and maximum CPU time taken by a round, in nanoseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t RoundCount = 0;
+static uint64_t TotalRoundNs = 0;
+static uint64_t MaxRoundNs = 0;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the CPU time used by the calling thread, in nanoseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetThreadCpuTimeNs
+(
+    void
+)
+{
+    struct timespec time;
+
+    LE_ASSERT(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) == 0);
+
+    return ((uint64_t)time.tv_sec * 1000000000) + time.tv_nsec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Takes a sample of the resource usage of an application and adds it to its history.  Nothing is
+ * added if the counters could not be read.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TakeSample
+(
+    AppUsage_t* appUsagePtr,        ///< [IN] The application.
+    uint64_t timeMs                 ///< [IN] Time of the sample.
+)
+{
+    uint64_t cpuTimeNs;
+    uint64_t memBytes;
+
+    if ( (cgrp_ReadCounter(appUsagePtr->cpuFd, &cpuTimeNs) != LE_OK) ||
+         (cgrp_ReadCounter(appUsagePtr->memFd, &memBytes) != LE_OK) )
+    {
+        LE_WARN("Could not sample the resource usage of app '%s'.", appUsagePtr->name);
+        return;
+    }
+
+    Sample_t* samplePtr = &appUsagePtr->samples[appUsagePtr->head];
+
+    samplePtr->timeMs = timeMs;
+    samplePtr->cpuTimeUs = cpuTimeNs / 1000;
+    samplePtr->memBytes = memBytes;
+
+    appUsagePtr->head = (appUsagePtr->head + 1) % LE_APPINFO_MAX_USAGE_SAMPLES;
+
+    if (appUsagePtr->count < LE_APPINFO_MAX_USAGE_SAMPLES)
+    {
+        appUsagePtr->count++;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the current time of the relative clock, in milliseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetTimeMs
+(
+    void
+)
+{
+    le_clk_Time_t time = le_clk_GetRelativeTime();
+
+    return ((uint64_t)time.sec * 1000) + (time.usec / 1000);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sampling timer handler: samples all the running applications, and accounts for the CPU time
+ * taken by the round.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SampleAllApps
+(
+    le_timer_Ref_t timerRef         ///< [IN] The sampling timer.
+)
+{
+    uint64_t startNs = GetThreadCpuTimeNs();
+    uint64_t timeMs = GetTimeMs();
+
+    le_hashmap_It_Ref_t iter = le_hashmap_GetIterator(AppUsageMap);
+
+    while (le_hashmap_NextNode(iter) == LE_OK)
+    {
+        TakeSample(le_hashmap_GetValue(iter), timeMs);
+    }
+
+    uint64_t roundNs = GetThreadCpuTimeNs() - startNs;
+
+    RoundCount++;
+    TotalRoundNs += roundNs;
+
+    if (roundNs > MaxRoundNs)
+    {
+        MaxRoundNs = roundNs;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes the resource usage sampler.  Must be called once before the other functions of this
+ * module.
+ */
+//--------------------------------------------------------------------------------------------------
+void appUsage_Init
+(
+    void
+)
+{
+    AppUsagePool = le_mem_CreatePool("AppUsage", sizeof(AppUsage_t));
+
+    AppUsageMap = le_hashmap_Create("AppUsage",
+                                    APPS_HASHMAP_SIZE,
+                                    le_hashmap_HashString,
+                                    le_hashmap_EqualsString);
+
+    SampleTimer = le_timer_Create("AppUsageSample");
+    LE_ASSERT(le_timer_SetMsInterval(SampleTimer, SAMPLE_PERIOD_MS) == LE_OK);
+    LE_ASSERT(le_timer_SetRepeat(SampleTimer, 0) == LE_OK);
+    LE_ASSERT(le_timer_SetHandler(SampleTimer, SampleAllApps) == LE_OK);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts sampling the resource usage of an application.  The cgroups of the application must have
+ * been created.
+ */
+//--------------------------------------------------------------------------------------------------
+void appUsage_StartApp
+(
+    const char* appNamePtr          ///< [IN] Name of the application.
+)
+{
+    // Drop any history left from a previous run.
+    appUsage_StopApp(appNamePtr);
+
+    AppUsage_t* appUsagePtr = le_mem_ForceAlloc(AppUsagePool);
+
+    memset(appUsagePtr, 0, sizeof(*appUsagePtr));
+    LE_ASSERT(le_utf8_Copy(appUsagePtr->name, appNamePtr, sizeof(appUsagePtr->name), NULL)
+              == LE_OK);
+
+    appUsagePtr->cpuFd = cgrp_cpu_OpenUsage(appNamePtr);
+    appUsagePtr->memFd = cgrp_mem_OpenUsage(appNamePtr);
+
+    if ( (appUsagePtr->cpuFd < 0) || (appUsagePtr->memFd < 0) )
+    {
+        LE_ERROR("Resource usage of app '%s' will not be sampled.", appNamePtr);
+
+        if (appUsagePtr->cpuFd >= 0)
+        {
+            fd_Close(appUsagePtr->cpuFd);
+        }
+        if (appUsagePtr->memFd >= 0)
+        {
+            fd_Close(appUsagePtr->memFd);
+        }
+
+        le_mem_Release(appUsagePtr);
+        return;
+    }
+
+    // Start the history with the usage at start up.
+    TakeSample(appUsagePtr, GetTimeMs());
+
+    le_hashmap_Put(AppUsageMap, appUsagePtr->name, appUsagePtr);
+
+    if (!le_timer_IsRunning(SampleTimer))
+    {
+        LE_ASSERT(le_timer_Start(SampleTimer) == LE_OK);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stops sampling the resource usage of an application and drops its history.  Must be called
+ * before the cgroups of the application are deleted.
+ */
+//--------------------------------------------------------------------------------------------------
+void appUsage_StopApp
+(
+    const char* appNamePtr          ///< [IN] Name of the application.
+)
+{
+    AppUsage_t* appUsagePtr = le_hashmap_Remove(AppUsageMap, appNamePtr);
+
+    if (appUsagePtr == NULL)
+    {
+        return;
+    }
+
+    fd_Close(appUsagePtr->cpuFd);
+    fd_Close(appUsagePtr->memFd);
+    le_mem_Release(appUsagePtr);
+
+    if (le_hashmap_isEmpty(AppUsageMap))
+    {
+        LE_ASSERT(le_timer_Stop(SampleTimer) == LE_OK);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the recent resource usage of a running application, as sampled periodically by the
+ * Supervisor from the cgroups of the application.  The samples are returned from the newest to the
+ * oldest.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the application is not running.
+ *
+ * @note If the application name pointer is null or if its string is empty it is a fatal error, the
+ *       function will not return.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_appInfo_GetUsageHistory
+(
+    const char* appName,            ///< [IN] Application name.
+    uint32_t* ageMsPtr,             ///< [OUT] Age of each sample, in milliseconds.
+    size_t* ageMsSizePtr,           ///< [INOUT] Number of ages.
+    uint64_t* cpuTimeUsPtr,         ///< [OUT] CPU time used, in microseconds.
+    size_t* cpuTimeUsSizePtr,       ///< [INOUT] Number of CPU times.
+    uint64_t* memBytesPtr,          ///< [OUT] Memory used, in bytes.
+    size_t* memBytesSizePtr         ///< [INOUT] Number of memory sizes.
+)
+{
+    if ( (appName == NULL) || (appName[0] == '\0') )
+    {
+        LE_KILL_CLIENT("Invalid app name.");
+        return LE_FAULT;
+    }
+
+    AppUsage_t* appUsagePtr = le_hashmap_Get(AppUsageMap, appName);
+
+    if (appUsagePtr == NULL)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    size_t count = appUsagePtr->count;
+
+    if (*ageMsSizePtr < count)
+    {
+        count = *ageMsSizePtr;
+    }
+    if (*cpuTimeUsSizePtr < count)
+    {
+        count = *cpuTimeUsSizePtr;
+    }
+    if (*memBytesSizePtr < count)
+    {
+        count = *memBytesSizePtr;
+    }
+
+    uint64_t nowMs = GetTimeMs();
+    size_t index = appUsagePtr->head;
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        index = (index + LE_APPINFO_MAX_USAGE_SAMPLES - 1) % LE_APPINFO_MAX_USAGE_SAMPLES;
+
+        const Sample_t* samplePtr = &appUsagePtr->samples[index];
+
+        ageMsPtr[i] = (uint32_t)(nowMs - samplePtr->timeMs);
+        cpuTimeUsPtr[i] = samplePtr->cpuTimeUs;
+        memBytesPtr[i] = samplePtr->memBytes;
+    }
+
+    *ageMsSizePtr = count;
+    *cpuTimeUsSizePtr = count;
+    *memBytesSizePtr = count;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the cost of the resource usage sampling done by the Supervisor.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_appInfo_GetUsageSamplerStats
+(
+    uint32_t* periodMsPtr,          ///< [OUT] Sampling period, in milliseconds.
+    uint32_t* roundCountPtr,        ///< [OUT] Number of sampling rounds done.
+    uint32_t* avgRoundUsPtr,        ///< [OUT] Average CPU time of a round, in microseconds.
+    uint32_t* maxRoundUsPtr         ///< [OUT] Maximum CPU time of a round, in microseconds.
+)
+{
+    *periodMsPtr = SAMPLE_PERIOD_MS;
+    *roundCountPtr = RoundCount;
+    *avgRoundUsPtr = (RoundCount == 0) ? 0 : (uint32_t)((TotalRoundNs / RoundCount) / 1000);
+    *maxRoundUsPtr = (uint32_t)(MaxRoundNs / 1000);
+}
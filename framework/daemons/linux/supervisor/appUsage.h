@@ -0,0 +1,52 @@
+//--------------------------------------------------------------------------------------------------
+/** @file supervisor/appUsage.h
+ *
+ * API for sampling the resource usage of the running applications.
+ *
+ * The CPU time and the memory used by each running application are read periodically from its
+ * cgroups, all the applications in one round, and the last samples are kept in a history that
+ * can be queried with le_appInfo_GetUsageHistory().
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+#ifndef LEGATO_SRC_APP_USAGE_INCLUDE_GUARD
+#define LEGATO_SRC_APP_USAGE_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes the resource usage sampler.  Must be called once before the other functions of this
+ * module.
+ */
+//--------------------------------------------------------------------------------------------------
+void appUsage_Init
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts sampling the resource usage of an application.  The cgroups of the application must have
+ * been created.
+ */
+//--------------------------------------------------------------------------------------------------
+void appUsage_StartApp
+(
+    const char* appNamePtr          ///< [IN] Name of the application.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stops sampling the resource usage of an application and drops its history.  Must be called
+ * before the cgroups of the application are deleted.
+ */
+//--------------------------------------------------------------------------------------------------
+void appUsage_StopApp
+(
+    const char* appNamePtr          ///< [IN] Name of the application.
+);
+
+
+#endif  // LEGATO_SRC_APP_USAGE_INCLUDE_GUARD
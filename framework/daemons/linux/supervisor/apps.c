@@ -536,21 +536,21 @@ static AppContainer_t* GetActiveAppWithProc
     pid_t pid
 )
 {
-    le_dls_Link_t* appLinkPtr = le_dls_Peek(&ActiveAppsList);
+    app_Ref_t appRef = app_FindByTopLevelProc(pid);
 
-    while (appLinkPtr != NULL)
+    if (appRef == NULL)
     {
-        AppContainer_t* appContainerPtr = CONTAINER_OF(appLinkPtr, AppContainer_t, link);
+        return NULL;
+    }
 
-        if (app_HasTopLevelProc(appContainerPtr->appRef, pid))
-        {
-            return appContainerPtr;
-        }
+    AppContainer_t* appContainerPtr = app_GetContextPtr(appRef);
 
-        appLinkPtr = le_dls_PeekNext(&ActiveAppsList, appLinkPtr);
+    if ( (appContainerPtr == NULL) || !appContainerPtr->isActive )
+    {
+        return NULL;
     }
 
-    return NULL;
+    return appContainerPtr;
 }
 
 
@@ -626,6 +626,9 @@ static le_result_t CreateApp
 
     containerPtr->appRef = appRef;
     containerPtr->link = LE_DLS_LINK_INIT;
+
+    // Lets the container be found from the app, when one of its processes has terminated.
+    app_SetContextPtr(appRef, containerPtr);
     containerPtr->stopHandler = NULL;
     containerPtr->clientRef = NULL;
     containerPtr->traceAttachHandler = NULL;
@@ -24,6 +24,7 @@
 #include "killProc.h"
 #include "interfaces.h"
 #include "sysStatus.h"
+#include "wait.h"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -164,6 +165,7 @@ typedef struct proc_Ref
     proc_BlockCallback_t  blockCallback;  ///< Callback function to indicate when the process is
                                           ///  has been blocked after the fork but before the exec.
     void* blockContextPtr;          ///< Context pointer for the blockCallback.
+    void* contextPtr;               ///< Context pointer of the owner of the process.
 }
 Process_t;
 
@@ -189,6 +191,22 @@ Arg_t;
 static le_mem_PoolRef_t ProcessPool;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Estimated maximum number of running processes, used to size the hashmap.
+ */
+//--------------------------------------------------------------------------------------------------
+#define PROCS_HASHMAP_SIZE          63
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Running processes, by pid.  Lets the owner of a terminated child be found without searching.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t ProcPidMap;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * The memory pool for path and name strings.
@@ -383,6 +401,11 @@ void proc_Init
     PathPool = le_mem_CreatePool("Paths", LIMIT_MAX_PATH_BYTES);
     PriorityPool = le_mem_CreatePool("Priority", LIMIT_MAX_PRIORITY_NAME_BYTES);
     ArgsPool = le_mem_CreatePool("Args", sizeof(Arg_t));
+
+    ProcPidMap = le_hashmap_Create("ProcPids",
+                                   PROCS_HASHMAP_SIZE,
+                                   le_hashmap_HashUInt32,
+                                   le_hashmap_EqualsUInt32);
 }
 
 
@@ -452,6 +475,7 @@ proc_Ref_t proc_Create
     procPtr->faultTime = 0;
     procPtr->pid = -1;  // Processes that are not running are assigned -1 as its pid.
     procPtr->cmdKill = false;
+    procPtr->contextPtr = NULL;
 
     // Default to using /dev/null for standard streams.
     procPtr->stdInFd = -1;
@@ -519,6 +543,12 @@ void proc_Delete
     // Delete arguments override list.
     proc_ClearArgs(procRef);
 
+    // The process should be dead, but don't leave a dangling entry in the index if it isn't.
+    if (procRef->pid != -1)
+    {
+        le_hashmap_Remove(ProcPidMap, &procRef->pid);
+    }
+
     // Close any open file descriptors.
     if (procRef->stdInFd != -1)
     {
@@ -1367,6 +1397,10 @@ le_result_t proc_Start
     }
 
     procRef->pid = pID;
+    le_hashmap_Put(ProcPidMap, &procRef->pid, procRef);
+
+    // Get the termination of the child reported directly.
+    wait_WatchChild(pID);
 
     // Don't need this end of the pipe.
     fd_Close(syncPipeFd[READ_PIPE]);
@@ -1466,6 +1500,56 @@ pid_t proc_GetPID
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds a running process by its PID.
+ *
+ * @return
+ *      The process reference if found.
+ *      NULL if the PID is not the PID of a running process.
+ */
+//--------------------------------------------------------------------------------------------------
+proc_Ref_t proc_FindByPid
+(
+    pid_t pid                       ///< [IN] The PID.
+)
+{
+    return le_hashmap_Get(ProcPidMap, &pid);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the context pointer of a process, for its owner.
+ */
+//--------------------------------------------------------------------------------------------------
+void proc_SetContextPtr
+(
+    proc_Ref_t procRef,             ///< [IN] The process reference.
+    void* contextPtr                ///< [IN] Context pointer.
+)
+{
+    procRef->contextPtr = contextPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the context pointer of a process.
+ *
+ * @return
+ *      The context pointer set with proc_SetContextPtr(), or NULL if none was set.
+ */
+//--------------------------------------------------------------------------------------------------
+void* proc_GetContextPtr
+(
+    proc_Ref_t procRef              ///< [IN] The process reference.
+)
+{
+    return procRef->contextPtr;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get the process's name.
@@ -2009,6 +2093,21 @@ static bool ReachedFaultLimit
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records that a process is dead: removes it from the index of running processes.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ForgetPid
+(
+    proc_Ref_t procRef             ///< [IN] The process reference.
+)
+{
+    le_hashmap_Remove(ProcPidMap, &procRef->pid);
+    procRef->pid = -1;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This handler must be called when a SIGCHILD is received for the specified process.
@@ -2033,7 +2132,7 @@ FaultAction_t proc_SigChildHandler
         procRef->cmdKill = false;
 
         // Remember that this process is dead.
-        procRef->pid = -1;
+        ForgetPid(procRef);
 
         return FAULT_ACTION_NONE;
     }
@@ -2071,7 +2170,7 @@ FaultAction_t proc_SigChildHandler
     }
 
     // Record the fact that the process is dead.
-    procRef->pid = -1;
+    ForgetPid(procRef);
 
     // If the process has reached its fault limit, take action to stop
     // the apparently futile attempts to start this thing.
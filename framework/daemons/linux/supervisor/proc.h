@@ -165,6 +165,47 @@ const char* proc_GetName
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds a running process by its PID.
+ *
+ * @return
+ *      The process reference if found.
+ *      NULL if the PID is not the PID of a running process.
+ */
+//--------------------------------------------------------------------------------------------------
+proc_Ref_t proc_FindByPid
+(
+    pid_t pid                       ///< [IN] The PID.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the context pointer of a process, for its owner.
+ */
+//--------------------------------------------------------------------------------------------------
+void proc_SetContextPtr
+(
+    proc_Ref_t procRef,             ///< [IN] The process reference.
+    void* contextPtr                ///< [IN] Context pointer.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the context pointer of a process.
+ *
+ * @return
+ *      The context pointer set with proc_SetContextPtr(), or NULL if none was set.
+ */
+//--------------------------------------------------------------------------------------------------
+void* proc_GetContextPtr
+(
+    proc_Ref_t procRef              ///< [IN] The process reference.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get the name of the application that this process belongs to.
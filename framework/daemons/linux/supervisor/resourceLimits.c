@@ -12,6 +12,7 @@
 #include "limit.h"
 #include "user.h"
 #include "cgroups.h"
+#include "appUsage.h"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -374,6 +375,9 @@ le_result_t resLim_SetAppLimits
     }
 
     le_cfg_CancelTxn(appCfg);
+
+    appUsage_StartApp(appNamePtr);
+
     return LE_OK;
 }
 
@@ -494,6 +498,9 @@ void resLim_CleanupApp
 {
     const char* appNamePtr = app_GetName(appRef);
 
+    // Stop sampling the cgroups before they are removed.
+    appUsage_StopApp(appNamePtr);
+
     // Remove cgroups for this app in each of the cgroup subsystems.
     cgrp_SubSys_t subSys = 0;
     for (; subSys < CGRP_NUM_SUBSYSTEMS; subSys++)
@@ -212,6 +212,7 @@
 #include "daemon.h"
 #include "apps.h"
 #include "wait.h"
+#include "appUsage.h"
 #include "fileSystem.h"
 #include "sysStatus.h"
 #include "fileDescriptor.h"
@@ -720,6 +721,50 @@ static void CaptureDebugData
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handles the termination of a child process.  The PID is passed down to the apps SIGCHILD handler
+ * and framework daemon SIGCHILD handler for identification and processing.  The lower layer
+ * handlers are assumed to reap the child only if it is going to handle the process death.  If
+ * neither the apps or framework daemons recognize the child then we must reap it here.
+ */
+//--------------------------------------------------------------------------------------------------
+static void HandleChildExit
+(
+    pid_t pid                       ///< [IN] Pid of the child, in a waitable state.
+)
+{
+    // Send the pid to the apps SIGCHILD handler for processing.
+    le_result_t result = apps_SigChildHandler(pid);
+
+    if (result == LE_FAULT)
+    {
+        // There was an app fault that could not be handled so restart the framework.
+        framework_Reboot();
+    }
+
+    if (result == LE_NOT_FOUND)
+    {
+        // Send the pid to the framework daemon's SIGCHILD handler for processing.
+        le_result_t r = fwDaemons_SigChildHandler(pid);
+
+        if (r == LE_FAULT)
+        {
+            CaptureDebugData();
+            framework_Reboot();
+        }
+        else if (r == LE_NOT_FOUND)
+        {
+            // The child is neither an application process nor a framework daemon.
+            // Reap the child now.
+            LE_INFO("Reaping unconfigured child process %d.", pid);
+
+            wait_ReapChild(pid);
+        }
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * The signal event handler function for SIGCHLD called from the Legato event loop.
@@ -734,10 +779,11 @@ static void CaptureDebugData
  *
  * Because SIGCHILD signals may come from either apps or framework daemons they are caught here
  * first.  In this function we do a wait_Peek() to get the PID of the process that generated the
- * SIGCHILD without reaping the child.  The PID is passed down to the apps SIGCHILD handler and
- * framework daemon SIGCHILD handler for identification and processing.  The lower layer handlers
- * are assumed to reap the child only if it is going to handle the process death.  If neither the
- * apps or framework daemons recognize the child then we must reap it here.
+ * SIGCHILD without reaping the child, and pass it to HandleChildExit().
+ *
+ * Application processes started by the Supervisor are also watched through their process file
+ * descriptors (see wait_WatchChild()), and their exits are usually handled before the SIGCHILD is.
+ * Whichever comes first reaps the child, and the other one does not see it any more.
  */
 //--------------------------------------------------------------------------------------------------
 static void SigChildHandler
@@ -758,34 +804,7 @@ static void SigChildHandler
             break;
         }
 
-        // Send the pid to the apps SIGCHILD handler for processing.
-        le_result_t result = apps_SigChildHandler(pid);
-
-        if (result == LE_FAULT)
-        {
-            // There was an app fault that could not be handled so restart the framework.
-            framework_Reboot();
-        }
-
-        if (result == LE_NOT_FOUND)
-        {
-            // Send the pid to the framework daemon's SIGCHILD handler for processing.
-            le_result_t r = fwDaemons_SigChildHandler(pid);
-
-            if (r == LE_FAULT)
-            {
-                CaptureDebugData();
-                framework_Reboot();
-            }
-            else if (r == LE_NOT_FOUND)
-            {
-                // The child is neither an application process nor a framework daemon.
-                // Reap the child now.
-                LE_INFO("Reaping unconfigured child process %d.", pid);
-
-                wait_ReapChild(pid);
-            }
-        }
+        HandleChildExit(pid);
     }
 }
 
@@ -1154,6 +1173,8 @@ COMPONENT_INIT
     SetupSmackOnlyCap();
 
     cgrp_Init();
+    appUsage_Init();
+    wait_Init(HandleChildExit);
 
     if (!fs_IsMountPoint(CURRENT_SYSTEM_PATH))
     {
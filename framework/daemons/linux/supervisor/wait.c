@@ -8,6 +8,215 @@
 
 #include "legato.h"
 #include "wait.h"
+#include "fileDescriptor.h"
+#include "stats.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * System call number of pidfd_open(), not defined by older C libraries.  It is 434 in the system
+ * call table shared by most architectures since Linux 5.1, but MIPS, Alpha and IA-64 add their own
+ * offsets to it, and x32 sets the x32 bit.
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef SYS_pidfd_open
+#if defined(__NR_pidfd_open)
+#define SYS_pidfd_open              __NR_pidfd_open
+#elif defined(__mips__) && (_MIPS_SIM == _ABIO32)
+#define SYS_pidfd_open              (4000 + 434)
+#elif defined(__mips__) && (_MIPS_SIM == _ABI64)
+#define SYS_pidfd_open              (5000 + 434)
+#elif defined(__mips__) && (_MIPS_SIM == _ABIN32)
+#define SYS_pidfd_open              (6000 + 434)
+#elif defined(__mips__)
+#error "Unknown MIPS ABI"
+#elif defined(__alpha__)
+#define SYS_pidfd_open              (110 + 434)
+#elif defined(__ia64__)
+#define SYS_pidfd_open              (1024 + 434)
+#elif defined(__x86_64__) && defined(__ILP32__)
+#define SYS_pidfd_open              (0x40000000 + 434)
+#else
+#define SYS_pidfd_open              434
+#endif
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Estimated maximum number of watched children, used to size the hashmap.
+ */
+//--------------------------------------------------------------------------------------------------
+#define WATCHES_HASHMAP_SIZE        63
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Watch on a child.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    pid_t pid;                          ///< Pid of the child.
+    int pidFd;                          ///< Process file descriptor of the child.
+    le_fdMonitor_Ref_t monitorRef;      ///< Monitor of the process file descriptor.
+}
+Watch_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of watches.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t WatchPool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Watches, by pid of the child.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t WatchMap;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler called when a watched child has terminated.
+ */
+//--------------------------------------------------------------------------------------------------
+static wait_ChildHandlerFunc_t ChildHandler = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * true if the kernel supports pidfds.  Cleared on the first failure of pidfd_open() with ENOSYS.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsPidFdSupported = true;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Drops a watch, if the child is watched.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DropWatch
+(
+    pid_t pid                       ///< [IN] Pid of the child.
+)
+{
+    Watch_t* watchPtr = le_hashmap_Remove(WatchMap, &pid);
+
+    if (watchPtr != NULL)
+    {
+        le_fdMonitor_Delete(watchPtr->monitorRef);
+        fd_Close(watchPtr->pidFd);
+        le_mem_Release(watchPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler of the events of the process file descriptor of a watched child, which becomes readable
+ * when the child terminates.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PidFdHandler
+(
+    int fd,                         ///< [IN] Process file descriptor.
+    short events                    ///< [IN] Events.
+)
+{
+    Watch_t* watchPtr = le_fdMonitor_GetContextPtr();
+    pid_t pid = watchPtr->pid;
+
+    ChildHandler(pid);
+
+    // The handler normally reaps the child, which drops the watch.  If it did not, drop the watch
+    // anyway, so that the handler is not called again: the child will still be seen on SIGCHLD.
+    if (le_hashmap_Get(WatchMap, &pid) == watchPtr)
+    {
+        DropWatch(pid);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes the wait module.
+ */
+//--------------------------------------------------------------------------------------------------
+void wait_Init
+(
+    wait_ChildHandlerFunc_t handlerFunc     ///< [IN] Handler called when a watched child has
+                                            ///       terminated.
+)
+{
+    ChildHandler = handlerFunc;
+
+    WatchPool = le_mem_CreatePool("ChildWatches", sizeof(Watch_t));
+
+    WatchMap = le_hashmap_Create("ChildWatches",
+                                 WATCHES_HASHMAP_SIZE,
+                                 le_hashmap_HashUInt32,
+                                 le_hashmap_EqualsUInt32);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Watches a child through a process file descriptor (pidfd), so that its termination is reported
+ * directly to the handler given to wait_Init(), from the event loop, without waiting for SIGCHLD
+ * to be handled.  The watch is dropped when the child is reaped with wait_ReapChild().
+ *
+ * If the kernel does not support pidfds, this does nothing: the termination of the child is only
+ * seen through SIGCHLD.
+ */
+//--------------------------------------------------------------------------------------------------
+void wait_WatchChild
+(
+    pid_t pid                       ///< [IN] Pid of the child to watch.
+)
+{
+    if (!IsPidFdSupported)
+    {
+        return;
+    }
+
+    int pidFd = syscall(SYS_pidfd_open, pid, 0);
+
+    if (pidFd == -1)
+    {
+        if (errno == ENOSYS)
+        {
+            LE_INFO("Process file descriptors are not supported, children are reaped on SIGCHLD.");
+            IsPidFdSupported = false;
+        }
+        else
+        {
+            LE_ERROR("Could not open process file descriptor of child %d.  %m.", pid);
+        }
+        return;
+    }
+
+    // The pid can only have been reused if the previous child was reaped, but be safe.
+    DropWatch(pid);
+
+    Watch_t* watchPtr = le_mem_ForceAlloc(WatchPool);
+
+    watchPtr->pid = pid;
+    watchPtr->pidFd = pidFd;
+
+    char monitorName[32];
+    snprintf(monitorName, sizeof(monitorName), "Child-%d", pid);
+
+    watchPtr->monitorRef = le_fdMonitor_Create(monitorName, pidFd, PidFdHandler, POLLIN);
+    le_fdMonitor_SetContextPtr(watchPtr->monitorRef, watchPtr);
+
+    le_hashmap_Put(WatchMap, &watchPtr->pid, watchPtr);
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -44,7 +253,8 @@ pid_t wait_Peek
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Reap a specific child.  The child must be in a waitable state.
+ * Reap a specific child.  The child must be in a waitable state.  Drops the watch on the child if
+ * it was watched, and removes the statistics page left behind by the child if it was killed.
  *
  * @note
  *      This function does not return on error.
@@ -72,5 +282,8 @@ int wait_ReapChild
 
     LE_FATAL_IF(resultPid == 0, "Could not reap child %d.", pid);
 
+    DropWatch(pid);
+    stats_RemovePage(pid);
+
     return status;
 }
@@ -9,6 +9,45 @@
 #define LEGATO_SRC_WAIT_INCLUDE_GUARD
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prototype of the handler called when a watched child has terminated.  The child is not reaped.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*wait_ChildHandlerFunc_t)
+(
+    pid_t pid                       ///< [IN] Pid of the terminated child.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes the wait module.
+ */
+//--------------------------------------------------------------------------------------------------
+void wait_Init
+(
+    wait_ChildHandlerFunc_t handlerFunc     ///< [IN] Handler called when a watched child has
+                                            ///       terminated.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Watches a child through a process file descriptor (pidfd), so that its termination is reported
+ * directly to the handler given to wait_Init(), from the event loop, without waiting for SIGCHLD
+ * to be handled.  The watch is dropped when the child is reaped with wait_ReapChild().
+ *
+ * If the kernel does not support pidfds, this does nothing: the termination of the child is only
+ * seen through SIGCHLD.
+ */
+//--------------------------------------------------------------------------------------------------
+void wait_WatchChild
+(
+    pid_t pid                       ///< [IN] Pid of the child to watch.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets the pid of any child that is in a waitable state without reaping the child process.
@@ -26,7 +65,8 @@ pid_t wait_Peek
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Reap a specific child.  The child must be in a waitable state.
+ * Reap a specific child.  The child must be in a waitable state.  Drops the watch on the child if
+ * it was watched, and removes the statistics page left behind by the child if it was killed.
  *
  * @note This function does not return on error.
  *
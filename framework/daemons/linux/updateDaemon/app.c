@@ -54,6 +54,9 @@ static const char* PreInstallPath = "/legato/apps/%s/read-only/script/pre-instal
 static const char* PostInstallPath = "/legato/apps/%s/read-only/script/post-install";
 
 
+static const char* SdirLoadAppCommand = "/legato/systems/current/bin/sdir load '%s'";
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Import an applications configuration into the system config tree, allowing the supervisor to be
@@ -202,6 +205,27 @@ static void ExecPostinstallHook
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reload the bindings configuration of an application, and the other applications' bindings to its
+ * services.  The other bindings are left untouched, so their clients are not disturbed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReloadAppBindings
+(
+    const char* appNamePtr  ///< [IN] Name of the app installed or removed.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char commandBuffer[LIMIT_MAX_PATH_BYTES] = "";
+    int count = snprintf(commandBuffer, sizeof(commandBuffer), SdirLoadAppCommand, appNamePtr);
+
+    LE_ASSERT(count < sizeof(commandBuffer));
+
+    system(commandBuffer);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Recursively sets the permissions for all files and directories in application read-only directory.
@@ -781,7 +805,7 @@ le_result_t app_InstallIndividual
 
 
     // Reload the bindings configuration
-    system("/legato/systems/current/bin/sdir load");
+    ReloadAppBindings(appNamePtr);
 
     ExecPostinstallHook(appMd5Ptr);
 
@@ -856,7 +880,7 @@ le_result_t app_RemoveIndividual
     system_UnlinkApp("current", delAppName);
 
     // Reload the bindings configuration
-    system("/legato/systems/current/bin/sdir load");
+    ReloadAppBindings(appNamePtr);
 
     sysStatus_MarkTried();
 
@@ -0,0 +1,555 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file decompress.c
+ *
+ * Streaming decompressors used by the Update Daemon to unpack update pack payloads.
+ *
+ * xz payloads are decoded by liblzma's multi-threaded decoder when it is available, so that the
+ * independent blocks of a multi-block stream (as produced by "xz -T") are decoded in parallel.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "decompress.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Magic numbers found at the start of the compressed streams.
+ */
+//--------------------------------------------------------------------------------------------------
+static const uint8_t Bzip2Magic[] = { 'B', 'Z', 'h' };
+static const uint8_t XzMagic[] = { 0xFD, '7', 'z', 'X', 'Z', 0x00 };
+static const uint8_t ZstdMagic[] = { 0x28, 0xB5, 0x2F, 0xFD };
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Offset and value of the magic string found in the header of a POSIX (ustar) tarball.
+ */
+//--------------------------------------------------------------------------------------------------
+#define USTAR_MAGIC_OFFSET  257
+#define USTAR_MAGIC         "ustar"
+
+
+#if UPDATE_UNPACK_XZ
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory limit for the xz decoder.  Above this, the multi-threaded decoder falls back to decoding
+ * in a single thread rather than failing.
+ */
+//--------------------------------------------------------------------------------------------------
+#define XZ_MEMLIMIT_THREADING   (64 * 1024 * 1024)
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a buffer starts with a given magic number.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool HasMagic
+(
+    const uint8_t* headPtr,
+    size_t headLen,
+    const uint8_t* magicPtr,
+    size_t magicLen
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return (headLen >= magicLen) && (memcmp(headPtr, magicPtr, magicLen) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set up the decoder for the stream's format.
+ *
+ * @return LE_OK if successful, LE_FAULT otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t InitDecoder
+(
+    decompress_Stream_t* streamPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    streamPtr->isEnd = false;
+
+    switch (streamPtr->format)
+    {
+        case DECOMPRESS_NONE:
+            return LE_OK;
+
+        case DECOMPRESS_BZIP2:
+        {
+            memset(&streamPtr->u.bz, 0, sizeof(streamPtr->u.bz));
+
+            int bzResult = BZ2_bzDecompressInit(&streamPtr->u.bz, 0, 0);
+            if (bzResult != BZ_OK)
+            {
+                LE_ERROR("Failed to initialize bzip2 decoder (%d).", bzResult);
+                return LE_FAULT;
+            }
+            return LE_OK;
+        }
+
+#if UPDATE_UNPACK_XZ
+        case DECOMPRESS_XZ:
+        {
+            lzma_stream init = LZMA_STREAM_INIT;
+            lzma_ret xzResult;
+
+            streamPtr->u.xz = init;
+
+#if LZMA_VERSION >= 50040002
+            long numCpus = sysconf(_SC_NPROCESSORS_ONLN);
+            lzma_mt options =
+            {
+                .threads = (numCpus > 1) ? numCpus : 1,
+                .memlimit_threading = XZ_MEMLIMIT_THREADING,
+                .memlimit_stop = UINT64_MAX,
+            };
+
+            xzResult = lzma_stream_decoder_mt(&streamPtr->u.xz, &options);
+#else
+            xzResult = lzma_stream_decoder(&streamPtr->u.xz, UINT64_MAX, 0);
+#endif
+            if (xzResult != LZMA_OK)
+            {
+                LE_ERROR("Failed to initialize xz decoder (%d).", xzResult);
+                return LE_FAULT;
+            }
+            return LE_OK;
+        }
+#endif
+
+#if UPDATE_UNPACK_ZSTD
+        case DECOMPRESS_ZSTD:
+            streamPtr->u.zstdPtr = ZSTD_createDStream();
+            if (streamPtr->u.zstdPtr == NULL)
+            {
+                LE_ERROR("Failed to initialize zstd decoder.");
+                return LE_FAULT;
+            }
+            ZSTD_initDStream(streamPtr->u.zstdPtr);
+            return LE_OK;
+#endif
+
+        default:
+            LE_FATAL("Unexpected format %d.", streamPtr->format);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the decoder for the stream's format.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EndDecoder
+(
+    decompress_Stream_t* streamPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    switch (streamPtr->format)
+    {
+        case DECOMPRESS_BZIP2:
+            BZ2_bzDecompressEnd(&streamPtr->u.bz);
+            break;
+
+#if UPDATE_UNPACK_XZ
+        case DECOMPRESS_XZ:
+            lzma_end(&streamPtr->u.xz);
+            break;
+#endif
+
+#if UPDATE_UNPACK_ZSTD
+        case DECOMPRESS_ZSTD:
+            ZSTD_freeDStream(streamPtr->u.zstdPtr);
+            streamPtr->u.zstdPtr = NULL;
+            break;
+#endif
+
+        default:
+            break;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode bzip2 data.
+ *
+ * @return LE_OK if successful, LE_FAULT if the data is corrupted.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t RunBzip2
+(
+    decompress_Stream_t* streamPtr,
+    const uint8_t** inPtrPtr,
+    size_t* inLenPtr,
+    uint8_t* outPtr,
+    size_t* outLenPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    bz_stream* bzPtr = &streamPtr->u.bz;
+    le_result_t result = LE_OK;
+
+    bzPtr->next_in = (char*)*inPtrPtr;
+    bzPtr->avail_in = *inLenPtr;
+    bzPtr->next_out = (char*)outPtr;
+    bzPtr->avail_out = *outLenPtr;
+
+    while (bzPtr->avail_out > 0)
+    {
+        // Another stream may follow the one that just ended.
+        if (streamPtr->isEnd)
+        {
+            if (bzPtr->avail_in == 0)
+            {
+                break;
+            }
+
+            bz_stream saved = *bzPtr;
+
+            EndDecoder(streamPtr);
+            if (InitDecoder(streamPtr) != LE_OK)
+            {
+                result = LE_FAULT;
+                break;
+            }
+            bzPtr->next_in = saved.next_in;
+            bzPtr->avail_in = saved.avail_in;
+            bzPtr->next_out = saved.next_out;
+            bzPtr->avail_out = saved.avail_out;
+        }
+
+        unsigned int availIn = bzPtr->avail_in;
+        unsigned int availOut = bzPtr->avail_out;
+        int bzResult = BZ2_bzDecompress(bzPtr);
+
+        if (bzResult == BZ_STREAM_END)
+        {
+            streamPtr->isEnd = true;
+        }
+        else if (bzResult != BZ_OK)
+        {
+            LE_ERROR("bzip2 decoding failed (%d).", bzResult);
+            result = LE_FAULT;
+            break;
+        }
+        else if ((bzPtr->avail_in == availIn) && (bzPtr->avail_out == availOut))
+        {
+            // Needs more input.
+            break;
+        }
+    }
+
+    *inLenPtr = bzPtr->avail_in;
+    *inPtrPtr = (const uint8_t*)bzPtr->next_in;
+    *outLenPtr -= bzPtr->avail_out;
+
+    return result;
+}
+
+
+#if UPDATE_UNPACK_XZ
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode xz data.
+ *
+ * @return LE_OK if successful, LE_FAULT if the data is corrupted.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t RunXz
+(
+    decompress_Stream_t* streamPtr,
+    const uint8_t** inPtrPtr,
+    size_t* inLenPtr,
+    uint8_t* outPtr,
+    size_t* outLenPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    lzma_stream* xzPtr = &streamPtr->u.xz;
+    le_result_t result = LE_OK;
+
+    xzPtr->next_in = *inPtrPtr;
+    xzPtr->avail_in = *inLenPtr;
+    xzPtr->next_out = outPtr;
+    xzPtr->avail_out = *outLenPtr;
+
+    while (xzPtr->avail_out > 0)
+    {
+        // Another stream may follow the one that just ended.
+        if (streamPtr->isEnd)
+        {
+            if (xzPtr->avail_in == 0)
+            {
+                break;
+            }
+
+            lzma_stream saved = *xzPtr;
+
+            EndDecoder(streamPtr);
+            if (InitDecoder(streamPtr) != LE_OK)
+            {
+                result = LE_FAULT;
+                break;
+            }
+            xzPtr->next_in = saved.next_in;
+            xzPtr->avail_in = saved.avail_in;
+            xzPtr->next_out = saved.next_out;
+            xzPtr->avail_out = saved.avail_out;
+        }
+
+        lzma_ret xzResult = lzma_code(xzPtr, LZMA_RUN);
+
+        if (xzResult == LZMA_STREAM_END)
+        {
+            streamPtr->isEnd = true;
+        }
+        else if (xzResult == LZMA_BUF_ERROR)
+        {
+            // No progress possible: needs more input.
+            break;
+        }
+        else if (xzResult != LZMA_OK)
+        {
+            LE_ERROR("xz decoding failed (%d).", xzResult);
+            result = LE_FAULT;
+            break;
+        }
+    }
+
+    *inLenPtr = xzPtr->avail_in;
+    *inPtrPtr = xzPtr->next_in;
+    *outLenPtr -= xzPtr->avail_out;
+
+    return result;
+}
+#endif
+
+
+#if UPDATE_UNPACK_ZSTD
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode zstd data.
+ *
+ * @return LE_OK if successful, LE_FAULT if the data is corrupted.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t RunZstd
+(
+    decompress_Stream_t* streamPtr,
+    const uint8_t** inPtrPtr,
+    size_t* inLenPtr,
+    uint8_t* outPtr,
+    size_t* outLenPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ZSTD_inBuffer in = { .src = *inPtrPtr, .size = *inLenPtr, .pos = 0 };
+    ZSTD_outBuffer out = { .dst = outPtr, .size = *outLenPtr, .pos = 0 };
+    le_result_t result = LE_OK;
+
+    // The zstd decoder moves on to the next frame by itself.
+    while (out.pos < out.size)
+    {
+        size_t inPos = in.pos;
+        size_t outPos = out.pos;
+        size_t zstdResult = ZSTD_decompressStream(streamPtr->u.zstdPtr, &out, &in);
+
+        if (ZSTD_isError(zstdResult))
+        {
+            LE_ERROR("zstd decoding failed (%s).", ZSTD_getErrorName(zstdResult));
+            result = LE_FAULT;
+            break;
+        }
+        streamPtr->isEnd = (zstdResult == 0);
+
+        if ((in.pos == inPos) && (out.pos == outPos))
+        {
+            // Needs more input.
+            break;
+        }
+    }
+
+    *inPtrPtr += in.pos;
+    *inLenPtr -= in.pos;
+    *outLenPtr = out.pos;
+
+    return result;
+}
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Detect the format of a stream from its first bytes and set up a decoder for it.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_UNSUPPORTED if the format is not recognized or its support is not built in.
+ *      - LE_FAULT if the decoder could not be initialized.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t decompress_Open
+(
+    decompress_Stream_t* streamPtr, ///< [OUT] Stream to initialize.
+    const uint8_t* headPtr,         ///< [IN] First bytes of the stream.
+    size_t headLen                  ///< [IN] Number of bytes at headPtr.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (HasMagic(headPtr, headLen, Bzip2Magic, sizeof(Bzip2Magic)))
+    {
+        streamPtr->format = DECOMPRESS_BZIP2;
+    }
+    else if (HasMagic(headPtr, headLen, XzMagic, sizeof(XzMagic)))
+    {
+#if UPDATE_UNPACK_XZ
+        streamPtr->format = DECOMPRESS_XZ;
+#else
+        LE_ERROR("xz compressed payloads are not supported by this build.");
+        return LE_UNSUPPORTED;
+#endif
+    }
+    else if (HasMagic(headPtr, headLen, ZstdMagic, sizeof(ZstdMagic)))
+    {
+#if UPDATE_UNPACK_ZSTD
+        streamPtr->format = DECOMPRESS_ZSTD;
+#else
+        LE_ERROR("zstd compressed payloads are not supported by this build.");
+        return LE_UNSUPPORTED;
+#endif
+    }
+    else if (   (headLen >= USTAR_MAGIC_OFFSET + sizeof(USTAR_MAGIC) - 1)
+             && (memcmp(headPtr + USTAR_MAGIC_OFFSET, USTAR_MAGIC, sizeof(USTAR_MAGIC) - 1) == 0))
+    {
+        streamPtr->format = DECOMPRESS_NONE;
+    }
+    else
+    {
+        LE_ERROR("Payload compression format not recognized.");
+        return LE_UNSUPPORTED;
+    }
+
+    return InitDecoder(streamPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a printable name for the format of a stream.
+ */
+//--------------------------------------------------------------------------------------------------
+const char* decompress_GetName
+(
+    const decompress_Stream_t* streamPtr    ///< [IN] Stream.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    switch (streamPtr->format)
+    {
+        case DECOMPRESS_NONE:   return "none";
+        case DECOMPRESS_BZIP2:  return "bzip2";
+        case DECOMPRESS_XZ:     return "xz";
+        case DECOMPRESS_ZSTD:   return "zstd";
+    }
+
+    return "unknown";
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decompress as much of the input as will fit in the output buffer.
+ *
+ * The input pointer and length are advanced past the bytes consumed.  Concatenated compressed
+ * streams (as produced by parallel compressors like pbzip2 or pixz) are decoded one after the
+ * other.  Decoders may hold back output, so at the end of the input this must be called (with no
+ * input) until it returns no output.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FAULT if the input is corrupted.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t decompress_Run
+(
+    decompress_Stream_t* streamPtr, ///< [IN] Stream.
+    const uint8_t** inPtrPtr,       ///< [IN,OUT] Input bytes.
+    size_t* inLenPtr,               ///< [IN,OUT] Number of input bytes.
+    uint8_t* outPtr,                ///< [OUT] Output buffer.
+    size_t* outLenPtr               ///< [IN,OUT] Output buffer size in, number of bytes out.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    switch (streamPtr->format)
+    {
+        case DECOMPRESS_NONE:
+        {
+            size_t count = (*inLenPtr < *outLenPtr) ? *inLenPtr : *outLenPtr;
+
+            memcpy(outPtr, *inPtrPtr, count);
+            *inPtrPtr += count;
+            *inLenPtr -= count;
+            *outLenPtr = count;
+            return LE_OK;
+        }
+
+        case DECOMPRESS_BZIP2:
+            return RunBzip2(streamPtr, inPtrPtr, inLenPtr, outPtr, outLenPtr);
+
+#if UPDATE_UNPACK_XZ
+        case DECOMPRESS_XZ:
+            return RunXz(streamPtr, inPtrPtr, inLenPtr, outPtr, outLenPtr);
+#endif
+
+#if UPDATE_UNPACK_ZSTD
+        case DECOMPRESS_ZSTD:
+            return RunZstd(streamPtr, inPtrPtr, inLenPtr, outPtr, outLenPtr);
+#endif
+
+        default:
+            LE_FATAL("Unexpected format %d.", streamPtr->format);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether the input ended cleanly, at the end of a compressed stream.
+ *
+ * @return true if the stream is complete.
+ */
+//--------------------------------------------------------------------------------------------------
+bool decompress_IsComplete
+(
+    const decompress_Stream_t* streamPtr    ///< [IN] Stream.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return (streamPtr->format == DECOMPRESS_NONE) || streamPtr->isEnd;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the resources held by a stream's decoder.
+ */
+//--------------------------------------------------------------------------------------------------
+void decompress_Close
+(
+    decompress_Stream_t* streamPtr  ///< [IN] Stream.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    EndDecoder(streamPtr);
+}
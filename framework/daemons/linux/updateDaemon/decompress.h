@@ -0,0 +1,155 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file decompress.h
+ *
+ * Streaming decompressors used by the Update Daemon to unpack update pack payloads.
+ *
+ * The compression format is detected from the first bytes of the stream.  bzip2 is always
+ * supported, since that's what mkapp and mksys produce.  xz and zstd support are optional and are
+ * enabled by building with UPDATE_UNPACK_XZ=1 and UPDATE_UNPACK_ZSTD=1 respectively.
+ * Uncompressed tarballs are passed through as they are.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_DECOMPRESS_H_INCLUDE_GUARD
+#define LEGATO_DECOMPRESS_H_INCLUDE_GUARD
+
+#include <bzlib.h>
+
+#if UPDATE_UNPACK_XZ
+#include <lzma.h>
+#endif
+
+#if UPDATE_UNPACK_ZSTD
+#include <zstd.h>
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of bytes at the start of a stream that are needed to reliably detect its format.
+ * Fewer bytes may be given to decompress_Open() if the stream is shorter than that.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DECOMPRESS_DETECT_BYTES  265
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compression formats.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    DECOMPRESS_NONE,        ///< Not compressed (plain tarball).
+    DECOMPRESS_BZIP2,       ///< bzip2.
+    DECOMPRESS_XZ,          ///< xz (LZMA2).
+    DECOMPRESS_ZSTD,        ///< Zstandard.
+}
+decompress_Format_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * State of a decompression stream.  Treat as opaque.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    decompress_Format_t format;     ///< Format of the stream.
+    bool isEnd;                     ///< true if the end of a compressed stream was reached.
+    union
+    {
+        bz_stream bz;               ///< bzip2 decoder state.
+#if UPDATE_UNPACK_XZ
+        lzma_stream xz;             ///< xz decoder state.
+#endif
+#if UPDATE_UNPACK_ZSTD
+        ZSTD_DStream* zstdPtr;      ///< zstd decoder state.
+#endif
+    }
+    u;
+}
+decompress_Stream_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Detect the format of a stream from its first bytes and set up a decoder for it.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_UNSUPPORTED if the format is not recognized or its support is not built in.
+ *      - LE_FAULT if the decoder could not be initialized.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t decompress_Open
+(
+    decompress_Stream_t* streamPtr, ///< [OUT] Stream to initialize.
+    const uint8_t* headPtr,         ///< [IN] First bytes of the stream.
+    size_t headLen                  ///< [IN] Number of bytes at headPtr.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a printable name for the format of a stream.
+ */
+//--------------------------------------------------------------------------------------------------
+const char* decompress_GetName
+(
+    const decompress_Stream_t* streamPtr    ///< [IN] Stream.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decompress as much of the input as will fit in the output buffer.
+ *
+ * The input pointer and length are advanced past the bytes consumed.  Concatenated compressed
+ * streams (as produced by parallel compressors like pbzip2 or pixz) are decoded one after the
+ * other.  Decoders may hold back output, so at the end of the input this must be called (with no
+ * input) until it returns no output.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FAULT if the input is corrupted.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t decompress_Run
+(
+    decompress_Stream_t* streamPtr, ///< [IN] Stream.
+    const uint8_t** inPtrPtr,       ///< [IN,OUT] Input bytes.
+    size_t* inLenPtr,               ///< [IN,OUT] Number of input bytes.
+    uint8_t* outPtr,                ///< [OUT] Output buffer.
+    size_t* outLenPtr               ///< [IN,OUT] Output buffer size in, number of bytes out.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether the input ended cleanly, at the end of a compressed stream.
+ *
+ * @return true if the stream is complete.
+ */
+//--------------------------------------------------------------------------------------------------
+bool decompress_IsComplete
+(
+    const decompress_Stream_t* streamPtr    ///< [IN] Stream.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the resources held by a stream's decoder.
+ */
+//--------------------------------------------------------------------------------------------------
+void decompress_Close
+(
+    decompress_Stream_t* streamPtr  ///< [IN] Stream.
+);
+
+
+#endif // LEGATO_DECOMPRESS_H_INCLUDE_GUARD
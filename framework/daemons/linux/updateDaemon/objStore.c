@@ -0,0 +1,313 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file objStore.c
+ *
+ * Content-addressed store of the files bundled in installed apps.
+ *
+ * Objects live in <store>/<app name>/<sha256>-<mode>, where mode is the file's permissions in
+ * octal.  An object is just another hard link to the same inode as the app files that share it,
+ * so an object that only has one link left is not used by any app and can be removed.
+ *
+ * The link and add functions are called on the unpacker's extraction thread, while the other
+ * functions are called on the main thread between extractions.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "objStore.h"
+#include <fts.h>
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Directory of the store.
+ */
+//--------------------------------------------------------------------------------------------------
+static char StoreDir[PATH_MAX] = OBJSTORE_DIR;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Counters since they were last taken.
+ */
+//--------------------------------------------------------------------------------------------------
+static objStore_Stats_t Stats;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a file with given permissions can be shared between apps.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsShareable
+(
+    mode_t mode
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return ((mode & (S_IWGRP | S_IWOTH)) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the path of an object.
+ *
+ * @return LE_OK if successful, LE_OVERFLOW if the path doesn't fit.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetObjectPath
+(
+    const char* scopePtr,
+    const uint8_t* digestPtr,
+    mode_t mode,
+    char* objPath               ///< [OUT] PATH_MAX bytes.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char digestStr[OBJSTORE_DIGEST_BYTES * 2 + 1];
+
+    LE_ASSERT(le_hex_BinaryToString(digestPtr, OBJSTORE_DIGEST_BYTES, digestStr, sizeof(digestStr))
+              == OBJSTORE_DIGEST_BYTES * 2);
+
+    if (snprintf(objPath, PATH_MAX, "%s/%s/%s-%04o", StoreDir, scopePtr, digestStr,
+                 (unsigned int)(mode & 07777)) >= PATH_MAX)
+    {
+        return LE_OVERFLOW;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the object store.
+ */
+//--------------------------------------------------------------------------------------------------
+void objStore_Init
+(
+    const char* dirPath     ///< [IN] Directory of the store (normally OBJSTORE_DIR).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(le_utf8_Copy(StoreDir, dirPath, sizeof(StoreDir), NULL) == LE_OK);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the path of the object store directory.
+ */
+//--------------------------------------------------------------------------------------------------
+const char* objStore_GetDir
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return StoreDir;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a file as a link to an object, if the object is in the store.
+ *
+ * @return
+ *      - LE_OK if the file was linked.
+ *      - LE_NOT_FOUND if there's no such object (or it can't be shared, or it is no longer a
+ *        regular file with the given permissions), so the file must be written.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t objStore_Link
+(
+    const char* scopePtr,       ///< [IN] Scope of the object (app name).
+    const uint8_t* digestPtr,   ///< [IN] OBJSTORE_DIGEST_BYTES bytes of digest of the contents.
+    mode_t mode,                ///< [IN] Permissions of the file.
+    const char* path            ///< [IN] Path of the file to create.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char objPath[PATH_MAX];
+    struct stat objStat;
+
+    // The object must still be a regular file with the permissions its name says, as the link
+    // shares its inode (and so its type and mode) with the new file.
+    if (   !IsShareable(mode)
+        || (GetObjectPath(scopePtr, digestPtr, mode, objPath) != LE_OK)
+        || (lstat(objPath, &objStat) != 0)
+        || !S_ISREG(objStat.st_mode)
+        || ((objStat.st_mode & 07777) != (mode & 07777)))
+    {
+        return LE_NOT_FOUND;
+    }
+
+    if ((link(objPath, path) != 0) && ((errno != EEXIST) || (unlink(path) != 0)
+                                       || (link(objPath, path) != 0)))
+    {
+        // E.g., too many links.  Just write the file.
+        LE_DEBUG("Could not link '%s' to '%s' (%m).", path, objPath);
+        return LE_NOT_FOUND;
+    }
+
+    Stats.linkedFiles++;
+    Stats.linkedBytes += objStat.st_size;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a file that was just written to the store.  If the object is in the store already, the file
+ * is replaced by a link to it.
+ *
+ * Failing to add a file is not an error; the file just won't be shared.
+ */
+//--------------------------------------------------------------------------------------------------
+void objStore_Add
+(
+    const char* scopePtr,       ///< [IN] Scope of the object (app name).
+    const uint8_t* digestPtr,   ///< [IN] OBJSTORE_DIGEST_BYTES bytes of digest of the contents.
+    const char* path            ///< [IN] Path of the file.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char objPath[PATH_MAX];
+    struct stat fileStat;
+
+    if (   (lstat(path, &fileStat) != 0)
+        || !S_ISREG(fileStat.st_mode)
+        || !IsShareable(fileStat.st_mode)
+        || (GetObjectPath(scopePtr, digestPtr, fileStat.st_mode, objPath) != LE_OK))
+    {
+        return;
+    }
+
+    if (link(path, objPath) == 0)
+    {
+        Stats.addedFiles++;
+        return;
+    }
+
+    if (errno == ENOENT)
+    {
+        // First object of this scope.
+        char scopePath[PATH_MAX];
+
+        LE_ASSERT(snprintf(scopePath, sizeof(scopePath), "%s/%s", StoreDir, scopePtr)
+                  < sizeof(scopePath));
+
+        if (   (le_dir_MakePath(scopePath, S_IRWXU) == LE_OK)
+            && (link(path, objPath) == 0))
+        {
+            Stats.addedFiles++;
+            return;
+        }
+    }
+
+    if (errno != EEXIST)
+    {
+        LE_WARN("Could not add '%s' to the object store (%m).", path);
+        return;
+    }
+
+    // Already stored: swap the new file for a link to the object.
+    char tmpPath[PATH_MAX];
+
+    if (   (snprintf(tmpPath, sizeof(tmpPath), "%s.objStore", path) >= sizeof(tmpPath))
+        || (link(objPath, tmpPath) != 0))
+    {
+        return;
+    }
+
+    if (rename(tmpPath, path) != 0)
+    {
+        LE_WARN("Could not replace '%s' (%m).", path);
+        unlink(tmpPath);
+        return;
+    }
+
+    Stats.sharedFiles++;
+    Stats.sharedBytes += fileStat.st_size;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove objects that no installed app links to anymore.
+ */
+//--------------------------------------------------------------------------------------------------
+void objStore_Collect
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char* pathArrayPtr[] = { StoreDir, NULL };
+    size_t removedCount = 0;
+
+    FTS* ftsPtr = fts_open(pathArrayPtr, FTS_PHYSICAL, NULL);
+    if (ftsPtr == NULL)
+    {
+        return;
+    }
+
+    FTSENT* entPtr;
+    while ((entPtr = fts_read(ftsPtr)) != NULL)
+    {
+        switch (entPtr->fts_info)
+        {
+            case FTS_F:
+                if (entPtr->fts_statp->st_nlink == 1)
+                {
+                    if (unlink(entPtr->fts_accpath) == 0)
+                    {
+                        removedCount++;
+                    }
+                    else
+                    {
+                        LE_ERROR("Unable to remove '%s' (%m).", entPtr->fts_path);
+                    }
+                }
+                break;
+
+            case FTS_DP:
+                // Remove scopes that are empty now (fails harmlessly if not empty).
+                if (entPtr->fts_level == 1)
+                {
+                    rmdir(entPtr->fts_accpath);
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    fts_close(ftsPtr);
+
+    if (removedCount > 0)
+    {
+        LE_INFO("Removed %zu unused objects from the object store.", removedCount);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the counters and reset them.
+ */
+//--------------------------------------------------------------------------------------------------
+void objStore_TakeStats
+(
+    objStore_Stats_t* statsPtr  ///< [OUT] Counters since the last call.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    *statsPtr = Stats;
+    memset(&Stats, 0, sizeof(Stats));
+}
@@ -0,0 +1,133 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file objStore.h
+ *
+ * Content-addressed store of the files bundled in installed apps.
+ *
+ * Files of installed apps are hard links to objects in the store, named after the SHA-256 of their
+ * contents and their permissions.  When an app is unpacked, files whose object is already in the
+ * store are linked instead of being written again, so files that don't change from one version of
+ * an app to the next are only ever stored once.
+ *
+ * Objects are scoped by app name, because all the links to an object share its SMACK label and
+ * IMA signature.  Only files that are not writable by group or other are shared.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_OBJ_STORE_H_INCLUDE_GUARD
+#define LEGATO_OBJ_STORE_H_INCLUDE_GUARD
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default location of the object store.  Must be on the same file system as /legato/apps.
+ */
+//--------------------------------------------------------------------------------------------------
+#define OBJSTORE_DIR    "/legato/apps/objects"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the digests that identify objects (SHA-256).
+ */
+//--------------------------------------------------------------------------------------------------
+#define OBJSTORE_DIGEST_BYTES   32
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Counters of what the store saved.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    size_t linkedFiles;     ///< Number of files linked from the store instead of being written.
+    uint64_t linkedBytes;   ///< Bytes that didn't have to be written.
+    size_t sharedFiles;     ///< Number of files written but then found to be in the store.
+    uint64_t sharedBytes;   ///< Bytes of storage saved by those files.
+    size_t addedFiles;      ///< Number of new objects added to the store.
+}
+objStore_Stats_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the object store.
+ */
+//--------------------------------------------------------------------------------------------------
+void objStore_Init
+(
+    const char* dirPath     ///< [IN] Directory of the store (normally OBJSTORE_DIR).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the path of the object store directory.
+ */
+//--------------------------------------------------------------------------------------------------
+const char* objStore_GetDir
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a file as a link to an object, if the object is in the store.
+ *
+ * @return
+ *      - LE_OK if the file was linked.
+ *      - LE_NOT_FOUND if there's no such object (or it can't be shared, or it is no longer a
+ *        regular file with the given permissions), so the file must be written.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t objStore_Link
+(
+    const char* scopePtr,       ///< [IN] Scope of the object (app name).
+    const uint8_t* digestPtr,   ///< [IN] OBJSTORE_DIGEST_BYTES bytes of digest of the contents.
+    mode_t mode,                ///< [IN] Permissions of the file.
+    const char* path            ///< [IN] Path of the file to create.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a file that was just written to the store.  If the object is in the store already, the file
+ * is replaced by a link to it.
+ *
+ * Failing to add a file is not an error; the file just won't be shared.
+ */
+//--------------------------------------------------------------------------------------------------
+void objStore_Add
+(
+    const char* scopePtr,       ///< [IN] Scope of the object (app name).
+    const uint8_t* digestPtr,   ///< [IN] OBJSTORE_DIGEST_BYTES bytes of digest of the contents.
+    const char* path            ///< [IN] Path of the file.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove objects that no installed app links to anymore.
+ */
+//--------------------------------------------------------------------------------------------------
+void objStore_Collect
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the counters and reset them.
+ */
+//--------------------------------------------------------------------------------------------------
+void objStore_TakeStats
+(
+    objStore_Stats_t* statsPtr  ///< [OUT] Counters since the last call.
+);
+
+
+#endif // LEGATO_OBJ_STORE_H_INCLUDE_GUARD
@@ -19,6 +19,7 @@
 #include "supCtrl.h"
 #include "file.h"
 #include "system.h"
+#include "objStore.h"
 #include "installer.h"
 #include "sysPaths.h"
 #include "sysStatus.h"
@@ -1063,7 +1064,11 @@ void system_RemoveUnusedApps
             {
                 char* foundHashPtr = le_path_GetBasenamePtr(entPtr->fts_path, "/");
 
-                if (!system_AppUsedInAnySystem(foundHashPtr))
+                if (strcmp(entPtr->fts_path, objStore_GetDir()) == 0)
+                {
+                    // The object store is cleaned up below, once the apps are gone.
+                }
+                else if (!system_AppUsedInAnySystem(foundHashPtr))
                 {
                     LE_INFO("Removing unused app with MD5 sum %s.", foundHashPtr);
 
@@ -1088,6 +1093,9 @@ void system_RemoveUnusedApps
     }
 
     fts_close(ftsPtr);
+
+    // Drop the objects that were only used by the apps just removed.
+    objStore_Collect();
 }
 
 
@@ -0,0 +1,1859 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file untar.c
+ *
+ * In-process streaming tarball extractor used by the Update Unpacker.
+ *
+ * The payload flows through three stages, each on its own thread:
+ *
+ *  - The Update Unpacker (main thread) copies the payload from the update pack into a pipe and
+ *    reports progress, as it always did.
+ *  - The decompression thread reads the pipe, detects the compression format and decompresses
+ *    the stream into a small ring of chunk buffers.
+ *  - The extraction thread parses the tar entries out of the chunks and writes the files, hashing
+ *    their contents as they go by.  Small files can be provided by the caller (e.g., from the
+ *    object store) once their digest is known, in which case they are never written.
+ *
+ * If something goes wrong, both threads stop doing real work but keep draining their input, so
+ * that the stage before them never blocks.  The result is reported once the end of the input has
+ * been reached.
+ *
+ * Like "bsdtar xmop", which this replaces, file permissions are restored, but ownership and
+ * modification times are not.  Entries that would end up outside of the destination directory are
+ * refused: their names can't climb up the tree, they can't go through a symbolic link (which an
+ * earlier entry could have pointed anywhere), and symbolic links can only point inside the
+ * destination directory, or under a directory given by the caller if they are absolute.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "untar.h"
+#include "decompress.h"
+#include "fileDescriptor.h"
+#include <openssl/evp.h>
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the buffers used to read the input and to pass decompressed data between the threads.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CHUNK_BYTES         (64 * 1024)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of decompressed chunks that can be waiting for the extraction thread.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NUM_CHUNKS          4
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Largest file held in memory until its digest is known, when there is a link handler.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LINK_BUFFER_BYTES   (256 * 1024)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of a tar block.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BLOCK_BYTES         512
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Largest GNU long name or pax extended header accepted.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_META_BYTES      (16 * 1024)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header of a tar entry (POSIX ustar layout, which GNU tar also follows).
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char name[100];
+    char mode[8];
+    char uid[8];
+    char gid[8];
+    char size[12];
+    char mtime[12];
+    char checksum[8];
+    char typeflag;
+    char linkname[100];
+    char magic[6];
+    char version[2];
+    char uname[32];
+    char gname[32];
+    char devmajor[8];
+    char devminor[8];
+    char prefix[155];
+    char padding[12];
+}
+TarHeader_t;
+
+_Static_assert(sizeof(TarHeader_t) == BLOCK_BYTES, "Bad tar header layout");
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Chunk of decompressed data on its way to the extraction thread.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    size_t len;                     ///< Number of bytes in data[].
+    bool isLast;                    ///< true if this is the last chunk of the stream.
+    uint8_t data[CHUNK_BYTES];      ///< Decompressed bytes.
+}
+Chunk_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Directory whose permissions must be set once everything has been extracted, because they don't
+ * allow the owner to create entries in it.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_sls_Link_t link;             ///< Link in the extraction's list of fixups.
+    mode_t mode;                    ///< Permissions to set.
+    char path[PATH_MAX];            ///< Path of the directory.
+}
+DirFixup_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * State of the tar parser.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    TAR_HEADER,                     ///< Reading an entry header.
+    TAR_DATA,                       ///< Writing the contents of a regular file.
+    TAR_META,                       ///< Reading a GNU long name or a pax extended header.
+    TAR_SKIP,                       ///< Skipping over padding or unwanted data.
+    TAR_END,                        ///< End of archive reached.
+}
+TarState_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * An extraction.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct untar_Extraction
+{
+    char dirPath[PATH_MAX];             ///< Directory to extract into.
+    char linkRootPath[PATH_MAX];        ///< Where absolute symlinks can point ("" for nowhere).
+    untar_DoneHandler_t doneHandler;    ///< Completion callback.
+    untar_LinkHandler_t linkHandler;    ///< Callback to provide files without writing them.
+    untar_FileHandler_t fileHandler;    ///< Per-file callback (can be NULL).
+    void* contextPtr;                   ///< Context pointer for the callbacks.
+    le_thread_Ref_t callerThread;       ///< Thread to call the completion callback on.
+    le_thread_Ref_t decompressThread;   ///< Decompression thread.
+    le_thread_Ref_t extractThread;      ///< Extraction thread.
+    bool isDeleted;                     ///< true once untar_Delete() has been called.
+    bool isFailed;                      ///< true once either thread has failed.
+
+    // Decompression thread's state.
+    int inputFd;                        ///< Read end of the input pipe.
+    decompress_Stream_t stream;         ///< Decompression stream.
+    le_result_t decompressResult;       ///< Result of decompression.
+    size_t writeIndex;                  ///< Index of the next chunk to fill.
+    uint8_t inBuf[CHUNK_BYTES];         ///< Compressed input buffer.
+
+    // Chunks passed from the decompression thread to the extraction thread.
+    Chunk_t chunks[NUM_CHUNKS];         ///< Ring of chunks.
+    le_sem_Ref_t freeSem;               ///< Counts chunks available to the decompression thread.
+    le_sem_Ref_t fullSem;               ///< Counts chunks available to the extraction thread.
+
+    // Extraction thread's state.
+    le_result_t extractResult;          ///< Result of extraction.
+    size_t readIndex;                   ///< Index of the next chunk to extract.
+    TarState_t state;                   ///< Parser state.
+    uint8_t header[BLOCK_BYTES];        ///< Header being read.
+    size_t headerLen;                   ///< Number of bytes in header[].
+    int zeroBlocks;                     ///< Number of consecutive zero blocks seen.
+    uint64_t remaining;                 ///< Bytes left in the current data, metadata or skip.
+    size_t padding;                     ///< Bytes of padding after the current data or metadata.
+    char metaType;                      ///< Type flag of the metadata being read.
+    char metaBuf[MAX_META_BYTES + 1];   ///< Metadata being read.
+    size_t metaLen;                     ///< Number of bytes in metaBuf[].
+    char longPath[PATH_MAX];            ///< Path of the next entry, from metadata ("" if none).
+    char longLink[PATH_MAX];            ///< Link target of the next entry, from metadata.
+    bool hasLongSize;                   ///< true if the next entry's size came from metadata.
+    uint64_t longSize;                  ///< Size of the next entry, from metadata.
+    int fileFd;                         ///< File being written (-1 if none).
+    bool isBuffered;                    ///< true if the file is being held in fileBuf[].
+    size_t fileBufLen;                  ///< Number of bytes in fileBuf[].
+    uint8_t fileBuf[LINK_BUFFER_BYTES]; ///< Contents of a small file, until its digest is known.
+    mode_t fileMode;                    ///< Permissions of the file being written.
+    char filePath[PATH_MAX];            ///< Path of the file being written.
+    EVP_MD_CTX* digestCtxPtr;           ///< Digest of the file being written.
+    le_sls_List_t dirFixups;            ///< Directory permissions to set at the end.
+    size_t fileCount;                   ///< Number of regular files extracted.
+    uint64_t byteCount;                 ///< Number of bytes of tarball extracted.
+}
+Extraction_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of extractions.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t ExtractionPool = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of directory permission fixups.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t DirFixupPool = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mark the extraction as failed, so that both threads stop working.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetFailed
+(
+    Extraction_t* extractionPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    __atomic_store_n(&extractionPtr->isFailed, true, __ATOMIC_RELAXED);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether the extraction has failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsFailed
+(
+    Extraction_t* extractionPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return __atomic_load_n(&extractionPtr->isFailed, __ATOMIC_RELAXED);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the next empty chunk, waiting for the extraction thread to free one if necessary.
+ */
+//--------------------------------------------------------------------------------------------------
+static Chunk_t* GetFreeChunk
+(
+    Extraction_t* extractionPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_sem_Wait(extractionPtr->freeSem);
+
+    Chunk_t* chunkPtr = &extractionPtr->chunks[extractionPtr->writeIndex];
+    extractionPtr->writeIndex = (extractionPtr->writeIndex + 1) % NUM_CHUNKS;
+
+    chunkPtr->len = 0;
+    chunkPtr->isLast = false;
+
+    return chunkPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pass a filled chunk on to the extraction thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendChunk
+(
+    Extraction_t* extractionPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_sem_Post(extractionPtr->fullSem);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read from the input pipe.
+ *
+ * @return Number of bytes read (0 at end of input), or -1 on error.
+ */
+//--------------------------------------------------------------------------------------------------
+static ssize_t ReadInput
+(
+    Extraction_t* extractionPtr,
+    uint8_t* bufPtr,
+    size_t bufSize
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ssize_t readResult;
+
+    do
+    {
+        readResult = read(extractionPtr->inputFd, bufPtr, bufSize);
+    }
+    while ((readResult == -1) && (errno == EINTR));
+
+    if (readResult == -1)
+    {
+        LE_ERROR("Failed to read payload (%m).");
+    }
+
+    return readResult;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decompress a buffer of input into chunks, passing the full ones on to the extraction thread.
+ *
+ * At the end of the input, this is called with no input to flush the decoder.
+ *
+ * @return LE_OK if successful, LE_FORMAT_ERROR if the input is corrupted.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t DecompressInput
+(
+    Extraction_t* extractionPtr,
+    const uint8_t* inPtr,
+    size_t inLen,
+    bool isEof,
+    Chunk_t** chunkPtrPtr           ///< [IN,OUT] Chunk being filled.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    for (;;)
+    {
+        Chunk_t* chunkPtr = *chunkPtrPtr;
+        size_t inLenBefore = inLen;
+        size_t outLen = CHUNK_BYTES - chunkPtr->len;
+
+        if (decompress_Run(&extractionPtr->stream,
+                           &inPtr,
+                           &inLen,
+                           chunkPtr->data + chunkPtr->len,
+                           &outLen) != LE_OK)
+        {
+            return LE_FORMAT_ERROR;
+        }
+
+        chunkPtr->len += outLen;
+
+        if (chunkPtr->len == CHUNK_BYTES)
+        {
+            SendChunk(extractionPtr);
+            *chunkPtrPtr = GetFreeChunk(extractionPtr);
+        }
+        else if ((outLen == 0) && (inLen == inLenBefore))
+        {
+            // Nothing more can be done with this input.
+            return LE_OK;
+        }
+
+        if ((inLen == 0) && !isEof)
+        {
+            return LE_OK;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main function of the decompression thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* DecompressThreadMain
+(
+    void* contextPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Extraction_t* extractionPtr = contextPtr;
+    le_result_t result = LE_OK;
+    bool isOpen = false;
+    bool isEof = false;
+    size_t inLen = 0;
+    ssize_t readResult;
+
+    // Gather enough bytes to detect the compression format.
+    while ((inLen < DECOMPRESS_DETECT_BYTES) && !isEof)
+    {
+        readResult = ReadInput(extractionPtr,
+                               extractionPtr->inBuf + inLen,
+                               sizeof(extractionPtr->inBuf) - inLen);
+        if (readResult < 0)
+        {
+            result = LE_FAULT;
+            isEof = true;
+        }
+        else if (readResult == 0)
+        {
+            isEof = true;
+        }
+        else
+        {
+            inLen += readResult;
+        }
+    }
+
+    if (result == LE_OK)
+    {
+        result = decompress_Open(&extractionPtr->stream, extractionPtr->inBuf, inLen);
+
+        if (result == LE_OK)
+        {
+            isOpen = true;
+            LE_INFO("Unpacking %s payload.", decompress_GetName(&extractionPtr->stream));
+        }
+        else if (result == LE_UNSUPPORTED)
+        {
+            result = LE_FORMAT_ERROR;
+        }
+    }
+
+    Chunk_t* chunkPtr = GetFreeChunk(extractionPtr);
+
+    for (;;)
+    {
+        if ((result == LE_OK) && IsFailed(extractionPtr))
+        {
+            // The extraction thread gave up, so just drain the input.
+            result = LE_FAULT;
+        }
+
+        if (result == LE_OK)
+        {
+            result = DecompressInput(extractionPtr, extractionPtr->inBuf, inLen, isEof, &chunkPtr);
+        }
+
+        if (isEof)
+        {
+            break;
+        }
+
+        readResult = ReadInput(extractionPtr, extractionPtr->inBuf, sizeof(extractionPtr->inBuf));
+        if (readResult < 0)
+        {
+            result = LE_FAULT;
+            break;
+        }
+        isEof = (readResult == 0);
+        inLen = readResult;
+    }
+
+    if ((result == LE_OK) && !decompress_IsComplete(&extractionPtr->stream))
+    {
+        LE_ERROR("Payload is truncated.");
+        result = LE_FORMAT_ERROR;
+    }
+
+    if (isOpen)
+    {
+        decompress_Close(&extractionPtr->stream);
+    }
+
+    fd_Close(extractionPtr->inputFd);
+    extractionPtr->inputFd = -1;
+
+    if (result != LE_OK)
+    {
+        SetFailed(extractionPtr);
+    }
+
+    // The semaphore makes this visible to the extraction thread along with the last chunk.
+    extractionPtr->decompressResult = result;
+    chunkPtr->isLast = true;
+    SendChunk(extractionPtr);
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a numeric field of a tar header (octal, or base-256 for large values).
+ *
+ * @return LE_OK if successful, LE_FORMAT_ERROR if the field is not a valid number.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ParseNumber
+(
+    const char* fieldPtr,
+    size_t fieldSize,
+    uint64_t* valuePtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const uint8_t* bytePtr = (const uint8_t*)fieldPtr;
+    uint64_t value = 0;
+    size_t i = 0;
+
+    if (bytePtr[0] & 0x80)
+    {
+        value = bytePtr[0] & 0x3F;
+        for (i = 1; i < fieldSize; i++)
+        {
+            value = (value << 8) | bytePtr[i];
+        }
+        *valuePtr = value;
+        return LE_OK;
+    }
+
+    while ((i < fieldSize) && (fieldPtr[i] == ' '))
+    {
+        i++;
+    }
+
+    for (; (i < fieldSize) && (fieldPtr[i] != '\0') && (fieldPtr[i] != ' '); i++)
+    {
+        if ((fieldPtr[i] < '0') || (fieldPtr[i] > '7'))
+        {
+            return LE_FORMAT_ERROR;
+        }
+        value = (value << 3) | (fieldPtr[i] - '0');
+    }
+
+    *valuePtr = value;
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check a tar header's checksum.
+ *
+ * @return true if the checksum is valid.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsChecksumValid
+(
+    const uint8_t* blockPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const TarHeader_t* headerPtr = (const TarHeader_t*)blockPtr;
+    size_t checksumOffset = offsetof(TarHeader_t, checksum);
+    uint64_t expected;
+    uint64_t unsignedSum = 0;
+    int64_t signedSum = 0;
+    size_t i;
+
+    if (ParseNumber(headerPtr->checksum, sizeof(headerPtr->checksum), &expected) != LE_OK)
+    {
+        return false;
+    }
+
+    for (i = 0; i < BLOCK_BYTES; i++)
+    {
+        uint8_t byte = blockPtr[i];
+
+        // The checksum field itself counts as spaces.
+        if ((i >= checksumOffset) && (i < checksumOffset + sizeof(headerPtr->checksum)))
+        {
+            byte = ' ';
+        }
+        unsignedSum += byte;
+        signedSum += (int8_t)byte;
+    }
+
+    // Some old tar implementations used signed chars.
+    return (expected == unsignedSum) || ((int64_t)expected == signedSum);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a block is all zeros.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsZeroBlock
+(
+    const uint8_t* blockPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t i;
+
+    for (i = 0; i < BLOCK_BYTES; i++)
+    {
+        if (blockPtr[i] != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a path has a ".." component.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool HasDotDot
+(
+    const char* pathPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const char* componentPtr = pathPtr;
+
+    while (componentPtr != NULL)
+    {
+        while (*componentPtr == '/')
+        {
+            componentPtr++;
+        }
+        if (   (strncmp(componentPtr, "..", 2) == 0)
+            && ((componentPtr[2] == '/') || (componentPtr[2] == '\0')))
+        {
+            return true;
+        }
+        componentPtr = strchr(componentPtr, '/');
+    }
+
+    return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that none of the directories that a path goes through below the destination directory is
+ * a symbolic link.  Directories that don't exist yet will be created as real directories.
+ *
+ * @return LE_OK if so, LE_FORMAT_ERROR otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CheckParents
+(
+    Extraction_t* extractionPtr,
+    const char* path                ///< Path in the destination directory.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char parentPath[PATH_MAX];
+    struct stat st;
+
+    LE_ASSERT(le_utf8_Copy(parentPath, path, sizeof(parentPath), NULL) == LE_OK);
+
+    char* slashPtr = strchr(parentPath + strlen(extractionPtr->dirPath) + 1, '/');
+
+    while (slashPtr != NULL)
+    {
+        *slashPtr = '\0';
+
+        if (lstat(parentPath, &st) != 0)
+        {
+            // Nothing further down exists yet (or the entry will fail to be created anyway).
+            return LE_OK;
+        }
+        if (S_ISLNK(st.st_mode))
+        {
+            LE_ERROR("Refusing to extract '%s' through symlink '%s'.", path, parentPath);
+            return LE_FORMAT_ERROR;
+        }
+
+        *slashPtr = '/';
+        slashPtr = strchr(slashPtr + 1, '/');
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Work out where an entry goes in the destination directory.
+ *
+ * Leading slashes and "./" are stripped, like tar does.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_NOT_FOUND if the entry is the destination directory itself.
+ *      - LE_FORMAT_ERROR if the entry would end up outside of the destination directory, or would
+ *        go through a symbolic link.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetDestPath
+(
+    Extraction_t* extractionPtr,
+    const char* namePtr,
+    char* destPath              ///< [OUT] PATH_MAX bytes.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Refuse anything that climbs up the tree.
+    if (HasDotDot(namePtr))
+    {
+        LE_ERROR("Refusing to extract '%s'.", namePtr);
+        return LE_FORMAT_ERROR;
+    }
+
+    for (;;)
+    {
+        if (*namePtr == '/')
+        {
+            namePtr++;
+        }
+        else if ((namePtr[0] == '.') && (namePtr[1] == '/'))
+        {
+            namePtr += 2;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if ((namePtr[0] == '\0') || (strcmp(namePtr, ".") == 0))
+    {
+        return LE_NOT_FOUND;
+    }
+
+    if (snprintf(destPath, PATH_MAX, "%s/%s", extractionPtr->dirPath, namePtr) >= PATH_MAX)
+    {
+        LE_ERROR("Path too long for '%s'.", namePtr);
+        return LE_FORMAT_ERROR;
+    }
+
+    // Drop trailing slashes (from directory entries).
+    size_t len = strlen(destPath);
+    while (destPath[len - 1] == '/')
+    {
+        destPath[--len] = '\0';
+    }
+
+    return CheckParents(extractionPtr, destPath);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create the directory that a path is in, and any missing directories above it.
+ *
+ * @return LE_OK if successful, LE_FAULT otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t MakeParentDir
+(
+    const char* path
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char parentPath[PATH_MAX];
+
+    LE_ASSERT(le_utf8_Copy(parentPath, path, sizeof(parentPath), NULL) == LE_OK);
+
+    char* slashPtr = strrchr(parentPath, '/');
+    if (slashPtr == NULL)
+    {
+        return LE_FAULT;
+    }
+    *slashPtr = '\0';
+
+    return le_dir_MakePath(parentPath, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove whatever non-directory is in the way of a new entry.
+ *
+ * @return LE_OK if successful, LE_FAULT otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ClearPath
+(
+    const char* path
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if ((unlink(path) != 0) && (errno != ENOENT))
+    {
+        LE_ERROR("Failed to replace '%s' (%m).", path);
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a directory entry.
+ *
+ * @return LE_OK if successful, LE_FAULT otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t MakeDir
+(
+    Extraction_t* extractionPtr,
+    const char* path,
+    mode_t mode
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int mkdirResult = mkdir(path, S_IRWXU);
+
+    if ((mkdirResult != 0) && (errno == ENOENT) && (MakeParentDir(path) == LE_OK))
+    {
+        mkdirResult = mkdir(path, S_IRWXU);
+    }
+
+    if (mkdirResult != 0)
+    {
+        struct stat st;
+
+        // An existing directory is fine, but not a symlink to one.
+        if ((errno != EEXIST) || (lstat(path, &st) != 0) || !S_ISDIR(st.st_mode))
+        {
+            LE_ERROR("Failed to create directory '%s' (%m).", path);
+            return LE_FAULT;
+        }
+    }
+
+    // Directories that the owner can't write into get their permissions at the very end.
+    if ((mode & S_IRWXU) != S_IRWXU)
+    {
+        DirFixup_t* fixupPtr = le_mem_ForceAlloc(DirFixupPool);
+
+        fixupPtr->link = LE_SLS_LINK_INIT;
+        fixupPtr->mode = mode;
+        LE_ASSERT(le_utf8_Copy(fixupPtr->path, path, sizeof(fixupPtr->path), NULL) == LE_OK);
+        le_sls_Stack(&extractionPtr->dirFixups, &fixupPtr->link);
+        return LE_OK;
+    }
+
+    if (chmod(path, mode) != 0)
+    {
+        LE_ERROR("Failed to set permissions of '%s' (%m).", path);
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check where a symbolic link entry points.  Relative links must stay inside the destination
+ * directory; absolute links must point under the directory where the caller allows them.
+ *
+ * @return LE_OK if the link is allowed, LE_FORMAT_ERROR otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CheckLinkTarget
+(
+    Extraction_t* extractionPtr,
+    const char* path,               ///< Path of the link in the destination directory.
+    const char* targetPath          ///< Where the link points.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (targetPath[0] == '/')
+    {
+        size_t rootLen = strlen(extractionPtr->linkRootPath);
+
+        if (   (rootLen > 0)
+            && (strncmp(targetPath, extractionPtr->linkRootPath, rootLen) == 0)
+            && (targetPath[rootLen] == '/')
+            && !HasDotDot(targetPath))
+        {
+            return LE_OK;
+        }
+    }
+    else
+    {
+        // Depth of the directory the link is in, below the destination directory: the last
+        // component is the link itself.
+        int depth = -1;
+        const char* componentPtr = path + strlen(extractionPtr->dirPath) + 1;
+
+        for (;;)
+        {
+            const char* endPtr = strchrnul(componentPtr, '/');
+            size_t len = endPtr - componentPtr;
+
+            if ((len > 0) && !((len == 1) && (componentPtr[0] == '.')))
+            {
+                depth++;
+            }
+            if (*endPtr == '\0')
+            {
+                break;
+            }
+            componentPtr = endPtr + 1;
+        }
+
+        // Follow the target from there, without ever climbing above the destination directory.
+        // ".." is only allowed before any other component: after one, it would climb from
+        // wherever that component resolves to, which could itself be a symlink.
+        bool isDescending = false;
+        componentPtr = targetPath;
+
+        for (;;)
+        {
+            const char* endPtr = strchrnul(componentPtr, '/');
+            size_t len = endPtr - componentPtr;
+
+            if ((len == 2) && (strncmp(componentPtr, "..", 2) == 0))
+            {
+                depth--;
+                if (isDescending || (depth < 0))
+                {
+                    break;
+                }
+            }
+            else if ((len > 0) && !((len == 1) && (componentPtr[0] == '.')))
+            {
+                isDescending = true;
+            }
+            if (*endPtr == '\0')
+            {
+                return LE_OK;
+            }
+            componentPtr = endPtr + 1;
+        }
+    }
+
+    LE_ERROR("Refusing symlink '%s' -> '%s'.", path, targetPath);
+    return LE_FORMAT_ERROR;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a symbolic link entry.
+ *
+ * @return LE_OK if successful, LE_FAULT or LE_FORMAT_ERROR otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t MakeSymlink
+(
+    Extraction_t* extractionPtr,
+    const char* path,
+    const char* targetPath
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (CheckLinkTarget(extractionPtr, path, targetPath) != LE_OK)
+    {
+        return LE_FORMAT_ERROR;
+    }
+
+    if (ClearPath(path) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    if (symlink(targetPath, path) != 0)
+    {
+        if ((errno == ENOENT) && (MakeParentDir(path) == LE_OK) && (symlink(targetPath, path) == 0))
+        {
+            return LE_OK;
+        }
+        LE_ERROR("Failed to create symlink '%s' -> '%s' (%m).", path, targetPath);
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a hard link entry.
+ *
+ * @return LE_OK if successful, LE_FAULT or LE_FORMAT_ERROR otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t MakeHardLink
+(
+    Extraction_t* extractionPtr,
+    const char* path,
+    const char* linkName
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char targetPath[PATH_MAX];
+
+    le_result_t result = GetDestPath(extractionPtr, linkName, targetPath);
+    if (result != LE_OK)
+    {
+        return LE_FORMAT_ERROR;
+    }
+
+    if (ClearPath(path) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    if (link(targetPath, path) != 0)
+    {
+        if ((errno == ENOENT) && (MakeParentDir(path) == LE_OK) && (link(targetPath, path) == 0))
+        {
+            return LE_OK;
+        }
+        LE_ERROR("Failed to create hard link '%s' -> '%s' (%m).", path, targetPath);
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create the file of the current regular file entry.
+ *
+ * @return LE_OK if successful, LE_FAULT otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CreateFile
+(
+    Extraction_t* extractionPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const char* path = extractionPtr->filePath;
+
+    if (ClearPath(path) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    int flags = O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC;
+    int fd = open(path, flags, S_IRUSR | S_IWUSR);
+
+    if ((fd < 0) && (errno == ENOENT) && (MakeParentDir(path) == LE_OK))
+    {
+        fd = open(path, flags, S_IRUSR | S_IWUSR);
+    }
+
+    if (fd < 0)
+    {
+        LE_ERROR("Failed to create file '%s' (%m).", path);
+        return LE_FAULT;
+    }
+
+    extractionPtr->fileFd = fd;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start a regular file entry.
+ *
+ * If there is a link handler, small files are held in memory until their digest is known, so that
+ * they don't need to be written at all if the link handler can provide them.
+ *
+ * @return LE_OK if successful, LE_FAULT otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t StartFile
+(
+    Extraction_t* extractionPtr,
+    const char* path,
+    mode_t mode,
+    uint64_t size
+)
+//--------------------------------------------------------------------------------------------------
+{
+    extractionPtr->fileMode = mode;
+    LE_ASSERT(le_utf8_Copy(extractionPtr->filePath, path, sizeof(extractionPtr->filePath), NULL)
+              == LE_OK);
+
+    if ((extractionPtr->fileHandler != NULL) || (extractionPtr->linkHandler != NULL))
+    {
+        LE_ASSERT(EVP_DigestInit_ex(extractionPtr->digestCtxPtr, EVP_sha256(), NULL) == 1);
+    }
+
+    extractionPtr->isBuffered = (   (extractionPtr->linkHandler != NULL)
+                                 && (size > 0)
+                                 && (size <= sizeof(extractionPtr->fileBuf)));
+    extractionPtr->fileBufLen = 0;
+
+    if (extractionPtr->isBuffered)
+    {
+        return LE_OK;
+    }
+
+    return CreateFile(extractionPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write some of the contents of the current regular file.
+ *
+ * @return LE_OK if successful, LE_FAULT otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteFile
+(
+    Extraction_t* extractionPtr,
+    const uint8_t* dataPtr,
+    size_t len
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if ((extractionPtr->fileHandler != NULL) || (extractionPtr->linkHandler != NULL))
+    {
+        LE_ASSERT(EVP_DigestUpdate(extractionPtr->digestCtxPtr, dataPtr, len) == 1);
+    }
+
+    if (extractionPtr->isBuffered)
+    {
+        // The size in the header guarantees that this fits.
+        memcpy(extractionPtr->fileBuf + extractionPtr->fileBufLen, dataPtr, len);
+        extractionPtr->fileBufLen += len;
+        return LE_OK;
+    }
+
+    if (fd_WriteSize(extractionPtr->fileFd, (void*)dataPtr, len) != (ssize_t)len)
+    {
+        LE_ERROR("Failed to write file '%s' (%m).", extractionPtr->filePath);
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finish writing the current regular file.
+ *
+ * @return LE_OK if successful, LE_FAULT otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t FinishFile
+(
+    Extraction_t* extractionPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_result_t result = LE_OK;
+    uint8_t digest[UNTAR_DIGEST_BYTES];
+
+    if ((extractionPtr->fileHandler != NULL) || (extractionPtr->linkHandler != NULL))
+    {
+        LE_ASSERT(EVP_DigestFinal_ex(extractionPtr->digestCtxPtr, digest, NULL) == 1);
+    }
+
+    if (extractionPtr->isBuffered)
+    {
+        extractionPtr->isBuffered = false;
+
+        // Maybe the file doesn't need to be written at all.
+        if (   (ClearPath(extractionPtr->filePath) == LE_OK)
+            && (extractionPtr->linkHandler(extractionPtr->filePath,
+                                           digest,
+                                           extractionPtr->fileMode,
+                                           extractionPtr->contextPtr) == LE_OK))
+        {
+            extractionPtr->fileCount++;
+            return LE_OK;
+        }
+
+        result = CreateFile(extractionPtr);
+        if (result == LE_OK)
+        {
+            result = WriteFile(extractionPtr, extractionPtr->fileBuf, extractionPtr->fileBufLen);
+        }
+        if (result != LE_OK)
+        {
+            return result;
+        }
+    }
+
+    int fd = extractionPtr->fileFd;
+
+    extractionPtr->fileFd = -1;
+
+    if (fchmod(fd, extractionPtr->fileMode) != 0)
+    {
+        LE_ERROR("Failed to set permissions of '%s' (%m).", extractionPtr->filePath);
+        result = LE_FAULT;
+    }
+
+    if (close(fd) != 0)
+    {
+        LE_ERROR("Failed to close '%s' (%m).", extractionPtr->filePath);
+        result = LE_FAULT;
+    }
+
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    extractionPtr->fileCount++;
+
+    if (extractionPtr->fileHandler != NULL)
+    {
+        result = extractionPtr->fileHandler(extractionPtr->filePath,
+                                            digest,
+                                            extractionPtr->contextPtr);
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Skip a number of bytes of the tarball, then expect a header.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartSkip
+(
+    Extraction_t* extractionPtr,
+    uint64_t count
+)
+//--------------------------------------------------------------------------------------------------
+{
+    extractionPtr->remaining = count;
+    extractionPtr->state = (count == 0) ? TAR_HEADER : TAR_SKIP;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy a metadata value into a path buffer.
+ *
+ * @return LE_OK if successful, LE_FORMAT_ERROR if it doesn't fit.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CopyMetaPath
+(
+    char* destPtr,              ///< [OUT] PATH_MAX bytes.
+    const char* valuePtr,
+    size_t valueLen
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (valueLen >= PATH_MAX)
+    {
+        LE_ERROR("Path in tar metadata is too long.");
+        return LE_FORMAT_ERROR;
+    }
+
+    memcpy(destPtr, valuePtr, valueLen);
+    destPtr[valueLen] = '\0';
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Apply the GNU long name or pax extended header that was just read to the next entry.
+ *
+ * @return LE_OK if successful, LE_FORMAT_ERROR if the metadata is not valid.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ProcessMeta
+(
+    Extraction_t* extractionPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char* bufPtr = extractionPtr->metaBuf;
+    size_t len = extractionPtr->metaLen;
+
+    bufPtr[len] = '\0';
+
+    switch (extractionPtr->metaType)
+    {
+        case 'L':
+            return CopyMetaPath(extractionPtr->longPath, bufPtr, strlen(bufPtr));
+
+        case 'K':
+            return CopyMetaPath(extractionPtr->longLink, bufPtr, strlen(bufPtr));
+
+        default:
+            break;
+    }
+
+    // pax records look like "<length> <key>=<value>\n", where length covers the whole record.
+    size_t pos = 0;
+
+    while (pos < len)
+    {
+        char* recordPtr = bufPtr + pos;
+        char* endPtr;
+        unsigned long recordLen = strtoul(recordPtr, &endPtr, 10);
+
+        if ((recordLen == 0) || (recordLen > len - pos) || (*endPtr != ' ')
+            || (recordPtr[recordLen - 1] != '\n'))
+        {
+            LE_ERROR("Malformed pax extended header.");
+            return LE_FORMAT_ERROR;
+        }
+
+        char* keyPtr = endPtr + 1;
+        char* valuePtr = memchr(keyPtr, '=', recordPtr + recordLen - keyPtr);
+        if (valuePtr == NULL)
+        {
+            LE_ERROR("Malformed pax extended header.");
+            return LE_FORMAT_ERROR;
+        }
+        size_t keyLen = valuePtr - keyPtr;
+        valuePtr++;
+        size_t valueLen = recordPtr + recordLen - 1 - valuePtr;
+
+        le_result_t result = LE_OK;
+
+        if ((keyLen == 4) && (strncmp(keyPtr, "path", keyLen) == 0))
+        {
+            result = CopyMetaPath(extractionPtr->longPath, valuePtr, valueLen);
+        }
+        else if ((keyLen == 8) && (strncmp(keyPtr, "linkpath", keyLen) == 0))
+        {
+            result = CopyMetaPath(extractionPtr->longLink, valuePtr, valueLen);
+        }
+        else if ((keyLen == 4) && (strncmp(keyPtr, "size", keyLen) == 0))
+        {
+            extractionPtr->longSize = strtoull(valuePtr, NULL, 10);
+            extractionPtr->hasLongSize = true;
+        }
+
+        if (result != LE_OK)
+        {
+            return result;
+        }
+
+        pos += recordLen;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Act on the header that was just read.
+ *
+ * @return LE_OK if successful, LE_FORMAT_ERROR or LE_FAULT otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ProcessHeader
+(
+    Extraction_t* extractionPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const TarHeader_t* headerPtr = (const TarHeader_t*)extractionPtr->header;
+    uint64_t size;
+    uint64_t mode;
+
+    // The archive ends with two zero blocks.
+    if (IsZeroBlock(extractionPtr->header))
+    {
+        extractionPtr->zeroBlocks++;
+        if (extractionPtr->zeroBlocks >= 2)
+        {
+            extractionPtr->state = TAR_END;
+        }
+        return LE_OK;
+    }
+    extractionPtr->zeroBlocks = 0;
+
+    if (   !IsChecksumValid(extractionPtr->header)
+        || (ParseNumber(headerPtr->size, sizeof(headerPtr->size), &size) != LE_OK)
+        || (ParseNumber(headerPtr->mode, sizeof(headerPtr->mode), &mode) != LE_OK))
+    {
+        LE_ERROR("Corrupted tar header.");
+        return LE_FORMAT_ERROR;
+    }
+
+    if (extractionPtr->hasLongSize)
+    {
+        size = extractionPtr->longSize;
+    }
+
+    size_t padding = (BLOCK_BYTES - (size % BLOCK_BYTES)) % BLOCK_BYTES;
+
+    // Metadata that applies to the next entry.
+    switch (headerPtr->typeflag)
+    {
+        case 'L':
+        case 'K':
+        case 'x':
+            if (size > MAX_META_BYTES)
+            {
+                LE_ERROR("Tar metadata too large (%" PRIu64 " bytes).", size);
+                return LE_FORMAT_ERROR;
+            }
+            extractionPtr->metaType = headerPtr->typeflag;
+            extractionPtr->metaLen = 0;
+            extractionPtr->padding = padding;
+            extractionPtr->remaining = size;
+            extractionPtr->state = TAR_META;
+            if (size == 0)
+            {
+                StartSkip(extractionPtr, padding);
+                return ProcessMeta(extractionPtr);
+            }
+            return LE_OK;
+
+        case 'g':
+            // Global pax headers hold nothing we use.
+            StartSkip(extractionPtr, size + padding);
+            return LE_OK;
+
+        default:
+            break;
+    }
+
+    // A proper entry.  Use the metadata seen before it, if any.
+    char name[PATH_MAX];
+    char linkName[PATH_MAX];
+
+    if (extractionPtr->longPath[0] != '\0')
+    {
+        LE_ASSERT(le_utf8_Copy(name, extractionPtr->longPath, sizeof(name), NULL) == LE_OK);
+    }
+    else if ((strncmp(headerPtr->magic, "ustar", 5) == 0) && (headerPtr->prefix[0] != '\0'))
+    {
+        snprintf(name, sizeof(name), "%.*s/%.*s",
+                 (int)sizeof(headerPtr->prefix), headerPtr->prefix,
+                 (int)sizeof(headerPtr->name), headerPtr->name);
+    }
+    else
+    {
+        snprintf(name, sizeof(name), "%.*s", (int)sizeof(headerPtr->name), headerPtr->name);
+    }
+
+    if (extractionPtr->longLink[0] != '\0')
+    {
+        LE_ASSERT(le_utf8_Copy(linkName, extractionPtr->longLink, sizeof(linkName), NULL)
+                  == LE_OK);
+    }
+    else
+    {
+        snprintf(linkName, sizeof(linkName), "%.*s",
+                 (int)sizeof(headerPtr->linkname), headerPtr->linkname);
+    }
+
+    extractionPtr->longPath[0] = '\0';
+    extractionPtr->longLink[0] = '\0';
+    extractionPtr->hasLongSize = false;
+
+    char path[PATH_MAX];
+    le_result_t result = GetDestPath(extractionPtr, name, path);
+
+    if (result == LE_NOT_FOUND)
+    {
+        // The destination directory itself.
+        StartSkip(extractionPtr, size + padding);
+        return LE_OK;
+    }
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    mode &= (S_ISUID | S_ISGID | S_ISVTX | S_IRWXU | S_IRWXG | S_IRWXO);
+
+    switch (headerPtr->typeflag)
+    {
+        case '0':
+        case '\0':
+        case '7':
+            result = StartFile(extractionPtr, path, mode, size);
+            if (result != LE_OK)
+            {
+                return result;
+            }
+            if (size == 0)
+            {
+                StartSkip(extractionPtr, padding);
+                return FinishFile(extractionPtr);
+            }
+            extractionPtr->remaining = size;
+            extractionPtr->padding = padding;
+            extractionPtr->state = TAR_DATA;
+            return LE_OK;
+
+        case '5':
+            result = MakeDir(extractionPtr, path, mode);
+            break;
+
+        case '2':
+            result = MakeSymlink(extractionPtr, path, linkName);
+            break;
+
+        case '1':
+            result = MakeHardLink(extractionPtr, path, linkName);
+            break;
+
+        default:
+            LE_WARN("Skipping '%s' (unsupported entry type '%c').", name, headerPtr->typeflag);
+            break;
+    }
+
+    StartSkip(extractionPtr, size + padding);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Feed decompressed tarball bytes through the tar parser.
+ *
+ * @return LE_OK if successful, LE_FORMAT_ERROR or LE_FAULT otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ExtractBytes
+(
+    Extraction_t* extractionPtr,
+    const uint8_t* dataPtr,
+    size_t len
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_result_t result = LE_OK;
+
+    extractionPtr->byteCount += len;
+
+    while ((len > 0) && (result == LE_OK))
+    {
+        size_t count = len;
+
+        if ((extractionPtr->state != TAR_HEADER) && (extractionPtr->remaining < count))
+        {
+            count = extractionPtr->remaining;
+        }
+
+        switch (extractionPtr->state)
+        {
+            case TAR_HEADER:
+                if (count > BLOCK_BYTES - extractionPtr->headerLen)
+                {
+                    count = BLOCK_BYTES - extractionPtr->headerLen;
+                }
+                memcpy(extractionPtr->header + extractionPtr->headerLen, dataPtr, count);
+                extractionPtr->headerLen += count;
+                if (extractionPtr->headerLen == BLOCK_BYTES)
+                {
+                    extractionPtr->headerLen = 0;
+                    result = ProcessHeader(extractionPtr);
+                }
+                break;
+
+            case TAR_DATA:
+                result = WriteFile(extractionPtr, dataPtr, count);
+                extractionPtr->remaining -= count;
+                if ((result == LE_OK) && (extractionPtr->remaining == 0))
+                {
+                    StartSkip(extractionPtr, extractionPtr->padding);
+                    result = FinishFile(extractionPtr);
+                }
+                break;
+
+            case TAR_META:
+                memcpy(extractionPtr->metaBuf + extractionPtr->metaLen, dataPtr, count);
+                extractionPtr->metaLen += count;
+                extractionPtr->remaining -= count;
+                if (extractionPtr->remaining == 0)
+                {
+                    StartSkip(extractionPtr, extractionPtr->padding);
+                    result = ProcessMeta(extractionPtr);
+                }
+                break;
+
+            case TAR_SKIP:
+                extractionPtr->remaining -= count;
+                if (extractionPtr->remaining == 0)
+                {
+                    extractionPtr->state = TAR_HEADER;
+                }
+                break;
+
+            case TAR_END:
+                // Whatever follows the end of the archive is ignored.
+                return LE_OK;
+        }
+
+        dataPtr += count;
+        len -= count;
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the permissions of the directories that were held back until the end.
+ *
+ * @return LE_OK if successful, LE_FAULT otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ApplyDirFixups
+(
+    Extraction_t* extractionPtr,
+    bool apply
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_result_t result = LE_OK;
+    le_sls_Link_t* linkPtr;
+
+    while ((linkPtr = le_sls_Pop(&extractionPtr->dirFixups)) != NULL)
+    {
+        DirFixup_t* fixupPtr = CONTAINER_OF(linkPtr, DirFixup_t, link);
+
+        if (apply && (chmod(fixupPtr->path, fixupPtr->mode) != 0))
+        {
+            LE_ERROR("Failed to set permissions of '%s' (%m).", fixupPtr->path);
+            result = LE_FAULT;
+        }
+
+        le_mem_Release(fixupPtr);
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report the result of an extraction.  Runs on the thread that started it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportDone
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Extraction_t* extractionPtr = param1Ptr;
+    le_result_t result = (le_result_t)(intptr_t)param2Ptr;
+
+    if (!extractionPtr->isDeleted)
+    {
+        extractionPtr->doneHandler(extractionPtr, result, extractionPtr->contextPtr);
+    }
+
+    le_mem_Release(extractionPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main function of the extraction thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* ExtractThreadMain
+(
+    void* contextPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Extraction_t* extractionPtr = contextPtr;
+    bool isLast = false;
+
+    while (!isLast)
+    {
+        le_sem_Wait(extractionPtr->fullSem);
+
+        Chunk_t* chunkPtr = &extractionPtr->chunks[extractionPtr->readIndex];
+        extractionPtr->readIndex = (extractionPtr->readIndex + 1) % NUM_CHUNKS;
+
+        if ((extractionPtr->extractResult == LE_OK) && !IsFailed(extractionPtr))
+        {
+            extractionPtr->extractResult = ExtractBytes(extractionPtr,
+                                                        chunkPtr->data,
+                                                        chunkPtr->len);
+            if (extractionPtr->extractResult != LE_OK)
+            {
+                SetFailed(extractionPtr);
+            }
+        }
+
+        isLast = chunkPtr->isLast;
+
+        le_sem_Post(extractionPtr->freeSem);
+    }
+
+    le_result_t result = extractionPtr->decompressResult;
+
+    if (extractionPtr->fileFd != -1)
+    {
+        fd_Close(extractionPtr->fileFd);
+        extractionPtr->fileFd = -1;
+    }
+
+    if (result == LE_OK)
+    {
+        result = extractionPtr->extractResult;
+    }
+
+    if (   (result == LE_OK)
+        && (extractionPtr->state != TAR_END)
+        && ((extractionPtr->state != TAR_HEADER) || (extractionPtr->headerLen != 0)))
+    {
+        LE_ERROR("Tarball is truncated.");
+        result = LE_FORMAT_ERROR;
+    }
+
+    if ((ApplyDirFixups(extractionPtr, (result == LE_OK)) != LE_OK) && (result == LE_OK))
+    {
+        result = LE_FAULT;
+    }
+
+    if (result == LE_OK)
+    {
+        LE_INFO("Unpacked %zu files (%" PRIu64 " bytes) into '%s'.",
+                extractionPtr->fileCount,
+                extractionPtr->byteCount,
+                extractionPtr->dirPath);
+    }
+
+    le_mem_AddRef(extractionPtr);
+    le_event_QueueFunctionToThread(extractionPtr->callerThread,
+                                   ReportDone,
+                                   extractionPtr,
+                                   (void*)(intptr_t)result);
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start extracting a (compressed) tarball into a directory.
+ *
+ * The tarball must be written to the file descriptor returned through inputFdPtr, which must be
+ * closed by the caller once the whole tarball has been written.
+ *
+ * @return Reference to the extraction.
+ */
+//--------------------------------------------------------------------------------------------------
+untar_Ref_t untar_Start
+(
+    const char* dirPath,                ///< [IN] Directory to extract into.
+    const char* linkRootPath,           ///< [IN] Directory under which absolute symlinks can point
+                                        ///       (NULL if they are not allowed).
+    untar_DoneHandler_t doneHandler,    ///< [IN] Completion callback.
+    untar_LinkHandler_t linkHandler,    ///< [IN] Callback to provide files (NULL if not needed).
+    untar_FileHandler_t fileHandler,    ///< [IN] Per-file callback (NULL if not needed).
+    void* contextPtr,                   ///< [IN] Context pointer for the callbacks.
+    int* inputFdPtr                     ///< [OUT] Write end of the input pipe.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (ExtractionPool == NULL)
+    {
+        ExtractionPool = le_mem_CreatePool("Untar", sizeof(Extraction_t));
+        DirFixupPool = le_mem_CreatePool("UntarDirFixup", sizeof(DirFixup_t));
+    }
+
+    Extraction_t* extractionPtr = le_mem_ForceAlloc(ExtractionPool);
+    memset(extractionPtr, 0, sizeof(*extractionPtr));
+
+    LE_ASSERT(le_utf8_Copy(extractionPtr->dirPath, dirPath, sizeof(extractionPtr->dirPath), NULL)
+              == LE_OK);
+    if (linkRootPath != NULL)
+    {
+        LE_ASSERT(le_utf8_Copy(extractionPtr->linkRootPath, linkRootPath,
+                               sizeof(extractionPtr->linkRootPath), NULL) == LE_OK);
+    }
+    extractionPtr->doneHandler = doneHandler;
+    extractionPtr->linkHandler = linkHandler;
+    extractionPtr->fileHandler = fileHandler;
+    extractionPtr->contextPtr = contextPtr;
+    extractionPtr->callerThread = le_thread_GetCurrent();
+    extractionPtr->decompressResult = LE_OK;
+    extractionPtr->extractResult = LE_OK;
+    extractionPtr->state = TAR_HEADER;
+    extractionPtr->fileFd = -1;
+    extractionPtr->dirFixups = LE_SLS_LIST_INIT;
+    extractionPtr->freeSem = le_sem_Create("UntarFree", NUM_CHUNKS);
+    extractionPtr->fullSem = le_sem_Create("UntarFull", 0);
+    extractionPtr->digestCtxPtr = EVP_MD_CTX_new();
+    LE_ASSERT(extractionPtr->digestCtxPtr != NULL);
+
+    int pipeFds[2];
+    LE_FATAL_IF(pipe2(pipeFds, O_CLOEXEC) != 0, "Failed to create pipe (%m).");
+    extractionPtr->inputFd = pipeFds[0];
+    *inputFdPtr = pipeFds[1];
+
+    extractionPtr->decompressThread = le_thread_Create("untarDecompress",
+                                                       DecompressThreadMain,
+                                                       extractionPtr);
+    extractionPtr->extractThread = le_thread_Create("untarExtract",
+                                                    ExtractThreadMain,
+                                                    extractionPtr);
+    le_thread_SetJoinable(extractionPtr->decompressThread);
+    le_thread_SetJoinable(extractionPtr->extractThread);
+    le_thread_Start(extractionPtr->decompressThread);
+    le_thread_Start(extractionPtr->extractThread);
+
+    return extractionPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete an extraction.  The completion callback will not be called after this.
+ *
+ * If the extraction is still running, the input pipe's write end must have been closed already;
+ * this then waits for the worker threads to wind down.
+ */
+//--------------------------------------------------------------------------------------------------
+void untar_Delete
+(
+    untar_Ref_t ref             ///< [IN] Extraction.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Extraction_t* extractionPtr = ref;
+
+    extractionPtr->isDeleted = true;
+
+    // Whatever is left of the input is not wanted anymore.
+    SetFailed(extractionPtr);
+
+    le_thread_Join(extractionPtr->decompressThread, NULL);
+    le_thread_Join(extractionPtr->extractThread, NULL);
+
+    le_sem_Delete(extractionPtr->freeSem);
+    le_sem_Delete(extractionPtr->fullSem);
+    EVP_MD_CTX_free(extractionPtr->digestCtxPtr);
+
+    le_mem_Release(extractionPtr);
+}
@@ -0,0 +1,128 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file untar.h
+ *
+ * In-process streaming tarball extractor used by the Update Unpacker.
+ *
+ * The compressed tarball is written into a pipe by the caller.  Two worker threads take it from
+ * there: one decompresses the stream and the other one extracts the tar entries into the
+ * destination directory, so reading the update pack, decompressing and writing files all happen
+ * at the same time.  Completion is reported on the thread that started the extraction.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_UNTAR_H_INCLUDE_GUARD
+#define LEGATO_UNTAR_H_INCLUDE_GUARD
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the digest computed for each regular file extracted (SHA-256).
+ */
+//--------------------------------------------------------------------------------------------------
+#define UNTAR_DIGEST_BYTES  32
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to an extraction in progress.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct untar_Extraction* untar_Ref_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Completion callback.  Called on the thread that started the extraction.
+ *
+ * The result is:
+ *      - LE_OK if everything was extracted.
+ *      - LE_FORMAT_ERROR if the payload is corrupted, is not a tarball or has unsafe entries.
+ *      - LE_FAULT if the files could not be written.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*untar_DoneHandler_t)
+(
+    untar_Ref_t ref,            ///< Extraction that finished.
+    le_result_t result,         ///< Result.
+    void* contextPtr            ///< Context pointer given to untar_Start().
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Callback that can provide a regular file without it being written, e.g. by linking it to an
+ * identical file.  Called on the extraction thread for small files, once their digest is known.
+ * Nothing exists at the file's path when this is called.
+ *
+ * @return LE_OK if the file was provided, anything else to have it written.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef le_result_t (*untar_LinkHandler_t)
+(
+    const char* pathPtr,        ///< Path of the file to create.
+    const uint8_t* digestPtr,   ///< UNTAR_DIGEST_BYTES bytes of digest of the file's contents.
+    mode_t mode,                ///< Permissions of the file.
+    void* contextPtr            ///< Context pointer given to untar_Start().
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Per-file callback.  Called on the extraction thread after each regular file has been written,
+ * with the SHA-256 digest of its contents computed while it was being written.
+ *
+ * @return LE_OK to carry on, anything else to fail the extraction.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef le_result_t (*untar_FileHandler_t)
+(
+    const char* pathPtr,        ///< Path of the file that was written.
+    const uint8_t* digestPtr,   ///< UNTAR_DIGEST_BYTES bytes of digest.
+    void* contextPtr            ///< Context pointer given to untar_Start().
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start extracting a (compressed) tarball into a directory.
+ *
+ * The tarball must be written to the file descriptor returned through inputFdPtr, which must be
+ * closed by the caller once the whole tarball has been written.
+ *
+ * Entries whose names climb out of the directory or go through a symbolic link are refused, and so
+ * are symbolic links that point outside of the directory, unless they are absolute and point under
+ * linkRootPath.
+ *
+ * @return Reference to the extraction.
+ */
+//--------------------------------------------------------------------------------------------------
+untar_Ref_t untar_Start
+(
+    const char* dirPath,                ///< [IN] Directory to extract into.
+    const char* linkRootPath,           ///< [IN] Directory under which absolute symlinks can point
+                                        ///       (NULL if they are not allowed).
+    untar_DoneHandler_t doneHandler,    ///< [IN] Completion callback.
+    untar_LinkHandler_t linkHandler,    ///< [IN] Callback to provide files (NULL if not needed).
+    untar_FileHandler_t fileHandler,    ///< [IN] Per-file callback (NULL if not needed).
+    void* contextPtr,                   ///< [IN] Context pointer for the callbacks.
+    int* inputFdPtr                     ///< [OUT] Write end of the input pipe.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete an extraction.  The completion callback will not be called after this.
+ *
+ * If the extraction is still running, the input pipe's write end must have been closed already;
+ * this then waits for the worker threads to wind down.
+ */
+//--------------------------------------------------------------------------------------------------
+void untar_Delete
+(
+    untar_Ref_t ref             ///< [IN] Extraction.
+);
+
+
+#endif // LEGATO_UNTAR_H_INCLUDE_GUARD
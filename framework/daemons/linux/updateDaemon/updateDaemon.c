@@ -776,6 +776,8 @@ le_result_t  VerifyUnpackedSystem
             case FTS_D:
                 if (1 == entPtr->fts_level)
                 {
+                    // Verify all the files of the app at once, with the app's own certificate if
+                    // it has one and with the system certificate otherwise.
                     snprintf(appPubCertPath,
                              sizeof(appPubCertPath),
                              "%s/%s",
@@ -791,11 +793,27 @@ le_result_t  VerifyUnpackedSystem
                             fts_close(ftsPtr);
                             return LE_FAULT;
                         }
+
+                        // The certificate itself is signed as any other file of the app.
+                        result = ima_VerifyFile(appPubCertPath, appPubCertPath);
+                        if (LE_OK == result)
+                        {
+                            result = ima_VerifyDir(entPtr->fts_path, appPubCertPath);
+                        }
                     }
                     else
                     {
-                        memset(appPubCertPath, 0, sizeof(appPubCertPath));
+                        result = ima_VerifyDir(entPtr->fts_path, path);
+                    }
+
+                    if (LE_OK != result)
+                    {
+                        LE_CRIT("Failed to verify files of '%s' directory", entPtr->fts_path);
+                        fts_close(ftsPtr);
+                        return LE_FAULT;
                     }
+
+                    fts_set(ftsPtr, entPtr, FTS_SKIP);
                 }
                 break;
 
@@ -804,22 +822,13 @@ le_result_t  VerifyUnpackedSystem
                 break;
 
             case FTS_F:
-                // As directories are visiting preorder, verifying files using last received
-                // certificate should be ok.
-                if (file_Exists(appPubCertPath))
-                {
-                    result = ima_VerifyFile(entPtr->fts_accpath, appPubCertPath);
-                }
-                else
-                {
-                    result = ima_VerifyFile(entPtr->fts_accpath, path);
-                }
+                result = ima_VerifyFile(entPtr->fts_accpath, path);
 
                 if (LE_OK != result)
                 {
                     LE_CRIT("Failed to verify file '%s' with public certificate '%s'",
                             entPtr->fts_accpath,
-                            file_Exists(appPubCertPath) ? appPubCertPath : path);
+                            path);
                     fts_close(ftsPtr);
                     return LE_FAULT;
                 }
@@ -5,7 +5,8 @@
  * Implementation of the Update Pack parser.  This file parses an update pack, and drives the
  * rest of the update based on the contents of the update pack.
  *
- * This is single-threaded, event-driven code that shares the main thread's event loop.
+ * This is single-threaded, event-driven code that shares the main thread's event loop.  Only the
+ * decompression and extraction of payload tarballs run on worker threads (see untar.c).
  *
  * Copyright (C) Sierra Wireless Inc.
  */
@@ -15,7 +16,8 @@
 #include "interfaces.h"
 #include "limit.h"
 #include "updateUnpack.h"
-#include "pipeline.h"
+#include "untar.h"
+#include "objStore.h"
 #include "fileDescriptor.h"
 #include "system.h"
 #include "app.h"
@@ -34,12 +36,15 @@ static bool InputFdClosed = false;
 /// Reference to the FD Monitor for the input stream (NULL if not unpacking).
 static le_fdMonitor_Ref_t InputFdMonitor = NULL;
 
-/// Reference to an unpack pipeline (NULL if not unpacking).
-static pipeline_Ref_t Pipeline = NULL;
+/// Reference to the tarball extraction in progress (NULL if not unpacking).
+static untar_Ref_t Extraction = NULL;
 
-/// File descriptor connected to the input of a pipeline (-1 if not unpacking)
+/// File descriptor connected to the input of the extraction (-1 if not unpacking)
 static int PipelineFd = -1;
 
+/// Time at which the current extraction started.
+static le_clk_Time_t UntarStartTime;
+
 /// Function to be called to report progress.
 static updateUnpack_ProgressHandler_t ProgressFunc = NULL;
 
@@ -182,11 +187,11 @@ static void Reset
         PipelineFd = -1;
     }
 
-    // Delete the pipeline.
-    if (Pipeline != NULL)
+    // Delete the extraction.  Its input has been closed above, so this won't block for long.
+    if (Extraction != NULL)
     {
-        pipeline_Delete(Pipeline);
-        Pipeline = NULL;
+        untar_Delete(Extraction);
+        Extraction = NULL;
     }
 }
 
@@ -370,34 +375,84 @@ static void StartParsing
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Completion callback for "tar xj" operation.
+ * Provide an app file from the object store instead of writing it.  Called on the extraction
+ * thread.
+ *
+ * @return LE_OK if the file was linked, LE_NOT_FOUND if it must be written.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t LinkFromObjStore
+(
+    const char* pathPtr,
+    const uint8_t* digestPtr,
+    mode_t mode,
+    void* contextPtr            ///< App name.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return objStore_Link(contextPtr, digestPtr, mode, pathPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add an app file that was just written to the object store.  Called on the extraction thread.
+ *
+ * @return LE_OK (failing to share a file doesn't fail the update).
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AddToObjStore
+(
+    const char* pathPtr,
+    const uint8_t* digestPtr,
+    void* contextPtr            ///< App name.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    objStore_Add(contextPtr, digestPtr, pathPtr);
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Completion callback for the tarball extraction.
  */
 //--------------------------------------------------------------------------------------------------
 static void UntarDone
 (
-    pipeline_Ref_t pipeline,
-    int status
+    untar_Ref_t extraction,
+    le_result_t result,
+    void* contextPtr
 )
 //--------------------------------------------------------------------------------------------------
 {
-    pipeline_Delete(Pipeline);
-    Pipeline = NULL;
+    LE_ASSERT(extraction == Extraction);
 
-    if (!WIFEXITED(status) || (WEXITSTATUS(status) != EXIT_SUCCESS))
-    {
-        if (WIFEXITED(status))
-        {
-            LE_ERROR("Payload unpack pipeline failed with exit code: %d", WEXITSTATUS(status));
-        }
-        else if (WIFSIGNALED(status))
-        {
-            LE_ERROR("Payload unpack pipeline killed by signal: %d", WTERMSIG(status));
-        }
-        else
-        {
-            LE_ERROR("Payload unpack pipeline died for unknown reason (status: %d)", status);
-        }
+    untar_Delete(Extraction);
+    Extraction = NULL;
 
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), UntarStartTime);
+    objStore_Stats_t stats;
+
+    objStore_TakeStats(&stats);
+    LE_INFO("Payload unpacked in %lu ms (%zu files linked from the object store, %zu shared,"
+            " %" PRIu64 " bytes saved).",
+            (unsigned long)(elapsed.sec * 1000 + elapsed.usec / 1000),
+            stats.linkedFiles,
+            stats.sharedFiles,
+            stats.linkedBytes + stats.sharedBytes);
+
+    if (result == LE_FORMAT_ERROR)
+    {
+        LE_ERROR("Payload is not a valid tarball.");
+        HandleFormatError();
+        return;
+    }
+    if (result != LE_OK)
+    {
+        LE_ERROR("Payload unpack failed (%s).", LE_RESULT_TXT(result));
         HandleInternalError();
         return;
     }
@@ -687,31 +742,6 @@ static void InputFdEventHandler
 }
 
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Function that runs in the unpack pipeline's "tar" process.
- **/
-//--------------------------------------------------------------------------------------------------
-static int Untar
-(
-    void* param
-)
-//--------------------------------------------------------------------------------------------------
-{
-    const char* unpackDir = param;
-
-    // Close all open file descriptors except for stdin, stdout, and stderr.
-    // This ensures that we don't keep copies of things like the pipeline input write pipe open.
-    fd_CloseAllNonStd();
-
-    // Try bsdtar first.  If that fails, fallback to tar.
-    execl("/usr/bin/bsdtar", "bsdtar", "xjmop", "-f", "-", "-C", unpackDir, (char*)NULL);
-    execl("/bin/tar", "tar", "xjop", "-C", unpackDir, (char*)NULL);
-
-    LE_FATAL("Failed to exec tar (%m)");
-}
-
-
 //--------------------------------------------------------------------------------------------------
 /**
  * Start unpacking a tarball.
@@ -726,12 +756,21 @@ static void StartUntar
     State = STATE_UNPACKING_PAYLOAD;
 
     PayloadBytesCopied = 0;
+    UntarStartTime = le_clk_GetRelativeTime();
 
-    // Create a pipeline: PipelineFd -> tar
-    Pipeline = pipeline_Create();
-    PipelineFd = pipeline_CreateInputPipe(Pipeline);
-    pipeline_Append(Pipeline, Untar, (void*)dirPath);
-    pipeline_Start(Pipeline, UntarDone);
+    // Extract in-process: PipelineFd -> decompression thread -> extraction thread.
+    // App files go through the object store, so unchanged files are not written again.
+    // Only systems have absolute symlinks, from their apps directory to the installed apps.
+    if (AppName[0] != '\0')
+    {
+        Extraction = untar_Start(dirPath, NULL, UntarDone, LinkFromObjStore, AddToObjStore,
+                                 AppName, &PipelineFd);
+    }
+    else
+    {
+        Extraction = untar_Start(dirPath, "/legato/apps", UntarDone, NULL, NULL, NULL,
+                                 &PipelineFd);
+    }
 
     fd_SetNonBlocking(InputFd);
 
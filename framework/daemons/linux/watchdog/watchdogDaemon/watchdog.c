@@ -95,6 +95,12 @@
  * the threshold value is increased until a point at which all allowable watchdog resources have
  * been allocated at which point no more will be be created.
  *
+ * A process can also kick its watchdog through a shared memory heartbeat obtained with
+ * le_wdog_GetHeartbeat(), to save the IPC message of each kick.  The heartbeats are checked in one
+ * periodic sweep: each new kick found restarts the process' timer for the rest of its timeout,
+ * counted from the time of the kick.  The heartbeat is checked again when the timer expires, so a
+ * kick that was not swept yet is not missed.
+ *
  * @note Critical systems rely on the watchdog daemon to ensure system liveness, so all
  * unrecoverable errors in the watchdogDaemon are considered fatal to the system, and will
  * cause a system reboot by calling LE_FATAL or LE_ASSERT.
@@ -108,6 +114,8 @@
 #include "user.h"
 #include "fileDescriptor.h"
 #include "pa_wdog.h"
+#include "wdogHeartbeat.h"
+#include <sys/mman.h>
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -196,6 +204,13 @@
 //--------------------------------------------------------------------------------------------------
 #define TIMEOUT_KICK -3
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Interval of the sweep of the heartbeats (in milliseconds)
+ **/
+//--------------------------------------------------------------------------------------------------
+#define HEARTBEAT_SWEEP_INTERVAL 1000
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Define a special PID to use for no such process.
@@ -287,6 +302,135 @@ static le_hashmap_Ref_t MandatoryWatchdogRefs;  ///< The container used to track
 
 static le_timer_Ref_t DefaultExternalWdogTimer; ///< Default external wdog timer
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Shared memory heartbeat of a process, through which it kicks its watchdog without IPC messages.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    pid_t procId;                       ///< The process the heartbeat belongs to (hash key)
+    le_msg_SessionRef_t sessionRef;     ///< The session the heartbeat was obtained on
+    int fd;                             ///< The shared memory file descriptor
+    wdogHeartbeat_t* slotPtr;           ///< The mapped heartbeat
+    uint32_t kickCount;                 ///< The kick count at the last check
+}
+HeartbeatObj_t;
+
+static le_mem_PoolRef_t HeartbeatPool;          ///< The memory pool the heartbeats come from
+static le_hashmap_Ref_t HeartbeatRefs;          ///< The container used to track heartbeats
+static le_timer_Ref_t HeartbeatSweepTimer;      ///< The timer of the sweep of the heartbeats
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Construct le_clk_Time_t object that will give an interval of the provided number
+ *  of milliseconds.
+ *
+ *      @return the constructed le_clk_Time_t
+ */
+//--------------------------------------------------------------------------------------------------
+static le_clk_Time_t MakeTimerInterval
+(
+    uint64_t milliseconds
+)
+{
+    le_clk_Time_t interval;
+
+    interval.sec = milliseconds / 1000;
+    interval.usec = (milliseconds - (interval.sec * 1000)) * 1000;
+
+    return interval;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether the process kicked its heartbeat since the last check.
+ *
+ * @return
+ *      true if it kicked, with the time elapsed since the kick
+ */
+//--------------------------------------------------------------------------------------------------
+static bool GetHeartbeatKick
+(
+    HeartbeatObj_t* heartbeatPtr,   ///< [IN] The heartbeat to check
+    uint32_t* elapsedMsPtr          ///< [OUT] The time elapsed since the last kick (in ms)
+)
+{
+    uint32_t kickCount = __atomic_load_n(&heartbeatPtr->slotPtr->kickCount, __ATOMIC_ACQUIRE);
+
+    if (kickCount == heartbeatPtr->kickCount)
+    {
+        return false;
+    }
+    heartbeatPtr->kickCount = kickCount;
+
+    // The kick time is at least as recent as the kick count.  Both clocks wrap around the same way.
+    *elapsedMsPtr = wdogHeartbeat_GetTimeMs()
+                    - __atomic_load_n(&heartbeatPtr->slotPtr->kickTimeMs, __ATOMIC_RELAXED);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Restart the timer of a watchdog kicked through its heartbeat some time ago, for the rest of its
+ * timeout.  A watchdog kicked more than its timeout ago expires immediately.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RestartHeartbeatWatchdog
+(
+    WatchdogObj_t* watchDogPtr,     ///< [IN] The watchdog kicked
+    uint32_t elapsedMs              ///< [IN] The time elapsed since the kick (in ms)
+)
+{
+    le_clk_Time_t timeoutValue = watchDogPtr->kickTimeoutInterval;
+    le_clk_Time_t elapsed = MakeTimerInterval(elapsedMs);
+
+    le_timer_Stop(watchDogPtr->timer);
+
+    if (le_clk_Equal(timeoutValue, MakeTimerInterval(LE_WDOG_TIMEOUT_NEVER)))
+    {
+        LE_DEBUG("Timeout set to NEVER!");
+        return;
+    }
+
+    if (le_clk_GreaterThan(timeoutValue, elapsed))
+    {
+        timeoutValue = le_clk_Sub(timeoutValue, elapsed);
+    }
+    else
+    {
+        timeoutValue = MakeTimerInterval(LE_WDOG_TIMEOUT_NOW);
+    }
+
+    // timer is stopped here so this should never fail
+    LE_ASSERT(LE_OK == le_timer_SetInterval(watchDogPtr->timer, timeoutValue));
+    le_timer_Start(watchDogPtr->timer);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove the heartbeat from our container, unmap it and free it.  The sweep stops with the last
+ * heartbeat.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseHeartbeat
+(
+    HeartbeatObj_t* heartbeatPtr    ///< [IN] The heartbeat to release
+)
+{
+    LE_DEBUG("Releasing heartbeat of %d", heartbeatPtr->procId);
+
+    LE_ASSERT(heartbeatPtr == le_hashmap_Remove(HeartbeatRefs, &(heartbeatPtr->procId)));
+    munmap(heartbeatPtr->slotPtr, sizeof(wdogHeartbeat_t));
+    fd_Close(heartbeatPtr->fd);
+    le_mem_Release(heartbeatPtr);
+
+    if (le_hashmap_isEmpty(HeartbeatRefs))
+    {
+        le_timer_Stop(HeartbeatSweepTimer);
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Remove the watchdog from our container, free the timer it contains and then free the storage
@@ -355,6 +499,13 @@ static void CleanUpClosedClient
     LE_INFO("Client session closed");
     if (LE_OK == le_msg_GetClientProcessId(sessionRef, &clientProcId))
     {
+        // The heartbeat lives as long as the session it was obtained on.
+        HeartbeatObj_t* heartbeatPtr = le_hashmap_Get(HeartbeatRefs, &clientProcId);
+        if ((heartbeatPtr != NULL) && (heartbeatPtr->sessionRef == sessionRef))
+        {
+            ReleaseHeartbeat(heartbeatPtr);
+        }
+
         DeleteWatchdog(clientProcId);
     }
 }
@@ -498,6 +649,19 @@ static void WatchdogHandleExpiry
     if (expiredDog != NULL)
     {
         pid_t procId = watchDogPtr->procId;
+
+        // A kick through the heartbeat may not have been swept yet.
+        HeartbeatObj_t* heartbeatPtr = le_hashmap_Get(HeartbeatRefs, &procId);
+        uint32_t elapsedMs;
+
+        if ((heartbeatPtr != NULL) &&
+            GetHeartbeatKick(heartbeatPtr, &elapsedMs) &&
+            le_clk_GreaterThan(watchDogPtr->kickTimeoutInterval, MakeTimerInterval(elapsedMs)))
+        {
+            RestartHeartbeatWatchdog(watchDogPtr, elapsedMs);
+            return;
+        }
+
         int fd;
         char procName[LE_LIMIT_PROC_NAME_LEN + 1];
         char procPidPath[LE_LIMIT_PROC_NAME_LEN + 1];
@@ -525,27 +689,6 @@ static void WatchdogHandleExpiry
     }
 }
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Construct le_clk_Time_t object that will give an interval of the provided number
- *  of milliseconds.
- *
- *      @return the constructed le_clk_Time_t
- */
-//--------------------------------------------------------------------------------------------------
-static le_clk_Time_t MakeTimerInterval
-(
-    uint64_t milliseconds
-)
-{
-    le_clk_Time_t interval;
-
-    interval.sec = milliseconds / 1000;
-    interval.usec = (milliseconds - (interval.sec * 1000)) * 1000;
-
-    return interval;
-}
-
 //--------------------------------------------------------------------------------------------------
 /**
  * Check a regular watchdog is running.
@@ -1022,6 +1165,121 @@ static WatchdogObj_t* GetClientWatchdogPtr
     return watchdogPtr;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create the shared memory heartbeat of a process and add it to our container.  The sweep starts
+ * with the first heartbeat.
+ *
+ * @return
+ *      A pointer to the new heartbeat, or NULL if it could not be created
+ */
+//--------------------------------------------------------------------------------------------------
+static HeartbeatObj_t* CreateHeartbeat
+(
+    pid_t clientPid,                    ///< [IN] The process id of the client
+    le_msg_SessionRef_t sessionRef      ///< [IN] The session the heartbeat is obtained on
+)
+{
+    wdogHeartbeat_t* slotPtr = MAP_FAILED;
+
+    int fd = memfd_create("wdogHeartbeat", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0)
+    {
+        LE_ERROR("Failed to create heartbeat for %d (%m)", clientPid);
+        return NULL;
+    }
+
+    // The size is sealed, so that a client can't truncate the heartbeat and crash the watchdog
+    // daemon with a SIGBUS.
+    if ((0 == ftruncate(fd, sizeof(wdogHeartbeat_t))) &&
+        (0 == fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL)))
+    {
+        slotPtr = mmap(NULL, sizeof(wdogHeartbeat_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+
+    if (MAP_FAILED == slotPtr)
+    {
+        LE_ERROR("Failed to map heartbeat for %d (%m)", clientPid);
+        fd_Close(fd);
+        return NULL;
+    }
+
+    // The memfd is zero-filled: the kick count and time are already cleared.
+    slotPtr->magic = WDOG_HEARTBEAT_MAGIC;
+    slotPtr->version = WDOG_HEARTBEAT_VERSION;
+
+    HeartbeatObj_t* heartbeatPtr = le_mem_ForceAlloc(HeartbeatPool);
+    heartbeatPtr->procId = clientPid;
+    heartbeatPtr->sessionRef = sessionRef;
+    heartbeatPtr->fd = fd;
+    heartbeatPtr->slotPtr = slotPtr;
+    heartbeatPtr->kickCount = 0;
+    LE_ASSERT(NULL == le_hashmap_Put(HeartbeatRefs, &(heartbeatPtr->procId), heartbeatPtr));
+
+    if (!le_timer_IsRunning(HeartbeatSweepTimer))
+    {
+        le_timer_Start(HeartbeatSweepTimer);
+    }
+
+    LE_INFO("Created heartbeat for %d", clientPid);
+    return heartbeatPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check a heartbeat for a new kick, and restart the process' watchdog if it kicked.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool SweepHeartbeat
+(
+    const void* keyPtr,
+    const void* valuePtr,
+    void* contextPtr
+)
+{
+    HeartbeatObj_t* heartbeatPtr = (HeartbeatObj_t*)valuePtr;
+    uint32_t elapsedMs;
+
+    if (GetHeartbeatKick(heartbeatPtr, &elapsedMs))
+    {
+        pid_t procId = heartbeatPtr->procId;
+        WatchdogObj_t* watchDogPtr = LookupClientWatchdogPtrById(procId);
+
+        if (watchDogPtr == NULL)
+        {
+            // The watchdog was deleted when another session of the process closed.  Treat the
+            // kick as a kick from a new process, as for an IPC kick, unless the process is gone.
+            if (kill(procId, 0) != 0)
+            {
+                return true;
+            }
+            watchDogPtr = CreateNewWatchdog(procId);
+            AddWatchdog(watchDogPtr);
+        }
+
+        if (IS_TRACE_ENABLED)
+        {
+            TRACE("Heartbeat of %d kicked %u ms ago", procId, elapsedMs);
+        }
+        RestartHeartbeatWatchdog(watchDogPtr, elapsedMs);
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The handler of the sweep of the heartbeats.
+ */
+//--------------------------------------------------------------------------------------------------
+static void HeartbeatSweepHandler
+(
+    le_timer_Ref_t timerRef
+)
+{
+    le_hashmap_ForEach(HeartbeatRefs, SweepHeartbeat, NULL);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
 * Resets the watchdog for the client that has kicked us. This function must be called from within
@@ -1208,6 +1466,59 @@ le_result_t le_wdog_GetMaxWatchdogTimeout
     return LE_NOT_FOUND;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the shared memory heartbeat of this process, to kick the watchdog without IPC messages.
+ * The heartbeat is created on the first call, and released when the session it was obtained on
+ * closes.
+ *
+ * @return
+ *      - LE_OK            The file descriptor of the heartbeat is returned
+ *      - LE_FAULT         The heartbeat could not be created
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_wdog_GetHeartbeat
+(
+    int* heartbeatFdPtr
+        ///< [OUT] File descriptor of the heartbeat, to map read-write.
+)
+{
+    pid_t clientProcId;
+    le_msg_SessionRef_t sessionRef = le_wdog_GetClientSessionRef();
+
+    if (heartbeatFdPtr == NULL)
+    {
+        LE_KILL_CLIENT("heartbeatFdPtr is NULL.");
+        return LE_FAULT;
+    }
+    *heartbeatFdPtr = -1;
+
+    if (LE_OK != le_msg_GetClientProcessId(sessionRef, &clientProcId))
+    {
+        LE_WARN("Can't find client Id. The client may have closed the session.");
+        return LE_FAULT;
+    }
+
+    HeartbeatObj_t* heartbeatPtr = le_hashmap_Get(HeartbeatRefs, &clientProcId);
+    if (heartbeatPtr == NULL)
+    {
+        heartbeatPtr = CreateHeartbeat(clientProcId, sessionRef);
+        if (heartbeatPtr == NULL)
+        {
+            return LE_FAULT;
+        }
+    }
+
+    *heartbeatFdPtr = dup(heartbeatPtr->fd);
+    if (*heartbeatFdPtr < 0)
+    {
+        LE_ERROR("Failed to duplicate heartbeat file descriptor (%m)");
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Signal to the supervisor that we are set up and ready
@@ -1265,6 +1576,14 @@ static le_result_t InitializeTimerContainer
     LE_ASSERT(NULL != MandatoryWatchdogRefs);
     le_hashmap_MakeTraceable(MandatoryWatchdogRefs);
 
+    HeartbeatPool = le_mem_CreatePool("WdogHeartbeatPool", sizeof(HeartbeatObj_t));
+    HeartbeatRefs = le_hashmap_Create(
+        "wdog_heartbeatRefs",
+        LE_WDOG_HASTABLE_WIDTH,
+        le_hashmap_HashUInt32,
+        le_hashmap_EqualsUInt32);
+    LE_ASSERT(NULL != HeartbeatRefs);
+
     return LE_OK;
 }
 
@@ -1528,5 +1847,12 @@ COMPONENT_INIT
     le_timer_Start(DefaultExternalWdogTimer);
     pa_wdog_Init();
 
+    // The sweep of the heartbeats is started with the first heartbeat.
+    HeartbeatSweepTimer = le_timer_Create("HeartbeatSweepTimer");
+    le_timer_SetMsInterval(HeartbeatSweepTimer, HEARTBEAT_SWEEP_INTERVAL);
+    le_timer_SetHandler(HeartbeatSweepTimer, HeartbeatSweepHandler);
+    le_timer_SetRepeat(HeartbeatSweepTimer, 0); // repeat indefinitely
+    le_timer_SetWakeup(HeartbeatSweepTimer, false);
+
     LE_INFO("The watchdog service is ready");
 }
@@ -392,6 +392,21 @@ typedef struct le_log_Session* le_log_SessionRef_t;
 
 typedef struct le_log_Trace* le_log_TraceRef_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log call site: what is known of a log message at compile time.  Each LE_DEBUG, LE_INFO, etc.
+ * has its own, statically allocated, so that only its address is passed when the message is sent.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_log_Level_t level;               ///< Severity level.
+    const char* filenamePtr;            ///< Name of the source file.
+    const char* functionNamePtr;        ///< Name of the function.
+    unsigned int lineNumber;            ///< Line number in the source file.
+}
+_le_log_Site_t;
+
 void _le_log_Send
 (
     const le_log_Level_t level,
@@ -404,6 +419,14 @@ void _le_log_Send
     ...
 ) __attribute__ ((format (printf, 7, 8)));
 
+void _le_log_SendSite
+(
+    const _le_log_Site_t* sitePtr,
+    le_log_SessionRef_t logSession,
+    const char* formatPtr,
+    ...
+) __attribute__ ((format (printf, 3, 4)));
+
 le_log_TraceRef_t _le_log_GetTraceRef
 (
     le_log_SessionRef_t logSession,
@@ -459,13 +482,19 @@ LE_SHARED le_log_Level_t* LE_LOG_LEVEL_FILTER_PTR;
 //--------------------------------------------------------------------------------------------------
 /**
  * Internal macro to filter out messages that do not meet the current filtering level.
+ *
+ * The file, function, line and level of the message are in a static call site descriptor, so a
+ * message filtered out costs a relaxed load of the filtering level, and a message sent passes only
+ * the address of the descriptor besides its format and arguments.
  */
 //--------------------------------------------------------------------------------------------------
 #define _LE_LOG_MSG(level, formatString, ...) \
     do { \
-        if ((LE_LOG_LEVEL_FILTER_PTR == NULL) || (level >= *LE_LOG_LEVEL_FILTER_PTR)) \
-            _le_log_Send(level, NULL, LE_LOG_SESSION, STRINGIZE(LE_FILENAME), __func__, __LINE__, \
-                    formatString, ##__VA_ARGS__); \
+        static const _le_log_Site_t _le_log_site = \
+            { level, STRINGIZE(LE_FILENAME), __func__, __LINE__ }; \
+        if ((LE_LOG_LEVEL_FILTER_PTR == NULL) || \
+            (level >= __atomic_load_n(LE_LOG_LEVEL_FILTER_PTR, __ATOMIC_RELAXED))) \
+            _le_log_SendSite(&_le_log_site, LE_LOG_SESSION, formatString, ##__VA_ARGS__); \
     } while(0)
 
 
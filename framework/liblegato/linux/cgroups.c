@@ -63,6 +63,22 @@ static const char* SubSysName[CGRP_NUM_SUBSYSTEMS] = {"cpu,cpuacct", "memory", "
 #define MEM_LIMIT_FILENAME          "memory.limit_in_bytes"
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cpu usage file.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CPU_USAGE_FILENAME          "cpuacct.usage"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory usage file.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MEM_USAGE_FILENAME          "memory.usage_in_bytes"
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Freeze state file.
@@ -1062,3 +1078,96 @@ ssize_t cgrp_GetMaxMemUsed
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Opens the CPU usage counter of a cgroup: the total CPU time used by its tasks, in nanoseconds.
+ * The counter can then be read any number of times with cgrp_ReadCounter(), without opening it
+ * again.
+ *
+ * @return
+ *      The file descriptor of the counter, to be closed by the caller.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+int cgrp_cpu_OpenUsage
+(
+    const char* cgroupNamePtr       ///< [IN] Name of the cgroup.
+)
+{
+    int fd = OpenCgrpFile(CGRP_SUBSYS_CPU, cgroupNamePtr, CPU_USAGE_FILENAME,
+                          O_RDONLY | O_CLOEXEC);
+
+    return (fd < 0) ? LE_FAULT : fd;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Opens the memory usage counter of a cgroup: the memory used by its tasks, in bytes.  The counter
+ * can then be read any number of times with cgrp_ReadCounter(), without opening it again.
+ *
+ * @return
+ *      The file descriptor of the counter, to be closed by the caller.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+int cgrp_mem_OpenUsage
+(
+    const char* cgroupNamePtr       ///< [IN] Name of the cgroup.
+)
+{
+    int fd = OpenCgrpFile(CGRP_SUBSYS_MEM, cgroupNamePtr, MEM_USAGE_FILENAME,
+                          O_RDONLY | O_CLOEXEC);
+
+    return (fd < 0) ? LE_FAULT : fd;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads the current value of a cgroup counter opened with cgrp_cpu_OpenUsage() or
+ * cgrp_mem_OpenUsage().
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t cgrp_ReadCounter
+(
+    int fd,                         ///< [IN] File descriptor of the counter.
+    uint64_t* valuePtr              ///< [OUT] Value of the counter.
+)
+{
+    char buffer[MAX_DIGITS];
+    ssize_t numBytesRead;
+
+    // The kernel regenerates the content of the file on each read from its start.
+    do
+    {
+        numBytesRead = pread(fd, buffer, sizeof(buffer) - 1, 0);
+    }
+    while ((numBytesRead == -1) && (errno == EINTR));
+
+    if (numBytesRead <= 0)
+    {
+        LE_ERROR("Could not read cgroup counter.  %m.");
+        return LE_FAULT;
+    }
+
+    buffer[numBytesRead] = '\0';
+
+    char* endPtr;
+    errno = 0;
+    unsigned long long value = strtoull(buffer, &endPtr, 10);
+
+    if ((errno != 0) || (endPtr == buffer))
+    {
+        LE_ERROR("Invalid cgroup counter value '%s'.", buffer);
+        return LE_FAULT;
+    }
+
+    *valuePtr = value;
+
+    return LE_OK;
+}
@@ -435,4 +435,51 @@ ssize_t cgrp_GetMaxMemUsed
     const char* cgroupNamePtr       ///< [IN] Name of the cgroup.
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Opens the CPU usage counter of a cgroup: the total CPU time used by its tasks, in nanoseconds.
+ * The counter can then be read any number of times with cgrp_ReadCounter(), without opening it
+ * again.
+ *
+ * @return
+ *      The file descriptor of the counter, to be closed by the caller.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+int cgrp_cpu_OpenUsage
+(
+    const char* cgroupNamePtr       ///< [IN] Name of the cgroup.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Opens the memory usage counter of a cgroup: the memory used by its tasks, in bytes.  The counter
+ * can then be read any number of times with cgrp_ReadCounter(), without opening it again.
+ *
+ * @return
+ *      The file descriptor of the counter, to be closed by the caller.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+int cgrp_mem_OpenUsage
+(
+    const char* cgroupNamePtr       ///< [IN] Name of the cgroup.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads the current value of a cgroup counter opened with cgrp_cpu_OpenUsage() or
+ * cgrp_mem_OpenUsage().
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t cgrp_ReadCounter
+(
+    int fd,                         ///< [IN] File descriptor of the counter.
+    uint64_t* valuePtr              ///< [OUT] Value of the counter.
+);
+
 #endif // LEGATO_SRC_CGROUPS_INCLUDE_GUARD
@@ -99,6 +99,7 @@
 #include "fdMonitor.h"
 #include "limit.h"
 #include "fileDescriptor.h"
+#include "stats.h"
 
 #include <pthread.h>
 #include <sys/eventfd.h>
@@ -589,6 +590,9 @@ static void ProcessOneEventReport
         return;
     }
 
+    stats_Dec(STATS_EVENT_QUEUE_DEPTH);
+    stats_Inc(STATS_EVENTS_PROCESSED);
+
     // Convert the link pointer into a pointer to the Report base class.
     reportObjPtr = CONTAINER_OF(linkPtr, Report_t, link);
 
@@ -742,6 +746,7 @@ static void QueueFunction
 
     // Queue it to the Event Queue.
     le_sls_Queue(&perThreadRecPtr->eventQueue, &reportPtr->baseClass.link);
+    stats_Inc(STATS_EVENT_QUEUE_DEPTH);
 
     // Write to the eventfd to notify the Event Loop that there is something on the queue.
     WriteEventFd(perThreadRecPtr);
@@ -950,6 +955,8 @@ void event_DestructThread
     {
         Report_t* reportPtr = CONTAINER_OF(singleLinkPtr, Report_t, link);
 
+        stats_Dec(STATS_EVENT_QUEUE_DEPTH);
+
         // If it is carrying a pointer to a reference-counted object from a memory pool,
         // release that thing first.
         if (reportPtr->type == LE_EVENT_REPORT_COUNTED_REF)
@@ -1222,6 +1229,7 @@ void le_event_Report
         memset(reportObjPtr->payload, 0, eventPtr->payloadSize);
         memcpy(reportObjPtr->payload, payloadPtr, payloadSize);
         le_sls_Queue(&perThreadRecPtr->eventQueue, &reportObjPtr->baseClass.link);
+        stats_Inc(STATS_EVENT_QUEUE_DEPTH);
 
         // Increment the eventfd for the handler's thread's Event Queue.
         // This will wake up the thread and tell it that it has something on its Event Queue.
@@ -1283,6 +1291,7 @@ void le_event_ReportWithRefCounting
         reportObjPtr->payload[0] = objectPtr;
         le_mem_AddRef(objectPtr);
         le_sls_Queue(&perThreadRecPtr->eventQueue, &reportObjPtr->baseClass.link);
+        stats_Inc(STATS_EVENT_QUEUE_DEPTH);
 
         // Increment the eventfd for the handler's thread's Event Queue.
         // This will wake up the thread and tell it that it has something on its Event Queue.
@@ -23,6 +23,7 @@
 #include "pipeline.h"
 #include "atomFile.h"
 #include "fs.h"
+#include "stats.h"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -52,6 +53,7 @@ __attribute__((constructor)) void _legato_InitFramework
 
     mem_Init();
     log_Init();        // Uses memory pools.
+    stats_Init();      // Counters may already be in use by memory pools.
     sig_Init();        // Uses memory pools.
     safeRef_Init();    // Uses memory pools and hash maps.
     pathIter_Init();   // Uses memory pools and safe references.
@@ -12,6 +12,9 @@
 #include "logDaemon/logDaemon.h"
 #include "limit.h"
 #include "messagingSession.h"
+#include "logRing.h"
+#include "fileDescriptor.h"
+#include <sys/syscall.h>
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -98,6 +101,32 @@ static LogSession_t DefaultLogSession =    {
                                         };
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log ring of the Log Control Daemon the messages are also appended to, or NULL if not received
+ * yet.  Set only once.
+ */
+//--------------------------------------------------------------------------------------------------
+static logRing_Ref_t LogRingRef = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Thread ID of the calling thread, recorded in the log ring.  0 until first used by the thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static __thread pid_t ThreadId = 0;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Process ID ThreadId was read in, 0 until then.  A child created by fork() inherits the cached
+ * ThreadId of the forking thread, so it is read again when the process ID no longer matches.
+ */
+//--------------------------------------------------------------------------------------------------
+static __thread pid_t ThreadIdPid = 0;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * A keyword object that contains the keyword string and can be attached to the keyword list.
@@ -374,8 +403,8 @@ static void SetLogLevelFilter
 
     if (sessionPtr)
     {
-        // Set this component's level.
-        sessionPtr->level = levelFilter;
+        // Set this component's level.  The log macros read it without locking the mutex.
+        __atomic_store_n(&sessionPtr->level, levelFilter, __ATOMIC_RELAXED);
     }
 
     Unlock();
@@ -724,13 +753,20 @@ static void RegisterWithLogControlDaemon
         // log settings get applied before the component initialization functions run.
         msgRef = le_msg_RequestSyncResponse(msgRef);
 
-        // The response has no payload.
+        // The response has no payload, but may carry the log ring.
         if (msgRef == NULL)
         {
             LE_ERROR("Log session registration failed!");
         }
         else
         {
+            int fd = le_msg_GetFd(msgRef);
+
+            if (fd >= 0)
+            {
+                log_UseRing(fd);
+            }
+
             le_msg_ReleaseMsg(msgRef);
         }
     }
@@ -1019,10 +1055,60 @@ static int ConvertToSyslogLevel
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Builds the log message and sends it to the logging system.
+ * Gets the current time, in nanoseconds of the real-time clock, for the log ring.
  */
 //--------------------------------------------------------------------------------------------------
-void _le_log_Send
+static uint64_t GetRingTimestamp
+(
+    void
+)
+{
+    struct timespec now;
+
+    if (clock_gettime(CLOCK_REALTIME, &now) != 0)
+    {
+        return 0;
+    }
+
+    return ((uint64_t)now.tv_sec * 1000000000) + now.tv_nsec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts appending the log messages of this process to the log ring of the Log Control Daemon,
+ * in addition to syslog.  Only the first ring given is used.
+ */
+//--------------------------------------------------------------------------------------------------
+void log_UseRing
+(
+    int fd          ///< [IN] File descriptor of the log ring.  Closed by this function.
+)
+{
+    if (__atomic_load_n(&LogRingRef, __ATOMIC_ACQUIRE) == NULL)
+    {
+        logRing_Ref_t ringRef = logRing_Map(fd, true);
+        logRing_Ref_t expectedRef = NULL;
+
+        // Another thread may have published a ring since the check above; keep that one.
+        if ((ringRef != NULL) &&
+            !__atomic_compare_exchange_n(&LogRingRef, &expectedRef, ringRef, false,
+                                         __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        {
+            logRing_Unmap(ringRef);
+        }
+    }
+
+    fd_Close(fd);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Builds the log message from its format and arguments and sends it to the logging system.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendMsg
 (
     const le_log_Level_t level,         // The severity level. Set to -1 if this is a Trace log.
     const le_log_TraceRef_t traceRef,   // The Trace reference. Set to NULL if this is not a Trace log.
@@ -1030,7 +1116,8 @@ void _le_log_Send
     const char* filenamePtr,            // The name of the source file that logged the message.
     const char* functionNamePtr,        // The name of the function that logged the message.
     const unsigned int lineNumber,      // The line number in the source file that logged the message.
-    const char* formatPtr, ...          // The user message format and options.
+    const char* formatPtr,              // The user message format.
+    va_list varParams                   // The user message options.
 )
 {
     // Save the current errno to be used in the log message because some of the system calls below
@@ -1054,6 +1141,7 @@ void _le_log_Send
 
     // Get either the log level or the trace keyword.
     const char* levelPtr;
+    bool isTrace = false;
 
     if ( (level <= LOG_DEBUG) && (level >= LOG_EMERG) )
     {
@@ -1068,6 +1156,7 @@ void _le_log_Send
 
         // Add the trace keyword.
         levelPtr = keywordObjPtr->keyword;
+        isTrace = true;
     }
 
     // Get the component name.
@@ -1090,9 +1179,6 @@ void _le_log_Send
     // Get the user message.
     char msg[MAX_MSG_SIZE] = "";
 
-    va_list varParams;
-    va_start(varParams, formatPtr);
-
     // Reset the errno to ensure that we report the proper errno value.
     errno = savedErrno;
 
@@ -1100,7 +1186,41 @@ void _le_log_Send
     // it.  If there was a truncation then that'll just show up in the logs.
     vsnprintf(msg, sizeof(msg), formatPtr, varParams);
 
-    va_end(varParams);
+    // Also append the message to the log ring, as a structured record.
+    logRing_Ref_t ringRef = __atomic_load_n(&LogRingRef, __ATOMIC_ACQUIRE);
+
+    if (ringRef != NULL)
+    {
+        char traceMsg[MAX_MSG_SIZE];
+        pid_t pid = getpid();
+
+        if (ThreadIdPid != pid)
+        {
+            ThreadId = syscall(SYS_gettid);
+            ThreadIdPid = pid;
+        }
+
+        logRing_Entry_t entry = {
+                                    .timestampNs = GetRingTimestamp(),
+                                    .pid = pid,
+                                    .tid = ThreadId,
+                                    .level = level,
+                                    .procNamePtr = procNamePtr,
+                                    .compNamePtr = compNamePtr,
+                                    .msgPtr = msg
+                                };
+
+        // Traces have their keyword instead of a severity level.
+        if (isTrace)
+        {
+            snprintf(traceMsg, sizeof(traceMsg), "%s: %s", levelPtr, msg);
+            entry.level = LOGRING_LEVEL_TRACE;
+            entry.msgPtr = traceMsg;
+        }
+
+        entry.msgLen = strlen(entry.msgPtr);
+        logRing_Append(ringRef, &entry, 1);
+    }
 
     // If running on an embedded target, write the message out to the log.
 #ifdef LEGATO_EMBEDDED
@@ -1132,6 +1252,54 @@ void _le_log_Send
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Builds the log message and sends it to the logging system.
+ */
+//--------------------------------------------------------------------------------------------------
+void _le_log_Send
+(
+    const le_log_Level_t level,         // The severity level. Set to -1 if this is a Trace log.
+    const le_log_TraceRef_t traceRef,   // The Trace reference. Set to NULL if this is not a Trace log.
+    le_log_SessionRef_t logSession,     // The log session.
+    const char* filenamePtr,            // The name of the source file that logged the message.
+    const char* functionNamePtr,        // The name of the function that logged the message.
+    const unsigned int lineNumber,      // The line number in the source file that logged the message.
+    const char* formatPtr, ...          // The user message format and options.
+)
+{
+    va_list varParams;
+    va_start(varParams, formatPtr);
+
+    SendMsg(level, traceRef, logSession, filenamePtr, functionNamePtr, lineNumber, formatPtr,
+            varParams);
+
+    va_end(varParams);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Builds the log message of a log call site and sends it to the logging system.
+ */
+//--------------------------------------------------------------------------------------------------
+void _le_log_SendSite
+(
+    const _le_log_Site_t* sitePtr,      // The log call site.
+    le_log_SessionRef_t logSession,     // The log session.
+    const char* formatPtr, ...          // The user message format and options.
+)
+{
+    va_list varParams;
+    va_start(varParams, formatPtr);
+
+    SendMsg(sitePtr->level, NULL, logSession, sitePtr->filenamePtr, sitePtr->functionNamePtr,
+            sitePtr->lineNumber, formatPtr, varParams);
+
+    va_end(varParams);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get a null-terminated, printable string representing an le_result_t value.
@@ -1251,7 +1419,7 @@ void _le_log_SetFilterLevel
 //--------------------------------------------------------------------------------------------------
 {
     LE_ASSERT(logSession != NULL);
-    logSession->level = level;
+    __atomic_store_n(&logSession->level, level, __ATOMIC_RELAXED);
 }
 
 
@@ -1351,6 +1519,48 @@ void log_LogGenericMsg
     const char* msgPtr          ///< [IN] Message.
 )
 {
+    // Append each line of the message to the log ring, in batches of at most LOGRING_MAX_BATCH.
+    logRing_Ref_t ringRef = __atomic_load_n(&LogRingRef, __ATOMIC_ACQUIRE);
+
+    if (ringRef != NULL)
+    {
+        logRing_Entry_t entries[LOGRING_MAX_BATCH];
+        uint64_t timestampNs = GetRingTimestamp();
+        const char* linePtr = msgPtr;
+        size_t numEntries = 0;
+
+        while (*linePtr != '\0')
+        {
+            const char* endPtr = strchrnul(linePtr, '\n');
+
+            if (endPtr > linePtr)
+            {
+                entries[numEntries].timestampNs = timestampNs;
+                entries[numEntries].pid = pid;
+                entries[numEntries].tid = 0;
+                entries[numEntries].level = level;
+                entries[numEntries].procNamePtr = procNamePtr;
+                entries[numEntries].compNamePtr = "";
+                entries[numEntries].msgPtr = linePtr;
+                entries[numEntries].msgLen = endPtr - linePtr;
+                numEntries++;
+
+                if (numEntries == LOGRING_MAX_BATCH)
+                {
+                    logRing_Append(ringRef, entries, numEntries);
+                    numEntries = 0;
+                }
+            }
+
+            linePtr = (*endPtr == '\n') ? (endPtr + 1) : endPtr;
+        }
+
+        if (numEntries > 0)
+        {
+            logRing_Append(ringRef, entries, numEntries);
+        }
+    }
+
     // Write the message out to the log.
 #ifdef LEGATO_EMBEDDED
 
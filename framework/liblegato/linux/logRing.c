@@ -0,0 +1,565 @@
+//--------------------------------------------------------------------------------------------------
+/** @file logRing.c
+ *
+ * Binary log ring.
+ *
+ * The file of the ring starts with a header, followed by a power of two number of slots.  Every
+ * slot starts with a stamp: 0 if the slot was never written, the index of the slot (counted from
+ * the creation of the ring) plus one if it is the first slot of a record, or the same with
+ * CONTINUATION_FLAG set if it is one of the following slots.  The first slot holds the header of
+ * the record, followed by the process name, the component name and the message, without null
+ * terminators; they go on in the following slots.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "logRing.h"
+#include "fileDescriptor.h"
+#include <sys/mman.h>
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Bytes of record data in a slot, after its stamp.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SLOT_DATA_BYTES         (LOGRING_SLOT_BYTES - sizeof(uint64_t))
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Flag set in the stamp of the slots that follow the first slot of a record.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CONTINUATION_FLAG       (UINT64_C(1) << 63)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of slots of a record: enough for the longest names and message.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_RECORD_SLOTS        8
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Minimum number of slots of a ring, so that a batch of the longest records always fits in it.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MIN_RING_SLOTS          1024
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Name of the memory file of a ring.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RING_MEMFD_NAME         "LegatoLogRing"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header of the ring, at the start of its file.  Takes one slot.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t magic;                 ///< LOGRING_MAGIC.
+    uint32_t version;               ///< LOGRING_VERSION.
+    uint32_t numSlots;              ///< Number of slots, a power of two.
+    uint32_t slotBytes;             ///< LOGRING_SLOT_BYTES.
+    uint64_t head;                  ///< Number of slots reserved since the ring was created.
+    uint8_t  reserved[LOGRING_SLOT_BYTES - 24];
+}
+RingHeader_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Slot of the ring.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t stamp;                 ///< Index of the slot plus one, once written.
+    uint8_t  data[SLOT_DATA_BYTES]; ///< Record data.
+}
+Slot_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header of a record, at the start of the data of its first slot.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t timestampNs;           ///< Time stamp, in nanoseconds.
+    int32_t  pid;                   ///< PID of the process.
+    int32_t  tid;                   ///< Thread ID, or 0.
+    uint16_t msgLen;                ///< Length of the message.
+    uint8_t  level;                 ///< Level, or LOGRING_LEVEL_TRACE.
+    uint8_t  numSlots;              ///< Number of slots of the record.
+    uint8_t  procNameLen;           ///< Length of the process name.
+    uint8_t  compNameLen;           ///< Length of the component name.
+    uint8_t  reserved[2];
+}
+RecordHeader_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mapped ring.  The size of the ring is kept here, as the header can be written by every process
+ * the ring is shared with.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct logRing_Ring
+{
+    RingHeader_t*   headerPtr;      ///< Mapped header, followed by the slots.
+    Slot_t*         slotsPtr;       ///< Mapped slots.
+    size_t          mapBytes;       ///< Size of the mapping.
+    uint32_t        numSlots;       ///< Number of slots.
+}
+Ring_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the number of slots a record takes.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline size_t NumRecordSlots
+(
+    size_t textBytes        ///< [IN] Bytes of names and message of the record.
+)
+{
+    return (sizeof(RecordHeader_t) + textBytes + SLOT_DATA_BYTES - 1) / SLOT_DATA_BYTES;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes a record to the slots reserved for it, then commits it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteRecord
+(
+    Ring_t* ringPtr,                    ///< [IN] The ring.
+    uint64_t index,                     ///< [IN] Index of the first slot of the record.
+    const logRing_Entry_t* entryPtr,    ///< [IN] The record.
+    const RecordHeader_t* headerPtr     ///< [IN] Header of the record, with the lengths.
+)
+{
+    uint8_t buffer[MAX_RECORD_SLOTS * SLOT_DATA_BYTES];
+    uint64_t mask = ringPtr->numSlots - 1;
+    size_t offset = sizeof(RecordHeader_t);
+    size_t i;
+
+    memcpy(buffer, headerPtr, sizeof(RecordHeader_t));
+    memcpy(buffer + offset, entryPtr->procNamePtr, headerPtr->procNameLen);
+    offset += headerPtr->procNameLen;
+    memcpy(buffer + offset, entryPtr->compNamePtr, headerPtr->compNameLen);
+    offset += headerPtr->compNameLen;
+    memcpy(buffer + offset, entryPtr->msgPtr, headerPtr->msgLen);
+
+    // The first slot is written last: its stamp commits the record.
+    for (i = headerPtr->numSlots - 1; i > 0; i--)
+    {
+        Slot_t* slotPtr = &ringPtr->slotsPtr[(index + i) & mask];
+
+        memcpy(slotPtr->data, buffer + (i * SLOT_DATA_BYTES), SLOT_DATA_BYTES);
+        __atomic_store_n(&slotPtr->stamp, (index + i + 1) | CONTINUATION_FLAG, __ATOMIC_RELAXED);
+    }
+
+    Slot_t* slotPtr = &ringPtr->slotsPtr[index & mask];
+
+    memcpy(slotPtr->data, buffer, SLOT_DATA_BYTES);
+    __atomic_store_n(&slotPtr->stamp, index + 1, __ATOMIC_RELEASE);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads the record starting at a slot.
+ *
+ * @return
+ *      - LE_OK if the record was read.
+ *      - LE_NOT_FOUND if there is no committed record starting at this slot.
+ *      - LE_OVERFLOW if the record was overwritten while it was being read.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadRecord
+(
+    Ring_t* ringPtr,                    ///< [IN] The ring.
+    uint64_t index,                     ///< [IN] Index of the slot.
+    logRing_Record_t* recordPtr,        ///< [OUT] The record.
+    size_t* numSlotsPtr                 ///< [OUT] Number of slots of the record.
+)
+{
+    uint8_t buffer[MAX_RECORD_SLOTS * SLOT_DATA_BYTES];
+    uint64_t mask = ringPtr->numSlots - 1;
+    Slot_t* slotPtr = &ringPtr->slotsPtr[index & mask];
+    RecordHeader_t header;
+    size_t i;
+
+    if (__atomic_load_n(&slotPtr->stamp, __ATOMIC_ACQUIRE) != index + 1)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    memcpy(buffer, slotPtr->data, SLOT_DATA_BYTES);
+    memcpy(&header, buffer, sizeof(header));
+
+    size_t textBytes = header.procNameLen + header.compNameLen + header.msgLen;
+    bool isValid = (header.procNameLen <= LIMIT_MAX_PROCESS_NAME_LEN) &&
+                   (header.compNameLen <= LIMIT_MAX_COMPONENT_NAME_LEN) &&
+                   (header.msgLen < LOGRING_MAX_MSG_BYTES) &&
+                   (header.numSlots == NumRecordSlots(textBytes));
+
+    for (i = 1; isValid && (i < header.numSlots); i++)
+    {
+        slotPtr = &ringPtr->slotsPtr[(index + i) & mask];
+        isValid = (__atomic_load_n(&slotPtr->stamp, __ATOMIC_RELAXED) ==
+                   ((index + i + 1) | CONTINUATION_FLAG));
+        memcpy(buffer + (i * SLOT_DATA_BYTES), slotPtr->data, SLOT_DATA_BYTES);
+    }
+
+    // A writer reserves slots before writing to them, so if the head doesn't show that the first
+    // slot was reserved again, nothing read above was overwritten.
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&ringPtr->headerPtr->head, __ATOMIC_RELAXED) > index + ringPtr->numSlots)
+    {
+        return LE_OVERFLOW;
+    }
+
+    if (!isValid)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    size_t offset = sizeof(RecordHeader_t);
+
+    recordPtr->index = index;
+    recordPtr->timestampNs = header.timestampNs;
+    recordPtr->pid = header.pid;
+    recordPtr->tid = header.tid;
+    recordPtr->level = header.level;
+    memcpy(recordPtr->procName, buffer + offset, header.procNameLen);
+    recordPtr->procName[header.procNameLen] = '\0';
+    offset += header.procNameLen;
+    memcpy(recordPtr->compName, buffer + offset, header.compNameLen);
+    recordPtr->compName[header.compNameLen] = '\0';
+    offset += header.compNameLen;
+    memcpy(recordPtr->msg, buffer + offset, header.msgLen);
+    recordPtr->msg[header.msgLen] = '\0';
+
+    *numSlotsPtr = header.numSlots;
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether a record matches a filter.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsMatching
+(
+    const logRing_Record_t* recordPtr,  ///< [IN] The record.
+    const logRing_Filter_t* filterPtr   ///< [IN] The filter.
+)
+{
+    if (recordPtr->level == LOGRING_LEVEL_TRACE)
+    {
+        if (filterPtr->minLevel > LE_LOG_DEBUG)
+        {
+            return false;
+        }
+    }
+    else if (recordPtr->level < filterPtr->minLevel)
+    {
+        return false;
+    }
+
+    return (recordPtr->timestampNs >= filterPtr->sinceNs) &&
+           ((filterPtr->pid == 0) || (recordPtr->pid == filterPtr->pid)) &&
+           ((filterPtr->procNamePtr == NULL) ||
+            (strcmp(recordPtr->procName, filterPtr->procNamePtr) == 0)) &&
+           ((filterPtr->compNamePtr == NULL) ||
+            (strcmp(recordPtr->compName, filterPtr->compNamePtr) == 0));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates the file of a new, empty log ring.  Its size is sealed, so that the processes it is
+ * shared with can't truncate it under the feet of the others.
+ *
+ * @return
+ *      The file descriptor of the ring, or -1 on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+int logRing_Create
+(
+    size_t size     ///< [IN] Size of the ring, in bytes.  Rounded down to a power of two slots.
+)
+{
+    RingHeader_t header;
+    uint32_t numSlots = MIN_RING_SLOTS;
+
+    // The layout must hold the longest record.
+    LE_ASSERT((sizeof(RingHeader_t) == LOGRING_SLOT_BYTES) &&
+              (sizeof(Slot_t) == LOGRING_SLOT_BYTES) &&
+              (NumRecordSlots(LIMIT_MAX_PROCESS_NAME_LEN + LIMIT_MAX_COMPONENT_NAME_LEN +
+                              LOGRING_MAX_MSG_BYTES - 1) <= MAX_RECORD_SLOTS));
+
+    while ((numSlots < (UINT32_C(1) << 31)) && ((size_t)numSlots * 2 * LOGRING_SLOT_BYTES <= size))
+    {
+        numSlots *= 2;
+    }
+
+    int fd = memfd_create(RING_MEMFD_NAME, MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0)
+    {
+        LE_ERROR("Failed to create log ring (%m).");
+        return -1;
+    }
+
+    memset(&header, 0, sizeof(header));
+    header.magic = LOGRING_MAGIC;
+    header.version = LOGRING_VERSION;
+    header.numSlots = numSlots;
+    header.slotBytes = LOGRING_SLOT_BYTES;
+
+    // The slots are zero-filled: none of them was written.
+    if ((ftruncate(fd, sizeof(RingHeader_t) + ((off_t)numSlots * LOGRING_SLOT_BYTES)) != 0) ||
+        (pwrite(fd, &header, sizeof(header), 0) != sizeof(header)) ||
+        (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0))
+    {
+        LE_ERROR("Failed to set up log ring of %" PRIu32 " slots (%m).", numSlots);
+        fd_Close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maps a log ring.  The file descriptor can be closed once mapped.
+ *
+ * @return
+ *      A reference to the mapped ring, or NULL if the file is not a valid log ring.
+ */
+//--------------------------------------------------------------------------------------------------
+logRing_Ref_t logRing_Map
+(
+    int fd,             ///< [IN] File descriptor of the ring.
+    bool isWritable     ///< [IN] true to append to the ring, false to only query it.
+)
+{
+    RingHeader_t header;
+    struct stat fileStat;
+
+    // Only a ring whose size can't change is safe to map: it can't be truncated under our feet.
+    int seals = fcntl(fd, F_GET_SEALS);
+    if ((seals < 0) || ((seals & (F_SEAL_SHRINK | F_SEAL_GROW)) != (F_SEAL_SHRINK | F_SEAL_GROW)))
+    {
+        LE_ERROR("Log ring is not sealed.");
+        return NULL;
+    }
+
+    if ((fstat(fd, &fileStat) != 0) || (pread(fd, &header, sizeof(header), 0) != sizeof(header)))
+    {
+        LE_ERROR("Failed to read log ring header (%m).");
+        return NULL;
+    }
+
+    if ((header.magic != LOGRING_MAGIC) || (header.version != LOGRING_VERSION) ||
+        (header.slotBytes != LOGRING_SLOT_BYTES) || (header.numSlots < MIN_RING_SLOTS) ||
+        ((header.numSlots & (header.numSlots - 1)) != 0) ||
+        (fileStat.st_size != sizeof(RingHeader_t) + ((off_t)header.numSlots * LOGRING_SLOT_BYTES)))
+    {
+        LE_ERROR("Bad log ring (magic 0x%08" PRIx32 ", version %" PRIu32 ", %" PRIu32 " slots).",
+                 header.magic, header.version, header.numSlots);
+        return NULL;
+    }
+
+    size_t mapBytes = fileStat.st_size;
+    void* mapPtr = mmap(NULL, mapBytes, isWritable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                        MAP_SHARED, fd, 0);
+    if (mapPtr == MAP_FAILED)
+    {
+        LE_ERROR("Failed to map log ring (%m).");
+        return NULL;
+    }
+
+    Ring_t* ringPtr = malloc(sizeof(Ring_t));
+    LE_ASSERT(ringPtr != NULL);
+
+    ringPtr->headerPtr = mapPtr;
+    ringPtr->slotsPtr = (Slot_t*)(ringPtr->headerPtr + 1);
+    ringPtr->mapBytes = mapBytes;
+    ringPtr->numSlots = header.numSlots;
+
+    return ringPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unmaps a log ring.
+ */
+//--------------------------------------------------------------------------------------------------
+void logRing_Unmap
+(
+    logRing_Ref_t ringRef   ///< [IN] The ring.
+)
+{
+    munmap(ringRef->headerPtr, ringRef->mapBytes);
+    free(ringRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the size of a log ring.
+ *
+ * @return
+ *      The number of bytes of records the ring can hold.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t logRing_GetSize
+(
+    logRing_Ref_t ringRef   ///< [IN] The ring.
+)
+{
+    return (size_t)ringRef->numSlots * LOGRING_SLOT_BYTES;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Appends a batch of records to a log ring.  May be called from any thread of any process the
+ * ring is shared with.
+ */
+//--------------------------------------------------------------------------------------------------
+void logRing_Append
+(
+    logRing_Ref_t ringRef,                  ///< [IN] The ring (mapped writable).
+    const logRing_Entry_t* entriesPtr,      ///< [IN] The records.
+    size_t numEntries                       ///< [IN] Number of records, at most
+                                            ///       LOGRING_MAX_BATCH.
+)
+{
+    RecordHeader_t headers[LOGRING_MAX_BATCH];
+    uint64_t totalSlots = 0;
+    size_t i;
+
+    LE_ASSERT(numEntries <= LOGRING_MAX_BATCH);
+
+    for (i = 0; i < numEntries; i++)
+    {
+        const logRing_Entry_t* entryPtr = &entriesPtr[i];
+        RecordHeader_t* headerPtr = &headers[i];
+
+        memset(headerPtr, 0, sizeof(RecordHeader_t));
+        headerPtr->timestampNs = entryPtr->timestampNs;
+        headerPtr->pid = entryPtr->pid;
+        headerPtr->tid = entryPtr->tid;
+        headerPtr->level = entryPtr->level;
+        headerPtr->procNameLen = strnlen(entryPtr->procNamePtr, LIMIT_MAX_PROCESS_NAME_LEN);
+        headerPtr->compNameLen = strnlen(entryPtr->compNamePtr, LIMIT_MAX_COMPONENT_NAME_LEN);
+        headerPtr->msgLen = (entryPtr->msgLen < LOGRING_MAX_MSG_BYTES) ?
+                            entryPtr->msgLen : (LOGRING_MAX_MSG_BYTES - 1);
+        headerPtr->numSlots = NumRecordSlots(headerPtr->procNameLen + headerPtr->compNameLen +
+                                             headerPtr->msgLen);
+        totalSlots += headerPtr->numSlots;
+    }
+
+    if (totalSlots == 0)
+    {
+        return;
+    }
+
+    // Reserve the slots of the whole batch at once.  The acquire keeps the writes to the slots
+    // after the reservation, which readers rely on to detect overwritten records.
+    uint64_t index = __atomic_fetch_add(&ringRef->headerPtr->head, totalSlots, __ATOMIC_ACQ_REL);
+
+    for (i = 0; i < numEntries; i++)
+    {
+        WriteRecord(ringRef, index, &entriesPtr[i], &headers[i]);
+        index += headers[i].numSlots;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queries the records of a log ring, from the oldest to the newest.
+ *
+ * @return
+ *      The number of records matching the filter.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t logRing_Query
+(
+    logRing_Ref_t ringRef,                  ///< [IN] The ring.
+    const logRing_Filter_t* filterPtr,      ///< [IN] The filter, or NULL for all the records.
+    logRing_RecordHandler_t handlerPtr,     ///< [IN] Handler called for each matching record.
+    void* contextPtr                        ///< [IN] Context passed to the handler.
+)
+{
+    static const logRing_Filter_t noFilter = { 0 };
+    logRing_Record_t record;
+    size_t numMatching = 0;
+
+    if (filterPtr == NULL)
+    {
+        filterPtr = &noFilter;
+    }
+
+    // Records appended after the query started are left out.
+    uint64_t head = __atomic_load_n(&ringRef->headerPtr->head, __ATOMIC_ACQUIRE);
+    uint64_t index = (head > ringRef->numSlots) ? (head - ringRef->numSlots) : 0;
+
+    while (index < head)
+    {
+        size_t numSlots;
+
+        switch (ReadRecord(ringRef, index, &record, &numSlots))
+        {
+            case LE_OK:
+                index += numSlots;
+                if (IsMatching(&record, filterPtr))
+                {
+                    numMatching++;
+                    if (!handlerPtr(&record, contextPtr))
+                    {
+                        return numMatching;
+                    }
+                }
+                break;
+
+            case LE_OVERFLOW:
+            {
+                // The writers caught up with us: skip to the oldest slot not overwritten yet.
+                uint64_t newHead = __atomic_load_n(&ringRef->headerPtr->head, __ATOMIC_RELAXED);
+                index = (newHead - ringRef->numSlots > index) ? (newHead - ringRef->numSlots) :
+                                                                 (index + 1);
+                break;
+            }
+
+            default:
+                // Continuation slot, or record not committed yet.
+                index++;
+                break;
+        }
+    }
+
+    return numMatching;
+}
@@ -0,0 +1,245 @@
+/** @file logRing.h
+ *
+ * Declarations of the binary log ring.
+ *
+ * The log ring is a circular store of structured log records in a memory-mapped file owned by the
+ * Log Control Daemon.  The daemon hands the file to every process that registers with it, and the
+ * processes append their log records (level, process, component, PID, thread ID, time stamp and
+ * message) to it directly, without any IPC message.  The log control tool maps the same file to
+ * query the records, filtering them on their fields rather than parsing the text of syslog.
+ *
+ * The ring is an array of fixed-size slots.  A record takes one or more consecutive slots.
+ * Writers reserve the slots of a whole batch of records with a single atomic add to the head of
+ * the ring, then fill them in, without any lock.  Each slot is stamped with its absolute index in
+ * the ring once written; the first slot of a record is stamped last, which commits the record.
+ * When the ring is full, the oldest records are overwritten.
+ *
+ * Readers never write to the ring.  They only report a record if its first slot carries the
+ * expected stamp, and if the head of the ring shows that it was not overwritten while it was
+ * being copied.  All the lengths are checked against the size of the ring, since every process
+ * that logs can write to it.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LE_LOG_RING_H_INCLUDE_GUARD
+#define LE_LOG_RING_H_INCLUDE_GUARD
+
+#include "limit.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Magic number found at the start of a valid log ring ("LERG").
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOGRING_MAGIC               0x4752454C
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Layout version of the log ring.  Must be incremented if the layout of the ring, of its slots or
+ * of its records changes.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOGRING_VERSION             1
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of a slot of the ring, in bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOGRING_SLOT_BYTES          64
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of bytes of a message stored in the ring, including the null terminator.
+ * Longer messages are truncated.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOGRING_MAX_MSG_BYTES       256
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of records appended in one batch.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOGRING_MAX_BATCH           32
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Level of the records of traces, which have a keyword instead of a severity level.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOGRING_LEVEL_TRACE         0xFF
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a mapped log ring.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct logRing_Ring* logRing_Ref_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log record to append to the ring.  The strings don't need to be null-terminated within their
+ * lengths.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t        timestampNs;        ///< Time stamp (CLOCK_REALTIME), in nanoseconds.
+    pid_t           pid;                ///< PID of the process that logged the record.
+    pid_t           tid;                ///< Thread ID of the thread that logged it, or 0.
+    uint8_t         level;              ///< le_log_Level_t, or LOGRING_LEVEL_TRACE.
+    const char*     procNamePtr;        ///< Process name.
+    const char*     compNamePtr;        ///< Component name.
+    const char*     msgPtr;             ///< Message (traces start with their keyword).
+    size_t          msgLen;             ///< Length of the message, in bytes.
+}
+logRing_Entry_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log record read from the ring.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t        index;                                  ///< Index of the record in the ring.
+    uint64_t        timestampNs;                            ///< Time stamp, in nanoseconds.
+    pid_t           pid;                                    ///< PID of the process.
+    pid_t           tid;                                    ///< Thread ID, or 0.
+    uint8_t         level;                                  ///< Level, or LOGRING_LEVEL_TRACE.
+    char            procName[LIMIT_MAX_PROCESS_NAME_BYTES]; ///< Process name.
+    char            compName[LIMIT_MAX_COMPONENT_NAME_BYTES]; ///< Component name.
+    char            msg[LOGRING_MAX_MSG_BYTES];             ///< Message.
+}
+logRing_Record_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Filter of a query.  Zeroed fields (or NULL strings) match everything.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char*     procNamePtr;        ///< Only records of processes with this name.
+    const char*     compNamePtr;        ///< Only records of components with this name.
+    pid_t           pid;                ///< Only records of this process.
+    int             minLevel;           ///< Only records at least this severe (traces excluded
+                                        ///  if not 0).
+    uint64_t        sinceNs;            ///< Only records time-stamped from this time on.
+}
+logRing_Filter_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prototype of the handler called for each record matching a query.
+ *
+ * @return true to go on with the query, false to stop it.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef bool (*logRing_RecordHandler_t)
+(
+    const logRing_Record_t* recordPtr,  ///< [IN] The record.
+    void* contextPtr                    ///< [IN] Context of the query.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates the file of a new, empty log ring.  Its size is sealed, so that the processes it is
+ * shared with can't truncate it under the feet of the others.
+ *
+ * @return
+ *      The file descriptor of the ring, or -1 on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+int logRing_Create
+(
+    size_t size     ///< [IN] Size of the ring, in bytes.  Rounded down to a power of two slots.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maps a log ring.  The file descriptor can be closed once mapped.
+ *
+ * @return
+ *      A reference to the mapped ring, or NULL if the file is not a valid log ring.
+ */
+//--------------------------------------------------------------------------------------------------
+logRing_Ref_t logRing_Map
+(
+    int fd,             ///< [IN] File descriptor of the ring.
+    bool isWritable     ///< [IN] true to append to the ring, false to only query it.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unmaps a log ring.
+ */
+//--------------------------------------------------------------------------------------------------
+void logRing_Unmap
+(
+    logRing_Ref_t ringRef   ///< [IN] The ring.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the size of a log ring.
+ *
+ * @return
+ *      The number of bytes of records the ring can hold.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t logRing_GetSize
+(
+    logRing_Ref_t ringRef   ///< [IN] The ring.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Appends a batch of records to a log ring.  May be called from any thread of any process the
+ * ring is shared with.
+ */
+//--------------------------------------------------------------------------------------------------
+void logRing_Append
+(
+    logRing_Ref_t ringRef,                  ///< [IN] The ring (mapped writable).
+    const logRing_Entry_t* entriesPtr,      ///< [IN] The records.
+    size_t numEntries                       ///< [IN] Number of records, at most
+                                            ///       LOGRING_MAX_BATCH.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queries the records of a log ring, from the oldest to the newest.
+ *
+ * @return
+ *      The number of records matching the filter.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t logRing_Query
+(
+    logRing_Ref_t ringRef,                  ///< [IN] The ring.
+    const logRing_Filter_t* filterPtr,      ///< [IN] The filter, or NULL for all the records.
+    logRing_RecordHandler_t handlerPtr,     ///< [IN] Handler called for each matching record.
+    void* contextPtr                        ///< [IN] Context passed to the handler.
+);
+
+
+#endif // LE_LOG_RING_H_INCLUDE_GUARD
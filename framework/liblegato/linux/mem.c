@@ -45,6 +45,7 @@
 #include "legato.h"
 #include "mem.h"
 #include "limit.h"
+#include "stats.h"
 
 #define USE_GUARD_BAND
 #define FILL_DELETED_AND_CHECK_ALLOCATED
@@ -336,6 +337,7 @@ static void InitPool
     pool->numBlocksInUse = 0;
     pool->maxNumBlocksUsed = 0;
     pool->numBlocksToForce = DEFAULT_NUM_BLOCKS_TO_FORCE;
+    pool->statsIndex = -1;
 
     #ifdef LE_MEM_TRACE
         pool->memTrace = NULL;
@@ -349,6 +351,27 @@ static void InitPool
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Updates the counters of a pool in the statistics page.
+ *
+ * @note
+ *      Assumes that the mutex is locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UpdatePoolStats
+(
+    le_mem_PoolRef_t    pool        ///< [IN] The pool.
+)
+{
+    stats_SetPoolCounter(pool->statsIndex, STATS_POOL_TOTAL_BLOCKS, pool->totalBlocks);
+    stats_SetPoolCounter(pool->statsIndex, STATS_POOL_BLOCKS_IN_USE, pool->numBlocksInUse);
+    stats_SetPoolCounter(pool->statsIndex, STATS_POOL_MAX_BLOCKS_USED, pool->maxNumBlocksUsed);
+    stats_SetPoolCounter(pool->statsIndex, STATS_POOL_ALLOCS, pool->numAllocations);
+    stats_SetPoolCounter(pool->statsIndex, STATS_POOL_OVERFLOWS, pool->numOverflows);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Moves the specified number of blocks from the source pool to the destination pool.
@@ -646,6 +669,8 @@ le_mem_PoolRef_t _le_mem_CreatePool
     // Add the new pool to the list of pools.
     PoolListChangeCount++;
     le_dls_Queue(&PoolList, &(newPool->poolLink));
+    stats_Inc(STATS_MEM_POOLS);
+    newPool->statsIndex = stats_AddPool(newPool->name, newPool->userDataSize);
 
     Unlock();
 
@@ -699,6 +724,8 @@ le_mem_PoolRef_t le_mem_ExpandPool
             {
                 pool->superPoolPtr->maxNumBlocksUsed = pool->superPoolPtr->numBlocksInUse;
             }
+
+            UpdatePoolStats(pool->superPoolPtr);
         }
         else
         {
@@ -706,6 +733,8 @@ le_mem_PoolRef_t le_mem_ExpandPool
             AddBlocks(pool, numObjects);
         }
 
+        UpdatePoolStats(pool);
+
         Unlock();
     #endif
 
@@ -763,6 +792,10 @@ void* le_mem_TryAlloc
             pool->maxNumBlocksUsed = pool->numBlocksInUse;
         }
 
+        stats_Inc(STATS_MEM_ALLOCS);
+        stats_Inc(STATS_MEM_BLOCKS_IN_USE);
+        UpdatePoolStats(pool);
+
         blockPtr->refCount = 1;
 
         // Return the user object in the block.
@@ -834,6 +867,8 @@ void* le_mem_ForceAlloc
 
             Lock();
             pool->numOverflows++;
+            stats_Inc(STATS_MEM_OVERFLOWS);
+            UpdatePoolStats(pool);
 
             // log a warning.
             LE_DEBUG("Memory pool '%s' overflowed. Expanded to %zu blocks.",
@@ -949,6 +984,8 @@ void le_mem_Release
             #endif
 
             poolPtr->numBlocksInUse--;
+            stats_Dec(STATS_MEM_BLOCKS_IN_USE);
+            UpdatePoolStats(poolPtr);
 
             break;
         }
@@ -1095,6 +1132,7 @@ void le_mem_ResetStats
     Lock();
     pool->numAllocations = 0;
     pool->numOverflows = 0;
+    UpdatePoolStats(pool);
     Unlock();
 }
 
@@ -1320,6 +1358,8 @@ le_mem_PoolRef_t _le_mem_CreateSubPool
     // Add the sub-pool to the list of pools.
     PoolListChangeCount++;
     le_dls_Queue(&PoolList, &(subPool->poolLink));
+    stats_Inc(STATS_MEM_POOLS);
+    subPool->statsIndex = stats_AddPool(subPool->name, subPool->userDataSize);
 
     Unlock();
 
@@ -1369,10 +1409,13 @@ void le_mem_DeleteSubPool
 
     // Update the superPool's block use count.
     superPool->numBlocksInUse -= numBlocks;
+    UpdatePoolStats(superPool);
 
     // Remove the sub-pool from the list of sub-pools.
     PoolListChangeCount++;
     le_dls_Remove(&PoolList, &(subPool->poolLink));
+    stats_Dec(STATS_MEM_POOLS);
+    stats_RemovePool(subPool->statsIndex);
 
     Unlock();
 
@@ -46,6 +46,7 @@ typedef struct le_mem_Pool
     #endif
 
     le_mem_Destructor_t destructor;     ///< The destructor for objects in this pool.
+    int statsIndex;                     ///< Entry of the pool in the statistics page, or -1.
     char name[LIMIT_MAX_MEM_POOL_NAME_BYTES]; ///< Name of the pool.
 }
 MemPool_t;
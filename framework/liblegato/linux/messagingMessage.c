@@ -14,6 +14,7 @@
 #include "messagingInterface.h"
 #include "fileDescriptor.h"
 #include "unixSocket.h"
+#include "stats.h"
 
 // =======================================
 //  PRIVATE FUNCTIONS
@@ -160,11 +161,18 @@ le_result_t msgMessage_Send
 
     // The first bytes come from our transaction ID and the rest (if any)
     // from our Message object's payload section, which comes right after the transaction ID.
-    return unixSocket_SendMsg(  socketFd,
-                                &msgPtr->txnId,
-                                sizeof(msgPtr->txnId) + le_msg_GetMaxPayloadSize(msgPtr),
-                                msgPtr->fd,
-                                false   ); // Don't send process credentials.
+    size_t byteCount = sizeof(msgPtr->txnId) + le_msg_GetMaxPayloadSize(msgPtr);
+    le_result_t result = unixSocket_SendMsg(socketFd,
+                                            &msgPtr->txnId,
+                                            byteCount,
+                                            msgPtr->fd,
+                                            false   ); // Don't send process credentials.
+    if (result == LE_OK)
+    {
+        stats_Inc(STATS_IPC_MSGS_SENT);
+    }
+
+    return result;
 }
 
 
@@ -199,6 +207,11 @@ le_result_t msgMessage_Receive
         msgRef->clientServer.server.responseFd = -1;
     }
 
+    if (result == LE_OK)
+    {
+        stats_Inc(STATS_IPC_MSGS_RECEIVED);
+    }
+
     return result;
 }
 
@@ -17,6 +17,7 @@
 #include "messagingProtocol.h"
 #include "messagingMessage.h"
 #include "fileDescriptor.h"
+#include "stats.h"
 
 
 // =======================================
@@ -452,6 +453,7 @@ static msgSession_Session_t* CreateSession
 
     SessionObjListChangeCount++;
     msgInterface_AddSession(interfaceRef, sessionPtr);
+    stats_Inc(STATS_IPC_SESSIONS);
 
     return sessionPtr;
 }
@@ -522,6 +524,7 @@ static void DeleteSession
     // Remove the Session from the Interface's Session List.
     SessionObjListChangeCount++;
     msgInterface_RemoveSession(sessionPtr->interfaceRef, sessionPtr);
+    stats_Dec(STATS_IPC_SESSIONS);
 
     // Release the Session object itself.
     le_mem_Release(sessionPtr);
@@ -0,0 +1,295 @@
+//--------------------------------------------------------------------------------------------------
+/** @file stats.c
+ *
+ * Per-process statistics page.
+ *
+ * The page is a POSIX shared memory object named after the process's PID.  It is created when the
+ * framework library is initialized and unlinked when the process exits normally.  The page of a
+ * process that is killed or crashes is unlinked by the Supervisor when it reaps the process, and
+ * pages of other dead processes are collected by Inspect when it lists the pages.  Until the
+ * shared page exists (and in case it can't be created), counters are kept in a private page so
+ * that stats_PagePtr is always valid and updating a counter never needs a check.
+ *
+ * Since a forked child would otherwise keep updating its parent's page, the child switches back to
+ * a private page right after the fork.  It doesn't publish a page of its own, because most
+ * children exec() straight away and the page would be left behind by non-Legato programs; a child
+ * that execs a Legato program gets a fresh page when the framework is initialized again.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "stats.h"
+#include "fileDescriptor.h"
+#include <sys/mman.h>
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of the shared memory object name, including the null terminator.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_SHM_NAME_BYTES  32
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Private page used before the shared page is mapped, or if it can't be.
+ */
+//--------------------------------------------------------------------------------------------------
+static stats_Page_t PrivatePage;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pointer to the statistics page currently in use.
+ */
+//--------------------------------------------------------------------------------------------------
+stats_Page_t* stats_PagePtr = &PrivatePage;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Name of the shared memory object of this process's page.  Empty if there is no shared page.
+ */
+//--------------------------------------------------------------------------------------------------
+static char ShmName[MAX_SHM_NAME_BYTES] = "";
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates and maps the shared statistics page for the calling process.
+ *
+ * @return
+ *      Pointer to the mapped page, or NULL on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+static stats_Page_t* CreateSharedPage
+(
+    void
+)
+{
+    pid_t pid = getpid();
+
+    LE_ASSERT(snprintf(ShmName, sizeof(ShmName), STATS_SHM_NAME_FORMAT, pid) < sizeof(ShmName));
+
+    int fd = shm_open(ShmName, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR | S_IRGRP);
+
+    if (fd < 0)
+    {
+        LE_DEBUG("Statistics page '%s' not available (%m).", ShmName);
+        ShmName[0] = '\0';
+        return NULL;
+    }
+
+    stats_Page_t* pagePtr = MAP_FAILED;
+
+    if (ftruncate(fd, sizeof(stats_Page_t)) == 0)
+    {
+        pagePtr = mmap(NULL, sizeof(stats_Page_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+
+    fd_Close(fd);
+
+    if (pagePtr == MAP_FAILED)
+    {
+        LE_DEBUG("Could not map statistics page '%s' (%m).", ShmName);
+        shm_unlink(ShmName);
+        ShmName[0] = '\0';
+        return NULL;
+    }
+
+    return pagePtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Switches the process over to a new page, carrying over the current counter values.
+ *
+ * @warning Must only be called while the process is single-threaded.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SwitchPage
+(
+    stats_Page_t* newPagePtr    ///< [IN] Page to use from now on.
+)
+{
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+
+    if (newPagePtr != stats_PagePtr)
+    {
+        memcpy(newPagePtr->counters, stats_PagePtr->counters, sizeof(newPagePtr->counters));
+        memcpy(newPagePtr->pools, stats_PagePtr->pools, sizeof(newPagePtr->pools));
+    }
+    newPagePtr->version = STATS_VERSION;
+    newPagePtr->numCounters = STATS_NUM_COUNTERS;
+    newPagePtr->poolsOffset = offsetof(stats_Page_t, pools);
+    newPagePtr->maxPools = STATS_MAX_POOLS;
+    newPagePtr->pid = getpid();
+    newPagePtr->startTimeMs = (uint64_t)now.sec * 1000 + now.usec / 1000;
+
+    // Readers treat the page as valid once the magic number is there, so write it last.
+    __atomic_store_n(&newPagePtr->magic, STATS_MAGIC, __ATOMIC_RELEASE);
+
+    stats_PagePtr = newPagePtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes the shared page of this process when it exits.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemoveSharedPage
+(
+    void
+)
+{
+    // Only the process that created the page gets to remove it.
+    if ((ShmName[0] != '\0') && (stats_PagePtr->pid == getpid()))
+    {
+        shm_unlink(ShmName);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Called in the child process after a fork() to stop it from updating its parent's page.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ChildAfterFork
+(
+    void
+)
+{
+    stats_Page_t* parentPagePtr = stats_PagePtr;
+
+    SwitchPage(&PrivatePage);
+
+    if (parentPagePtr != &PrivatePage)
+    {
+        munmap(parentPagePtr, sizeof(stats_Page_t));
+    }
+
+    ShmName[0] = '\0';
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a memory pool to the statistics page.
+ *
+ * @warning The caller must serialize the calls to stats_AddPool() and stats_RemovePool().
+ *
+ * @return
+ *      Index of the pool's entry, or -1 if the table of pools is full.
+ */
+//--------------------------------------------------------------------------------------------------
+int stats_AddPool
+(
+    const char* name,           ///< [IN] Name of the pool.
+    size_t objSize              ///< [IN] Size of the objects in the pool, in bytes.
+)
+{
+    int i;
+
+    for (i = 0; i < STATS_MAX_POOLS; i++)
+    {
+        stats_Pool_t* poolPtr = &stats_PagePtr->pools[i];
+
+        if (poolPtr->name[0] == '\0')
+        {
+            memset(poolPtr->counters, 0, sizeof(poolPtr->counters));
+            poolPtr->objSize = objSize;
+
+            // An empty name would mark the entry as free.
+            if (le_utf8_Copy(poolPtr->name, name, sizeof(poolPtr->name), NULL) != LE_OK)
+            {
+                LE_DEBUG("Pool name '%s' truncated in the statistics page.", name);
+            }
+            if (poolPtr->name[0] == '\0')
+            {
+                LE_ASSERT(le_utf8_Copy(poolPtr->name, "?", sizeof(poolPtr->name), NULL) == LE_OK);
+            }
+
+            return i;
+        }
+    }
+
+    LE_DEBUG("No room for pool '%s' in the statistics page.", name);
+    return -1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes a memory pool from the statistics page.
+ *
+ * @warning The caller must serialize the calls to stats_AddPool() and stats_RemovePool().
+ */
+//--------------------------------------------------------------------------------------------------
+void stats_RemovePool
+(
+    int poolIndex               ///< [IN] Entry of the pool, from stats_AddPool(), or -1.
+)
+{
+    if (poolIndex >= 0)
+    {
+        stats_PagePtr->pools[poolIndex].name[0] = '\0';
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes the statistics page left behind by a process that no longer exists.  Used by the
+ * process that reaps it, since the page is only removed by a process that exits normally.
+ */
+//--------------------------------------------------------------------------------------------------
+void stats_RemovePage
+(
+    pid_t pid                   ///< [IN] PID of the dead process.
+)
+{
+    char shmName[MAX_SHM_NAME_BYTES];
+
+    LE_ASSERT(snprintf(shmName, sizeof(shmName), STATS_SHM_NAME_FORMAT, pid) < sizeof(shmName));
+
+    // The process may not have had a page at all (e.g., not a Legato program).
+    if ((shm_unlink(shmName) != 0) && (errno != ENOENT))
+    {
+        LE_DEBUG("Could not remove statistics page '%s' (%m).", shmName);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes the statistics module by publishing this process's statistics page in shared memory.
+ *
+ * Counter updates made before this is called are carried over to the shared page.  If the shared
+ * page can't be created (e.g., no /dev/shm in a sandbox), the counters are kept in private memory.
+ */
+//--------------------------------------------------------------------------------------------------
+void stats_Init
+(
+    void
+)
+{
+    stats_Page_t* pagePtr = CreateSharedPage();
+
+    if (pagePtr != NULL)
+    {
+        SwitchPage(pagePtr);
+    }
+    else
+    {
+        SwitchPage(&PrivatePage);
+    }
+
+    LE_ASSERT(atexit(RemoveSharedPage) == 0);
+    LE_ASSERT(pthread_atfork(NULL, NULL, ChildAfterFork) == 0);
+}
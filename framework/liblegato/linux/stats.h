@@ -0,0 +1,299 @@
+/** @file stats.h
+ *
+ * Declarations of the framework's per-process statistics page.
+ *
+ * Every process that uses liblegato publishes a small, fixed-layout page of counters in POSIX
+ * shared memory (/dev/shm/legato.stats.<pid>).  The counters are maintained by the framework
+ * modules (memory pools, timers, event loop, IPC sessions, etc.) using relaxed atomic operations,
+ * so updating them never takes a lock.  Tools such as Inspect map the page read-only and read
+ * all the counters at once instead of walking the framework's data structures through
+ * /proc/<pid>/mem.
+ *
+ * Readers must check the magic number and the version before interpreting the page.  New counters
+ * are only ever appended to the end of the counter array, and numCounters tells readers how many
+ * counters the writer knows about, so older readers keep working with newer writers.  The table of
+ * memory pools follows the counters, at the offset given in the header.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LE_STATS_H_INCLUDE_GUARD
+#define LE_STATS_H_INCLUDE_GUARD
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Magic number found at the start of a valid statistics page ("LEST").
+ */
+//--------------------------------------------------------------------------------------------------
+#define STATS_MAGIC             0x5453454C
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Layout version of the statistics page.  Must be incremented if the header layout changes.
+ * Adding counters to the end of stats_Counter_t does not require a version change.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STATS_VERSION           2
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Format of the POSIX shared memory object name of a process's statistics page.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STATS_SHM_NAME_FORMAT   "/legato.stats.%d"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Directory in which the shared memory objects of the statistics pages can be found.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STATS_SHM_DIR           "/dev/shm"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prefix of the file names of the statistics pages in STATS_SHM_DIR.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STATS_SHM_FILE_PREFIX   "legato.stats."
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Counters available in the statistics page.
+ *
+ * Gauges go up and down (e.g., number of blocks in use), the other counters only go up.
+ *
+ * @warning Only append to this list, never reorder it.  Also update the table of counter names
+ *          in the Inspect tool.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    STATS_MEM_POOLS,            ///< Gauge: Number of memory pools and sub-pools.
+    STATS_MEM_BLOCKS_IN_USE,    ///< Gauge: Number of memory pool blocks in use.
+    STATS_MEM_ALLOCS,           ///< Number of memory pool block allocations.
+    STATS_MEM_OVERFLOWS,        ///< Number of times a memory pool had to be expanded by
+                                ///  le_mem_ForceAlloc().
+    STATS_THREADS,              ///< Gauge: Number of Legato thread objects.
+    STATS_TIMERS,               ///< Gauge: Number of timer objects.
+    STATS_TIMERS_ACTIVE,        ///< Gauge: Number of running timers.
+    STATS_TIMER_EXPIRIES,       ///< Number of timer expiries.
+    STATS_EVENT_QUEUE_DEPTH,    ///< Gauge: Number of reports on all threads' event queues.
+    STATS_EVENTS_PROCESSED,     ///< Number of event reports and queued functions processed.
+    STATS_IPC_SESSIONS,         ///< Gauge: Number of IPC session objects.
+    STATS_IPC_MSGS_SENT,        ///< Number of IPC messages sent.
+    STATS_IPC_MSGS_RECEIVED,    ///< Number of IPC messages received.
+
+    STATS_NUM_COUNTERS          ///< Number of counters.  Must be last.
+}
+stats_Counter_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of memory pools listed in the statistics page.  Pools created once the table is
+ * full are only counted in the STATS_MEM_XXX counters.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STATS_MAX_POOLS         128
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the name of a memory pool in the statistics page, including the null terminator.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STATS_POOL_NAME_BYTES   32
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Counters of each memory pool in the statistics page.
+ *
+ * @warning Adding a counter changes the size of the pool entries, so it requires a version change.
+ *          Also update the table of pool columns in the Inspect tool.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    STATS_POOL_TOTAL_BLOCKS,    ///< Gauge: Number of blocks in the pool, free or in use.
+    STATS_POOL_BLOCKS_IN_USE,   ///< Gauge: Number of blocks in use.
+    STATS_POOL_MAX_BLOCKS_USED, ///< Maximum number of blocks in use at any one time.
+    STATS_POOL_ALLOCS,          ///< Number of block allocations.
+    STATS_POOL_OVERFLOWS,       ///< Number of times the pool had to be expanded by
+                                ///  le_mem_ForceAlloc().
+
+    STATS_POOL_NUM_COUNTERS     ///< Number of counters of a pool.  Must be last.
+}
+stats_PoolCounter_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Entry of a memory pool in the statistics page.  The entry is free if its name is empty.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char     name[STATS_POOL_NAME_BYTES];       ///< Name of the pool, including its component.
+    uint64_t objSize;                           ///< Size of the objects in the pool, in bytes.
+    uint64_t counters[STATS_POOL_NUM_COUNTERS]; ///< Counters, indexed by stats_PoolCounter_t.
+}
+stats_Pool_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Layout of the statistics page.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t magic;                         ///< STATS_MAGIC once the page is initialized.
+    uint32_t version;                       ///< STATS_VERSION.
+    uint32_t numCounters;                   ///< Number of entries in counters[].
+    int32_t  pid;                           ///< PID of the process that owns the page.
+    uint64_t startTimeMs;                   ///< Monotonic time (ms) at which the page was created.
+    uint32_t poolsOffset;                   ///< Offset of pools[] from the start of the page.
+    uint32_t maxPools;                      ///< Number of entries in pools[].
+    uint64_t counters[STATS_NUM_COUNTERS];  ///< Counters, indexed by stats_Counter_t.
+    stats_Pool_t pools[STATS_MAX_POOLS];    ///< Memory pools.
+}
+stats_Page_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pointer to the statistics page of this process.  Never NULL; points to a private page until
+ * stats_Init() has mapped the shared one.
+ *
+ * @note Only use the stats_XXX() functions to update the counters.
+ */
+//--------------------------------------------------------------------------------------------------
+extern stats_Page_t* stats_PagePtr;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a (possibly negative) amount to a counter in the statistics page.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void stats_Add
+(
+    stats_Counter_t counter,    ///< [IN] Counter to update.
+    int64_t amount              ///< [IN] Amount to add.
+)
+{
+    __atomic_fetch_add(&stats_PagePtr->counters[counter], (uint64_t)amount, __ATOMIC_RELAXED);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Increments a counter in the statistics page.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void stats_Inc
+(
+    stats_Counter_t counter     ///< [IN] Counter to increment.
+)
+{
+    stats_Add(counter, 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decrements a counter in the statistics page.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void stats_Dec
+(
+    stats_Counter_t counter     ///< [IN] Counter to decrement.
+)
+{
+    stats_Add(counter, -1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets a counter of a memory pool in the statistics page.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void stats_SetPoolCounter
+(
+    int poolIndex,                  ///< [IN] Entry of the pool, from stats_AddPool(), or -1.
+    stats_PoolCounter_t counter,    ///< [IN] Counter to set.
+    uint64_t value                  ///< [IN] New value of the counter.
+)
+{
+    if (poolIndex >= 0)
+    {
+        __atomic_store_n(&stats_PagePtr->pools[poolIndex].counters[counter], value,
+                         __ATOMIC_RELAXED);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a memory pool to the statistics page.
+ *
+ * @warning The caller must serialize the calls to stats_AddPool() and stats_RemovePool().
+ *
+ * @return
+ *      Index of the pool's entry, or -1 if the table of pools is full.
+ */
+//--------------------------------------------------------------------------------------------------
+int stats_AddPool
+(
+    const char* name,           ///< [IN] Name of the pool.
+    size_t objSize              ///< [IN] Size of the objects in the pool, in bytes.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes a memory pool from the statistics page.
+ *
+ * @warning The caller must serialize the calls to stats_AddPool() and stats_RemovePool().
+ */
+//--------------------------------------------------------------------------------------------------
+void stats_RemovePool
+(
+    int poolIndex               ///< [IN] Entry of the pool, from stats_AddPool(), or -1.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes the statistics page left behind by a process that no longer exists.  Used by the
+ * process that reaps it, since the page is only removed by a process that exits normally.
+ */
+//--------------------------------------------------------------------------------------------------
+void stats_RemovePage
+(
+    pid_t pid                   ///< [IN] PID of the dead process.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes the statistics module by publishing this process's statistics page in shared memory.
+ *
+ * Counter updates made before this is called are carried over to the shared page.  If the shared
+ * page can't be created (e.g., no /dev/shm in a sandbox), the counters are kept in private memory.
+ */
+//--------------------------------------------------------------------------------------------------
+void stats_Init
+(
+    void
+);
+
+
+#endif // LE_STATS_H_INCLUDE_GUARD
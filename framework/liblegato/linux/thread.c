@@ -33,6 +33,7 @@
 
 #include "legato.h"
 #include "thread.h"
+#include "stats.h"
 
 
 /// Expected number of threads in the process.
@@ -254,6 +255,7 @@ static void CleanupThread
         le_ref_DeleteRef(ThreadRefMap, threadObjPtr->safeRef);
         ThreadObjListChangeCount++;
         le_dls_Remove(&ThreadObjList, &(threadObjPtr->link));
+        stats_Dec(STATS_THREADS);
         Unlock();
 
         DeleteThread(threadObjPtr);
@@ -441,6 +443,7 @@ static thread_Obj_t* CreateThread
     threadPtr->safeRef = le_ref_CreateRef(ThreadRefMap, threadPtr);
     ThreadObjListChangeCount++;
     le_dls_Queue(&ThreadObjList, &(threadPtr->link));
+    stats_Inc(STATS_THREADS);
     Unlock();
 
     return threadPtr;
@@ -940,6 +943,7 @@ le_result_t le_thread_Join
                     le_ref_DeleteRef(ThreadRefMap, threadPtr->safeRef);
                     ThreadObjListChangeCount++;
                     le_dls_Remove(&ThreadObjList, &(threadPtr->link));
+                    stats_Dec(STATS_THREADS);
                     Unlock();
                     DeleteThread(threadPtr);
 
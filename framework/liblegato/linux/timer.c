@@ -10,6 +10,7 @@
 #include "clock.h"
 #include "timer.h"
 #include "thread.h"
+#include "stats.h"
 #include "fileDescriptor.h"
 #include <sys/timerfd.h>
 #include "fileDescriptor.h"
@@ -127,6 +128,8 @@ static Timer_t* CreateTimer
     timerPtr->safeRef = le_ref_CreateRef(SafeRefMap, timerPtr);
     timerPtr->isWakeupEnabled = true;
 
+    stats_Inc(STATS_TIMERS);
+
     return timerPtr;
 }
 
@@ -180,6 +183,7 @@ static void AddToTimerList
 
     // The new timer is now on the active list
     newTimerPtr->isActive = true;
+    stats_Inc(STATS_TIMERS_ACTIVE);
 }
 
 
@@ -233,6 +237,7 @@ static Timer_t* PopFromTimerList
 
         // The timer is no longer on the active list
         timerPtr->isActive = false;
+        stats_Dec(STATS_TIMERS_ACTIVE);
 
         return timerPtr;
     }
@@ -255,6 +260,7 @@ static void RemoveFromTimerList
     timerPtr->isActive = false;
     TimerListChangeCount++;
     le_dls_Remove(listPtr, &timerPtr->link);
+    stats_Dec(STATS_TIMERS_ACTIVE);
 }
 
 
@@ -480,6 +486,7 @@ static void ProcessExpiredTimer
 
     // Keep track of the number of times the timer has expired, regardless of whether it repeats.
     expiredTimer->expiryCount++;
+    stats_Inc(STATS_TIMER_EXPIRIES);
 
     // Handle repeating timers by adding it back to the list; do this before calling the expiry
     // handler to reduce jitter.
@@ -806,6 +813,7 @@ void le_timer_Delete
     }
     le_ref_DeleteRef(SafeRefMap, timerRef);
     le_mem_Release(timerPtr);
+    stats_Dec(STATS_TIMERS);
 }
 
 
@@ -15,6 +15,11 @@
  * Groups are created and deleted by modifying the /etc/group file.  File update and locking is
  * handled in the same way as the passwd file.
  *
+ * Lookups of users and groups by ID or name are served from an in-process cache of the passwd and
+ * group files, indexed by ID and by name.  A file is read again whenever its inode, size or
+ * modification time changed since it was cached, which any update through this API does.  Users
+ * and groups that are not in the files are still looked up through the C library.
+ *
  * Copyright (C) Sierra Wireless Inc.
  */
 
@@ -557,6 +562,374 @@ void user_Init
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of buckets of the hashmaps of the user and group cache.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CACHE_HASHMAP_SIZE      211
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Entry of the user and group cache: a line of the passwd or group file.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char            name[LIMIT_MAX_USER_NAME_BYTES];    ///< User or group name.
+    uint32_t        id;                                 ///< User or group ID.
+    gid_t           gid;                                ///< Primary group ID of a user.
+    le_dls_Link_t   link;                               ///< Link in the list of the table.
+}
+CacheEntry_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cached table of the passwd or group file.  The table is valid as long as the device, inode, size
+ * and modification time of the file are those it was read with.  Since the files are updated by
+ * renaming a new file over them, any update changes at least the inode.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char*         pathPtr;        ///< File the table is read from.
+    bool                isLoaded;       ///< true if the table was read from the file.
+    dev_t               dev;            ///< Device of the file when read.
+    ino_t               ino;            ///< Inode of the file when read.
+    off_t               size;           ///< Size of the file when read.
+    struct timespec     mtime;          ///< Modification time of the file when read.
+    le_dls_List_t       list;           ///< All the entries of the table.
+    le_hashmap_Ref_t    idMap;          ///< Entries by ID.  The first line of an ID wins.
+    le_hashmap_Ref_t    nameMap;        ///< Entries by name.  The first line of a name wins.
+}
+CacheTable_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The cached tables of the passwd and group files, the pool of their entries and the mutex that
+ * protects them.
+ */
+//--------------------------------------------------------------------------------------------------
+static CacheTable_t UserTable = { .pathPtr = PASSWORD_FILE, .list = LE_DLS_LIST_INIT };
+static CacheTable_t GroupTable = { .pathPtr = GROUP_FILE, .list = LE_DLS_LIST_INIT };
+static le_mem_PoolRef_t CacheEntryPool = NULL;
+static pthread_mutex_t CacheMutex = PTHREAD_MUTEX_INITIALIZER;
+
+#define LOCK    LE_ASSERT(pthread_mutex_lock(&CacheMutex) == 0);
+#define UNLOCK  LE_ASSERT(pthread_mutex_unlock(&CacheMutex) == 0);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks if the cache can be used.  When /etc is not writable, the apps translation table takes
+ * precedence over the passwd and group files and is re-read on each lookup, so the cache is
+ * bypassed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsCacheUsable
+(
+    void
+)
+{
+    return (NbAppsInTranslationTable == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Empties a cached table.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ClearTable
+(
+    CacheTable_t* tablePtr          ///< [IN] The table.
+)
+{
+    le_dls_Link_t* linkPtr;
+
+    le_hashmap_RemoveAll(tablePtr->idMap);
+    le_hashmap_RemoveAll(tablePtr->nameMap);
+
+    while ((linkPtr = le_dls_Pop(&tablePtr->list)) != NULL)
+    {
+        le_mem_Release(CONTAINER_OF(linkPtr, CacheEntry_t, link));
+    }
+
+    tablePtr->isLoaded = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds an entry to a cached table.  Names too long for an entry are left to the C library.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddEntry
+(
+    CacheTable_t* tablePtr,         ///< [IN] The table.
+    const char* namePtr,            ///< [IN] User or group name.
+    uint32_t id,                    ///< [IN] User or group ID.
+    gid_t gid                       ///< [IN] Primary group ID of a user.
+)
+{
+    CacheEntry_t* entryPtr = le_mem_ForceAlloc(CacheEntryPool);
+
+    if (le_utf8_Copy(entryPtr->name, namePtr, sizeof(entryPtr->name), NULL) != LE_OK)
+    {
+        le_mem_Release(entryPtr);
+        return;
+    }
+
+    entryPtr->id = id;
+    entryPtr->gid = gid;
+    entryPtr->link = LE_DLS_LINK_INIT;
+    le_dls_Queue(&tablePtr->list, &entryPtr->link);
+
+    if (!le_hashmap_ContainsKey(tablePtr->idMap, &entryPtr->id))
+    {
+        le_hashmap_Put(tablePtr->idMap, &entryPtr->id, entryPtr);
+    }
+
+    if (!le_hashmap_ContainsKey(tablePtr->nameMap, entryPtr->name))
+    {
+        le_hashmap_Put(tablePtr->nameMap, entryPtr->name, entryPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads the passwd or group file into its cached table, under a read lock.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if the file could not be read.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t LoadTable
+(
+    CacheTable_t* tablePtr          ///< [IN] The table.
+)
+{
+    struct stat fileStat;
+    int err;
+
+    FILE* filePtr = le_flock_OpenStream(tablePtr->pathPtr, LE_FLOCK_READ, NULL);
+    if (filePtr == NULL)
+    {
+        LE_ERROR("Could not read file %s.  %m.", tablePtr->pathPtr);
+        return LE_FAULT;
+    }
+
+    if (fstat(fileno(filePtr), &fileStat) != 0)
+    {
+        LE_ERROR("Could not stat file %s.  %m.", tablePtr->pathPtr);
+        le_flock_CloseStream(filePtr);
+        return LE_FAULT;
+    }
+
+    if (tablePtr == &UserTable)
+    {
+        char buf[MaxPasswdEntrySize];
+        struct passwd pwd;
+        struct passwd* pwdPtr;
+
+        do
+        {
+            err = fgetpwent_r(filePtr, &pwd, buf, sizeof(buf), &pwdPtr);
+            if (pwdPtr != NULL)
+            {
+                AddEntry(tablePtr, pwd.pw_name, pwd.pw_uid, pwd.pw_gid);
+            }
+        }
+        while ((pwdPtr != NULL) || (err == EINTR));
+    }
+    else
+    {
+        char buf[MaxGroupEntrySize];
+        struct group grp;
+        struct group* grpPtr;
+
+        do
+        {
+            err = fgetgrent_r(filePtr, &grp, buf, sizeof(buf), &grpPtr);
+            if (grpPtr != NULL)
+            {
+                AddEntry(tablePtr, grp.gr_name, grp.gr_gid, grp.gr_gid);
+            }
+        }
+        while ((grpPtr != NULL) || (err == EINTR));
+    }
+
+    le_flock_CloseStream(filePtr);
+
+    // Anything but the end of the file means part of the table is missing.
+    if (err != ENOENT)
+    {
+        errno = err;
+        LE_ERROR("Could not read the entries of file %s.  %m.", tablePtr->pathPtr);
+        ClearTable(tablePtr);
+        return LE_FAULT;
+    }
+
+    tablePtr->dev = fileStat.st_dev;
+    tablePtr->ino = fileStat.st_ino;
+    tablePtr->size = fileStat.st_size;
+    tablePtr->mtime = fileStat.st_mtim;
+    tablePtr->isLoaded = true;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Brings a cached table up to date with its file, reading the file again if it changed since it
+ * was read.  Must be called with the cache mutex held, and never with the file locked for writing.
+ *
+ * @return
+ *      LE_OK if the table is up to date.
+ *      LE_FAULT if the file could not be read.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t RefreshTable
+(
+    CacheTable_t* tablePtr          ///< [IN] The table.
+)
+{
+    struct stat fileStat;
+
+    if (CacheEntryPool == NULL)
+    {
+        CacheEntryPool = le_mem_CreatePool("UserCacheEntry", sizeof(CacheEntry_t));
+        UserTable.idMap = le_hashmap_Create("UserCacheByUid", CACHE_HASHMAP_SIZE,
+                                            le_hashmap_HashUInt32, le_hashmap_EqualsUInt32);
+        UserTable.nameMap = le_hashmap_Create("UserCacheByName", CACHE_HASHMAP_SIZE,
+                                              le_hashmap_HashString, le_hashmap_EqualsString);
+        GroupTable.idMap = le_hashmap_Create("GroupCacheByGid", CACHE_HASHMAP_SIZE,
+                                             le_hashmap_HashUInt32, le_hashmap_EqualsUInt32);
+        GroupTable.nameMap = le_hashmap_Create("GroupCacheByName", CACHE_HASHMAP_SIZE,
+                                               le_hashmap_HashString, le_hashmap_EqualsString);
+    }
+
+    if (stat(tablePtr->pathPtr, &fileStat) != 0)
+    {
+        LE_ERROR("Could not stat file %s.  %m.", tablePtr->pathPtr);
+        ClearTable(tablePtr);
+        return LE_FAULT;
+    }
+
+    if ( tablePtr->isLoaded &&
+         (fileStat.st_dev == tablePtr->dev) &&
+         (fileStat.st_ino == tablePtr->ino) &&
+         (fileStat.st_size == tablePtr->size) &&
+         (fileStat.st_mtim.tv_sec == tablePtr->mtime.tv_sec) &&
+         (fileStat.st_mtim.tv_nsec == tablePtr->mtime.tv_nsec) )
+    {
+        return LE_OK;
+    }
+
+    ClearTable(tablePtr);
+    return LoadTable(tablePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Looks up the name of a user or group ID in the cache.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_OVERFLOW if the provided buffer is too small and only part of the name was copied.
+ *      LE_NOT_FOUND if the ID is not in the cache, or the cache can't be used.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CacheGetName
+(
+    CacheTable_t* tablePtr,         ///< [IN] The table.
+    uint32_t id,                    ///< [IN] User or group ID.
+    char* nameBufPtr,               ///< [OUT] The buffer to store the name in.
+    size_t nameBufSize              ///< [IN] The size of the buffer.
+)
+{
+    le_result_t result = LE_NOT_FOUND;
+
+    if (!IsCacheUsable())
+    {
+        return LE_NOT_FOUND;
+    }
+
+    LOCK
+
+    if (RefreshTable(tablePtr) == LE_OK)
+    {
+        CacheEntry_t* entryPtr = le_hashmap_Get(tablePtr->idMap, &id);
+
+        if (entryPtr != NULL)
+        {
+            result = le_utf8_Copy(nameBufPtr, entryPtr->name, nameBufSize, NULL);
+        }
+    }
+
+    UNLOCK
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Looks up the IDs of a user or group name in the cache.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the name is not in the cache, or the cache can't be used.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CacheGetIDs
+(
+    CacheTable_t* tablePtr,         ///< [IN] The table.
+    const char* namePtr,            ///< [IN] User or group name.
+    uint32_t* idPtr,                ///< [OUT] User or group ID.  Can be NULL.
+    gid_t* gidPtr                   ///< [OUT] Primary group ID of a user.  Can be NULL.
+)
+{
+    le_result_t result = LE_NOT_FOUND;
+
+    if (!IsCacheUsable())
+    {
+        return LE_NOT_FOUND;
+    }
+
+    LOCK
+
+    if (RefreshTable(tablePtr) == LE_OK)
+    {
+        CacheEntry_t* entryPtr = le_hashmap_Get(tablePtr->nameMap, namePtr);
+
+        if (entryPtr != NULL)
+        {
+            if (idPtr != NULL)
+            {
+                *idPtr = entryPtr->id;
+            }
+            if (gidPtr != NULL)
+            {
+                *gidPtr = entryPtr->gid;
+            }
+            result = LE_OK;
+        }
+    }
+
+    UNLOCK
+
+    return result;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets a user name from a user ID.
@@ -2044,6 +2417,12 @@ le_result_t user_GetIDs
                                 ///        This can be NULL if the gid is not needed.
 )
 {
+    // Look up the cached passwd file first.  Users it doesn't know are left to the C library.
+    if (CacheGetIDs(&UserTable, usernamePtr, uidPtr, gidPtr) == LE_OK)
+    {
+        return LE_OK;
+    }
+
     // Lock the passwd file for reading.
     int fd = le_flock_Open(PASSWORD_FILE, LE_FLOCK_READ);
     if (fd < 0)
@@ -2077,6 +2456,11 @@ le_result_t user_GetUid
     uid_t* uidPtr               ///< [OUT] Pointer to store the uid.
 )
 {
+    if (CacheGetIDs(&UserTable, usernamePtr, uidPtr, NULL) == LE_OK)
+    {
+        return LE_OK;
+    }
+
     // Lock the passwd file for reading.
     int fd = le_flock_Open(PASSWORD_FILE, LE_FLOCK_READ);
     if (fd < 0)
@@ -2117,6 +2501,11 @@ le_result_t user_GetGid
     gid_t* gidPtr                ///< [OUT] Pointer to store the gid.
 )
 {
+    if (CacheGetIDs(&GroupTable, groupNamePtr, gidPtr, NULL) == LE_OK)
+    {
+        return LE_OK;
+    }
+
     // Lock the group file for reading.
     int fd = le_flock_Open(GROUP_FILE, LE_FLOCK_READ);
     if (fd < 0)
@@ -2159,6 +2548,12 @@ le_result_t user_GetName
     size_t nameBufSize          ///< [IN] The size of the buffer that the user name will be stored in.
 )
 {
+    le_result_t result = CacheGetName(&UserTable, uid, nameBufPtr, nameBufSize);
+    if (result != LE_NOT_FOUND)
+    {
+        return result;
+    }
+
     // Lock the passwd file for reading.
     int fd = le_flock_Open(PASSWORD_FILE, LE_FLOCK_READ);
     if (fd < 0)
@@ -2194,6 +2589,12 @@ le_result_t user_GetGroupName
     size_t nameBufSize          ///< [IN] The size of the buffer that the group name will be stored in.
 )
 {
+    le_result_t result = CacheGetName(&GroupTable, gid, nameBufPtr, nameBufSize);
+    if (result != LE_NOT_FOUND)
+    {
+        return result;
+    }
+
     // Lock the group file for reading.
     int fd = le_flock_Open(GROUP_FILE, LE_FLOCK_READ);
     if (fd < 0)
@@ -79,6 +79,17 @@ void log_ConnectToControlDaemon
     void
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts appending the log messages of this process to the log ring of the Log Control Daemon,
+ * in addition to syslog.  Only the first ring given is used.
+ */
+//--------------------------------------------------------------------------------------------------
+void log_UseRing
+(
+    int fd          ///< [IN] File descriptor of the log ring.  Closed by this function.
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Registers a named component with the logging system.
@@ -933,7 +933,7 @@ void GenerateExportedAdef
 
     file::MakeDir(dirPath);
 
-    std::ofstream defStream(filePath, std::ofstream::trunc);
+    file::GeneratedFile_t defStream(filePath);
 
     defStream << "\n"
                  "//\n"
@@ -66,15 +66,10 @@ void AppBuildScriptGenerator_t::GenerateAppBuildRules
         // Delete the old info.properties file, if there is one.
         "  command = rm -f $out && $\n"
         // Compute the MD5 checksum of the staging area.
-        // Don't follow symlinks (-P), and include the directory structure and the contents of
+        // Don't follow symlinks, and include the directory structure and the contents of
         // symlinks as part of the MD5 hash.
-        "            md5=$$( ( cd $workingDir/staging && $\n"
-        "                      find -P -print0 |LC_ALL=C sort -z && $\n"
-        "                      find -P -type f -print0 |LC_ALL=C sort -z |xargs -0 md5sum && $\n"
-        "                      find -P -type l -print0 |LC_ALL=C sort -z"
-                             " |xargs -0 -r -n 1 readlink $\n"
-        "                    ) | md5sum) && $\n"
-        "            md5=$${md5%% *} && $\n"
+        "            md5=$$( " << baseGeneratorPtr->GetHashDirCommand("$workingDir/staging")
+                                                                            << " ) && $\n"
         // Generate the app's info.properties file.
         "            ( echo \"app.name=$name\" && $\n"
         "              echo \"app.md5=$$md5\" && $\n"
@@ -138,15 +133,11 @@ void AppBuildScriptGenerator_t::GenerateAppBuildRules
             "            cp " << buildParams.pubCert <<
                         " $workingDir/staging.signed/ima_pub.cert  && $\n"
             // Recompute the MD5 checksum of the staging area.
-            // Don't follow symlinks (-P), and include the directory structure and the contents
+            // Don't follow symlinks, and include the directory structure and the contents
             // of symlinks as part of the MD5 hash.
-            "            md5signed=$$( ( cd $workingDir/staging.signed && $\n"
-            "                      find -P -print0 |LC_ALL=C sort -z && $\n"
-            "                      find -P -type f -print0 |LC_ALL=C sort -z |xargs -0 md5sum && $\n"
-            "                      find -P -type l -print0 |LC_ALL=C sort -z"
-                                 " |xargs -0 -r -n 1 readlink $\n"
-            "                    ) | md5sum) && $\n"
-            "            md5signed=$${md5signed%% *} && $\n"
+            "            md5signed=$$( "
+                        << baseGeneratorPtr->GetHashDirCommand("$workingDir/staging.signed")
+                                                                            << " ) && $\n"
             // Get the app's MD5 hash from its info.properties file and replace with signed one.
             "            md5=`grep '^app.md5=' $workingDir/staging.signed/info.properties"
                         " | sed 's/^app.md5=//'` && $\n"
@@ -169,6 +169,22 @@ std::string BuildScriptGenerator_t::GetPathEnvVarDecl
     return pathStr;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a command that prints the MD5 sum of a staging directory.  The MD5 sums of the files are
+ * cached next to the directory, so that only the files that changed are read again on rebuilds.
+ **/
+//--------------------------------------------------------------------------------------------------
+std::string BuildScriptGenerator_t::GetHashDirCommand
+(
+    const std::string& dirPath
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return std::string(buildParams.argv[0]) + " --hash-dir " + dirPath + " "
+           + dirPath + ".md5cache";
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Generate generic build rules.
@@ -76,6 +76,7 @@ class BuildScriptGenerator_t
                                                       model::FileSystemObjectSet_t& bundledFiles);
 
         std::string GetPathEnvVarDecl(void);
+        std::string GetHashDirCommand(const std::string& dirPath);
         std::string PermissionsToModeFlags(model::Permissions_t permissions);
 
     public:
@@ -131,14 +131,9 @@ void SystemBuildScriptGenerator_t::GenerateSystemBuildRules
     "            rm -f $out && $\n"
 
     // Compute the MD5 checksum of the staging area.
-    // Don't follow symlinks (-P), and include the directory structure and the contents of symlinks
+    // Don't follow symlinks, and include the directory structure and the contents of symlinks
     // as part of the MD5 hash.
-    "            md5=$$( ( cd $stagingDir && $\n"
-    "                      find -P -print0 |LC_ALL=C sort -z && $\n"
-    "                      find -P -type f -print0 |LC_ALL=C sort -z |xargs -0 md5sum && $\n"
-    "                      find -P -type l -print0 |LC_ALL=C sort -z |xargs -0 -r -n 1 readlink $\n"
-    "                    ) | md5sum) && $\n"
-    "            md5=$${md5%% *} && $\n"
+    "            md5=$$( " << baseGeneratorPtr->GetHashDirCommand("$stagingDir") << " ) && $\n"
 
     // Get the Legato framework version and append the MD5 sum to it to get the system version.
     "           frameworkVersion=$$( cat $$LEGATO_ROOT/version ) && $\n"
@@ -230,15 +225,10 @@ void SystemBuildScriptGenerator_t::GenerateSystemBuildRules
 
         script <<
         // Recompute the MD5 checksum of the staging area.
-        // Don't follow symlinks (-P), and include the directory structure and the contents
+        // Don't follow symlinks, and include the directory structure and the contents
         // of symlinks as part of the MD5 hash.
-        "            md5signed=$$( ( cd $stagingDir.signed && $\n"
-        "                      find -P -print0 |LC_ALL=C sort -z && $\n"
-        "                      find -P -type f -print0 |LC_ALL=C sort -z |xargs -0 md5sum && $\n"
-        "                      find -P -type l -print0 |LC_ALL=C sort -z "
-                               "|xargs -0 -r -n 1 readlink $\n"
-        "                    ) | md5sum) && $\n"
-        "            md5signed=$${md5signed%% *} && $\n"
+        "            md5signed=$$( " << baseGeneratorPtr->GetHashDirCommand("$stagingDir.signed")
+                                                                            << " ) && $\n"
         // Get the systems's MD5 hash from its info.properties file and replace with signed one
         "            md5=`grep '^system.md5=' $stagingDir.signed/info.properties | "
                                                           "sed 's/^system.md5=//'` && $\n"
@@ -89,7 +89,7 @@ void GenerateCLangComponentMainFile
 
     // Open the .c file for writing.
     file::MakeDir(outputDir);
-    std::ofstream fileStream(filePath, std::ofstream::trunc);
+    file::GeneratedFile_t fileStream(filePath);
     if (!fileStream.is_open())
     {
         throw mk::Exception_t(
@@ -41,7 +41,7 @@ void GenerateCLangInterfacesHeader
     file::MakeDir(outputDir);
 
     // Open the interfaces.h file for writing.
-    std::ofstream fileStream(filePath, std::ofstream::trunc);
+    file::GeneratedFile_t fileStream(filePath);
     if (!fileStream.is_open())
     {
         throw mk::Exception_t(
@@ -30,7 +30,7 @@ void GenerateJavaExeMain
 
     // Open the file as an output stream.
     file::MakeDir(path::GetContainingDir(sourceFile));
-    std::ofstream outputFile(sourceFile);
+    file::GeneratedFile_t outputFile(sourceFile);
     if (outputFile.is_open() == false)
     {
         throw mk::Exception_t(
@@ -32,7 +32,7 @@ void GeneratePythonExeMain
     file::MakeDir(path::GetContainingDir(launcherFile));
 
     // Open the file as an output stream.
-    std::ofstream outputFile(launcherFile);
+    file::GeneratedFile_t outputFile(launcherFile);
 
     outputFile << "#!/usr/bin/env python\n";
     outputFile << "import sys\n"
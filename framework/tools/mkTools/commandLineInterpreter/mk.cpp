@@ -2,6 +2,9 @@
 /**
  * Implementation of the "mk" tool, which implements all of "mkcomp", "mkexe", "mkapp", and "mksys".
  *
+ * Any of them run with --hash-dir as the first argument computes the MD5 sum of a staging
+ * directory instead (see mkhash.cpp).
+ *
  * Copyright (C) Sierra Wireless Inc.
  */
 //--------------------------------------------------------------------------------------------------
@@ -26,7 +29,11 @@ int main(int argc, const char** argv)
     {
         std::string fileName = path::GetLastNode(argv[0]);
 
-        if (fileName == "mkexe")
+        if ((argc > 1) && (strcmp(argv[1], "--hash-dir") == 0))
+        {
+            cli::HashDirectory(argc, argv);
+        }
+        else if (fileName == "mkexe")
         {
             cli::MakeExecutable(argc, argv);
         }
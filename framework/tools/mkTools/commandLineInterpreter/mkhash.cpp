@@ -0,0 +1,398 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Implements the directory hashing functionality of the "mk" tool.
+ *
+ *  The build scripts use this to compute the MD5 sum of an app's or a system's staging area.  The
+ *  result is the same as the MD5 sum of the output of
+ *
+ *      find -P -print0 |LC_ALL=C sort -z &&
+ *      find -P -type f -print0 |LC_ALL=C sort -z |xargs -0 md5sum &&
+ *      find -P -type l -print0 |LC_ALL=C sort -z |xargs -0 -r -n 1 readlink
+ *
+ *  run in the directory, but the MD5 sums of the files' contents are cached between builds
+ *  (keyed by path, size and modification time), so only the files that changed get read again.
+ *
+ *  Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <fts.h>
+#include <limits.h>
+#include <unistd.h>
+#include <string.h>
+
+#include "mkTools.h"
+#include "commandLineInterpreter.h"
+
+
+namespace cli
+{
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cached MD5 sum of a file's contents.
+ */
+//--------------------------------------------------------------------------------------------------
+struct CachedHash_t
+{
+    off_t size;             ///< Size of the file when it was hashed.
+    time_t mtimeSec;        ///< Modification time of the file when it was hashed (seconds).
+    long mtimeNsec;         ///< Modification time of the file when it was hashed (nanoseconds).
+    std::string md5;        ///< MD5 sum of the file's contents.
+};
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load the cache file.  The cache is only an optimization, so anything that can't be read from it
+ * is just ignored.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LoadCache
+(
+    const std::string& cachePath,
+    std::map<std::string, CachedHash_t>& cache      ///< [OUT] Path -> cached hash.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    std::ifstream cacheFile(cachePath);
+    std::string line;
+
+    while (std::getline(cacheFile, line))
+    {
+        std::istringstream lineStream(line);
+        CachedHash_t entry;
+        std::string path;
+
+        if (   (lineStream >> entry.md5 >> entry.size >> entry.mtimeSec >> entry.mtimeNsec)
+            && (lineStream.get() == ' ')
+            && std::getline(lineStream, path)
+            && (entry.md5.size() == 32))
+        {
+            cache[path] = entry;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Save the cache file.
+ *
+ * @throw mk::Exception_t on error.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SaveCache
+(
+    const std::string& cachePath,
+    const std::map<std::string, CachedHash_t>& cache
+)
+//--------------------------------------------------------------------------------------------------
+{
+    std::string tempPath = cachePath + ".tmp";
+
+    {
+        std::ofstream cacheFile(tempPath, std::ios::trunc);
+
+        for (const auto& mapEntry : cache)
+        {
+            const auto& entry = mapEntry.second;
+
+            // Paths with newlines can't be stored in this format.  They are rare enough to just
+            // be hashed again every time.
+            if (mapEntry.first.find('\n') == std::string::npos)
+            {
+                cacheFile << entry.md5 << ' ' << entry.size << ' ' << entry.mtimeSec << ' '
+                          << entry.mtimeNsec << ' ' << mapEntry.first << '\n';
+            }
+        }
+
+        if (!cacheFile)
+        {
+            throw mk::Exception_t(
+                mk::format(LE_I18N("Failed to write hash cache file '%s'."), tempPath)
+            );
+        }
+    }
+
+    if (rename(tempPath.c_str(), cachePath.c_str()) != 0)
+    {
+        throw mk::Exception_t(
+            mk::format(LE_I18N("Failed to rename '%s' to '%s' (%s)."),
+                       tempPath, cachePath, std::string(strerror(errno)))
+        );
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the MD5 sum of a file's contents.
+ *
+ * @return The MD5 sum as a hex string.
+ *
+ * @throw mk::Exception_t on error.
+ */
+//--------------------------------------------------------------------------------------------------
+static std::string HashFile
+(
+    const std::string& path
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0)
+    {
+        throw mk::Exception_t(
+            mk::format(LE_I18N("Failed to open '%s' (%s)."), path, std::string(strerror(errno)))
+        );
+    }
+
+    MD5 hash;
+    static char buffer[64 * 1024];
+    ssize_t bytesRead;
+
+    while ((bytesRead = read(fd, buffer, sizeof(buffer))) != 0)
+    {
+        if (bytesRead < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            int err = errno;
+            close(fd);
+            throw mk::Exception_t(
+                mk::format(LE_I18N("Failed to read '%s' (%s)."), path, std::string(strerror(err)))
+            );
+        }
+
+        hash.update(buffer, bytesRead);
+    }
+
+    close(fd);
+
+    return hash.finalize().hexdigest();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a line of md5sum output to the directory's hash.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddMd5sumLine
+(
+    MD5& dirHash,
+    const std::string& md5,
+    const std::string& path
+)
+//--------------------------------------------------------------------------------------------------
+{
+    std::string line;
+
+    // md5sum escapes backslashes and newlines in file names, and then flags the line with a
+    // leading backslash.
+    if (path.find_first_of("\\\n") != std::string::npos)
+    {
+        line = "\\" + md5 + "  ";
+
+        for (char c : path)
+        {
+            if (c == '\\')
+            {
+                line += "\\\\";
+            }
+            else if (c == '\n')
+            {
+                line += "\\n";
+            }
+            else
+            {
+                line += c;
+            }
+        }
+    }
+    else
+    {
+        line = md5 + "  " + path;
+    }
+
+    line += '\n';
+    dirHash.update(line.c_str(), line.size());
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Implements the directory hashing functionality used to compute app and system MD5 sums.
+ *
+ * Usage: mk --hash-dir DIR [CACHE_FILE]
+ */
+//--------------------------------------------------------------------------------------------------
+void HashDirectory
+(
+    int argc,           ///< Count of the number of command line parameters.
+    const char** argv   ///< Pointer to an array of pointers to command line argument strings.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if ((argc < 3) || (argc > 4))
+    {
+        throw mk::Exception_t(
+            mk::format(LE_I18N("Usage: %s --hash-dir DIR [CACHE_FILE]"), std::string(argv[0]))
+        );
+    }
+
+    std::string dirPath = argv[2];
+    std::string cachePath = (argc > 3) ? argv[3] : "";
+
+    // Paths inside the directory are named relative to it, so it mustn't end with a separator.
+    while ((dirPath.size() > 1) && (dirPath.back() == '/'))
+    {
+        dirPath.pop_back();
+    }
+
+    std::map<std::string, CachedHash_t> oldCache;
+    std::map<std::string, CachedHash_t> newCache;
+
+    if (!cachePath.empty())
+    {
+        LoadCache(cachePath, oldCache);
+    }
+
+    // Walk the directory without following symlinks, naming everything the way find does.
+    std::vector<std::string> allPaths;
+    std::vector<std::string> filePaths;
+    std::vector<std::string> linkPaths;
+
+    char* pathArrayPtr[] = { const_cast<char*>(dirPath.c_str()), NULL };
+    FTS* ftsPtr = fts_open(pathArrayPtr, FTS_PHYSICAL | FTS_NOCHDIR, NULL);
+
+    if (ftsPtr == NULL)
+    {
+        throw mk::Exception_t(
+            mk::format(LE_I18N("Failed to open directory '%s' (%s)."),
+                       dirPath, std::string(strerror(errno)))
+        );
+    }
+
+    FTSENT* entPtr;
+    while ((entPtr = fts_read(ftsPtr)) != NULL)
+    {
+        std::string relPath = "." + std::string(entPtr->fts_path + dirPath.size());
+
+        switch (entPtr->fts_info)
+        {
+            case FTS_DP:
+                continue;
+
+            case FTS_F:
+                filePaths.push_back(relPath);
+                break;
+
+            case FTS_SL:
+            case FTS_SLNONE:
+                linkPaths.push_back(relPath);
+                break;
+
+            case FTS_DNR:
+            case FTS_ERR:
+            case FTS_NS:
+            {
+                std::string errorText = strerror(entPtr->fts_errno);
+                fts_close(ftsPtr);
+                throw mk::Exception_t(
+                    mk::format(LE_I18N("Failed to read '%s' (%s)."),
+                               std::string(entPtr->fts_path), errorText)
+                );
+            }
+
+            default:
+                break;
+        }
+
+        allPaths.push_back(relPath);
+    }
+
+    fts_close(ftsPtr);
+
+    // LC_ALL=C sort orders by byte values, just like std::string comparison does.
+    std::sort(allPaths.begin(), allPaths.end());
+    std::sort(filePaths.begin(), filePaths.end());
+    std::sort(linkPaths.begin(), linkPaths.end());
+
+    MD5 dirHash;
+
+    for (const auto& relPath : allPaths)
+    {
+        dirHash.update(relPath.c_str(), relPath.size() + 1);
+    }
+
+    for (const auto& relPath : filePaths)
+    {
+        std::string filePath = dirPath + relPath.substr(1);
+        struct stat fileStat;
+
+        if (lstat(filePath.c_str(), &fileStat) != 0)
+        {
+            throw mk::Exception_t(
+                mk::format(LE_I18N("stat() failed (%s) for path '%s'."),
+                           std::string(strerror(errno)), filePath)
+            );
+        }
+
+        auto cacheIter = oldCache.find(relPath);
+
+        if (   (cacheIter != oldCache.end())
+            && (cacheIter->second.size == fileStat.st_size)
+            && (cacheIter->second.mtimeSec == fileStat.st_mtim.tv_sec)
+            && (cacheIter->second.mtimeNsec == fileStat.st_mtim.tv_nsec))
+        {
+            newCache[relPath] = cacheIter->second;
+        }
+        else
+        {
+            newCache[relPath] = { fileStat.st_size,
+                                  fileStat.st_mtim.tv_sec,
+                                  fileStat.st_mtim.tv_nsec,
+                                  HashFile(filePath) };
+        }
+
+        AddMd5sumLine(dirHash, newCache[relPath].md5, relPath);
+    }
+
+    for (const auto& relPath : linkPaths)
+    {
+        std::string linkPath = dirPath + relPath.substr(1);
+        char target[PATH_MAX];
+
+        ssize_t len = readlink(linkPath.c_str(), target, sizeof(target));
+        if (len < 0)
+        {
+            throw mk::Exception_t(
+                mk::format(LE_I18N("Failed to read symlink '%s' (%s)."),
+                           linkPath, std::string(strerror(errno)))
+            );
+        }
+
+        dirHash.update(target, len);
+        dirHash.update("\n", 1);
+    }
+
+    if (!cachePath.empty())
+    {
+        SaveCache(cachePath, newCache);
+    }
+
+    std::cout << dirHash.finalize().hexdigest() << std::endl;
+}
+
+
+} // namespace cli
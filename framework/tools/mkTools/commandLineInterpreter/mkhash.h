@@ -0,0 +1,24 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef MKHASH_H_INCLUDE_GUARD
+#define MKHASH_H_INCLUDE_GUARD
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Implements the directory hashing functionality used to compute app and system MD5 sums.
+ *
+ * Usage: mk --hash-dir DIR [CACHE_FILE]
+ */
+//--------------------------------------------------------------------------------------------------
+void HashDirectory
+(
+    int argc,           ///< Count of the number of command line parameters.
+    const char** argv   ///< Pointer to an array of pointers to command line argument strings.
+);
+
+
+#endif // MKHASH_H_INCLUDE_GUARD
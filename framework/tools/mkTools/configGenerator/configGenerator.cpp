@@ -857,7 +857,7 @@ void Generate
                   << std::endl;
     }
 
-    std::ofstream cfgStream(filePath, std::ofstream::trunc);
+    file::GeneratedFile_t cfgStream(filePath);
 
     if (cfgStream.is_open() == false)
     {
@@ -1172,7 +1172,7 @@ static void GenerateModulesConfig
                   << std::endl;
     }
 
-    std::ofstream cfgStream(filePath, std::ofstream::trunc);
+    file::GeneratedFile_t cfgStream(filePath);
 
     if (cfgStream.is_open() == false)
     {
@@ -1274,7 +1274,7 @@ static void GenerateUsersConfig
                   << std::endl;
     }
 
-    std::ofstream cfgStream(filePath, std::ofstream::trunc);
+    file::GeneratedFile_t cfgStream(filePath);
 
     if (cfgStream.is_open() == false)
     {
@@ -1367,7 +1367,7 @@ static void GenerateAppsConfig
                   << std::endl;
     }
 
-    std::ofstream cfgStream(filePath, std::ofstream::trunc);
+    file::GeneratedFile_t cfgStream(filePath);
 
     if (cfgStream.is_open() == false)
     {
@@ -1432,7 +1432,7 @@ static void GenerateFrameworkConfig
     }
 
 
-    std::ofstream cfgStream(filePath, std::ofstream::trunc);
+    file::GeneratedFile_t cfgStream(filePath);
 
     if (cfgStream.is_open() == false)
     {
@@ -437,4 +437,153 @@ void DeleteFile
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether two files have the same contents.
+ *
+ * @return true if they do, false if they don't or one of them can't be read.
+ **/
+//--------------------------------------------------------------------------------------------------
+static bool HaveSameContents
+(
+    const std::string& path1,
+    const std::string& path2
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct stat statBuffer1;
+    struct stat statBuffer2;
+
+    if (   (stat(path1.c_str(), &statBuffer1) != 0)
+        || (stat(path2.c_str(), &statBuffer2) != 0)
+        || (statBuffer1.st_size != statBuffer2.st_size))
+    {
+        return false;
+    }
+
+    std::ifstream stream1(path1, std::ifstream::binary);
+    std::ifstream stream2(path2, std::ifstream::binary);
+
+    return (   stream1.is_open()
+            && stream2.is_open()
+            && std::equal(std::istreambuf_iterator<char>(stream1),
+                          std::istreambuf_iterator<char>(),
+                          std::istreambuf_iterator<char>(stream2)));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open a generated file for writing.
+ *
+ * As for std::ofstream, check is_open() for failures.
+ **/
+//--------------------------------------------------------------------------------------------------
+GeneratedFile_t::GeneratedFile_t
+(
+    const std::string& path     ///< Path of the file to generate.
+)
+//--------------------------------------------------------------------------------------------------
+:   std::ofstream(path + ".new", std::ofstream::trunc),
+    path(path),
+    tempPath(path + ".new"),
+    isFinished(false)
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Destructor.  Closes the file if close() wasn't called.
+ **/
+//--------------------------------------------------------------------------------------------------
+GeneratedFile_t::~GeneratedFile_t
+(
+)
+//--------------------------------------------------------------------------------------------------
+{
+    try
+    {
+        // Don't replace the file with something incomplete if an exception is being thrown.
+        Finish(!std::uncaught_exception());
+    }
+    catch (mk::Exception_t& e)
+    {
+        std::cerr << LE_I18N("** ERROR:") << std::endl << e.what() << std::endl;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the file, replacing the file at the path given to the constructor if the contents changed.
+ *
+ * @throw mk::Exception_t if the file can't be replaced.
+ **/
+//--------------------------------------------------------------------------------------------------
+void GeneratedFile_t::close
+(
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Finish(true);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the temporary file and either move it into place or delete it.
+ *
+ * @throw mk::Exception_t if the file can't be replaced.
+ **/
+//--------------------------------------------------------------------------------------------------
+void GeneratedFile_t::Finish
+(
+    bool keepContents   ///< false to discard what was written.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (isFinished)
+    {
+        return;
+    }
+
+    isFinished = true;
+
+    bool wasOpen = is_open();
+
+    std::ofstream::close();
+
+    if (!wasOpen)
+    {
+        return;
+    }
+
+    if (keepContents && fail())
+    {
+        unlink(tempPath.c_str());
+
+        throw mk::Exception_t(
+            mk::format(LE_I18N("Error writing to file '%s'."), path)
+        );
+    }
+
+    if (!keepContents || HaveSameContents(tempPath, path))
+    {
+        unlink(tempPath.c_str());
+    }
+    else if (rename(tempPath.c_str(), path.c_str()) != 0)
+    {
+        int err = errno;
+
+        unlink(tempPath.c_str());
+
+        throw mk::Exception_t(
+            mk::format(LE_I18N("Failed to rename '%s' to '%s' (%s)."), tempPath, path,
+                       std::string(strerror(err)))
+        );
+    }
+}
+
+
 } // namespace file
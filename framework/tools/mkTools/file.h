@@ -173,6 +173,35 @@ void DeleteFile
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Output file stream for generated files.
+ *
+ * The contents are written to a temporary file, which only replaces the file at the given path
+ * when the stream is closed (or destroyed) if the contents are different.  That way, regenerating
+ * a file that didn't change doesn't update its modification time, and so doesn't make ninja
+ * rebuild everything that depends on it.
+ *
+ * If the stream is destroyed by an exception, or if writing failed, the file is left untouched.
+ **/
+//--------------------------------------------------------------------------------------------------
+class GeneratedFile_t : public std::ofstream
+{
+    public:
+        GeneratedFile_t(const std::string& path);
+        ~GeneratedFile_t();
+
+        void close();
+
+    private:
+        void Finish(bool keepContents);
+
+        const std::string path;     ///< Path of the file being generated.
+        const std::string tempPath; ///< Path of the temporary file being written.
+        bool isFinished;            ///< true once the temporary file has been dealt with.
+};
+
+
 } // namespace file
 
 #endif // LEGATO_MKTOOLS_FILE_H_INCLUDE_GUARD
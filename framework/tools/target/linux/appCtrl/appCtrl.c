@@ -202,6 +202,7 @@ static void PrintHelp
         "    app status [<appName>]\n"
         "    app version <appName>\n"
         "    app info [<appName>]\n"
+        "    app usage <appName>\n"
         "    app runProc <appName> <procName> [options]\n"
         "    app runProc <appName> [<procName>] --exe=<exePath> [options]\n"
         "\n"
@@ -249,6 +250,12 @@ static void PrintHelp
         "       If no name is given, prints the information of all installed applications.\n"
         "       If a name is given, prints the information of the specified application.\n"
         "\n"
+        "    app usage <appName>\n"
+        "       Prints the recent resource usage of the specified running application, as sampled\n"
+        "       periodically by the Supervisor: the CPU load since the previous sample and the\n"
+        "       memory used, from the newest sample to the oldest.  Also prints the CPU time the\n"
+        "       Supervisor spends sampling all the running applications.\n"
+        "\n"
         "    app runProc <appName> <procName> [options]\n"
         "       Runs a configured process inside an app using the process settings from the\n"
         "       configuration database.  If an exePath is provided as an option then the specified\n"
@@ -1264,6 +1271,69 @@ static void PrintAppVersion
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Implements the "usage" command.
+ *
+ * @note This function does not return.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrintAppUsage
+(
+    void
+)
+{
+    uint32_t ageMs[LE_APPINFO_MAX_USAGE_SAMPLES];
+    uint64_t cpuTimeUs[LE_APPINFO_MAX_USAGE_SAMPLES];
+    uint64_t memBytes[LE_APPINFO_MAX_USAGE_SAMPLES];
+    size_t ageMsSize = NUM_ARRAY_MEMBERS(ageMs);
+    size_t cpuTimeUsSize = NUM_ARRAY_MEMBERS(cpuTimeUs);
+    size_t memBytesSize = NUM_ARRAY_MEMBERS(memBytes);
+
+    le_appInfo_ConnectService();
+
+    if (le_appInfo_GetUsageHistory(AppNamePtr, ageMs, &ageMsSize, cpuTimeUs, &cpuTimeUsSize,
+                                   memBytes, &memBytesSize) != LE_OK)
+    {
+        printf("%s is not running.\n", AppNamePtr);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("%10s %8s %12s\n", "AGE (s)", "CPU (%)", "MEMORY (KB)");
+
+    size_t i;
+    for (i = 0; i < ageMsSize; i++)
+    {
+        printf("%10.1f ", ageMs[i] / 1000.0);
+
+        // The CPU load is computed against the previous (older) sample.
+        if ( (i + 1 < ageMsSize) && (ageMs[i + 1] > ageMs[i]) )
+        {
+            printf("%8.1f ", ((cpuTimeUs[i] - cpuTimeUs[i + 1]) * 100.0) /
+                             ((ageMs[i + 1] - ageMs[i]) * 1000.0));
+        }
+        else
+        {
+            printf("%8s ", "-");
+        }
+
+        printf("%12" PRIu64 "\n", memBytes[i] / 1024);
+    }
+
+    uint32_t periodMs;
+    uint32_t roundCount;
+    uint32_t avgRoundUs;
+    uint32_t maxRoundUs;
+
+    le_appInfo_GetUsageSamplerStats(&periodMs, &roundCount, &avgRoundUs, &maxRoundUs);
+
+    printf("\nSampled every %" PRIu32 " ms, %" PRIu32 " rounds, %" PRIu32 " us per round "
+           "(max %" PRIu32 " us).\n", periodMs, roundCount, avgRoundUs, maxRoundUs);
+
+    exit(EXIT_SUCCESS);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * A handler that is called when the application process exits.
@@ -1868,6 +1938,12 @@ static void CommandArgHandler
         le_arg_AddPositionalCallback(AppNameArgHandler);
         le_arg_AllowLessPositionalArgsThanCallbacks();
     }
+    else if (strcmp(command, "usage") == 0)
+    {
+        CommandFunc = PrintAppUsage;
+
+        le_arg_AddPositionalCallback(AppNameArgHandler);
+    }
     else
     {
         fprintf(stderr, "Unknown command '%s'.  Try --help.\n", command);
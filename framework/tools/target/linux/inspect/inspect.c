@@ -22,6 +22,9 @@
 #include "addr.h"
 #include "fileDescriptor.h"
 #include "timer.h"
+#include "stats.h"
+#include <dirent.h>
+#include <sys/mman.h>
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -40,6 +43,7 @@ typedef struct ServiceObjIter*      ServiceObjIter_Ref_t;
 typedef struct ClientObjIter*       ClientObjIter_Ref_t;
 typedef struct SessionObjIter*      SessionObjIter_Ref_t;
 typedef struct InterfaceObjIter*    InterfaceObjIter_Ref_t;
+typedef struct StatsIter*           StatsIter_Ref_t;
 
 
 //--------------------------------------------------------------------------------------------------
@@ -57,7 +61,9 @@ typedef enum
     INSPECT_INSP_TYPE_IPC_SERVERS,
     INSPECT_INSP_TYPE_IPC_CLIENTS,
     INSPECT_INSP_TYPE_IPC_SERVERS_SESSIONS,
-    INSPECT_INSP_TYPE_IPC_CLIENTS_SESSIONS
+    INSPECT_INSP_TYPE_IPC_CLIENTS_SESSIONS,
+    INSPECT_INSP_TYPE_STATS,
+    INSPECT_INSP_TYPE_STATS_POOLS
 }
 InspType_t;
 
@@ -199,6 +205,37 @@ typedef struct InterfaceObjIter
 InterfaceObjIter_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of a process name read from /proc/<PID>/comm, including the null terminator.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_PROC_NAME_BYTES 17
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Statistics page of a process, read from its shared memory object.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    stats_Page_t page;                  ///< Copy of the process's statistics page.
+    char procName[MAX_PROC_NAME_BYTES]; ///< Name of the process.
+}
+StatsNode_t;
+
+// Iterator for stepping through the statistics pages of one or all processes.  Unlike the other
+// iterators, this one doesn't need access to the remote process's memory.
+typedef struct StatsIter
+{
+    DIR* dirPtr;                        ///< Shared memory directory, NULL if inspecting one PID.
+    bool isDone;                        ///< true if the single PID has already been read.
+    StatsNode_t currNode;               ///< Current statistics page.
+}
+StatsIter_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Local memory pool that is used for allocating an inspection object iterator.
@@ -1538,6 +1575,290 @@ static msgSession_Session_t* GetNextSessionObj
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates an iterator for the statistics pages.  If a PID was given, only that process's page is
+ * visited; otherwise the pages of all live processes are.
+ *
+ * @return
+ *      Iterator to the statistics pages.
+ */
+//--------------------------------------------------------------------------------------------------
+static StatsIter_Ref_t CreateStatsIter
+(
+    void
+)
+{
+    StatsIter_t* iteratorPtr = le_mem_ForceAlloc(IteratorPool);
+
+    iteratorPtr->dirPtr = NULL;
+    iteratorPtr->isDone = false;
+
+    if (PidToInspect <= 0)
+    {
+        iteratorPtr->dirPtr = opendir(STATS_SHM_DIR);
+
+        if (iteratorPtr->dirPtr == NULL)
+        {
+            fprintf(stderr, "Could not open %s.  %m.\n", STATS_SHM_DIR);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    return iteratorPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The statistics pages are read in one go, so there's no list that can change under our feet.
+ *
+ * @return
+ *      Always 0.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t GetStatsListChgCnt
+(
+    StatsIter_Ref_t iterRef ///< [IN] The iterator.
+)
+{
+    return 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads a process's statistics page with a single read-only mapping of its shared memory object.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the process has no statistics page.
+ *      LE_FAULT if the page is not valid or has an unsupported layout.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadStatsPage
+(
+    pid_t pid,              ///< [IN] Process to read the page of.
+    stats_Page_t* pagePtr   ///< [OUT] Copy of the page.
+)
+{
+    char shmName[LIMIT_MAX_PATH_BYTES];
+    INTERNAL_ERR_IF(snprintf(shmName, sizeof(shmName), STATS_SHM_NAME_FORMAT, pid)
+                    >= sizeof(shmName),
+                    "Statistics page name too long.");
+
+    int fd = shm_open(shmName, O_RDONLY, 0);
+
+    if (fd < 0)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    struct stat statBuf;
+
+    if ((fstat(fd, &statBuf) != 0) || (statBuf.st_size < offsetof(stats_Page_t, counters)))
+    {
+        fd_Close(fd);
+        return LE_FAULT;
+    }
+
+    size_t mapSize = statBuf.st_size;
+    const stats_Page_t* remotePagePtr = mmap(NULL, mapSize, PROT_READ, MAP_SHARED, fd, 0);
+
+    fd_Close(fd);
+
+    if (remotePagePtr == MAP_FAILED)
+    {
+        return LE_FAULT;
+    }
+
+    le_result_t result = LE_FAULT;
+
+    if ((__atomic_load_n(&remotePagePtr->magic, __ATOMIC_ACQUIRE) == STATS_MAGIC)
+        && (remotePagePtr->version == STATS_VERSION))
+    {
+        // Only read the counters that both sides know about and that fit in the mapping.
+        size_t numCounters = (mapSize - offsetof(stats_Page_t, counters)) / sizeof(uint64_t);
+
+        if (remotePagePtr->numCounters < numCounters)
+        {
+            numCounters = remotePagePtr->numCounters;
+        }
+        if (STATS_NUM_COUNTERS < numCounters)
+        {
+            numCounters = STATS_NUM_COUNTERS;
+        }
+
+        memset(pagePtr, 0, sizeof(*pagePtr));
+        pagePtr->magic = STATS_MAGIC;
+        pagePtr->version = remotePagePtr->version;
+        pagePtr->numCounters = numCounters;
+        pagePtr->pid = remotePagePtr->pid;
+        pagePtr->startTimeMs = remotePagePtr->startTimeMs;
+
+        size_t i;
+        for (i = 0; i < numCounters; i++)
+        {
+            pagePtr->counters[i] = __atomic_load_n(&remotePagePtr->counters[i], __ATOMIC_RELAXED);
+        }
+
+        // Likewise, only read the pool entries that fit in the mapping.
+        size_t numPools = 0;
+
+        if (remotePagePtr->poolsOffset <= mapSize)
+        {
+            numPools = (mapSize - remotePagePtr->poolsOffset) / sizeof(stats_Pool_t);
+        }
+        if (remotePagePtr->maxPools < numPools)
+        {
+            numPools = remotePagePtr->maxPools;
+        }
+        if (STATS_MAX_POOLS < numPools)
+        {
+            numPools = STATS_MAX_POOLS;
+        }
+
+        const stats_Pool_t* remotePoolsPtr =
+            (const stats_Pool_t*)((const uint8_t*)remotePagePtr + remotePagePtr->poolsOffset);
+
+        pagePtr->poolsOffset = offsetof(stats_Page_t, pools);
+        pagePtr->maxPools = numPools;
+
+        for (i = 0; i < numPools; i++)
+        {
+            stats_Pool_t* poolPtr = &pagePtr->pools[i];
+            size_t j;
+
+            memcpy(poolPtr->name, remotePoolsPtr[i].name, sizeof(poolPtr->name));
+            poolPtr->name[sizeof(poolPtr->name) - 1] = '\0';
+            poolPtr->objSize = remotePoolsPtr[i].objSize;
+
+            for (j = 0; j < STATS_POOL_NUM_COUNTERS; j++)
+            {
+                poolPtr->counters[j] = __atomic_load_n(&remotePoolsPtr[i].counters[j],
+                                                       __ATOMIC_RELAXED);
+            }
+        }
+
+        result = LE_OK;
+    }
+
+    munmap((void*)remotePagePtr, mapSize);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads the statistics page of a process and its name into a node.
+ *
+ * @return
+ *      LE_OK if successful, otherwise see ReadStatsPage().
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadStatsNode
+(
+    pid_t pid,              ///< [IN] Process to read the page of.
+    StatsNode_t* nodePtr    ///< [OUT] Node to fill in.
+)
+{
+    le_result_t result = ReadStatsPage(pid, &nodePtr->page);
+
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    char commPath[LIMIT_MAX_PATH_BYTES];
+    snprintf(commPath, sizeof(commPath), "/proc/%d/comm", pid);
+
+    LE_ASSERT(le_utf8_Copy(nodePtr->procName, "?", sizeof(nodePtr->procName), NULL) == LE_OK);
+
+    int fd = open(commPath, O_RDONLY);
+
+    if (fd >= 0)
+    {
+        if (fd_ReadLine(fd, nodePtr->procName, sizeof(nodePtr->procName)) == LE_FAULT)
+        {
+            LE_ASSERT(le_utf8_Copy(nodePtr->procName, "?", sizeof(nodePtr->procName), NULL)
+                      == LE_OK);
+        }
+
+        fd_Close(fd);
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the next statistics page.  Pages left behind by processes that no longer exist, e.g.
+ * processes killed by a signal and not reaped by the Supervisor, are removed.
+ *
+ * @return
+ *      Node containing the next statistics page, or NULL if there are no more pages.
+ */
+//--------------------------------------------------------------------------------------------------
+static StatsNode_t* GetNextStatsNode
+(
+    StatsIter_Ref_t iterRef ///< [IN] The iterator.
+)
+{
+    if (iterRef->dirPtr == NULL)
+    {
+        if (iterRef->isDone)
+        {
+            return NULL;
+        }
+
+        iterRef->isDone = true;
+
+        if (ReadStatsNode(PidToInspect, &iterRef->currNode) != LE_OK)
+        {
+            fprintf(stderr, "No statistics available for process %d.\n", PidToInspect);
+            exit(EXIT_FAILURE);
+        }
+
+        return &iterRef->currNode;
+    }
+
+    struct dirent* entryPtr;
+    size_t prefixLen = strlen(STATS_SHM_FILE_PREFIX);
+
+    while ((entryPtr = readdir(iterRef->dirPtr)) != NULL)
+    {
+        int pid;
+
+        if ((strncmp(entryPtr->d_name, STATS_SHM_FILE_PREFIX, prefixLen) != 0)
+            || (le_utf8_ParseInt(&pid, entryPtr->d_name + prefixLen) != LE_OK)
+            || (pid <= 0))
+        {
+            continue;
+        }
+
+        if ((kill(pid, 0) != 0) && (errno == ESRCH))
+        {
+            // Nobody else will remove it.  Ignore failures, e.g., when not run as root.
+            stats_RemovePage(pid);
+            continue;
+        }
+
+        if (ReadStatsNode(pid, &iterRef->currNode) == LE_OK)
+        {
+            return &iterRef->currNode;
+        }
+    }
+
+    closedir(iterRef->dirPtr);
+    iterRef->dirPtr = NULL;
+    iterRef->isDone = true;
+
+    return NULL;
+}
+
+
 // TODO: migrate the above to a separate module.
 //--------------------------------------------------------------------------------------------------
 /**
@@ -1557,6 +1878,7 @@ static void PrintHelp
         "SYNOPSIS:\n"
         "    inspect <pools|threads|timers|mutexes|semaphores> [OPTIONS] PID\n"
         "    inspect ipc <servers|clients [sessions]> [OPTIONS] PID\n"
+        "    inspect stats [pools] [OPTIONS] [PID]\n"
         "\n"
         "DESCRIPTION:\n"
         "    inspect pools              Prints the memory pools usage for the specified process.\n"
@@ -1569,6 +1891,11 @@ static void PrintHelp
                                         " specified process.\n"
         "    inspect ipc                Prints the info of ipc in all threads for the"
                                         " specified process.\n"
+        "    inspect stats              Prints the framework statistics (memory pools, timers,\n"
+        "                               event queues, IPC) published by the specified process,\n"
+        "                               or by all processes if no PID is given.\n"
+        "    inspect stats pools        Prints the memory pools usage published by the specified\n"
+        "                               process, or by all processes if no PID is given.\n"
         "\n"
         "OPTIONS:\n"
         "    -f\n"
@@ -1734,6 +2061,42 @@ static ColumnInfo_t SessionObjTableInfo[] =
 };
 static size_t SessionObjTableInfoSize = NUM_ARRAY_MEMBERS(SessionObjTableInfo);
 
+// NOTE: The counter columns must be in the same order as stats_Counter_t.
+static ColumnInfo_t StatsTableInfo[] =
+{
+    {"PID",           "%*s",  NULL, "%*d",        sizeof(int32_t),         false, 0, true},
+    {"NAME",          "%-*s", NULL, "%-*s",       MAX_PROC_NAME_BYTES - 1, true,  0, true},
+    {"POOLS",         "%*s",  NULL, "%*"PRIu64"", sizeof(uint16_t),        false, 0, true},
+    {"USED BLKS",     "%*s",  NULL, "%*"PRIu64"", sizeof(uint32_t),        false, 0, true},
+    {"ALLOCS",        "%*s",  NULL, "%*"PRIu64"", sizeof(uint64_t),        false, 0, false},
+    {"OVERFLOWS",     "%*s",  NULL, "%*"PRIu64"", sizeof(uint64_t),        false, 0, false},
+    {"THREADS",       "%*s",  NULL, "%*"PRIu64"", sizeof(uint16_t),        false, 0, true},
+    {"TIMERS",        "%*s",  NULL, "%*"PRIu64"", sizeof(uint32_t),        false, 0, true},
+    {"RUNNING",       "%*s",  NULL, "%*"PRIu64"", sizeof(uint32_t),        false, 0, true},
+    {"EXPIRIES",      "%*s",  NULL, "%*"PRIu64"", sizeof(uint64_t),        false, 0, false},
+    {"QUEUED EVENTS", "%*s",  NULL, "%*"PRIu64"", sizeof(uint32_t),        false, 0, true},
+    {"EVENTS",        "%*s",  NULL, "%*"PRIu64"", sizeof(uint64_t),        false, 0, false},
+    {"SESSIONS",      "%*s",  NULL, "%*"PRIu64"", sizeof(uint32_t),        false, 0, true},
+    {"MSGS SENT",     "%*s",  NULL, "%*"PRIu64"", sizeof(uint64_t),        false, 0, false},
+    {"MSGS RCVD",     "%*s",  NULL, "%*"PRIu64"", sizeof(uint64_t),        false, 0, false}
+};
+static size_t StatsTableInfoSize = NUM_ARRAY_MEMBERS(StatsTableInfo);
+
+// NOTE: The counter columns must be in the same order as stats_PoolCounter_t.
+static ColumnInfo_t StatsPoolTableInfo[] =
+{
+    {"PID",         "%*s",  NULL, "%*d",        sizeof(int32_t),           false, 0, true},
+    {"NAME",        "%-*s", NULL, "%-*s",       MAX_PROC_NAME_BYTES - 1,   true,  0, true},
+    {"TOTAL BLKS",  "%*s",  NULL, "%*"PRIu64"", sizeof(uint32_t),          false, 0, true},
+    {"USED BLKS",   "%*s",  NULL, "%*"PRIu64"", sizeof(uint32_t),          false, 0, true},
+    {"MAX USED",    "%*s",  NULL, "%*"PRIu64"", sizeof(uint32_t),          false, 0, true},
+    {"ALLOCS",      "%*s",  NULL, "%*"PRIu64"", sizeof(uint64_t),          false, 0, true},
+    {"OVERFLOWS",   "%*s",  NULL, "%*"PRIu64"", sizeof(uint32_t),          false, 0, true},
+    {"OBJ BYTES",   "%*s",  NULL, "%*"PRIu64"", sizeof(uint32_t),          false, 0, true},
+    {"MEMORY POOL", "%-*s", NULL, "%-*s",       STATS_POOL_NAME_BYTES - 1, true,  0, true}
+};
+static size_t StatsPoolTableInfoSize = NUM_ARRAY_MEMBERS(StatsPoolTableInfo);
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -2067,6 +2430,14 @@ static void InitDisplay
             InitDisplayTable(SessionObjTableInfo, SessionObjTableInfoSize);
             break;
 
+        case INSPECT_INSP_TYPE_STATS:
+            InitDisplayTable(StatsTableInfo, StatsTableInfoSize);
+            break;
+
+        case INSPECT_INSP_TYPE_STATS_POOLS:
+            InitDisplayTable(StatsPoolTableInfo, StatsPoolTableInfoSize);
+            break;
+
         default:
             INTERNAL_ERR("Failed to initialize display table - unexpected inspect type %d.",
                          inspectType);
@@ -2273,6 +2644,18 @@ static int PrintInspectHeader
             tableSize = SessionObjTableInfoSize;
             break;
 
+        case INSPECT_INSP_TYPE_STATS:
+            strncpy(inspectTypeString, "Statistics", inspectTypeStringSize);
+            table = StatsTableInfo;
+            tableSize = StatsTableInfoSize;
+            break;
+
+        case INSPECT_INSP_TYPE_STATS_POOLS:
+            strncpy(inspectTypeString, "Memory Pool Statistics", inspectTypeStringSize);
+            table = StatsPoolTableInfo;
+            tableSize = StatsPoolTableInfoSize;
+            break;
+
         default:
             INTERNAL_ERR("unexpected inspect type %d.", InspectType);
     }
@@ -2285,7 +2668,14 @@ static int PrintInspectHeader
         // Print title.
         printf("Legato %s Inspector\n", inspectTypeString);
         lineCount++;
-        printf("Inspecting process %d\n", PidToInspect);
+        if (PidToInspect > 0)
+        {
+            printf("Inspecting process %d\n", PidToInspect);
+        }
+        else
+        {
+            printf("Inspecting all processes\n");
+        }
         lineCount++;
 
         // Print column headers.
@@ -3660,6 +4050,152 @@ static int PrintSessionObjInfo
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print the statistics page of a process to stdout.
+ */
+//--------------------------------------------------------------------------------------------------
+static int PrintStatsInfo
+(
+    StatsNode_t* statsNodeRef ///< [IN] ref to the statistics node to be printed.
+)
+{
+    int lineCount = 0;
+    int index = 0;
+    int i;
+
+    if (!IsOutputJson)
+    {
+        FillIntColField(statsNodeRef->page.pid,  StatsTableInfo, StatsTableInfoSize, &index);
+        FillStrColField(statsNodeRef->procName,  StatsTableInfo, StatsTableInfoSize, &index);
+
+        for (i = 0; i < STATS_NUM_COUNTERS; i++)
+        {
+            FillUint64ColField(statsNodeRef->page.counters[i],
+                               StatsTableInfo, StatsTableInfoSize, &index);
+        }
+
+        PrintInfo(StatsTableInfo, StatsTableInfoSize);
+        lineCount++;
+    }
+    else
+    {
+        // If it's not the first time, print a comma.
+        if (!IsPrintedNodeFirst)
+        {
+            printf(",");
+        }
+        else
+        {
+            IsPrintedNodeFirst = false;
+        }
+
+        bool printed = false;
+
+        printf("[");
+
+        ExportIntToJson(statsNodeRef->page.pid,  StatsTableInfo, StatsTableInfoSize, &index,
+                                                 &printed);
+        ExportStrToJson(statsNodeRef->procName,  StatsTableInfo, StatsTableInfoSize, &index,
+                                                 &printed);
+
+        for (i = 0; i < STATS_NUM_COUNTERS; i++)
+        {
+            ExportUint64ToJson(statsNodeRef->page.counters[i],
+                               StatsTableInfo, StatsTableInfoSize, &index, &printed);
+        }
+
+        printf("]");
+    }
+
+    return lineCount;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print the memory pools in the statistics page of a process to stdout, one line per pool.
+ */
+//--------------------------------------------------------------------------------------------------
+static int PrintStatsPoolsInfo
+(
+    StatsNode_t* statsNodeRef ///< [IN] ref to the statistics node to be printed.
+)
+{
+    int lineCount = 0;
+    uint32_t poolIndex;
+
+    for (poolIndex = 0; poolIndex < statsNodeRef->page.maxPools; poolIndex++)
+    {
+        stats_Pool_t* poolPtr = &statsNodeRef->page.pools[poolIndex];
+        int index = 0;
+        int i;
+
+        if (poolPtr->name[0] == '\0')
+        {
+            continue;
+        }
+
+        if (!IsOutputJson)
+        {
+            FillIntColField(statsNodeRef->page.pid, StatsPoolTableInfo, StatsPoolTableInfoSize,
+                            &index);
+            FillStrColField(statsNodeRef->procName, StatsPoolTableInfo, StatsPoolTableInfoSize,
+                            &index);
+
+            for (i = 0; i < STATS_POOL_NUM_COUNTERS; i++)
+            {
+                FillUint64ColField(poolPtr->counters[i],
+                                   StatsPoolTableInfo, StatsPoolTableInfoSize, &index);
+            }
+
+            FillUint64ColField(poolPtr->objSize, StatsPoolTableInfo, StatsPoolTableInfoSize,
+                               &index);
+            FillStrColField(poolPtr->name, StatsPoolTableInfo, StatsPoolTableInfoSize, &index);
+
+            PrintInfo(StatsPoolTableInfo, StatsPoolTableInfoSize);
+            lineCount++;
+        }
+        else
+        {
+            // If it's not the first time, print a comma.
+            if (!IsPrintedNodeFirst)
+            {
+                printf(",");
+            }
+            else
+            {
+                IsPrintedNodeFirst = false;
+            }
+
+            bool printed = false;
+
+            printf("[");
+
+            ExportIntToJson(statsNodeRef->page.pid, StatsPoolTableInfo, StatsPoolTableInfoSize,
+                            &index, &printed);
+            ExportStrToJson(statsNodeRef->procName, StatsPoolTableInfo, StatsPoolTableInfoSize,
+                            &index, &printed);
+
+            for (i = 0; i < STATS_POOL_NUM_COUNTERS; i++)
+            {
+                ExportUint64ToJson(poolPtr->counters[i],
+                                   StatsPoolTableInfo, StatsPoolTableInfoSize, &index, &printed);
+            }
+
+            ExportUint64ToJson(poolPtr->objSize, StatsPoolTableInfo, StatsPoolTableInfoSize,
+                               &index, &printed);
+            ExportStrToJson(poolPtr->name, StatsPoolTableInfo, StatsPoolTableInfoSize, &index,
+                            &printed);
+
+            printf("]");
+        }
+    }
+
+    return lineCount;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Function prototype needed by InspectEndHandling.
@@ -3841,6 +4377,20 @@ static void InspectFunc
             printNodeInfoFunc = (PrintNodeInfoFunc_t) PrintSessionObjInfo;
             break;
 
+        case INSPECT_INSP_TYPE_STATS:
+            createIterFunc    = (CreateIterFunc_t)    CreateStatsIter;
+            getListChgCntFunc = (GetListChgCntFunc_t) GetStatsListChgCnt;
+            getNextNodeFunc   = (GetNextNodeFunc_t)   GetNextStatsNode;
+            printNodeInfoFunc = (PrintNodeInfoFunc_t) PrintStatsInfo;
+            break;
+
+        case INSPECT_INSP_TYPE_STATS_POOLS:
+            createIterFunc    = (CreateIterFunc_t)    CreateStatsIter;
+            getListChgCntFunc = (GetListChgCntFunc_t) GetStatsListChgCnt;
+            getNextNodeFunc   = (GetNextNodeFunc_t)   GetNextStatsNode;
+            printNodeInfoFunc = (PrintNodeInfoFunc_t) PrintStatsPoolsInfo;
+            break;
+
         default:
             INTERNAL_ERR("unexpected inspect type %d.", inspectType);
     }
@@ -3942,6 +4492,42 @@ static void PidArgHandler
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function called by command line argument scanner when the optional pools or pid argument of the
+ * stats command is found.  The statistics page is read through shared memory, so there's no need
+ * to open the process's mem file.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void StatsPidArgHandler
+(
+    const char* pidStr
+)
+{
+    int pid;
+    le_result_t result = le_utf8_ParseInt(&pid, pidStr);
+
+    if ((strcmp(pidStr, "pools") == 0) && (InspectType == INSPECT_INSP_TYPE_STATS))
+    {
+        InspectType = INSPECT_INSP_TYPE_STATS_POOLS;
+
+        // The PID is still optional.
+        le_arg_AddPositionalCallback(StatsPidArgHandler);
+        return;
+    }
+
+    if ((result == LE_OK) && (pid > 0))
+    {
+        PidToInspect = pid;
+    }
+    else
+    {
+        fprintf(stderr, "Invalid PID (%s).\n", pidStr);
+        exit(EXIT_FAILURE);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * IPC sessions argument handler.
@@ -4042,13 +4628,21 @@ static void CommandArgHandler
     {
         le_arg_AddPositionalCallback(IpcInterfaceTypeHandler);
     }
+    else if (strcmp(command, "stats") == 0)
+    {
+        InspectType = INSPECT_INSP_TYPE_STATS;
+
+        // The PID is optional; without it, all processes are inspected.
+        le_arg_AddPositionalCallback(StatsPidArgHandler);
+        le_arg_AllowLessPositionalArgsThanCallbacks();
+    }
     else
     {
         fprintf(stderr, "Invalid command '%s'.\n", command);
         exit(EXIT_FAILURE);
     }
 
-    if (strcmp(command, "ipc") != 0)
+    if ((strcmp(command, "ipc") != 0) && (strcmp(command, "stats") != 0))
     {
         le_arg_AddPositionalCallback(PidArgHandler);
     }
@@ -4154,6 +4748,11 @@ static void InitIteratorPool
                    sizeof(ThreadObjIter_t) : sizeof(SessionObjIter_t);
             break;
 
+        case INSPECT_INSP_TYPE_STATS:
+        case INSPECT_INSP_TYPE_STATS_POOLS:
+            size = sizeof(StatsIter_t);
+            break;
+
         default:
             INTERNAL_ERR("unexpected inspect type %d.", inspectType);
     }
@@ -28,6 +28,12 @@ $ log trace keyword processName/componentName
 $ log stoptrace keyword processName/componentName
 @endverbatim
  *
+ *
+ * To query the records of the log ring of the log daemon, at least as severe as a given level, for
+ * a component in a process, logged in the last 60 seconds:
+ * @verbatim
+$ log query processName/componentName --level=WARNING --since=60
+@endverbatim
  *
  * With all of the above examples "*" can be used in place of processName and componentName to mean
  * all processes and/or all components.  In fact if the "processName/componentName" is omitted the
@@ -46,6 +52,9 @@ $ log stoptrace keyword processName/componentName
  *    destination is the "processName/componentName" followed by a '/' character.
  *    commandParameter is the string specific to the command.
  *
+ * The query command is different: the log daemon responds with the file descriptor of the log ring,
+ * which this tool maps to read the records itself, filtering them on their fields.
+ *
  * Copyright (C) Sierra Wireless Inc.
  */
 
@@ -53,6 +62,7 @@ $ log stoptrace keyword processName/componentName
 #include "log.h"
 #include "logDaemon.h"
 #include "limit.h"
+#include "logRing.h"
 #include <ctype.h>
 
 
@@ -91,6 +101,22 @@ static const char* CommandParamPtr = NULL;
 static const char* SessionIdPtr = DEFAULT_SESSION_ID;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Minimum severity level of the records of a query (--level), or -1 for all of them.
+ **/
+//--------------------------------------------------------------------------------------------------
+static le_log_Level_t QueryLevel = -1;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Age of the oldest records of a query, in seconds (--since), or 0 for all of them.
+ **/
+//--------------------------------------------------------------------------------------------------
+static int QuerySinceSec = 0;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * True if an error response was received from the Log Control Daemon.
@@ -119,6 +145,7 @@ static void PrintHelpAndExit
         "    log trace KEYWORD_STR [DESTINATION]\n"
         "    log stoptrace KEYWORD_STR [DESTINATION]\n"
         "    log forget PROCESS_NAME\n"
+        "    log query [DESTINATION] [--level=FILTER_STR] [--since=SECONDS]\n"
         "\n"
         "DESCRIPTION:\n"
         "    log list            Lists all processes/components registered with the\n"
@@ -146,6 +173,13 @@ static void PrintHelpAndExit
         "                        Future processes with that name will have default\n"
         "                        settings.\n"
         "\n"
+        "    log query           Prints the records of the log ring of the log\n"
+        "                        daemon from the oldest to the newest, for the\n"
+        "                        [DESTINATION] only.  With --level, only the records\n"
+        "                        at least as severe as FILTER_STR are printed, and\n"
+        "                        no traces.  With --since, only the records logged\n"
+        "                        in the last SECONDS are printed.\n"
+        "\n"
         "The [DESTINATION] is optional and specifies the process and component to\n"
         "send the command to.  The [DESTINATION] must be in this format:\n"
         "\n"
@@ -364,6 +398,130 @@ le_log_Level_t ParseSeverityLevel
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function that gets called by le_arg_Scan() when the --level option is seen on the command line.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void QueryLevelArgHandler
+(
+    const char* logLevel
+)
+{
+    QueryLevel = ParseSeverityLevel(logLevel);
+    if (QueryLevel == (le_log_Level_t)(-1))
+    {
+        ExitWithErrorMsg("Invalid log level.");
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prints a record of the log ring.
+ *
+ * @return true, to go on with the query.
+ **/
+//--------------------------------------------------------------------------------------------------
+static bool PrintRecord
+(
+    const logRing_Record_t* recordPtr,  ///< [IN] The record.
+    void* contextPtr                    ///< [IN] Not used.
+)
+{
+    time_t sec = recordPtr->timestampNs / 1000000000;
+    unsigned int msec = (recordPtr->timestampNs % 1000000000) / 1000000;
+    const char* levelPtr = "TRACE";
+    char timeStamp[32] = "";
+    struct tm tm;
+
+    if (localtime_r(&sec, &tm) != NULL)
+    {
+        strftime(timeStamp, sizeof(timeStamp), "%b %d %H:%M:%S", &tm);
+    }
+
+    if (recordPtr->level != LOGRING_LEVEL_TRACE)
+    {
+        levelPtr = log_SeverityLevelToStr(recordPtr->level);
+        if (levelPtr == NULL)
+        {
+            levelPtr = "?";
+        }
+    }
+
+    printf("%s.%03u | %-9s | %s[%d]/%s T=%d | %s\n", timeStamp, msec, levelPtr,
+           recordPtr->procName, recordPtr->pid, recordPtr->compName, recordPtr->tid,
+           recordPtr->msg);
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queries the log ring received from the Log Control Daemon and prints the matching records.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void QueryRing
+(
+    int fd      ///< [IN] File descriptor of the log ring.
+)
+{
+    char procName[LIMIT_MAX_PROCESS_NAME_BYTES];
+    logRing_Filter_t filter = { 0 };
+
+    logRing_Ref_t ringRef = logRing_Map(fd, false);
+    close(fd);
+    if (ringRef == NULL)
+    {
+        ExitWithErrorMsg("Invalid log ring.");
+    }
+
+    // Build the filter from the destination: "*" matches any process or component.
+    const char* compNamePtr = strchr(SessionIdPtr, '/') + 1;
+    size_t procNameLen = compNamePtr - 1 - SessionIdPtr;
+    if (procNameLen >= sizeof(procName))
+    {
+        ExitWithErrorMsg("Invalid destination.");
+    }
+    memcpy(procName, SessionIdPtr, procNameLen);
+    procName[procNameLen] = '\0';
+
+    if (strcmp(procName, "*") != 0)
+    {
+        char* endPtr;
+        long pid = strtol(procName, &endPtr, 10);
+
+        if ((*endPtr == '\0') && (endPtr != procName))
+        {
+            filter.pid = pid;
+        }
+        else
+        {
+            filter.procNamePtr = procName;
+        }
+    }
+    if ((strcmp(compNamePtr, "*") != 0) && (*compNamePtr != '\0'))
+    {
+        filter.compNamePtr = compNamePtr;
+    }
+    if (QueryLevel != (le_log_Level_t)(-1))
+    {
+        filter.minLevel = QueryLevel;
+    }
+    if (QuerySinceSec > 0)
+    {
+        struct timespec now;
+
+        LE_ASSERT(clock_gettime(CLOCK_REALTIME, &now) == 0);
+        filter.sinceNs = (((uint64_t)now.tv_sec - QuerySinceSec) * 1000000000) + now.tv_nsec;
+    }
+
+    logRing_Query(ringRef, &filter, PrintRecord, NULL);
+    logRing_Unmap(ringRef);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Appends some text to the command message.
@@ -529,6 +687,14 @@ static void CommandArgHandler
         // This command has only a process name (or pid) as a parameter.
         le_arg_AddPositionalCallback(ProcessIdArgHandler);
     }
+    else if (strcmp(command, "query") == 0)
+    {
+        Command = LOG_CMD_GET_RING;
+
+        // Wait for an optional log session identifier next.
+        le_arg_AddPositionalCallback(SessionIdArgHandler);
+        le_arg_AllowLessPositionalArgsThanCallbacks();
+    }
     else
     {
         char errorMsg[100];
@@ -551,6 +717,10 @@ COMPONENT_INIT
     // Print help and exit if the "-h" or "--help" options are given.
     le_arg_SetFlagCallback(PrintHelpAndExit, "h", "help");
 
+    // Filters of the "query" command.
+    le_arg_SetStringCallback(QueryLevelArgHandler, NULL, "level");
+    le_arg_SetIntVar(&QuerySinceSec, NULL, "since");
+
     le_arg_Scan();
 
     // Connect to the Log Control Daemon and allocate a message buffer to hold the command.
@@ -584,6 +754,26 @@ COMPONENT_INIT
             AppendToCommand(msgRef, CommandParamPtr);
 
             break;
+
+        case LOG_CMD_GET_RING:
+        {
+            // The records are read from the log ring directly, so there is only one response.
+            msgRef = le_msg_RequestSyncResponse(msgRef);
+            if (msgRef == NULL)
+            {
+                ExitWithErrorMsg("No response from the log daemon.");
+            }
+
+            int fd = le_msg_GetFd(msgRef);
+            le_msg_ReleaseMsg(msgRef);
+            if (fd < 0)
+            {
+                ExitWithErrorMsg("No log ring, or this user may not read it.");
+            }
+
+            QueryRing(fd);
+            exit(EXIT_SUCCESS);
+        }
     }
 
     // Send the command and wait for messages from the Log Control Daemon.  When the Log Control
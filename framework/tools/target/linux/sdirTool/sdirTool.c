@@ -50,6 +50,12 @@ static const char* ClientIfPtr = NULL;
 static const char* ServerIfPtr = NULL;
 
 
+//--------------------------------------------------------------------------------------------------
+/// App name string (used by Load()).  NULL = load the bindings of all users and apps.
+//--------------------------------------------------------------------------------------------------
+static const char* AppNamePtr = NULL;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Prints help to stdout and exits with EXIT_SUCCESS.
@@ -68,6 +74,7 @@ static void PrintHelpAndExit
         "    sdir list\n"
         "    sdir list --format=json\n"
         "    sdir load\n"
+        "    sdir load APP_NAME\n"
         "    sdir bind CLIENT_IF SERVER_IF\n"
         "    sdir help\n"
         "    sdir -h\n"
@@ -87,6 +94,12 @@ static void PrintHelpAndExit
         "            The tool will not exit until it gets confirmation from\n"
         "            the Service Directory that the changes have been applied.\n"
         "\n"
+        "    sdir load APP_NAME\n"
+        "            Updates only the bindings of the app APP_NAME, and the bindings\n"
+        "            of the other users and apps to the services of APP_NAME, with the\n"
+        "            current state of the configuration tree.  The other bindings are\n"
+        "            left untouched.  Used when an app is installed or removed.\n"
+        "\n"
         "    sdir bind CLIENT_IF SERVER_IF\n"
         "            Creates a temporary binding in the Service Directory from\n"
         "            client-side IPC interface CLIENT_IF to server-side IPC interface\n"
@@ -268,6 +281,79 @@ static void SendUnbindAllRequest
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send an "App Bind Start" or "App Bind End" request to the Service Directory.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendAppBindRequest
+(
+    le_sdtp_MsgType_t msgType,  ///< [in] LE_SDTP_MSGID_APP_BIND_START or LE_SDTP_MSGID_APP_BIND_END.
+    const char* appName         ///< [in] Name of the app whose bindings are being updated.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_msg_MessageRef_t msgRef = le_msg_CreateMsg(SessionRef);
+    le_sdtp_Msg_t* msgPtr = le_msg_GetPayloadPtr(msgRef);
+
+    msgPtr->msgType = msgType;
+
+    if (le_utf8_Copy(msgPtr->appName, appName, sizeof(msgPtr->appName), NULL) != LE_OK)
+    {
+        ExitWithErrorMsg("App name too long.");
+    }
+
+    msgRef = le_msg_RequestSyncResponse(msgRef);
+
+    if (msgRef == NULL)
+    {
+        ExitWithErrorMsg("Communication with Service Directory failed.");
+    }
+
+    le_msg_ReleaseMsg(msgRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send an "Unbind" request to the Service Directory for the client interface named after a
+ * configuration tree iterator's current node.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendCfgUnbindRequest
+(
+    uid_t uid,                  ///< [in] Unix user ID of the client whose binding is being deleted.
+    le_cfg_IteratorRef_t i      ///< [in] Configuration read iterator.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_msg_MessageRef_t msgRef = le_msg_CreateMsg(SessionRef);
+    le_sdtp_Msg_t* msgPtr = le_msg_GetPayloadPtr(msgRef);
+
+    msgPtr->msgType = LE_SDTP_MSGID_UNBIND;
+    msgPtr->client = uid;
+
+    if (le_cfg_GetNodeName(i,
+                           "",
+                           msgPtr->clientInterfaceName,
+                           sizeof(msgPtr->clientInterfaceName)) != LE_OK)
+    {
+        // Such a binding can't have been created in the first place.
+        le_msg_ReleaseMsg(msgRef);
+        return;
+    }
+
+    msgRef = le_msg_RequestSyncResponse(msgRef);
+
+    if (msgRef == NULL)
+    {
+        ExitWithErrorMsg("Communication with Service Directory failed.");
+    }
+
+    le_msg_ReleaseMsg(msgRef);
+}
+
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -397,11 +483,14 @@ static le_result_t GetServerUid
 //--------------------------------------------------------------------------------------------------
 /**
  * Send a binding from a configuration tree iterator's current node to the Service Directory.
+ *
+ * @return LE_OK if the binding was sent, or the error found in its configuration.
  */
 //--------------------------------------------------------------------------------------------------
-static void SendCfgBindRequest
+static le_result_t SendCfgBindRequest
 (
     uid_t uid,                  ///< [in] Unix user ID of the client whose binding is being created.
+    const char* appName,        ///< [in] Name of the app the binding is configured in ("" if none).
     le_cfg_IteratorRef_t i      ///< [in] Configuration read iterator.
 )
 //--------------------------------------------------------------------------------------------------
@@ -413,6 +502,7 @@ static void SendCfgBindRequest
 
     msgPtr->msgType = LE_SDTP_MSGID_BIND;
     msgPtr->client = uid;
+    LE_ASSERT(le_utf8_Copy(msgPtr->appName, appName, sizeof(msgPtr->appName), NULL) == LE_OK);
 
     // Fetch the client's service name.
     result = le_cfg_GetNodeName(i,
@@ -424,14 +514,16 @@ static void SendCfgBindRequest
         char path[LIMIT_MAX_PATH_BYTES];
         le_cfg_GetPath(i, "", path, sizeof(path));
         LE_CRIT("Configured client service name too long (@ %s)", path);
-        return;
+        le_msg_ReleaseMsg(msgRef);
+        return result;
     }
 
     // Fetch the server's user ID.
     result = GetServerUid(i, &msgPtr->server);
     if (result != LE_OK)
     {
-        return;
+        le_msg_ReleaseMsg(msgRef);
+        return result;
     }
 
     // Fetch the server's service name.
@@ -445,14 +537,16 @@ static void SendCfgBindRequest
         char path[LIMIT_MAX_PATH_BYTES];
         le_cfg_GetPath(i, "interface", path, sizeof(path));
         LE_CRIT("Server interface name too big (@ %s)", path);
-        return;
+        le_msg_ReleaseMsg(msgRef);
+        return result;
     }
     if (msgPtr->serverInterfaceName[0] == '\0')
     {
         char path[LIMIT_MAX_PATH_BYTES];
         le_cfg_GetPath(i, "interface", path, sizeof(path));
         LE_CRIT("Server interface name missing (@ %s)", path);
-        return;
+        le_msg_ReleaseMsg(msgRef);
+        return LE_NOT_FOUND;
     }
 
     msgRef = le_msg_RequestSyncResponse(msgRef);
@@ -463,6 +557,8 @@ static void SendCfgBindRequest
     }
 
     le_msg_ReleaseMsg(msgRef);
+
+    return LE_OK;
 }
 
 
@@ -561,6 +657,150 @@ static le_result_t GetAppUid
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send all the bindings of the user or app configuration node that a given configuration iterator
+ * is currently positioned at.  The iterator is left on that node.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendCfgBindings
+(
+    le_cfg_IteratorRef_t i, ///< [in] Configuration tree iterator.
+    uid_t uid,              ///< [in] Unix user ID of the user or app.
+    const char* appName     ///< [in] Name of the app ("" for a user).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_cfg_GoToNode(i, "bindings");
+
+    le_result_t result = le_cfg_GoToFirstChild(i);
+    if (result == LE_OK)
+    {
+        while (result == LE_OK)
+        {
+            SendCfgBindRequest(uid, appName, i);
+
+            result = le_cfg_GoToNextSibling(i);
+        }
+
+        le_cfg_GoToParent(i);
+    }
+
+    le_cfg_GoToParent(i);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Update the bindings of the user or app configuration node that a given configuration iterator
+ * is currently positioned at, to the services of a given app.  The iterator is left on that node.
+ *
+ * Bindings to the app that can't be resolved anymore (because it was removed) are deleted.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UpdateCfgBindingsToApp
+(
+    le_cfg_IteratorRef_t i,     ///< [in] Configuration tree iterator.
+    uid_t uid,                  ///< [in] Unix user ID of the user or app.
+    const char* appName,        ///< [in] Name of the app ("" for a user).
+    const char* serverAppName   ///< [in] Name of the app serving the bindings to update.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_cfg_GoToNode(i, "bindings");
+
+    le_result_t result = le_cfg_GoToFirstChild(i);
+    if (result == LE_OK)
+    {
+        while (result == LE_OK)
+        {
+            char serverApp[LIMIT_MAX_APP_NAME_BYTES];
+
+            if ((le_cfg_GetString(i, "app", serverApp, sizeof(serverApp), "") == LE_OK)
+                && (strcmp(serverApp, serverAppName) == 0)
+                && (SendCfgBindRequest(uid, appName, i) != LE_OK))
+            {
+                SendCfgUnbindRequest(uid, i);
+            }
+
+            result = le_cfg_GoToNextSibling(i);
+        }
+
+        le_cfg_GoToParent(i);
+    }
+
+    le_cfg_GoToParent(i);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Update the bindings of one app, and the bindings of the other users and apps to its services.
+ * The other bindings in the Service Directory are not touched, so the clients using them are
+ * not disturbed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LoadApp
+(
+    le_cfg_IteratorRef_t i, ///< [in] Configuration read iterator on the root of the tree.
+    const char* appName     ///< [in] Name of the app.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_result_t result;
+
+    // The bindings of the app that are not sent again (because they were removed from the
+    // configuration, or the app itself was removed) will be deleted at the end.
+    SendAppBindRequest(LE_SDTP_MSGID_APP_BIND_START, appName);
+
+    le_cfg_GoToNode(i, "/apps");
+    if (le_cfg_NodeExists(i, appName))
+    {
+        uid_t uid;
+
+        le_cfg_GoToNode(i, appName);
+        if (GetAppUid(i, &uid) == LE_OK)
+        {
+            SendCfgBindings(i, uid, appName);
+        }
+    }
+
+    SendAppBindRequest(LE_SDTP_MSGID_APP_BIND_END, appName);
+
+    // Iterate over the users collection, updating their bindings to the app.
+    le_cfg_GoToNode(i, "/users");
+    result = le_cfg_GoToFirstChild(i);
+    while (result == LE_OK)
+    {
+        uid_t uid;
+        if (GetUserUid(i, &uid) == LE_OK)
+        {
+            UpdateCfgBindingsToApp(i, uid, "", appName);
+        }
+
+        result = le_cfg_GoToNextSibling(i);
+    }
+
+    // Iterate over the other apps, updating their bindings to the app.
+    le_cfg_GoToNode(i, "/apps");
+    result = le_cfg_GoToFirstChild(i);
+    while (result == LE_OK)
+    {
+        char clientAppName[LIMIT_MAX_APP_NAME_BYTES];
+        uid_t uid;
+
+        if ((le_cfg_GetNodeName(i, "", clientAppName, sizeof(clientAppName)) == LE_OK)
+            && (strcmp(clientAppName, appName) != 0)
+            && (GetAppUid(i, &uid) == LE_OK))
+        {
+            UpdateCfgBindingsToApp(i, uid, clientAppName, appName);
+        }
+
+        result = le_cfg_GoToNextSibling(i);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Execute a 'load' command.
@@ -583,6 +823,14 @@ static void Load
     // Start a read transaction on the root of the "system" configuration tree.
     le_cfg_IteratorRef_t i = le_cfg_CreateReadTxn("system:");
 
+    // If only one app's bindings are to be updated, leave the others alone.
+    if (AppNamePtr != NULL)
+    {
+        LoadApp(i, AppNamePtr);
+
+        exit(EXIT_SUCCESS);
+    }
+
     // Tell the Service Directory to delete all existing bindings.
     SendUnbindAllRequest();
 
@@ -596,17 +844,7 @@ static void Load
         {
             // For each user, iterate over the bindings collection, sending the binding to
             // the Service Directory.
-            le_cfg_GoToNode(i, "bindings");
-            result = le_cfg_GoToFirstChild(i);
-            while (result == LE_OK)
-            {
-                SendCfgBindRequest(uid, i);
-
-                result = le_cfg_GoToNextSibling(i);
-            }
-
-            // Go back up to the user name node.
-            le_cfg_GoToNode(i, "../..");
+            SendCfgBindings(i, uid, "");
         }
 
         // Move on to the next user.
@@ -618,23 +856,15 @@ static void Load
     result = le_cfg_GoToFirstChild(i);
     while (result == LE_OK)
     {
+        char appName[LIMIT_MAX_APP_NAME_BYTES];
         uid_t uid;
 
         if (GetAppUid(i, &uid) == LE_OK)
         {
             // For each app, iterate over the bindings collection, sending the binding to
-            // the Service Directory.
-            le_cfg_GoToNode(i, "bindings");
-            result = le_cfg_GoToFirstChild(i);
-            while (result == LE_OK)
-            {
-                SendCfgBindRequest(uid, i);
-
-                result = le_cfg_GoToNextSibling(i);
-            }
-
-            // Go back up to the app's node.
-            le_cfg_GoToNode(i, "../..");
+            // the Service Directory, tagged with the app's name so it can be updated alone.
+            le_cfg_GetNodeName(i, "", appName, sizeof(appName));
+            SendCfgBindings(i, uid, appName);
         }
 
         // Move on to the next app.
@@ -760,6 +990,7 @@ static void Bind
     le_sdtp_Msg_t* msgPtr = le_msg_GetPayloadPtr(msgRef);
 
     msgPtr->msgType = LE_SDTP_MSGID_BIND;
+    msgPtr->appName[0] = '\0';
 
     // Parse the client interface specifier.
     ParseInterfaceSpec(ClientIfPtr,
@@ -822,6 +1053,23 @@ static void ServerIfArgHandler
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Positional argument callback function that gets called with the APP_NAME argument from the
+ * command line.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void AppNameArgHandler
+(
+    const char* argPtr  ///< Pointer to the argument string.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Just save it for now.
+    AppNamePtr = argPtr;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Positional argument callback function that gets called with the command argument from the
@@ -842,6 +1090,12 @@ static void CommandArgHandler
         le_arg_AddPositionalCallback(ClientIfArgHandler);
         le_arg_AddPositionalCallback(ServerIfArgHandler);
     }
+    // The load command accepts an optional app name.
+    else if (strcmp(CommandPtr, "load") == 0)
+    {
+        le_arg_AddPositionalCallback(AppNameArgHandler);
+        le_arg_AllowLessPositionalArgsThanCallbacks();
+    }
 }
 
 